@@ -30,8 +30,15 @@ typedef PFP::VEC3 VEC3;
 int main(int argc, char **argv)
 {
 
-	if(argc != 2)
+	if(argc < 2)
+	{
+		std::cout << "usage: " << argv[0] << " mesh_file [arena]" << std::endl;
 		return 1;
+	}
+
+	// optional: attribute blocks taken from huge page slabs and recycled
+	if ((argc > 2) && (std::string(argv[2]) == "arena"))
+		BlockAllocator::setDefault(std::make_shared<ArenaBlockAllocator>());
 
 	MAP myMap;
 
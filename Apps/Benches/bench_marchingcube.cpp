@@ -0,0 +1,120 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+
+#include "Algo/MC/marchingcube.h"
+#include "Algo/MC/windowing.h"
+
+#include "Utils/cgognStream.h"
+#include "Utils/chrono.h"
+
+#include <cstdlib>
+#include <cmath>
+#include <vector>
+
+
+using namespace CGoGN ;
+
+struct PFP: public PFP_STANDARD
+{
+	typedef EmbeddedMap2 MAP;
+};
+
+typedef PFP::MAP MAP;
+typedef PFP::VEC3 VEC3;
+typedef Algo::Surface::MC::MarchingCube<unsigned char, Algo::Surface::MC::WindowingGreater, PFP> MC;
+
+/**
+ * Bench of the marching cube: simple meshing against slab parallel meshing
+ * and brick skipping (min/max pyramid) of a field of blobs
+ * usage: bench_marchingcube [image_size] [nb_slabs] [nb_threads]
+ */
+int main(int argc, char** argv)
+{
+	int size = 256;
+	unsigned int nbSlabs = 0;
+	unsigned int nbth = CGoGN::Parallel::NumberOfThreads;
+	if (argc > 1)
+		size = atoi(argv[1]);
+	if (argc > 2)
+		nbSlabs = atoi(argv[2]);
+	if (argc > 3)
+		nbth = atoi(argv[3]);
+
+	std::vector<unsigned char> data(size * size * size);
+	for (int z = 0; z < size; ++z)
+		for (int y = 0; y < size; ++y)
+			for (int x = 0; x < size; ++x)
+			{
+				double f = std::sin(0.15 * x) * std::cos(0.11 * y) + std::sin(0.13 * z) * std::cos(0.07 * x);
+				if (x == 0 || y == 0 || z == 0 || x == size - 1 || y == size - 1 || z == size - 1)
+					f = -2.0;
+				data[(z * size + y) * size + x] = (unsigned char)(128.0 + 60.0 * f);
+			}
+	Algo::Surface::MC::Image<unsigned char> image(&data[0], size, size, size, 1.0f, 1.0f, 1.0f, false);
+
+	Algo::Surface::MC::WindowingGreater<unsigned char> wind;
+	wind.setIsoValue(128);
+
+	CGoGNout << size << "^3 voxels, " << nbth << " threads" << CGoGNendl;
+
+	{
+		MAP map;
+		VertexAttribute<VEC3, MAP> position = map.addAttribute<VEC3, VERTEX, MAP>("position");
+		MC mc(&image, &map, position, wind, false);
+		Utils::Chrono ch;
+		ch.start();
+		mc.simpleMeshing();
+		CGoGNout << "simpleMeshing: " << ch.elapsed() << " ms" << CGoGNendl;
+	}
+
+	{
+		MAP map;
+		VertexAttribute<VEC3, MAP> position = map.addAttribute<VEC3, VERTEX, MAP>("position");
+		MC mc(&image, &map, position, wind, false);
+		Utils::Chrono ch;
+		ch.start();
+		mc.parallelMeshing(nbSlabs, nbth);
+		CGoGNout << "parallelMeshing: " << ch.elapsed() << " ms" << CGoGNendl;
+	}
+
+	{
+		MAP map;
+		VertexAttribute<VEC3, MAP> position = map.addAttribute<VEC3, VERTEX, MAP>("position");
+		MC mc(&image, &map, position, wind, false);
+		Utils::Chrono ch;
+		ch.start();
+		Algo::Surface::MC::MinMaxPyramid<unsigned char> pyramid(image, 8, nbth);
+		unsigned int nbActive = mc.setPyramid(&pyramid);
+		int t = ch.elapsed();
+		mc.simpleMeshing();
+		CGoGNout << "simpleMeshing with pyramid: " << ch.elapsed() << " ms (pyramid " << t << " ms, "
+				 << nbActive << " / " << pyramid.getNbBricksX() * pyramid.getNbBricksY() * pyramid.getNbBricksZ() << " active bricks)" << CGoGNendl;
+	}
+
+	return 0;
+}
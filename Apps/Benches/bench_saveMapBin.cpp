@@ -0,0 +1,96 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+#include "Algo/Tiling/Surface/square.h"
+#include "Utils/chrono.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+using namespace CGoGN;
+
+struct PFP: public PFP_STANDARD
+{
+	typedef EmbeddedMap2 MAP;
+};
+
+typedef PFP::MAP MAP;
+typedef PFP::VEC3 VEC3;
+
+
+static long fileSize(const char* filename)
+{
+	FILE* f = fopen(filename, "rb");
+	if (f == NULL)
+		return 0;
+	fseek(f, 0, SEEK_END);
+	long sz = ftell(f);
+	fclose(f);
+	return sz;
+}
+
+int main(int argc, char **argv)
+{
+	unsigned int n = (argc > 1) ? atoi(argv[1]) : 1000;
+
+	MAP myMap;
+	VertexAttribute<VEC3, MAP> position = myMap.addAttribute<VEC3, VERTEX, MAP>("position");
+	Algo::Surface::Tilings::Square::Grid<PFP> grid(myMap, n, n);
+	grid.embedIntoGrid(position, 1.0f, 1.0f, 0.0f);
+
+	FaceAttribute<float, MAP> value = myMap.addAttribute<float, FACE, MAP>("value");
+	foreach_cell<FACE>(myMap, [&] (Face f)
+	{
+		value[f] = position[f.dart][0] * position[f.dart][1];
+	});
+
+	std::cout << "grid " << n << "x" << n << ": " << myMap.getNbDarts() << " darts, " << Parallel::NumberOfThreads << " threads" << std::endl;
+
+	const char* names[3] = { "gzip", "raw", "lz4" };
+	for (unsigned int f = 0; f < 3; ++f)
+	{
+#ifndef CGOGN_WITH_LZ4
+		if (f == Utils::BIN_LZ4)
+			continue;
+#endif
+		Utils::Chrono chrono;
+		chrono.start();
+		myMap.saveMapBin("bench_saveMapBin.map", Utils::BinaryFormat(f));
+		int tSave = chrono.elapsed();
+
+		MAP myMap2;
+		chrono.start();
+		myMap2.loadMapBin("bench_saveMapBin.map");
+		int tLoad = chrono.elapsed();
+
+		std::cout << names[f] << ": save " << tSave << " ms, load " << tLoad << " ms, " << fileSize("bench_saveMapBin.map") / (1024 * 1024) << " MB" << std::endl;
+	}
+	remove("bench_saveMapBin.map");
+
+	return 0;
+}
@@ -0,0 +1,167 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+
+#include "Algo/Simulation/ShapeMatching/shapeMatching.h"
+#include "Algo/Tiling/Surface/triangular.h"
+
+#include "Utils/cgognStream.h"
+#include "Utils/chrono.h"
+
+#include <cstdlib>
+#include <cmath>
+
+
+using namespace CGoGN ;
+
+struct PFP: public PFP_STANDARD
+{
+	typedef EmbeddedMap2 MAP;
+};
+
+typedef PFP::MAP MAP;
+typedef PFP::VEC3 VEC3;
+typedef PFP::REAL REAL;
+typedef Algo::Surface::Simulation::ShapeMatching::ShapeMatching<PFP> SM;
+
+/**
+ * soft body: a torus falling under gravity, pulled back to its rest shape
+ */
+struct Body
+{
+	MAP map;
+	VertexAttribute<VEC3, MAP> position;
+	VertexAttribute<REAL, MAP> mass;
+	VertexAttribute<VEC3, MAP> velocity;
+	VertexAttribute<VEC3, MAP> force;
+	SM* solver;
+
+	Body(unsigned int n, unsigned int nbth)
+	{
+		position = map.addAttribute<VEC3, VERTEX, MAP>("position");
+		mass = map.addAttribute<REAL, VERTEX, MAP>("mass");
+		velocity = map.addAttribute<VEC3, VERTEX, MAP>("velocity");
+		force = map.addAttribute<VEC3, VERTEX, MAP>("force");
+		Algo::Surface::Tilings::Triangular::Tore<PFP> tore(map, 2 * n, n);
+		tore.embedIntoTore(position, 3.0f, 1.0f);
+		mass.setAllValues(1.0f);
+		velocity.setAllValues(VEC3(0));
+		force.setAllValues(VEC3(0.0f, 0.0f, -9.81f));
+		solver = new SM(map, position, mass);
+		solver->initialize(nbth);
+	}
+
+	~Body()
+	{
+		delete solver;
+	}
+
+	void move(unsigned int nbth)
+	{
+		solver->computeVelocities(velocity, force, 0.01f, 0.5f, nbth);
+		solver->applyVelocities(velocity, 0.01f, nbth);
+	}
+};
+
+/**
+ * Bench of the shape matching solver: steps per second of one big body
+ * (parallel reductions) and of many small bodies (one solver per thread)
+ * usage: bench_shapeMatching [nb_bodies] [body_size] [big_body_size] [nb_steps] [nb_threads]
+ */
+int main(int argc, char** argv)
+{
+	unsigned int nbBodies = 1000;
+	unsigned int size = 10;
+	unsigned int bigSize = 500;
+	unsigned int nbSteps = 100;
+	unsigned int nbth = CGoGN::Parallel::NumberOfThreads;
+	if (argc > 1)
+		nbBodies = atoi(argv[1]);
+	if (argc > 2)
+		size = atoi(argv[2]);
+	if (argc > 3)
+		bigSize = atoi(argv[3]);
+	if (argc > 4)
+		nbSteps = atoi(argv[4]);
+	if (argc > 5)
+		nbth = atoi(argv[5]);
+
+	CGoGNout << nbth << " threads, " << nbSteps << " steps" << CGoGNendl;
+
+	{
+		Body body(bigSize, nbth);
+		Utils::Chrono ch;
+		ch.start();
+		for (unsigned int s = 0; s < nbSteps; ++s)
+		{
+			body.solver->shapeMatch(nbth);
+			body.move(nbth);
+		}
+		double t = ch.elapsed();
+		CGoGNout << "1 body of " << 2 * bigSize * bigSize << " vertices: " << 1000.0 * nbSteps / t << " steps/s" << CGoGNendl;
+	}
+
+	{
+		std::vector<Body*> bodies;
+		std::vector<SM*> solvers;
+		for (unsigned int i = 0; i < nbBodies; ++i)
+		{
+			bodies.push_back(new Body(size, 1));
+			solvers.push_back(bodies.back()->solver);
+		}
+
+		Utils::Chrono ch;
+		ch.start();
+		for (unsigned int s = 0; s < nbSteps; ++s)
+		{
+			for (unsigned int i = 0; i < nbBodies; ++i)
+			{
+				bodies[i]->solver->shapeMatch(1);
+				bodies[i]->move(1);
+			}
+		}
+		double t = ch.elapsed();
+		CGoGNout << nbBodies << " bodies of " << 2 * size * size << " vertices, one after the other: " << 1000.0 * nbSteps / t << " steps/s" << CGoGNendl;
+
+		ch.start();
+		for (unsigned int s = 0; s < nbSteps; ++s)
+		{
+			Algo::Surface::Simulation::ShapeMatching::Parallel::shapeMatch<PFP>(solvers, nbth);
+			CGoGN::Parallel::foreach_index(nbBodies, [&] (unsigned int i, unsigned int)
+			{
+				bodies[i]->move(1);
+			}, nbth);
+		}
+		t = ch.elapsed();
+		CGoGNout << nbBodies << " bodies of " << 2 * size * size << " vertices, batch: " << 1000.0 * nbSteps / t << " steps/s" << CGoGNendl;
+
+		for (unsigned int i = 0; i < nbBodies; ++i)
+			delete bodies[i];
+	}
+
+	return 0;
+}
@@ -0,0 +1,269 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+
+#include "Geometry/vector_gen.h"
+#include "Geometry/matrix.h"
+#include "Utils/cgognStream.h"
+#include "Utils/chrono.h"
+
+#include <vector>
+#include <random>
+#include <cstdlib>
+
+
+using namespace CGoGN ;
+
+/*
+ * scalar kernels written as the generic loops of Geom::Vector and Geom::Matrix
+ */
+
+template <unsigned int DIM, typename T>
+void addScalar(std::vector< Geom::Vector<DIM, T> >& a, const std::vector< Geom::Vector<DIM, T> >& b)
+{
+	for (unsigned int i = 0; i < a.size(); ++i)
+		for (unsigned int j = 0; j < DIM; ++j)
+			a[i][j] += b[i][j];
+}
+
+template <unsigned int DIM, typename T>
+T dotScalar(const std::vector< Geom::Vector<DIM, T> >& a, const std::vector< Geom::Vector<DIM, T> >& b)
+{
+	T sum(0);
+	for (unsigned int i = 0; i < a.size(); ++i)
+	{
+		T d(0);
+		for (unsigned int j = 0; j < DIM; ++j)
+			d += a[i][j] * b[i][j];
+		sum += d;
+	}
+	return sum;
+}
+
+// sum of the (unnormalized) normals of the triangles (a[i], b[i], c[i])
+template <typename T>
+Geom::Vector<3, T> normalScalar(const std::vector< Geom::Vector<3, T> >& a, const std::vector< Geom::Vector<3, T> >& b, const std::vector< Geom::Vector<3, T> >& c)
+{
+	Geom::Vector<3, T> sum(0);
+	for (unsigned int i = 0; i < a.size(); ++i)
+	{
+		T u[3], v[3];
+		for (unsigned int j = 0; j < 3; ++j)
+		{
+			u[j] = b[i][j] - a[i][j];
+			v[j] = c[i][j] - a[i][j];
+		}
+		sum[0] += u[1] * v[2] - u[2] * v[1];
+		sum[1] += u[2] * v[0] - u[0] * v[2];
+		sum[2] += u[0] * v[1] - u[1] * v[0];
+	}
+	return sum;
+}
+
+template <unsigned int N, typename T>
+void productScalar(std::vector< Geom::Matrix<N, N, T> >& r, const std::vector< Geom::Matrix<N, N, T> >& a, const Geom::Matrix<N, N, T>& b)
+{
+	for (unsigned int l = 0; l < a.size(); ++l)
+		for (unsigned int i = 0; i < N; ++i)
+			for (unsigned int j = 0; j < N; ++j)
+			{
+				T s(0);
+				for (unsigned int k = 0; k < N; ++k)
+					s += a[l](i,k) * b(k,j);
+				r[l](i,j) = s;
+			}
+}
+
+void transformScalar(std::vector<Geom::Vec4f>& r, const Geom::Matrix44f& m, const std::vector<Geom::Vec4f>& a)
+{
+	for (unsigned int l = 0; l < a.size(); ++l)
+		for (unsigned int i = 0; i < 4; ++i)
+		{
+			float s(0);
+			for (unsigned int j = 0; j < 4; ++j)
+				s += m(i,j) * a[l][j];
+			r[l][i] = s;
+		}
+}
+
+/*
+ * the same kernels with the operators (SIMD specializations when available)
+ */
+
+template <unsigned int DIM, typename T>
+void addVector(std::vector< Geom::Vector<DIM, T> >& a, const std::vector< Geom::Vector<DIM, T> >& b)
+{
+	for (unsigned int i = 0; i < a.size(); ++i)
+		a[i] += b[i];
+}
+
+template <unsigned int DIM, typename T>
+T dotVector(const std::vector< Geom::Vector<DIM, T> >& a, const std::vector< Geom::Vector<DIM, T> >& b)
+{
+	T sum(0);
+	for (unsigned int i = 0; i < a.size(); ++i)
+		sum += a[i] * b[i];
+	return sum;
+}
+
+template <typename T>
+Geom::Vector<3, T> normalVector(const std::vector< Geom::Vector<3, T> >& a, const std::vector< Geom::Vector<3, T> >& b, const std::vector< Geom::Vector<3, T> >& c)
+{
+	Geom::Vector<3, T> sum(0);
+	for (unsigned int i = 0; i < a.size(); ++i)
+		sum += (b[i] - a[i]) ^ (c[i] - a[i]);
+	return sum;
+}
+
+template <unsigned int N, typename T>
+void productMatrix(std::vector< Geom::Matrix<N, N, T> >& r, const std::vector< Geom::Matrix<N, N, T> >& a, const Geom::Matrix<N, N, T>& b)
+{
+	for (unsigned int l = 0; l < a.size(); ++l)
+		r[l] = a[l] * b;
+}
+
+void transformMatrix(std::vector<Geom::Vec4f>& r, const Geom::Matrix44f& m, const std::vector<Geom::Vec4f>& a)
+{
+	for (unsigned int l = 0; l < a.size(); ++l)
+		r[l] = m * a[l];
+}
+
+template <unsigned int DIM, typename T>
+std::vector< Geom::Vector<DIM, T> > randomVectors(unsigned int nb, std::mt19937& gen)
+{
+	std::uniform_real_distribution<T> dist(T(-1), T(1));
+	std::vector< Geom::Vector<DIM, T> > v(nb);
+	for (unsigned int i = 0; i < nb; ++i)
+		for (unsigned int j = 0; j < DIM; ++j)
+			v[i][j] = dist(gen);
+	return v;
+}
+
+template <unsigned int N, typename T>
+std::vector< Geom::Matrix<N, N, T> > randomMatrices(unsigned int nb, std::mt19937& gen)
+{
+	std::uniform_real_distribution<T> dist(T(-1), T(1));
+	std::vector< Geom::Matrix<N, N, T> > m(nb);
+	for (unsigned int l = 0; l < nb; ++l)
+		for (unsigned int i = 0; i < N; ++i)
+			for (unsigned int j = 0; j < N; ++j)
+				m[l](i,j) = dist(gen);
+	return m;
+}
+
+template <typename FUNC>
+double timing(unsigned int nbLoops, FUNC f)
+{
+	Utils::Chrono ch;
+	ch.start();
+	for (unsigned int k = 0; k < nbLoops; ++k)
+		f();
+	return ch.elapsed();
+}
+
+void printTimes(const std::string& name, double scalar, double simd)
+{
+	CGoGNout << name << ": scalar " << scalar << " ms, operators " << simd << " ms";
+	if (simd > 0)
+		CGoGNout << " (x" << scalar / simd << ")";
+	CGoGNout << CGoGNendl;
+}
+
+template <unsigned int DIM, typename T>
+void benchVectors(const std::string& name, unsigned int nb, unsigned int nbLoops, std::mt19937& gen)
+{
+	std::vector< Geom::Vector<DIM, T> > a = randomVectors<DIM, T>(nb, gen);
+	std::vector< Geom::Vector<DIM, T> > b = randomVectors<DIM, T>(nb, gen);
+	volatile T sink;
+
+	printTimes(name + " +=", timing(nbLoops, [&] () { addScalar(a, b); }), timing(nbLoops, [&] () { addVector(a, b); }));
+	printTimes(name + " dot", timing(nbLoops, [&] () { sink = dotScalar(a, b); }), timing(nbLoops, [&] () { sink = dotVector(a, b); }));
+	(void)sink;
+}
+
+template <typename T>
+void benchNormals(const std::string& name, unsigned int nb, unsigned int nbLoops, std::mt19937& gen)
+{
+	std::vector< Geom::Vector<3, T> > a = randomVectors<3, T>(nb, gen);
+	std::vector< Geom::Vector<3, T> > b = randomVectors<3, T>(nb, gen);
+	std::vector< Geom::Vector<3, T> > c = randomVectors<3, T>(nb, gen);
+	volatile T sink;
+
+	printTimes(name + " triangle normals", timing(nbLoops, [&] () { sink = normalScalar(a, b, c)[0]; }), timing(nbLoops, [&] () { sink = normalVector(a, b, c)[0]; }));
+	(void)sink;
+}
+
+template <unsigned int N, typename T>
+void benchMatrices(const std::string& name, unsigned int nb, unsigned int nbLoops, std::mt19937& gen)
+{
+	std::vector< Geom::Matrix<N, N, T> > a = randomMatrices<N, T>(nb, gen);
+	std::vector< Geom::Matrix<N, N, T> > r(nb);
+	Geom::Matrix<N, N, T> b = randomMatrices<N, T>(1, gen)[0];
+
+	printTimes(name + " product", timing(nbLoops, [&] () { productScalar(r, a, b); }), timing(nbLoops, [&] () { productMatrix(r, a, b); }));
+}
+
+/**
+ * Bench of the SIMD specializations of Geom::Vector and Geom::Matrix
+ * against the generic loops (kernels on small arrays that stay in cache)
+ * usage: bench_simd [nb_elements] [nb_loops]
+ */
+int main(int argc, char** argv)
+{
+	unsigned int nb = 4096;
+	unsigned int nbLoops = 20000;
+	if (argc > 1)
+		nb = atoi(argv[1]);
+	if (argc > 2)
+		nbLoops = atoi(argv[2]);
+
+#ifdef CGOGN_SIMD_AVX
+	CGoGNout << "SIMD: SSE2 + AVX" << CGoGNendl;
+#elif defined(CGOGN_SIMD_SSE2)
+	CGoGNout << "SIMD: SSE2" << CGoGNendl;
+#else
+	CGoGNout << "SIMD: none (generic loops)" << CGoGNendl;
+#endif
+	CGoGNout << nb << " elements, " << nbLoops << " loops" << CGoGNendl;
+
+	std::mt19937 gen(0);
+
+	benchVectors<3, float>("Vec3f", nb, nbLoops, gen);
+	benchVectors<4, float>("Vec4f", nb, nbLoops, gen);
+	benchVectors<3, double>("Vec3d", nb, nbLoops, gen);
+	benchNormals<float>("Vec3f", nb, nbLoops, gen);
+	benchNormals<double>("Vec3d", nb, nbLoops, gen);
+
+	benchMatrices<3, float>("Matrix33f", nb, nbLoops / 4, gen);
+	benchMatrices<3, double>("Matrix33d", nb, nbLoops / 4, gen);
+	benchMatrices<4, float>("Matrix44f", nb, nbLoops / 4, gen);
+
+	std::vector<Geom::Vec4f> points = randomVectors<4, float>(nb, gen);
+	std::vector<Geom::Vec4f> transformed(nb);
+	Geom::Matrix44f m = randomMatrices<4, float>(1, gen)[0];
+	printTimes("Matrix44f * Vec4f", timing(nbLoops, [&] () { transformScalar(transformed, m, points); }), timing(nbLoops, [&] () { transformMatrix(transformed, m, points); }));
+
+	return 0;
+}
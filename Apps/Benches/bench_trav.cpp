@@ -25,11 +25,15 @@
 
 #include "Topology/generic/parameters.h"
 #include "Topology/map/embeddedMap3.h"
+#include "Topology/generic/mapImpl/mapMonoAoS.h"
 #include "Algo/Tiling/Volume/cubic.h"
 #include "Algo/Geometry/area.h"
 #include "Algo/Geometry/volume.h"
 #include "Utils/chrono.h"
 
+#include <algorithm>
+#include <random>
+
 
 using namespace CGoGN ;
 
@@ -49,6 +53,52 @@ typedef PFP::MAP MAP;
 typedef PFP::MAP::IMPL MAP_IMPL;
 typedef PFP::VEC3 VEC3;
 
+/**
+ * topological map with a given storage of the relations (MapMono or MapMonoAoS)
+ */
+template <typename TOPO_MAP>
+struct PFP_TOPO: public PFP_DOUBLE
+{
+	typedef TOPO_MAP MAP;
+};
+
+/**
+ * Compare the storages of the topological relations on a grid of hexahedra:
+ * incident traversals and phi walks from darts taken in random order
+ */
+template <typename TOPO_MAP>
+void benchTopo(const std::string& name, int nb)
+{
+	TOPO_MAP topoMap;
+	Algo::Volume::Tilings::Cubic::Grid<PFP_TOPO<TOPO_MAP> > cubic(topoMap, nb, nb, nb);
+
+	Utils::Chrono ch;
+	ch.start();
+	unsigned int nbInc = 0;
+	foreach_cell<VOLUME>(topoMap, [&](Vol w)
+	{
+		foreach_incident3<VERTEX>(topoMap, w, [&](Vertex) { ++nbInc; });
+	});
+	CGoGNout << name << ": volume -> vertex traversal in " << ch.elapsed() << " ms (" << nbInc << ")" << CGoGNendl;
+
+	std::vector<Dart> darts;
+	darts.reserve(topoMap.getNbDarts());
+	for (Dart d = topoMap.begin(); d != topoMap.end(); topoMap.next(d))
+		darts.push_back(d);
+	std::shuffle(darts.begin(), darts.end(), std::mt19937(0));
+
+	ch.start();
+	unsigned int sum = 0;
+	for (std::vector<Dart>::const_iterator it = darts.begin(); it != darts.end(); ++it)
+	{
+		Dart d = *it;
+		for (int i = 0; i < 4; ++i)
+			d = topoMap.phi2(topoMap.phi3(topoMap.phi1(d)));
+		sum += d.index;
+	}
+	CGoGNout << name << ": random phi walks in " << ch.elapsed() << " ms (" << sum << ")" << CGoGNendl;
+}
+
 int main()
 {
 	// declare a map to handle the mesh
@@ -132,6 +182,8 @@ int main()
 
 	CGoGNout<< "Linear volume:" << ch.elapsed()<< " ms  val="<<vol<< CGoGNendl;
 
+	benchTopo< Map3<MapMono> >("separated relations (MapMono)", nb);
+	benchTopo< Map3<MapMonoAoS<> > >("interleaved relations (MapMonoAoS)", nb);
 
 	return 0;
 }
@@ -0,0 +1,116 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+
+#include "Algo/Geometry/triangleBatch.h"
+#include "Algo/Geometry/normal.h"
+#include "Algo/Geometry/area.h"
+#include "Algo/Geometry/laplacian.h"
+#include "Algo/Tiling/Surface/triangular.h"
+
+#include "Utils/cgognStream.h"
+#include "Utils/chrono.h"
+
+#include <cstdlib>
+
+
+using namespace CGoGN ;
+
+struct PFP: public PFP_STANDARD
+{
+	typedef EmbeddedMap2 MAP;
+};
+
+typedef PFP::MAP MAP;
+typedef PFP::VEC3 VEC3;
+typedef PFP::REAL REAL;
+
+template <typename FUNC>
+double timing(unsigned int nbLoops, FUNC f)
+{
+	Utils::Chrono ch;
+	ch.start();
+	for (unsigned int k = 0; k < nbLoops; ++k)
+		f();
+	return ch.elapsed() / nbLoops;
+}
+
+void printTimes(const std::string& name, double perVertex, double batch)
+{
+	CGoGNout << name << ": per vertex " << perVertex << " ms, batch " << batch << " ms (x" << perVertex / batch << ")" << CGoGNendl;
+}
+
+/**
+ * Bench of the batch kernels of TriangleBatch against the per vertex / per edge functions
+ * usage: bench_triangleBatch [tore_size] [nb_loops] [nb_threads]
+ */
+int main(int argc, char** argv)
+{
+	unsigned int n = 500;
+	unsigned int nbLoops = 5;
+	unsigned int nbth = CGoGN::Parallel::NumberOfThreads;
+	if (argc > 1)
+		n = atoi(argv[1]);
+	if (argc > 2)
+		nbLoops = atoi(argv[2]);
+	if (argc > 3)
+		nbth = atoi(argv[3]);
+
+	MAP map;
+	VertexAttribute<VEC3, MAP> position = map.addAttribute<VEC3, VERTEX, MAP>("position");
+	VertexAttribute<VEC3, MAP> normal = map.addAttribute<VEC3, VERTEX, MAP>("normal");
+	VertexAttribute<REAL, MAP> area = map.addAttribute<REAL, VERTEX, MAP>("area");
+	EdgeAttribute<REAL, MAP> weight = map.addAttribute<REAL, EDGE, MAP>("weight");
+	VertexAttribute<VEC3, MAP> laplacian = map.addAttribute<VEC3, VERTEX, MAP>("laplacian");
+
+	Algo::Surface::Tilings::Triangular::Tore<PFP> tore(map, n, n);
+	tore.embedIntoTore(position, 3.0f, 1.0f);
+	CGoGNout << 2 * n * n << " triangles, " << nbLoops << " loops, " << nbth << " threads" << CGoGNendl;
+
+	Utils::Chrono ch;
+	ch.start();
+	Algo::Surface::Geometry::TriangleBatch<PFP> batch(map, nbth);
+	CGoGNout << "extraction of the topology: " << ch.elapsed() << " ms" << CGoGNendl;
+
+	double tPos = timing(nbLoops, [&] () { batch.setPositions(position, nbth); });
+	CGoGNout << "setPositions: " << tPos << " ms" << CGoGNendl;
+
+	printTimes("vertex normals",
+		timing(nbLoops, [&] () { Algo::Surface::Geometry::computeNormalVertices<PFP>(map, position, normal); }),
+		timing(nbLoops, [&] () { batch.computeNormalVertices(normal, nbth); }));
+	printTimes("Voronoi areas",
+		timing(nbLoops, [&] () { Algo::Surface::Geometry::computeVoronoiAreaVertices<PFP>(map, position, area); }),
+		timing(nbLoops, [&] () { batch.computeVoronoiAreaVertices(area, nbth); }));
+	printTimes("cotan weights",
+		timing(nbLoops, [&] () { Algo::Surface::Geometry::computeCotanWeightEdges<PFP>(map, position, weight); }),
+		timing(nbLoops, [&] () { batch.computeCotanWeightEdges(weight, nbth); }));
+	printTimes("cotan Laplacian",
+		timing(nbLoops, [&] () { Algo::Surface::Geometry::computeLaplacianCotanVertices<PFP, VEC3>(map, weight, area, position, laplacian); }),
+		timing(nbLoops, [&] () { batch.computeLaplacianCotanVertices(position, laplacian, nbth); }));
+
+	return 0;
+}
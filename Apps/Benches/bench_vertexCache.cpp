@@ -0,0 +1,132 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+#include "Algo/Tiling/Surface/triangular.h"
+#include "Algo/Render/GL2/mapRender.h"
+#include "Algo/Render/vertexCache.h"
+#include "Utils/chrono.h"
+
+#include <algorithm>
+#include <random>
+#include <sstream>
+#include <cstdlib>
+
+
+using namespace CGoGN ;
+
+struct PFP: public PFP_STANDARD
+{
+	typedef EmbeddedMap2 MAP;
+};
+
+typedef PFP::MAP MAP;
+typedef PFP::VEC3 VEC3;
+typedef Algo::Render::GL2::MapRender MapRender;
+namespace VertexCache = Algo::Render::VertexCache;
+
+void printMetrics(const std::string& name, const std::vector<GLuint>& indices)
+{
+	CGoGNout << name << ":";
+	const unsigned int sizes[3] = { 8, 16, 32 };
+	for (unsigned int i = 0; i < 3; ++i)
+		CGoGNout << "  cache " << sizes[i] << " ACMR=" << VertexCache::computeACMR(indices, sizes[i]) << " ATVR=" << VertexCache::computeATVR(indices, sizes[i]);
+	CGoGNout << CGoGNendl;
+}
+
+/// read the positions in the order of the index table (as the vertex fetch does)
+double fetch(const VertexAttribute<VEC3, MAP>& position, const std::vector<GLuint>& indices)
+{
+	Utils::Chrono ch;
+	ch.start();
+	VEC3 sum(0);
+	for (unsigned int k = 0; k < 10; ++k)
+		for (std::vector<GLuint>::const_iterator it = indices.begin(); it != indices.end(); ++it)
+			sum += position[*it];
+	double t = ch.elapsed();
+	CGoGNout << "  (" << sum << ")" << CGoGNendl;
+	return t;
+}
+
+/**
+ * Headless bench of the post-transform vertex cache optimization (ACMR / ATVR)
+ * and of the vertex fetch reordering of the vertex container
+ */
+int main(int argc, char** argv)
+{
+	unsigned int nb = 500;
+	if (argc > 1)
+		nb = atoi(argv[1]);
+
+	MAP myMap;
+	VertexAttribute<VEC3, MAP> position = myMap.addAttribute<VEC3, VERTEX, MAP>("position");
+	Algo::Surface::Tilings::Triangular::Grid<PFP> grid(myMap, nb, nb, true);
+	grid.embedIntoGrid(position, 1.0f, 1.0f, 0.0f);
+
+	// shuffle the vertex container (as after an import or some modifications)
+	std::vector<unsigned int> lines;
+	const AttributeContainer& cont = myMap.getAttributeContainer<VERTEX>();
+	for (unsigned int i = cont.realBegin(); i != cont.realEnd(); cont.realNext(i))
+		lines.push_back(i);
+	std::vector<unsigned int> shuffled(lines);
+	std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937(0));
+	std::vector<unsigned int> mapOldNew(cont.realEnd());
+	for (unsigned int i = 0; i < lines.size(); ++i)
+		mapOldNew[lines[i]] = shuffled[i];
+	myMap.permuteOrbitContainer(VERTEX, mapOldNew);
+
+	std::vector<GLuint> indices;
+	MapRender::initTriangles<PFP>(myMap, indices, &position);
+	CGoGNout << indices.size() / 3 << " triangles" << CGoGNendl;
+	printMetrics("initTriangles", indices);
+
+	std::vector<GLuint> local;
+	MapRender::initTrianglesOptimized<PFP>(myMap, local, &position);
+	printMetrics("initTrianglesOptimized", local);
+
+	Utils::Chrono ch;
+	for (unsigned int i = 0; i < 3; ++i)
+	{
+		const unsigned int cacheSize = 8u << i;
+		std::vector<GLuint> optimized(indices);
+		ch.start();
+		VertexCache::optimizeTriangles(optimized, cacheSize);
+		double t = ch.elapsed();
+		std::stringstream ss;
+		ss << "optimizeTriangles(" << cacheSize << ") in " << t << " ms";
+		printMetrics(ss.str(), optimized);
+	}
+
+	VertexCache::optimizeTriangles(indices);
+	double before = fetch(position, indices);
+	ch.start();
+	VertexCache::reorderVertices(myMap, indices);
+	double t = ch.elapsed();
+	double after = fetch(position, indices);
+	CGoGNout << "reorderVertices in " << t << " ms, fetch of positions " << before << " ms -> " << after << " ms" << CGoGNendl;
+
+	return 0;
+}
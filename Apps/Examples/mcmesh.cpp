@@ -168,7 +168,7 @@ void MCMesh::MC()
 {
 	myMap.clear(false);
 	// elargir l'image pour le calcul de la courbure
-	SAlgo::MC::Image<DATATYPE>* myImgFr = myImg->addFrame(1);
+	SAlgo::MC::Image<DATATYPE>* myImgFr = myImg->addFrame(1, true);
 
 	SAlgo::MC::WindowingGreater<DATATYPE> myWindFunc;
 	myWindFunc.setIsoValue(DATATYPE(127));
@@ -5,6 +5,16 @@
 
 
 #include "Algo/Export/exportVTU.h"
+#include "Algo/Modelisation/polyhedron.h"
+#include "Utils/threadPool.h"
+
+#include "zlib.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <vector>
 
 using namespace CGoGN;
 
@@ -25,8 +35,165 @@ struct PFP2 : public PFP_STANDARD
 
 template class Algo::Volume::Export::VTUExporter<PFP2>;
 
+typedef std::vector<unsigned char> Bytes;
+
+// read the arrays of the appended data of a vtu file (raw or compressed)
+static bool readAppendedArrays(const char* filename, bool compressed, std::vector<Bytes>& arrays)
+{
+	std::ifstream fin(filename, std::ios::in | std::ios::binary);
+	std::stringstream ss;
+	ss << fin.rdbuf();
+	std::string content = ss.str();
+
+	size_t pos = content.find("<AppendedData");
+	if (pos == std::string::npos)
+		return false;
+	pos = content.find('_', pos) + 1;
+	size_t end = content.rfind("</AppendedData>") - 1;	// endl written after data
+
+	const unsigned char* data = reinterpret_cast<const unsigned char*>(content.data());
+	arrays.clear();
+	while (pos < end)
+	{
+		const unsigned int* header = reinterpret_cast<const unsigned int*>(data + pos);
+		Bytes array;
+		if (!compressed)
+		{
+			array.assign(data + pos + 4, data + pos + 4 + header[0]);
+			pos += 4 + header[0];
+		}
+		else
+		{
+			unsigned int nbBlocks = header[0];
+			pos += 4 * (3 + nbBlocks);
+			for (unsigned int b = 0; b < nbBlocks; ++b)
+			{
+				uLongf size = (b == nbBlocks - 1 && header[2] != 0) ? header[2] : header[1];
+				Bytes block(size);
+				if (uncompress(&block[0], &size, data + pos, header[3 + b]) != Z_OK)
+					return false;
+				array.insert(array.end(), block.begin(), block.begin() + size);
+				pos += header[3 + b];
+			}
+		}
+		arrays.push_back(array);
+	}
+	return pos == end;
+}
+
 int test_exportVTU()
 {
+	int nbErrors = 0;
+
+	// blocks of compressed data, gathered in parallel
+	{
+		std::vector<unsigned int> values(300000);
+		for (unsigned int i = 0; i < values.size(); ++i)
+			values[i] = (i * 7919u) % 1000u;
+
+		Utils::ThreadPool pool(3);
+		FILE* f = tmpfile();
+		unsigned int nbBytes = Utils::zlibVTUWriteCompressed(uint32(values.size() * sizeof(unsigned int)),
+			Utils::gatherElements<unsigned int>([&] (unsigned int k) { return values[k]; }), f, 1, &pool, 3);
+		if ((long)nbBytes != ftell(f))
+			++nbErrors;
+
+		Bytes buffer(nbBytes);
+		rewind(f);
+		if (fread(&buffer[0], 1, nbBytes, f) != nbBytes)
+			++nbErrors;
+		fclose(f);
+
+		const unsigned int* header = reinterpret_cast<const unsigned int*>(&buffer[0]);
+		Bytes decoded;
+		unsigned int pos = 4 * (3 + header[0]);
+		for (unsigned int b = 0; b < header[0]; ++b)
+		{
+			uLongf size = header[1];
+			Bytes block(size);
+			if (uncompress(&block[0], &size, &buffer[pos], header[3 + b]) != Z_OK)
+				++nbErrors;
+			decoded.insert(decoded.end(), block.begin(), block.begin() + size);
+			pos += header[3 + b];
+		}
+		if (decoded.size() != values.size() * sizeof(unsigned int) || memcmp(&decoded[0], &values[0], decoded.size()) != 0)
+			++nbErrors;
+	}
+
+	// surface: compressed export gives the same arrays as raw export
+	{
+		PFP1::MAP map;
+		VertexAttribute<PFP1::VEC3, PFP1::MAP> position = map.addAttribute<PFP1::VEC3, VERTEX, PFP1::MAP>("position");
+		FaceAttribute<float, PFP1::MAP> area = map.addAttribute<float, FACE, PFP1::MAP>("area");
+
+		for (unsigned int i = 0; i < 10000; ++i)
+		{
+			Dart d = map.newFace(3 + i % 3);
+			area[d] = float(i);
+			Dart e = d;
+			do
+			{
+				position[e] = PFP1::VEC3(float(i), float(e.index), 0.0f);
+				e = map.phi1(e);
+			} while (e != d);
+		}
+
+		std::vector<Bytes> raw, compressed;
+		for (unsigned int level = 0; level < 10; level += 9)
+		{
+			Algo::Surface::Export::VTUExporter<PFP1> exporter(map, position);
+			exporter.init("test_exportVTU_surface.vtu", true, level, 2);
+			exporter.addVertexAttribute(position, "Float32");
+			exporter.endVertexAttributes();
+			exporter.addFaceAttribute(area, "Float32");
+			exporter.endFaceAttributes();
+			exporter.close();
+
+			if (!readAppendedArrays("test_exportVTU_surface.vtu", level > 0, level > 0 ? compressed : raw))
+				++nbErrors;
+		}
+		if (raw.size() != 6 || raw != compressed)
+			++nbErrors;
+		remove("test_exportVTU_surface.vtu");
+	}
+
+	// volume: tetrahedra and hexahedra
+	{
+		PFP2::MAP map;
+		VertexAttribute<PFP2::VEC3, PFP2::MAP> position = map.addAttribute<PFP2::VEC3, VERTEX, PFP2::MAP>("position");
+		VolumeAttribute<int, PFP2::MAP> label = map.addAttribute<int, VOLUME, PFP2::MAP>("label");
+
+		for (unsigned int i = 0; i < 100; ++i)
+		{
+			Dart d = (i % 2 == 0) ? Algo::Surface::Modelisation::createTetrahedron<PFP2>(map) : Algo::Surface::Modelisation::createHexahedron<PFP2>(map);
+			label[d] = int(i);
+		}
+		unsigned int k = 0;
+		TraversorV<PFP2::MAP> tv(map);
+		for (Dart d = tv.begin(); d != tv.end(); d = tv.next())
+			position[d] = PFP2::VEC3(float(k++), 0.0f, 1.0f);
+
+		std::vector<Bytes> raw, compressed;
+		for (unsigned int level = 0; level < 10; level += 9)
+		{
+			Algo::Volume::Export::VTUExporter<PFP2> exporter(map, position);
+			exporter.init("test_exportVTU_volume.vtu", true, level, 2);
+			exporter.addVolumeAttribute(label, "Int32");
+			exporter.endVolumeAttributes();
+			exporter.close();
+
+			if (!readAppendedArrays("test_exportVTU_volume.vtu", level > 0, level > 0 ? compressed : raw))
+				++nbErrors;
+		}
+		if (raw.size() != 5 || raw != compressed)
+			++nbErrors;
+		// connectivity of 50 tetras and 50 hexas, offset of the last cell
+		else if (raw[2].size() != 4 * (50 * 4 + 50 * 8) ||
+			reinterpret_cast<const unsigned int*>(&raw[3][0])[99] != 50 * 4 + 50 * 8)
+			++nbErrors;
+		remove("test_exportVTU_volume.vtu");
+	}
 
-	return 0;
+	std::cout << "exportVTU: " << (nbErrors == 0 ? "ok" : "differs") << std::endl;
+	return nbErrors;
 }
\ No newline at end of file
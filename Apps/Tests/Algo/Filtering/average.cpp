@@ -5,6 +5,9 @@
 
 
 #include "Algo/Filtering/average.h"
+#include "Algo/Tiling/Surface/triangular.h"
+
+#include <iostream>
 
 using namespace CGoGN;
 
@@ -73,8 +76,41 @@ template void Algo::Surface::Filtering::filterAverageFaceAttribute_WithinSphere<
 	const FaceAttribute<Geom::Vec3f, PFP3::MAP>& attIn, FaceAttribute<Geom::Vec3f, PFP3::MAP>& attOut, int neigh,
 	VertexAttribute<PFP3::VEC3, PFP3::MAP>& position, PFP3::REAL radius);
 
+template void Algo::Surface::Filtering::Parallel::filterAverageVertexAttribute_WithinSphere<PFP2, Geom::Vec3f>(PFP2::MAP& map,
+	const VertexAttribute<Geom::Vec3f, PFP2::MAP>& attIn, VertexAttribute<Geom::Vec3f, PFP2::MAP>& attOut, int neigh,
+	VertexAttribute<PFP2::VEC3, PFP2::MAP>& position, PFP2::REAL radius, unsigned int nbth);
+
+template void Algo::Surface::Filtering::Parallel::filterAverageEdgeAttribute_WithinSphere<PFP2, Geom::Vec3f>(PFP2::MAP& map,
+	const EdgeAttribute<Geom::Vec3f, PFP2::MAP>& attIn, EdgeAttribute<Geom::Vec3f, PFP2::MAP>& attOut, int neigh,
+	VertexAttribute<PFP2::VEC3, PFP2::MAP>& position, PFP2::REAL radius, unsigned int nbth);
+
+template void Algo::Surface::Filtering::Parallel::filterAverageFaceAttribute_WithinSphere<PFP2, Geom::Vec3f>(PFP2::MAP& map,
+	const FaceAttribute<Geom::Vec3f, PFP2::MAP>& attIn, FaceAttribute<Geom::Vec3f, PFP2::MAP>& attOut, int neigh,
+	VertexAttribute<PFP2::VEC3, PFP2::MAP>& position, PFP2::REAL radius, unsigned int nbth);
+
+template void Algo::Surface::Filtering::Parallel::filterAverageVertexAttribute_WithinSphere<PFP3, Geom::Vec3f>(PFP3::MAP& map,
+	const VertexAttribute<Geom::Vec3f, PFP3::MAP>& attIn, VertexAttribute<Geom::Vec3f, PFP3::MAP>& attOut, int neigh,
+	VertexAttribute<PFP3::VEC3, PFP3::MAP>& position, PFP3::REAL radius, unsigned int nbth);
+
 int test_average()
 {
-
-	return 0;
+	// the parallel within sphere filter collects the same vertices in the same order
+	PFP2::MAP map;
+	VertexAttribute<PFP2::VEC3, PFP2::MAP> position = map.addAttribute<PFP2::VEC3, VERTEX, PFP2::MAP>("position");
+	VertexAttribute<PFP2::VEC3, PFP2::MAP> smooth1 = map.addAttribute<PFP2::VEC3, VERTEX, PFP2::MAP>("smooth1");
+	VertexAttribute<PFP2::VEC3, PFP2::MAP> smooth2 = map.addAttribute<PFP2::VEC3, VERTEX, PFP2::MAP>("smooth2");
+	Algo::Surface::Tilings::Triangular::Tore<PFP2> tore(map, 40, 20);
+	tore.embedIntoTore(position, 3.0f, 1.0f);
+
+	bool ok = true;
+	int neighs[3] = { Algo::Surface::Filtering::INSIDE, Algo::Surface::Filtering::BORDER, Algo::Surface::Filtering::INSIDE | Algo::Surface::Filtering::BORDER };
+	for (int neigh : neighs)
+	{
+		Algo::Surface::Filtering::filterAverageVertexAttribute_WithinSphere<PFP2, PFP2::VEC3>(map, position, smooth1, neigh, position, 0.8);
+		Algo::Surface::Filtering::Parallel::filterAverageVertexAttribute_WithinSphere<PFP2, PFP2::VEC3>(map, position, smooth2, neigh, position, 0.8, 4);
+		foreach_cell<VERTEX>(map, [&] (Vertex v) { ok &= smooth1[v] == smooth2[v]; });
+	}
+
+	std::cout << "filterAverageVertexAttribute_WithinSphere: " << (ok ? "ok" : "differs") << std::endl;
+	return ok ? 0 : 1;
 }
\ No newline at end of file
@@ -4,6 +4,10 @@
 
 
 #include "Algo/Filtering/taubin.h"
+#include "Algo/Tiling/Surface/triangular.h"
+
+#include <iostream>
+#include <cmath>
 
 using namespace CGoGN;
 
@@ -45,8 +49,40 @@ template void Algo::Surface::Filtering::filterTaubin_modified<PFP3>(PFP3::MAP& m
 	VertexAttribute<PFP3::VEC3, PFP3::MAP>& position, VertexAttribute<PFP3::VEC3, PFP3::MAP>& position2, PFP3::REAL radius);
 
 
+template void Algo::Surface::Filtering::Parallel::filterTaubin_modified<PFP1>(PFP1::MAP& map,
+	VertexAttribute<PFP1::VEC3, PFP1::MAP>& position, VertexAttribute<PFP1::VEC3, PFP1::MAP>& position2, PFP1::REAL radius, unsigned int nbth);
+
+template void Algo::Surface::Filtering::Parallel::filterTaubin_modified<PFP2>(PFP2::MAP& map,
+	VertexAttribute<PFP2::VEC3, PFP2::MAP>& position, VertexAttribute<PFP2::VEC3, PFP2::MAP>& position2, PFP2::REAL radius, unsigned int nbth);
+
+template void Algo::Surface::Filtering::Parallel::filterTaubin_modified<PFP3>(PFP3::MAP& map,
+	VertexAttribute<PFP3::VEC3, PFP3::MAP>& position, VertexAttribute<PFP3::VEC3, PFP3::MAP>& position2, PFP3::REAL radius, unsigned int nbth);
+
+
 int test_taubin()
 {
-
-		return 0;
+	// the parallel modified Taubin filter gives the same positions
+	PFP2::MAP map;
+	VertexAttribute<PFP2::VEC3, PFP2::MAP> position = map.addAttribute<PFP2::VEC3, VERTEX, PFP2::MAP>("position");
+	VertexAttribute<PFP2::VEC3, PFP2::MAP> positionPar = map.addAttribute<PFP2::VEC3, VERTEX, PFP2::MAP>("positionPar");
+	VertexAttribute<PFP2::VEC3, PFP2::MAP> position2 = map.addAttribute<PFP2::VEC3, VERTEX, PFP2::MAP>("position2");
+	Algo::Surface::Tilings::Triangular::Tore<PFP2> tore(map, 40, 20);
+	tore.embedIntoTore(position, 3.0f, 1.0f);
+	foreach_cell<VERTEX>(map, [&] (Vertex v)
+	{
+		position[v][2] += 0.05 * std::sin(7.0 * position[v][0]);
+		positionPar[v] = position[v];
+	});
+
+	for (unsigned int i = 0; i < 3; ++i)
+	{
+		Algo::Surface::Filtering::filterTaubin_modified<PFP2>(map, position, position2, 0.6);
+		Algo::Surface::Filtering::Parallel::filterTaubin_modified<PFP2>(map, positionPar, position2, 0.6, 4);
+	}
+
+	bool ok = true;
+	foreach_cell<VERTEX>(map, [&] (Vertex v) { ok &= position[v] == positionPar[v]; });
+
+	std::cout << "filterTaubin_modified: " << (ok ? "ok" : "differs") << std::endl;
+	return ok ? 0 : 1;
 }
\ No newline at end of file
@@ -7,6 +7,9 @@ extern int test_basic();
 extern int test_convexity();
 extern int test_curvature();
 extern int test_distances();
+extern int test_faceBVH();
+extern int test_kdTree();
+extern int test_triangleBatch();
 
 
 int main()
@@ -18,6 +21,9 @@ int main()
 	test_convexity();
 	test_curvature();
 	test_distances();
+	test_faceBVH();
+	test_kdTree();
+	test_triangleBatch();
 
 	return 0;
 }
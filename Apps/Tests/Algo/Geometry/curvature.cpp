@@ -4,6 +4,11 @@
 #include "Topology/map/embeddedMap2.h"
 
 #include "Algo/Geometry/curvature.h"
+#include "Algo/Geometry/normal.h"
+#include "Algo/Geometry/area.h"
+#include "Algo/Tiling/Surface/triangular.h"
+
+#include <cmath>
 
 using namespace CGoGN;
 
@@ -250,6 +255,20 @@ template void Algo::Surface::Geometry::computeCurvatureVertex_NormalCycles<PFP2>
 	VertexAttribute<PFP2::VEC3, PFP2::MAP>& Knormal
 	);
 
+template void Algo::Surface::Geometry::computeCurvatureVertex_NormalCycles<PFP2>(
+	PFP2::MAP& map,
+	Vertex v,
+	Algo::Surface::Selection::Collector<PFP2>& neigh,
+	const VertexAttribute<PFP2::VEC3, PFP2::MAP>& position,
+	const VertexAttribute<PFP2::VEC3, PFP2::MAP>& normal,
+	const EdgeAttribute<PFP2::REAL, PFP2::MAP>& edgeangle,
+	const EdgeAttribute<PFP2::REAL, PFP2::MAP>& edgearea,
+	VertexAttribute<PFP2::REAL, PFP2::MAP>& kmax,
+	VertexAttribute<PFP2::REAL, PFP2::MAP>& kmin,
+	VertexAttribute<PFP2::VEC3, PFP2::MAP>& Kmax,
+	VertexAttribute<PFP2::VEC3, PFP2::MAP>& Kmin,
+	VertexAttribute<PFP2::VEC3, PFP2::MAP>& Knormal);
+
 template void Algo::Surface::Geometry::computeCurvatureVertices_NormalCycles_Projected<PFP2>(
 	PFP2::MAP& map,
 	PFP2::REAL radius,
@@ -468,5 +487,39 @@ template void Algo::Surface::Geometry::normalCycles_ProjectTensor<PFP3>(Geom::Ma
 
 int test_curvature()
 {
-	return 0;
+	// the parallel normal cycles (kd-tree neighborhoods) give the same curvatures as the sequential ones
+	typedef PFP2::MAP MAP;
+	MAP map;
+	VertexAttribute<PFP2::VEC3, MAP> position = map.addAttribute<PFP2::VEC3, VERTEX, MAP>("position");
+	VertexAttribute<PFP2::VEC3, MAP> normal = map.addAttribute<PFP2::VEC3, VERTEX, MAP>("normal");
+	EdgeAttribute<PFP2::REAL, MAP> edgeangle = map.addAttribute<PFP2::REAL, EDGE, MAP>("edgeangle");
+	EdgeAttribute<PFP2::REAL, MAP> edgearea = map.addAttribute<PFP2::REAL, EDGE, MAP>("edgearea");
+	VertexAttribute<PFP2::REAL, MAP> kmax[2] = { map.addAttribute<PFP2::REAL, VERTEX, MAP>("kmax1"), map.addAttribute<PFP2::REAL, VERTEX, MAP>("kmax2") };
+	VertexAttribute<PFP2::REAL, MAP> kmin[2] = { map.addAttribute<PFP2::REAL, VERTEX, MAP>("kmin1"), map.addAttribute<PFP2::REAL, VERTEX, MAP>("kmin2") };
+	VertexAttribute<PFP2::VEC3, MAP> Kmax = map.addAttribute<PFP2::VEC3, VERTEX, MAP>("Kmax");
+	VertexAttribute<PFP2::VEC3, MAP> Kmin = map.addAttribute<PFP2::VEC3, VERTEX, MAP>("Kmin");
+	VertexAttribute<PFP2::VEC3, MAP> Knormal = map.addAttribute<PFP2::VEC3, VERTEX, MAP>("Knormal");
+
+	Algo::Surface::Tilings::Triangular::Tore<PFP2> tore(map, 40, 20);
+	tore.embedIntoTore(position, 3.0f, 1.0f);
+	Algo::Surface::Geometry::computeNormalVertices<PFP2>(map, position, normal);
+	Algo::Surface::Geometry::computeAnglesBetweenNormalsOnEdges<PFP2>(map, position, edgeangle);
+	Algo::Surface::Geometry::computeAreaEdges<PFP2>(map, position, edgearea);
+
+	unsigned int nbth = CGoGN::Parallel::NumberOfThreads;
+	for (unsigned int i = 0; i < 2; ++i)
+	{
+		CGoGN::Parallel::NumberOfThreads = (i == 0) ? 1 : 4;
+		Algo::Surface::Geometry::computeCurvatureVertices_NormalCycles<PFP2>(map, 0.5, position, normal, edgeangle, edgearea, kmax[i], kmin[i], Kmax, Kmin, Knormal);
+	}
+	CGoGN::Parallel::NumberOfThreads = nbth;
+
+	bool ok = true;
+	foreach_cell<VERTEX>(map, [&] (Vertex v)
+	{
+		ok &= std::abs(kmax[0][v] - kmax[1][v]) < 1e-9 && std::abs(kmin[0][v] - kmin[1][v]) < 1e-9;
+	});
+
+	std::cout << "computeCurvatureVertices_NormalCycles: " << (ok ? "ok" : "differs") << std::endl;
+	return ok ? 0 : 1;
 }
@@ -4,6 +4,9 @@
 #include "Topology/map/embeddedMap3.h"
 
 #include "Algo/Geometry/distances.h"
+#include "Algo/Tiling/Surface/square.h"
+
+#include <cmath>
 
 using namespace CGoGN;
 
@@ -36,9 +39,60 @@ template PFP3::REAL Algo::Geometry::squaredDistancePoint2FacePlane<PFP3>(PFP3::M
 template PFP3::REAL Algo::Geometry::squaredDistancePoint2Face<PFP3>(PFP3::MAP& map, Face f, const VertexAttribute<PFP3::VEC3, PFP3::MAP>& position, const PFP3::VEC3& P);
 template PFP3::REAL Algo::Geometry::squaredDistancePoint2Edge<PFP3>(PFP3::MAP& map, Edge e, const VertexAttribute<PFP3::VEC3, PFP3::MAP>& position, const PFP3::VEC3& P);
 
+template Algo::Geometry::DistanceStats<PFP1::REAL> Algo::Geometry::computeDistance<PFP1>(PFP1::MAP& map1, const VertexAttribute<PFP1::VEC3, PFP1::MAP>& position1, VertexAttribute<PFP1::REAL, PFP1::MAP>& distance1, PFP1::MAP& map2, const VertexAttribute<PFP1::VEC3, PFP1::MAP>& position2, unsigned int nbth);
+template Algo::Geometry::DistanceStats<PFP2::REAL> Algo::Geometry::computeDistance<PFP2>(PFP2::MAP& map1, const VertexAttribute<PFP2::VEC3, PFP2::MAP>& position1, VertexAttribute<PFP2::REAL, PFP2::MAP>& distance1, PFP2::MAP& map2, const VertexAttribute<PFP2::VEC3, PFP2::MAP>& position2, unsigned int nbth);
+template Algo::Geometry::DistanceStats<PFP3::REAL> Algo::Geometry::computeDistance<PFP3>(PFP3::MAP& map1, const VertexAttribute<PFP3::VEC3, PFP3::MAP>& position1, VertexAttribute<PFP3::REAL, PFP3::MAP>& distance1, PFP3::MAP& map2, const VertexAttribute<PFP3::VEC3, PFP3::MAP>& position2, unsigned int nbth);
+
 
 
 int test_distances()
 {
-	return 0;
+	// bumpy grid against a coarser tilted grid
+	PFP2::MAP map1;
+	VertexAttribute<PFP2::VEC3, PFP2::MAP> position1 = map1.addAttribute<PFP2::VEC3, VERTEX, PFP2::MAP>("position");
+	VertexAttribute<PFP2::REAL, PFP2::MAP> distance1 = map1.addAttribute<PFP2::REAL, VERTEX, PFP2::MAP>("distance");
+	Algo::Surface::Tilings::Square::Grid<PFP2> grid1(map1, 40, 40, true);
+	grid1.embedIntoGrid(position1, 2.0f, 2.0f, 0.0f);
+	foreach_cell<VERTEX>(map1, [&] (Vertex v)
+	{
+		PFP2::VEC3& p = position1[v];
+		p[2] = 0.2 * std::sin(4.0 * p[0]) * std::cos(3.0 * p[1]);
+	});
+
+	PFP2::MAP map2;
+	VertexAttribute<PFP2::VEC3, PFP2::MAP> position2 = map2.addAttribute<PFP2::VEC3, VERTEX, PFP2::MAP>("position");
+	Algo::Surface::Tilings::Square::Grid<PFP2> grid2(map2, 15, 15, true);
+	grid2.embedIntoGrid(position2, 3.0f, 3.0f, 0.0f);
+	foreach_cell<VERTEX>(map2, [&] (Vertex v)
+	{
+		PFP2::VEC3& p = position2[v];
+		p[2] = 0.1 * p[0] + 0.3 * p[1] * p[1];
+	});
+
+	Algo::Geometry::DistanceStats<PFP2::REAL> s1 = Algo::Geometry::computeDistance<PFP2>(map1, position1, distance1, map2, position2, 1);
+	Algo::Geometry::DistanceStats<PFP2::REAL> s4 = Algo::Geometry::computeDistance<PFP2>(map1, position1, distance1, map2, position2, 4);
+
+	// brute force
+	double sum = 0.0;
+	double max = 0.0;
+	bool ok = s1.nbVertices == 41 * 41 && s4.nbVertices == s1.nbVertices;
+	foreach_cell<VERTEX>(map1, [&] (Vertex v)
+	{
+		double d2 = std::numeric_limits<double>::max();
+		foreach_cell<FACE>(map2, [&] (Face f)
+		{
+			d2 = std::min(d2, Algo::Geometry::squaredDistancePoint2Face<PFP2>(map2, f, position2, position1[v]));
+		});
+		double d = std::sqrt(d2);
+		ok &= std::abs(d - distance1[v]) < 1e-12;
+		sum += d;
+		max = std::max(max, d);
+	});
+
+	ok &= std::abs(s1.max - max) < 1e-12 && std::abs(s4.max - max) < 1e-12;
+	ok &= std::abs(s1.mean - sum / s1.nbVertices) < 1e-9 && std::abs(s4.mean - s1.mean) < 1e-9;
+	ok &= s1.min <= s1.mean && s1.mean <= s1.rms && s1.rms <= s1.max;
+
+	std::cout << "computeDistance: " << (ok ? "ok" : "differs") << std::endl;
+	return ok ? 0 : 1;
 }
\ No newline at end of file
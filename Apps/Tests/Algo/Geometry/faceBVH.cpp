@@ -0,0 +1,109 @@
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+#include "Topology/map/embeddedMap3.h"
+
+#include "Algo/Geometry/faceBVH.h"
+#include "Algo/Selection/raySelector.h"
+#include "Algo/Tiling/Surface/square.h"
+
+
+using namespace CGoGN;
+
+struct PFP1 : public PFP_STANDARD
+{
+	typedef EmbeddedMap2 MAP;
+};
+
+struct PFP2 : public PFP_DOUBLE
+{
+	typedef EmbeddedMap2 MAP;
+};
+
+struct PFP3 : public PFP_DOUBLE
+{
+	typedef EmbeddedMap3 MAP;
+};
+
+
+/*****************************************
+*		 INSTANTIATION
+*****************************************/
+
+template class Algo::Geometry::FaceBVH<PFP1>;
+template class Algo::Geometry::FaceBVH<PFP2>;
+template class Algo::Geometry::FaceBVH<PFP3>;
+
+
+/// compare the selections with and without BVH on rays through a bumpy grid
+bool compareRaySelections(PFP2::MAP& map, const VertexAttribute<PFP2::VEC3, PFP2::MAP>& position, const Algo::Geometry::FaceBVH<PFP2>& bvh)
+{
+	bool ok = true;
+	for (unsigned int i = 0; i < 100; ++i)
+	{
+		PFP2::VEC3 rayA(0.37 * (i % 10) - 1.5, 0.29 * (i / 10) - 1.3, 5.0);
+		PFP2::VEC3 rayAB(0.05 * std::sin(double(i)), 0.05 * std::cos(double(i)), -1.0);
+
+		std::vector<Face> f1, f2;
+		std::vector<PFP2::VEC3> p1, p2;
+		Algo::Selection::facesRaySelection<PFP2>(map, position, rayA, rayAB, f1, p1);
+		Algo::Selection::facesRaySelection<PFP2>(map, position, bvh, rayA, rayAB, f2, p2);
+		ok &= f1.size() == f2.size();
+		if (!f1.empty() && !f2.empty())
+			ok &= std::abs((p1[0] - rayA).norm2() - (p2[0] - rayA).norm2()) < 1e-12;
+
+		Face f;
+		Algo::Selection::faceRaySelection<PFP2>(map, position, bvh, rayA, rayAB, f);
+		ok &= f1.empty() ? f.dart == NIL : (p1[0] - rayA).norm2() == (p2[0] - rayA).norm2();
+
+		std::vector<Vertex> v1, v2;
+		Algo::Selection::verticesRaySelection<PFP2>(map, position, rayA, rayAB, v1, 0.05f);
+		Algo::Selection::verticesRaySelection<PFP2>(map, position, bvh, rayA, rayAB, v2, 0.05f);
+		ok &= v1.size() == v2.size();
+		for (unsigned int j = 0; j < v1.size() && j < v2.size(); ++j)
+			ok &= (position[v1[j]] - rayA).norm2() == (position[v2[j]] - rayA).norm2();
+
+		std::vector<Edge> e1, e2;
+		Algo::Selection::edgesRaySelection<PFP2>(map, position, rayA, rayAB, e1, 0.02f);
+		Algo::Selection::edgesRaySelection<PFP2>(map, position, bvh, rayA, rayAB, e2, 0.02f);
+		ok &= e1.size() == e2.size();
+	}
+	return ok;
+}
+
+int test_faceBVH()
+{
+	PFP2::MAP map;
+	VertexAttribute<PFP2::VEC3, PFP2::MAP> position = map.addAttribute<PFP2::VEC3, VERTEX, PFP2::MAP>("position");
+	Algo::Surface::Tilings::Square::Grid<PFP2> grid(map, 60, 60, true);
+	grid.embedIntoGrid(position, 4.0f, 4.0f, 0.0f);
+	foreach_cell<VERTEX>(map, [&] (Vertex v)
+	{
+		PFP2::VEC3& p = position[v];
+		p[2] = 0.3 * std::sin(3.0 * p[0]) * std::cos(2.0 * p[1]);
+	});
+
+	// the tree does not depend on the number of threads
+	Algo::Geometry::FaceBVH<PFP2> bvh(map, position, 1);
+	Algo::Geometry::FaceBVH<PFP2> bvh4(map, position, 4);
+	bool ok = bvh.nodes().size() == bvh4.nodes().size() && bvh.faces().size() == 3600;
+	for (unsigned int i = 0; ok && i < bvh.nodes().size(); ++i)
+		ok &= bvh.nodes()[i].first == bvh4.nodes()[i].first && bvh.nodes()[i].nb == bvh4.nodes()[i].nb;
+
+	ok &= compareRaySelections(map, position, bvh);
+
+	// move the vertices and refit
+	foreach_cell<VERTEX>(map, [&] (Vertex v)
+	{
+		PFP2::VEC3& p = position[v];
+		p[2] = 0.5 * std::cos(2.0 * p[0] + p[1]);
+	});
+	bvh.refit(4);
+	ok &= compareRaySelections(map, position, bvh);
+
+	std::cout << "faceBVH: " << (ok ? "ok" : "differs") << std::endl;
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,79 @@
+#include <iostream>
+#include <algorithm>
+
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+
+#include "Algo/Geometry/kdTree.h"
+#include "Algo/Tiling/Surface/square.h"
+
+
+using namespace CGoGN;
+
+struct PFP1 : public PFP_STANDARD
+{
+	typedef EmbeddedMap2 MAP;
+};
+
+struct PFP2 : public PFP_DOUBLE
+{
+	typedef EmbeddedMap2 MAP;
+};
+
+
+/*****************************************
+*		 INSTANTIATION
+*****************************************/
+
+template class Algo::Geometry::KdTree<PFP1::VEC3>;
+template class Algo::Geometry::KdTree<PFP2::VEC3>;
+
+
+int test_kdTree()
+{
+	PFP2::MAP map;
+	VertexAttribute<PFP2::VEC3, PFP2::MAP> position = map.addAttribute<PFP2::VEC3, VERTEX, PFP2::MAP>("position");
+	Algo::Surface::Tilings::Square::Grid<PFP2> grid(map, 50, 50, true);
+	grid.embedIntoGrid(position, 2.0f, 2.0f, 0.0f);
+	foreach_cell<VERTEX>(map, [&] (Vertex v)
+	{
+		PFP2::VEC3& p = position[v];
+		p[2] = 0.2 * std::sin(5.0 * p[0] + 2.0 * p[1]);
+	});
+
+	Algo::Geometry::KdTree<PFP2::VEC3> kdTree;
+	kdTree.build(position, 4);
+	bool ok = kdTree.size() == 51 * 51;
+
+	// radius and k nearest queries against brute force
+	for (unsigned int q = 0; q < 50; ++q)
+	{
+		PFP2::VEC3 P(0.043 * q - 1.1, 0.7 * std::sin(double(q)), 0.1 * std::cos(double(q)));
+
+		std::vector<unsigned int> found;
+		kdTree.withinRadius(P, 0.15, found);
+		std::sort(found.begin(), found.end());
+
+		std::vector<unsigned int> expected;
+		std::vector< std::pair<double, unsigned int> > all;
+		for (unsigned int i = position.begin(); i != position.end(); position.next(i))
+		{
+			double d2 = (position[i] - P).norm2();
+			if (d2 <= 0.15 * 0.15)
+				expected.push_back(i);
+			all.push_back(std::make_pair(d2, i));
+		}
+		ok &= found == expected;
+
+		std::vector<unsigned int> nearest;
+		std::vector<double> dist2;
+		kdTree.kNearest(P, 12, nearest, dist2);
+		std::sort(all.begin(), all.end());
+		ok &= nearest.size() == 12;
+		for (unsigned int i = 0; ok && i < 12; ++i)
+			ok &= nearest[i] == all[i].second && dist2[i] == all[i].first;
+	}
+
+	std::cout << "kdTree: " << (ok ? "ok" : "differs") << std::endl;
+	return ok ? 0 : 1;
+}
@@ -1,6 +1,43 @@
+#include <iostream>
+#include "Topology/generic/parameters.h"
+#include "Topology/gmap/embeddedGMap2.h"
+#include "Topology/map/embeddedMap2.h"
+
+#include "Algo/Geometry/stats.h"
+
+
+using namespace CGoGN;
+
+struct PFP1 : public PFP_STANDARD
+{
+	typedef EmbeddedMap2 MAP;
+};
+
+struct PFP2 : public PFP_DOUBLE
+{
+	typedef EmbeddedMap2 MAP;
+};
+
+struct PFP3 : public PFP_STANDARD
+{
+	typedef EmbeddedGMap2 MAP;
+};
+
+
+using namespace CGoGN;
+
+
+/*****************************************
+*		 INSTANTIATION
+*****************************************/
+
+template void Algo::Geometry::statModele<PFP1>(PFP1::MAP& map, const VertexAttribute<PFP1::VEC3, PFP1::MAP>& position);
+template void Algo::Geometry::statModele<PFP2>(PFP2::MAP& map, const VertexAttribute<PFP2::VEC3, PFP2::MAP>& position);
+template void Algo::Geometry::statModele<PFP3>(PFP3::MAP& map, const VertexAttribute<PFP3::VEC3, PFP3::MAP>& position);
+
+template void Algo::Geometry::Parallel::statModele<PFP1>(PFP1::MAP& map, const VertexAttribute<PFP1::VEC3, PFP1::MAP>& position);
+template void Algo::Geometry::Parallel::statModele<PFP3>(PFP3::MAP& map, const VertexAttribute<PFP3::VEC3, PFP3::MAP>& position);
 
-//template <typename PFP>
-//void statModele(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position)
 
 int test_stats()
 {
@@ -0,0 +1,140 @@
+#include <iostream>
+#include <cmath>
+
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+
+#include "Algo/Geometry/triangleBatch.h"
+#include "Algo/Geometry/normal.h"
+#include "Algo/Geometry/area.h"
+#include "Algo/Geometry/laplacian.h"
+#include "Algo/Tiling/Surface/triangular.h"
+#include "Algo/Tiling/Surface/square.h"
+
+using namespace CGoGN;
+
+struct PFP1 : public PFP_STANDARD
+{
+	typedef EmbeddedMap2 MAP;
+};
+
+struct PFP2 : public PFP_DOUBLE
+{
+	typedef EmbeddedMap2 MAP;
+};
+
+
+/*****************************************
+*		 INSTANTIATION
+*****************************************/
+
+template class Algo::Surface::Geometry::TriangleBatch<PFP1>;
+template class Algo::Surface::Geometry::TriangleBatch<PFP2>;
+
+template void Algo::Surface::Geometry::TriangleBatch<PFP1>::computeLaplacianCotanVertices<PFP1::VEC3>(
+	const VertexAttribute<PFP1::VEC3, PFP1::MAP>& attr,
+	VertexAttribute<PFP1::VEC3, PFP1::MAP>& laplacian,
+	unsigned int nbth) const;
+
+template void Algo::Surface::Geometry::TriangleBatch<PFP2>::computeLaplacianCotanVertices<PFP2::REAL>(
+	const VertexAttribute<PFP2::REAL, PFP2::MAP>& attr,
+	VertexAttribute<PFP2::REAL, PFP2::MAP>& laplacian,
+	unsigned int nbth) const;
+
+
+/// same results as the per vertex / per edge functions (up to rounding)
+static int testTriangleBatch(PFP2::MAP& map, VertexAttribute<PFP2::VEC3, PFP2::MAP>& position)
+{
+	typedef PFP2::VEC3 VEC3;
+	typedef PFP2::REAL REAL;
+
+	foreach_cell<VERTEX>(map, [&] (Vertex v)
+	{
+		VEC3& p = position[v];
+		p += VEC3(0.01 * std::sin(7.0 * p[1]), 0.01 * std::cos(5.0 * p[2]), 0.01 * std::sin(3.0 * p[0]));
+	});
+
+	VertexAttribute<VEC3, PFP2::MAP> normal = map.addAttribute<VEC3, VERTEX, PFP2::MAP>("normal");
+	VertexAttribute<VEC3, PFP2::MAP> normalB = map.addAttribute<VEC3, VERTEX, PFP2::MAP>("normalB");
+	VertexAttribute<REAL, PFP2::MAP> area = map.addAttribute<REAL, VERTEX, PFP2::MAP>("area");
+	VertexAttribute<REAL, PFP2::MAP> areaB = map.addAttribute<REAL, VERTEX, PFP2::MAP>("areaB");
+	EdgeAttribute<REAL, PFP2::MAP> weight = map.addAttribute<REAL, EDGE, PFP2::MAP>("weight");
+	EdgeAttribute<REAL, PFP2::MAP> weightB = map.addAttribute<REAL, EDGE, PFP2::MAP>("weightB");
+	VertexAttribute<VEC3, PFP2::MAP> laplacian = map.addAttribute<VEC3, VERTEX, PFP2::MAP>("laplacian");
+	VertexAttribute<VEC3, PFP2::MAP> laplacianB = map.addAttribute<VEC3, VERTEX, PFP2::MAP>("laplacianB");
+
+	Algo::Surface::Geometry::computeNormalVertices<PFP2>(map, position, normal);
+	Algo::Surface::Geometry::computeVoronoiAreaVertices<PFP2>(map, position, area);
+	Algo::Surface::Geometry::computeCotanWeightEdges<PFP2>(map, position, weight);
+	Algo::Surface::Geometry::computeLaplacianCotanVertices<PFP2, VEC3>(map, weight, area, position, laplacian);
+
+	Algo::Surface::Geometry::TriangleBatch<PFP2> batch(map, 4);
+	batch.setPositions(position, 4);
+	batch.computeNormalVertices(normalB, 4);
+	batch.computeVoronoiAreaVertices(areaB, 4);
+	batch.computeCotanWeightEdges(weightB, 4);
+	batch.computeLaplacianCotanVertices(position, laplacianB, 4);
+
+	const REAL eps = 1e-9;
+	int nbErrors = 0;
+	foreach_cell<VERTEX>(map, [&] (Vertex v)
+	{
+		if ((normal[v] - normalB[v]).norm() > eps
+			|| std::fabs(area[v] - areaB[v]) > eps * std::fabs(area[v])
+			|| (laplacian[v] - laplacianB[v]).norm() > eps * laplacian[v].norm() + eps)
+			++nbErrors;
+	});
+	foreach_cell<EDGE>(map, [&] (Edge e)
+	{
+		if (std::fabs(weight[e] - weightB[e]) > eps * (std::fabs(weight[e]) + 1))
+			++nbErrors;
+	});
+
+	map.removeAttribute(normal);
+	map.removeAttribute(normalB);
+	map.removeAttribute(area);
+	map.removeAttribute(areaB);
+	map.removeAttribute(weight);
+	map.removeAttribute(weightB);
+	map.removeAttribute(laplacian);
+	map.removeAttribute(laplacianB);
+	return nbErrors;
+}
+
+int test_triangleBatch()
+{
+	int nbErrors = 0;
+
+	{
+		PFP2::MAP map;
+		VertexAttribute<PFP2::VEC3, PFP2::MAP> position = map.addAttribute<PFP2::VEC3, VERTEX, PFP2::MAP>("position");
+		Algo::Surface::Tilings::Triangular::Tore<PFP2> tore(map, 60, 40);
+		tore.embedIntoTore(position, 3.0f, 1.0f);
+		nbErrors += testTriangleBatch(map, position);
+	}
+
+	{
+		PFP2::MAP map;
+		VertexAttribute<PFP2::VEC3, PFP2::MAP> position = map.addAttribute<PFP2::VEC3, VERTEX, PFP2::MAP>("position");
+		Algo::Surface::Tilings::Triangular::Grid<PFP2> grid(map, 30, 30, true);
+		grid.embedIntoGrid(position, 2.0f, 2.0f, 0.0f);
+		foreach_cell<VERTEX>(map, [&] (Vertex v)
+		{
+			PFP2::VEC3& p = position[v];
+			p[2] = 0.2 * std::sin(5.0 * p[0] + 2.0 * p[1]);
+		});
+		nbErrors += testTriangleBatch(map, position);
+	}
+
+	// faces that are not triangles
+	{
+		PFP2::MAP map;
+		Algo::Surface::Tilings::Square::Grid<PFP2> grid(map, 4, 4, true);
+		Algo::Surface::Geometry::TriangleBatch<PFP2> batch(map, 1);
+		if (batch.isValid())
+			++nbErrors;
+	}
+
+	std::cout << "triangleBatch: " << (nbErrors == 0 ? "ok" : "differs") << std::endl;
+	return nbErrors;
+}
@@ -0,0 +1,38 @@
+#include <iostream>
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+
+#include "Algo/Geometry/weldVertices.h"
+
+
+using namespace CGoGN;
+
+struct PFP1 : public PFP_STANDARD
+{
+	typedef EmbeddedMap2 MAP;
+};
+
+struct PFP2 : public PFP_DOUBLE
+{
+	typedef EmbeddedMap2 MAP;
+};
+
+
+using namespace CGoGN;
+
+
+/*****************************************
+*		 INSTANTIATION
+*****************************************/
+
+template unsigned int Algo::Geometry::weldPoints<PFP1>(const VertexAttribute<PFP1::VEC3, PFP1::MAP>& position, PFP1::REAL epsilon, std::vector<unsigned int>& representative, unsigned int nbth);
+template unsigned int Algo::Geometry::weldPoints<PFP2>(const VertexAttribute<PFP2::VEC3, PFP2::MAP>& position, PFP2::REAL epsilon, std::vector<unsigned int>& representative, unsigned int nbth);
+
+template unsigned int Algo::Surface::Geometry::weldVertices<PFP1>(PFP1::MAP& map, const VertexAttribute<PFP1::VEC3, PFP1::MAP>& position, PFP1::REAL epsilon, unsigned int nbth);
+template unsigned int Algo::Surface::Geometry::weldVertices<PFP2>(PFP2::MAP& map, const VertexAttribute<PFP2::VEC3, PFP2::MAP>& position, PFP2::REAL epsilon, unsigned int nbth);
+
+
+int test_weldVertices()
+{
+	return 0;
+}
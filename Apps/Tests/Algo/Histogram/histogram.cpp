@@ -4,6 +4,7 @@
 
 
 #include "Algo/Histogram/histogram.h"
+#include "Algo/Tiling/Surface/square.h"
 
 using namespace CGoGN;
 
@@ -24,8 +25,35 @@ template unsigned int  Algo::Histogram::Histogram::markCellsOfQuantilesColumn<CM
 
 
 
+struct TestColorMap : public Algo::Histogram::HistoColorMap
+{
+	Geom::Vec3f color(double) const { return Geom::Vec3f(0.0f, 0.0f, 0.0f); }
+};
+
 int test_histogram()
 {
+	PFP1::MAP map;
+	VAC1 position = map.addAttribute<Geom::Vec3f, VERTEX, PFP1::MAP>("position");
+	Algo::Surface::Tilings::Square::Grid<PFP1> grid(map, 50, 50, true);
+	grid.embedIntoGrid(position, 1.0f, 1.0f, 0.0f);
+
+	VA1 values = map.addAttribute<double, VERTEX, PFP1::MAP>("values");
+	foreach_cell<VERTEX>(map, [&] (Vertex v) { values[v] = position[v][0] * position[v][1]; });
+
+	TestColorMap cm;
+	Algo::Histogram::Histogram seq(cm);
+	seq.initData(values);
+	seq.populateHisto(20);
+
+	Algo::Histogram::Histogram par(cm);
+	par.initData(values);
+	Algo::Histogram::Parallel::populateHisto(par, 20);
+
+	if (seq.getPopulation() != par.getPopulation())
+	{
+		std::cerr << "parallel populateHisto differs from sequential" << std::endl;
+		return 1;
+	}
 
 	return 0;
 }
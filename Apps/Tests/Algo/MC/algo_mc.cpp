@@ -4,6 +4,7 @@ extern int test_image();
 extern int test_planeCutting();
 extern int test_marchingcube();
 extern int test_marchingcubeGen();
+extern int test_minMaxPyramid();
 extern int test_windowing();
 
 int main()
@@ -11,6 +12,7 @@ int main()
 	test_image();
 	test_marchingcube();
 	test_marchingcubeGen();
+	test_minMaxPyramid();
 	test_windowing();
 
 	return 0;
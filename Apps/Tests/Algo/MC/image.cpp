@@ -1,5 +1,12 @@
 
 #include "Algo/MC/image.h"
+#include "Algo/MC/windowing.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <vector>
 
 using namespace CGoGN;
 
@@ -16,7 +23,158 @@ template class Algo::Surface::MC::Image<long long>;
 template class Algo::Surface::MC::Image<float>;
 template class Algo::Surface::MC::Image<double>;
 
+/**
+ * image with small chunks of lazy slices
+ */
+template <typename DataType>
+class ChunkedImage : public Algo::Surface::MC::Image<DataType>
+{
+public:
+	static Algo::Surface::MC::Image<DataType>* addFrame(const Algo::Surface::MC::Image<DataType>& img, int frameWidth, int chunkSize)
+	{
+		return static_cast<const ChunkedImage<DataType>&>(img).filteredImage(ChunkedImage<DataType>::FILTER_FRAME, frameWidth, true, chunkSize);
+	}
+
+	static Algo::Surface::MC::Image<DataType>* Blur3(const Algo::Surface::MC::Image<DataType>& img, int chunkSize)
+	{
+		return static_cast<const ChunkedImage<DataType>&>(img).filteredImage(ChunkedImage<DataType>::FILTER_BLUR3, 0, true, chunkSize);
+	}
+};
+
+/**
+ * number of voxels that differ between two images of same size
+ */
+template <typename DataType>
+int nbDifferentVoxels(Algo::Surface::MC::Image<DataType>& img1, Algo::Surface::MC::Image<DataType>& img2)
+{
+	if (img1.getWidthX() != img2.getWidthX() || img1.getWidthY() != img2.getWidthY() || img1.getWidthZ() != img2.getWidthZ())
+		return 1;
+
+	int nb = 0;
+	for (int z = 0; z < img1.getWidthZ(); ++z)
+		for (int y = 0; y < img1.getWidthY(); ++y)
+			for (int x = 0; x < img1.getWidthX(); ++x)
+				if (img1.getVoxel(x, y, z) != img2.getVoxel(x, y, z))
+					++nb;
+	return nb;
+}
+
+/**
+ * write an uncompressed inr file of unsigned short voxels
+ */
+void writeInr(const char* filename, const std::vector<unsigned short>& data, int wx, int wy, int wz, bool bigEndian)
+{
+	std::ostringstream header;
+	header << "#INRIMAGE-4#{\nXDIM=" << wx << "\nYDIM=" << wy << "\nZDIM=" << wz
+		   << "\nVDIM=1\nTYPE=unsigned fixed\nPIXSIZE=16 bits\nSCALE=2**0\nCPU=" << (bigEndian ? "sun" : "decm")
+		   << "\nVX=0.5\nVY=0.5\nVZ=2\n";
+	std::string h = header.str();
+	h.resize(256 - 4, '\n');
+	h += "##}\n";
+
+	std::ofstream out(filename, std::ios::out | std::ios::binary);
+	out.write(h.c_str(), h.size());
+	for (unsigned int i = 0; i < data.size(); ++i)
+	{
+		unsigned char bytes[2] = { (unsigned char)(data[i] & 0xff), (unsigned char)(data[i] >> 8) };
+		if (bigEndian)
+			std::swap(bytes[0], bytes[1]);
+		out.write(reinterpret_cast<const char*>(bytes), 2);
+	}
+}
+
 int test_image()
 {
-	return 0;
-}
\ No newline at end of file
+	// raw file read in memory or mapped
+	const int wx = 13, wy = 11, wz = 7;
+	std::vector<unsigned short> data(wx * wy * wz);
+	for (unsigned int i = 0; i < data.size(); ++i)
+		data[i] = (unsigned short)(i * 31);
+
+	const char* filename = "test_image_raw.raw";
+	{
+		std::ofstream out(filename, std::ios::out | std::ios::binary);
+		out.write(reinterpret_cast<const char*>(&wx), sizeof(int));
+		out.write(reinterpret_cast<const char*>(&wy), sizeof(int));
+		out.write(reinterpret_cast<const char*>(&wz), sizeof(int));
+		out.write(reinterpret_cast<const char*>(&data[0]), data.size() * sizeof(unsigned short));
+	}
+
+	int nbErrors = 0;
+	Algo::Surface::MC::Image<unsigned short> original(&data[0], wx, wy, wz, 1.0f, 1.0f, 1.0f, false);
+	Algo::Surface::MC::Image<unsigned short> read;
+	read.loadRaw(filename);
+	Algo::Surface::MC::Image<unsigned short> mapped;
+	mapped.loadRaw(filename, true);
+
+	nbErrors += nbDifferentVoxels(read, original);
+	mapped.prefetchSlices(0, wz);
+	nbErrors += nbDifferentVoxels(mapped, original);
+	mapped.releaseSlices(0, wz);
+	std::remove(filename);
+
+	// inr files (both byte orders) read in memory or mapped
+	const char* inrname = "test_image_inr.inr";
+	for (int bigEndian = 0; bigEndian < 2; ++bigEndian)
+	{
+		writeInr(inrname, data, wx, wy, wz, bigEndian == 1);
+		for (int map = 0; map < 2; ++map)
+		{
+			Algo::Surface::MC::Image<unsigned short> inr;
+			if (!inr.loadInr(inrname, map == 1) || inr.getVoxSizeZ() != 2.0f)
+				++nbErrors;
+			else
+				nbErrors += nbDifferentVoxels(inr, original);
+		}
+	}
+	Algo::Surface::MC::Image<short> inrType;
+	if (inrType.loadInr(inrname))
+		++nbErrors;
+	std::remove(inrname);
+
+	std::cout << "image loaders: " << (nbErrors == 0 ? "ok" : "differs") << std::endl;
+
+	// lazy frame and blur against allocated ones (of a lazy image too)
+	int nbLazyErrors = 0;
+	Algo::Surface::MC::Image<unsigned short>* framed = original.addFrame(2);
+	Algo::Surface::MC::Image<unsigned short>* lazyFramed = original.addFrame(2, true);
+	if (!lazyFramed->isLazy() || lazyFramed->getOrigin() != framed->getOrigin())
+		++nbLazyErrors;
+	nbLazyErrors += nbDifferentVoxels(*lazyFramed, *framed);
+
+	Algo::Surface::MC::Image<unsigned short>* blurred = framed->Blur3();
+	Algo::Surface::MC::Image<unsigned short>* lazyBlurred = lazyFramed->Blur3(true);
+	nbLazyErrors += nbDifferentVoxels(*lazyBlurred, *blurred);
+
+	// released slices are computed again
+	lazyBlurred->releaseSlices(0, lazyBlurred->getWidthZ());
+	lazyFramed->releaseSlices(0, lazyFramed->getWidthZ());
+	nbLazyErrors += nbDifferentVoxels(*lazyBlurred, *blurred);
+
+	Algo::Surface::MC::WindowingGreater<unsigned short> wind;
+	wind.setIsoValue(1000);
+	if (lazyBlurred->computeVolume(wind) != blurred->computeVolume(wind))
+		++nbLazyErrors;
+
+	// chunks of 1 and 3 slices
+	for (int chunkSize = 1; chunkSize < 4; chunkSize += 2)
+	{
+		Algo::Surface::MC::Image<unsigned short>* chunkedFramed = ChunkedImage<unsigned short>::addFrame(original, 2, chunkSize);
+		Algo::Surface::MC::Image<unsigned short>* chunkedBlurred = ChunkedImage<unsigned short>::Blur3(*chunkedFramed, chunkSize);
+		nbLazyErrors += nbDifferentVoxels(*chunkedBlurred, *blurred);
+		for (int z = 0; z < chunkedBlurred->getWidthZ(); ++z)
+			chunkedBlurred->releaseSlices(z, z + 1);
+		nbLazyErrors += nbDifferentVoxels(*chunkedBlurred, *blurred);
+		nbLazyErrors += nbDifferentVoxels(*chunkedFramed, *framed);
+		delete chunkedBlurred;
+		delete chunkedFramed;
+	}
+
+	delete lazyBlurred;
+	delete blurred;
+	delete lazyFramed;
+	delete framed;
+
+	std::cout << "image lazy frame and blur: " << (nbLazyErrors == 0 ? "ok" : "differs") << std::endl;
+	return nbErrors + nbLazyErrors;
+}
@@ -2,11 +2,18 @@
 #include "Topology/map/embeddedMap2.h"
 #include "Topology/map/embeddedMap3.h"
 #include "Topology/gmap/embeddedGMap2.h"
+#include "Topology/map/map2.h"
+#include "Topology/generic/mapImpl/mapMonoAoS.h"
 
 
 #include "Algo/MC/marchingcube.h"
 #include "Algo/MC/windowing.h"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
 using namespace CGoGN;
 
 struct PFP1 : public PFP_STANDARD
@@ -42,10 +49,178 @@ template class Algo::Surface::MC::MarchingCube< int, Algo::Surface::MC::Windowin
 template class Algo::Surface::MC::MarchingCube< double, Algo::Surface::MC::WindowingEqual, PFP3 >;
 
 
+// interleaved relations: the darts of the slabs are not copied at once
+struct PFP4 : public PFP_DOUBLE
+{
+	typedef Map2<MapMonoAoS<> > MAP;
+};
+
+
 
-int test_marchingcube()
+/**
+ * signature of each dart: positions of its edge and of the edge of its phi2
+ */
+template <typename PFP>
+std::vector< std::array<double, 12> > dartSignatures(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position)
 {
+	std::vector< std::array<double, 12> > sig;
+	for (Dart d = map.begin(); d != map.end(); map.next(d))
+	{
+		Dart e[4] = { d, map.phi1(d), map.phi2(d), map.phi1(map.phi2(d)) };
+		std::array<double, 12> s;
+		for (unsigned int i = 0; i < 4; ++i)
+			for (unsigned int j = 0; j < 3; ++j)
+				s[3*i+j] = position[e[i]][j];
+		sig.push_back(s);
+	}
+	std::sort(sig.begin(), sig.end());
+	return sig;
+}
+
+template <typename PFP>
+int testParallelMeshing(Algo::Surface::MC::Image<unsigned char>& image, unsigned int nbSlabs)
+{
+	typedef typename PFP::MAP MAP;
+	typedef typename PFP::VEC3 VEC3;
+
+	Algo::Surface::MC::WindowingGreater<unsigned char> wind;
+	wind.setIsoValue(128);
+
+	MAP map1;
+	VertexAttribute<VEC3, MAP> position1 = map1.template addAttribute<VEC3, VERTEX, MAP>("position");
+	Algo::Surface::MC::MarchingCube<unsigned char, Algo::Surface::MC::WindowingGreater, PFP> mc1(&image, &map1, position1, wind, false);
+	mc1.simpleMeshing();
+
+	MAP map2;
+	VertexAttribute<VEC3, MAP> position2 = map2.template addAttribute<VEC3, VERTEX, MAP>("position");
+	Algo::Surface::MC::MarchingCube<unsigned char, Algo::Surface::MC::WindowingGreater, PFP> mc2(&image, &map2, position2, wind, false);
+	mc2.parallelMeshing(nbSlabs, 4);
 
-	return 0;
+	int nbErrors = 0;
+	if (map1.getNbDarts() != map2.getNbDarts() || map1.getNbCells(VERTEX) != map2.getNbCells(VERTEX))
+		++nbErrors;
+	else if (dartSignatures<PFP>(map1, position1) != dartSignatures<PFP>(map2, position2))
+		++nbErrors;
+
+	return nbErrors;
+}
+
+template <typename PFP>
+int testPyramidMeshing(Algo::Surface::MC::Image<unsigned char>& image, unsigned int brickSize, unsigned int nbSlabs)
+{
+	typedef typename PFP::MAP MAP;
+	typedef typename PFP::VEC3 VEC3;
+
+	Algo::Surface::MC::WindowingGreater<unsigned char> wind;
+	wind.setIsoValue(128);
+
+	MAP map1;
+	VertexAttribute<VEC3, MAP> position1 = map1.template addAttribute<VEC3, VERTEX, MAP>("position");
+	Algo::Surface::MC::MarchingCube<unsigned char, Algo::Surface::MC::WindowingGreater, PFP> mc1(&image, &map1, position1, wind, false);
+	mc1.simpleMeshing();
+
+	Algo::Surface::MC::MinMaxPyramid<unsigned char> pyramid(image, brickSize, 4);
+
+	MAP map2;
+	VertexAttribute<VEC3, MAP> position2 = map2.template addAttribute<VEC3, VERTEX, MAP>("position");
+	Algo::Surface::MC::MarchingCube<unsigned char, Algo::Surface::MC::WindowingGreater, PFP> mc2(&image, &map2, position2, wind, false);
+	unsigned int nbActive = mc2.setPyramid(&pyramid);
+	if (nbSlabs == 0)
+		mc2.simpleMeshing();
+	else
+		mc2.parallelMeshing(nbSlabs, 4);
+
+	int nbErrors = 0;
+	// the surface does not cross all the bricks
+	if (nbActive == 0 || nbActive == pyramid.getNbBricksX() * pyramid.getNbBricksY() * pyramid.getNbBricksZ())
+		++nbErrors;
+	if (map1.getNbDarts() != map2.getNbDarts() || map1.getNbCells(VERTEX) != map2.getNbCells(VERTEX))
+		++nbErrors;
+	else if (dartSignatures<PFP>(map1, position1) != dartSignatures<PFP>(map2, position2))
+		++nbErrors;
+
+	return nbErrors;
+}
+
+template <typename PFP>
+int testLazyMeshing(Algo::Surface::MC::Image<unsigned char>& image, unsigned int nbSlabs)
+{
+	typedef typename PFP::MAP MAP;
+	typedef typename PFP::VEC3 VEC3;
+
+	Algo::Surface::MC::WindowingGreater<unsigned char> wind;
+	wind.setIsoValue(128);
+
+	Algo::Surface::MC::Image<unsigned char>* framed = image.addFrame(1);
+	Algo::Surface::MC::Image<unsigned char>* lazyFramed = image.addFrame(1, true);
+
+	MAP map1;
+	VertexAttribute<VEC3, MAP> position1 = map1.template addAttribute<VEC3, VERTEX, MAP>("position");
+	Algo::Surface::MC::MarchingCube<unsigned char, Algo::Surface::MC::WindowingGreater, PFP> mc1(framed, &map1, position1, wind, false);
+	mc1.simpleMeshing();
+
+	MAP map2;
+	VertexAttribute<VEC3, MAP> position2 = map2.template addAttribute<VEC3, VERTEX, MAP>("position");
+	Algo::Surface::MC::MarchingCube<unsigned char, Algo::Surface::MC::WindowingGreater, PFP> mc2(lazyFramed, &map2, position2, wind, false);
+	if (nbSlabs == 0)
+		mc2.simpleMeshing();
+	else
+		mc2.parallelMeshing(nbSlabs, 4);
+
+	int nbErrors = 0;
+	if (map1.getNbDarts() != map2.getNbDarts() || map1.getNbCells(VERTEX) != map2.getNbCells(VERTEX))
+		++nbErrors;
+	else if (dartSignatures<PFP>(map1, position1) != dartSignatures<PFP>(map2, position2))
+		++nbErrors;
+
+	delete lazyFramed;
+	delete framed;
+	return nbErrors;
+}
+
+int test_marchingcube()
+{
+	// two overlapping balls and a torus, cut by several slabs
+	const int wx = 40, wy = 36, wz = 47;
+	std::vector<unsigned char> data(wx * wy * wz);
+	for (int z = 0; z < wz; ++z)
+		for (int y = 0; y < wy; ++y)
+			for (int x = 0; x < wx; ++x)
+			{
+				double b1 = 11.0 - std::sqrt(double((x-14)*(x-14) + (y-17)*(y-17) + (z-14)*(z-14)));
+				double b2 = 8.5 - std::sqrt(double((x-24)*(x-24) + (y-19)*(y-19) + (z-22)*(z-22)));
+				double r = std::sqrt(double((x-20)*(x-20) + (y-18)*(y-18))) - 11.0;
+				double t = 4.0 - std::sqrt(r*r + double((z-35)*(z-35)));
+				double f = std::max(b1, std::max(b2, t));
+				data[(z * wy + y) * wx + x] = (unsigned char)(std::min(std::max(128.0 + 40.0 * f, 0.0), 255.0));
+			}
+
+	Algo::Surface::MC::Image<unsigned char> image(&data[0], wx, wy, wz, 1.0f, 1.0f, 1.0f, false);
+
+	int nbErrors = 0;
+	nbErrors += testParallelMeshing<PFP2>(image, 2);
+	nbErrors += testParallelMeshing<PFP2>(image, 5);
+	nbErrors += testParallelMeshing<PFP2>(image, 46);
+	nbErrors += testParallelMeshing<PFP3>(image, 5);
+	nbErrors += testParallelMeshing<PFP4>(image, 5);
+
+	std::cout << "marchingcube parallel: " << (nbErrors == 0 ? "ok" : "differs") << std::endl;
+
+	int nbPyramidErrors = 0;
+	nbPyramidErrors += testPyramidMeshing<PFP2>(image, 8, 0);
+	nbPyramidErrors += testPyramidMeshing<PFP2>(image, 4, 0);
+	nbPyramidErrors += testPyramidMeshing<PFP2>(image, 8, 5);
+	nbPyramidErrors += testPyramidMeshing<PFP3>(image, 4, 3);
+
+	std::cout << "marchingcube brick skipping: " << (nbPyramidErrors == 0 ? "ok" : "differs") << std::endl;
+	nbErrors += nbPyramidErrors;
+
+	int nbLazyErrors = 0;
+	nbLazyErrors += testLazyMeshing<PFP2>(image, 0);
+	nbLazyErrors += testLazyMeshing<PFP2>(image, 5);
+
+	std::cout << "marchingcube lazy image: " << (nbLazyErrors == 0 ? "ok" : "differs") << std::endl;
+	nbErrors += nbLazyErrors;
+	return nbErrors;
 }
 
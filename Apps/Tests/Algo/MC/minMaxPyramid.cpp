@@ -0,0 +1,68 @@
+#include "Algo/MC/minMaxPyramid.h"
+#include "Algo/MC/windowing.h"
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+using namespace CGoGN;
+
+template class Algo::Surface::MC::MinMaxPyramid<unsigned char>;
+template class Algo::Surface::MC::MinMaxPyramid<unsigned short>;
+template class Algo::Surface::MC::MinMaxPyramid<int>;
+template class Algo::Surface::MC::MinMaxPyramid<float>;
+template class Algo::Surface::MC::MinMaxPyramid<double>;
+
+
+int test_minMaxPyramid()
+{
+	const int wx = 29, wy = 17, wz = 40;
+	std::vector<short> data(wx * wy * wz);
+	for (int i = 0; i < wx * wy * wz; ++i)
+		data[i] = short((i * 7919) % 1000 - 500);
+
+	Algo::Surface::MC::Image<short> image(&data[0], wx, wy, wz, 1.0f, 1.0f, 1.0f, false);
+	Algo::Surface::MC::MinMaxPyramid<short> pyramid(image, 8, 4);
+
+	int nbErrors = 0;
+
+	// bricks of level 0 against the voxels (corners included)
+	for (unsigned int bz = 0; bz < pyramid.getNbBricksZ(); ++bz)
+		for (unsigned int by = 0; by < pyramid.getNbBricksY(); ++by)
+			for (unsigned int bx = 0; bx < pyramid.getNbBricksX(); ++bx)
+			{
+				short vmin = 1000;
+				short vmax = -1000;
+				for (int z = bz * 8; z <= std::min(int(bz * 8 + 8), wz - 1); ++z)
+					for (int y = by * 8; y <= std::min(int(by * 8 + 8), wy - 1); ++y)
+						for (int x = bx * 8; x <= std::min(int(bx * 8 + 8), wx - 1); ++x)
+						{
+							vmin = std::min(vmin, image.getVoxel(x, y, z));
+							vmax = std::max(vmax, image.getVoxel(x, y, z));
+						}
+				if (pyramid.getMin(0, bx, by, bz) != vmin || pyramid.getMax(0, bx, by, bz) != vmax)
+					++nbErrors;
+			}
+
+	// top of the pyramid covers the whole image
+	unsigned int top = pyramid.getNbLevels() - 1;
+	if (pyramid.getNbBricksX(top) != 1 || pyramid.getNbBricksY(top) != 1 || pyramid.getNbBricksZ(top) != 1)
+		++nbErrors;
+	if (pyramid.getMin(top, 0, 0, 0) != *std::min_element(data.begin(), data.end()) ||
+		pyramid.getMax(top, 0, 0, 0) != *std::max_element(data.begin(), data.end()))
+		++nbErrors;
+
+	// no brick is uniform for a value inside the range of the image
+	Algo::Surface::MC::WindowingGreater<short> wind;
+	wind.setIsoValue(0);
+	std::vector<unsigned char> active;
+	if (pyramid.activeBricks(wind, active) != active.size())
+		++nbErrors;
+	// all the bricks are uniform for a value outside
+	wind.setIsoValue(2000);
+	if (pyramid.activeBricks(wind, active) != 0)
+		++nbErrors;
+
+	std::cout << "minMaxPyramid: " << (nbErrors == 0 ? "ok" : "differs") << std::endl;
+	return nbErrors;
+}
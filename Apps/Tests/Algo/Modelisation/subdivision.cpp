@@ -4,6 +4,10 @@
 
 
 #include "Algo/Modelisation/subdivision.h"
+#include "Algo/Tiling/Surface/triangular.h"
+#include "Algo/Tiling/Surface/square.h"
+
+#include <iostream>
 
 using namespace CGoGN;
 
@@ -28,6 +32,8 @@ template void Algo::Surface::Modelisation::LoopSubdivision<PFP1, VPOS1>(PFP1::MA
 template void Algo::Surface::Modelisation::LoopSubdivisionGen<PFP1>(PFP1::MAP& map, VertexAttributeGen& attrib);
 template void Algo::Surface::Modelisation::LoopSubdivisionAttribNameTyped<PFP1, Geom::Vec3d>(PFP1::MAP& map, const std::string& nameAttrib);
 template void Algo::Surface::Modelisation::LoopSubdivisionAttribName<PFP1>(PFP1::MAP& map, const std::string& nameAttrib);
+template void Algo::Surface::Modelisation::Parallel::CatmullClarkSubdivision<PFP1, VPOS1>(PFP1::MAP& map, VPOS1& attributs, unsigned int nbth);
+template void Algo::Surface::Modelisation::Parallel::LoopSubdivision<PFP1, VPOS1>(PFP1::MAP& map, VPOS1& attributs, unsigned int nbth);
 template void Algo::Surface::Modelisation::TwoNPlusOneSubdivision<PFP1, VPOS1>(PFP1::MAP& map, VPOS1& attributs, float size);
 template void Algo::Surface::Modelisation::DooSabin<PFP1, VPOS1>(PFP1::MAP& map, VPOS1& position);
 template void Algo::Surface::Modelisation::computeDual<PFP1>(PFP1::MAP& map, VertexAttribute<PFP1::VEC3, PFP1::MAP>& position);
@@ -56,6 +62,8 @@ template void Algo::Surface::Modelisation::LoopSubdivision<PFP2, VPOS2>(PFP2::MA
 template void Algo::Surface::Modelisation::LoopSubdivisionGen<PFP2>(PFP2::MAP& map, VertexAttributeGen& attrib);
 template void Algo::Surface::Modelisation::LoopSubdivisionAttribNameTyped<PFP2, Geom::Vec3d>(PFP2::MAP& map, const std::string& nameAttrib);
 template void Algo::Surface::Modelisation::LoopSubdivisionAttribName<PFP2>(PFP2::MAP& map, const std::string& nameAttrib);
+template void Algo::Surface::Modelisation::Parallel::CatmullClarkSubdivision<PFP2, VPOS2>(PFP2::MAP& map, VPOS2& attributs, unsigned int nbth);
+template void Algo::Surface::Modelisation::Parallel::LoopSubdivision<PFP2, VPOS2>(PFP2::MAP& map, VPOS2& attributs, unsigned int nbth);
 template void Algo::Surface::Modelisation::TwoNPlusOneSubdivision<PFP2, VPOS2>(PFP2::MAP& map, VPOS2& attributs, float size);
 template void Algo::Surface::Modelisation::DooSabin<PFP2, VPOS2>(PFP2::MAP& map, VPOS2& position);
 template void Algo::Surface::Modelisation::computeDual<PFP2>(PFP2::MAP& map, VertexAttribute<PFP2::VEC3, PFP2::MAP>& position);
@@ -85,6 +93,8 @@ template void Algo::Surface::Modelisation::LoopSubdivision<PFP3, VPOS3>(PFP3::MA
 template void Algo::Surface::Modelisation::LoopSubdivisionGen<PFP3>(PFP3::MAP& map, VertexAttributeGen& attrib);
 template void Algo::Surface::Modelisation::LoopSubdivisionAttribNameTyped<PFP3, Geom::Vec3d>(PFP3::MAP& map, const std::string& nameAttrib);
 template void Algo::Surface::Modelisation::LoopSubdivisionAttribName<PFP3>(PFP3::MAP& map, const std::string& nameAttrib);
+template void Algo::Surface::Modelisation::Parallel::CatmullClarkSubdivision<PFP3, VPOS3>(PFP3::MAP& map, VPOS3& attributs, unsigned int nbth);
+template void Algo::Surface::Modelisation::Parallel::LoopSubdivision<PFP3, VPOS3>(PFP3::MAP& map, VPOS3& attributs, unsigned int nbth);
 template void Algo::Surface::Modelisation::TwoNPlusOneSubdivision<PFP3, VPOS3>(PFP3::MAP& map, VPOS3& attributs, float size);
 //template void Algo::Surface::Modelisation::DooSabin<PFP3, VPOS3>(PFP3::MAP& map, VPOS3& position);
 template void Algo::Surface::Modelisation::computeDual<PFP3>(PFP3::MAP& map, VertexAttribute<PFP3::VEC3, PFP3::MAP>& position);
@@ -93,8 +103,79 @@ template void Algo::Surface::Modelisation::computeDual<PFP3>(PFP3::MAP& map, Ver
 
 
 
-int test_subdivision()
+// same darts, relations, vertex embeddings, boundary marks and positions
+static bool sameSubdividedMaps(PFP2::MAP& map1, VPOS2& position1, PFP2::MAP& map2, VPOS2& position2)
 {
-
+	if (map1.getNbDarts() != map2.getNbDarts() || !map2.check())
+		return false;
+	for (Dart d = map1.begin(); d != map1.end(); map1.next(d))
+	{
+		if (map1.phi1(d) != map2.phi1(d) || map1.phi_1(d) != map2.phi_1(d) || map1.phi2(d) != map2.phi2(d))
+			return false;
+		if (map1.getEmbedding<VERTEX>(d) != map2.getEmbedding<VERTEX>(d))
+			return false;
+		if (map1.isBoundaryMarked<2>(d) != map2.isBoundaryMarked<2>(d))
+			return false;
+		if (position1[d] != position2[d])
+			return false;
+	}
+	return true;
+}
+
+template <typename BUILD>
+static int testParallelSubdivision(bool loop, BUILD build)
+{
+	PFP2::MAP map1;
+	PFP2::MAP map2;
+	VPOS2 position1 = map1.addAttribute<PFP2::VEC3, VERTEX, PFP2::MAP>("position");
+	VPOS2 position2 = map2.addAttribute<PFP2::VEC3, VERTEX, PFP2::MAP>("position");
+	build(map1, position1);
+	build(map2, position2);
+
+	for (unsigned int i = 0; i < 2; ++i)
+	{
+		if (loop)
+		{
+			Algo::Surface::Modelisation::LoopSubdivision<PFP2>(map1, position1);
+			Algo::Surface::Modelisation::Parallel::LoopSubdivision<PFP2>(map2, position2, 4);
+		}
+		else
+		{
+			Algo::Surface::Modelisation::CatmullClarkSubdivision<PFP2>(map1, position1);
+			Algo::Surface::Modelisation::Parallel::CatmullClarkSubdivision<PFP2>(map2, position2, 4);
+		}
+		if (!sameSubdividedMaps(map1, position1, map2, position2))
+		{
+			std::cerr << "parallel " << (loop ? "Loop" : "Catmull-Clark") << " subdivision differs at level " << i << std::endl;
+			return 1;
+		}
+	}
 	return 0;
+}
+
+int test_subdivision()
+{
+	// the parallel subdivisions build the same maps as the sequential ones
+	int nbErrors = 0;
+	nbErrors += testParallelSubdivision(true, [] (PFP2::MAP& map, VPOS2& position)
+	{
+		Algo::Surface::Tilings::Triangular::Tore<PFP2> tore(map, 12, 8);
+		tore.embedIntoTore(position, 3.0f, 1.0f);
+	});
+	nbErrors += testParallelSubdivision(true, [] (PFP2::MAP& map, VPOS2& position)
+	{
+		Algo::Surface::Tilings::Triangular::Grid<PFP2> grid(map, 12, 8, true);
+		grid.embedIntoGrid(position, 1.0f, 1.0f);
+	});
+	nbErrors += testParallelSubdivision(false, [] (PFP2::MAP& map, VPOS2& position)
+	{
+		Algo::Surface::Tilings::Square::Tore<PFP2> tore(map, 12, 8);
+		tore.embedIntoTore(position, 3.0f, 1.0f);
+	});
+	nbErrors += testParallelSubdivision(false, [] (PFP2::MAP& map, VPOS2& position)
+	{
+		Algo::Surface::Tilings::Square::Grid<PFP2> grid(map, 12, 8, true);
+		grid.embedIntoGrid(position, 1.0f, 1.0f);
+	});
+	return nbErrors;
 }
\ No newline at end of file
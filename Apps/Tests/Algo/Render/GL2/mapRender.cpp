@@ -5,6 +5,7 @@
 
 
 #include "Algo/Render/GL2/mapRender.h"
+#include "Algo/Tiling/Surface/square.h"
 
 
 using namespace CGoGN;
@@ -15,9 +16,13 @@ struct PFP1 : public PFP_STANDARD
 	typedef EmbeddedMap2 MAP;
 };
 
-template void Algo::Render::GL2::MapRender::initPrimitives<PFP1>(PFP1::MAP& map, int prim, bool optimized);
-template void Algo::Render::GL2::MapRender::initPrimitives<PFP1>(PFP1::MAP& map, int prim, const VertexAttribute<PFP1::VEC3, PFP1::MAP>* position, bool optimized);
-template void Algo::Render::GL2::MapRender::addPrimitives<PFP1>(PFP1::MAP& map, int prim, const VertexAttribute<PFP1::VEC3, PFP1::MAP>* position, bool optimized);
+template void Algo::Render::GL2::MapRender::initPrimitives<PFP1>(PFP1::MAP& map, int prim, bool optimized, unsigned int nbth);
+template void Algo::Render::GL2::MapRender::initPrimitives<PFP1>(PFP1::MAP& map, int prim, const VertexAttribute<PFP1::VEC3, PFP1::MAP>* position, bool optimized, unsigned int nbth);
+template void Algo::Render::GL2::MapRender::addPrimitives<PFP1>(PFP1::MAP& map, int prim, const VertexAttribute<PFP1::VEC3, PFP1::MAP>* position, bool optimized, unsigned int nbth);
+template void Algo::Render::GL2::MapRender::enableIncrementalTriangles<PFP1>(PFP1::MAP& map, const VertexAttribute<PFP1::VEC3, PFP1::MAP>* position, unsigned int nbth);
+template void Algo::Render::GL2::MapRender::setFaceDirty<PFP1::MAP>(PFP1::MAP& map, Face f);
+template void Algo::Render::GL2::MapRender::setFaceRemoved<PFP1::MAP>(PFP1::MAP& map, Face f);
+template void Algo::Render::GL2::MapRender::updateTriangles<PFP1>(PFP1::MAP& map, const VertexAttribute<PFP1::VEC3, PFP1::MAP>* position);
 
 
 
@@ -26,9 +31,11 @@ struct PFP2 : public PFP_DOUBLE
 	typedef EmbeddedMap2 MAP;
 };
 
-template void Algo::Render::GL2::MapRender::initPrimitives<PFP2>(PFP2::MAP& map, int prim, bool optimized);
-template void Algo::Render::GL2::MapRender::initPrimitives<PFP2>(PFP2::MAP& map, int prim, const VertexAttribute<PFP2::VEC3, PFP2::MAP>* position, bool optimized);
-template void Algo::Render::GL2::MapRender::addPrimitives<PFP2>(PFP2::MAP& map, int prim, const VertexAttribute<PFP2::VEC3, PFP2::MAP>* position, bool optimized);
+template void Algo::Render::GL2::MapRender::initPrimitives<PFP2>(PFP2::MAP& map, int prim, bool optimized, unsigned int nbth);
+template void Algo::Render::GL2::MapRender::initPrimitives<PFP2>(PFP2::MAP& map, int prim, const VertexAttribute<PFP2::VEC3, PFP2::MAP>* position, bool optimized, unsigned int nbth);
+template void Algo::Render::GL2::MapRender::addPrimitives<PFP2>(PFP2::MAP& map, int prim, const VertexAttribute<PFP2::VEC3, PFP2::MAP>* position, bool optimized, unsigned int nbth);
+template void Algo::Render::GL2::MapRender::enableIncrementalTriangles<PFP2>(PFP2::MAP& map, const VertexAttribute<PFP2::VEC3, PFP2::MAP>* position, unsigned int nbth);
+template void Algo::Render::GL2::MapRender::updateTriangles<PFP2>(PFP2::MAP& map, const VertexAttribute<PFP2::VEC3, PFP2::MAP>* position);
 
 
 struct PFP3 : public PFP_DOUBLE
@@ -36,14 +43,86 @@ struct PFP3 : public PFP_DOUBLE
 	typedef EmbeddedMap3 MAP;
 };
 
-template void Algo::Render::GL2::MapRender::initPrimitives<PFP3>(PFP3::MAP& map, int prim, bool optimized);
-template void Algo::Render::GL2::MapRender::initPrimitives<PFP3>(PFP3::MAP& map, int prim, const VertexAttribute<PFP3::VEC3, PFP3::MAP>* position, bool optimized);
-template void Algo::Render::GL2::MapRender::addPrimitives<PFP3>(PFP3::MAP& map, int prim, const VertexAttribute<PFP3::VEC3, PFP3::MAP>* position, bool optimized);
+template void Algo::Render::GL2::MapRender::initPrimitives<PFP3>(PFP3::MAP& map, int prim, bool optimized, unsigned int nbth);
+template void Algo::Render::GL2::MapRender::initPrimitives<PFP3>(PFP3::MAP& map, int prim, const VertexAttribute<PFP3::VEC3, PFP3::MAP>* position, bool optimized, unsigned int nbth);
+template void Algo::Render::GL2::MapRender::addPrimitives<PFP3>(PFP3::MAP& map, int prim, const VertexAttribute<PFP3::VEC3, PFP3::MAP>* position, bool optimized, unsigned int nbth);
+template void Algo::Render::GL2::MapRender::enableIncrementalTriangles<PFP3>(PFP3::MAP& map, const VertexAttribute<PFP3::VEC3, PFP3::MAP>* position, unsigned int nbth);
+template void Algo::Render::GL2::MapRender::setFaceDirty<PFP3::MAP>(PFP3::MAP& map, Face f);
+template void Algo::Render::GL2::MapRender::setFaceRemoved<PFP3::MAP>(PFP3::MAP& map, Face f);
+template void Algo::Render::GL2::MapRender::updateTriangles<PFP3>(PFP3::MAP& map, const VertexAttribute<PFP3::VEC3, PFP3::MAP>* position);
 
 
 
-int test_mapRender()
+/// non degenerated triangles of an index table, in a canonical order
+std::vector<GLuint> sortedTriangles(const std::vector<GLuint>& indices)
 {
+	std::vector< std::vector<GLuint> > triangles;
+	for (unsigned int i = 0; i + 2 < indices.size(); i += 3)
+	{
+		std::vector<GLuint> t(indices.begin() + i, indices.begin() + i + 3);
+		if (t[0] == t[1] && t[1] == t[2])
+			continue;
+		std::rotate(t.begin(), std::min_element(t.begin(), t.end()), t.end());
+		triangles.push_back(t);
+	}
+	std::sort(triangles.begin(), triangles.end());
+	std::vector<GLuint> result;
+	for (unsigned int i = 0; i < triangles.size(); ++i)
+		result.insert(result.end(), triangles[i].begin(), triangles[i].end());
+	return result;
+}
 
-	return 0;
+int test_mapRender()
+{
+	typedef Algo::Render::GL2::MapRender MapRender;
+
+	PFP1::MAP map;
+	VertexAttribute<PFP1::VEC3, PFP1::MAP> position = map.addAttribute<PFP1::VEC3, VERTEX, PFP1::MAP>("position");
+	Algo::Surface::Tilings::Square::Grid<PFP1> grid(map, 20, 20, false);
+	grid.embedIntoGrid(position, 1.0f, 1.0f, 0.0f);
+
+	// parallel generation gives the tables of the sequential one
+	bool ok = true;
+	std::vector<GLuint> seq, par;
+	MapRender::initTriangles<PFP1>(map, seq, &position, 1);
+	MapRender::initTriangles<PFP1>(map, par, &position, 4);
+	ok &= seq == par;
+	seq.clear(); par.clear();
+	MapRender::initLines<PFP1>(map, seq, 1);
+	MapRender::initLines<PFP1>(map, par, 4);
+	ok &= seq == par;
+
+	// incremental table patched after local modifications
+	MapRender::TriangleTable table;
+	table.init<PFP1>(map, &position, 4);
+	for (unsigned int i = 0; i < 100; ++i)
+	{
+		Dart d = map.begin();
+		for (unsigned int j = 0; j < 7 * i; ++j)
+			map.next(d);
+		if (map.isBoundaryMarked<2>(d))
+			continue;
+		if (map.faceDegree(d) >= 4)
+		{
+			Dart e = map.phi1(map.phi1(d));
+			map.splitFace(d, e);
+			table.setFaceDirty(map, d);
+			table.setFaceDirty(map, e);
+		}
+		else if (!map.isBoundaryEdge(d) && !map.sameFace(d, map.phi2(d)))
+		{
+			Dart e = map.phi1(d);
+			table.setFaceRemoved(map, d);
+			table.setFaceRemoved(map, map.phi2(d));
+			map.mergeFaces(d);
+			table.setFaceDirty(map, e);
+		}
+		table.update<PFP1>(map, &position);
+	}
+	std::vector<GLuint> full;
+	MapRender::initTriangles<PFP1>(map, full, &position, 1);
+	ok &= sortedTriangles(table.indices()) == sortedTriangles(full);
+
+	std::cout << "mapRender: " << (ok ? "ok" : "differs") << std::endl;
+	return ok ? 0 : 1;
 }
\ No newline at end of file
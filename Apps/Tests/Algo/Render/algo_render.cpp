@@ -11,6 +11,7 @@ extern int test_topo3Render();
 extern int test_mapSVGRender();
 extern int test_topoPrimalRender();
 extern int test_topo3PrimalRender();
+extern int test_vertexCache();
 
 int main()
 {
@@ -24,6 +25,7 @@ int main()
 	test_mapSVGRender();
 	test_topoPrimalRender();
 	test_topo3PrimalRender();
+	test_vertexCache();
 
 	return 0;
 }
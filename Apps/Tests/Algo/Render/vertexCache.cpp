@@ -0,0 +1,68 @@
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+#include "Algo/Render/GL2/mapRender.h"
+#include "Algo/Render/vertexCache.h"
+#include "Algo/Tiling/Surface/square.h"
+
+using namespace CGoGN;
+
+struct PFP1 : public PFP_STANDARD
+{
+	typedef EmbeddedMap2 MAP;
+};
+
+template void Algo::Render::VertexCache::reorderVertices<PFP1::MAP>(PFP1::MAP& map, std::vector<unsigned int>& indices);
+
+// defined in GL2/mapRender.cpp
+extern std::vector<GLuint> sortedTriangles(const std::vector<GLuint>& indices);
+
+int test_vertexCache()
+{
+	typedef Algo::Render::GL2::MapRender MapRender;
+	namespace VertexCache = Algo::Render::VertexCache;
+
+	PFP1::MAP map;
+	VertexAttribute<PFP1::VEC3, PFP1::MAP> position = map.addAttribute<PFP1::VEC3, VERTEX, PFP1::MAP>("position");
+	Algo::Surface::Tilings::Square::Grid<PFP1> grid(map, 40, 40, true);
+	grid.embedIntoGrid(position, 1.0f, 1.0f, 0.0f);
+
+	// holes in the vertex container
+	std::vector<unsigned int> removed;
+	for (unsigned int i = 0; i < 10; ++i)
+		removed.push_back(map.newCell<VERTEX>());
+	for (unsigned int i = 0; i < removed.size(); i += 2)
+		map.getAttributeContainer<VERTEX>().removeLine(removed[i]);
+
+	std::vector<GLuint> table;
+	MapRender::initTriangles<PFP1>(map, table, &position);
+
+	// same triangles, with less cache misses
+	bool ok = true;
+	std::vector<GLuint> optimized(table);
+	VertexCache::optimizeTriangles(optimized, 16);
+	ok &= sortedTriangles(optimized) == sortedTriangles(table);
+	ok &= VertexCache::computeACMR(optimized, 16) < VertexCache::computeACMR(table, 16);
+	ok &= VertexCache::computeATVR(optimized, 16) >= 1.0f;
+
+	// vertices in fetch order, the attributes follow
+	std::vector<PFP1::VEC3> corners;
+	for (unsigned int i = 0; i < optimized.size(); ++i)
+		corners.push_back(position[optimized[i]]);
+	VertexCache::reorderVertices(map, optimized);
+	unsigned int next = 0;
+	for (unsigned int i = 0; i < optimized.size(); ++i)
+	{
+		ok &= position[optimized[i]] == corners[i];
+		if (optimized[i] == next)
+			++next;
+		else
+			ok &= optimized[i] < next;
+	}
+	table.clear();
+	MapRender::initTriangles<PFP1>(map, table, &position);
+	ok &= sortedTriangles(optimized) == sortedTriangles(table);
+	ok &= map.check();
+
+	std::cout << "vertexCache: " << (ok ? "ok" : "differs") << std::endl;
+	return ok ? 0 : 1;
+}
@@ -4,6 +4,9 @@
 
 
 #include "Algo/Selection/collector.h"
+#include "Algo/Tiling/Surface/triangular.h"
+
+#include <iostream>
 
 using namespace CGoGN;
 
@@ -26,6 +29,7 @@ struct PFP3 : public PFP_DOUBLE
 template class Algo::Surface::Selection::Collector_OneRing<PFP1>;
 template class Algo::Surface::Selection::Collector_OneRing_AroundEdge<PFP1>;
 template class Algo::Surface::Selection::Collector_WithinSphere<PFP1>;
+template class Algo::Surface::Selection::Collector_WithinSphere_KdTree<PFP1>;
 template class Algo::Surface::Selection::Collector_NormalAngle<PFP1>;
 template class Algo::Surface::Selection::Collector_NormalAngle_Triangles<PFP1>;
 template class Algo::Surface::Selection::CollectorCriterion_VertexNormalAngle<PFP1>;
@@ -39,6 +43,7 @@ template class Algo::Surface::Selection::Collector_Dijkstra<PFP1>;
 template class Algo::Surface::Selection::Collector_OneRing<PFP2>;
 template class Algo::Surface::Selection::Collector_OneRing_AroundEdge<PFP2>;
 template class Algo::Surface::Selection::Collector_WithinSphere<PFP2>;
+template class Algo::Surface::Selection::Collector_WithinSphere_KdTree<PFP2>;
 template class Algo::Surface::Selection::Collector_NormalAngle<PFP2>;
 template class Algo::Surface::Selection::Collector_NormalAngle_Triangles<PFP2>;
 template class Algo::Surface::Selection::CollectorCriterion_VertexNormalAngle<PFP2>;
@@ -53,6 +58,7 @@ template class Algo::Surface::Selection::Collector_Dijkstra<PFP2>;
 template class Algo::Surface::Selection::Collector_OneRing<PFP3>;
 template class Algo::Surface::Selection::Collector_OneRing_AroundEdge<PFP3>;
 template class Algo::Surface::Selection::Collector_WithinSphere<PFP3>;
+template class Algo::Surface::Selection::Collector_WithinSphere_KdTree<PFP3>;
 template class Algo::Surface::Selection::Collector_NormalAngle<PFP3>;
 template class Algo::Surface::Selection::Collector_NormalAngle_Triangles<PFP3>;
 template class Algo::Surface::Selection::CollectorCriterion_VertexNormalAngle<PFP3>;
@@ -64,10 +70,67 @@ template class Algo::Surface::Selection::Collector_Dijkstra_Vertices<PFP3>;
 template class Algo::Surface::Selection::Collector_Dijkstra<PFP3>;
 
 
-int test_collector()
+/// edges and faces designated by their smallest dart
+template <typename MAP>
+std::vector<unsigned int> sortedEdges(MAP& map, const std::vector<Edge>& edges)
+{
+	std::vector<unsigned int> keys;
+	for (Edge e : edges)
+		keys.push_back(std::min(e.dart.index, map.phi2(e.dart).index));
+	std::sort(keys.begin(), keys.end());
+	return keys;
+}
+
+template <typename MAP>
+std::vector<unsigned int> sortedFaces(MAP& map, const std::vector<Face>& faces)
 {
+	std::vector<unsigned int> keys;
+	for (Face f : faces)
+	{
+		unsigned int k = f.dart.index;
+		foreach_incident2<VERTEX>(map, f, [&] (Vertex v) { k = std::min(k, v.dart.index); });
+		keys.push_back(k);
+	}
+	std::sort(keys.begin(), keys.end());
+	return keys;
+}
 
-	return 0;
+int test_collector()
+{
+	// the kd-tree collector gives the same neighborhoods as the flood fill one on a closed surface
+	PFP2::MAP map;
+	VertexAttribute<PFP2::VEC3, PFP2::MAP> position = map.addAttribute<PFP2::VEC3, VERTEX, PFP2::MAP>("position");
+	Algo::Surface::Tilings::Triangular::Tore<PFP2> tore(map, 40, 20);
+	tore.embedIntoTore(position, 3.0f, 1.0f);
+
+	Algo::Geometry::KdTree<PFP2::VEC3> kdTree;
+	kdTree.build(position, 4);
+
+	bool ok = true;
+	for (PFP2::REAL radius : { 0.0, 0.3, 1.2 })
+	{
+		Algo::Surface::Selection::Collector_WithinSphere<PFP2> c1(map, position, radius);
+		Algo::Surface::Selection::Collector_WithinSphere_KdTree<PFP2> c2(map, position, kdTree, radius);
+		foreach_cell<VERTEX>(map, [&] (Vertex v)
+		{
+			c1.collectAll(v);
+			c2.collectAll(v);
+			ok &= c1.getNbInsideVertices() == c2.getNbInsideVertices();
+			for (unsigned int i = 0; ok && i < c1.getNbInsideVertices(); ++i)
+				ok &= c1.getInsideVertices()[i].dart == c2.getInsideVertices()[i].dart;
+			ok &= c1.getBorder() == c2.getBorder();
+			ok &= sortedEdges(map, c1.getInsideEdges()) == sortedEdges(map, c2.getInsideEdges());
+			ok &= sortedFaces(map, c1.getInsideFaces()) == sortedFaces(map, c2.getInsideFaces());
+			ok &= c1.computeArea(position) == c2.computeArea(position) || std::abs(c1.computeArea(position) - c2.computeArea(position)) < 1e-9;
+
+			c1.collectBorder(v);
+			c2.collectBorder(v);
+			ok &= c1.getBorder() == c2.getBorder();
+		});
+	}
+
+	std::cout << "Collector_WithinSphere_KdTree: " << (ok ? "ok" : "differs") << std::endl;
+	return ok ? 0 : 1;
 }
 
 
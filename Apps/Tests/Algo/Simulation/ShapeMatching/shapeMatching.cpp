@@ -1,92 +1,112 @@
-/*******************************************************************************
-* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
-* version 0.1                                                                  *
-* Copyright (C) 2009-2013, IGG Team, ICube, University of Strasbourg           *
-*                                                                              *
-* This library is free software; you can redistribute it and/or modify it      *
-* under the terms of the GNU Lesser General Public License as published by the *
-* Free Software Foundation; either version 2.1 of the License, or (at your     *
-* option) any later version.                                                   *
-*                                                                              *
-* This library is distributed in the hope that it will be useful, but WITHOUT  *
-* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
-* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
-* for more details.                                                            *
-*                                                                              *
-* You should have received a copy of the GNU Lesser General Public License     *
-* along with this library; if not, write to the Free Software Foundation,      *
-* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
-*                                                                              *
-* Web site: http://cgogn.unistra.fr/                                           *
-* Contact information: cgogn@unistra.fr                                        *
-*                                                                              *
-*******************************************************************************/
-
-#include <Eigen/Dense>
-#include <Eigen/Eigenvalues>
-
-#ifndef _SHAPE_MATCHING_H_
-#define _SHAPE_MATCHING_H_
-
-namespace CGoGN
-{
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+#include "Topology/gmap/embeddedGMap2.h"
 
-namespace Algo
-{
+#include "Algo/Simulation/ShapeMatching/shapeMatchingLinear.h"
+#include "Algo/Simulation/ShapeMatching/shapeMatchingQuadratic.h"
+#include "Algo/Tiling/Surface/triangular.h"
 
-namespace Surface
-{
+#include <iostream>
+#include <cmath>
 
-namespace Simulation
-{
+using namespace CGoGN;
 
-namespace ShapeMatching
+struct PFP1 : public PFP_STANDARD
 {
+	typedef EmbeddedMap2 MAP;
+};
 
-template <typename PFP>
-class ShapeMatching
+struct PFP2 : public PFP_DOUBLE
 {
-public:
-    typedef typename PFP::MAP MAP;
-    typedef typename PFP::VEC3 VEC3;
-    typedef typename PFP::REAL REAL;
-
-protected:
-    MAP& m_map;
-    VertexAttribute<VEC3>& m_position; // x_i : position
-    VertexAttribute<REAL>& m_mass;  // m_i : mass
-    VertexAttribute<VEC3> m_goal;
-
-    // q_{i} = x^{0} - x^{0}_{cm}
-    std::vector<Eigen::Vector3d> m_q;
-
-public:
-    ShapeMatching(MAP& map, VertexAttribute<VEC3>& position, VertexAttribute<REAL>& mass);
-
-    virtual ~ShapeMatching();
-
-    Eigen::Vector3d massCenter();
-
-    void initialize();
-
-    void shapeMatch();
-
-    void computeVelocities(VertexAttribute<VEC3>& velocity, VertexAttribute<VEC3>& fext, REAL h, REAL alpha);
-
-    void applyVelocities(VertexAttribute<VEC3>& velocity, REAL h);
+	typedef EmbeddedMap2 MAP;
 };
 
-} // namespace ShapeMatching
-
-} // namespace Simulation
-
-} // namespace Surface
+struct PFP3 : public PFP_DOUBLE
+{
+	typedef EmbeddedGMap2 MAP;
+};
 
-} // namespace Algo
 
-} // namespace CGoGN
+template class Algo::Surface::Simulation::ShapeMatching::ShapeMatching<PFP1>;
+template class Algo::Surface::Simulation::ShapeMatching::ShapeMatching<PFP2>;
+template class Algo::Surface::Simulation::ShapeMatching::ShapeMatching<PFP3>;
 
+template void Algo::Surface::Simulation::ShapeMatching::Parallel::shapeMatch<PFP2>(
+	const std::vector<Algo::Surface::Simulation::ShapeMatching::ShapeMatching<PFP2>*>& solvers,
+	unsigned int nbth);
 
-#include "shapeMatching.hpp"
 
-#endif
+/// rigid motion of the positions of map
+static void moveRigidly(PFP2::MAP& map, VertexAttribute<PFP2::VEC3, PFP2::MAP>& position, double angle)
+{
+	double c = std::cos(angle);
+	double s = std::sin(angle);
+	foreach_cell<VERTEX>(map, [&] (Vertex v)
+	{
+		PFP2::VEC3 p = position[v];
+		position[v] = PFP2::VEC3(c * p[0] - s * p[1], s * p[0] + c * p[1], p[2]) + PFP2::VEC3(0.5, -1.0, 2.0);
+	});
+}
+
+/// the goal positions of a rigidly moved body are its positions
+static int testRigid(PFP2::MAP& map, const VertexAttribute<PFP2::VEC3, PFP2::MAP>& position)
+{
+	VertexAttribute<PFP2::VEC3, PFP2::MAP> goal = map.getAttribute<PFP2::VEC3, VERTEX, PFP2::MAP>("goal");
+	int nbErrors = 0;
+	foreach_cell<VERTEX>(map, [&] (Vertex v)
+	{
+		if ((goal[v] - position[v]).norm() > 1e-6)
+			++nbErrors;
+	});
+	return nbErrors;
+}
+
+int test_shapeMatching()
+{
+	typedef Algo::Surface::Simulation::ShapeMatching::ShapeMatching<PFP2> SM;
+	typedef Algo::Surface::Simulation::ShapeMatching::ShapeMatchingLinear<PFP2> SML;
+	typedef Algo::Surface::Simulation::ShapeMatching::ShapeMatchingQuadratic<PFP2> SMQ;
+
+	const unsigned int NB = 6;
+	PFP2::MAP maps[NB];
+	VertexAttribute<PFP2::VEC3, PFP2::MAP> positions[NB];
+	VertexAttribute<PFP2::REAL, PFP2::MAP> masses[NB];
+	std::vector<SM*> solvers;
+	int nbErrors = 0;
+
+	for (unsigned int i = 0; i < NB; ++i)
+	{
+		positions[i] = maps[i].addAttribute<PFP2::VEC3, VERTEX, PFP2::MAP>("position");
+		masses[i] = maps[i].addAttribute<PFP2::REAL, VERTEX, PFP2::MAP>("mass");
+		Algo::Surface::Tilings::Triangular::Tore<PFP2> tore(maps[i], 20 + 5 * i, 10 + 3 * i);
+		tore.embedIntoTore(positions[i], 3.0f, 1.0f);
+		masses[i].setAllValues(1.0);
+
+		SM* solver;
+		if (i % 3 == 0)
+			solver = new SM(maps[i], positions[i], masses[i]);
+		else if (i % 3 == 1)
+			solver = new SML(maps[i], positions[i], masses[i], 0.5);
+		else
+			solver = new SMQ(maps[i], positions[i], masses[i], 0.5);
+		solver->initialize(4);
+		solvers.push_back(solver);
+
+		moveRigidly(maps[i], positions[i], 0.3 + 0.2 * i);
+	}
+
+	// one solver with several threads
+	solvers[0]->shapeMatch(4);
+	nbErrors += testRigid(maps[0], positions[0]);
+
+	// all the solvers in one batch
+	Algo::Surface::Simulation::ShapeMatching::Parallel::shapeMatch<PFP2>(solvers, 4);
+	for (unsigned int i = 0; i < NB; ++i)
+		nbErrors += testRigid(maps[i], positions[i]);
+
+	for (unsigned int i = 0; i < NB; ++i)
+		delete solvers[i];
+
+	std::cout << "shapeMatching: " << (nbErrors == 0 ? "ok" : "differs") << std::endl;
+	return nbErrors;
+}
@@ -1,11 +1,13 @@
 #include <iostream>
 
+extern int test_shapeMatching();
 extern int test_shapeMatchingLinear();
 extern int test_shapeMatchingQuadratic();
 
 
 int main()
 {
+	test_shapeMatching();
 	test_shapeMatchingLinear();
 	test_shapeMatchingQuadratic();
 
@@ -1,3 +1,5 @@
+#include <iostream>
+
 #include "Container/attributeContainer.h"
 #include "Geometry/vector_gen.h"
 
@@ -62,8 +64,35 @@ template void AttributeContainer::setData<char>(unsigned int attrIndex, unsigned
 
 }
 
+using namespace CGoGN;
+
 int test_attributeContainer()
 {
+	// copy of a container with small blocks, markers included
+	AttributeContainer cont;
+	cont.setBlockSize(64);
+	AttributeMultiVector<int>* values = cont.addAttribute<int>("values");
+	AttributeMultiVector<MarkerBool>* marks = cont.addMarkerAttribute("marks");
+	for (unsigned int i = 0; i < 1000; ++i)
+	{
+		unsigned int l = cont.insertLine();
+		(*values)[l] = int(l);
+		marks->setVal(l, l % 3 == 0);
+	}
+
+	AttributeContainer copy;
+	copy.copyFrom(cont);
+	AttributeMultiVector<int>* cValues = copy.getDataVector<int>("values");
+	AttributeMultiVector<MarkerBool>* cMarks = copy.getMarkerAttributes()[0];
+
+	int nbErrors = 0;
+	for (unsigned int l = cont.begin(); l != cont.end(); cont.next(l))
+	{
+		if ((*cValues)[l] != int(l) || (*cMarks)[l] != (l % 3 == 0))
+			++nbErrors;
+	}
+	if (nbErrors != 0)
+		std::cerr << "copyFrom: " << nbErrors << " wrong lines with blocks of 64 lines" << std::endl;
 
-	return 0;
+	return nbErrors;
 }
\ No newline at end of file
@@ -9,9 +9,9 @@ extern int test_containerBrowser();
 
 int main()
 {
-	test_attributeContainer();
-	test_attributeMultiVector();
-	test_containerBrowser();
+	int nbErrors = test_attributeContainer();
+	nbErrors += test_attributeMultiVector();
+	nbErrors += test_containerBrowser();
 
-	return 0;
+	return nbErrors;
 }
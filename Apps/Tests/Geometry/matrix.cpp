@@ -1,4 +1,6 @@
 #include <iostream>
+#include <cstdlib>
+#include <cmath>
 
 #include <Geometry/matrix.h>
 
@@ -19,6 +21,12 @@ template class Geom::Matrix<4, 4, double>;
 template class Geom::Matrix<7, 7, double>;
 
 
+// equal up to the rounding of fused multiply-adds (when the compiler contracts the generic code)
+static bool same(double a, double b)
+{
+	return std::abs(a - b) <= 1e-6;
+}
+
 int test_matrix()
 {
 	// test matrixx MN
@@ -38,5 +46,65 @@ int test_matrix()
 	std::cout << Cd << std::endl;
 	std::cout << Dd << std::endl;
 
-	return 0;
+	// the SIMD products compute as the generic loops
+	int nbErrors = 0;
+	for (unsigned int t = 0; t < 100; ++t)
+	{
+		Geom::Matrix44f A, B;
+		Geom::Matrix33d A3, B3;
+		Geom::Vec4f v;
+		for (unsigned int i = 0; i < 4; ++i)
+		{
+			v[i] = float(rand()) / RAND_MAX - 0.5f;
+			for (unsigned int j = 0; j < 4; ++j)
+			{
+				A(i,j) = float(rand()) / RAND_MAX - 0.5f;
+				B(i,j) = float(rand()) / RAND_MAX - 0.5f;
+				if (i < 3 && j < 3)
+				{
+					A3(i,j) = A(i,j);
+					B3(i,j) = B(i,j);
+				}
+			}
+		}
+
+		Geom::Matrix44f AB = A * B;
+		Geom::Matrix33d AB3 = A3 * B3;
+		Geom::Vec4f Av = A * v;
+		Geom::Vec4f vA = v * A;
+		for (unsigned int i = 0; i < 4; ++i)
+		{
+			float av = A(i,0) * v[0];
+			float va = v[0] * A(0,i);
+			for (unsigned int k = 1; k < 4; ++k)
+			{
+				av += A(i,k) * v[k];
+				va += v[k] * A(k,i);
+			}
+			if (!same(Av[i], av) || !same(vA[i], va))
+				++nbErrors;
+
+			for (unsigned int j = 0; j < 4; ++j)
+			{
+				float ab = A(i,0) * B(0,j);
+				for (unsigned int k = 1; k < 4; ++k)
+					ab += A(i,k) * B(k,j);
+				if (!same(AB(i,j), ab))
+					++nbErrors;
+
+				if (i < 3 && j < 3)
+				{
+					double ab3 = A3(i,0) * B3(0,j);
+					for (unsigned int k = 1; k < 3; ++k)
+						ab3 += A3(i,k) * B3(k,j);
+					if (!same(AB3(i,j), ab3))
+						++nbErrors;
+				}
+			}
+		}
+	}
+	if (nbErrors > 0)
+		std::cerr << "test_matrix: " << nbErrors << " errors" << std::endl;
+
+	return nbErrors;
 }
@@ -13,6 +13,7 @@ extern int test_transfo();
 extern int test_plane3d();
 extern int test_frame();
 extern int test_distances();
+extern int test_vector();
 
 
 
@@ -23,12 +24,13 @@ int main()
 	test_intersection();
 	test_orientation();
 	test_inclusion();
-	test_matrix();
+	int nbErrors = test_matrix();
 	test_tensor();
 	test_transfo();
 	test_plane3d();
 	test_frame();
 	test_distances();
+	nbErrors += test_vector();
 
-	return 0;
+	return nbErrors;
 }
@@ -3,6 +3,9 @@
 #define CGOGN_NO_STATIC_ASSERT 1
 #include "Geometry/vector_gen.h"
 
+#include <cstdlib>
+#include <cmath>
+
 using namespace CGoGN;
 
 template class Geom::Vector<2, short>;
@@ -21,6 +24,21 @@ template class Geom::Vector<11, short>;
 template class Geom::Vector<11, float>;
 template class Geom::Vector<11, double>;
 
+// equal up to the rounding of fused multiply-adds (when the compiler contracts the generic code)
+template <unsigned int DIM, typename T>
+static bool same(const Geom::Vector<DIM, T>& u, const Geom::Vector<DIM, T>& v)
+{
+	for (unsigned int i = 0; i < DIM; ++i)
+		if (std::abs(u[i] - v[i]) > T(1e-6))
+			return false;
+	return true;
+}
+
+static bool same(double a, double b)
+{
+	return std::abs(a - b) <= 1e-6;
+}
+
 int test_vector()
 {
 	Geom::Vec3f v1(3.0f,4.0f,5.0f);
@@ -32,7 +50,59 @@ int test_vector()
 
 	v1 *= 10.0f;
 	v2 *= 100.0f;
-	
-	return 0;
+
+	// the SIMD specializations compute as the generic loops
+	int nbErrors = 0;
+	for (unsigned int i = 0; i < 1000; ++i)
+	{
+		float a[4], b[4];
+		for (unsigned int j = 0; j < 4; ++j)
+		{
+			a[j] = float(rand()) / RAND_MAX - 0.5f;
+			b[j] = float(rand()) / RAND_MAX - 0.5f;
+		}
+
+		Geom::Vec3f a3(a[0], a[1], a[2]);
+		Geom::Vec3f b3(b[0], b[1], b[2]);
+		Geom::Vec3f s3 = a3 + b3;
+		Geom::Vec3f d3 = a3 - b3;
+		Geom::Vec3f c3 = a3 ^ b3;
+		float dot3 = a[0] * b[0];
+		dot3 += a[1] * b[1];
+		dot3 += a[2] * b[2];
+		if (!same(s3, Geom::Vec3f(a[0] + b[0], a[1] + b[1], a[2] + b[2])) || !same(d3, Geom::Vec3f(a[0] - b[0], a[1] - b[1], a[2] - b[2])))
+			++nbErrors;
+		if (!same(c3, Geom::Vec3f(a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0])))
+			++nbErrors;
+		if (!same(a3 * b3, dot3))
+			++nbErrors;
+
+		Geom::Vec4f a4(a[0], a[1], a[2], a[3]);
+		Geom::Vec4f b4(b[0], b[1], b[2], b[3]);
+		float dot4 = dot3;
+		dot4 += a[3] * b[3];
+		if (!same(a4 + b4, Geom::Vec4f(a[0] + b[0], a[1] + b[1], a[2] + b[2], a[3] + b[3])) || !same(a4 * b4, dot4))
+			++nbErrors;
+
+		Geom::Vec4d a4d(a4);
+		Geom::Vec4d b4d(b4);
+		double dot4d = double(a[0]) * double(b[0]);
+		for (unsigned int j = 1; j < 4; ++j)
+			dot4d += double(a[j]) * double(b[j]);
+		if (!same(a4d - b4d, Geom::Vec4d(double(a[0]) - double(b[0]), double(a[1]) - double(b[1]), double(a[2]) - double(b[2]), double(a[3]) - double(b[3]))) || !same(a4d * b4d, dot4d))
+			++nbErrors;
+
+		Geom::Vec3d a3d(a3);
+		Geom::Vec3d b3d(b3);
+		double dot3d = double(a[0]) * double(b[0]);
+		dot3d += double(a[1]) * double(b[1]);
+		dot3d += double(a[2]) * double(b[2]);
+		if (!same(a3d - b3d, Geom::Vec3d(double(a[0]) - double(b[0]), double(a[1]) - double(b[1]), double(a[2]) - double(b[2]))) || !same(a3d * b3d, dot3d))
+			++nbErrors;
+	}
+	if (nbErrors > 0)
+		std::cerr << "test_vector: " << nbErrors << " errors" << std::endl;
+
+	return nbErrors;
 }
 
@@ -0,0 +1,139 @@
+#include "Utils/binaryStream.h"
+#include "Utils/gzstream.h"
+#include "Utils/threadPool.h"
+
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+using namespace CGoGN;
+
+// sequence of small writes and of blocks larger than the frames
+static void writeTest(std::ostream& out, const std::vector<char>& block)
+{
+	for (unsigned int i = 0; i < 1000; ++i)
+		out.write(reinterpret_cast<const char*>(&i), sizeof(unsigned int));
+	out.write(&block[0], block.size());
+	out.write(&block[0], 17);
+	out.write(&block[0], block.size() - 5);
+}
+
+static bool readTest(std::istream& in, const std::vector<char>& block)
+{
+	bool ok = true;
+	for (unsigned int i = 0; i < 1000; ++i)
+	{
+		unsigned int v = 0;
+		in.read(reinterpret_cast<char*>(&v), sizeof(unsigned int));
+		ok = ok && (v == i);
+	}
+	std::vector<char> buffer(block.size());
+	in.read(&buffer[0], block.size());
+	ok = ok && (buffer == block);
+	in.read(&buffer[0], 17);
+	ok = ok && (memcmp(&buffer[0], &block[0], 17) == 0);
+	in.read(&buffer[0], block.size() - 5);
+	ok = ok && (memcmp(&buffer[0], &block[0], block.size() - 5) == 0);
+	ok = ok && in.good();
+	// nothing left
+	char c;
+	in.read(&c, 1);
+	return ok && in.gcount() == 0;
+}
+
+int test_binaryStream()
+{
+	int nbErrors = 0;
+
+	std::vector<char> block(3 * 1024 * 1024 + 123);
+	for (unsigned int i = 0; i < block.size(); ++i)
+		block[i] = char((i * 7919u) % 251u);
+
+	Utils::ThreadPool pool(3);
+
+	std::vector<Utils::BinaryFormat> formats;
+	formats.push_back(Utils::BIN_GZIP);
+	formats.push_back(Utils::BIN_RAW);
+#ifdef CGOGN_WITH_LZ4
+	formats.push_back(Utils::BIN_LZ4);
+#endif
+
+	for (unsigned int f = 0; f < formats.size(); ++f)
+	{
+		for (unsigned int p = 0; p < 2; ++p)
+		{
+			Utils::ThreadPool* tp = (p == 0) ? NULL : &pool;
+			{
+				Utils::BinaryOStream out("test_binaryStream.bin", std::ios::out | std::ios::binary, formats[f], tp);
+				writeTest(out, block);
+				if (!out.good())
+					++nbErrors;
+			}
+			Utils::BinaryIStream in("test_binaryStream.bin", std::ios::in | std::ios::binary, tp);
+			if (in.format() != formats[f] || !readTest(in, block))
+				++nbErrors;
+		}
+	}
+
+	// gzip files are compatible with gzstream in both directions
+	{
+		Utils::BinaryOStream out("test_binaryStream.bin", std::ios::out, Utils::BIN_GZIP, &pool);
+		writeTest(out, block);
+	}
+	{
+		igzstream in("test_binaryStream.bin", std::ios::in);
+		if (!readTest(in, block))
+			++nbErrors;
+	}
+	{
+		ogzstream out("test_binaryStream.bin", std::ios::out);
+		writeTest(out, block);
+	}
+	{
+		Utils::BinaryIStream in("test_binaryStream.bin");
+		if (in.format() != Utils::BIN_GZIP || !readTest(in, block))
+			++nbErrors;
+	}
+	remove("test_binaryStream.bin");
+
+	// maps saved in each format
+	{
+		typedef PFP_STANDARD::VEC3 VEC3;
+		EmbeddedMap2 map;
+		VertexAttribute<VEC3, EmbeddedMap2> position = map.addAttribute<VEC3, VERTEX, EmbeddedMap2>("position");
+		for (unsigned int i = 0; i < 5000; ++i)
+		{
+			Dart d = map.newFace(3 + i % 3);
+			position[d] = VEC3(float(i), 1.0f, 2.0f);
+		}
+
+		for (unsigned int f = 0; f < formats.size(); ++f)
+		{
+			if (!map.saveMapBin("test_binaryStream.map", formats[f]))
+				++nbErrors;
+
+			EmbeddedMap2 map2;
+			if (!map2.loadMapBin("test_binaryStream.map"))
+				++nbErrors;
+			VertexAttribute<VEC3, EmbeddedMap2> position2 = map2.getAttribute<VEC3, VERTEX, EmbeddedMap2>("position");
+			if (map2.getNbDarts() != map.getNbDarts() || !position2.isValid())
+				++nbErrors;
+			else
+			{
+				for (unsigned int i = position.begin(); i != position.end(); position.next(i))
+				{
+					if (!(position2[i] == position[i]))
+						++nbErrors;
+				}
+			}
+		}
+		remove("test_binaryStream.map");
+	}
+
+	std::cout << "binaryStream: " << (nbErrors == 0 ? "ok" : "differs") << std::endl;
+	return nbErrors;
+}
@@ -0,0 +1,67 @@
+#include "Utils/indexedHeap.h"
+#include "Topology/generic/dart.h"
+
+#include <map>
+#include <vector>
+#include <cstdlib>
+
+using namespace CGoGN;
+
+template class CGoGN::Utils::IndexedHeap<float, Dart>;
+template class CGoGN::Utils::IndexedHeap<double, Dart, 2>;
+
+
+int test_indexedHeap()
+{
+	// same order as a multimap under random insertions, removals and updates
+	typedef Utils::IndexedHeap<double, Dart> HEAP;
+	HEAP heap;
+	std::multimap<double, Dart> mmap;
+	std::vector<HEAP::iterator> hits;
+	std::vector<std::multimap<double, Dart>::iterator> mits;
+
+	srand(12345);
+	for (unsigned int i = 0; i < 20000; ++i)
+	{
+		unsigned int op = rand() % 4;
+		if (op < 2 || hits.empty())
+		{
+			double k = double(rand() % 100);
+			hits.push_back(heap.insert(std::make_pair(k, Dart(i))));
+			mits.push_back(mmap.insert(std::make_pair(k, Dart(i))));
+		}
+		else
+		{
+			unsigned int j = rand() % hits.size();
+			heap.erase(hits[j]);
+			mmap.erase(mits[j]);
+			if (op == 3)
+			{
+				double k = double(rand() % 100);
+				hits[j] = heap.insert(std::make_pair(k, Dart(i)));
+				mits[j] = mmap.insert(std::make_pair(k, Dart(i)));
+			}
+			else
+			{
+				hits[j] = hits.back();
+				hits.pop_back();
+				mits[j] = mits.back();
+				mits.pop_back();
+			}
+		}
+		if (heap.size() != mmap.size())
+			return 1;
+		if (!heap.empty() && (heap.begin()->second != mmap.begin()->second))
+			return 1;
+	}
+
+	while (!heap.empty())
+	{
+		if (heap.begin()->second != mmap.begin()->second)
+			return 1;
+		heap.erase(heap.begin());
+		mmap.erase(mmap.begin());
+	}
+
+	return 0;
+}
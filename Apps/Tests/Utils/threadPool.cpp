@@ -0,0 +1,46 @@
+#include "Utils/threadPool.h"
+
+#include <atomic>
+#include <iostream>
+
+using namespace CGoGN;
+
+
+int test_threadPool()
+{
+	Utils::ThreadPool pool(3);
+	int nbErrors = 0;
+
+	// each task is executed once
+	std::atomic<unsigned int> sum(0);
+	pool.exec(1000, [&] (unsigned int task, unsigned int)
+	{
+		sum += task;
+	});
+	if (sum != 999u * 1000u / 2u)
+		++nbErrors;
+
+	// nested reserve and exec from the tasks are executed inline by the worker
+	std::atomic<unsigned int> nbWrongWorkers(0);
+	sum = 0;
+	pool.exec(8, [&] (unsigned int, unsigned int w)
+	{
+		pool.reserve(8);
+		pool.exec(10, [&] (unsigned int t, unsigned int wn)
+		{
+			if (wn != w)
+				++nbWrongWorkers;
+			sum += t;
+		});
+	});
+	if (sum != 8u * 45u || nbWrongWorkers != 0 || pool.nbWorkers() != 3)
+		++nbErrors;
+
+	if (pool.currentWorker() != 0)
+		++nbErrors;
+
+	if (nbErrors != 0)
+		std::cerr << "threadPool: " << nbErrors << " errors" << std::endl;
+
+	return nbErrors;
+}
@@ -0,0 +1,116 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include "Topology/generic/parameters.h"
+#include "Topology/map/map2.h"
+#include "Topology/map/map3.h"
+#include "Topology/generic/mapImpl/mapMono.h"
+#include "Topology/generic/mapImpl/mapMonoAoS.h"
+#include "Algo/Tiling/Surface/square.h"
+#include "Algo/Tiling/Volume/cubic.h"
+
+using namespace CGoGN ;
+
+/**
+ * same topological maps with separated (MapMono) and interleaved (MapMonoAoS) relations
+ */
+struct PFP2: public PFP_STANDARD
+{
+	typedef Map2<MapMono> MAP;
+};
+
+struct PFP2_AOS: public PFP_STANDARD
+{
+	typedef Map2<MapMonoAoS<> > MAP;
+};
+
+struct PFP3: public PFP_STANDARD
+{
+	typedef Map3<MapMono> MAP;
+};
+
+struct PFP3_AOS: public PFP_STANDARD
+{
+	typedef Map3<MapMonoAoS<> > MAP;
+};
+
+template <typename MAP_A, typename MAP_B>
+bool sameTopo(MAP_A& ma, MAP_B& mb)
+{
+	if (ma.getNbDarts() != mb.getNbDarts())
+		return false;
+	Dart db = mb.begin();
+	for (Dart d = ma.begin(); d != ma.end(); ma.next(d), mb.next(db))
+	{
+		if ((d != db) || (ma.phi1(d) != mb.phi1(db)) || (ma.phi_1(d) != mb.phi_1(db)) || (ma.phi2(d) != mb.phi2(db)))
+			return false;
+	}
+	return true;
+}
+
+int main()
+{
+	bool ok = true;
+
+	PFP3::MAP map3;
+	PFP3_AOS::MAP map3aos;
+	Algo::Volume::Tilings::Cubic::Grid<PFP3> grid(map3, 4, 4, 4);
+	Algo::Volume::Tilings::Cubic::Grid<PFP3_AOS> gridAos(map3aos, 4, 4, 4);
+	ok &= sameTopo(map3, map3aos);
+	for (Dart d = map3.begin(); d != map3.end(); map3.next(d))
+		ok &= map3.phi3(d) == map3aos.phi3(d);
+	std::cout << "Map3 grid: " << (ok ? "ok" : "differs") << std::endl;
+
+	// a map saved with separated relations is loaded with interleaved ones
+	map3.saveMapBin("aos_mono.map");
+	PFP3_AOS::MAP loaded;
+	ok &= loaded.loadMapBin("aos_mono.map") && sameTopo(map3, loaded);
+	map3aos.saveMapBin("aos_aos.map");
+	ok &= loaded.loadMapBin("aos_aos.map") && sameTopo(map3, loaded);
+	std::cout << "load: " << (ok ? "ok" : "differs") << std::endl;
+
+	// interleaved relations can not be read as separated ones
+	PFP3::MAP loadedMono;
+	ok &= !loadedMono.loadMapBin("aos_aos.map");
+	ok &= !loadedMono.copyFrom(map3aos) && !loaded.copyFrom(map3);
+	ok &= loadedMono.copyFrom(map3) && sameTopo(map3, loadedMono);
+	std::cout << "incompatible maps: " << (ok ? "ok" : "differs") << std::endl;
+
+	// operations that replace the whole phi1 relation
+	PFP2::MAP map2;
+	PFP2_AOS::MAP map2aos;
+	Algo::Surface::Tilings::Square::Grid<PFP2> square(map2, 5, 7, true);
+	Algo::Surface::Tilings::Square::Grid<PFP2_AOS> squareAos(map2aos, 5, 7, true);
+	map2.addAttribute<int, VERTEX, PFP2::MAP>("v");
+	map2.addAttribute<int, FACE, PFP2::MAP>("f");
+	map2aos.addAttribute<int, VERTEX, PFP2_AOS::MAP>("v");
+	map2aos.addAttribute<int, FACE, PFP2_AOS::MAP>("f");
+	map2.computeDual();
+	map2aos.computeDual();
+	ok &= sameTopo(map2, map2aos) && map2aos.check();
+	std::cout << "dual: " << (ok ? "ok" : "differs") << std::endl;
+
+	return ok ? 0 : 1;
+}
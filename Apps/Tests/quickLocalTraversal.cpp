@@ -0,0 +1,122 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+
+#include "Topology/generic/parameters.h"
+#include "Topology/map/embeddedMap2.h"
+#include "Topology/map/embeddedMap3.h"
+#include "Topology/generic/traversor/traversor2.h"
+#include "Topology/generic/traversor/traversor3.h"
+#include "Algo/Tiling/Surface/square.h"
+#include "Algo/Tiling/Volume/cubic.h"
+#include "Algo/Topo/basic.h"
+
+using namespace CGoGN ;
+
+/**
+ * local traversals of the cells with and without the quick incident / adjacent tables
+ */
+struct PFP2: public PFP_STANDARD
+{
+	typedef EmbeddedMap2 MAP;
+};
+
+struct PFP3: public PFP_STANDARD
+{
+	typedef EmbeddedMap3 MAP;
+};
+
+template <typename MAP>
+std::vector<Dart> localTraversals2(MAP& map)
+{
+	std::vector<Dart> darts;
+	foreach_cell<VERTEX>(map, [&] (Vertex v)
+	{
+		foreach_incident2<EDGE>(map, v, [&] (Edge e) { darts.push_back(e.dart); });
+		foreach_adjacent2<EDGE>(map, v, [&] (Vertex w) { darts.push_back(w.dart); });
+		darts.push_back(NIL);
+	});
+	foreach_cell<FACE>(map, [&] (Face f)
+	{
+		foreach_incident2<VERTEX>(map, f, [&] (Vertex v) { darts.push_back(v.dart); });
+		darts.push_back(NIL);
+	});
+	return darts;
+}
+
+template <typename MAP>
+std::vector<Dart> localTraversals3(MAP& map)
+{
+	std::vector<Dart> darts;
+	foreach_cell<VERTEX>(map, [&] (Vertex v)
+	{
+		foreach_incident3<VOLUME>(map, v, [&] (Vol w) { darts.push_back(w.dart); });
+		foreach_adjacent3<EDGE>(map, v, [&] (Vertex w) { darts.push_back(w.dart); });
+		darts.push_back(NIL);
+	});
+	return darts;
+}
+
+int main()
+{
+	bool ok = true;
+
+	for (unsigned int nbth = 1; nbth <= 4; nbth += 3)
+	{
+		PFP2::MAP map2;
+		Algo::Surface::Tilings::Square::Grid<PFP2> grid(map2, 20, 20, true);
+		Algo::Topo::initAllOrbitsEmbedding<VERTEX>(map2);
+		Algo::Topo::initAllOrbitsEmbedding<FACE>(map2);
+		std::vector<Dart> ref2 = localTraversals2(map2);
+
+		map2.enableQuickIncidentTraversal<PFP2::MAP, VERTEX, EDGE>(nbth);
+		map2.enableQuickAdjacentTraversal<PFP2::MAP, VERTEX, EDGE>(nbth);
+		map2.enableQuickIncidentTraversal<PFP2::MAP, FACE, VERTEX>(nbth);
+		ok &= localTraversals2(map2) == ref2;
+
+		// tables updated after a topological modification
+		map2.cutEdge(map2.begin());
+		map2.updateQuickIncidentTraversal<PFP2::MAP, VERTEX, EDGE>(nbth);
+		map2.updateQuickAdjacentTraversal<PFP2::MAP, VERTEX, EDGE>(nbth);
+		map2.updateQuickIncidentTraversal<PFP2::MAP, FACE, VERTEX>(nbth);
+		std::vector<Dart> quick2 = localTraversals2(map2);
+		map2.disableQuickIncidentTraversal<VERTEX, EDGE>();
+		map2.disableQuickAdjacentTraversal<VERTEX, EDGE>();
+		map2.disableQuickIncidentTraversal<FACE, VERTEX>();
+		ok &= quick2 == localTraversals2(map2);
+		std::cout << "Map2 (" << nbth << " threads): " << (ok ? "ok" : "differs") << std::endl;
+
+		PFP3::MAP map3;
+		Algo::Volume::Tilings::Cubic::Grid<PFP3> cubic(map3, 5, 5, 5);
+		Algo::Topo::initAllOrbitsEmbedding<VERTEX>(map3);
+		std::vector<Dart> ref3 = localTraversals3(map3);
+		map3.enableQuickIncidentTraversal<PFP3::MAP, VERTEX, VOLUME>(nbth);
+		map3.enableQuickAdjacentTraversal<PFP3::MAP, VERTEX, EDGE>(nbth);
+		ok &= localTraversals3(map3) == ref3;
+		std::cout << "Map3 (" << nbth << " threads): " << (ok ? "ok" : "differs") << std::endl;
+	}
+
+	return ok ? 0 : 1;
+}
@@ -29,6 +29,8 @@
 #include "Geometry/inclusion.h"
 #include "Geometry/orientation.h"
 
+#include "Algo/Geometry/weldVertices.h"
+
 namespace CGoGN
 {
 
@@ -47,8 +49,13 @@ bool isBetween(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3,
 template <typename PFP>
 void mergeVertex(typename PFP::MAP& map, VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& positions, Dart d, Dart e, int precision);
 
+/**
+ * Merge the vertices that are near (Geom::Vector::isNear with precision) and not already merged:
+ * the candidate pairs are found with the grid of Algo::Geometry::closePairs (instead of testing all the pairs)
+ * and each vertex, in traversal order, absorbs the following vertices near it
+ */
 template <typename PFP>
-void mergeVertices(typename PFP::MAP& map, VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& positions, int precision);
+void mergeVertices(typename PFP::MAP& map, VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& positions, int precision, unsigned int nbth = CGoGN::Parallel::NumberOfThreads);
 
 }
 
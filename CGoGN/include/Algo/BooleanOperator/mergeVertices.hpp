@@ -76,31 +76,52 @@ void mergeVertex(typename PFP::MAP& map, VertexAttribute<typename PFP::VEC3, typ
 }
 
 template <typename PFP>
-void mergeVertices(typename PFP::MAP& map, VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& positions, int precision)
+void mergeVertices(typename PFP::MAP& map, VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& positions, int precision, unsigned int nbth)
 {
-	// TODO optimiser en triant les sommets
-	// map.template enableQuickTraversal<VERTEX>();
-	TraversorV<typename PFP::MAP> travV1(map) ;
+	typedef typename PFP::REAL REAL;
+
+	// one dart per vertex, in traversal order
+	std::vector<Dart> vertices;
+	foreach_cell<VERTEX>(map, [&] (Vertex v)
+	{
+		vertices.push_back(v.dart);
+	});
+	const unsigned int nbVertices = (unsigned int)(vertices.size());
+
+	// candidate pairs (i < j) of vertices that may be near
+	std::vector< std::pair<unsigned int, unsigned int> > pairs;
+	if (precision < 0)
+	{
+		// isNear does not bound the distance: all the vertices are candidates
+		for (unsigned int j = 1; j < nbVertices; ++j)
+			pairs.push_back(std::make_pair(0u, j));
+	}
+	else
+	{
+		Algo::Geometry::closePairs<typename PFP::VEC3>(nbVertices, [&] (unsigned int i) -> const typename PFP::VEC3&
+		{
+			return positions[vertices[i]];
+		}, REAL(precision), pairs, nbth);
+	}
+
+	// merge each vertex with the following unmerged vertices near it
 	CellMarker<typename PFP::MAP, VERTEX> vM(map);
-	for(Dart d1 = travV1.begin() ; d1 != travV1.end() ; d1 = travV1.next())
+	unsigned int p = 0;
+	for (unsigned int i = 0; i < nbVertices; ++i)
 	{
-		vM.mark(d1);
-		TraversorV<typename PFP::MAP> travV2(map) ;
-		for(Dart d2 = travV2.begin() ; d2 != travV2.end() ; d2 = travV2.next())
+		Dart d1 = vertices[i];
+		bool merged = vM.isMarked(d1);
+		if (!merged)
+			vM.mark(d1);
+		for (; (p < pairs.size()) && (pairs[p].first == i); ++p)
 		{
-			if(!vM.isMarked(d2))
-			{
-				if(positions[d1].isNear(positions[d2], precision))
-				{
-					if (map.sameVertex(d1,d2))
-						std::cout << "fusion: sameVertex" << std::endl ;
-					if (!map.sameVertex(d1,d2))
-						mergeVertex<PFP>(map,positions,d1,d2,precision);
-				}
-			}
+			if (merged)
+				continue;
+			Dart d2 = vertices[pairs[p].second];
+			if (!vM.isMarked(d2) && positions[d1].isNear(positions[d2], precision) && !map.sameVertex(d1, d2))
+				mergeVertex<PFP>(map, positions, d1, d2, precision);
 		}
 	}
-	//	map.template disableQuickTraversal<VERTEX>();
 }
 
 }
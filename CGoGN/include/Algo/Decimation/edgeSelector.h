@@ -29,6 +29,7 @@
 #include "Algo/Decimation/approximator.h"
 #include "Algo/Geometry/boundingbox.h"
 #include "Utils/qem.h"
+#include "Utils/indexedHeap.h"
 #include "Algo/Geometry/normal.h"
 #include "Algo/Selection/collector.h"
 #include "Algo/Geometry/curvature.h"
@@ -109,7 +110,7 @@ private:
 
 	typedef struct
 	{
-		typename std::multimap<REAL,Dart>::iterator it ;
+		typename Utils::IndexedHeap<REAL,Dart>::iterator it ;
 		bool valid ;
 		static std::string CGoGNnameOfType() { return "LengthEdgeInfo" ; }
 	} LengthEdgeInfo ;
@@ -117,8 +118,8 @@ private:
 
 	EdgeAttribute<EdgeInfo, MAP> edgeInfo ;
 
-	std::multimap<REAL,Dart> edges ;
-	typename std::multimap<REAL,Dart>::iterator cur ;
+	Utils::IndexedHeap<REAL,Dart> edges ;
+	typename Utils::IndexedHeap<REAL,Dart>::iterator cur ;
 
 	void initEdgeInfo(Dart d) ;
 	void updateEdgeInfo(Dart d, bool recompute) ;
@@ -176,7 +177,7 @@ private:
 
 	typedef	struct
 	{
-		typename std::multimap<REAL,Dart>::iterator it ;
+		typename Utils::IndexedHeap<REAL,Dart>::iterator it ;
 		bool valid ;
 		static std::string CGoGNnameOfType() { return "QEMedgeInfo" ; }
 	} QEMedgeInfo ;
@@ -186,8 +187,8 @@ private:
 	VertexAttribute<Utils::Quadric<REAL>, MAP> quadric ;
 	Utils::Quadric<REAL> tmpQ ;
 
-	std::multimap<REAL,Dart> edges ;
-	typename std::multimap<REAL,Dart>::iterator cur ;
+	Utils::IndexedHeap<REAL,Dart> edges ;
+	typename Utils::IndexedHeap<REAL,Dart>::iterator cur ;
 
 	void initEdgeInfo(Dart d) ;
 	void updateEdgeInfo(Dart d, bool recompute) ;
@@ -232,7 +233,7 @@ private:
 
 	typedef	struct
 	{
-		typename std::multimap<REAL,Dart>::iterator it ;
+		typename Utils::IndexedHeap<REAL,Dart>::iterator it ;
 		bool valid ;
 		static std::string CGoGNnameOfType() { return "QEMedgeInfo" ; }
 	} QEMedgeInfo ;
@@ -241,8 +242,8 @@ private:
 	EdgeAttribute<EdgeInfo, MAP> edgeInfo ;
 	VertexAttribute<Utils::Quadric<REAL>, MAP> quadric ;
 
-	std::multimap<REAL,Dart> edges ;
-	typename std::multimap<REAL,Dart>::iterator cur ;
+	Utils::IndexedHeap<REAL,Dart> edges ;
+	typename Utils::IndexedHeap<REAL,Dart>::iterator cur ;
 
 	void initEdgeInfo(Dart d) ;
 	void updateEdgeInfo(Dart d, bool recompute) ;
@@ -288,7 +289,7 @@ private:
 
 	typedef	struct
 	{
-		typename std::multimap<REAL,Dart>::iterator it ;
+		typename Utils::IndexedHeap<REAL,Dart>::iterator it ;
 		bool valid ;
 		static std::string CGoGNnameOfType() { return "NormalAreaEdgeInfo" ; }
 	} NormalAreaEdgeInfo ;
@@ -297,8 +298,8 @@ private:
 	EdgeAttribute<EdgeInfo, MAP> edgeInfo ;
 	EdgeAttribute<Geom::Matrix<3,3,REAL>, MAP> edgeMatrix ;
 
-	std::multimap<REAL,Dart> edges ;
-	typename std::multimap<REAL,Dart>::iterator cur ;
+	Utils::IndexedHeap<REAL,Dart> edges ;
+	typename Utils::IndexedHeap<REAL,Dart>::iterator cur ;
 
 	void initEdgeInfo(Dart d) ;
 	void updateEdgeInfo(Dart d) ;
@@ -342,7 +343,7 @@ private:
 
 	typedef	struct
 	{
-		typename std::multimap<REAL,Dart>::iterator it ;
+		typename Utils::IndexedHeap<REAL,Dart>::iterator it ;
 		bool valid ;
 		static std::string CGoGNnameOfType() { return "CurvatureEdgeInfo" ; }
 	} CurvatureEdgeInfo ;
@@ -361,8 +362,8 @@ private:
 	VertexAttribute<VEC3, MAP> Kmin ;
 	VertexAttribute<VEC3, MAP> Knormal ;
 
-	std::multimap<REAL,Dart> edges ;
-	typename std::multimap<REAL,Dart>::iterator cur ;
+	Utils::IndexedHeap<REAL,Dart> edges ;
+	typename Utils::IndexedHeap<REAL,Dart>::iterator cur ;
 
 	void initEdgeInfo(Dart d) ;
 	void updateEdgeInfo(Dart d, bool recompute) ;
@@ -453,7 +454,7 @@ private:
 
 	typedef	struct
 	{
-		typename std::multimap<REAL,Dart>::iterator it ;
+		typename Utils::IndexedHeap<REAL,Dart>::iterator it ;
 		bool valid ;
 		static std::string CGoGNnameOfType() { return "CurvatureTensorEdgeInfo" ; }
 	} CurvatureTensorEdgeInfo ;
@@ -463,8 +464,8 @@ private:
 	EdgeAttribute<REAL, MAP> edgeangle ;
 	EdgeAttribute<REAL, MAP> edgearea ;
 
-	std::multimap<REAL,Dart> edges ;
-	typename std::multimap<REAL,Dart>::iterator cur ;
+	Utils::IndexedHeap<REAL,Dart> edges ;
+	typename Utils::IndexedHeap<REAL,Dart>::iterator cur ;
 
 	void initEdgeInfo(Dart d) ;
 	void updateEdgeInfo(Dart d) ; // TODO : usually has a 2nd arg (, bool recompute) : why ??
@@ -521,7 +522,7 @@ private:
 
 	typedef	struct
 	{
-		typename std::multimap<REAL,Dart>::iterator it ;
+		typename Utils::IndexedHeap<REAL,Dart>::iterator it ;
 		bool valid ;
 		static std::string CGoGNnameOfType() { return "MinDetailEdgeInfo" ; }
 	} MinDetailEdgeInfo ;
@@ -529,8 +530,8 @@ private:
 
 	EdgeAttribute<EdgeInfo, MAP> edgeInfo ;
 
-	std::multimap<REAL,Dart> edges ;
-	typename std::multimap<REAL,Dart>::iterator cur ;
+	Utils::IndexedHeap<REAL,Dart> edges ;
+	typename Utils::IndexedHeap<REAL,Dart>::iterator cur ;
 
 	void initEdgeInfo(Dart d) ;
 	void updateEdgeInfo(Dart d, bool recompute) ;
@@ -577,7 +578,7 @@ private:
 
 	typedef	struct
 	{
-		typename std::multimap<REAL,Dart>::iterator it ;
+		typename Utils::IndexedHeap<REAL,Dart>::iterator it ;
 		bool valid ;
 		static std::string CGoGNnameOfType() { return "ColorNaiveEdgeInfo" ; }
 	} ColorNaiveedgeInfo ;
@@ -586,8 +587,8 @@ private:
 	EdgeAttribute<EdgeInfo, MAP> edgeInfo ;
 	VertexAttribute<Utils::Quadric<REAL>, MAP> m_quadric ;
 
-	std::multimap<REAL,Dart> edges ;
-	typename std::multimap<REAL,Dart>::iterator cur ;
+	Utils::IndexedHeap<REAL,Dart> edges ;
+	typename Utils::IndexedHeap<REAL,Dart>::iterator cur ;
 
 	void initEdgeInfo(Dart d) ;
 	void updateEdgeInfo(Dart d, bool recompute) ;
@@ -645,7 +646,7 @@ private:
 
 	typedef	struct
 	{
-		typename std::multimap<REAL,Dart>::iterator it ;
+		typename Utils::IndexedHeap<REAL,Dart>::iterator it ;
 		bool valid ;
 		static std::string CGoGNnameOfType() { return "GeomColOptGradEdgeInfo" ; }
 	} ColorNaiveedgeInfo ;
@@ -654,8 +655,8 @@ private:
 	EdgeAttribute<EdgeInfo, MAP> edgeInfo ;
 	VertexAttribute<Utils::Quadric<REAL>, MAP> m_quadric ;
 
-	std::multimap<REAL,Dart> edges ;
-	typename std::multimap<REAL,Dart>::iterator cur ;
+	Utils::IndexedHeap<REAL,Dart> edges ;
+	typename Utils::IndexedHeap<REAL,Dart>::iterator cur ;
 
 	void initEdgeInfo(Dart d) ;
 	void updateEdgeInfo(Dart d) ;
@@ -735,7 +736,7 @@ private:
 
 	typedef	struct
 	{
-		typename std::multimap<REAL,Dart>::iterator it ;
+		typename Utils::IndexedHeap<REAL,Dart>::iterator it ;
 		bool valid ;
 		static std::string CGoGNnameOfType() { return "QEMextColorEdgeInfo" ; }
 	} QEMextColorEdgeInfo ;
@@ -744,8 +745,8 @@ private:
 	EdgeAttribute<EdgeInfo, MAP> edgeInfo ;
 	VertexAttribute<Utils::QuadricNd<REAL,6>, MAP> m_quadric ;
 
-	std::multimap<REAL,Dart> edges ;
-	typename std::multimap<REAL,Dart>::iterator cur ;
+	Utils::IndexedHeap<REAL,Dart> edges ;
+	typename Utils::IndexedHeap<REAL,Dart>::iterator cur ;
 
 	void initEdgeInfo(Dart d) ;
 	void updateEdgeInfo(Dart d, bool recompute) ;
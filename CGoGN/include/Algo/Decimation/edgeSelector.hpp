@@ -188,7 +188,7 @@ void EdgeSelector_Length<PFP>::updateBeforeCollapse(Dart d)
 	edgeE = &(edgeInfo[m.phi_1(d)]) ;	// the concerned edges
 	if(edgeE->valid)
 		edges.erase(edgeE->it) ;
-									// from the multimap
+									// from the heap
 	Dart dd = m.phi2(d) ;
 	if(dd != d)
 	{
@@ -263,7 +263,7 @@ void EdgeSelector_Length<PFP>::updateEdgeInfo(Dart d, bool recompute)
 	if(recompute)
 	{
 		if(einfo.valid)
-			edges.erase(einfo.it) ;			// remove the edge from the multimap
+			edges.erase(einfo.it) ;			// remove the edge from the heap
 		if(m.edgeCanCollapse(d))
 			computeEdgeInfo(d, einfo) ;
 		else
@@ -334,7 +334,7 @@ bool EdgeSelector_QEM<PFP>::init()
 	for (Edge e : allEdgesOf(m))
 	{
 		initEdgeInfo(e.dart) ;	// init the edges with their optimal position
-	}							// and insert them in the multimap according to their error
+	}							// and insert them in the heap according to their error
 
 	cur = edges.begin() ; // init the current edge to the first one
 
@@ -366,7 +366,7 @@ void EdgeSelector_QEM<PFP>::updateBeforeCollapse(Dart d)
 	edgeE = &(edgeInfo[m.phi_1(d)]) ;	// the concerned edges
 	if(edgeE->valid)
 		edges.erase(edgeE->it) ;
-									// from the multimap
+									// from the heap
 	Dart dd = m.phi2(d) ;
 	if(dd != d)
 	{
@@ -450,7 +450,7 @@ void EdgeSelector_QEM<PFP>::updateEdgeInfo(Dart d, bool recompute)
 	if(recompute)
 	{
 		if(einfo.valid)
-			edges.erase(einfo.it) ;		// remove the edge from the multimap
+			edges.erase(einfo.it) ;		// remove the edge from the heap
 		if(m.edgeCanCollapse(d))
 			computeEdgeInfo(d, einfo) ;
 		else
@@ -532,7 +532,7 @@ bool EdgeSelector_QEMml<PFP>::init()
 	for (Edge e : allEdgesOf(m))
 	{
 		initEdgeInfo(e.dart) ;	// init the edges with their optimal position
-	}							// and insert them in the multimap according to their error
+	}							// and insert them in the heap according to their error
 
 	cur = edges.begin() ; // init the current edge to the first one
 
@@ -564,7 +564,7 @@ void EdgeSelector_QEMml<PFP>::updateBeforeCollapse(Dart d)
 	edgeE = &(edgeInfo[m.phi_1(d)]) ;	// the concerned edges
 	if(edgeE->valid)
 		edges.erase(edgeE->it) ;
-									// from the multimap
+									// from the heap
 	Dart dd = m.phi2(d) ;
 	if(dd != d)
 	{
@@ -691,7 +691,7 @@ void EdgeSelector_QEMml<PFP>::updateEdgeInfo(Dart d, bool recompute)
 	if(recompute)
 	{
 		if(einfo.valid)
-			edges.erase(einfo.it) ;		// remove the edge from the multimap
+			edges.erase(einfo.it) ;		// remove the edge from the heap
 		if(m.edgeCanCollapse(d))
 			computeEdgeInfo(d, einfo) ;
 		else
@@ -800,7 +800,7 @@ void EdgeSelector_NormalArea<PFP>::updateBeforeCollapse(Dart d)
 		edges.erase(edgeE->it) ;
 		edgeE->valid = false;
 	}
-									// from the multimap
+									// from the heap
 	Dart dd = m.phi2(d) ;
 	edgeE = &(edgeInfo[m.phi1(dd)]) ;
 	if(edgeE->valid)
@@ -829,7 +829,7 @@ void EdgeSelector_NormalArea<PFP>::updateAfterCollapse(Dart d2, Dart /*dd2*/)
 		computeEdgeMatrix(dit);
 	}
 
-	// update the multimap
+	// update the heap
 
 	Traversor2VVaE<MAP> tv (m,d2);
 	CellMarkerStore<MAP, EDGE> eMark (m);
@@ -870,7 +870,7 @@ void EdgeSelector_NormalArea<PFP>::updateEdgeInfo(Dart d)
 	EdgeInfo& einfo = edgeInfo[d] ;
 
 	if(einfo.valid)
-		edges.erase(einfo.it) ;		// remove the edge from the multimap
+		edges.erase(einfo.it) ;		// remove the edge from the heap
 
 	if(m.edgeCanCollapse(d))
 		computeEdgeInfo(d, einfo) ;
@@ -970,7 +970,7 @@ bool EdgeSelector_Curvature<PFP>::init()
 	for (Edge e : allEdgesOf(m))
 	{
 		initEdgeInfo(e.dart) ;	// init the edges with their optimal position
-	}							// and insert them in the multimap according to their error
+	}							// and insert them in the heap according to their error
 
 	cur = edges.begin() ; // init the current edge to the first one
 
@@ -1002,7 +1002,7 @@ void EdgeSelector_Curvature<PFP>::updateBeforeCollapse(Dart d)
 	edgeE = &(edgeInfo[m.phi_1(d)]) ;	// the concerned edges
 	if(edgeE->valid)
 		edges.erase(edgeE->it) ;
-									// from the multimap
+									// from the heap
 	Dart dd = m.phi2(d) ;
 	if(dd != d)
 	{
@@ -1086,7 +1086,7 @@ void EdgeSelector_Curvature<PFP>::updateEdgeInfo(Dart d, bool recompute)
 	if(recompute)
 	{
 		if(einfo.valid)
-			edges.erase(einfo.it) ;			// remove the edge from the multimap
+			edges.erase(einfo.it) ;			// remove the edge from the heap
 		if(m.edgeCanCollapse(d))
 			computeEdgeInfo(d, einfo) ;
 		else
@@ -1181,7 +1181,7 @@ bool EdgeSelector_CurvatureTensor<PFP>::init()
 	for (Edge e : allEdgesOf(m))
 	{
 		initEdgeInfo(e.dart) ;	// init the edges with their optimal position
-	}							// and insert them in the multimap according to their error
+	}							// and insert them in the heap according to their error
 
 	cur = edges.begin() ; // init the current edge to the first one
 
@@ -1224,7 +1224,7 @@ void EdgeSelector_CurvatureTensor<PFP>::updateBeforeCollapse(Dart d)
 		edges.erase(edgeE->it) ;
 		edgeE->valid = false;
 	}
-									// from the multimap
+									// from the heap
 	Dart dd = m.phi2(d) ;
 	edgeE = &(edgeInfo[m.phi1(dd)]) ;
 	if(edgeE->valid)
@@ -1262,7 +1262,7 @@ void EdgeSelector_CurvatureTensor<PFP>::updateAfterCollapse(Dart d2, Dart /*dd2*
 		}
 	}
 
-	// update the multimap
+	// update the heap
 	Traversor2VVaE<MAP> tv (m,d2);
 	eMark.unmarkAll();
 	for(Dart dit = tv.begin() ; dit != tv.end() ; dit = tv.next())
@@ -1302,7 +1302,7 @@ void EdgeSelector_CurvatureTensor<PFP>::updateEdgeInfo(Dart d)
 	EdgeInfo& einfo = edgeInfo[d] ;
 
 	if(einfo.valid)
-		edges.erase(einfo.it) ;		// remove the edge from the multimap
+		edges.erase(einfo.it) ;		// remove the edge from the heap
 
 	if(m.edgeCanCollapse(d))
 		computeEdgeInfo(d, einfo) ;
@@ -1393,7 +1393,7 @@ bool EdgeSelector_MinDetail<PFP>::init()
 	for (Edge e : allEdgesOf(m))
 	{
 		initEdgeInfo(e.dart) ;	// init the edges with their optimal position
-	}							// and insert them in the multimap according to their error
+	}							// and insert them in the heap according to their error
 
 	cur = edges.begin() ; // init the current edge to the first one
 
@@ -1425,7 +1425,7 @@ void EdgeSelector_MinDetail<PFP>::updateBeforeCollapse(Dart d)
 	edgeE = &(edgeInfo[m.phi_1(d)]) ;	// the concerned edges
 	if(edgeE->valid)
 		edges.erase(edgeE->it) ;
-									// from the multimap
+									// from the heap
 	Dart dd = m.phi2(d) ;
 	if(dd != d)
 	{
@@ -1500,7 +1500,7 @@ void EdgeSelector_MinDetail<PFP>::updateEdgeInfo(Dart d, bool recompute)
 	if(recompute)
 	{
 		if(einfo.valid)
-			edges.erase(einfo.it) ;			// remove the edge from the multimap
+			edges.erase(einfo.it) ;			// remove the edge from the heap
 		if(m.edgeCanCollapse(d))
 			computeEdgeInfo(d, einfo) ;
 		else
@@ -1581,7 +1581,7 @@ bool EdgeSelector_ColorNaive<PFP>::init()
 	for (Edge e : allEdgesOf(m))
 	{
 		initEdgeInfo(e.dart) ;	// init the edges with their optimal position
-	}							// and insert them in the multimap according to their error
+	}							// and insert them in the heap according to their error
 
 	cur = edges.begin() ; // init the current edge to the first one
 
@@ -1613,7 +1613,7 @@ void EdgeSelector_ColorNaive<PFP>::updateBeforeCollapse(Dart d)
 	edgeE = &(edgeInfo[m.phi_1(d)]) ;	// the edges that will disappear
 	if(edgeE->valid)
 		edges.erase(edgeE->it) ;
-										// from the multimap
+										// from the heap
 	Dart dd = m.phi2(d) ;
 	if(dd != d)
 	{
@@ -1702,7 +1702,7 @@ void EdgeSelector_ColorNaive<PFP>::updateEdgeInfo(Dart d, bool recompute)
 	if(recompute)
 	{
 		if(einfo.valid)
-			edges.erase(einfo.it) ;		// remove the edge from the multimap
+			edges.erase(einfo.it) ;		// remove the edge from the heap
 		if(m.edgeCanCollapse(d))
 			computeEdgeInfo(d, einfo) ;
 		else
@@ -1806,7 +1806,7 @@ bool EdgeSelector_GeomColOptGradient<PFP>::init()
 	for (Edge e : allEdgesOf(m))
 	{
 		initEdgeInfo(e.dart) ;	// init the edges with their optimal position
-	}							// and insert them in the multimap according to their error
+	}							// and insert them in the heap according to their error
 
 	cur = edges.begin() ; // init the current edge to the first one
 
@@ -1830,7 +1830,7 @@ void EdgeSelector_GeomColOptGradient<PFP>::updateBeforeCollapse(Dart d)
 	const Dart& v0 = d ;
 	const Dart& v1 = m.phi2(d) ;
 
-	// remove all the edges that will disappear from the multimap
+	// remove all the edges that will disappear from the heap
 	// namely : all edges adjacent to a vertex which is adjacent
 	// to either v0 or v1
 
@@ -1909,7 +1909,7 @@ void EdgeSelector_GeomColOptGradient<PFP>::updateAfterCollapse(Dart d2, Dart /*d
 	// update quadrics
 	recomputeQuadric(d2, true) ;
 
-	// update the multimap
+	// update the heap
 	Traversor2VVaE<MAP> tv(m, d2);
 	CellMarkerStore<MAP, EDGE> eMark(m);
 	for(Dart dit = tv.begin() ; dit != tv.end() ; dit = tv.next())
@@ -1949,7 +1949,7 @@ void EdgeSelector_GeomColOptGradient<PFP>::updateEdgeInfo(Dart d)
 	EdgeInfo& einfo = edgeInfo[d] ;
 
 	if(einfo.valid)
-		edges.erase(einfo.it) ;		// remove the edge from the multimap
+		edges.erase(einfo.it) ;		// remove the edge from the heap
 
 	if(m.edgeCanCollapse(d))
 		computeEdgeInfo(d, einfo) ;
@@ -2100,7 +2100,7 @@ bool EdgeSelector_QEMextColor<PFP>::init()
 	for (Edge e : allEdgesOf(m))
 	{
 		initEdgeInfo(e.dart) ;	// init the edges with their optimal position
-	}							// and insert them in the multimap according to their error
+	}							// and insert them in the heap according to their error
 
 	cur = edges.begin() ; // init the current edge to the first one
 
@@ -2132,7 +2132,7 @@ void EdgeSelector_QEMextColor<PFP>::updateBeforeCollapse(Dart d)
 	edgeE = &(edgeInfo[m.phi_1(d)]) ;	// the edges that will disappear
 	if(edgeE->valid)
 		edges.erase(edgeE->it) ;
-										// from the multimap
+										// from the heap
 	Dart dd = m.phi2(d) ;
 	if(dd != d)
 	{
@@ -2233,7 +2233,7 @@ void EdgeSelector_QEMextColor<PFP>::updateEdgeInfo(Dart d, bool recompute)
 	if(recompute)
 	{
 		if(einfo.valid)
-			edges.erase(einfo.it) ;		// remove the edge from the multimap
+			edges.erase(einfo.it) ;		// remove the edge from the heap
 		if(m.edgeCanCollapse(d))
 			computeEdgeInfo(d, einfo) ;
 		else
@@ -28,6 +28,7 @@
 #include "Algo/Decimation/selector.h"
 #include "Algo/Decimation/approximator.h"
 #include "Utils/qem.h"
+#include "Utils/indexedHeap.h"
 #include "Topology/generic/dart.h"
 
 namespace CGoGN
@@ -59,7 +60,7 @@ private:
 
 	typedef	struct
 	{
-		typename std::multimap<REAL, Dart>::iterator it;
+		typename Utils::IndexedHeap<REAL,Dart>::iterator it;
 		bool valid ;
 		static std::string CGoGNnameOfType() { return "QEMhalfEdgeInfo" ; }
 	} QEMhalfEdgeInfo ;
@@ -68,8 +69,8 @@ private:
 	DartAttribute<HalfEdgeInfo, MAP> halfEdgeInfo ;
 	VertexAttribute<Utils::Quadric<REAL>, MAP> m_quadric ;
 
-	std::multimap<REAL,Dart> halfEdges ;
-	typename std::multimap<REAL,Dart>::iterator cur ;
+	Utils::IndexedHeap<REAL,Dart> halfEdges ;
+	typename Utils::IndexedHeap<REAL,Dart>::iterator cur ;
 
 	void initHalfEdgeInfo(Dart d) ;
 	void updateHalfEdgeInfo(Dart d, bool recompute) ;
@@ -121,7 +122,7 @@ private:
 
 	typedef	struct
 	{
-		typename std::multimap<REAL,Dart>::iterator it ;
+		typename Utils::IndexedHeap<REAL,Dart>::iterator it ;
 		bool valid ;
 		static std::string CGoGNnameOfType() { return "QEMextColorHalfEdgeInfo" ; }
 	} QEMextColorHalfEdgeInfo ;
@@ -130,8 +131,8 @@ private:
 	DartAttribute<HalfEdgeInfo, MAP> halfEdgeInfo ;
 	VertexAttribute<Utils::QuadricNd<REAL,6>, MAP> m_quadric ;
 
-	std::multimap<REAL,Dart> halfEdges ;
-	typename std::multimap<REAL,Dart>::iterator cur ;
+	Utils::IndexedHeap<REAL,Dart> halfEdges ;
+	typename Utils::IndexedHeap<REAL,Dart>::iterator cur ;
 
 	void initHalfEdgeInfo(Dart d) ;
 	void updateHalfEdgeInfo(Dart d, bool recompute) ;
@@ -215,7 +216,7 @@ private:
 
 	typedef	struct
 	{
-		typename std::multimap<REAL,Dart>::iterator it ;
+		typename Utils::IndexedHeap<REAL,Dart>::iterator it ;
 		bool valid ;
 		static std::string CGoGNnameOfType() { return "QEMextColorNormalHalfEdgeInfo" ; }
 	} QEMextColorNormalHalfEdgeInfo ;
@@ -224,8 +225,8 @@ private:
 	DartAttribute<HalfEdgeInfo, MAP> halfEdgeInfo ;
 	VertexAttribute<Utils::QuadricNd<REAL,9>, MAP> m_quadric ;
 
-	std::multimap<REAL,Dart> halfEdges ;
-	typename std::multimap<REAL,Dart>::iterator cur ;
+	Utils::IndexedHeap<REAL,Dart> halfEdges ;
+	typename Utils::IndexedHeap<REAL,Dart>::iterator cur ;
 
 	void initHalfEdgeInfo(Dart d) ;
 	void updateHalfEdgeInfo(Dart d, bool recompute) ;
@@ -310,7 +311,7 @@ private:
 
 	typedef	struct
 	{
-		typename std::multimap<REAL,Dart>::iterator it ;
+		typename Utils::IndexedHeap<REAL,Dart>::iterator it ;
 		bool valid ;
 		static std::string CGoGNnameOfType() { return "ColorExperimentalHalfEdgeInfo" ; }
 	} QEMextColorHalfEdgeInfo ;
@@ -319,8 +320,8 @@ private:
 	DartAttribute<HalfEdgeInfo, MAP> halfEdgeInfo ;
 	VertexAttribute<Utils::Quadric<REAL>, MAP> m_quadric ;
 
-	std::multimap<REAL,Dart> halfEdges ;
-	typename std::multimap<REAL,Dart>::iterator cur ;
+	Utils::IndexedHeap<REAL,Dart> halfEdges ;
+	typename Utils::IndexedHeap<REAL,Dart>::iterator cur ;
 
 	void initHalfEdgeInfo(Dart d) ;
 	void updateHalfEdgeInfo(Dart d) ;
@@ -67,13 +67,13 @@ bool HalfEdgeSelector_QEMml<PFP>::init()
 		m_quadric[d_1] += q ;		// of the 3 incident vertices
 	}
 
-	// Init multimap for each Half-edge
+	// Init heap for each Half-edge
 	halfEdges.clear() ;
 
 	for(Dart d = m.begin(); d != m.end(); m.next(d))
 	{
 		initHalfEdgeInfo(d) ;	// init the edges with their optimal info
-	}							// and insert them in the multimap according to their error
+	}							// and insert them in the heap according to their error
 
 	cur = halfEdges.begin() ; 	// init the current edge to the first one
 
@@ -105,7 +105,7 @@ void HalfEdgeSelector_QEMml<PFP>::updateBeforeCollapse(Dart d)
 	edgeE = &(halfEdgeInfo[m.phi_1(d)]) ;	// the halfedges that will disappear
 	if(edgeE->valid)
 		halfEdges.erase(edgeE->it) ;
-										// from the multimap
+										// from the heap
 	Dart dd = m.phi2(d) ;
 	assert(dd != d) ;
 	if(dd != d)
@@ -209,7 +209,7 @@ void HalfEdgeSelector_QEMml<PFP>::updateHalfEdgeInfo(Dart d, bool recompute)
 	if(recompute)
 	{
 		if(heinfo.valid)
-			halfEdges.erase(heinfo.it) ;			// remove the edge from the multimap
+			halfEdges.erase(heinfo.it) ;			// remove the edge from the heap
 		if(m.edgeCanCollapse(d))
 			computeHalfEdgeInfo(d, heinfo) ;
 		else
@@ -303,13 +303,13 @@ bool HalfEdgeSelector_QEMextColor<PFP>::init()
 		m_quadric[d_1] += q ;		// of the 3 incident vertices
 	}
 
-	// Init multimap for each Half-edge
+	// Init heap for each Half-edge
 	halfEdges.clear() ;
 
 	for(Dart d = m.begin(); d != m.end(); m.next(d))
 	{
 		initHalfEdgeInfo(d) ;	// init the edges with their optimal info
-	}							// and insert them in the multimap according to their error
+	}							// and insert them in the heap according to their error
 
 	cur = halfEdges.begin() ; 	// init the current edge to the first one
 
@@ -341,7 +341,7 @@ void HalfEdgeSelector_QEMextColor<PFP>::updateBeforeCollapse(Dart d)
 	edgeE = &(halfEdgeInfo[m.phi_1(d)]) ;	// the halfedges that will disappear
 	if(edgeE->valid)
 		halfEdges.erase(edgeE->it) ;
-										// from the multimap
+										// from the heap
 	Dart dd = m.phi2(d) ;
 	assert(dd != d) ;
 	if(dd != d)
@@ -457,7 +457,7 @@ void HalfEdgeSelector_QEMextColor<PFP>::updateHalfEdgeInfo(Dart d, bool recomput
 	if(recompute)
 	{
 		if(heinfo.valid)
-			halfEdges.erase(heinfo.it) ;			// remove the edge from the multimap
+			halfEdges.erase(heinfo.it) ;			// remove the edge from the heap
 		if(m.edgeCanCollapse(d))
 			computeHalfEdgeInfo(d, heinfo) ;
 		else
@@ -586,13 +586,13 @@ bool HalfEdgeSelector_QEMextColorNormal<PFP>::init()
 		m_quadric[d_1] += q ;		// of the 3 incident vertices
 	}
 
-	// Init multimap for each Half-edge
+	// Init heap for each Half-edge
 	halfEdges.clear() ;
 
 	for(Dart d = m.begin(); d != m.end(); m.next(d))
 	{
 		initHalfEdgeInfo(d) ;	// init the edges with their optimal info
-	}							// and insert them in the multimap according to their error
+	}							// and insert them in the heap according to their error
 
 	cur = halfEdges.begin() ; 	// init the current edge to the first one
 
@@ -624,7 +624,7 @@ void HalfEdgeSelector_QEMextColorNormal<PFP>::updateBeforeCollapse(Dart d)
 	edgeE = &(halfEdgeInfo[m.phi_1(d)]) ;	// the halfedges that will disappear
 	if(edgeE->valid)
 		halfEdges.erase(edgeE->it) ;
-										// from the multimap
+										// from the heap
 	Dart dd = m.phi2(d) ;
 	assert(dd != d) ;
 	if(dd != d)
@@ -743,7 +743,7 @@ void HalfEdgeSelector_QEMextColorNormal<PFP>::updateHalfEdgeInfo(Dart d, bool re
 	if(recompute)
 	{
 		if(heinfo.valid)
-			halfEdges.erase(heinfo.it) ;			// remove the edge from the multimap
+			halfEdges.erase(heinfo.it) ;			// remove the edge from the heap
 		if(m.edgeCanCollapse(d))
 			computeHalfEdgeInfo(d, heinfo) ;
 		else
@@ -855,13 +855,13 @@ bool HalfEdgeSelector_ColorGradient<PFP>::init()
 		m_quadric[d_1] += q ;		// of the 3 incident vertices
 	}
 
-	// Init multimap for each Half-edge
+	// Init heap for each Half-edge
 	halfEdges.clear() ;
 
 	for(Dart d = m.begin(); d != m.end(); m.next(d))
 	{
 		initHalfEdgeInfo(d) ;	// init the edges with their optimal info
-	}							// and insert them in the multimap according to their error
+	}							// and insert them in the heap according to their error
 
 	cur = halfEdges.begin() ; 	// init the current edge to the first one
 
@@ -917,7 +917,7 @@ void HalfEdgeSelector_ColorGradient<PFP>::updateBeforeCollapse(Dart d)
 //	edgeE = &(halfEdgeInfo[m.phi_1(d)]) ;	// the halfedges that will disappear
 //	if(edgeE->valid)
 //		halfEdges.erase(edgeE->it) ;
-//										// from the multimap
+//										// from the heap
 //	Dart dd = m.phi2(d) ;
 //	assert(dd != d) ;
 //	if(dd != d)
@@ -27,6 +27,7 @@
 
 #include "Topology/generic/attributeHandler.h"
 #include "Algo/Import/importFileTypes.h"
+#include "Utils/compress.h"
 
 
 #include <stdint.h>
@@ -101,8 +102,22 @@ protected:
 	bool binaryMode;
 	unsigned int offsetAppend;
 
+	/// compression level of appended data (0: raw)
+	unsigned int m_compression;
+	unsigned int m_nbth;
+
+	/// lines of the vertices in the order of export
+	std::vector<unsigned int> vertexLines;
+
 	FILE* f_tempoBin_out ;
 
+	/**
+	 * write an array in the appended data (raw or compressed), gathered by pieces
+	 * @param nbBytes size of the array
+	 * @param gather function that copies a range of bytes of the array
+	 */
+	void writeAppendedArray(unsigned int nbBytes, const Utils::GatherFunction& gather);
+
 
 	template<typename T>
 	void addBinaryVertexAttribute(const VertexAttribute<T,MAP>& attrib, const std::string& vtkType, unsigned int nbComp=0, const std::string& name="");
@@ -122,9 +137,11 @@ public:
 	 * @brief start writing header of vtu file
 	 * @param filename
 	 * @param bin true if binray mode wanted
+	 * @param compression zlib compression level of binary data, 1 (fast) to 9 (best), 0 for no compression
+	 * @param nbth number of threads used to compress
 	 * @return true if ok
 	 */
-	bool init(const char* filename, bool bin=false);
+	bool init(const char* filename, bool bin=false, unsigned int compression=0, unsigned int nbth=CGoGN::Parallel::NumberOfThreads);
 
 
 
@@ -209,8 +226,22 @@ protected:
 	bool binaryMode;
 	unsigned int offsetAppend;
 
+	/// compression level of appended data (0: raw)
+	unsigned int m_compression;
+	unsigned int m_nbth;
+
+	/// lines of the vertices in the order of export
+	std::vector<unsigned int> vertexLines;
+
 	FILE* f_tempoBin_out ;
 
+	/**
+	 * write an array in the appended data (raw or compressed), gathered by pieces
+	 * @param nbBytes size of the array
+	 * @param gather function that copies a range of bytes of the array
+	 */
+	void writeAppendedArray(unsigned int nbBytes, const Utils::GatherFunction& gather);
+
 	template<typename T>
 	void addBinaryVertexAttribute(const VertexAttribute<T,MAP>& attrib, const std::string& vtkType, unsigned int nbComp=0, const std::string& name="");
 
@@ -229,9 +260,11 @@ public:
 	 * @brief start writing header of vtu file
 	 * @param filename
 	 * @param bin true if binray mode wanted
+	 * @param compression zlib compression level of binary data, 1 (fast) to 9 (best), 0 for no compression
+	 * @param nbth number of threads used to compress
 	 * @return true if ok
 	 */
-	bool init(const char* filename, bool bin=false);
+	bool init(const char* filename, bool bin=false, unsigned int compression=0, unsigned int nbth=CGoGN::Parallel::NumberOfThreads);
 
 
 
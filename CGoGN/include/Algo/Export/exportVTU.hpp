@@ -645,7 +645,7 @@ bool exportVTUCompressed(typename PFP::MAP& map, const VertexAttribute<VEC3,MAP>
 template <typename PFP>
 VTUExporter<PFP>::VTUExporter(MAP& map, const VertexAttribute<VEC3,MAP>& position):
 	m_map(map),m_position(position),
-	nbtotal(0),noPointData(true),noCellData(true),closed(false),binaryMode(false),f_tempoBin_out(NULL)
+	nbtotal(0),noPointData(true),noCellData(true),closed(false),binaryMode(false),offsetAppend(0),m_compression(0),m_nbth(1),f_tempoBin_out(NULL)
 {
 	if (map.dimension() != 2)
 	{
@@ -655,7 +655,7 @@ VTUExporter<PFP>::VTUExporter(MAP& map, const VertexAttribute<VEC3,MAP>& positio
 }
 
 template <typename PFP>
-bool VTUExporter<PFP>::init(const char* filename, bool bin)
+bool VTUExporter<PFP>::init(const char* filename, bool bin, unsigned int compression, unsigned int nbth)
 {
 	// save filename for close open ?
 	m_filename = std::string(filename);
@@ -671,10 +671,14 @@ bool VTUExporter<PFP>::init(const char* filename, bool bin)
 
 	VertexAutoAttribute<unsigned int,MAP> indices(m_map,"indices_vert");
 
+	vertexLines.clear();
+	vertexLines.reserve(m_position.nbElements());
+
 	unsigned int count=0;
 	for (unsigned int i = m_position.begin(); i != m_position.end(); m_position.next(i))
 	{
 		indices[i] = count++;
+		vertexLines.push_back(i);
 	}
 
 	triangles.reserve(4096);
@@ -722,8 +726,14 @@ bool VTUExporter<PFP>::init(const char* filename, bool bin)
 
 	nbtotal = uint32(triangles.size() / 3 + quads.size() / 4 + others_begin.size() - 1);
 
+	m_compression = bin ? std::min(compression, 9u) : 0;
+	m_nbth = std::max(nbth, 1u);
+
 	fout << "<?xml version=\"1.0\"?>" << std::endl;
-	fout << "<VTKFile type=\"UnstructuredGrid\" version=\"0.1\" byte_order=\"LittleEndian\">" << std::endl;
+	if (m_compression > 0)
+		fout << "<VTKFile type=\"UnstructuredGrid\" version=\"0.1\" byte_order=\"LittleEndian\" compressor=\"vtkZLibDataCompressor\">" << std::endl;
+	else
+		fout << "<VTKFile type=\"UnstructuredGrid\" version=\"0.1\" byte_order=\"LittleEndian\">" << std::endl;
 	fout << "<UnstructuredGrid>" <<  std::endl;
 	fout << "<Piece NumberOfPoints=\"" << m_position.nbElements() << "\" NumberOfCells=\""<< nbtotal << "\">" << std::endl;
 
@@ -1022,18 +1032,9 @@ void VTUExporter<PFP>::addBinaryVertexAttribute(const VertexAttribute<T,MAP>& at
 	else
 		fout << "<DataArray type=\""<< vtkType <<"\" Name=\""<<attrib.name()<<"\" NumberOfComponents=\""<< nbComp <<"\" Format=\"appended\" offset =\""<<offsetAppend<<"\"/>" << std::endl;
 
-	std::vector<T> buffer;
-	buffer.reserve(attrib.nbElements());
-
-	for (unsigned int i = attrib.begin(); i != attrib.end(); attrib.next(i))
-		buffer.push_back(attrib[i]);
-
-	unsigned int sz = buffer.size()*sizeof(T);
-
-	fwrite(&sz, sizeof(unsigned int), 1, f_tempoBin_out);			// size of block
-	fwrite(&buffer[0], sizeof(T), buffer.size(), f_tempoBin_out);	// block
-
-	offsetAppend += sizeof(T) * buffer.size() + sizeof(unsigned int);
+	// values are read directly in the attribute, in the order of the vertices
+	writeAppendedArray(uint32(vertexLines.size() * sizeof(T)),
+		Utils::gatherElements<T>([&] (unsigned int k) -> const T& { return attrib[vertexLines[k]]; }));
 }
 
 
@@ -1075,21 +1076,18 @@ void VTUExporter<PFP>::addBinaryFaceAttribute(const FaceAttribute<T,MAP>& attrib
 	else
 		fout << "<DataArray type=\""<< vtkType <<"\" Name=\""<<attrib.name()<<"\" NumberOfComponents=\""<< nbComp <<"\" Format=\"appended\" offset =\""<<offsetAppend<<"\"/>" << std::endl;
 
-	std::vector<T> buffer;
-	buffer.reserve(bufferTri.size() + bufferQuad.size() + bufferOther.size());
-
-	for (typename std::vector<Dart>::iterator it = bufferTri.begin(); it != bufferTri.end(); ++it)
-		buffer.push_back(attrib[*it]);
-	for (typename std::vector<Dart>::iterator it = bufferQuad.begin(); it != bufferQuad.end(); ++it)
-		buffer.push_back(attrib[*it]);
-	for (typename std::vector<Dart>::iterator it = bufferOther.begin(); it != bufferOther.end(); ++it)
-		buffer.push_back(attrib[*it]);
-
-	unsigned int sz = buffer.size()*sizeof(T);
-	fwrite(&sz, sizeof(unsigned int), 1, f_tempoBin_out);			// size of block
-	fwrite(&buffer[0], sizeof(T), buffer.size(), f_tempoBin_out);	// block
-
-	offsetAppend += sizeof(T) * buffer.size() + sizeof(unsigned int);
+	// faces in order: triangles, quads, others
+	const unsigned int nbTri = uint32(bufferTri.size());
+	const unsigned int nbQuad = uint32(bufferQuad.size());
+	writeAppendedArray(uint32((nbTri + nbQuad + bufferOther.size()) * sizeof(T)),
+		Utils::gatherElements<T>([&] (unsigned int k) -> const T&
+		{
+			if (k < nbTri)
+				return attrib[bufferTri[k]];
+			if (k < nbTri + nbQuad)
+				return attrib[bufferQuad[k - nbTri]];
+			return attrib[bufferOther[k - nbTri - nbQuad]];
+		}));
 }
 
 
@@ -1102,112 +1100,50 @@ bool VTUExporter<PFP>::binaryClose()
 	if (!noCellData)
 		endFaceAttributes();
 
-	{ // just for scope of std::vector (free memory)
-		fout << "<Points>" << std::endl;
-		fout << "<DataArray type =\"Float32\" Name =\"Position\" NumberOfComponents =\"3\" Format=\"appended\" offset =\""<<offsetAppend<<"\"/>"  << std::endl;
-
-		std::vector<VEC3> buffer;
-		buffer.reserve(m_position.nbElements());
-
-		for (unsigned int i = m_position.begin(); i != m_position.end(); m_position.next(i))
-			buffer.push_back(m_position[i]);
-
-		unsigned int sz = uint32(buffer.size()*sizeof(VEC3));
-
-		offsetAppend += sz + sizeof(unsigned int);
-
-		fwrite(&sz, sizeof(unsigned int), 1, f_tempoBin_out);			// size of block
-		fwrite(&buffer[0], sizeof(VEC3), buffer.size(), f_tempoBin_out);	// block
-
-		fout << "</Points>" << std::endl;
-	}
-
-	{ // just for scope of std::vector (free memory)
-
-		fout << "<Cells>" << std::endl;
-		fout << "<DataArray type =\"Int32\" Name =\"connectivity\" format =\"appended\" offset =\""<<offsetAppend<<"\"/>"  << std::endl;
-
-		std::vector<int> bufferInt;
-		bufferInt.reserve(triangles.size()+quads.size()+others.size());
-
-		for (unsigned int i=0; i<triangles.size(); i+=3)
-		{
-			bufferInt.push_back(triangles[i]);
-			bufferInt.push_back(triangles[i+1]);
-			bufferInt.push_back(triangles[i+2]);
-		}
-
-		for (unsigned int i=0; i<quads.size(); i+=4)
-		{
-			bufferInt.push_back(quads[i]);
-			bufferInt.push_back(quads[i+1]);
-			bufferInt.push_back(quads[i+2]);
-			bufferInt.push_back(quads[i+3]);
-		}
-
-		for (unsigned int i=1; i<others_begin.size(); ++i)
-		{
-			unsigned int beg = others_begin[i-1];
-			unsigned int end = others_begin[i];
-			for (unsigned int j=beg; j<end; ++j)
-				bufferInt.push_back(others[j]);
-		}
-
-		unsigned int sz = uint32(bufferInt.size() * sizeof(unsigned int));
-		offsetAppend += sz + sizeof(unsigned int);
-		fwrite(&sz, sizeof(unsigned int), 1, f_tempoBin_out);			// size of block
-		fwrite(&bufferInt[0], sizeof(unsigned int), bufferInt.size(), f_tempoBin_out);	// block
+	fout << "<Points>" << std::endl;
+	fout << "<DataArray type =\"Float32\" Name =\"Position\" NumberOfComponents =\"3\" Format=\"appended\" offset =\""<<offsetAppend<<"\"/>"  << std::endl;
+	writeAppendedArray(uint32(vertexLines.size() * sizeof(VEC3)),
+		Utils::gatherElements<VEC3>([&] (unsigned int k) -> const VEC3& { return m_position[vertexLines[k]]; }));
+	fout << "</Points>" << std::endl;
 
-		fout << "<DataArray type =\"Int32\" Name =\"offsets\" format =\"appended\" offset =\""<<offsetAppend<<"\"/>"  << std::endl;
+	// cells in order: triangles, quads, others
+	const unsigned int nbTri = uint32(triangles.size() / 3);
+	const unsigned int nbQuad = uint32(quads.size() / 4);
+	const unsigned int nbCells = nbTri + nbQuad + uint32(others_begin.size() - 1);
 
-		bufferInt.clear();
-		unsigned int offset = 0;
-		for (unsigned int i=0; i<triangles.size(); i+=3)
-		{
-			offset += 3;
-			bufferInt.push_back(offset);
-		}
-
-		for (unsigned int i=0; i<quads.size(); i+=4)
+	fout << "<Cells>" << std::endl;
+	fout << "<DataArray type =\"Int32\" Name =\"connectivity\" format =\"appended\" offset =\""<<offsetAppend<<"\"/>"  << std::endl;
+	writeAppendedArray(uint32((triangles.size() + quads.size() + others.size()) * sizeof(unsigned int)),
+		Utils::gatherElements<unsigned int>([&] (unsigned int k) -> unsigned int
 		{
-			offset += 4;
-			bufferInt.push_back(offset);
-		}
+			if (k < 3 * nbTri)
+				return triangles[k];
+			if (k < 3 * nbTri + 4 * nbQuad)
+				return quads[k - 3 * nbTri];
+			return others[k - 3 * nbTri - 4 * nbQuad];
+		}));
 
-		for (unsigned int i=1; i<others_begin.size(); ++i)
+	fout << "<DataArray type =\"Int32\" Name =\"offsets\" format =\"appended\" offset =\""<<offsetAppend<<"\"/>"  << std::endl;
+	writeAppendedArray(uint32(nbCells * sizeof(unsigned int)),
+		Utils::gatherElements<unsigned int>([&] (unsigned int k) -> unsigned int
 		{
-			unsigned int length = others_begin[i] - others_begin[i-1];
-			offset += length;
-			bufferInt.push_back(offset);
-		}
-
-		sz = uint32(bufferInt.size() * sizeof(unsigned int));
-
-		offsetAppend += sz + sizeof(unsigned int);
-		fwrite(&sz, sizeof(unsigned int), 1, f_tempoBin_out);			// size of block
-		fwrite(&bufferInt[0], sizeof(unsigned int), bufferInt.size(), f_tempoBin_out);	// block
-
-	}
+			if (k < nbTri)
+				return 3 * (k + 1);
+			if (k < nbTri + nbQuad)
+				return 3 * nbTri + 4 * (k - nbTri + 1);
+			return 3 * nbTri + 4 * nbQuad + others_begin[k - nbTri - nbQuad + 1];
+		}));
 
 	fout << "<DataArray type =\"UInt8\" Name =\"types\" format =\"appended\" offset =\""<<offsetAppend<<"\"/>"  << std::endl;
-	std::vector<unsigned char> bufferUC;
-	bufferUC.reserve(triangles.size()/3 + quads.size()/4 + others_begin.size());
-
-	for (unsigned int i=0; i<triangles.size(); i+=3)
-		bufferUC.push_back((unsigned char)5);
-
-	for (unsigned int i=0; i<quads.size(); i+=4)
-		bufferUC.push_back((unsigned char)9);
-
-	for (unsigned int i=1; i<others_begin.size(); ++i)
-		bufferUC.push_back((unsigned char)7);
-
-	unsigned int sz = uint32(bufferUC.size() * sizeof(unsigned char));
-
-	offsetAppend += sz + uint32(sizeof(unsigned int));
-
-	fwrite(&sz, sizeof(unsigned int), 1, f_tempoBin_out);			// size of block
-	fwrite(&bufferUC[0], sizeof(unsigned char), bufferUC.size(), f_tempoBin_out);	// block
+	writeAppendedArray(nbCells,
+		Utils::gatherElements<unsigned char>([&] (unsigned int k) -> unsigned char
+		{
+			if (k < nbTri)
+				return 5;
+			if (k < nbTri + nbQuad)
+				return 9;
+			return 7;
+		}));
 
 	fout << "</Cells>" << std::endl;
 	fout << "</Piece>" << std::endl;
@@ -1251,6 +1187,32 @@ bool VTUExporter<PFP>::binaryClose()
 
 
 
+template <typename PFP>
+void VTUExporter<PFP>::writeAppendedArray(unsigned int nbBytes, const Utils::GatherFunction& gather)
+{
+	if (m_compression > 0)
+	{
+		Utils::ThreadPool* pool = (m_nbth > 1) ? &CGoGN::Parallel::getThreadPool(m_nbth - 1) : NULL;
+		offsetAppend += Utils::zlibVTUWriteCompressed(nbBytes, gather, f_tempoBin_out, m_compression, pool, m_nbth - 1);
+		return;
+	}
+
+	fwrite(&nbBytes, sizeof(unsigned int), 1, f_tempoBin_out);	// size of block
+
+	// block, gathered by pieces of 1MB
+	std::vector<unsigned char> buffer(std::min(nbBytes, 1024u*1024u));
+	for (unsigned int offset = 0; offset < nbBytes; offset += uint32(buffer.size()))
+	{
+		unsigned int nb = std::min(nbBytes - offset, uint32(buffer.size()));
+		gather(offset, nb, &buffer[0]);
+		fwrite(&buffer[0], 1, nb, f_tempoBin_out);
+	}
+
+	offsetAppend += nbBytes + sizeof(unsigned int);
+}
+
+
+
 template <typename PFP>
 VTUExporter<PFP>::~VTUExporter()
 {
@@ -1274,7 +1236,7 @@ namespace Export
 template <typename PFP>
 VTUExporter<PFP>::VTUExporter(MAP& map, const VertexAttribute<VEC3,MAP>& position):
 	m_map(map),m_position(position),
-	nbtotal(0),noPointData(true),noCellData(true),closed(false),binaryMode(false),f_tempoBin_out(NULL)
+	nbtotal(0),noPointData(true),noCellData(true),closed(false),binaryMode(false),offsetAppend(0),m_compression(0),m_nbth(1),f_tempoBin_out(NULL)
 {
 	if (map.dimension() != 3)
 	{
@@ -1284,7 +1246,7 @@ VTUExporter<PFP>::VTUExporter(MAP& map, const VertexAttribute<VEC3,MAP>& positio
 }
 
 template <typename PFP>
-bool VTUExporter<PFP>::init(const char* filename, bool bin)
+bool VTUExporter<PFP>::init(const char* filename, bool bin, unsigned int compression, unsigned int nbth)
 {
 	// save filename for close open ?
 	m_filename = std::string(filename);
@@ -1300,10 +1262,14 @@ bool VTUExporter<PFP>::init(const char* filename, bool bin)
 
 	VertexAutoAttribute<unsigned int,MAP> indices(m_map,"indices_vert");
 
+	vertexLines.clear();
+	vertexLines.reserve(m_position.nbElements());
+
 	unsigned int count=0;
 	for (unsigned int i = m_position.begin(); i != m_position.end(); m_position.next(i))
 	{
 		indices[i] = count++;
+		vertexLines.push_back(i);
 	}
 
 	tetras.reserve(4096);
@@ -1361,8 +1327,14 @@ bool VTUExporter<PFP>::init(const char* filename, bool bin)
 
 	nbtotal = uint32(tetras.size() / 4 + hexas.size() / 8);
 
+	m_compression = bin ? std::min(compression, 9u) : 0;
+	m_nbth = std::max(nbth, 1u);
+
 	fout << "<?xml version=\"1.0\"?>" << std::endl;
-	fout << "<VTKFile type=\"UnstructuredGrid\" version=\"0.1\" byte_order=\"LittleEndian\">" << std::endl;
+	if (m_compression > 0)
+		fout << "<VTKFile type=\"UnstructuredGrid\" version=\"0.1\" byte_order=\"LittleEndian\" compressor=\"vtkZLibDataCompressor\">" << std::endl;
+	else
+		fout << "<VTKFile type=\"UnstructuredGrid\" version=\"0.1\" byte_order=\"LittleEndian\">" << std::endl;
 	fout << "<UnstructuredGrid>" <<  std::endl;
 	fout << "<Piece NumberOfPoints=\"" << m_position.nbElements() << "\" NumberOfCells=\""<< nbtotal << "\">" << std::endl;
 
@@ -1532,14 +1504,14 @@ bool VTUExporter<PFP>::close()
 	fout << "<Cells>" << std::endl;
 	fout << "<DataArray type=\"Int32\" Name=\"connectivity\" Format=\"ascii\">" << std::endl;
 
-	for (unsigned int i=0; i<tetras.size(); i+=3)
+	for (unsigned int i=0; i<tetras.size(); i+=4)
 	{
 		fout << tetras[i]   << " " << tetras[i+1] << " " << tetras[i+2] << " " << tetras[i+3] << std::endl;
 	}
 
-	for (unsigned int i=0; i<hexas.size(); i+=4)
+	for (unsigned int i=0; i<hexas.size(); i+=8)
 	{
-		fout << hexas[i]   << " " << hexas[i+1] << " " << hexas[i+2] << " " << hexas[i+3];
+		fout << hexas[i]   << " " << hexas[i+1] << " " << hexas[i+2] << " " << hexas[i+3] << " ";
 		fout << hexas[i+4] << " " << hexas[i+5] << " " << hexas[i+6] << " " << hexas[i+7]<< std::endl;
 	}
 
@@ -1547,15 +1519,15 @@ bool VTUExporter<PFP>::close()
 	fout << "<DataArray type=\"Int32\" Name=\"offsets\" Format=\"ascii\">" ;
 
 	unsigned int offset = 0;
-	for (unsigned int i=0; i<tetras.size(); i+=3)
+	for (unsigned int i=0; i<tetras.size(); i+=4)
 	{
 		offset += 4;
-		if (i%60 ==0)
+		if (i%80 ==0)
 			fout << std::endl;
 		fout << " " << offset;
 	}
 
-	for (unsigned int i=0; i<hexas.size(); i+=4)
+	for (unsigned int i=0; i<hexas.size(); i+=8)
 	{
 		offset += 8;
 		if (i%80 ==0)
@@ -1566,13 +1538,13 @@ bool VTUExporter<PFP>::close()
 
 	fout << std::endl << "</DataArray>" << std::endl;
 	fout << "<DataArray type=\"UInt8\" Name=\"types\" Format=\"ascii\">";
-	for (unsigned int i=0; i<tetras.size(); i+=3)
+	for (unsigned int i=0; i<tetras.size(); i+=4)
 	{
-		if (i%60 ==0)
+		if (i%80 ==0)
 			fout << std::endl;
 		fout << " 10";
 	}
-	for (unsigned int i=0; i<hexas.size(); i+=4)
+	for (unsigned int i=0; i<hexas.size(); i+=8)
 	{
 		if (i%80 ==0)
 			fout << std::endl;
@@ -1633,18 +1605,9 @@ void VTUExporter<PFP>::addBinaryVertexAttribute(const VertexAttribute<T,MAP>& at
 	else
 		fout << "<DataArray type=\""<< vtkType <<"\" Name=\""<<attrib.name()<<"\" NumberOfComponents=\""<< nbComp <<"\" Format=\"appended\" offset =\""<<offsetAppend<<"\"/>" << std::endl;
 
-	std::vector<T> buffer;
-	buffer.reserve(attrib.nbElements());
-
-	for (unsigned int i = attrib.begin(); i != attrib.end(); attrib.next(i))
-		buffer.push_back(attrib[i]);
-
-	unsigned int sz = buffer.size()*sizeof(T);
-
-	fwrite(&sz, sizeof(unsigned int), 1, f_tempoBin_out);			// size of block
-	fwrite(&buffer[0], sizeof(T), buffer.size(), f_tempoBin_out);	// block
-
-	offsetAppend += sizeof(T) * buffer.size() + sizeof(unsigned int);
+	// values are read directly in the attribute, in the order of the vertices
+	writeAppendedArray(uint32(vertexLines.size() * sizeof(T)),
+		Utils::gatherElements<T>([&] (unsigned int k) -> const T& { return attrib[vertexLines[k]]; }));
 }
 
 
@@ -1686,20 +1649,15 @@ void VTUExporter<PFP>::addBinaryVolumeAttribute(const VolumeAttribute<T,MAP>& at
 	else
 		fout << "<DataArray type=\""<< vtkType <<"\" Name=\""<<attrib.name()<<"\" NumberOfComponents=\""<< nbComp <<"\" Format=\"appended\" offset =\""<<offsetAppend<<"\"/>" << std::endl;
 
-	std::vector<T> buffer;
-	buffer.reserve(bufferTetra.size() + bufferHexa.size());
-
-	for (typename std::vector<Dart>::iterator it = bufferTetra.begin(); it != bufferTetra.end(); ++it)
-		buffer.push_back(attrib[*it]);
-	for (typename std::vector<Dart>::iterator it = bufferHexa.begin(); it != bufferHexa.end(); ++it)
-		buffer.push_back(attrib[*it]);
-
-
-	unsigned int sz = buffer.size()*sizeof(T);
-	fwrite(&sz, sizeof(unsigned int), 1, f_tempoBin_out);			// size of block
-	fwrite(&buffer[0], sizeof(T), buffer.size(), f_tempoBin_out);	// block
-
-	offsetAppend += sizeof(T) * buffer.size() + sizeof(unsigned int);
+	// volumes in order: tetras, hexas
+	const unsigned int nbTetra = uint32(bufferTetra.size());
+	writeAppendedArray(uint32((nbTetra + bufferHexa.size()) * sizeof(T)),
+		Utils::gatherElements<T>([&] (unsigned int k) -> const T&
+		{
+			if (k < nbTetra)
+				return attrib[bufferTetra[k]];
+			return attrib[bufferHexa[k - nbTetra]];
+		}));
 }
 
 
@@ -1712,96 +1670,41 @@ bool VTUExporter<PFP>::binaryClose()
 	if (!noCellData)
 		endVolumeAttributes();
 
-	{ // just for scope of std::vector (free memory)
-		fout << "<Points>" << std::endl;
-		fout << "<DataArray type =\"Float32\" Name =\"Position\" NumberOfComponents =\"3\" Format=\"appended\" offset =\""<<offsetAppend<<"\"/>"  << std::endl;
-
-		std::vector<VEC3> buffer;
-		buffer.reserve(m_position.nbElements());
-
-		for (unsigned int i = m_position.begin(); i != m_position.end(); m_position.next(i))
-			buffer.push_back(m_position[i]);
-
-		unsigned int sz = uint32(buffer.size()*sizeof(VEC3));
-
-		offsetAppend += sz + sizeof(unsigned int);
-
-		fwrite(&sz, sizeof(unsigned int), 1, f_tempoBin_out);			// size of block
-		fwrite(&buffer[0], sizeof(VEC3), buffer.size(), f_tempoBin_out);	// block
-
-		fout << "</Points>" << std::endl;
-	}
-
-	{ // just for scope of std::vector (free memory)
-
-		fout << "<Cells>" << std::endl;
-		fout << "<DataArray type =\"Int32\" Name =\"connectivity\" format =\"appended\" offset =\""<<offsetAppend<<"\"/>"  << std::endl;
-
-		std::vector<int> bufferInt;
-		bufferInt.reserve(tetras.size()+hexas.size());
-
-		for (unsigned int i=0; i<tetras.size(); i+=3)
-		{
-			bufferInt.push_back(tetras[i]);
-			bufferInt.push_back(tetras[i+1]);
-			bufferInt.push_back(tetras[i+2]);
-			bufferInt.push_back(tetras[i+3]);
-		}
-
-		for (unsigned int i=0; i<hexas.size(); i+=4)
-		{
-			bufferInt.push_back(hexas[i]);
-			bufferInt.push_back(hexas[i+1]);
-			bufferInt.push_back(hexas[i+2]);
-			bufferInt.push_back(hexas[i+3]);
-		}
-
-		unsigned int sz = uint32(bufferInt.size() * sizeof(unsigned int));
-		offsetAppend += sz + sizeof(unsigned int);
-		fwrite(&sz, sizeof(unsigned int), 1, f_tempoBin_out);			// size of block
-		fwrite(&bufferInt[0], sizeof(unsigned int), bufferInt.size(), f_tempoBin_out);	// block
+	fout << "<Points>" << std::endl;
+	fout << "<DataArray type =\"Float32\" Name =\"Position\" NumberOfComponents =\"3\" Format=\"appended\" offset =\""<<offsetAppend<<"\"/>"  << std::endl;
+	writeAppendedArray(uint32(vertexLines.size() * sizeof(VEC3)),
+		Utils::gatherElements<VEC3>([&] (unsigned int k) -> const VEC3& { return m_position[vertexLines[k]]; }));
+	fout << "</Points>" << std::endl;
 
-		fout << "<DataArray type =\"Int32\" Name =\"offsets\" format =\"appended\" offset =\""<<offsetAppend<<"\"/>"  << std::endl;
+	// cells in order: tetras, hexas
+	const unsigned int nbTetra = uint32(tetras.size() / 4);
+	const unsigned int nbCells = nbTetra + uint32(hexas.size() / 8);
 
-		bufferInt.clear();
-		unsigned int offset = 0;
-		for (unsigned int i=0; i<tetras.size(); i+=3)
+	fout << "<Cells>" << std::endl;
+	fout << "<DataArray type =\"Int32\" Name =\"connectivity\" format =\"appended\" offset =\""<<offsetAppend<<"\"/>"  << std::endl;
+	writeAppendedArray(uint32((tetras.size() + hexas.size()) * sizeof(unsigned int)),
+		Utils::gatherElements<unsigned int>([&] (unsigned int k) -> unsigned int
 		{
-			offset += 4;
-			bufferInt.push_back(offset);
-		}
+			if (k < 4 * nbTetra)
+				return tetras[k];
+			return hexas[k - 4 * nbTetra];
+		}));
 
-		for (unsigned int i=0; i<hexas.size(); i+=4)
+	fout << "<DataArray type =\"Int32\" Name =\"offsets\" format =\"appended\" offset =\""<<offsetAppend<<"\"/>"  << std::endl;
+	writeAppendedArray(uint32(nbCells * sizeof(unsigned int)),
+		Utils::gatherElements<unsigned int>([&] (unsigned int k) -> unsigned int
 		{
-			offset += 8;
-			bufferInt.push_back(offset);
-		}
-
-		sz = uint32(bufferInt.size() * sizeof(unsigned int));
-
-		offsetAppend += sz + sizeof(unsigned int);
-		fwrite(&sz, sizeof(unsigned int), 1, f_tempoBin_out);			// size of block
-		fwrite(&bufferInt[0], sizeof(unsigned int), bufferInt.size(), f_tempoBin_out);	// block
-
-	}
+			if (k < nbTetra)
+				return 4 * (k + 1);
+			return 4 * nbTetra + 8 * (k - nbTetra + 1);
+		}));
 
 	fout << "<DataArray type =\"UInt8\" Name =\"types\" format =\"appended\" offset =\""<<offsetAppend<<"\"/>"  << std::endl;
-	std::vector<unsigned char> bufferUC;
-	bufferUC.reserve(tetras.size()/3 + hexas.size()/4);
-
-	for (unsigned int i=0; i<tetras.size(); i+=4)
-		bufferUC.push_back((unsigned char)10);
-
-	for (unsigned int i=0; i<hexas.size(); i+=8)
-		bufferUC.push_back((unsigned char)12);
-
-
-	unsigned int sz = uint32(bufferUC.size() * sizeof(unsigned char));
-
-	offsetAppend += sz + sizeof(unsigned int);
-
-	fwrite(&sz, sizeof(unsigned int), 1, f_tempoBin_out);			// size of block
-	fwrite(&bufferUC[0], sizeof(unsigned char), bufferUC.size(), f_tempoBin_out);	// block
+	writeAppendedArray(nbCells,
+		Utils::gatherElements<unsigned char>([&] (unsigned int k) -> unsigned char
+		{
+			return (k < nbTetra) ? 10 : 12;
+		}));
 
 	fout << "</Cells>" << std::endl;
 	fout << "</Piece>" << std::endl;
@@ -1845,6 +1748,32 @@ bool VTUExporter<PFP>::binaryClose()
 
 
 
+template <typename PFP>
+void VTUExporter<PFP>::writeAppendedArray(unsigned int nbBytes, const Utils::GatherFunction& gather)
+{
+	if (m_compression > 0)
+	{
+		Utils::ThreadPool* pool = (m_nbth > 1) ? &CGoGN::Parallel::getThreadPool(m_nbth - 1) : NULL;
+		offsetAppend += Utils::zlibVTUWriteCompressed(nbBytes, gather, f_tempoBin_out, m_compression, pool, m_nbth - 1);
+		return;
+	}
+
+	fwrite(&nbBytes, sizeof(unsigned int), 1, f_tempoBin_out);	// size of block
+
+	// block, gathered by pieces of 1MB
+	std::vector<unsigned char> buffer(std::min(nbBytes, 1024u*1024u));
+	for (unsigned int offset = 0; offset < nbBytes; offset += uint32(buffer.size()))
+	{
+		unsigned int nb = std::min(nbBytes - offset, uint32(buffer.size()));
+		gather(offset, nb, &buffer[0]);
+		fwrite(&buffer[0], 1, nb, f_tempoBin_out);
+	}
+
+	offsetAppend += nbBytes + sizeof(unsigned int);
+}
+
+
+
 template <typename PFP>
 VTUExporter<PFP>::~VTUExporter()
 {
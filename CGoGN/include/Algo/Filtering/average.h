@@ -180,6 +180,123 @@ void filterAverageFaceAttribute_WithinSphere(
 	}
 }
 
+namespace Parallel
+{
+
+/*
+ * parallel versions of the within sphere filters: the neighborhoods are collected with a
+ * kd-tree of the positions (Collector_WithinSphere_KdTree), one collector by thread
+ */
+
+template <typename PFP, typename T>
+void filterAverageVertexAttribute_WithinSphere(
+	typename PFP::MAP& map,
+	const VertexAttribute<T, typename PFP::MAP>& attIn,
+	VertexAttribute<T, typename PFP::MAP>& attOut,
+	int neigh,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	typename PFP::REAL radius,
+	unsigned int nbth = CGoGN::Parallel::NumberOfThreads)
+{
+	nbth = CGoGN::Parallel::checkNbThreads(nbth);
+	Algo::Geometry::KdTree<typename PFP::VEC3> kdTree;
+	kdTree.build(position, nbth);
+
+	std::vector< FunctorAverage<VertexAttribute<T, typename PFP::MAP> > > faInside(nbth, FunctorAverage<VertexAttribute<T, typename PFP::MAP> >(attIn));
+	std::vector< FunctorAverageOnSphereBorder<PFP, T> > faBorder(nbth, FunctorAverageOnSphereBorder<PFP, T>(map, attIn, position));
+	std::vector< Algo::Surface::Selection::Collector_WithinSphere_KdTree<PFP> > cols(nbth, Algo::Surface::Selection::Collector_WithinSphere_KdTree<PFP>(map, position, kdTree, radius));
+
+	CGoGN::Parallel::foreach_cell<VERTEX>(map, [&] (Vertex v, unsigned int thr)
+	{
+		if(!map.isBoundaryVertex(v))
+		{
+			if (neigh & INSIDE)
+				cols[thr].collectAll(v) ;
+			else
+				cols[thr].collectBorder(v) ;
+
+			T sum(0);
+			faInside[thr].reset() ;
+			faBorder[thr].reset(position[v], radius);
+			if (neigh & INSIDE){
+				cols[thr].applyOnInsideVertices(faInside[thr]) ;
+				sum += faInside[thr].getSum();
+			}
+			if (neigh & BORDER){
+				cols[thr].applyOnBorder(faBorder[thr]) ;
+				sum += faBorder[thr].getSum();
+			}
+			attOut[v] = sum / (faInside[thr].getCount() + faBorder[thr].getCount()) ;
+		}
+		else
+			attOut[v] = attIn[v] ;
+	}, AUTO, nbth);
+}
+
+template <typename PFP, typename T>
+void filterAverageEdgeAttribute_WithinSphere(
+	typename PFP::MAP& map,
+	const EdgeAttribute<T, typename PFP::MAP>& attIn,
+	EdgeAttribute<T, typename PFP::MAP>& attOut,
+	int neigh,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	typename PFP::REAL radius,
+	unsigned int nbth = CGoGN::Parallel::NumberOfThreads)
+{
+	nbth = CGoGN::Parallel::checkNbThreads(nbth);
+	Algo::Geometry::KdTree<typename PFP::VEC3> kdTree;
+	kdTree.build(position, nbth);
+
+	std::vector< FunctorAverage<EdgeAttribute<T, typename PFP::MAP> > > fa(nbth, FunctorAverage<EdgeAttribute<T, typename PFP::MAP> >(attIn));
+	std::vector< Algo::Surface::Selection::Collector_WithinSphere_KdTree<PFP> > cols(nbth, Algo::Surface::Selection::Collector_WithinSphere_KdTree<PFP>(map, position, kdTree, radius));
+
+	CGoGN::Parallel::foreach_cell<EDGE>(map, [&] (Edge e, unsigned int thr)
+	{
+		if (neigh & INSIDE)
+			cols[thr].collectAll(e) ;
+		else
+			cols[thr].collectBorder(e) ;
+
+		fa[thr].reset() ;
+		if (neigh & INSIDE) cols[thr].applyOnInsideEdges(fa[thr]) ;
+		if (neigh & BORDER) cols[thr].applyOnBorder(fa[thr]) ;
+		attOut[e] = fa[thr].getAverage() ;
+	}, AUTO, nbth);
+}
+
+template <typename PFP, typename T>
+void filterAverageFaceAttribute_WithinSphere(
+	typename PFP::MAP& map,
+	const FaceAttribute<T, typename PFP::MAP>& attIn,
+	FaceAttribute<T, typename PFP::MAP>& attOut,
+	int neigh,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	typename PFP::REAL radius,
+	unsigned int nbth = CGoGN::Parallel::NumberOfThreads)
+{
+	nbth = CGoGN::Parallel::checkNbThreads(nbth);
+	Algo::Geometry::KdTree<typename PFP::VEC3> kdTree;
+	kdTree.build(position, nbth);
+
+	std::vector< FunctorAverage<FaceAttribute<T, typename PFP::MAP> > > fa(nbth, FunctorAverage<FaceAttribute<T, typename PFP::MAP> >(attIn));
+	std::vector< Algo::Surface::Selection::Collector_WithinSphere_KdTree<PFP> > cols(nbth, Algo::Surface::Selection::Collector_WithinSphere_KdTree<PFP>(map, position, kdTree, radius));
+
+	CGoGN::Parallel::foreach_cell<FACE>(map, [&] (Face f, unsigned int thr)
+	{
+		if (neigh & INSIDE)
+			cols[thr].collectAll(f) ;
+		else
+			cols[thr].collectBorder(f) ;
+
+		fa[thr].reset() ;
+		if (neigh & INSIDE) cols[thr].applyOnInsideFaces(fa[thr]) ;
+		if (neigh & BORDER) cols[thr].applyOnBorder(fa[thr]) ;
+		attOut[f] = fa[thr].getAverage() ;
+	}, AUTO, nbth);
+}
+
+} // namespace Parallel
+
 } // namespace Filtering
 
 } // namespace Surface
@@ -160,6 +160,56 @@ void filterTaubin_modified(typename PFP::MAP& map, VertexAttribute<typename PFP:
 	}
 }
 
+namespace Parallel
+{
+
+/**
+ * parallel version of filterTaubin_modified: the neighborhoods are collected with
+ * a kd-tree of the positions of each step (Collector_WithinSphere_KdTree)
+ */
+template <typename PFP>
+void filterTaubin_modified(typename PFP::MAP& map, VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position2, typename PFP::REAL radius, unsigned int nbth = CGoGN::Parallel::NumberOfThreads)
+{
+	typedef typename PFP::VEC3 VEC3 ;
+	typedef typename PFP::REAL REAL;
+
+	const REAL lambda = 0.6307f ;
+	const REAL mu = -0.6732f ;
+
+	nbth = CGoGN::Parallel::checkNbThreads(nbth);
+
+	auto step = [&] (VertexAttribute<VEC3, typename PFP::MAP>& pIn, VertexAttribute<VEC3, typename PFP::MAP>& pOut, REAL factor)
+	{
+		Algo::Geometry::KdTree<VEC3> kdTree;
+		kdTree.build(pIn, nbth);
+
+		std::vector< FunctorAverageOnSphereBorder<PFP, VEC3> > fa(nbth, FunctorAverageOnSphereBorder<PFP, VEC3>(map, pIn, pIn));
+		std::vector< Algo::Surface::Selection::Collector_WithinSphere_KdTree<PFP> > cols(nbth, Algo::Surface::Selection::Collector_WithinSphere_KdTree<PFP>(map, pIn, kdTree, radius));
+
+		CGoGN::Parallel::foreach_cell<VERTEX>(map, [&] (Vertex v, unsigned int thr)
+		{
+			if(!map.isBoundaryVertex(v))
+			{
+				cols[thr].collectBorder(v) ;
+				VEC3 center = pIn[v] ;
+				fa[thr].reset(center, radius) ;
+				cols[thr].applyOnBorder(fa[thr]) ;
+				VEC3 displ = fa[thr].getAverage() - center ;
+				displ *= factor ;
+				pOut[v] = center + displ ;
+			}
+			else
+				pOut[v] = pIn[v] ;
+		}, AUTO, nbth);
+	};
+
+	step(position, position2, lambda);
+	// unshrinking step
+	step(position2, position, mu);
+}
+
+} // namespace Parallel
+
 } // namespace Filtering
 
 } // namespace Surface
@@ -26,6 +26,7 @@
 #include "Algo/Geometry/centroid.h"
 
 #include "Topology/generic/autoAttributeHandler.h"
+#include "Topology/generic/reduction.h"
 
 namespace CGoGN
 {
@@ -248,19 +249,11 @@ namespace Parallel
 template <typename PFP>
 typename PFP::REAL totalArea(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position)
 {
-	std::vector<typename PFP::REAL> areas;
-	areas.resize(CGoGN::Parallel::NumberOfThreads);
+	typedef typename PFP::REAL REAL;
 
-	CGoGN::Parallel::foreach_cell<FACE>(map, [&] (Face f, unsigned int thr)
-	{
-		areas[thr-1] += convexFaceArea<PFP>(map, f, position);
-	}
-	,AUTO);
-
-	typename PFP::REAL area(0);
-	for (typename PFP::REAL a : areas)
-		area += a;
-	return area;
+	return CGoGN::Parallel::reduce_cell<FACE>(map, REAL(0),
+		[&] (REAL& area, Face f) { area += convexFaceArea<PFP>(map, f, position); },
+		[] (REAL& a, const REAL& b) { a += b; });
 }
 
 template <typename PFP>
@@ -28,6 +28,7 @@
 #include "Geometry/bounding_box.h"
 #include "Topology/generic/attributeHandler.h"
 #include "Topology/generic/traversor/traversorCell.h"
+#include "Topology/generic/reduction.h"
 
 namespace CGoGN
 {
@@ -38,6 +39,29 @@ namespace Algo
 namespace Geometry
 {
 
+namespace Parallel
+{
+
+template <typename PFP>
+Geom::BoundingBox<typename PFP::VEC3> computeBoundingBox(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position)
+{
+	typedef Geom::BoundingBox<typename PFP::VEC3> BB;
+
+	return CGoGN::Parallel::reduce_cell<VERTEX>(map, BB(),
+		[&] (BB& bb, Vertex v) { bb.addPoint(position[v]) ; },
+		[] (BB& a, const BB& b)
+		{
+			if (!b.isInitialized())
+				return;
+			if (a.isInitialized())
+				a.fusion(b) ;
+			else
+				a = b ;
+		});
+}
+
+} // namespace Parallel
+
 template <typename PFP>
 Geom::BoundingBox<typename PFP::VEC3> computeBoundingBox(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position)
 {
@@ -142,6 +142,25 @@ void computeCurvatureVertex_NormalCycles(
 	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Knormal
 );
 
+/**
+ * same as above with the neighborhood given by a collector (e.g. a Collector_WithinSphere_KdTree)
+ */
+template <typename PFP>
+void computeCurvatureVertex_NormalCycles(
+	typename PFP::MAP& map,
+	Vertex v,
+	Algo::Surface::Selection::Collector<PFP>& neigh,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal,
+	const EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edgeangle,
+	const EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edgearea,
+	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmax,
+	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmin,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmax,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmin,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Knormal
+);
+
 template <typename PFP>
 void computeCurvatureVertices_NormalCycles_Projected(
 	typename PFP::MAP& map,
@@ -173,6 +192,25 @@ void computeCurvatureVertex_NormalCycles_Projected(
 	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Knormal
 );
 
+/**
+ * same as above with the neighborhood given by a collector (e.g. a Collector_WithinSphere_KdTree)
+ */
+template <typename PFP>
+void computeCurvatureVertex_NormalCycles_Projected(
+	typename PFP::MAP& map,
+	Vertex v,
+	Algo::Surface::Selection::Collector<PFP>& neigh,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal,
+	const EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edgeangle,
+	const EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edgearea,
+	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmax,
+	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmin,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmax,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmin,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Knormal
+);
+
 
 
 template <typename PFP>
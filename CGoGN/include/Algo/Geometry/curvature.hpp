@@ -338,6 +338,25 @@ void computeCurvatureVertex_NormalCycles(
 	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmax,
 	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmin,
 	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Knormal)
+{
+	Selection::Collector_WithinSphere<PFP> neigh(map, position, radius) ;
+	computeCurvatureVertex_NormalCycles<PFP>(map, v, neigh, position, normal, edgeangle, edgearea, kmax, kmin, Kmax, Kmin, Knormal) ;
+}
+
+template <typename PFP>
+void computeCurvatureVertex_NormalCycles(
+	typename PFP::MAP& /*map*/,
+	Vertex v,
+	Algo::Surface::Selection::Collector<PFP>& neigh,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal,
+	const EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edgeangle,
+	const EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edgearea,
+	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmax,
+	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmin,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmax,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmin,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Knormal)
 {
 	typedef typename PFP::REAL REAL ;
 	typedef typename PFP::VEC3 VEC3 ;
@@ -346,7 +365,6 @@ void computeCurvatureVertex_NormalCycles(
 	typedef Eigen::Matrix<REAL,3,3,Eigen::RowMajor> E_MATRIX;
 
 	// collect the normal cycle tensor
-	Selection::Collector_WithinSphere<PFP> neigh(map, position, radius) ;
 	neigh.collectAll(v) ;
 
 	MATRIX tensor(0) ;
@@ -401,6 +419,25 @@ void computeCurvatureVertex_NormalCycles_Projected(
 	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmax,
 	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmin,
 	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Knormal)
+{
+	Selection::Collector_WithinSphere<PFP> neigh(map, position, radius) ;
+	computeCurvatureVertex_NormalCycles_Projected<PFP>(map, v, neigh, position, normal, edgeangle, edgearea, kmax, kmin, Kmax, Kmin, Knormal) ;
+}
+
+template <typename PFP>
+void computeCurvatureVertex_NormalCycles_Projected(
+	typename PFP::MAP& /*map*/,
+	Vertex v,
+	Algo::Surface::Selection::Collector<PFP>& neigh,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+	const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& normal,
+	const EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edgeangle,
+	const EdgeAttribute<typename PFP::REAL, typename PFP::MAP>& edgearea,
+	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmax,
+	VertexAttribute<typename PFP::REAL, typename PFP::MAP>& kmin,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmax,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Kmin,
+	VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& Knormal)
 {
 	typedef typename PFP::REAL REAL ;
 	typedef typename PFP::VEC3 VEC3 ;
@@ -409,7 +446,6 @@ void computeCurvatureVertex_NormalCycles_Projected(
 	typedef Eigen::Matrix<REAL,3,3,Eigen::RowMajor> E_MATRIX;
 
 	// collect the normal cycle tensor
-	Selection::Collector_WithinSphere<PFP> neigh(map, position, radius) ;
 	neigh.collectAll(v) ;
 
 	MATRIX tensor(0) ;
@@ -742,10 +778,16 @@ void computeCurvatureVertices_NormalCycles(
 	if (!map.template isOrbitEmbedded<FACE>())
 		Algo::Topo::initAllOrbitsEmbedding<FACE>(map);
 
-	CGoGN::Parallel::foreach_cell<VERTEX>(map, [&] (Vertex v, unsigned int /*thr*/)
+	// neighborhoods given by a kd-tree of the positions: one collector by thread, no marker
+	const unsigned int nbth = CGoGN::Parallel::checkNbThreads(CGoGN::Parallel::NumberOfThreads);
+	Algo::Geometry::KdTree<typename PFP::VEC3> kdTree;
+	kdTree.build(position, nbth);
+	std::vector< Selection::Collector_WithinSphere_KdTree<PFP> > neighs(nbth, Selection::Collector_WithinSphere_KdTree<PFP>(map, position, kdTree, radius));
+
+	CGoGN::Parallel::foreach_cell<VERTEX>(map, [&] (Vertex v, unsigned int thr)
 	{
-		computeCurvatureVertex_NormalCycles<PFP>(map, v, radius, position, normal, edgeangle, edgearea, kmax, kmin, Kmax, Kmin, Knormal) ;
-	}, FORCE_CELL_MARKING);
+		computeCurvatureVertex_NormalCycles<PFP>(map, v, neighs[thr], position, normal, edgeangle, edgearea, kmax, kmin, Kmax, Kmin, Knormal) ;
+	}, FORCE_CELL_MARKING, nbth);
 }
 
 template <typename PFP>
@@ -772,10 +814,16 @@ void computeCurvatureVertices_NormalCycles_Projected(
 	if (!map.template isOrbitEmbedded<FACE>())
 		Algo::Topo::initAllOrbitsEmbedding<FACE>(map);
 
-	CGoGN::Parallel::foreach_cell<VERTEX>(map, [&] (Vertex v, unsigned int /*thr*/)
+	// neighborhoods given by a kd-tree of the positions: one collector by thread, no marker
+	const unsigned int nbth = CGoGN::Parallel::checkNbThreads(CGoGN::Parallel::NumberOfThreads);
+	Algo::Geometry::KdTree<typename PFP::VEC3> kdTree;
+	kdTree.build(position, nbth);
+	std::vector< Selection::Collector_WithinSphere_KdTree<PFP> > neighs(nbth, Selection::Collector_WithinSphere_KdTree<PFP>(map, position, kdTree, radius));
+
+	CGoGN::Parallel::foreach_cell<VERTEX>(map, [&] (Vertex v, unsigned int thr)
 	{
-		computeCurvatureVertex_NormalCycles_Projected<PFP>(map, v, radius, position, normal, edgeangle, edgearea, kmax, kmin, Kmax, Kmin, Knormal) ;
-	}, FORCE_CELL_MARKING);
+		computeCurvatureVertex_NormalCycles_Projected<PFP>(map, v, neighs[thr], position, normal, edgeangle, edgearea, kmax, kmin, Kmax, Kmin, Knormal) ;
+	}, FORCE_CELL_MARKING, nbth);
 }
 
 } // namespace Parallel
@@ -25,6 +25,8 @@
 #ifndef __ALGO_GEOMETRY_DISTANCE_H__
 #define __ALGO_GEOMETRY_DISTANCE_H__
 
+#include "Algo/Geometry/faceBVH.h"
+
 namespace CGoGN
 {
 
@@ -81,9 +83,41 @@ void closestPointInTriangle(typename PFP::MAP& map, Face f, const VertexAttribut
 template <typename PFP>
 typename PFP::REAL squaredDistancePoint2Edge(typename PFP::MAP& map, Edge e, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, const typename PFP::VEC3& P) ;
 
-//template <typename PFP>
-//void computeDistance(typename PFP::MAP& map1, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position1, VertexAttribute<typename PFP::REAL, typename PFP::MAP>& distance1,
-//					 typename PFP::MAP& map2, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position2) ;
+/**
+* statistics of the distances of the vertices of a map to another map
+*/
+template <typename REAL>
+struct DistanceStats
+{
+	unsigned int nbVertices;
+	REAL min;
+	REAL max;	// one-sided Hausdorff distance
+	REAL mean;
+	REAL rms;
+};
+
+/**
+* compute the distance from each vertex of map1 to the surface of map2
+* (closest face of map2 given by a FaceBVH of map2)
+* @param map1 the first map
+* @param position1 the vertex attribute storing positions of map1
+* @param distance1 (out) the vertex attribute of map1 receiving the distances
+* @param bvh2 the BVH of the faces of map2
+* @param nbth number of threads (< 2: sequential)
+* @return the statistics of the distances
+*/
+template <typename PFP>
+DistanceStats<typename PFP::REAL> computeDistance(typename PFP::MAP& map1, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position1, VertexAttribute<typename PFP::REAL, typename PFP::MAP>& distance1,
+					 const FaceBVH<PFP>& bvh2, unsigned int nbth = CGoGN::Parallel::NumberOfThreads) ;
+
+/**
+* compute the distance from each vertex of map1 to the surface of map2
+* (builds a FaceBVH of map2)
+* @return the statistics of the distances (max is the one-sided Hausdorff distance from map1 to map2)
+*/
+template <typename PFP>
+DistanceStats<typename PFP::REAL> computeDistance(typename PFP::MAP& map1, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position1, VertexAttribute<typename PFP::REAL, typename PFP::MAP>& distance1,
+					 typename PFP::MAP& map2, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position2, unsigned int nbth = CGoGN::Parallel::NumberOfThreads) ;
 
 } // namespace Geometry
 
@@ -23,6 +23,10 @@
 *******************************************************************************/
 
 #include "Geometry/distances.h"
+#include "Topology/generic/reduction.h"
+
+#include <cmath>
+#include <limits>
 
 namespace CGoGN
 {
@@ -89,6 +93,78 @@ typename PFP::REAL squaredDistancePoint2Edge(typename PFP::MAP& map, Edge e, con
 	return Geom::squaredDistanceSeg2Point(A, AB, AB2, P) ;
 }
 
+/// partial sums of computeDistance (the last closest face is the first candidate of the next vertex)
+template <typename PFP>
+struct DistanceAccumulator
+{
+	typedef typename PFP::REAL REAL;
+
+	unsigned int nb;
+	REAL min;
+	REAL max;
+	double sum;
+	double sum2;
+	Face lastFace;
+
+	DistanceAccumulator() : nb(0), min(std::numeric_limits<REAL>::max()), max(0), sum(0), sum2(0), lastFace(NIL) {}
+
+	void add(REAL d)
+	{
+		++nb;
+		min = std::min(min, d);
+		max = std::max(max, d);
+		sum += d;
+		sum2 += double(d) * double(d);
+	}
+
+	void combine(const DistanceAccumulator& a)
+	{
+		nb += a.nb;
+		min = std::min(min, a.min);
+		max = std::max(max, a.max);
+		sum += a.sum;
+		sum2 += a.sum2;
+	}
+};
+
+template <typename PFP>
+DistanceStats<typename PFP::REAL> computeDistance(typename PFP::MAP& map1, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position1, VertexAttribute<typename PFP::REAL, typename PFP::MAP>& distance1,
+					 const FaceBVH<PFP>& bvh2, unsigned int nbth)
+{
+	typedef typename PFP::REAL REAL;
+	typedef DistanceAccumulator<PFP> ACC;
+
+	auto distVertex = [&] (ACC& acc, Vertex v)
+	{
+		REAL d = std::sqrt(bvh2.closestFace(position1[v], acc.lastFace));
+		distance1[v] = d;
+		acc.add(d);
+	};
+
+	ACC acc;
+	if (nbth > 1)
+		acc = CGoGN::Parallel::reduce_cell<VERTEX>(map1, ACC(), distVertex,
+			[] (ACC& a, const ACC& b) { a.combine(b); }, AUTO, nbth);
+	else
+		foreach_cell<VERTEX>(map1, [&] (Vertex v) { distVertex(acc, v); });
+
+	DistanceStats<REAL> stats;
+	stats.nbVertices = acc.nb;
+	stats.min = acc.nb > 0 ? acc.min : REAL(0);
+	stats.max = acc.max;
+	stats.mean = acc.nb > 0 ? REAL(acc.sum / acc.nb) : REAL(0);
+	stats.rms = acc.nb > 0 ? REAL(std::sqrt(acc.sum2 / acc.nb)) : REAL(0);
+	return stats;
+}
+
+template <typename PFP>
+DistanceStats<typename PFP::REAL> computeDistance(typename PFP::MAP& map1, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position1, VertexAttribute<typename PFP::REAL, typename PFP::MAP>& distance1,
+					 typename PFP::MAP& map2, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position2, unsigned int nbth)
+{
+	FaceBVH<PFP> bvh2(map2, position2, nbth);
+	return computeDistance<PFP>(map1, position1, distance1, bvh2, nbth);
+}
+
 } // namespace Geometry
 
 } // namespace Algo
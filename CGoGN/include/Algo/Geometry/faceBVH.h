@@ -0,0 +1,165 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef __ALGO_GEOMETRY_FACE_BVH_H__
+#define __ALGO_GEOMETRY_FACE_BVH_H__
+
+#include "Geometry/bounding_box.h"
+#include "Topology/generic/attributeHandler.h"
+#include "Topology/generic/parallelRange.h"
+
+#include <vector>
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Geometry
+{
+
+/**
+ * Bounding volume hierarchy of the faces of a map, for ray / line and closest face queries.
+ * The bounding boxes of the faces are stored in a FaceAttribute (the faces are
+ * embedded if needed). The tree is built with the surface area heuristic evaluated
+ * on bins of the centroids: the top of the tree is built with a parallel binning, then
+ * the subtrees are built in parallel. The tree does not depend on the number of threads.
+ * After a modification of the positions the boxes are refitted (refit), after a
+ * modification of the topology the tree has to be rebuilt (build).
+ * Lines are tested in both directions from rayA (as Geom::intersectionRayTriangleOpt
+ * used by the ray selection functions).
+ */
+template <typename PFP>
+class FaceBVH
+{
+public:
+	typedef typename PFP::MAP MAP;
+	typedef typename PFP::VEC3 VEC3;
+	typedef typename PFP::REAL REAL;
+	typedef Geom::BoundingBox<VEC3> BB;
+
+	/// max number of faces of a leaf
+	static const unsigned int MAX_LEAF_SIZE = 4;
+
+	/**
+	 * node of the tree: a leaf has nb faces from first in the table of faces,
+	 * an internal node (nb == 0) has its children in first and first+1
+	 */
+	struct Node
+	{
+		VEC3 bbMin;
+		VEC3 bbMax;
+		unsigned int first;
+		unsigned int nb;
+	};
+
+protected:
+	MAP& m_map;
+	VertexAttribute<VEC3, MAP> m_position;
+	FaceAttribute<BB, MAP> m_faceBB;
+
+	std::vector<Node> m_nodes;
+
+	/// faces ordered by leaf
+	std::vector<Face> m_faces;
+
+	class Builder;
+
+	void computeFaceBoundingBoxes(unsigned int nbth);
+
+	/// inverse of the direction (0 for the null components, tested apart)
+	static inline VEC3 inverseDirection(const VEC3& rayAB);
+
+	inline bool lineBox(const Node& n, const VEC3& rayA, const VEC3& invAB, REAL margin, REAL& tmin, REAL& tmax) const;
+
+	inline bool intersectFace(Face f, const VEC3& rayA, const VEC3& rayAB, VEC3& inter) const;
+
+	static inline REAL squaredDistancePointBox(const Node& n, const VEC3& P);
+
+	inline REAL squaredDistanceFace(Face f, const VEC3& P) const;
+
+public:
+	/**
+	 * build the tree of the faces of map
+	 */
+	FaceBVH(MAP& map, const VertexAttribute<VEC3, MAP>& position, unsigned int nbth = CGoGN::Parallel::NumberOfThreads);
+
+	~FaceBVH();
+
+	/**
+	 * rebuild the tree (after a modification of the topology)
+	 */
+	void build(unsigned int nbth = CGoGN::Parallel::NumberOfThreads);
+
+	/**
+	 * update the boxes of the faces and of the nodes (after a modification of the positions)
+	 */
+	void refit(unsigned int nbth = CGoGN::Parallel::NumberOfThreads);
+
+	const FaceAttribute<BB, MAP>& faceBoundingBoxes() const { return m_faceBB; }
+
+	const std::vector<Node>& nodes() const { return m_nodes; }
+
+	const std::vector<Face>& faces() const { return m_faces; }
+
+	/**
+	 * intersection of the line (rayA, rayAB) closest to rayA
+	 * @param face (out) intersected face
+	 * @param inter (out) intersection point
+	 * @return false if no face is intersected
+	 */
+	bool closestHit(const VEC3& rayA, const VEC3& rayAB, Face& face, VEC3& inter) const;
+
+	/**
+	 * all the intersections of the line (rayA, rayAB) (not sorted)
+	 * @param faces (out) intersected faces
+	 * @param inters (out) intersection points
+	 */
+	void allHits(const VEC3& rayA, const VEC3& rayAB, std::vector<Face>& faces, std::vector<VEC3>& inters) const;
+
+	/**
+	 * face closest to point P (distance computed as Algo::Geometry::squaredDistancePoint2Face)
+	 * @param face (in/out) closest face; if valid on input it is used as first candidate
+	 * (a good guess, as the face found for a neighbour point, speeds up the query)
+	 * @return the squared distance from P to face (max of REAL if the tree is empty)
+	 */
+	REAL closestFace(const VEC3& P, Face& face) const;
+
+	/**
+	 * apply f on each face whose box enlarged by margin intersects the line (rayA, rayAB)
+	 */
+	template <typename FUNC>
+	void foreachFaceNearLine(const VEC3& rayA, const VEC3& rayAB, REAL margin, FUNC f) const;
+};
+
+} // namespace Geometry
+
+} // namespace Algo
+
+} // namespace CGoGN
+
+#include "Algo/Geometry/faceBVH.hpp"
+
+#endif
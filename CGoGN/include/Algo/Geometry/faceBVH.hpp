@@ -0,0 +1,738 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include "Topology/generic/traversor/traversorCell.h"
+#include "Algo/Topo/basic.h"
+#include "Geometry/intersection.h"
+#include "Geometry/distances.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Geometry
+{
+
+/**
+ * binned SAH construction over the boxes of the faces
+ * (the faces are designated by their index in the table of faces given to the builder)
+ */
+template <typename PFP>
+class FaceBVH<PFP>::Builder
+{
+public:
+	static const unsigned int NB_BINS = 16;
+
+	/// ranges of faces smaller than this are built in one task
+	static const unsigned int SUBTREE_SIZE = 4096;
+
+	/// ranges of faces bigger than this are binned in parallel
+	static const unsigned int PARALLEL_SIZE = 65536;
+
+	struct Range
+	{
+		unsigned int node;
+		unsigned int begin;
+		unsigned int end;
+		VEC3 cMin;
+		VEC3 cMax;
+	};
+
+protected:
+	struct Bins
+	{
+		VEC3 bbMin[3][NB_BINS];
+		VEC3 bbMax[3][NB_BINS];
+		unsigned int nb[3][NB_BINS];
+	};
+
+	std::vector<VEC3> m_min;
+	std::vector<VEC3> m_max;
+	std::vector<VEC3> m_centroid;
+
+	static REAL area(const VEC3& bbMin, const VEC3& bbMax)
+	{
+		VEC3 d = bbMax - bbMin;
+		return d[0] * d[1] + d[1] * d[2] + d[2] * d[0];
+	}
+
+	static void emptyBox(VEC3& bbMin, VEC3& bbMax)
+	{
+		bbMin = VEC3(std::numeric_limits<REAL>::max());
+		bbMax = VEC3(-std::numeric_limits<REAL>::max());
+	}
+
+	static void addBox(VEC3& bbMin, VEC3& bbMax, const VEC3& pMin, const VEC3& pMax)
+	{
+		for (unsigned int k = 0; k < 3; ++k)
+		{
+			bbMin[k] = std::min(bbMin[k], pMin[k]);
+			bbMax[k] = std::max(bbMax[k], pMax[k]);
+		}
+	}
+
+	unsigned int binOf(unsigned int p, unsigned int axis, const VEC3& cMin, REAL scale) const
+	{
+		unsigned int b = (unsigned int)((m_centroid[p][axis] - cMin[axis]) * scale);
+		return std::min(b, NB_BINS - 1);
+	}
+
+	/// box of the faces of [begin, end[ and box of their centroids
+	void bounds(unsigned int begin, unsigned int end, Node& n, VEC3& cMin, VEC3& cMax, unsigned int nbth) const
+	{
+		if (end - begin < PARALLEL_SIZE)
+			nbth = 1;
+		unsigned int nbTasks = CGoGN::Parallel::nbTasksOfRange(end - begin, nbth);
+		std::vector<VEC3> boxes(4 * nbTasks);
+		for (unsigned int t = 0; t < nbTasks; ++t)
+		{
+			emptyBox(boxes[4*t], boxes[4*t+1]);
+			emptyBox(boxes[4*t+2], boxes[4*t+3]);
+		}
+		CGoGN::Parallel::foreach_index(end - begin, [&] (unsigned int i, unsigned int t)
+		{
+			unsigned int p = m_prims[begin + i];
+			addBox(boxes[4*t], boxes[4*t+1], m_min[p], m_max[p]);
+			addBox(boxes[4*t+2], boxes[4*t+3], m_centroid[p], m_centroid[p]);
+		}, nbth);
+
+		emptyBox(n.bbMin, n.bbMax);
+		emptyBox(cMin, cMax);
+		for (unsigned int t = 0; t < nbTasks; ++t)
+		{
+			addBox(n.bbMin, n.bbMax, boxes[4*t], boxes[4*t+1]);
+			addBox(cMin, cMax, boxes[4*t+2], boxes[4*t+3]);
+		}
+	}
+
+	/**
+	 * choose the best SAH split of the range and partition it
+	 * @return false if the range has to be a leaf
+	 */
+	bool split(const Range& r, const Node& n, unsigned int& mid, unsigned int nbth)
+	{
+		unsigned int nb = r.end - r.begin;
+		if (nb <= 1)
+			return false;
+
+		VEC3 scale;
+		for (unsigned int k = 0; k < 3; ++k)
+		{
+			REAL extent = r.cMax[k] - r.cMin[k];
+			scale[k] = extent > REAL(0) ? REAL(NB_BINS) / extent : REAL(0);
+		}
+
+		// all the centroids are equal: split in the middle if the range is too big
+		if (scale[0] == REAL(0) && scale[1] == REAL(0) && scale[2] == REAL(0))
+		{
+			if (nb <= MAX_LEAF_SIZE)
+				return false;
+			mid = r.begin + nb / 2;
+			return true;
+		}
+
+		// binning (per task bins merged afterwards)
+		if (nb < PARALLEL_SIZE)
+			nbth = 1;
+		unsigned int nbTasks = CGoGN::Parallel::nbTasksOfRange(nb, nbth);
+		std::vector<Bins> bins(nbTasks);
+		for (unsigned int t = 0; t < nbTasks; ++t)
+		{
+			for (unsigned int k = 0; k < 3; ++k)
+				for (unsigned int b = 0; b < NB_BINS; ++b)
+				{
+					emptyBox(bins[t].bbMin[k][b], bins[t].bbMax[k][b]);
+					bins[t].nb[k][b] = 0;
+				}
+		}
+		CGoGN::Parallel::foreach_index(nb, [&] (unsigned int i, unsigned int t)
+		{
+			unsigned int p = m_prims[r.begin + i];
+			for (unsigned int k = 0; k < 3; ++k)
+			{
+				if (scale[k] == REAL(0))
+					continue;
+				unsigned int b = binOf(p, k, r.cMin, scale[k]);
+				addBox(bins[t].bbMin[k][b], bins[t].bbMax[k][b], m_min[p], m_max[p]);
+				++bins[t].nb[k][b];
+			}
+		}, nbth);
+		for (unsigned int t = 1; t < nbTasks; ++t)
+		{
+			for (unsigned int k = 0; k < 3; ++k)
+				for (unsigned int b = 0; b < NB_BINS; ++b)
+				{
+					addBox(bins[0].bbMin[k][b], bins[0].bbMax[k][b], bins[t].bbMin[k][b], bins[t].bbMax[k][b]);
+					bins[0].nb[k][b] += bins[t].nb[k][b];
+				}
+		}
+		const Bins& bs = bins[0];
+
+		// sweep of the split planes between the bins
+		REAL bestCost = std::numeric_limits<REAL>::max();
+		unsigned int bestAxis = 0;
+		unsigned int bestBin = 0;
+		for (unsigned int k = 0; k < 3; ++k)
+		{
+			if (scale[k] == REAL(0))
+				continue;
+
+			REAL rightCost[NB_BINS];
+			VEC3 bbMin, bbMax;
+			emptyBox(bbMin, bbMax);
+			unsigned int nbRight = 0;
+			for (unsigned int b = NB_BINS - 1; b > 0; --b)
+			{
+				if (bs.nb[k][b] > 0)
+					addBox(bbMin, bbMax, bs.bbMin[k][b], bs.bbMax[k][b]);
+				nbRight += bs.nb[k][b];
+				rightCost[b] = nbRight > 0 ? area(bbMin, bbMax) * nbRight : REAL(0);
+			}
+
+			emptyBox(bbMin, bbMax);
+			unsigned int nbLeft = 0;
+			for (unsigned int b = 0; b < NB_BINS - 1; ++b)
+			{
+				if (bs.nb[k][b] > 0)
+					addBox(bbMin, bbMax, bs.bbMin[k][b], bs.bbMax[k][b]);
+				nbLeft += bs.nb[k][b];
+				if (nbLeft == 0 || nbLeft == nb)
+					continue;
+				REAL cost = area(bbMin, bbMax) * nbLeft + rightCost[b + 1];
+				if (cost < bestCost)
+				{
+					bestCost = cost;
+					bestAxis = k;
+					bestBin = b;
+				}
+			}
+		}
+
+		// cost of a traversal step = cost of a face test
+		REAL nodeArea = area(n.bbMin, n.bbMax);
+		REAL splitCost = nodeArea > REAL(0) ? REAL(1) + bestCost / nodeArea : REAL(nb);
+		if (nb <= MAX_LEAF_SIZE && REAL(nb) <= splitCost)
+			return false;
+
+		const REAL s = scale[bestAxis];
+		const VEC3& cMin = r.cMin;
+		mid = (unsigned int)(std::partition(m_prims.begin() + r.begin, m_prims.begin() + r.end, [&] (unsigned int p)
+		{
+			return binOf(p, bestAxis, cMin, s) <= bestBin;
+		}) - m_prims.begin());
+		return true;
+	}
+
+public:
+	/// faces in the order of the leaves
+	std::vector<unsigned int> m_prims;
+
+	Builder(const std::vector<Face>& faces, const FaceAttribute<BB, MAP>& faceBB) :
+		m_min(faces.size()),
+		m_max(faces.size()),
+		m_centroid(faces.size()),
+		m_prims(faces.size())
+	{
+		for (unsigned int i = 0; i < faces.size(); ++i)
+		{
+			const BB& bb = faceBB[faces[i]];
+			m_min[i] = bb.min();
+			m_max[i] = bb.max();
+			m_centroid[i] = (bb.min() + bb.max()) / REAL(2);
+			m_prims[i] = i;
+		}
+	}
+
+	/// create a root node for the whole table
+	Range root(std::vector<Node>& nodes, unsigned int nbth)
+	{
+		Range r;
+		r.node = uint32(nodes.size());
+		r.begin = 0;
+		r.end = uint32(m_prims.size());
+		nodes.push_back(Node());
+		bounds(r.begin, r.end, nodes.back(), r.cMin, r.cMax, nbth);
+		return r;
+	}
+
+	/**
+	 * split the range (children appended to nodes) or make it a leaf
+	 * @return false if the node is a leaf
+	 */
+	bool subdivide(const Range& r, std::vector<Node>& nodes, Range& left, Range& right, unsigned int nbth)
+	{
+		unsigned int mid;
+		Node& n = nodes[r.node];
+		if (!split(r, n, mid, nbth))
+		{
+			n.first = r.begin;
+			n.nb = r.end - r.begin;
+			return false;
+		}
+
+		n.first = uint32(nodes.size());
+		n.nb = 0;
+		left.node = n.first;
+		left.begin = r.begin;
+		left.end = mid;
+		right.node = n.first + 1;
+		right.begin = mid;
+		right.end = r.end;
+		nodes.resize(nodes.size() + 2);
+		bounds(left.begin, left.end, nodes[left.node], left.cMin, left.cMax, nbth);
+		bounds(right.begin, right.end, nodes[right.node], right.cMin, right.cMax, nbth);
+		return true;
+	}
+
+	/// sequential construction of the subtree of a range whose root is nodes[r.node]
+	void buildSubtree(const Range& r, std::vector<Node>& nodes)
+	{
+		std::vector<Range> stack;
+		stack.push_back(r);
+		while (!stack.empty())
+		{
+			Range cur = stack.back();
+			stack.pop_back();
+			Range left, right;
+			if (subdivide(cur, nodes, left, right, 1))
+			{
+				stack.push_back(right);
+				stack.push_back(left);
+			}
+		}
+	}
+};
+
+template <typename PFP>
+FaceBVH<PFP>::FaceBVH(MAP& map, const VertexAttribute<VEC3, MAP>& position, unsigned int nbth) :
+	m_map(map),
+	m_position(position)
+{
+	Algo::Topo::initAllOrbitsEmbedding<FACE>(map);
+	m_faceBB = map.template addAttribute<BB, FACE, MAP>("");
+	build(nbth);
+}
+
+template <typename PFP>
+FaceBVH<PFP>::~FaceBVH()
+{
+	if (m_faceBB.isValid())
+		m_map.removeAttribute(m_faceBB);
+}
+
+template <typename PFP>
+void FaceBVH<PFP>::computeFaceBoundingBoxes(unsigned int nbth)
+{
+	CGoGN::Parallel::foreach_index(uint32(m_faces.size()), [&] (unsigned int i, unsigned int)
+	{
+		Face f = m_faces[i];
+		BB& bb = m_faceBB[f];
+		bb.reset();
+		Dart d = f.dart;
+		do
+		{
+			bb.addPoint(m_position[d]);
+			d = m_map.phi1(d);
+		} while (d != f.dart);
+	}, nbth);
+}
+
+template <typename PFP>
+void FaceBVH<PFP>::build(unsigned int nbth)
+{
+	m_nodes.clear();
+	m_faces.clear();
+	foreach_cell<FACE>(m_map, [&] (Face f) { m_faces.push_back(f); });
+	if (m_faces.empty())
+		return;
+
+	computeFaceBoundingBoxes(nbth);
+
+	Builder builder(m_faces, m_faceBB);
+	m_nodes.reserve(2 * m_faces.size() / MAX_LEAF_SIZE + 1);
+
+	// top of the tree: the big ranges are binned in parallel
+	std::vector<typename Builder::Range> stack;
+	std::vector<typename Builder::Range> subtrees;
+	stack.push_back(builder.root(m_nodes, nbth));
+	while (!stack.empty())
+	{
+		typename Builder::Range cur = stack.back();
+		stack.pop_back();
+		if (cur.end - cur.begin <= Builder::SUBTREE_SIZE)
+		{
+			subtrees.push_back(cur);
+			continue;
+		}
+		typename Builder::Range left, right;
+		if (builder.subdivide(cur, m_nodes, left, right, nbth))
+		{
+			stack.push_back(right);
+			stack.push_back(left);
+		}
+	}
+
+	// the subtrees are built in parallel in local tables of nodes
+	std::vector< std::vector<Node> > subNodes(subtrees.size());
+	auto buildSub = [&] (unsigned int i, unsigned int)
+	{
+		subNodes[i].push_back(m_nodes[subtrees[i].node]);
+		typename Builder::Range r = subtrees[i];
+		r.node = 0;
+		builder.buildSubtree(r, subNodes[i]);
+	};
+	if (nbth < 2 || subtrees.size() < 2)
+	{
+		for (unsigned int i = 0; i < subtrees.size(); ++i)
+			buildSub(i, 0);
+	}
+	else
+	{
+		nbth = CGoGN::Parallel::checkNbThreads(nbth);
+		CGoGN::Parallel::getThreadPool(nbth - 1).exec(uint32(subtrees.size()), buildSub, nbth - 1);
+	}
+
+	// and appended to the table (the root of a subtree replaces its node)
+	for (unsigned int i = 0; i < subtrees.size(); ++i)
+	{
+		const std::vector<Node>& sub = subNodes[i];
+		unsigned int offset = uint32(m_nodes.size()) - 1;
+		for (unsigned int j = 0; j < sub.size(); ++j)
+		{
+			Node n = sub[j];
+			if (n.nb == 0)
+				n.first += offset;
+			if (j == 0)
+				m_nodes[subtrees[i].node] = n;
+			else
+				m_nodes.push_back(n);
+		}
+	}
+
+	std::vector<Face> faces(m_faces.size());
+	for (unsigned int i = 0; i < faces.size(); ++i)
+		faces[i] = m_faces[builder.m_prims[i]];
+	m_faces.swap(faces);
+}
+
+template <typename PFP>
+void FaceBVH<PFP>::refit(unsigned int nbth)
+{
+	computeFaceBoundingBoxes(nbth);
+
+	CGoGN::Parallel::foreach_index(uint32(m_nodes.size()), [&] (unsigned int i, unsigned int)
+	{
+		Node& n = m_nodes[i];
+		if (n.nb == 0)
+			return;
+		n.bbMin = m_faceBB[m_faces[n.first]].min();
+		n.bbMax = m_faceBB[m_faces[n.first]].max();
+		for (unsigned int j = n.first + 1; j < n.first + n.nb; ++j)
+		{
+			const BB& bb = m_faceBB[m_faces[j]];
+			for (unsigned int k = 0; k < 3; ++k)
+			{
+				n.bbMin[k] = std::min(n.bbMin[k], bb.min()[k]);
+				n.bbMax[k] = std::max(n.bbMax[k], bb.max()[k]);
+			}
+		}
+	}, nbth);
+
+	// the children are after their parent
+	for (unsigned int i = uint32(m_nodes.size()); i-- > 0; )
+	{
+		Node& n = m_nodes[i];
+		if (n.nb > 0)
+			continue;
+		const Node& l = m_nodes[n.first];
+		const Node& r = m_nodes[n.first + 1];
+		for (unsigned int k = 0; k < 3; ++k)
+		{
+			n.bbMin[k] = std::min(l.bbMin[k], r.bbMin[k]);
+			n.bbMax[k] = std::max(l.bbMax[k], r.bbMax[k]);
+		}
+	}
+}
+
+template <typename PFP>
+inline bool FaceBVH<PFP>::lineBox(const Node& n, const VEC3& rayA, const VEC3& invAB, REAL margin, REAL& tmin, REAL& tmax) const
+{
+	tmin = -std::numeric_limits<REAL>::max();
+	tmax = std::numeric_limits<REAL>::max();
+	for (unsigned int k = 0; k < 3; ++k)
+	{
+		REAL bMin = n.bbMin[k] - margin;
+		REAL bMax = n.bbMax[k] + margin;
+		if (invAB[k] == REAL(0)) // line parallel to the slab
+		{
+			if (rayA[k] < bMin || rayA[k] > bMax)
+				return false;
+			continue;
+		}
+		REAL t1 = (bMin - rayA[k]) * invAB[k];
+		REAL t2 = (bMax - rayA[k]) * invAB[k];
+		if (t1 > t2)
+			std::swap(t1, t2);
+		tmin = std::max(tmin, t1);
+		tmax = std::min(tmax, t2);
+		if (tmin > tmax)
+			return false;
+	}
+	return true;
+}
+
+template <typename PFP>
+inline bool FaceBVH<PFP>::intersectFace(Face f, const VEC3& rayA, const VEC3& rayAB, VEC3& inter) const
+{
+	// same fan of triangles as Algo::Selection::facesRaySelection
+	const VEC3& Ta = m_position[f.dart];
+	Dart dd = m_map.phi1(f.dart);
+	Dart ddd = m_map.phi1(dd);
+	do
+	{
+		if (Geom::intersectionRayTriangleOpt<VEC3>(rayA, rayAB, Ta, m_position[dd], m_position[ddd], inter))
+			return true;
+		dd = ddd;
+		ddd = m_map.phi1(dd);
+	} while (ddd != f.dart);
+	return false;
+}
+
+template <typename PFP>
+inline typename PFP::VEC3 FaceBVH<PFP>::inverseDirection(const VEC3& rayAB)
+{
+	VEC3 inv;
+	for (unsigned int k = 0; k < 3; ++k)
+		inv[k] = rayAB[k] != REAL(0) ? REAL(1) / rayAB[k] : REAL(0);
+	return inv;
+}
+
+template <typename PFP>
+bool FaceBVH<PFP>::closestHit(const VEC3& rayA, const VEC3& rayAB, Face& face, VEC3& inter) const
+{
+	face = NIL;
+	if (m_nodes.empty())
+		return false;
+
+	const VEC3 inv = inverseDirection(rayAB);
+	const REAL AB2 = rayAB * rayAB;
+	REAL best = std::numeric_limits<REAL>::max();
+
+	// min distance (in parameter of the line) from rayA to the interval [tmin, tmax]
+	auto paramDist = [] (REAL tmin, REAL tmax) -> REAL
+	{
+		if (tmin <= REAL(0) && tmax >= REAL(0))
+			return REAL(0);
+		return std::min(std::abs(tmin), std::abs(tmax));
+	};
+
+	std::vector< std::pair<unsigned int, REAL> > stack;
+	REAL tmin, tmax;
+	if (!lineBox(m_nodes[0], rayA, inv, REAL(0), tmin, tmax))
+		return false;
+	stack.push_back(std::make_pair(0u, paramDist(tmin, tmax)));
+
+	while (!stack.empty())
+	{
+		std::pair<unsigned int, REAL> cur = stack.back();
+		stack.pop_back();
+		if (cur.second * cur.second * AB2 > best)
+			continue;
+
+		const Node& n = m_nodes[cur.first];
+		if (n.nb > 0)
+		{
+			for (unsigned int i = n.first; i < n.first + n.nb; ++i)
+			{
+				VEC3 I;
+				if (intersectFace(m_faces[i], rayA, rayAB, I))
+				{
+					REAL d2 = (I - rayA).norm2();
+					if (d2 < best)
+					{
+						best = d2;
+						face = m_faces[i];
+						inter = I;
+					}
+				}
+			}
+			continue;
+		}
+
+		// nearest child on top of the stack
+		std::pair<unsigned int, REAL> children[2];
+		unsigned int nbChildren = 0;
+		for (unsigned int c = 0; c < 2; ++c)
+		{
+			if (lineBox(m_nodes[n.first + c], rayA, inv, REAL(0), tmin, tmax))
+				children[nbChildren++] = std::make_pair(n.first + c, paramDist(tmin, tmax));
+		}
+		if (nbChildren == 2 && children[0].second < children[1].second)
+			std::swap(children[0], children[1]);
+		for (unsigned int c = 0; c < nbChildren; ++c)
+			stack.push_back(children[c]);
+	}
+
+	return face.dart != NIL;
+}
+
+template <typename PFP>
+inline typename PFP::REAL FaceBVH<PFP>::squaredDistancePointBox(const Node& n, const VEC3& P)
+{
+	REAL d2 = 0;
+	for (unsigned int k = 0; k < 3; ++k)
+	{
+		REAL d = std::max(n.bbMin[k] - P[k], std::max(REAL(0), P[k] - n.bbMax[k]));
+		d2 += d * d;
+	}
+	return d2;
+}
+
+template <typename PFP>
+inline typename PFP::REAL FaceBVH<PFP>::squaredDistanceFace(Face f, const VEC3& P) const
+{
+	// same fan of triangles as Algo::Geometry::squaredDistancePoint2Face
+	const VEC3& A = m_position[f.dart];
+	Dart d = m_map.phi1(f.dart);
+	Dart e = m_map.phi1(d);
+	REAL dist2 = Geom::squaredDistancePoint2Triangle(P, A, m_position[d], m_position[e]);
+	d = e;
+	e = m_map.phi1(d);
+	while (e != f.dart)
+	{
+		dist2 = std::min(dist2, Geom::squaredDistancePoint2Triangle(P, A, m_position[d], m_position[e]));
+		d = e;
+		e = m_map.phi1(d);
+	}
+	return dist2;
+}
+
+template <typename PFP>
+typename PFP::REAL FaceBVH<PFP>::closestFace(const VEC3& P, Face& face) const
+{
+	REAL best = std::numeric_limits<REAL>::max();
+	if (m_nodes.empty())
+	{
+		face = NIL;
+		return best;
+	}
+
+	if (face.dart != NIL)
+		best = squaredDistanceFace(face, P);
+
+	std::vector< std::pair<unsigned int, REAL> > stack;
+	stack.push_back(std::make_pair(0u, squaredDistancePointBox(m_nodes[0], P)));
+
+	while (!stack.empty())
+	{
+		std::pair<unsigned int, REAL> cur = stack.back();
+		stack.pop_back();
+		if (cur.second >= best)
+			continue;
+
+		const Node& n = m_nodes[cur.first];
+		if (n.nb > 0)
+		{
+			for (unsigned int i = n.first; i < n.first + n.nb; ++i)
+			{
+				REAL d2 = squaredDistanceFace(m_faces[i], P);
+				if (d2 < best)
+				{
+					best = d2;
+					face = m_faces[i];
+				}
+			}
+			continue;
+		}
+
+		// nearest child on top of the stack
+		std::pair<unsigned int, REAL> l = std::make_pair(n.first, squaredDistancePointBox(m_nodes[n.first], P));
+		std::pair<unsigned int, REAL> r = std::make_pair(n.first + 1, squaredDistancePointBox(m_nodes[n.first + 1], P));
+		if (l.second < r.second)
+			std::swap(l, r);
+		if (l.second < best)
+			stack.push_back(l);
+		if (r.second < best)
+			stack.push_back(r);
+	}
+
+	return best;
+}
+
+template <typename PFP>
+void FaceBVH<PFP>::allHits(const VEC3& rayA, const VEC3& rayAB, std::vector<Face>& faces, std::vector<VEC3>& inters) const
+{
+	faces.clear();
+	inters.clear();
+	foreachFaceNearLine(rayA, rayAB, REAL(0), [&] (Face f)
+	{
+		VEC3 I;
+		if (intersectFace(f, rayA, rayAB, I))
+		{
+			faces.push_back(f);
+			inters.push_back(I);
+		}
+	});
+}
+
+template <typename PFP>
+template <typename FUNC>
+void FaceBVH<PFP>::foreachFaceNearLine(const VEC3& rayA, const VEC3& rayAB, REAL margin, FUNC f) const
+{
+	if (m_nodes.empty())
+		return;
+
+	const VEC3 inv = inverseDirection(rayAB);
+	std::vector<unsigned int> stack;
+	stack.push_back(0);
+	while (!stack.empty())
+	{
+		const Node& n = m_nodes[stack.back()];
+		stack.pop_back();
+		REAL tmin, tmax;
+		if (!lineBox(n, rayA, inv, margin, tmin, tmax))
+			continue;
+		if (n.nb > 0)
+		{
+			for (unsigned int i = n.first; i < n.first + n.nb; ++i)
+				f(m_faces[i]);
+		}
+		else
+		{
+			stack.push_back(n.first + 1);
+			stack.push_back(n.first);
+		}
+	}
+}
+
+} // namespace Geometry
+
+} // namespace Algo
+
+} // namespace CGoGN
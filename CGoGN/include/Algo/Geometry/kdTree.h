@@ -0,0 +1,123 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#ifndef __ALGO_GEOMETRY_KD_TREE_H__
+#define __ALGO_GEOMETRY_KD_TREE_H__
+
+#include "Topology/generic/attributeHandler.h"
+#include "Topology/generic/parallelRange.h"
+
+#include <vector>
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Geometry
+{
+
+/**
+ * Kd-tree of points for radius and k nearest neighbours queries.
+ * The tree is implicit: the points are reordered so that each range of points
+ * is split at its median along the largest extent of its box
+ * (the splitting point is in the middle of the range, the axis is stored with it).
+ * The top of the tree is split sequentially, the subtrees are built in parallel;
+ * the tree does not depend on the number of threads.
+ * The points are designated by their index in the build (or their line for an attribute).
+ */
+template <typename VEC3>
+class KdTree
+{
+public:
+	typedef typename VEC3::DATA_TYPE REAL;
+
+	/// max number of points of a leaf
+	static const unsigned int LEAF_SIZE = 8;
+
+protected:
+	/// points in the order of the tree
+	std::vector<VEC3> m_points;
+	/// index of the points in the order of the tree
+	std::vector<unsigned int> m_ids;
+	/// split axis of the range whose middle point is i
+	std::vector<unsigned char> m_axis;
+
+	void splitRange(unsigned int begin, unsigned int end);
+
+	void buildRange(unsigned int begin, unsigned int end);
+
+	template <typename FUNC>
+	void radiusRange(unsigned int begin, unsigned int end, const VEC3& P, REAL r2, FUNC& f) const;
+
+	void nearestRange(unsigned int begin, unsigned int end, const VEC3& P, unsigned int k, std::vector< std::pair<REAL, unsigned int> >& heap) const;
+
+public:
+	KdTree() {}
+
+	/**
+	 * build the tree of nbPoints points
+	 * @param point point(i) returns the position of the i-th point
+	 */
+	template <typename POINT_FN>
+	void build(unsigned int nbPoints, POINT_FN point, unsigned int nbth = CGoGN::Parallel::NumberOfThreads);
+
+	/**
+	 * build the tree of the values of an attribute (the points are the used lines of the container)
+	 */
+	template <unsigned int ORBIT, typename MAP>
+	void build(const AttributeHandler<VEC3, ORBIT, MAP>& position, unsigned int nbth = CGoGN::Parallel::NumberOfThreads);
+
+	inline unsigned int size() const { return (unsigned int)(m_ids.size()); }
+
+	/**
+	 * apply f(point, dist2) on each point whose squared distance dist2 to P is <= radius^2 (no order)
+	 */
+	template <typename FUNC>
+	void foreachWithinRadius(const VEC3& P, REAL radius, FUNC f) const;
+
+	/**
+	 * the points whose distance to P is <= radius (no order)
+	 */
+	void withinRadius(const VEC3& P, REAL radius, std::vector<unsigned int>& points) const;
+
+	/**
+	 * the k points closest to P, sorted by distance (then by index)
+	 * @param points (out) the points (less than k if the tree is smaller)
+	 * @param dist2 (out) their squared distances to P
+	 */
+	void kNearest(const VEC3& P, unsigned int k, std::vector<unsigned int>& points, std::vector<REAL>& dist2) const;
+};
+
+} // namespace Geometry
+
+} // namespace Algo
+
+} // namespace CGoGN
+
+#include "Algo/Geometry/kdTree.hpp"
+
+#endif
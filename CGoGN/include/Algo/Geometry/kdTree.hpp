@@ -0,0 +1,258 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include <algorithm>
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Geometry
+{
+
+template <typename VEC3>
+void KdTree<VEC3>::splitRange(unsigned int begin, unsigned int end)
+{
+	VEC3 bbMin = m_points[m_ids[begin]];
+	VEC3 bbMax = bbMin;
+	for (unsigned int i = begin + 1; i < end; ++i)
+	{
+		const VEC3& p = m_points[m_ids[i]];
+		for (unsigned int k = 0; k < 3; ++k)
+		{
+			bbMin[k] = std::min(bbMin[k], p[k]);
+			bbMax[k] = std::max(bbMax[k], p[k]);
+		}
+	}
+	unsigned char axis = 0;
+	VEC3 ext = bbMax - bbMin;
+	if (ext[1] > ext[axis]) axis = 1;
+	if (ext[2] > ext[axis]) axis = 2;
+
+	// m_ids holds indices in m_points (still in the input order) during the build
+	const unsigned int mid = (begin + end) / 2;
+	std::nth_element(m_ids.begin() + begin, m_ids.begin() + mid, m_ids.begin() + end, [&] (unsigned int a, unsigned int b)
+	{
+		const REAL pa = m_points[a][axis];
+		const REAL pb = m_points[b][axis];
+		return pa < pb || (pa == pb && a < b);
+	});
+	m_axis[mid] = axis;
+}
+
+template <typename VEC3>
+void KdTree<VEC3>::buildRange(unsigned int begin, unsigned int end)
+{
+	while (end - begin > LEAF_SIZE)
+	{
+		splitRange(begin, end);
+		const unsigned int mid = (begin + end) / 2;
+		buildRange(begin, mid);
+		begin = mid + 1;
+	}
+}
+
+template <typename VEC3>
+template <typename POINT_FN>
+void KdTree<VEC3>::build(unsigned int nbPoints, POINT_FN point, unsigned int nbth)
+{
+	// ranges of points smaller than this are built in one task
+	const unsigned int SUBTREE_SIZE = 4096;
+
+	m_points.resize(nbPoints);
+	m_ids.resize(nbPoints);
+	m_axis.assign(nbPoints, 0);
+	CGoGN::Parallel::foreach_index(nbPoints, [&] (unsigned int i, unsigned int)
+	{
+		m_points[i] = point(i);
+		m_ids[i] = i;
+	}, nbth);
+
+	// top of the tree
+	std::vector< std::pair<unsigned int, unsigned int> > ranges;
+	std::vector< std::pair<unsigned int, unsigned int> > subtrees;
+	ranges.push_back(std::make_pair(0u, nbPoints));
+	while (!ranges.empty())
+	{
+		std::pair<unsigned int, unsigned int> r = ranges.back();
+		ranges.pop_back();
+		if (r.second - r.first <= SUBTREE_SIZE)
+		{
+			subtrees.push_back(r);
+			continue;
+		}
+		splitRange(r.first, r.second);
+		const unsigned int mid = (r.first + r.second) / 2;
+		ranges.push_back(std::make_pair(r.first, mid));
+		ranges.push_back(std::make_pair(mid + 1, r.second));
+	}
+
+	// subtrees
+	CGoGN::Parallel::foreach_index((unsigned int)(subtrees.size()), [&] (unsigned int i, unsigned int)
+	{
+		buildRange(subtrees[i].first, subtrees[i].second);
+	}, nbth);
+
+	// points in the order of the tree
+	std::vector<VEC3> points(nbPoints);
+	CGoGN::Parallel::foreach_index(nbPoints, [&] (unsigned int i, unsigned int)
+	{
+		points[i] = m_points[m_ids[i]];
+	}, nbth);
+	m_points.swap(points);
+}
+
+template <typename VEC3>
+template <unsigned int ORBIT, typename MAP>
+void KdTree<VEC3>::build(const AttributeHandler<VEC3, ORBIT, MAP>& position, unsigned int nbth)
+{
+	std::vector<unsigned int> lines;
+	for (unsigned int i = position.begin(); i != position.end(); position.next(i))
+		lines.push_back(i);
+
+	build((unsigned int)(lines.size()), [&] (unsigned int i) -> const VEC3&
+	{
+		return position[lines[i]];
+	}, nbth);
+
+	for (unsigned int i = 0; i < m_ids.size(); ++i)
+		m_ids[i] = lines[m_ids[i]];
+}
+
+template <typename VEC3>
+template <typename FUNC>
+void KdTree<VEC3>::radiusRange(unsigned int begin, unsigned int end, const VEC3& P, REAL r2, FUNC& f) const
+{
+	while (end - begin > LEAF_SIZE)
+	{
+		const unsigned int mid = (begin + end) / 2;
+		const REAL diff = P[m_axis[mid]] - m_points[mid][m_axis[mid]];
+		const REAL d2 = (m_points[mid] - P).norm2();
+		if (d2 <= r2)
+			f(m_ids[mid], d2);
+		// far side first (recursion), then near side (loop)
+		if (diff <= REAL(0))
+		{
+			if (diff * diff <= r2)
+				radiusRange(mid + 1, end, P, r2, f);
+			end = mid;
+		}
+		else
+		{
+			if (diff * diff <= r2)
+				radiusRange(begin, mid, P, r2, f);
+			begin = mid + 1;
+		}
+	}
+	for (unsigned int i = begin; i < end; ++i)
+	{
+		const REAL d2 = (m_points[i] - P).norm2();
+		if (d2 <= r2)
+			f(m_ids[i], d2);
+	}
+}
+
+template <typename VEC3>
+template <typename FUNC>
+void KdTree<VEC3>::foreachWithinRadius(const VEC3& P, REAL radius, FUNC f) const
+{
+	radiusRange(0, size(), P, radius * radius, f);
+}
+
+template <typename VEC3>
+void KdTree<VEC3>::withinRadius(const VEC3& P, REAL radius, std::vector<unsigned int>& points) const
+{
+	points.clear();
+	foreachWithinRadius(P, radius, [&] (unsigned int i, REAL) { points.push_back(i); });
+}
+
+template <typename VEC3>
+void KdTree<VEC3>::nearestRange(unsigned int begin, unsigned int end, const VEC3& P, unsigned int k, std::vector< std::pair<REAL, unsigned int> >& heap) const
+{
+	// heap: max-heap of the k best (squared distance, index)
+	auto consider = [&] (unsigned int i)
+	{
+		std::pair<REAL, unsigned int> c((m_points[i] - P).norm2(), m_ids[i]);
+		if (heap.size() < k)
+		{
+			heap.push_back(c);
+			std::push_heap(heap.begin(), heap.end());
+		}
+		else if (c < heap.front())
+		{
+			std::pop_heap(heap.begin(), heap.end());
+			heap.back() = c;
+			std::push_heap(heap.begin(), heap.end());
+		}
+	};
+
+	while (end - begin > LEAF_SIZE)
+	{
+		const unsigned int mid = (begin + end) / 2;
+		const REAL diff = P[m_axis[mid]] - m_points[mid][m_axis[mid]];
+		consider(mid);
+		// near side first (recursion), then far side (loop) if it can still contain better points
+		unsigned int nb, ne, fb, fe;
+		if (diff <= REAL(0)) { nb = begin; ne = mid; fb = mid + 1; fe = end; }
+		else { nb = mid + 1; ne = end; fb = begin; fe = mid; }
+		nearestRange(nb, ne, P, k, heap);
+		if (heap.size() == k && diff * diff > heap.front().first)
+			return;
+		begin = fb;
+		end = fe;
+	}
+	for (unsigned int i = begin; i < end; ++i)
+		consider(i);
+}
+
+template <typename VEC3>
+void KdTree<VEC3>::kNearest(const VEC3& P, unsigned int k, std::vector<unsigned int>& points, std::vector<REAL>& dist2) const
+{
+	points.clear();
+	dist2.clear();
+	if (k == 0)
+		return;
+
+	std::vector< std::pair<REAL, unsigned int> > heap;
+	heap.reserve(k);
+	nearestRange(0, size(), P, k, heap);
+	std::sort_heap(heap.begin(), heap.end());
+
+	points.reserve(heap.size());
+	dist2.reserve(heap.size());
+	for (unsigned int i = 0; i < heap.size(); ++i)
+	{
+		dist2.push_back(heap[i].first);
+		points.push_back(heap[i].second);
+	}
+}
+
+} // namespace Geometry
+
+} // namespace Algo
+
+} // namespace CGoGN
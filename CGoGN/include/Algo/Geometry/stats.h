@@ -25,6 +25,10 @@
 #ifndef STATS_H
 #define STATS_H
 
+#include "Topology/generic/traversor/traversorCell.h"
+#include "Topology/generic/traversor/traversor2.h"
+#include "Topology/generic/reduction.h"
+
 namespace CGoGN
 {
 
@@ -34,110 +38,116 @@ namespace Algo
 namespace Geometry
 {
 
-template <typename PFP>
-void statModele(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position)
+/// accumulators of statModele on faces
+struct StatFaces
 {
-	int nbFaces = 0;
-	int nbVertex = 0;
+	int nbFaces;
+	int nbEdge;
+	float ratioMinMax;
+	float lengthSeg;
+
+	StatFaces() : nbFaces(0), nbEdge(0), ratioMinMax(0), lengthSeg(0) {}
+
+	void combine(const StatFaces& s)
+	{
+		nbFaces += s.nbFaces;
+		nbEdge += s.nbEdge;
+		ratioMinMax += s.ratioMinMax;
+		lengthSeg += s.lengthSeg;
+	}
+};
 
-	CellMarker<typename PFP::MAP, VERTEX> mVertex(map);
+/// accumulators of statModele on vertices
+struct StatVertices
+{
+	int nbVertex;
+	int nbEdgePerVertex;
 
-	float ratioMinMax = 0;
-	int nbEdgePerVertex = 0;
-	float lengthSeg = 0;
-	int nbEdge = 0;
+	StatVertices() : nbVertex(0), nbEdgePerVertex(0) {}
 
-	TraversorF<typename PFP::MAP> tf(map) ;
-	for(Dart d = tf.begin(); d != tf.end(); tf.next(d))
+	void combine(const StatVertices& s)
 	{
-		nbFaces++;
-		bool init = true;
-		float min = 0;
-		float max = 0;
-
-		Traversor2FV<typename PFP::MAP> tfe(map, d) ;
-		for(Dart it = tfe.begin(); it != tfe.end(); it = tfe.next())
-		{
-			typename PFP::VEC3 segment = position[it] - position[map.phi1(it)] ;
-
-			float len = segment.norm() ;
-
-			lengthSeg += len;
-			nbEdge++;
-
-			if (init || len < min)
-				min = len;
-			if (init || len > max)
-				max = len;
-
-			init = false;
-
-			if (!mVertex.isMarked(it))
-			{
-				mVertex.mark(it) ;
-				nbVertex++ ;
-				Traversor2VE<typename PFP::MAP> tve(map, it) ;
-				for(Dart it2 = tve.begin(); it2 != tve.end(); it2 = tve.next())
-					nbEdgePerVertex++ ;
-			}
-		}
-
-		ratioMinMax += (min / max);
+		nbVertex += s.nbVertex;
+		nbEdgePerVertex += s.nbEdgePerVertex;
 	}
+};
+
+/// accumulate the stats of face f in s
+template <typename PFP>
+void statFace(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, StatFaces& s, Face f)
+{
+	s.nbFaces++;
+	bool init = true;
+	float min = 0;
+	float max = 0;
+
+	foreach_incident2<VERTEX>(map, f, [&] (Vertex v)
+	{
+		typename PFP::VEC3 segment = position[v] - position[map.phi1(v.dart)] ;
+
+		float len = segment.norm() ;
+
+		s.lengthSeg += len;
+		s.nbEdge++;
 
-//	for (Dart d = map.begin(); d != map.end(); map.next(d))
-//	{
-//		if (!mFace.isMarked(d))
-//		{
-//			nbFaces++;
-//			bool init = true;
-//			float min = 0;
-//			float max = 0;
-//			Dart e = d;
-//			do
-//			{
-//				mFace.mark(e);
-//				typename PFP::VEC3 segment = position[e] - position[map.phi1(e)] ;
-//
-//				float len = segment.norm() ;
-//
-//				lengthSeg += len;
-//				nbEdge++;
-//
-//				if (init || len < min)
-//					min = len;
-//				if (init || len > max)
-//					max = len;
-//
-//				init = false;
-//				e = map.phi1(e);
-//			}
-//			while (e != d);
-//
-//			ratioMinMax += (min / max);
-//		}
-//
-//		if (!mVertex.isMarked(d))
-//		{
-//			mVertex.mark(d) ;
-//			nbVertex++ ;
-//			Dart e = d;
-//			do
-//			{
-//				nbEdgePerVertex++ ;
-//				e = map.phi2_1(e) ;
-//			}
-//			while (e != d) ;
-//		}
-//	}
-
-	CGoGNout << "number of faces                : " << nbFaces << CGoGNendl;
-	CGoGNout << "number of vertices             : " << nbVertex << CGoGNendl;
-	CGoGNout << "mean ratio min max             : " << (ratioMinMax / (float) nbFaces) << CGoGNendl;
-	CGoGNout << "mean number of edge per vertex : " << ((float) nbEdgePerVertex / (float) nbVertex) << CGoGNendl;
-	CGoGNout << "mean edge length               : " << lengthSeg / (float) nbEdge << CGoGNendl;
+		if (init || len < min)
+			min = len;
+		if (init || len > max)
+			max = len;
+
+		init = false;
+	});
+
+	s.ratioMinMax += (min / max);
 }
 
+/// accumulate the stats of vertex v in s
+template <typename PFP>
+void statVertex(typename PFP::MAP& map, StatVertices& s, Vertex v)
+{
+	s.nbVertex++;
+	foreach_incident2<EDGE>(map, v, [&] (Edge) { s.nbEdgePerVertex++; });
+}
+
+inline void printStatModele(const StatFaces& sf, const StatVertices& sv)
+{
+	CGoGNout << "number of faces                : " << sf.nbFaces << CGoGNendl;
+	CGoGNout << "number of vertices             : " << sv.nbVertex << CGoGNendl;
+	CGoGNout << "mean ratio min max             : " << (sf.ratioMinMax / (float) sf.nbFaces) << CGoGNendl;
+	CGoGNout << "mean number of edge per vertex : " << ((float) sv.nbEdgePerVertex / (float) sv.nbVertex) << CGoGNendl;
+	CGoGNout << "mean edge length               : " << sf.lengthSeg / (float) sf.nbEdge << CGoGNendl;
+}
+
+template <typename PFP>
+void statModele(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position)
+{
+	StatFaces sf;
+	StatVertices sv;
+
+	foreach_cell<FACE>(map, [&] (Face f) { statFace<PFP>(map, position, sf, f); });
+	foreach_cell<VERTEX>(map, [&] (Vertex v) { statVertex<PFP>(map, sv, v); });
+
+	printStatModele(sf, sv);
+}
+
+namespace Parallel
+{
+
+template <typename PFP>
+void statModele(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position)
+{
+	StatFaces sf = CGoGN::Parallel::reduce_cell<FACE>(map, StatFaces(),
+		[&] (StatFaces& s, Face f) { statFace<PFP>(map, position, s, f); },
+		[] (StatFaces& a, const StatFaces& b) { a.combine(b); });
+	StatVertices sv = CGoGN::Parallel::reduce_cell<VERTEX>(map, StatVertices(),
+		[&] (StatVertices& s, Vertex v) { statVertex<PFP>(map, s, v); },
+		[] (StatVertices& a, const StatVertices& b) { a.combine(b); });
+
+	printStatModele(sf, sv);
+}
+
+} // namespace Parallel
+
 } // namespace Geometry
 
 } // namespace Algo
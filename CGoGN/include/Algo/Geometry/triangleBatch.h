@@ -0,0 +1,187 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#ifndef __ALGO_GEOMETRY_TRIANGLE_BATCH_H__
+#define __ALGO_GEOMETRY_TRIANGLE_BATCH_H__
+
+#include "Topology/generic/attributeHandler.h"
+#include "Topology/generic/parallelRange.h"
+
+#include <vector>
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Surface
+{
+
+namespace Geometry
+{
+
+/**
+ * Batch computation of the per vertex / per edge geometry of a triangle mesh.
+ * The topology is extracted once in flat tables (triangles as triples of vertex
+ * indices, vertex -> corners and vertex -> edges tables) and the positions are copied
+ * in separate x, y, z arrays. The kernels then run in parallel over these arrays,
+ * without any traversal or attribute access, and the results are written back in
+ * the attributes of the map.
+ * The results are those of the per vertex functions (computeNormalVertices,
+ * computeVoronoiAreaVertices, computeCotanWeightEdges, computeLaplacianCotanVertices)
+ * up to rounding: the angles are not computed, the cotangents are dot / norm of cross.
+ * After a modification of the positions call setPositions, after a modification
+ * of the topology call build.
+ */
+template <typename PFP>
+class TriangleBatch
+{
+public:
+	typedef typename PFP::MAP MAP;
+	typedef typename PFP::VEC3 VEC3;
+	typedef typename PFP::REAL REAL;
+
+	/// no opposite corner (boundary edge)
+	static const unsigned int NO_CORNER = 0xffffffff;
+
+	/// number of elements processed by a kernel task
+	static const unsigned int BLOCK_SIZE = 1024;
+
+protected:
+	MAP& m_map;
+	bool m_valid;
+
+	/// line of the vertex container of each vertex
+	std::vector<unsigned int> m_vertexLines;
+
+	/// 3 vertices of each triangle (corner c = 3 * triangle + k)
+	std::vector<unsigned int> m_triangles;
+
+	/// corners of each vertex: m_vertexCorners[m_vertexCornerBegin[v] .. m_vertexCornerBegin[v+1][
+	std::vector<unsigned int> m_vertexCornerBegin;
+	std::vector<unsigned int> m_vertexCorners;
+
+	/// a dart of each edge, its 2 vertices and its 2 opposite corners
+	std::vector<Dart> m_edgeDarts;
+	std::vector<unsigned int> m_edgeVertices;
+	std::vector<unsigned int> m_edgeCorners;
+
+	/// edges and neighbours of each vertex (same ranges in both tables)
+	std::vector<unsigned int> m_vertexEdgeBegin;
+	std::vector<unsigned int> m_vertexEdges;
+	std::vector<unsigned int> m_vertexNeighbours;
+
+	/// positions
+	std::vector<REAL> m_x;
+	std::vector<REAL> m_y;
+	std::vector<REAL> m_z;
+
+	/// cross product of the edges of the triangles (twice the area times the normal)
+	std::vector<REAL> m_nx;
+	std::vector<REAL> m_ny;
+	std::vector<REAL> m_nz;
+
+	/// cotangent of the angle, part of the Voronoi area and normal weight of each corner
+	std::vector<REAL> m_cornerCotan;
+	std::vector<REAL> m_cornerArea;
+	std::vector<REAL> m_cornerNormalWeight;
+
+	/// apply f(begin, end) on the blocks of BLOCK_SIZE indices of [0, nb[
+	template <typename FUNC>
+	static void foreachBlock(unsigned int nb, FUNC f, unsigned int nbth);
+
+	/// counting sort of the corners / edge ends by vertex
+	void buildVertexTable(const std::vector<unsigned int>& vertexOf, std::vector<unsigned int>& begin, std::vector<unsigned int>& table);
+
+	void computeCorners(unsigned int nbth);
+
+	void computeEdgeWeights(std::vector<REAL>& weight, unsigned int nbth) const;
+
+	void computeVertexAreas(std::vector<REAL>& area, unsigned int nbth) const;
+
+public:
+	/**
+	 * extract the topology of the (triangle) map
+	 */
+	TriangleBatch(MAP& map, unsigned int nbth = CGoGN::Parallel::NumberOfThreads);
+
+	/**
+	 * extract the topology again (after a modification of the topology)
+	 * @return false if a face is not a triangle
+	 */
+	bool build(unsigned int nbth = CGoGN::Parallel::NumberOfThreads);
+
+	/**
+	 * false if a face of the map is not a triangle (nothing can be computed)
+	 */
+	bool isValid() const { return m_valid; }
+
+	unsigned int nbVertices() const { return (unsigned int)(m_vertexLines.size()); }
+
+	unsigned int nbTriangles() const { return (unsigned int)(m_triangles.size() / 3); }
+
+	unsigned int nbEdges() const { return (unsigned int)(m_edgeDarts.size()); }
+
+	/**
+	 * copy the positions and compute the geometry of the triangles
+	 * (to be called before the compute functions and after each modification of the positions)
+	 */
+	void setPositions(const VertexAttribute<VEC3, MAP>& position, unsigned int nbth = CGoGN::Parallel::NumberOfThreads);
+
+	/**
+	 * normals of the vertices (as computeNormalVertices)
+	 */
+	void computeNormalVertices(VertexAttribute<VEC3, MAP>& normal, unsigned int nbth = CGoGN::Parallel::NumberOfThreads) const;
+
+	/**
+	 * mixed Voronoi areas of the vertices (as computeVoronoiAreaVertices)
+	 */
+	void computeVoronoiAreaVertices(VertexAttribute<REAL, MAP>& area, unsigned int nbth = CGoGN::Parallel::NumberOfThreads) const;
+
+	/**
+	 * cotangent weights of the edges (as computeCotanWeightEdges)
+	 */
+	void computeCotanWeightEdges(EdgeAttribute<REAL, MAP>& edgeWeight, unsigned int nbth = CGoGN::Parallel::NumberOfThreads) const;
+
+	/**
+	 * cotangent Laplacian of attr (as computeLaplacianCotanVertices with the weights
+	 * of computeCotanWeightEdges and the areas of computeVoronoiAreaVertices)
+	 */
+	template <typename ATTR_TYPE>
+	void computeLaplacianCotanVertices(const VertexAttribute<ATTR_TYPE, MAP>& attr, VertexAttribute<ATTR_TYPE, MAP>& laplacian, unsigned int nbth = CGoGN::Parallel::NumberOfThreads) const;
+};
+
+} // namespace Geometry
+
+} // namespace Surface
+
+} // namespace Algo
+
+} // namespace CGoGN
+
+#include "Algo/Geometry/triangleBatch.hpp"
+
+#endif
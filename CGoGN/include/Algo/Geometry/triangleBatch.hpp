@@ -0,0 +1,388 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include "Topology/generic/traversor/traversorCell.h"
+#include "Utils/cgognStream.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Surface
+{
+
+namespace Geometry
+{
+
+template <typename PFP>
+template <typename FUNC>
+void TriangleBatch<PFP>::foreachBlock(unsigned int nb, FUNC f, unsigned int nbth)
+{
+	unsigned int nbBlocks = (nb + BLOCK_SIZE - 1) / BLOCK_SIZE;
+	CGoGN::Parallel::foreach_index(nbBlocks, [&] (unsigned int block, unsigned int)
+	{
+		unsigned int b = block * BLOCK_SIZE;
+		f(b, std::min(b + BLOCK_SIZE, nb));
+	}, nbth);
+}
+
+template <typename PFP>
+TriangleBatch<PFP>::TriangleBatch(MAP& map, unsigned int nbth) :
+	m_map(map),
+	m_valid(false)
+{
+	build(nbth);
+}
+
+template <typename PFP>
+void TriangleBatch<PFP>::buildVertexTable(const std::vector<unsigned int>& vertexOf, std::vector<unsigned int>& begin, std::vector<unsigned int>& table)
+{
+	unsigned int nbV = nbVertices();
+	begin.assign(nbV + 1, 0);
+	for (std::vector<unsigned int>::const_iterator it = vertexOf.begin(); it != vertexOf.end(); ++it)
+		++begin[*it + 1];
+	for (unsigned int v = 0; v < nbV; ++v)
+		begin[v + 1] += begin[v];
+
+	std::vector<unsigned int> pos(begin.begin(), begin.end() - 1);
+	table.resize(vertexOf.size());
+	for (unsigned int i = 0; i < vertexOf.size(); ++i)
+		table[pos[vertexOf[i]]++] = i;
+}
+
+template <typename PFP>
+bool TriangleBatch<PFP>::build(unsigned int nbth)
+{
+	m_valid = true;
+	m_vertexLines.clear();
+	m_triangles.clear();
+	m_edgeDarts.clear();
+	m_edgeVertices.clear();
+	m_edgeCorners.clear();
+
+	// vertices: used lines of the vertex container
+	const AttributeContainer& vCont = m_map.template getAttributeContainer<VERTEX>();
+	std::vector<unsigned int> vertexIndex(vCont.realEnd(), NO_CORNER);
+	for (unsigned int i = vCont.begin(); i != vCont.end(); vCont.next(i))
+	{
+		vertexIndex[i] = (unsigned int)(m_vertexLines.size());
+		m_vertexLines.push_back(i);
+	}
+
+	// triangles: corners in order d, phi1(d), phi_1(d)
+	std::vector<unsigned int> cornerOfDart(m_map.template getAttributeContainer<DART>().realEnd(), NO_CORNER);
+	std::vector<Dart> cornerDarts;
+	foreach_cell_until<FACE>(m_map, [&] (Face f) -> bool
+	{
+		Dart d[3] = { f.dart, m_map.phi1(f.dart), m_map.phi_1(f.dart) };
+		if (m_map.phi1(d[1]) != d[2])
+		{
+			m_valid = false;
+			return false;
+		}
+		for (unsigned int k = 0; k < 3; ++k)
+		{
+			cornerOfDart[m_map.dartIndex(d[k])] = (unsigned int)(cornerDarts.size());
+			cornerDarts.push_back(d[k]);
+			m_triangles.push_back(vertexIndex[m_map.template getEmbedding<VERTEX>(d[k])]);
+		}
+		return true;
+	});
+
+	if (!m_valid)
+	{
+		CGoGNerr << "TriangleBatch: the map has faces that are not triangles" << CGoGNendl;
+		m_vertexLines.clear();
+		m_triangles.clear();
+		return false;
+	}
+
+	// edges: the edge of dart d of corner c is opposite to the previous corner of c
+	unsigned int nbC = (unsigned int)(cornerDarts.size());
+	for (unsigned int c = 0; c < nbC; ++c)
+	{
+		unsigned int c2 = cornerOfDart[m_map.dartIndex(m_map.phi2(cornerDarts[c]))];
+		if (c2 == NO_CORNER || c < c2)
+		{
+			unsigned int t = c - c % 3;
+			m_edgeDarts.push_back(cornerDarts[c]);
+			m_edgeVertices.push_back(m_triangles[c]);
+			m_edgeVertices.push_back(m_triangles[t + (c + 1) % 3]);
+			m_edgeCorners.push_back(t + (c + 2) % 3);
+			m_edgeCorners.push_back(c2 == NO_CORNER ? NO_CORNER : c2 - c2 % 3 + (c2 + 2) % 3);
+		}
+	}
+
+	buildVertexTable(m_triangles, m_vertexCornerBegin, m_vertexCorners);
+
+	std::vector<unsigned int> edgeEnds;
+	buildVertexTable(m_edgeVertices, m_vertexEdgeBegin, edgeEnds);
+	m_vertexEdges.resize(edgeEnds.size());
+	m_vertexNeighbours.resize(edgeEnds.size());
+	foreachBlock((unsigned int)(edgeEnds.size()), [&] (unsigned int b, unsigned int e)
+	{
+		for (unsigned int i = b; i < e; ++i)
+		{
+			m_vertexEdges[i] = edgeEnds[i] / 2;
+			m_vertexNeighbours[i] = m_edgeVertices[edgeEnds[i] ^ 1];
+		}
+	}, nbth);
+
+	return true;
+}
+
+template <typename PFP>
+void TriangleBatch<PFP>::setPositions(const VertexAttribute<VEC3, MAP>& position, unsigned int nbth)
+{
+	unsigned int nbV = nbVertices();
+	m_x.resize(nbV);
+	m_y.resize(nbV);
+	m_z.resize(nbV);
+	foreachBlock(nbV, [&] (unsigned int b, unsigned int e)
+	{
+		for (unsigned int v = b; v < e; ++v)
+		{
+			const VEC3& p = position[m_vertexLines[v]];
+			m_x[v] = p[0];
+			m_y[v] = p[1];
+			m_z[v] = p[2];
+		}
+	}, nbth);
+
+	computeCorners(nbth);
+}
+
+template <typename PFP>
+void TriangleBatch<PFP>::computeCorners(unsigned int nbth)
+{
+	unsigned int nbT = nbTriangles();
+	m_nx.resize(nbT);
+	m_ny.resize(nbT);
+	m_nz.resize(nbT);
+	m_cornerCotan.resize(3 * nbT);
+	m_cornerArea.resize(3 * nbT);
+	m_cornerNormalWeight.resize(3 * nbT);
+	if (nbT == 0)
+		return;
+
+	const unsigned int* tri = &m_triangles[0];
+	const REAL* x = &m_x[0];
+	const REAL* y = &m_y[0];
+	const REAL* z = &m_z[0];
+	REAL* nx = &m_nx[0];
+	REAL* ny = &m_ny[0];
+	REAL* nz = &m_nz[0];
+	REAL* cotan = &m_cornerCotan[0];
+	REAL* area = &m_cornerArea[0];
+	REAL* normalWeight = &m_cornerNormalWeight[0];
+
+	foreachBlock(nbT, [&] (unsigned int b, unsigned int e)
+	{
+		for (unsigned int t = b; t < e; ++t)
+		{
+			unsigned int i0 = tri[3 * t];
+			unsigned int i1 = tri[3 * t + 1];
+			unsigned int i2 = tri[3 * t + 2];
+
+			// edges p0p1, p0p2, p1p2
+			REAL ax = x[i1] - x[i0], ay = y[i1] - y[i0], az = z[i1] - z[i0];
+			REAL bx = x[i2] - x[i0], by = y[i2] - y[i0], bz = z[i2] - z[i0];
+			REAL cx = x[i2] - x[i1], cy = y[i2] - y[i1], cz = z[i2] - z[i1];
+
+			REAL n[3] = { ay * bz - az * by, az * bx - ax * bz, ax * by - ay * bx };
+			nx[t] = n[0];
+			ny[t] = n[1];
+			nz[t] = n[2];
+			REAL doubleArea = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+
+			REAL la = ax * ax + ay * ay + az * az;
+			REAL lb = bx * bx + by * by + bz * bz;
+			REAL lc = cx * cx + cy * cy + cz * cz;
+
+			// dot products of the edges of each corner
+			REAL d0 = ax * bx + ay * by + az * bz;
+			REAL d1 = -(ax * cx + ay * cy + az * cz);
+			REAL d2 = bx * cx + by * cy + bz * cz;
+
+			REAL cot0 = d0 / doubleArea;
+			REAL cot1 = d1 / doubleArea;
+			REAL cot2 = d2 / doubleArea;
+			cotan[3 * t] = cot0;
+			cotan[3 * t + 1] = cot1;
+			cotan[3 * t + 2] = cot2;
+
+			// mixed Voronoi area (Meyer et al.)
+			if (d0 < 0 || d1 < 0 || d2 < 0)
+			{
+				REAL quarter = doubleArea / 8;
+				area[3 * t] = d0 < 0 ? 2 * quarter : quarter;
+				area[3 * t + 1] = d1 < 0 ? 2 * quarter : quarter;
+				area[3 * t + 2] = d2 < 0 ? 2 * quarter : quarter;
+			}
+			else
+			{
+				area[3 * t] = (la * cot2 + lb * cot1) / 8;
+				area[3 * t + 1] = (lc * cot0 + la * cot2) / 8;
+				area[3 * t + 2] = (lb * cot1 + lc * cot0) / 8;
+			}
+
+			// normal n / |n| weighted by area / product of the squared lengths of the edges of the corner
+			REAL l0 = la * lb;
+			REAL l1 = la * lc;
+			REAL l2 = lb * lc;
+			normalWeight[3 * t] = l0 > 0 ? REAL(0.5) / l0 : REAL(0);
+			normalWeight[3 * t + 1] = l1 > 0 ? REAL(0.5) / l1 : REAL(0);
+			normalWeight[3 * t + 2] = l2 > 0 ? REAL(0.5) / l2 : REAL(0);
+		}
+	}, nbth);
+}
+
+template <typename PFP>
+void TriangleBatch<PFP>::computeEdgeWeights(std::vector<REAL>& weight, unsigned int nbth) const
+{
+	unsigned int nbE = nbEdges();
+	weight.resize(nbE);
+	foreachBlock(nbE, [&] (unsigned int b, unsigned int e)
+	{
+		for (unsigned int i = b; i < e; ++i)
+		{
+			unsigned int c2 = m_edgeCorners[2 * i + 1];
+			REAL w = m_cornerCotan[m_edgeCorners[2 * i]];
+			if (c2 != NO_CORNER)
+				w += m_cornerCotan[c2];
+			weight[i] = REAL(0.5) * w;
+		}
+	}, nbth);
+}
+
+template <typename PFP>
+void TriangleBatch<PFP>::computeVertexAreas(std::vector<REAL>& area, unsigned int nbth) const
+{
+	unsigned int nbV = nbVertices();
+	area.resize(nbV);
+	foreachBlock(nbV, [&] (unsigned int b, unsigned int e)
+	{
+		for (unsigned int v = b; v < e; ++v)
+		{
+			REAL a = 0;
+			for (unsigned int i = m_vertexCornerBegin[v]; i < m_vertexCornerBegin[v + 1]; ++i)
+				a += m_cornerArea[m_vertexCorners[i]];
+			area[v] = a;
+		}
+	}, nbth);
+}
+
+template <typename PFP>
+void TriangleBatch<PFP>::computeNormalVertices(VertexAttribute<VEC3, MAP>& normal, unsigned int nbth) const
+{
+	foreachBlock(nbVertices(), [&] (unsigned int b, unsigned int e)
+	{
+		for (unsigned int v = b; v < e; ++v)
+		{
+			VEC3 N(0);
+			for (unsigned int i = m_vertexCornerBegin[v]; i < m_vertexCornerBegin[v + 1]; ++i)
+			{
+				unsigned int c = m_vertexCorners[i];
+				unsigned int t = c / 3;
+				REAL w = m_cornerNormalWeight[c];
+				N += VEC3(w * m_nx[t], w * m_ny[t], w * m_nz[t]);
+			}
+			N.normalize();
+			normal[m_vertexLines[v]] = N;
+		}
+	}, nbth);
+}
+
+template <typename PFP>
+void TriangleBatch<PFP>::computeVoronoiAreaVertices(VertexAttribute<REAL, MAP>& area, unsigned int nbth) const
+{
+	std::vector<REAL> a;
+	computeVertexAreas(a, nbth);
+	foreachBlock(nbVertices(), [&] (unsigned int b, unsigned int e)
+	{
+		for (unsigned int v = b; v < e; ++v)
+			area[m_vertexLines[v]] = a[v];
+	}, nbth);
+}
+
+template <typename PFP>
+void TriangleBatch<PFP>::computeCotanWeightEdges(EdgeAttribute<REAL, MAP>& edgeWeight, unsigned int nbth) const
+{
+	std::vector<REAL> w;
+	computeEdgeWeights(w, nbth);
+	foreachBlock(nbEdges(), [&] (unsigned int b, unsigned int e)
+	{
+		for (unsigned int i = b; i < e; ++i)
+			edgeWeight[m_edgeDarts[i]] = w[i];
+	}, nbth);
+}
+
+template <typename PFP>
+template <typename ATTR_TYPE>
+void TriangleBatch<PFP>::computeLaplacianCotanVertices(const VertexAttribute<ATTR_TYPE, MAP>& attr, VertexAttribute<ATTR_TYPE, MAP>& laplacian, unsigned int nbth) const
+{
+	std::vector<REAL> weight;
+	computeEdgeWeights(weight, nbth);
+	std::vector<REAL> area;
+	computeVertexAreas(area, nbth);
+
+	unsigned int nbV = nbVertices();
+	std::vector<ATTR_TYPE> value(nbV);
+	foreachBlock(nbV, [&] (unsigned int b, unsigned int e)
+	{
+		for (unsigned int v = b; v < e; ++v)
+			value[v] = attr[m_vertexLines[v]];
+	}, nbth);
+
+	foreachBlock(nbV, [&] (unsigned int b, unsigned int e)
+	{
+		for (unsigned int v = b; v < e; ++v)
+		{
+			ATTR_TYPE l(0);
+			REAL wSum = 0;
+			for (unsigned int i = m_vertexEdgeBegin[v]; i < m_vertexEdgeBegin[v + 1]; ++i)
+			{
+				REAL w = weight[m_vertexEdges[i]] / area[v];
+				l += (value[m_vertexNeighbours[i]] - value[v]) * w;
+				wSum += w;
+			}
+			l /= wSum;
+			laplacian[m_vertexLines[v]] = l;
+		}
+	}, nbth);
+}
+
+} // namespace Geometry
+
+} // namespace Surface
+
+} // namespace Algo
+
+} // namespace CGoGN
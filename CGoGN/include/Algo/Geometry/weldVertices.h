@@ -0,0 +1,107 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#ifndef __ALGO_GEOMETRY_WELD_VERTICES_H__
+#define __ALGO_GEOMETRY_WELD_VERTICES_H__
+
+#include "Geometry/bounding_box.h"
+#include "Topology/generic/attributeHandler.h"
+#include "Topology/generic/parallelRange.h"
+
+#include <vector>
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Geometry
+{
+
+/**
+ * Weld the points that are closer than epsilon (transitively).
+ * The points are sorted (in parallel) by the key of their cell in a grid of cells
+ * of size epsilon/sqrt(3), so that the points of a cell are all welded together,
+ * then each cell is compared with its neighbours (a cell stops as soon as one pair
+ * of points is welded) and the welds are merged with a union-find.
+ * The cell size only depends on epsilon (no fixed resolution, no memory per empty cell);
+ * it is enlarged if the bounding box does not fit in 2^30 cells by axis.
+ * With epsilon = 0 only equal points are welded.
+ * @param nbPoints number of points
+ * @param point point(i) returns the position of the i-th point
+ * @param epsilon welding distance
+ * @param representative representative[i] is the smallest index of the points welded with i
+ * @param nbth number of used threads
+ * @return the number of points that are not their own representative
+ */
+template <typename VEC3, typename POINT_FN>
+unsigned int weldPoints(unsigned int nbPoints, POINT_FN point, typename VEC3::DATA_TYPE epsilon, std::vector<unsigned int>& representative, unsigned int nbth = CGoGN::Parallel::NumberOfThreads);
+
+/**
+ * Weld the values of a vertex attribute (all used lines of the container)
+ * @param representative representative[line] is the smallest line welded with line (EMBNULL for unused lines)
+ * @return the number of lines that are not their own representative
+ */
+template <typename PFP>
+unsigned int weldPoints(const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, typename PFP::REAL epsilon, std::vector<unsigned int>& representative, unsigned int nbth = CGoGN::Parallel::NumberOfThreads);
+
+/**
+ * Find all the pairs of points closer than epsilon (equal points if epsilon is 0)
+ * with the grid of weldPoints: the cost is linear in the number of points and of pairs
+ * @param pairs the pairs (i,j) with i < j, sorted
+ */
+template <typename VEC3, typename POINT_FN>
+void closePairs(unsigned int nbPoints, POINT_FN point, typename VEC3::DATA_TYPE epsilon, std::vector< std::pair<unsigned int, unsigned int> >& pairs, unsigned int nbth = CGoGN::Parallel::NumberOfThreads);
+
+} // namespace Geometry
+
+namespace Surface
+{
+
+namespace Geometry
+{
+
+/**
+ * Weld the close vertices of an existing surface map: the boundary edges whose
+ * ends are welded (closer than epsilon) are sewn two by two.
+ * Vertices that only touch (no pair of boundary edges to sew) are left unchanged,
+ * so the map stays a 2-manifold.
+ * @return the number of sewn edges
+ */
+template <typename PFP>
+unsigned int weldVertices(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, typename PFP::REAL epsilon, unsigned int nbth = CGoGN::Parallel::NumberOfThreads);
+
+} // namespace Geometry
+
+} // namespace Surface
+
+} // namespace Algo
+
+} // namespace CGoGN
+
+#include "Algo/Geometry/weldVertices.hpp"
+
+#endif
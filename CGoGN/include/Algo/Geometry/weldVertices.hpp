@@ -0,0 +1,426 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include <cmath>
+#include <algorithm>
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Geometry
+{
+
+/// point in a cell of the welding grid (ordered by cell then by point)
+struct WeldCellPoint
+{
+	int x, y, z;
+	unsigned int point;
+
+	inline bool sameCell(const WeldCellPoint& c) const
+	{
+		return (x == c.x) && (y == c.y) && (z == c.z);
+	}
+
+	inline bool cellLess(const WeldCellPoint& c) const
+	{
+		if (x != c.x) return x < c.x;
+		if (y != c.y) return y < c.y;
+		return z < c.z;
+	}
+
+	inline bool operator<(const WeldCellPoint& c) const
+	{
+		if (!sameCell(c))
+			return cellLess(c);
+		return point < c.point;
+	}
+};
+
+/**
+ * points sorted (in parallel) by cell of a uniform grid
+ */
+template <typename VEC3>
+struct WeldGrid
+{
+	typedef typename VEC3::DATA_TYPE REAL;
+
+	VEC3 origin;
+	REAL cellSize;
+	/// all the points of a cell are closer than epsilon
+	bool cellsWithinEpsilon;
+	/// number of cells to look at around a cell in each direction
+	int range;
+
+	std::vector<WeldCellPoint> cellPoints;
+	/// index in cellPoints of the first point of each cell (+ end)
+	std::vector<unsigned int> cellBegin;
+
+	inline unsigned int nbCells() const { return (unsigned int)(cellBegin.size()) - 1; }
+
+	/**
+	 * cells of diagonal epsilon, enlarged if the bounding box does not fit in 2^30 cells by axis
+	 * (epsilon = 0: only the points of a same cell are compared)
+	 */
+	template <typename POINT_FN>
+	void build(unsigned int nbPoints, POINT_FN& point, REAL epsilon, unsigned int nbth)
+	{
+		typedef Geom::BoundingBox<VEC3> BB;
+
+		// bounding box: one per task
+		std::vector<BB> bbs(CGoGN::Parallel::nbTasksOfRange(nbPoints, nbth));
+		CGoGN::Parallel::foreach_index(nbPoints, [&] (unsigned int i, unsigned int task)
+		{
+			bbs[task].addPoint(point(i));
+		}, nbth);
+		BB bb = bbs[0];
+		for (unsigned int i = 1; i < bbs.size(); ++i)
+			bb.fusion(bbs[i]);
+
+		origin = bb.min();
+		cellSize = epsilon / std::sqrt(REAL(3));
+		cellsWithinEpsilon = epsilon > REAL(0);
+		const REAL maxCells = REAL(1 << 30);
+		if (!(cellSize * maxCells > bb.maxSize()))
+		{
+			cellSize = bb.maxSize() / maxCells;
+			if (!(cellSize > REAL(0)))
+				cellSize = REAL(1);
+			cellsWithinEpsilon = false;
+		}
+		range = int(std::ceil(epsilon / cellSize));
+
+		cellPoints.resize(nbPoints);
+		CGoGN::Parallel::foreach_index(nbPoints, [&] (unsigned int i, unsigned int)
+		{
+			VEC3 P = point(i) - origin;
+			WeldCellPoint& cp = cellPoints[i];
+			cp.x = int(std::floor(P[0] / cellSize));
+			cp.y = int(std::floor(P[1] / cellSize));
+			cp.z = int(std::floor(P[2] / cellSize));
+			cp.point = i;
+		}, nbth);
+		CGoGN::Parallel::sort(cellPoints, nbth);
+
+		cellBegin.clear();
+		cellBegin.reserve(nbPoints / 2 + 2);
+		cellBegin.push_back(0);
+		for (unsigned int i = 1; i < nbPoints; ++i)
+		{
+			if (!cellPoints[i].sameCell(cellPoints[i - 1]))
+				cellBegin.push_back(i);
+		}
+		cellBegin.push_back(nbPoints);
+	}
+
+	/**
+	 * apply func(n) on each non empty cell n that follows cell c in the cell order
+	 * and is at most range cells away in each direction
+	 */
+	template <typename FUNC>
+	void foreach_next_neighbour(unsigned int c, FUNC func) const
+	{
+		const unsigned int nbc = nbCells();
+		const WeldCellPoint& cell = cellPoints[cellBegin[c]];
+		WeldCellPoint neighbour;
+		for (int dx = 0; dx <= range; ++dx)
+		{
+			for (int dy = (dx == 0) ? 0 : -range; dy <= range; ++dy)
+			{
+				for (int dz = (dx == 0 && dy == 0) ? 1 : -range; dz <= range; ++dz)
+				{
+					neighbour.x = cell.x + dx;
+					neighbour.y = cell.y + dy;
+					neighbour.z = cell.z + dz;
+					std::vector<unsigned int>::const_iterator it = std::lower_bound(cellBegin.begin(), cellBegin.begin() + nbc, neighbour,
+						[&] (unsigned int first, const WeldCellPoint& n) { return cellPoints[first].cellLess(n); });
+					if ((it != cellBegin.begin() + nbc) && cellPoints[*it].sameCell(neighbour))
+						func((unsigned int)(it - cellBegin.begin()));
+				}
+			}
+		}
+	}
+};
+
+/// epsilon = 0: equal points
+template <typename VEC3>
+inline bool weldNear(const VEC3& P, const VEC3& Q, typename VEC3::DATA_TYPE epsilon)
+{
+	if (epsilon > typename VEC3::DATA_TYPE(0))
+	{
+		VEC3 D = Q - P;
+		return D * D < epsilon * epsilon;
+	}
+	return P == Q;
+}
+
+template <typename VEC3, typename POINT_FN>
+unsigned int weldPoints(unsigned int nbPoints, POINT_FN point, typename VEC3::DATA_TYPE epsilon, std::vector<unsigned int>& representative, unsigned int nbth)
+{
+	representative.resize(nbPoints);
+	for (unsigned int i = 0; i < nbPoints; ++i)
+		representative[i] = i;
+
+	if ((nbPoints < 2) || (epsilon < typename VEC3::DATA_TYPE(0)))
+		return 0;
+
+	WeldGrid<VEC3> grid;
+	grid.build(nbPoints, point, epsilon, nbth);
+	const std::vector<WeldCellPoint>& cellPoints = grid.cellPoints;
+	const std::vector<unsigned int>& cellBegin = grid.cellBegin;
+	const unsigned int nbCells = grid.nbCells();
+
+	// pairs of welded points found between cells (and in cells if they are too large), one vector per task
+	std::vector< std::vector< std::pair<unsigned int, unsigned int> > > links(CGoGN::Parallel::nbTasksOfRange(nbCells, nbth));
+	CGoGN::Parallel::foreach_index(nbCells, [&] (unsigned int c, unsigned int task)
+	{
+		std::vector< std::pair<unsigned int, unsigned int> >& taskLinks = links[task];
+		const unsigned int b = cellBegin[c];
+		const unsigned int e = cellBegin[c + 1];
+
+		if (!grid.cellsWithinEpsilon)
+		{
+			for (unsigned int i = b; i < e; ++i)
+			{
+				for (unsigned int j = i + 1; j < e; ++j)
+				{
+					if (weldNear(point(cellPoints[i].point), point(cellPoints[j].point), epsilon))
+						taskLinks.push_back(std::make_pair(cellPoints[i].point, cellPoints[j].point));
+				}
+			}
+		}
+
+		grid.foreach_next_neighbour(c, [&] (unsigned int n)
+		{
+			bool found = false;
+			for (unsigned int i = b; (i < e) && !found; ++i)
+			{
+				for (unsigned int j = cellBegin[n]; (j < cellBegin[n + 1]) && !found; ++j)
+				{
+					if (weldNear(point(cellPoints[i].point), point(cellPoints[j].point), epsilon))
+					{
+						taskLinks.push_back(std::make_pair(cellPoints[i].point, cellPoints[j].point));
+						// all the points of both cells are now welded
+						found = grid.cellsWithinEpsilon;
+					}
+				}
+			}
+		});
+	}, nbth);
+
+	// union-find, the root of a set is its smallest point
+	std::vector<unsigned int>& parent = representative;
+	auto find = [&] (unsigned int i) -> unsigned int
+	{
+		while (parent[i] != i)
+		{
+			parent[i] = parent[parent[i]];
+			i = parent[i];
+		}
+		return i;
+	};
+	auto unite = [&] (unsigned int a, unsigned int b)
+	{
+		a = find(a);
+		b = find(b);
+		if (a < b)
+			parent[b] = a;
+		else if (b < a)
+			parent[a] = b;
+	};
+
+	if (grid.cellsWithinEpsilon)
+	{
+		// the first point of a cell is the smallest one
+		for (unsigned int c = 0; c < nbCells; ++c)
+		{
+			for (unsigned int i = cellBegin[c] + 1; i < cellBegin[c + 1]; ++i)
+				unite(cellPoints[cellBegin[c]].point, cellPoints[i].point);
+		}
+	}
+	for (unsigned int t = 0; t < links.size(); ++t)
+	{
+		for (std::vector< std::pair<unsigned int, unsigned int> >::const_iterator it = links[t].begin(); it != links[t].end(); ++it)
+			unite(it->first, it->second);
+	}
+
+	unsigned int nbWelded = 0;
+	for (unsigned int i = 0; i < nbPoints; ++i)
+	{
+		representative[i] = find(i);
+		if (representative[i] != i)
+			++nbWelded;
+	}
+	return nbWelded;
+}
+
+template <typename VEC3, typename POINT_FN>
+void closePairs(unsigned int nbPoints, POINT_FN point, typename VEC3::DATA_TYPE epsilon, std::vector< std::pair<unsigned int, unsigned int> >& pairs, unsigned int nbth)
+{
+	pairs.clear();
+	if ((nbPoints < 2) || (epsilon < typename VEC3::DATA_TYPE(0)))
+		return;
+
+	WeldGrid<VEC3> grid;
+	grid.build(nbPoints, point, epsilon, nbth);
+	const std::vector<WeldCellPoint>& cellPoints = grid.cellPoints;
+	const std::vector<unsigned int>& cellBegin = grid.cellBegin;
+	const unsigned int nbCells = grid.nbCells();
+
+	std::vector< std::vector< std::pair<unsigned int, unsigned int> > > taskPairs(CGoGN::Parallel::nbTasksOfRange(nbCells, nbth));
+	CGoGN::Parallel::foreach_index(nbCells, [&] (unsigned int c, unsigned int task)
+	{
+		std::vector< std::pair<unsigned int, unsigned int> >& tp = taskPairs[task];
+		const unsigned int b = cellBegin[c];
+		const unsigned int e = cellBegin[c + 1];
+
+		auto test = [&] (unsigned int i, unsigned int j)
+		{
+			unsigned int p = cellPoints[i].point;
+			unsigned int q = cellPoints[j].point;
+			if (grid.cellsWithinEpsilon && (i >= b) && (i < e) && (j >= b) && (j < e))
+				tp.push_back(std::make_pair(p, q));
+			else if (weldNear(point(p), point(q), epsilon))
+				tp.push_back(std::make_pair(std::min(p, q), std::max(p, q)));
+		};
+
+		for (unsigned int i = b; i < e; ++i)
+			for (unsigned int j = i + 1; j < e; ++j)
+				test(i, j);
+
+		grid.foreach_next_neighbour(c, [&] (unsigned int n)
+		{
+			for (unsigned int i = b; i < e; ++i)
+				for (unsigned int j = cellBegin[n]; j < cellBegin[n + 1]; ++j)
+					test(i, j);
+		});
+	}, nbth);
+
+	for (unsigned int t = 0; t < taskPairs.size(); ++t)
+		pairs.insert(pairs.end(), taskPairs[t].begin(), taskPairs[t].end());
+	CGoGN::Parallel::sort(pairs, nbth);
+}
+
+template <typename PFP>
+unsigned int weldPoints(const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, typename PFP::REAL epsilon, std::vector<unsigned int>& representative, unsigned int nbth)
+{
+	std::vector<unsigned int> lines;
+	for (unsigned int i = position.begin(); i != position.end(); position.next(i))
+		lines.push_back(i);
+
+	std::vector<unsigned int> rep;
+	unsigned int nbWelded = weldPoints<typename PFP::VEC3>((unsigned int)(lines.size()), [&] (unsigned int i) -> const typename PFP::VEC3&
+	{
+		return position[lines[i]];
+	}, epsilon, rep, nbth);
+
+	representative.assign(position.end(), EMBNULL);
+	for (unsigned int i = 0; i < lines.size(); ++i)
+		representative[lines[i]] = lines[rep[i]];
+
+	return nbWelded;
+}
+
+} // namespace Geometry
+
+namespace Surface
+{
+
+namespace Geometry
+{
+
+template <typename PFP>
+unsigned int weldVertices(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, typename PFP::REAL epsilon, unsigned int nbth)
+{
+	std::vector<unsigned int> representative;
+	if (Algo::Geometry::weldPoints<PFP>(position, epsilon, representative, nbth) == 0)
+		return 0;
+
+	// boundary edges (inner dart) with the welded vertices of their ends
+	struct BoundaryEdge
+	{
+		unsigned int v1, v2;	// ordered ends
+		bool reversed;			// dart goes from v2 to v1
+		Dart d;
+		bool operator<(const BoundaryEdge& e) const
+		{
+			if (v1 != e.v1) return v1 < e.v1;
+			if (v2 != e.v2) return v2 < e.v2;
+			return d.index < e.d.index;
+		}
+	};
+
+	std::vector<BoundaryEdge> edges;
+	for (Dart d = map.begin(); d != map.end(); map.next(d))
+	{
+		if (map.template isBoundaryMarked<2>(d) || !map.template isBoundaryMarked<2>(map.phi2(d)))
+			continue;
+		unsigned int a = representative[map.template getEmbedding<VERTEX>(d)];
+		unsigned int b = representative[map.template getEmbedding<VERTEX>(map.phi1(d))];
+		if (a == b)
+			continue;
+		BoundaryEdge e;
+		e.v1 = std::min(a, b);
+		e.v2 = std::max(a, b);
+		e.reversed = b < a;
+		e.d = d;
+		edges.push_back(e);
+	}
+	CGoGN::Parallel::sort(edges, nbth);
+
+	// sew the edges of opposite directions two by two
+	unsigned int nbSewn = 0;
+	unsigned int i = 0;
+	while (i < edges.size())
+	{
+		unsigned int j = i;
+		while ((j < edges.size()) && (edges[j].v1 == edges[i].v1) && (edges[j].v2 == edges[i].v2))
+			++j;
+
+		std::vector<Dart> forward;
+		std::vector<Dart> backward;
+		for (unsigned int k = i; k < j; ++k)
+			(edges[k].reversed ? backward : forward).push_back(edges[k].d);
+
+		for (unsigned int k = 0; k < std::min(forward.size(), backward.size()); ++k)
+		{
+			map.sewFaces(forward[k], backward[k]);
+			++nbSewn;
+		}
+		i = j;
+	}
+
+	return nbSewn;
+}
+
+} // namespace Geometry
+
+} // namespace Surface
+
+} // namespace Algo
+
+} // namespace CGoGN
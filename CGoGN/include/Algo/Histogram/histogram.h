@@ -54,6 +54,19 @@ namespace Algo
 namespace Histogram
 {
 
+class Histogram;
+
+namespace Parallel
+{
+
+/**
+ * compute the histogram with given number of classes,
+ * the class counting is shared between the threads
+ */
+CGoGN_ALGO_API void populateHisto(Histogram& histo, unsigned int nbclasses = 0);
+
+} // namespace Parallel
+
 class CGoGN_ALGO_API HistoColorMap
 {
 protected:
@@ -185,6 +198,14 @@ class CGoGN_ALGO_API Histogram
 	/// update quantiles height from histo area for correct superposition
 	void quantilesAreaCorrection();
 
+	/// set the number of classes and their width
+	void initClasses(unsigned int nbclasses);
+
+	/// update max bar and quantiles once populations are computed
+	void updatePopulations();
+
+	friend void Parallel::populateHisto(Histogram& histo, unsigned int nbclasses);
+
 public:
 	/**
 	* create an histogram from attribute handler
@@ -43,6 +43,19 @@ namespace Surface
 namespace Import 
 {
 
+/**
+* build the map of the faces of a table
+* The faces without their degenerated edges are stored in an offset table, the darts are
+* embedded in parallel and the phi2 links are found in parallel by sorting the half-edges by edge
+* (no incident darts vector per vertex).
+* @param map the map in which the function imports the mesh
+* @param mts the table of faces
+* @param nbth number of used threads
+* @return a boolean indicating if import was successful
+*/
+template <typename PFP>
+bool importMesh(typename PFP::MAP& map, MeshTablesSurface<PFP>& mts, unsigned int nbth = CGoGN::Parallel::NumberOfThreads);
+
 /**
 * import a mesh
 * @param map the map in which the function imports the mesh
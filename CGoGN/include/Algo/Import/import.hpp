@@ -27,6 +27,7 @@
 #include "Container/fakeAttribute.h"
 #include "Algo/Modelisation/polyhedron.h"
 #include "Algo/Topo/basic.h"
+#include "Topology/generic/parallelRange.h"
 
 namespace CGoGN
 {
@@ -41,101 +42,169 @@ namespace Import
 {
 
 template <typename PFP>
-bool importMesh(typename PFP::MAP& map, MeshTablesSurface<PFP>& mts)
+bool importMesh(typename PFP::MAP& map, MeshTablesSurface<PFP>& mts, unsigned int nbth)
 {
 	typedef typename PFP::MAP MAP;
 
-	VertexAutoAttribute< NoTypeNameAttribute< std::vector<Dart> >, MAP> vecDartsPerVertex(map, "incidents");
-
-	unsigned nbf = mts.getNbFaces();
-	int index = 0;
-	// buffer for tempo faces (used to remove degenerated edges)
-	std::vector<unsigned int> edgesBuffer;
-	edgesBuffer.reserve(16);
+	const unsigned int nbf = mts.getNbFaces();
 
-	DartMarkerNoUnmark<MAP> m(map) ;
+	// first index of each face in the table of embeddings
+	std::vector<unsigned int> firstEmb(nbf + 1);
+	firstEmb[0] = 0;
+	for (unsigned int i = 0; i < nbf; ++i)
+		firstEmb[i + 1] = firstEmb[i] + mts.getNbEdgesFace(i);
 
-//	unsigned int vemb = EMBNULL;
-//	auto fsetemb = [&] (Dart d) { map.template initDartEmbedding<VERTEX>(d, vemb); };
-
-	// for each face of table
-	for(unsigned int i = 0; i < nbf; ++i)
+	// vertices of face i without degenerated edges (the first nbMax are written in vertices)
+	// return 0 for faces that are degenerated
+	auto cleanFace = [&] (unsigned int i, unsigned int* vertices, unsigned int nbMax) -> unsigned int
 	{
-		// store face in buffer, removing degenerated edges
-		unsigned int nbe = mts.getNbEdgesFace(i);
-		edgesBuffer.clear();
+		unsigned int nbe = 0;
 		unsigned int prec = EMBNULL;
-		for (unsigned int j = 0; j < nbe; ++j)
+		unsigned int first = EMBNULL;
+		for (unsigned int j = firstEmb[i]; j < firstEmb[i + 1]; ++j)
 		{
-			unsigned int em = mts.getEmbIdx(index++);
+			unsigned int em = mts.getEmbIdx(j);
 			if (em != prec)
 			{
 				prec = em;
-				edgesBuffer.push_back(em);
+				if (nbe == 0)
+					first = em;
+				if (nbe < nbMax)
+					vertices[nbe] = em;
+				++nbe;
 			}
 		}
 		// check first/last vertices
-		if (edgesBuffer.front() == edgesBuffer.back())
-			edgesBuffer.pop_back();
+		if ((nbe > 0) && (prec == first))
+			--nbe;
+		return (nbe > 2) ? nbe : 0;
+	};
+
+	// table of the non degenerated faces: vertices of face i in [faceBegin[i], faceBegin[i+1][
+	std::vector<unsigned int> faceBegin(nbf + 1);
+	faceBegin[0] = 0;
+	CGoGN::Parallel::foreach_index(nbf, [&] (unsigned int i, unsigned int)
+	{
+		faceBegin[i + 1] = cleanFace(i, NULL, 0);
+	}, nbth);
+	for (unsigned int i = 0; i < nbf; ++i)
+		faceBegin[i + 1] += faceBegin[i];
+	const unsigned int nbHalfEdges = faceBegin[nbf];
+
+	std::vector<unsigned int> faceVertices(nbHalfEdges);
+	CGoGN::Parallel::foreach_index(nbf, [&] (unsigned int i, unsigned int)
+	{
+		if (faceBegin[i + 1] > faceBegin[i])
+			cleanFace(i, &faceVertices[faceBegin[i]], faceBegin[i + 1] - faceBegin[i]);
+	}, nbth);
 
-		// create only non degenerated faces
-		nbe = uint32(edgesBuffer.size());
-		if (nbe > 2)
-		{
-			Dart d = map.newFace(nbe, false);
-			for (unsigned int j = 0; j < nbe; ++j)
-			{
-				unsigned int vemb = edgesBuffer[j];	// get embedding
-				map.template foreach_dart_of_orbit<PFP::MAP::VERTEX_OF_PARENT>(d, [&] (Dart dd) { map.template initDartEmbedding<VERTEX>(dd, vemb); });
+	// creation of the faces (insertion of the darts in the container is sequential)
+	std::vector<Dart> faceDart(nbf, NIL);
+	for (unsigned int i = 0; i < nbf; ++i)
+	{
+		if (faceBegin[i + 1] > faceBegin[i])
+			faceDart[i] = map.newFace(faceBegin[i + 1] - faceBegin[i], false);
+	}
 
-				m.mark(d) ;								// mark on the fly to unmark on second loop
-				vecDartsPerVertex[vemb].push_back(d);	// store incident darts for fast adjacency reconstruction
-				d = map.phi1(d);
-			}
+	// dart of each half-edge and vertex embedding of the darts (the references are counted afterwards)
+	AttributeMultiVector<unsigned int>* vertexEmb = map.template getEmbeddingAttributeVector<VERTEX>();
+	std::vector<Dart> halfEdgeDart(nbHalfEdges);
+	std::vector<unsigned int> nbEmbeddedDarts(nbHalfEdges);
+	CGoGN::Parallel::foreach_index(nbf, [&] (unsigned int i, unsigned int)
+	{
+		Dart d = faceDart[i];
+		for (unsigned int k = faceBegin[i]; k < faceBegin[i + 1]; ++k)
+		{
+			unsigned int vemb = faceVertices[k];
+			unsigned int nb = 0;
+			map.template foreach_dart_of_orbit<PFP::MAP::VERTEX_OF_PARENT>(d, [&] (Dart dd) { (*vertexEmb)[map.dartIndex(dd)] = vemb; ++nb; });
+			halfEdgeDart[k] = d;
+			nbEmbeddedDarts[k] = nb;
+			d = map.phi1(d);
 		}
-	}
+	}, nbth);
 
-	bool needBijectiveCheck = false;
+	AttributeContainer& vertexCont = map.template getAttributeContainer<VERTEX>();
+	for (unsigned int k = 0; k < nbHalfEdges; ++k)
+		vertexCont.setNbRefs(faceVertices[k], vertexCont.getNbRefs(faceVertices[k]) + nbEmbeddedDarts[k]);
+	if (map.template getQuickTraversal<VERTEX>() != NULL)
+		map.template updateQuickTraversal<MAP, VERTEX>();
 
-	// reconstruct neighbourhood
-	unsigned int nbBoundaryEdges = 0;
-	for (Dart d = map.begin(); d != map.end(); map.next(d))
+	// half-edges sorted by edge: the half-edges of opposite directions of an edge are sewn two by two
+	// (in creation order, as the previous sequential reconstruction did)
+	struct HalfEdge
 	{
-		if (m.isMarked(d))
+		unsigned int v1, v2;	// ordered ends
+		unsigned int k;			// index of the half-edge
+		bool reversed;			// half-edge goes from v2 to v1
+		bool operator<(const HalfEdge& h) const
 		{
-			// darts incident to end vertex of edge
-			std::vector<Dart>& vec = vecDartsPerVertex[map.phi1(d)];
-
-			unsigned int embd = map.template getEmbedding<VERTEX>(d);
-			Dart good_dart = NIL;
-			bool firstOK = true;
-			for (typename std::vector<Dart>::iterator it = vec.begin(); it != vec.end() && good_dart == NIL; ++it)
-			{
-				if (map.template getEmbedding<VERTEX>(map.phi1(*it)) == embd)
-				{
-					good_dart = *it;
-					if (good_dart == map.phi2(good_dart))
-					{
-						map.sewFaces(d, good_dart, false);
-						m.template unmarkOrbit<EDGE>(d);
-					}
-					else
-					{
-						good_dart = NIL;
-						firstOK = false;
-					}
-				}
-			}
+			if (v1 != h.v1) return v1 < h.v1;
+			if (v2 != h.v2) return v2 < h.v2;
+			return k < h.k;
+		}
+	};
 
-			if (!firstOK)
-				needBijectiveCheck = true;
+	std::vector<HalfEdge> halfEdges(nbHalfEdges);
+	CGoGN::Parallel::foreach_index(nbf, [&] (unsigned int i, unsigned int)
+	{
+		const unsigned int b = faceBegin[i];
+		const unsigned int e = faceBegin[i + 1];
+		for (unsigned int k = b; k < e; ++k)
+		{
+			unsigned int v = faceVertices[k];
+			unsigned int w = faceVertices[(k + 1 < e) ? k + 1 : b];
+			HalfEdge& h = halfEdges[k];
+			h.v1 = std::min(v, w);
+			h.v2 = std::max(v, w);
+			h.k = k;
+			h.reversed = w < v;
+		}
+	}, nbth);
+	CGoGN::Parallel::sort(halfEdges, nbth);
 
-			if (good_dart == NIL)
-			{
-				m.template unmarkOrbit<EDGE>(d);
-				++nbBoundaryEdges;
-			}
+	const unsigned int nbTasks = CGoGN::Parallel::nbTasksOfRange(nbHalfEdges, nbth);
+	std::vector<unsigned int> nbBoundaryEdgesPerTask(nbTasks, 0);
+	std::vector<unsigned char> needBijectiveCheckPerTask(nbTasks, 0);
+	CGoGN::Parallel::foreach_index(nbHalfEdges, [&] (unsigned int i, unsigned int task)
+	{
+		// each edge is processed by the task of its first half-edge
+		if ((i > 0) && (halfEdges[i - 1].v1 == halfEdges[i].v1) && (halfEdges[i - 1].v2 == halfEdges[i].v2))
+			return;
+
+		unsigned int j = i + 1;
+		while ((j < nbHalfEdges) && (halfEdges[j].v1 == halfEdges[i].v1) && (halfEdges[j].v2 == halfEdges[i].v2))
+			++j;
+
+		// non manifold edge
+		if (j - i > 2)
+			needBijectiveCheckPerTask[task] = 1;
+
+		unsigned int f = i;
+		unsigned int b = i;
+		unsigned int nbSewn = 0;
+		while (true)
+		{
+			while ((f < j) && halfEdges[f].reversed)
+				++f;
+			while ((b < j) && !halfEdges[b].reversed)
+				++b;
+			if ((f == j) || (b == j))
+				break;
+			map.sewFaces(halfEdgeDart[halfEdges[f].k], halfEdgeDart[halfEdges[b].k], false);
+			++nbSewn;
+			++f;
+			++b;
 		}
+		nbBoundaryEdgesPerTask[task] += (j - i) - 2 * nbSewn;
+	}, nbth);
+
+	unsigned int nbBoundaryEdges = 0;
+	bool needBijectiveCheck = false;
+	for (unsigned int t = 0; t < nbTasks; ++t)
+	{
+		nbBoundaryEdges += nbBoundaryEdgesPerTask[t];
+		needBijectiveCheck = needBijectiveCheck || (needBijectiveCheckPerTask[t] != 0);
 	}
 
 	if (nbBoundaryEdges > 0)
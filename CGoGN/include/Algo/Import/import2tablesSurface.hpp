@@ -24,6 +24,7 @@
 
 #include "Algo/Import/importPlyData.h"
 #include "Algo/Geometry/boundingbox.h"
+#include "Algo/Geometry/weldVertices.h"
 #include "Topology/generic/autoAttributeHandler.h"
 
 #include "Algo/Modelisation/voxellisation.h"
@@ -1578,149 +1579,45 @@ bool MeshTablesSurface<PFP>::importASSIMP(const std::string& filename, std::vect
 template<typename PFP>
 bool MeshTablesSurface<PFP>::mergeCloseVertices()
 {
-    const int NBV = 64; // seems to be good
-
-    const int NEIGH[27] = {
-    -NBV*NBV - NBV - 1, 	-NBV*NBV - NBV, 	-NBV*NBV - NBV + 1,
-    -NBV*NBV - 1, 	-NBV*NBV, 	-NBV*NBV + 1,
-    -NBV*NBV + NBV - 1,	-NBV*NBV + NBV,	- NBV*NBV + NBV + 1,
-    -NBV - 1,	- NBV,	-NBV + 1,
-    -1,	0,	1,
-    NBV - 1,	NBV,	NBV + 1,
-    NBV*NBV - NBV - 1,	NBV*NBV - NBV,	NBV*NBV - NBV + 1,
-    NBV*NBV - 1,	NBV*NBV,	NBV*NBV + 1,
-    NBV*NBV + NBV - 1,	NBV*NBV + NBV,	NBV*NBV + NBV + 1};
-
-    std::vector<unsigned int>** grid;
-    grid = new std::vector<unsigned int>*[NBV*NBV*NBV];
-
-    // init grid with null ptrs
-    for (unsigned int i=0; i<NBV*NBV*NBV; ++i)
-        grid[i] = NULL;
-
 	VertexAttribute<VEC3, MAP> positions = m_map.template getAttribute<VEC3, VERTEX, MAP>("position");
+	if (!positions.isValid() || (m_nbFaces == 0))
+		return false;
 
-    // compute BB
-    Geom::BoundingBox<typename PFP::VEC3> bb(positions[ positions.begin() ]) ;
-    for (unsigned int i = positions.begin(); i != positions.end(); positions.next(i))
-    {
-        bb.addPoint(positions[i]) ;
-    }
-
-    // add one voxel around to avoid testing
-    typename PFP::VEC3 bbsize = (bb.max() - bb.min());
-    typename PFP::VEC3 one = bbsize/(NBV-2);
-    one*= 1.001f;
-    bb.addPoint( bb.min() - one);
-    bb.addPoint( bb.max() + one);
-    bbsize = (bb.max() - bb.min());
-
-	VertexAutoAttribute<unsigned int, MAP> gridIndex(m_map, "gridIndex");
-	VertexAutoAttribute<unsigned int, MAP> newIndices(m_map, "newIndices");
+	// compute EPSILON: average length of the first edge of the 100 first faces divided by 10000 (very very close)
+	unsigned int nbf = 100;
+	if (nbf > m_nbFaces)
+		nbf = m_nbFaces;
 
-    // Store each vertex in the grid and store voxel index in vertex attribute
-    for (unsigned int i = positions.begin(); i != positions.end(); positions.next(i))
-    {
-        typename PFP::VEC3 P = positions[i];
-        P -= bb.min();
-		typename PFP::REAL pz = floor((P[2] / bbsize[2])*NBV);
-		typename PFP::REAL py = floor((P[1] / bbsize[1])*NBV);
-		typename PFP::REAL px = floor((P[0] / bbsize[0])*NBV);
-
-        unsigned int index = uint32(NBV*NBV*pz + NBV*py + px);
-
-        if (pz==63)
-            std::cout << "z 63 bb:"<<bb<<"  P="<<positions[i]<< std::endl;
-
-        std::vector<unsigned int>* vox = grid[index];
-        if (vox==NULL)
-        {
-            grid[index] = new std::vector<unsigned int>();
-            grid[index]->reserve(8);
-            vox = grid[index];
-        }
-        vox->push_back(i);
-        gridIndex[i] = index;
-        newIndices[i] = 0xffffffff;
-    }
-
-    // compute EPSILON: average length of 50 of 100 first edges of faces divide by 10000 (very very closed)
-    unsigned int nbf = 100;
-    if (nbf> m_nbFaces)
-        nbf = m_nbFaces;
-
-    int k=0;
-    double d=0;
-    for (unsigned int i=0; i< nbf;++i)
-    {
-        typename PFP::VEC3 e1 = positions[m_emb[k+1]] - positions[m_emb[k]];
-        d += double(e1.norm());
-        k += m_nbEdges[i];
-    }
-    d /= double(nbf);
+	int k = 0;
+	double d = 0;
+	for (unsigned int i = 0; i < nbf; ++i)
+	{
+		typename PFP::VEC3 e1 = positions[m_emb[k+1]] - positions[m_emb[k]];
+		d += double(e1.norm());
+		k += m_nbEdges[i];
+	}
+	d /= double(nbf);
 
 	typename PFP::REAL epsilon = typename PFP::REAL(d / 10000.0);
 
+	std::vector<unsigned int> newIndices;
+	if (Algo::Geometry::weldPoints<PFP>(positions, epsilon, newIndices) == 0)
+		return true;
 
-    // traverse vertices
-    for (unsigned int i = positions.begin(); i != positions.end(); positions.next(i))
-    {
-        if (newIndices[i] == 0xffffffff)
-        {
-            const typename PFP::VEC3& P = positions[i];
+	// update faces indices
+	for (std::vector<unsigned int>::iterator it = m_emb.begin(); it != m_emb.end(); ++it)
+		*it = newIndices[*it];
 
-            for (unsigned int n=0; n<27; ++n)
-            {
-                std::vector<unsigned int>* voxel = grid[gridIndex[i]+NEIGH[n]];
-                if (voxel != NULL)
-                {
-                    for (std::vector<unsigned int>::iterator v = voxel->begin(); v != voxel->end(); ++v)
-                    {
-                        if ((*v != i) && (*v != 0xffffffff))
-                        {
-                            typename PFP::VEC3 Q = positions[*v];
-                            Q -= P;
-                            typename PFP::REAL d2 = Q*Q;
-                            if (d2 < epsilon*epsilon)
-                            {
-                                newIndices[*v] = i;
-                                *v = 0xffffffff;
-                            }
-                        }
-                    }
-                }
-            }
-        }
-    }
-
-    // update faces indices
-    for	(std::vector<unsigned int>::iterator it = m_emb.begin(); it != m_emb.end(); ++it)
-    {
-        if (newIndices[*it] != 0xffffffff)
-        {
-            *it = newIndices[*it];
-        }
-    }
-
-    // delete embeddings
-    AttributeContainer& container = m_map.template getAttributeContainer<VERTEX>() ;
-
-    for (unsigned int i = positions.begin(); i != positions.end(); positions.next(i))
-    {
-        if (newIndices[i] != 0xffffffff)
-        {
-            container.removeLine(i);
-        }
-    }
-
-    // release grid memory
-    for (unsigned int i=0; i<NBV*NBV*NBV; ++i)
-        if (grid[i]!=NULL)
-            delete grid[i];
+	// delete embeddings
+	AttributeContainer& container = m_map.template getAttributeContainer<VERTEX>() ;
 
-    delete[] grid;
+	for (unsigned int i = positions.begin(); i != positions.end(); positions.next(i))
+	{
+		if (newIndices[i] != i)
+			container.removeLine(i);
+	}
 
-    return true;
+	return true;
 }
 
 
@@ -27,6 +27,9 @@
 
 #include "Geometry/vector_gen.h"
 #include "Utils/img3D_IO.h"
+#include "Utils/mappedFile.h"
+#include <atomic>
+#include <mutex>
 #include <vector>
 
 #ifdef CGOGN_WITH_ZINRI
@@ -50,6 +53,8 @@ namespace MC
  *
  * The class Image manage 3D voxel image
  * of any type
+ * The voxels are allocated, mapped from a file (loadRaw, loadVox, loadInr)
+ * or computed by slices when accessed (lazy addFrame and Blur3)
  * @param DataType the type of voxel
  */
 template< typename  DataType >
@@ -118,6 +123,69 @@ protected:
 	 */
 	bool m_Alloc;
 
+	/**
+	 * file mapped in memory that holds the data (NULL if none)
+	 */
+	Utils::MappedFile* m_File;
+
+	/**
+	 * filters that compute an image from a source image slice by slice
+	 */
+	enum SliceFilter { FILTER_FRAME, FILTER_BLUR3 };
+
+	/**
+	 * slices of a lazy image (view of a source image through a filter),
+	 * computed by chunks of consecutive slices when they are accessed.
+	 * Chunk c holds the slices [c*chunkSize-1, c*chunkSize+chunkSize] so that
+	 * the slices before and after any slice are reachable from its voxel pointers.
+	 */
+	struct LazySlices
+	{
+		const Image<DataType>* source;
+		SliceFilter filter;
+		int frameWidth;
+		int chunkSize;
+		std::vector< std::atomic<DataType*> > chunks;
+		/// released flag of each slice and number of released slices of each chunk
+		std::vector<unsigned char> released;
+		std::vector<int> nbReleased;
+		std::mutex mutex;
+
+		LazySlices(const Image<DataType>* src, SliceFilter f, int fw, int cs, int nbSlices);
+	};
+
+	/**
+	 * lazy slices (NULL for an image that holds its data)
+	 */
+	LazySlices* m_Lazy;
+
+	/**
+	 * use the data of a mapped file from offset (kept in place if aligned, else copied)
+	 */
+	void useMappedData(Utils::MappedFile* file, std::size_t offset);
+
+	/**
+	 * compute slice z of this image from the source image through a filter
+	 * @param src the source image
+	 * @param filter the filter
+	 * @param frameWidth width of the frame (FILTER_FRAME)
+	 * @param z the slice
+	 * @param dest the m_WXY voxels of the slice
+	 */
+	void computeSlice(const Image<DataType>& src, SliceFilter filter, int frameWidth, int z, DataType* dest) const;
+
+	/**
+	 * create an image computed from this one through a filter
+	 * @param lazy the slices are computed when accessed, else all of them are computed now
+	 * @param chunkSize number of slices of the chunks of a lazy image (0: chunks of about 16 MB)
+	 */
+	Image<DataType>* filteredImage(SliceFilter filter, int frameWidth, bool lazy, int chunkSize = 0) const;
+
+	/**
+	 * voxel address of a lazy image (its chunk is computed if needed)
+	 */
+	DataType* lazyVoxelPtr(int _lX, int _lY, int _lZ) const;
+
 	/**
 	* Test if a point is in the image
 	*
@@ -195,13 +263,53 @@ public:
 
 	/**
 	* Load a raw image
+	* @param filename file to open
+	* @param mapped the file is mapped in memory instead of being read:
+	* voxels are read from the file when accessed (copy on write, the file is never modified)
+	*/
+	void loadRaw(const char *filename, bool mapped = false);
+
+	/**
+	* are the data in a file mapped in memory
+	*/
+	bool isMapped() const { return m_File != NULL; }
+
+	/**
+	* are the slices computed when accessed (see addFrame and Blur3):
+	* the image has no contiguous data (getData returns NULL), its voxels are
+	* read with getVoxel or getVoxelPtr, and from a voxel pointer only the
+	* voxels of the same slice and of the slices before and after are reachable
 	*/
-	void loadRaw(const char *filename);
+	bool isLazy() const { return m_Lazy != NULL; }
+
+	/**
+	* advise that slices [zBegin,zEnd[ will be read soon (mapped or lazy image only)
+	*/
+	void prefetchSlices(int zBegin, int zEnd) const;
+
+	/**
+	* advise that slices [zBegin,zEnd[ will not be read again soon (mapped or lazy image only):
+	* their memory is the first to be reclaimed.
+	* The chunks of slices of a lazy image are freed when all their slices have
+	* been released: their voxel pointers must not be used any more.
+	*/
+	void releaseSlices(int zBegin, int zEnd) const;
 
 	/**
 	 * Load a vox file
+	 * @param filename file to open (the data are in the file of same name with extension raw)
+	 * @param mapped the data file is mapped in memory instead of being read
 	 */
-	void loadVox(const char *filename);
+	void loadVox(const char *filename, bool mapped = false);
+
+	/**
+	* Load an uncompressed inr file (one component)
+	* @param filename file to open
+	* @param mapped the file is mapped in memory instead of being read
+	* (the file is read if its byte order is not the one of the machine)
+	* @return false if the file can not be read or does not store DataType voxels
+	*/
+	bool loadInr(const char *filename, bool mapped = false);
 
 #ifdef CGOGN_WITH_ZINRI
 	/**
@@ -320,9 +428,11 @@ public:
 	/**
 	*  add Frame of zero around the image
 	* @param  _lWidth the width of frame to add
+	* @param lazy the framed slices are computed when accessed (see isLazy) instead of
+	* allocating the whole new image; this image must outlive the new one
 	* @return the new image
 	*/
-	Image<DataType>* addFrame(int _lWidth) const;
+	Image<DataType>* addFrame(int _lWidth, bool lazy = false) const;
 
 	/**
 	 * Get the lower corner of bounding AABB
@@ -344,8 +454,10 @@ public:
 
 	/**
 	 * local (3x3) blur of image
+	 * @param lazy the blurred slices are computed when accessed (see isLazy) instead of
+	 * allocating the whole new image; this image must outlive the new one
 	 */
-	Image<DataType>* Blur3();
+	Image<DataType>* Blur3(bool lazy = false) const;
 
 	/**
 	 * create a virtual sphere for computing curvature
@@ -29,7 +29,10 @@
 #include <cmath>
 #include <typeinfo>
 #include <algorithm>
+#include <limits>
+#include <sstream>
 #include "Utils/cgognStream.h"
+#include "Topology/generic/parallelRange.h"
 
 namespace CGoGN
 {
@@ -48,7 +51,10 @@ Image<DataType>::Image():
 	m_Data	(NULL),
 	m_OX	(0),
 	m_OY	(0),
-	m_OZ	(0)
+	m_OZ	(0),
+	m_Alloc	(false),
+	m_File	(NULL),
+	m_Lazy	(NULL)
 {
 }
 
@@ -64,7 +70,9 @@ Image<DataType>::Image(DataType *data, int wx, int wy, int wz, float sx, float s
 	m_OZ   (0),
 	m_SX   (sx),
 	m_SY   (sy),
-	m_SZ   (sz)
+	m_SZ   (sz),
+	m_File (NULL),
+	m_Lazy (NULL)
 {
 	if ( copy )
 	{
@@ -117,8 +125,40 @@ void Image<DataType>::createMask(const Image<DataTypeIn>& img )
 
 
 template< typename  DataType >
-void Image<DataType>::loadRaw(const char *filename)
+void Image<DataType>::loadRaw(const char *filename, bool mapped)
 {
+	if (mapped)
+	{
+		Utils::MappedFile* file = new Utils::MappedFile();
+		if (!file->open(filename) || (file->size() < 3*sizeof(int)))
+		{
+			CGoGNerr << "Mesh_Base::loadRaw: Unable to open file " << CGoGNendl;
+			exit(0);
+		}
+
+		// read size
+		memcpy(&m_WX, file->data(), sizeof(int));
+		memcpy(&m_WY, file->data() + sizeof(int), sizeof(int));
+		memcpy(&m_WZ, file->data() + 2*sizeof(int), sizeof(int));
+
+		m_WXY = m_WX * m_WY;
+
+		std::size_t total = std::size_t(m_WXY) * std::size_t(m_WZ);
+		if (file->size() < 3*sizeof(int) + total*sizeof(DataType))
+		{
+			CGoGNerr << "Mesh_Base::loadRaw: file too short " << CGoGNendl;
+			exit(0);
+		}
+
+		m_SX = 1.0;
+		m_SY = 1.0;
+		m_SZ = 1.0;
+
+		// the data follow the 3 ints of header
+		useMappedData(file, 3*sizeof(int));
+		return;
+	}
+
 	std::ifstream fp( filename, std::ios::in|std::ios::binary);
 	if (!fp.good())
 	{
@@ -146,10 +186,87 @@ void Image<DataType>::loadRaw(const char *filename)
 	m_Alloc=true;
 }
 
+template< typename  DataType >
+void Image<DataType>::useMappedData(Utils::MappedFile* file, std::size_t offset)
+{
+	// used in place if aligned for DataType
+	if (offset % alignof(DataType) == 0)
+	{
+		m_Data = reinterpret_cast<DataType*>(file->data() + offset);
+		m_Alloc = false;
+		m_File = file;
+	}
+	else
+	{
+		std::size_t total = std::size_t(m_WXY) * std::size_t(m_WZ);
+		m_Data = new DataType[total];
+		memcpy(m_Data, file->data() + offset, total*sizeof(DataType));
+		m_Alloc = true;
+		delete file;
+	}
+}
+
+template< typename  DataType >
+void Image<DataType>::prefetchSlices(int zBegin, int zEnd) const
+{
+	if (m_Lazy != NULL)
+	{
+		// slices of the source used by the slices [zBegin,zEnd[
+		int before = (m_Lazy->filter == FILTER_FRAME) ? m_Lazy->frameWidth : 1;
+		int after = (m_Lazy->filter == FILTER_FRAME) ? -m_Lazy->frameWidth : 1;
+		m_Lazy->source->prefetchSlices(std::max(zBegin - before, 0), std::min(zEnd + after, m_Lazy->source->m_WZ));
+		return;
+	}
+
+	if ((m_File == NULL) || (zEnd <= zBegin))
+		return;
+	std::size_t offset = reinterpret_cast<const char*>(m_Data) - m_File->data();
+	std::size_t slice = std::size_t(m_WXY) * sizeof(DataType);
+	m_File->willNeed(offset + std::size_t(zBegin) * slice, std::size_t(zEnd - zBegin) * slice);
+}
+
+template< typename  DataType >
+void Image<DataType>::releaseSlices(int zBegin, int zEnd) const
+{
+	if (m_Lazy != NULL)
+	{
+		LazySlices& lazy = *m_Lazy;
+		{
+			std::lock_guard<std::mutex> lock(lazy.mutex);
+			for (int z = std::max(zBegin, 0); z < std::min(zEnd, m_WZ); ++z)
+			{
+				if (lazy.released[z])
+					continue;
+				lazy.released[z] = 1;
+				int c = z / lazy.chunkSize;
+				int first = c * lazy.chunkSize;
+				int nb = std::min(lazy.chunkSize, m_WZ - first);
+				if (++lazy.nbReleased[c] == nb)
+				{
+					delete[] lazy.chunks[c].load(std::memory_order_relaxed);
+					lazy.chunks[c].store(NULL, std::memory_order_relaxed);
+					lazy.nbReleased[c] = 0;
+					std::fill(lazy.released.begin() + first, lazy.released.begin() + first + nb, 0);
+				}
+			}
+		}
+		// slices of the source that are not used by the next slices
+		int shift = (lazy.filter == FILTER_FRAME) ? lazy.frameWidth : 1;
+		lazy.source->releaseSlices(std::max(zBegin - shift, 0), std::min(zEnd - shift, lazy.source->m_WZ));
+		return;
+	}
+
+	if ((m_File == NULL) || (zEnd <= zBegin))
+		return;
+	std::size_t offset = reinterpret_cast<const char*>(m_Data) - m_File->data();
+	std::size_t slice = std::size_t(m_WXY) * sizeof(DataType);
+	m_File->dontNeed(offset + std::size_t(zBegin) * slice, std::size_t(zEnd - zBegin) * slice);
+}
+
 
 
 template< typename  DataType >
-void Image<DataType>::loadVox(const char *filename)
+void Image<DataType>::loadVox(const char *filename, bool mapped)
 {
 	std::ifstream in(filename);
 	if (!in)
@@ -196,15 +313,28 @@ void Image<DataType>::loadVox(const char *filename)
 	m_WXY = m_WX * m_WY;
 	int total = m_WXY * m_WZ;
 
-	m_Data = new DataType[total];
-
 	int filename_s = int(strlen(filename))+1 ;
 //	char datafile[filename_s] ;
 	char* datafile = new char[filename_s] ;
 	memcpy(datafile, filename, filename_s);
-	datafile[filename_s-3] = 'r' ;
-	datafile[filename_s-2] = 'a' ;
-	datafile[filename_s-1] = 'w' ;
+	datafile[filename_s-4] = 'r' ;
+	datafile[filename_s-3] = 'a' ;
+	datafile[filename_s-2] = 'w' ;
+
+	if (mapped)
+	{
+		Utils::MappedFile* file = new Utils::MappedFile();
+		if (!file->open(datafile) || (file->size() < std::size_t(m_WXY) * std::size_t(m_WZ) * sizeof(DataType)))
+		{
+			CGoGNerr << "Mesh_Base::loadVox: Unable to open data file " << datafile << CGoGNendl;
+			exit(0);
+		}
+		useMappedData(file, 0);
+		delete[] datafile;
+		return;
+	}
+
+	m_Data = new DataType[total];
 
 	std::ifstream fp(datafile, std::ios::in|std::ios::binary);
 	fp.read(reinterpret_cast<char*>(m_Data), total*sizeof(DataType));
@@ -213,6 +343,134 @@ void Image<DataType>::loadVox(const char *filename)
 	delete[] datafile;
 }
 
+template< typename  DataType >
+bool Image<DataType>::loadInr(const char *filename, bool mapped)
+{
+	std::ifstream fp(filename, std::ios::in|std::ios::binary);
+	if (!fp.good())
+	{
+		CGoGNerr << "Image::loadInr: Unable to open file " << filename << CGoGNendl;
+		return false;
+	}
+
+	// header: blocks of 256 characters, from "#INRIMAGE-4#{" to "##}"
+	std::string header;
+	char block[256];
+	do
+	{
+		fp.read(block, 256);
+		if (fp.gcount() != 256)
+		{
+			CGoGNerr << "Image::loadInr: invalid header" << CGoGNendl;
+			return false;
+		}
+		header.append(block, 256);
+	} while (header.find("##}") == std::string::npos);
+
+	if (header.compare(0, 12, "#INRIMAGE-4#") != 0)
+	{
+		CGoGNerr << "Image::loadInr: not an inr file" << CGoGNendl;
+		return false;
+	}
+
+	int vdim = 1;
+	int pixsize = 0;
+	std::string type;
+	std::string cpu("decm");
+	m_WX = 0;
+	m_WY = 0;
+	m_WZ = 1;
+	m_SX = 1.0f;
+	m_SY = 1.0f;
+	m_SZ = 1.0f;
+
+	std::istringstream input(header);
+	std::string line;
+	while (std::getline(input, line))
+	{
+		std::size_t eq = line.find('=');
+		if (eq == std::string::npos)
+			continue;
+		std::string keyword = line.substr(0, eq);
+		std::istringstream value(line.substr(eq + 1));
+		if (keyword == "XDIM")
+			value >> m_WX;
+		else if (keyword == "YDIM")
+			value >> m_WY;
+		else if (keyword == "ZDIM")
+			value >> m_WZ;
+		else if (keyword == "VDIM")
+			value >> vdim;
+		else if (keyword == "PIXSIZE")
+			value >> pixsize;
+		else if (keyword == "TYPE")
+			type = line.substr(eq + 1);
+		else if (keyword == "CPU")
+			value >> cpu;
+		else if (keyword == "VX")
+			value >> m_SX;
+		else if (keyword == "VY")
+			value >> m_SY;
+		else if (keyword == "VZ")
+			value >> m_SZ;
+	}
+
+	bool typeOk;
+	if (type == "float")
+		typeOk = !std::numeric_limits<DataType>::is_integer;
+	else if (type == "unsigned fixed")
+		typeOk = std::numeric_limits<DataType>::is_integer && !std::numeric_limits<DataType>::is_signed;
+	else if (type == "signed fixed")
+		typeOk = std::numeric_limits<DataType>::is_integer && std::numeric_limits<DataType>::is_signed;
+	else
+		typeOk = false;
+
+	if ((m_WX <= 0) || (m_WY <= 0) || (m_WZ <= 0) || (vdim != 1) || !typeOk || (pixsize != int(8*sizeof(DataType))))
+	{
+		CGoGNerr << "Image::loadInr: " << filename << " does not store " << typeid(DataType).name() << " voxels" << CGoGNendl;
+		return false;
+	}
+
+	m_WXY = m_WX * m_WY;
+	std::size_t total = std::size_t(m_WXY) * std::size_t(m_WZ);
+
+	// byte order of file and machine
+	unsigned short one = 1;
+	bool bigEndian = (*reinterpret_cast<unsigned char*>(&one) == 0);
+	bool swap = (sizeof(DataType) > 1) && (bigEndian != ((cpu == "sun") || (cpu == "sgi")));
+
+	if (mapped && !swap)
+	{
+		Utils::MappedFile* file = new Utils::MappedFile();
+		if (!file->open(filename) || (file->size() < header.size() + total*sizeof(DataType)))
+		{
+			CGoGNerr << "Image::loadInr: file too short " << CGoGNendl;
+			delete file;
+			return false;
+		}
+		useMappedData(file, header.size());
+		return true;
+	}
+
+	m_Data = new DataType[total];
+	m_Alloc = true;
+	fp.read(reinterpret_cast<char*>(m_Data), total*sizeof(DataType));
+	if (std::size_t(fp.gcount()) != total*sizeof(DataType))
+	{
+		CGoGNerr << "Image::loadInr: file too short " << CGoGNendl;
+		return false;
+	}
+
+	if (swap)
+	{
+		char* bytes = reinterpret_cast<char*>(m_Data);
+		for (std::size_t i = 0; i < total; ++i, bytes += sizeof(DataType))
+			std::reverse(bytes, bytes + sizeof(DataType));
+	}
+
+	return true;
+}
+
 #ifdef CGOGN_WITH_QT
 template< typename  DataType >
 bool Image<DataType>::loadPNG3D(const char* filename)
@@ -494,120 +752,213 @@ Image<DataType>::~Image()
 	{
 		delete[] m_Data;
 	}
+
+	if (m_File != NULL)
+		delete m_File;
+
+	if (m_Lazy != NULL)
+	{
+		for (unsigned int c = 0; c < m_Lazy->chunks.size(); ++c)
+			delete[] m_Lazy->chunks[c].load(std::memory_order_relaxed);
+		delete m_Lazy;
+	}
 }
 
 
 template< typename  DataType >
 DataType Image<DataType>::getVoxel(int _lX, int _lY, int _lZ)
 {
-  return m_Data[_lX + m_WX*_lY + m_WXY*_lZ];
+	return *getVoxelPtr(_lX, _lY, _lZ);
 }
 
 
 template< typename  DataType >
 const DataType* Image<DataType>::getVoxelPtr(int lX, int lY, int lZ) const
 {
-	return m_Data + lX + m_WX*lY + m_WXY*lZ;
+	if (m_Lazy != NULL)
+		return lazyVoxelPtr(lX, lY, lZ);
+	// images of more than 2^31 voxels
+	return m_Data + lX + std::ptrdiff_t(m_WX)*lY + std::ptrdiff_t(m_WXY)*lZ;
 }
 
 
 template< typename  DataType >
 DataType* Image<DataType>::getVoxelPtr(int lX, int lY, int  lZ)
 {
-	return m_Data + lX + m_WX*lY + m_WXY*lZ;
+	if (m_Lazy != NULL)
+		return lazyVoxelPtr(lX, lY, lZ);
+	return m_Data + lX + std::ptrdiff_t(m_WX)*lY + std::ptrdiff_t(m_WXY)*lZ;
 }
 
 template< typename  DataType >
 DataType Image<DataType>::getVoxel(const Geom::Vec3i &V)
 {
-	return m_Data[V[0] + m_WX*V[1] + m_WXY*V[2]];
+	return *getVoxelPtr(V[0], V[1], V[2]);
 }
 
 
-/*
-*  add a frame of Zero to the image
-*/
 template< typename  DataType >
-Image<DataType>* Image<DataType>::addFrame(int frameWidth) const
+Image<DataType>::LazySlices::LazySlices(const Image<DataType>* src, SliceFilter f, int fw, int cs, int nbSlices):
+	source(src),
+	filter(f),
+	frameWidth(fw),
+	chunkSize(cs),
+	chunks((nbSlices + cs - 1) / cs),
+	released(nbSlices, 0),
+	nbReleased((nbSlices + cs - 1) / cs, 0)
 {
-	int lTx = m_WX+2*frameWidth;
-	int lTy = m_WY+2*frameWidth;
-	int lTz = m_WZ+2*frameWidth;
-	int lTxy = lTx*lTy;
+	for (unsigned int c = 0; c < chunks.size(); ++c)
+		chunks[c].store(NULL, std::memory_order_relaxed);
+}
 
-	// define Zero
-	DataType Zero = DataType();
 
-	// allocate new data
-	DataType *newData = new DataType[lTxy*lTz];
+template< typename  DataType >
+DataType* Image<DataType>::lazyVoxelPtr(int lX, int lY, int lZ) const
+{
+	LazySlices& lazy = *m_Lazy;
+	int c = lZ / lazy.chunkSize;
+	int zFirst = c * lazy.chunkSize - 1;
+	std::size_t sliceSize = std::size_t(m_WXY);
 
-	// get pointer to original data
-	DataType *original = m_Data;
+	DataType* chunk = lazy.chunks[c].load(std::memory_order_acquire);
+	if (chunk == NULL)
+	{
+		std::lock_guard<std::mutex> lock(lazy.mutex);
+		chunk = lazy.chunks[c].load(std::memory_order_relaxed);
+		if (chunk == NULL)
+		{
+			// the slices of the chunk and the slices before and after it
+			chunk = new DataType[(lazy.chunkSize + 2) * sliceSize]();
+			for (int z = std::max(zFirst, 0); z < std::min(zFirst + lazy.chunkSize + 2, m_WZ); ++z)
+				computeSlice(*lazy.source, lazy.filter, lazy.frameWidth, z, chunk + (z - zFirst) * sliceSize);
+			lazy.chunks[c].store(chunk, std::memory_order_release);
+		}
+	}
 
+	return chunk + (lZ - zFirst) * sliceSize + std::size_t(m_WX)*lY + lX;
+}
 
-	DataType *data = newData;
-	int sizeFrameZ = lTxy * frameWidth;
 
-	// frame Z upper
-	for(int i=0; i<sizeFrameZ; i++)
-	{
-		*data++ = Zero;
-	}
+template< typename  DataType >
+void Image<DataType>::computeSlice(const Image<DataType>& src, SliceFilter filter, int frameWidth, int z, DataType* dest) const
+{
+	DataType Zero = DataType();
 
-	int nbsl = lTz - 2*frameWidth;
-	for(int i=0; i<nbsl; i++)
+	if (filter == FILTER_FRAME)
 	{
-		int sizeFrameY = lTx*frameWidth;
-		// frame Y upper
-		for(int j=0; j<sizeFrameY; j++)
+		int sz = z - frameWidth;
+		if ((sz < 0) || (sz >= src.m_WZ))
 		{
-			*data++ = Zero;
+			std::fill(dest, dest + m_WXY, Zero);
+			return;
 		}
 
-		int nbrow = lTy - 2*frameWidth;
-		for(int k=0; k<nbrow; k++)
+		// frame Y upper, rows of the source with their X frames, frame Y lower
+		DataType* data = std::fill_n(dest, m_WX*frameWidth, Zero);
+		for (int y = 0; y < src.m_WY; ++y)
 		{
-			// frame X upper
-			for(int l=0; l< frameWidth; l++)
-			{
-				*data++ = Zero;
-			}
-
-			// copy original Data
-			int nbcol = lTx - 2*frameWidth;
-			for(int l=0; l<nbcol; l++)
-			{
-				*data++ = *original++;
-			}
+			data = std::fill_n(data, frameWidth, Zero);
+			const DataType* original = src.getVoxelPtr(0, y, sz);
+			data = std::copy(original, original + src.m_WX, data);
+			data = std::fill_n(data, frameWidth, Zero);
+		}
+		std::fill_n(data, m_WX*frameWidth, Zero);
+		return;
+	}
 
-			// frame X lower
-			for(int l=0; l< frameWidth; l++)
-			{
-				*data++ = Zero;
-			}
+	// FILTER_BLUR3: voxels of the border are copied
+	int txm = m_WX-1;
+	int tym = m_WY-1;
 
+	if ((z == 0) || (z == m_WZ-1))
+	{
+		for (int y = 0; y <= tym; ++y)
+		{
+			const DataType* original = src.getVoxelPtr(0, y, z);
+			std::copy(original, original + m_WX, dest + y*m_WX);
 		}
+		return;
+	}
 
-		// frame Y upper
-		for(int j=0; j<sizeFrameY; j++)
+	std::copy(src.getVoxelPtr(0, 0, z), src.getVoxelPtr(0, 0, z) + m_WX, dest);
+	for (int y = 1; y < tym; ++y)
+	{
+		DataType* dst = dest + y*m_WX;
+		const DataType* ori = src.getVoxelPtr(0, y, z);
+		dst[0] = ori[0];
+		for (int x = 1; x < txm; ++x)
 		{
-			*data++ = Zero;
+			const DataType* ptr = ori + x - m_WXY - m_WX -1;
+			double val=0.0;
+			for (int i=0; i<3;++i)
+			{
+				val += (*ptr++);
+				val += (*ptr++);
+				val += (*ptr);
+				ptr += m_WX;
+				val += (*ptr--);
+				val += (*ptr--);
+				val += (*ptr);
+				ptr += m_WX;
+				val += (*ptr++);
+				val += (*ptr++);
+				val += (*ptr);
+				ptr += m_WXY -( 2+m_WX*2);
+			}
+			val += 3.0 * ori[x];
+			val /= (27.0 + 3.0);
+			dst[x] = DataType(val);
 		}
+		dst[txm] = ori[txm];
 	}
+	std::copy(src.getVoxelPtr(0, tym, z), src.getVoxelPtr(0, tym, z) + m_WX, dest + tym*m_WX);
+}
+
 
-	// frame Z lower
-	for(int i=0; i<sizeFrameZ; i++)
+template< typename  DataType >
+Image<DataType>* Image<DataType>::filteredImage(SliceFilter filter, int frameWidth, bool lazy, int chunkSize) const
+{
+	int lTx = m_WX+2*frameWidth;
+	int lTy = m_WY+2*frameWidth;
+	int lTz = m_WZ+2*frameWidth;
+	std::size_t lTxy = std::size_t(lTx)*std::size_t(lTy);
+
+	if (lazy)
 	{
-		*data++ = Zero;
+		Image<DataType>* newImg = new Image<DataType>(NULL,lTx,lTy,lTz,getVoxSizeX(),getVoxSizeY(),getVoxSizeZ());
+		// chunks of about 16 MB
+		if (chunkSize <= 0)
+			chunkSize = int(std::max(std::size_t(4), (std::size_t(1) << 24) / (lTxy*sizeof(DataType))));
+		newImg->m_Lazy = new LazySlices(this, filter, frameWidth, std::min(chunkSize, lTz), lTz);
+		return newImg;
 	}
 
+	// allocate new data
+	DataType *newData = new DataType[lTxy*lTz];
 	Image<DataType>* newImg = new Image<DataType>(newData,lTx,lTy,lTz,getVoxSizeX(),getVoxSizeY(),getVoxSizeZ());
+	newImg->m_Alloc=true;
+
+	CGoGN::Parallel::foreach_index(lTz, [&] (unsigned int z, unsigned int)
+	{
+		newImg->computeSlice(*this, filter, frameWidth, int(z), newData + z*lTxy);
+	});
+
+	return newImg;
+}
+
+
+/*
+*  add a frame of Zero to the image
+*/
+template< typename  DataType >
+Image<DataType>* Image<DataType>::addFrame(int frameWidth, bool lazy) const
+{
+	Image<DataType>* newImg = filteredImage(FILTER_FRAME, frameWidth, lazy);
 
 	// set origin of real data in image
 	newImg->setOrigin(m_OX+frameWidth, m_OY+frameWidth, m_OZ+frameWidth);
 
 	return newImg;
-
 }
 
 
@@ -615,20 +966,24 @@ template< typename  DataType >
 template< typename Windowing >
 float Image<DataType>::computeVolume(const Windowing& wind) const
 {
-	int nbv = getWidthXY()*getWidthZ();
-
-	const DataType *data = getData();
-
 	// volume in number of voxel
 	int vol=0;
 
-	for(int i=0; i<nbv; i++)
+	// row by row (data of lazy images are not contiguous)
+	for(int z=0; z<m_WZ; z++)
 	{
-		if (wind.inside(*data))
+		for(int y=0; y<m_WY; y++)
 		{
-			vol++;
+			const DataType *data = getVoxelPtr(0,y,z);
+			for(int x=0; x<m_WX; x++)
+			{
+				if (wind.inside(*data))
+				{
+					vol++;
+				}
+				data++;
+			}
 		}
-		data++;
 	}
 
 
@@ -636,70 +991,10 @@ float Image<DataType>::computeVolume(const Windowing& wind) const
 }
 
 template< typename  DataType >
-Image<DataType>* Image<DataType>::Blur3()
+Image<DataType>* Image<DataType>::Blur3(bool lazy) const
 {
-
-	int txm = m_WX-1;
-	int tym = m_WY-1;
-	int tzm = m_WZ-1;
-
-	DataType* data2 = new DataType[m_WX*m_WY*m_WZ];
-	Image<DataType>* newImg = new Image<DataType>(data2,m_WX,m_WY,m_WZ,getVoxSizeX(),getVoxSizeY(),getVoxSizeZ());
-	newImg->m_Alloc=true;
 	// set origin of real data in image ??
-
-	// for frame
-	for(int y=0; y<=tym; ++y)
-		for(int x=0; x<=txm; ++x)
-			*(newImg->getVoxelPtr(x,y,0)) = *(getVoxelPtr(x,y,0));
-
-	for(int z=1; z<tzm; ++z)
-	{
-		for(int x=0; x<=txm; ++x)
-			*(newImg->getVoxelPtr(x,0,z)) = *(getVoxelPtr(x,0,z));
-		for(int y=1; y<tym; ++y)
-		{
-			*(newImg->getVoxelPtr(0,y,z)) = *(getVoxelPtr(0,y,z));
-
-//			#pragma omp parallel for // OpenMP
-			for(int x=1; x<txm; ++x)
-			{
-				DataType* ori = getVoxelPtr(x,y,z);
-				DataType* dest = newImg->getVoxelPtr(x,y,z);
-				DataType* ptr = ori - m_WXY - m_WX -1;
-				double val=0.0;
-				for (int i=0; i<3;++i)
-				{
-					val += (*ptr++);
-					val += (*ptr++);
-					val += (*ptr);
-					ptr += m_WX;
-					val += (*ptr--);
-					val += (*ptr--);
-					val += (*ptr);
-					ptr += m_WX;
-					val += (*ptr++);
-					val += (*ptr++);
-					val += (*ptr);
-					ptr += m_WXY -( 2+m_WX*2);
-				}
-				val += 3.0 * (*ori);
-				val /= (27.0 + 3.0);
-				DataType res = DataType(val);
-				*dest= res;
-			}
-			*(newImg->getVoxelPtr(txm,y,z)) = *(getVoxelPtr(txm,y,z));
-		}
-		for(int x=0; x<=txm; ++x)
-			*(newImg->getVoxelPtr(x,tym,z)) = *(getVoxelPtr(x,tym,z));
-
-	}
-	for(int y=0; y<=tym; ++y)
-		for(int x=1; x<txm; ++x)
-			*(newImg->getVoxelPtr(x,y,tzm)) = *(getVoxelPtr(x,y,tzm));
-
-
-	return newImg;
+	return filteredImage(FILTER_BLUR3, 0, lazy);
 }
 
 //template<typename DataType>
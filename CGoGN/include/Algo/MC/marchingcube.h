@@ -28,9 +28,15 @@
 #include "Algo/MC/image.h"
 #include "Algo/MC/buffer.h"
 #include "Algo/MC/tables.h"
+#include "Algo/MC/minMaxPyramid.h"
 
 #include "Geometry/vector_gen.h"
 
+#include "Topology/generic/parallelRange.h"
+
+#include <utility>
+#include <vector>
+
 namespace CGoGN
 {
 
@@ -205,6 +211,88 @@ protected:
 
 	L_DART createTriEmb(unsigned int e1, unsigned int e2, unsigned int e3);
 
+	/**
+	* @name Slab extraction
+	* a slab is the range of cube slices [zBegin,zEnd[ meshed in its own map;
+	* vertices created on the bottom (z = zBegin) and top (z = zEnd) planes
+	* are recorded with an edge key 2*(y*WX+x)+dir (dir 0 for X edges, 1 for Y edges)
+	*/
+	//@{
+	bool m_recordSeams;
+	int m_zBegin;
+	int m_zEnd;
+	std::vector< std::pair<unsigned int, unsigned int> > m_bottomSeam;
+	std::vector< std::pair<unsigned int, unsigned int> > m_topSeam;
+
+	/**
+	* mesh the cube slices [zBegin,zEnd[ in m_map
+	*/
+	void meshSlices(int zBegin, int zEnd);
+
+	/**
+	* record a vertex created on edge _edge (0..7) of cube (_lX,_lY,_lZ) if it lies on a seam plane
+	*/
+	void storeSeamVertex(unsigned int _edge, int _lX, int _lY, int _lZ, unsigned int _vert);
+
+	/**
+	* create in m_map the vertices of a meshed slab (sequential)
+	* @param slab the meshed slab
+	* @param seamVertex vertex of m_map by edge key of the previous top seam (updated with the top seam of slab)
+	* @param isSeam flag of m_map vertices lying on a seam (updated)
+	* @param vertexOf vertex of m_map of each vertex line of the slab map (filled)
+	*/
+	void mapSlabVertices(MarchingCube<DataType, Windowing, PFP>& slab, std::vector<unsigned int>& seamVertex, std::vector<unsigned char>& isSeam, std::vector<unsigned int>& vertexOf);
+
+	/**
+	* copy the triangles of a meshed slab in faces of m_map created beforehand:
+	* embeddings, positions and phi2 links inside the slab (can be run concurrently on different slabs)
+	* @param slab the meshed slab
+	* @param vertexOf vertex of m_map of each vertex line of the slab map
+	* @param faces the faces of m_map that receive the triangles of the slab
+	* @param nbEmbeddedDarts number of darts embedded on each vertex line of the slab map (filled)
+	* @param freeDarts darts of m_map copied without phi2 neighbour (filled)
+	*/
+	void copySlabFaces(MarchingCube<DataType, Windowing, PFP>& slab, const std::vector<unsigned int>& vertexOf, const L_DART* faces, std::vector<unsigned int>& nbEmbeddedDarts, std::vector<L_DART>& freeDarts);
+
+	/**
+	* copy the darts of a meshed slab in dart lines of m_map inserted beforehand (MapMono only):
+	* relations, embeddings and positions (can be run concurrently on different slabs)
+	* @param slab the meshed slab
+	* @param vertexOf vertex of m_map of each vertex line of the slab map
+	* @param dartLines line of m_map of each dart line of the slab map
+	* @param nbEmbeddedDarts number of darts embedded on each vertex line of the slab map (filled)
+	* @param freeDarts darts of m_map copied without phi2 neighbour (filled)
+	*/
+	void copySlabDarts(MarchingCube<DataType, Windowing, PFP>& slab, const std::vector<unsigned int>& vertexOf, const std::vector<unsigned int>& dartLines, std::vector<unsigned int>& nbEmbeddedDarts, std::vector<L_DART>& freeDarts);
+
+	/**
+	* copy the positions of the vertices of a meshed slab (except those of its bottom seam)
+	*/
+	void copySlabPositions(MarchingCube<DataType, Windowing, PFP>& slab, const std::vector<unsigned int>& vertexOf);
+	//@}
+
+	/**
+	* @name Brick skipping
+	* cubes of bricks that are uniform for the windowing (computed with a MinMaxPyramid) are not processed
+	*/
+	//@{
+	const MinMaxPyramid<DataType>* m_pyramid;
+	std::vector<unsigned char> m_activeBricks;
+	unsigned int m_brickShift;
+	unsigned int m_nbBricksX;
+	unsigned int m_nbBricksXY;
+
+	/**
+	* is cube (_lX,_lY,_lZ) in an active brick
+	*/
+	inline bool activeCube(int _lX, int _lY, int _lZ) const
+	{
+		if (m_pyramid == NULL)
+			return true;
+		return m_activeBricks[(_lZ >> m_brickShift) * m_nbBricksXY + (_lY >> m_brickShift) * m_nbBricksX + (_lX >> m_brickShift)] != 0;
+	}
+	//@}
+
 public:
 	/**
 	* constructor from filename
@@ -245,6 +333,27 @@ public:
 	*/
 	void simpleMeshing();
 
+	/**
+	* parallel version of Marching Cubes algorithm:
+	* the image is cut along Z in slabs of cube slices meshed in independent maps
+	* by different threads, then the slabs are appended to the mesh and their
+	* boundaries are sewn along the shared planes. The result is the same mesh
+	* than simpleMeshing (up to the order of cells).
+	* The Z zone tagging (MC_WIDTH_EDGE_Z_EMBEDED) is not done by this version.
+	* @param nbSlabs number of slabs (0: one by task of the thread pool)
+	* @param nbth number of threads
+	*/
+	void parallelMeshing(unsigned int nbSlabs = 0, unsigned int nbth = CGoGN::Parallel::NumberOfThreads);
+
+	/**
+	* skip the bricks of the image that are entirely inside or outside for the windowing.
+	* The pyramid must have been built on the image of the marching cube and must
+	* outlive the meshing.
+	* @param pyramid the min/max pyramid of the image (NULL to process all the cubes)
+	* @return the number of active bricks (of level 0)
+	*/
+	unsigned int setPyramid(const MinMaxPyramid<DataType>* pyramid);
+
 	/**
 	 * get pointer on result mesh after processing
 	 * @return the mesh
@@ -24,7 +24,13 @@
 
 #include "Algo/MC/windowing.h"
 #include "Topology/generic/dartmarker.h"
+#include "Topology/generic/traversor/traversorCell.h"
+#include "Topology/generic/mapImpl/mapMono.h"
+#include <algorithm>
+#include <string>
+#include <type_traits>
 #include <vector>
+#include <unordered_map>
 
 namespace CGoGN
 {
@@ -80,7 +86,14 @@ MarchingCube<DataType, Windowing, PFP>::MarchingCube(Image<DataType>* img, L_MAP
 	m_positions(position),
 	m_fOrigin(VEC3(0.0,0.0,0.0)),
 	m_fScal(VEC3(1.0,1.0,1.0)),
-	m_brem(boundRemoved)
+	m_brem(boundRemoved),
+	m_recordSeams(false),
+	m_zBegin(0),
+	m_zEnd(0),
+	m_pyramid(NULL),
+	m_brickShift(0),
+	m_nbBricksX(0),
+	m_nbBricksXY(0)
 {
 	#ifdef MC_WIDTH_EDGE_Z_EMBEDED
 		m_currentZSlice = 0;
@@ -144,6 +157,17 @@ void MarchingCube<DataType, Windowing, PFP>::simpleMeshing()
 		m_map = new L_MAP();
 	}
 
+	meshSlices(0, m_Image->getWidthZ() - 1);
+
+	CGoGNout << "Taille carte:"<<m_map->getNbDarts()<<" brins"<<CGoGNendl;
+}
+
+template< typename  DataType, template < typename D2 > class Windowing, typename PFP >
+void MarchingCube<DataType, Windowing, PFP>::meshSlices(int zBegin, int zEnd)
+{
+	m_zBegin = zBegin;
+	m_zEnd = zEnd;
+
 	// create the buffer
 	if (m_Buffer != NULL)
 	{
@@ -168,18 +192,18 @@ void MarchingCube<DataType, Windowing, PFP>::simpleMeshing()
 
 	int lTx = m_Image->getWidthX();
 	int lTy = m_Image->getWidthY();
-	int lTz = m_Image->getWidthZ();
-
 
 	int lTxm = lTx - 1 ;
 	int lTym = lTy - 1;
-	int lTzm = lTz - 1;
 
 	int lZ,lY,lX;
 
+	int lTz = m_Image->getWidthZ();
+
 	lX = 0 ;
 	lY = 0 ;
-	lZ = 0 ;
+	lZ = zBegin ;
+	m_Image->prefetchSlices(lZ, std::min(lZ+3, lTz));
 	ucData = m_Image->getVoxelPtr(lX,lY,lZ);
 
 	createFaces_1(ucData++,lX++,lY,lZ,1);  // TAG
@@ -211,8 +235,11 @@ void MarchingCube<DataType, Windowing, PFP>::simpleMeshing()
 
 // middles slices
 
-	while (lZ < lTzm)
+	while (lZ < zEnd)
 	{
+		// read ahead the slice of voxels of the next cube slice
+		m_Image->prefetchSlices(std::min(lZ+2, lTz), std::min(lZ+3, lTz));
+
 		lY = 0;
 		lX = 0;
 
@@ -233,22 +260,376 @@ void MarchingCube<DataType, Windowing, PFP>::simpleMeshing()
 			createFaces_7(ucData++,lX++,lY,lZ,16); // TAG
 			while (lX < lTxm-1)
 			{
+				if (!activeCube(lX,lY,lZ))
+				{
+					// jump to the next brick
+					int next = std::min(((lX >> m_brickShift) + 1) << m_brickShift, lTxm-1);
+					ucData += next - lX;
+					lX = next;
+					continue;
+				}
 				createFaces_8(ucData++,lX++,lY,lZ,0);
 			}
 			createFaces_8(ucData++,lX,lY,lZ,32);   //TAG
 			lY++;
 		}
 
+		// voxels of slice lZ-1 are not read any more
+		m_Image->releaseSlices(lZ-1, lZ);
+
 		lZ++;
 		#ifdef MC_WIDTH_EDGE_Z_EMBEDED
 			m_currentZSlice++;
 		#endif
 		m_Buffer->nextSlice();
 	}
+}
+
+template< typename  DataType, template < typename D2 > class Windowing, typename PFP >
+unsigned int MarchingCube<DataType, Windowing, PFP>::setPyramid(const MinMaxPyramid<DataType>* pyramid)
+{
+	m_pyramid = pyramid;
+	if (pyramid == NULL)
+	{
+		m_activeBricks.clear();
+		return 0;
+	}
+
+	m_brickShift = pyramid->getBrickShift();
+	m_nbBricksX = pyramid->getNbBricksX();
+	m_nbBricksXY = pyramid->getNbBricksX() * pyramid->getNbBricksY();
+	return pyramid->activeBricks(m_windowFunc, m_activeBricks);
+}
+
+template< typename  DataType, template < typename D2 > class Windowing, typename PFP >
+void MarchingCube<DataType, Windowing, PFP>::storeSeamVertex(unsigned int _edge, int _lX, int _lY, int _lZ, unsigned int _vert)
+{
+	// edges 0..3 lie in plane _lZ, edges 4..7 in plane _lZ+1 (they receive _lZ+1)
+	if (_edge < 4)
+	{
+		if (_lZ != m_zBegin)
+			return;
+	}
+	else if (_lZ != m_zEnd)
+		return;
+
+	unsigned int dir = _edge & 1;	// 0,2,4,6: X edges / 1,3,5,7: Y edges
+	int x = _lX;
+	int y = _lY;
+	if ((_edge & 3) == 2)
+		--x;
+	else if ((_edge & 3) == 3)
+		--y;
+
+	unsigned int key = 2 * (y * m_Image->getWidthX() + x) + dir;
+	if (_edge < 4)
+		m_bottomSeam.push_back(std::make_pair(key, _vert));
+	else
+		m_topSeam.push_back(std::make_pair(key, _vert));
+}
+
+template< typename  DataType, template < typename D2 > class Windowing, typename PFP >
+void MarchingCube<DataType, Windowing, PFP>::parallelMeshing(unsigned int nbSlabs, unsigned int nbth)
+{
+	// create the mesh if needed
+	if (m_map == NULL)
+	{
+		m_map = new L_MAP();
+	}
+
+	unsigned int lTzm = m_Image->getWidthZ() - 1;
+	if (nbSlabs == 0)
+		nbSlabs = CGoGN::Parallel::nbTasksOfRange(lTzm, nbth);
+	if (nbSlabs > lTzm)
+		nbSlabs = lTzm;
+
+	if (nbSlabs < 2 || nbth < 2)
+	{
+		simpleMeshing();
+		return;
+	}
+
+	// maps and attributes are created (and destroyed) by the calling thread
+	std::vector<L_MAP*> maps(nbSlabs);
+	std::vector< VertexAttribute<VEC3, L_MAP> > positions(nbSlabs);
+	std::vector< MarchingCube<DataType, Windowing, PFP>* > slabs(nbSlabs);
+	for (unsigned int s = 0; s < nbSlabs; ++s)
+	{
+		maps[s] = new L_MAP();
+		maps[s]->setExternalThreadsAuthorization(true);
+		positions[s] = maps[s]->template addAttribute<VEC3, VERTEX, L_MAP>("position");
+		slabs[s] = new MarchingCube<DataType, Windowing, PFP>(m_Image, maps[s], positions[s], m_windowFunc, m_brem);
+		slabs[s]->m_recordSeams = true;
+		if (m_pyramid != NULL)
+		{
+			slabs[s]->m_pyramid = m_pyramid;
+			slabs[s]->m_activeBricks = m_activeBricks;
+			slabs[s]->m_brickShift = m_brickShift;
+			slabs[s]->m_nbBricksX = m_nbBricksX;
+			slabs[s]->m_nbBricksXY = m_nbBricksXY;
+		}
+	}
+
+	// relations stored in separated dart attributes: the darts of the slabs are copied at once
+	const bool bulkCopy = std::is_same<typename L_MAP::IMPL, MapMono>::value;
+
+	std::vector<unsigned int> nbFaces(nbSlabs, 0);
+	CGoGN::Parallel::foreach_index(nbSlabs, [&] (unsigned int s, unsigned int)
+	{
+		int zBegin = int((unsigned long long)(lTzm) * s / nbSlabs);
+		int zEnd = int((unsigned long long)(lTzm) * (s + 1) / nbSlabs);
+		slabs[s]->meshSlices(zBegin, zEnd);
+		if (!bulkCopy)
+			foreach_cell<FACE>(*maps[s], [&] (Face) { ++nbFaces[s]; });
+	}, nbth);
+
+	m_fOrigin = slabs[0]->m_fOrigin;
+	m_fScal = slabs[0]->m_fScal;
+
+	// vertices and faces are inserted in the containers of m_map sequentially
+	std::vector<unsigned int> seamVertex(2 * m_Image->getWidthXY(), EMBNULL);
+	std::vector<unsigned char> isSeam;
+	std::vector< std::vector<unsigned int> > vertexOf(nbSlabs);
+	for (unsigned int s = 0; s < nbSlabs; ++s)
+		mapSlabVertices(*slabs[s], seamVertex, isSeam, vertexOf[s]);
+
+	std::vector< std::vector<unsigned int> > nbEmbeddedDarts(nbSlabs);
+	std::vector< std::vector<L_DART> > freeDarts(nbSlabs);
+	if (bulkCopy)
+	{
+		// only the lines of the darts are inserted sequentially (with their markers cleared),
+		// the darts of the slabs are then copied concurrently in these lines
+		AttributeContainer& dartCont = m_map->getDartContainer();
+		std::vector< std::vector<unsigned int> > dartLines(nbSlabs);
+		for (unsigned int s = 0; s < nbSlabs; ++s)
+		{
+			const AttributeContainer& slabDartCont = maps[s]->getDartContainer();
+			dartLines[s].assign(slabDartCont.realEnd(), EMBNULL);
+			for (unsigned int i = slabDartCont.begin(); i != slabDartCont.end(); slabDartCont.next(i))
+			{
+				unsigned int line = dartCont.insertLine();
+				dartCont.initMarkersOfLine(line);
+				dartLines[s][i] = line;
+			}
+		}
+
+		CGoGN::Parallel::foreach_index(nbSlabs, [&] (unsigned int s, unsigned int)
+		{
+			copySlabDarts(*slabs[s], vertexOf[s], dartLines[s], nbEmbeddedDarts[s], freeDarts[s]);
+		}, nbth);
+	}
+	else
+	{
+		std::vector<unsigned int> firstFace(nbSlabs + 1, 0);
+		for (unsigned int s = 0; s < nbSlabs; ++s)
+			firstFace[s + 1] = firstFace[s] + nbFaces[s];
+		std::vector<L_DART> faces(firstFace[nbSlabs]);
+		for (unsigned int f = 0; f < firstFace[nbSlabs]; ++f)
+			faces[f] = m_map->newFace(3, false);
+
+		// triangles of the slabs copied concurrently
+		CGoGN::Parallel::foreach_index(nbSlabs, [&] (unsigned int s, unsigned int)
+		{
+			copySlabFaces(*slabs[s], vertexOf[s], faces.empty() ? NULL : &faces[firstFace[s]], nbEmbeddedDarts[s], freeDarts[s]);
+		}, nbth);
+	}
+
+	AttributeContainer& vertexCont = m_map->template getAttributeContainer<VERTEX>();
+	for (unsigned int s = 0; s < nbSlabs; ++s)
+	{
+		for (unsigned int i = 0; i < nbEmbeddedDarts[s].size(); ++i)
+		{
+			if (nbEmbeddedDarts[s][i] > 0)
+				vertexCont.setNbRefs(vertexOf[s][i], vertexCont.getNbRefs(vertexOf[s][i]) + nbEmbeddedDarts[s][i]);
+		}
+		delete slabs[s];
+		delete maps[s];
+	}
+	if (m_map->template getQuickTraversal<VERTEX>() != NULL)
+		m_map->template updateQuickTraversal<L_MAP, VERTEX>();
+
+	// sew the darts of the seams: the edge (v1,v2) of a slab faces the edge (v2,v1) of the next one
+	std::unordered_map<unsigned long long, L_DART> open;
+	for (unsigned int s = 0; s < nbSlabs; ++s)
+	{
+		for (typename std::vector<L_DART>::const_iterator it = freeDarts[s].begin(); it != freeDarts[s].end(); ++it)
+		{
+			unsigned int v1 = m_map->template getEmbedding<VERTEX>(*it);
+			unsigned int v2 = m_map->template getEmbedding<VERTEX>(m_map->phi1(*it));
+			if (!isSeam[v1] || !isSeam[v2])
+				continue;
+
+			typename std::unordered_map<unsigned long long, L_DART>::iterator jt = open.find((((unsigned long long)v2) << 32) | v1);
+			if (jt != open.end())
+			{
+				m_map->sewFaces(*it, jt->second, false);
+				open.erase(jt);
+			}
+			else
+				open[(((unsigned long long)v1) << 32) | v2] = *it;
+		}
+	}
 
 	CGoGNout << "Taille carte:"<<m_map->getNbDarts()<<" brins"<<CGoGNendl;
 }
 
+template< typename  DataType, template < typename D2 > class Windowing, typename PFP >
+void MarchingCube<DataType, Windowing, PFP>::mapSlabVertices(MarchingCube<DataType, Windowing, PFP>& slab, std::vector<unsigned int>& seamVertex, std::vector<unsigned char>& isSeam, std::vector<unsigned int>& vertexOf)
+{
+	L_MAP& slabMap = *slab.m_map;
+
+	// the bottom seam reuses the top seam of the previous slab
+	vertexOf.assign(slabMap.template getAttributeContainer<VERTEX>().realEnd(), EMBNULL);
+	for (typename std::vector< std::pair<unsigned int, unsigned int> >::const_iterator it = slab.m_bottomSeam.begin(); it != slab.m_bottomSeam.end(); ++it)
+		vertexOf[it->second] = seamVertex[it->first];
+
+	const AttributeContainer& slabCont = slabMap.template getAttributeContainer<VERTEX>();
+	for (unsigned int i = slabCont.begin(); i != slabCont.end(); slabCont.next(i))
+	{
+		if (vertexOf[i] == EMBNULL)
+			vertexOf[i] = m_map->template newCell<VERTEX>();
+	}
+
+	for (typename std::vector< std::pair<unsigned int, unsigned int> >::const_iterator it = slab.m_topSeam.begin(); it != slab.m_topSeam.end(); ++it)
+	{
+		unsigned int v = vertexOf[it->second];
+		seamVertex[it->first] = v;
+		if (v >= isSeam.size())
+			isSeam.resize(v + 1, 0);
+		isSeam[v] = 1;
+	}
+	isSeam.resize(m_map->template getAttributeContainer<VERTEX>().realEnd(), 0);
+}
+
+template< typename  DataType, template < typename D2 > class Windowing, typename PFP >
+void MarchingCube<DataType, Windowing, PFP>::copySlabFaces(MarchingCube<DataType, Windowing, PFP>& slab, const std::vector<unsigned int>& vertexOf, const L_DART* faces, std::vector<unsigned int>& nbEmbeddedDarts, std::vector<L_DART>& freeDarts)
+{
+	L_MAP& slabMap = *slab.m_map;
+	copySlabPositions(slab, vertexOf);
+
+	// embeddings are written directly, the references are counted by the caller
+	AttributeMultiVector<unsigned int>* vertexEmb = m_map->template getEmbeddingAttributeVector<VERTEX>();
+	nbEmbeddedDarts.assign(vertexOf.size(), 0);
+
+	unsigned int nbDartLines = slabMap.template getAttributeContainer<DART>().realEnd();
+	std::vector<L_DART> dartOf(nbDartLines, NIL);
+	std::vector<unsigned int> faceOf(nbDartLines, 0);
+	std::vector<L_DART> slabDarts;
+	slabDarts.reserve(slabMap.getNbDarts());
+
+	unsigned int f = 0;
+	foreach_cell<FACE>(slabMap, [&] (Face c)
+	{
+		L_DART d = c.dart;
+		L_DART nd = faces[f];
+		for (unsigned int k = 0; k < 3; ++k)
+		{
+			unsigned int line = slabMap.template getEmbedding<VERTEX>(d);
+			unsigned int vemb = vertexOf[line];
+			m_map->template foreach_dart_of_orbit<PFP::MAP::VERTEX_OF_PARENT>(nd, [&] (Dart dd) { (*vertexEmb)[m_map->dartIndex(dd)] = vemb; ++nbEmbeddedDarts[line]; });
+
+			unsigned int id = slabMap.dartIndex(d);
+			dartOf[id] = nd;
+			faceOf[id] = f;
+			slabDarts.push_back(d);
+			d = slabMap.phi1(d);
+			nd = m_map->phi1(nd);
+		}
+		++f;
+	});
+
+	// inner edges of the slab
+	for (typename std::vector<L_DART>::const_iterator it = slabDarts.begin(); it != slabDarts.end(); ++it)
+	{
+		unsigned int id = slabMap.dartIndex(*it);
+		unsigned int ie = slabMap.dartIndex(slabMap.phi2(*it));
+		if (ie < nbDartLines && dartOf[ie] != NIL && faceOf[ie] != faceOf[id])
+		{
+			if (id < ie)
+				m_map->sewFaces(dartOf[id], dartOf[ie], false);
+		}
+		else
+			freeDarts.push_back(dartOf[id]);
+	}
+}
+
+template< typename  DataType, template < typename D2 > class Windowing, typename PFP >
+void MarchingCube<DataType, Windowing, PFP>::copySlabPositions(MarchingCube<DataType, Windowing, PFP>& slab, const std::vector<unsigned int>& vertexOf)
+{
+	VertexAttribute<VEC3, L_MAP>& slabPositions = slab.m_positions;
+
+	// the vertices of the bottom seam are written by the previous slab
+	std::vector<unsigned char> onBottomSeam(vertexOf.size(), 0);
+	for (typename std::vector< std::pair<unsigned int, unsigned int> >::const_iterator it = slab.m_bottomSeam.begin(); it != slab.m_bottomSeam.end(); ++it)
+		onBottomSeam[it->second] = 1;
+	for (unsigned int i = slabPositions.begin(); i != slabPositions.end(); slabPositions.next(i))
+	{
+		if (!onBottomSeam[i])
+			m_positions[vertexOf[i]] = slabPositions[i];
+	}
+}
+
+template< typename  DataType, template < typename D2 > class Windowing, typename PFP >
+void MarchingCube<DataType, Windowing, PFP>::copySlabDarts(MarchingCube<DataType, Windowing, PFP>& slab, const std::vector<unsigned int>& vertexOf, const std::vector<unsigned int>& dartLines, std::vector<unsigned int>& nbEmbeddedDarts, std::vector<L_DART>& freeDarts)
+{
+	L_MAP& slabMap = *slab.m_map;
+	copySlabPositions(slab, vertexOf);
+
+	// the maps have the same type: the relations are the Dart attributes of same name,
+	// the embeddings of the other orbits than VERTEX are set to EMBNULL (as in newDart)
+	AttributeContainer& slabDartCont = slabMap.getDartContainer();
+	AttributeContainer& dartCont = m_map->getDartContainer();
+	std::vector<AttributeMultiVector<L_DART>*> slabRelations;
+	std::vector<AttributeMultiVector<L_DART>*> relations;
+	std::vector<AttributeMultiVector<unsigned int>*> nullEmbeddings;
+	AttributeMultiVector<unsigned int>* slabVertexEmb = slabMap.template getEmbeddingAttributeVector<VERTEX>();
+	AttributeMultiVector<unsigned int>* vertexEmb = m_map->template getEmbeddingAttributeVector<VERTEX>();
+
+	std::vector<std::string> names;
+	dartCont.getAttributesNames(names);
+	for (std::vector<std::string>::const_iterator it = names.begin(); it != names.end(); ++it)
+	{
+		AttributeMultiVectorGen* amv = dartCont.getVirtualDataVector(*it);
+		if (amv->getTypeName() == L_DART::CGoGNnameOfType())
+		{
+			AttributeMultiVector<L_DART>* slabRel = slabDartCont.template getDataVector<L_DART>(*it);
+			if (slabRel != NULL)
+			{
+				slabRelations.push_back(slabRel);
+				relations.push_back(static_cast<AttributeMultiVector<L_DART>*>(amv));
+			}
+		}
+		else if ((it->compare(0, 4, "EMB_") == 0) && (amv != vertexEmb))
+			nullEmbeddings.push_back(static_cast<AttributeMultiVector<unsigned int>*>(amv));
+	}
+
+	nbEmbeddedDarts.assign(vertexOf.size(), 0);
+	for (unsigned int i = slabDartCont.begin(); i != slabDartCont.end(); slabDartCont.next(i))
+	{
+		unsigned int line = dartLines[i];
+		for (unsigned int r = 0; r < relations.size(); ++r)
+			(*relations[r])[line] = L_DART(dartLines[(*slabRelations[r])[i].index]);
+		for (unsigned int e = 0; e < nullEmbeddings.size(); ++e)
+			(*nullEmbeddings[e])[line] = EMBNULL;
+
+		unsigned int v = (*slabVertexEmb)[i];
+		(*vertexEmb)[line] = vertexOf[v];
+		++nbEmbeddedDarts[v];
+	}
+
+	// darts whose phi2 is in their own face lie on the boundary of the slab
+	foreach_cell<FACE>(slabMap, [&] (Face c)
+	{
+		L_DART d = c.dart;
+		do
+		{
+			if (slabMap.sameFace(d, slabMap.phi2(d)))
+				freeDarts.push_back(L_DART(dartLines[slabMap.dartIndex(d)]));
+			d = slabMap.phi1(d);
+		} while (d != c.dart);
+	});
+}
+
 template< typename  DataType, template < typename D2 > class Windowing, typename PFP >
 unsigned char MarchingCube<DataType, Windowing, PFP>::computeIndex(const DataType* const _ucData) const
 {
@@ -309,6 +690,8 @@ void MarchingCube<DataType, Windowing, PFP>::createPointEdge0(const unsigned cha
 		lVertTable[0] = m_map->template newCell<VERTEX>();
 		m_positions[lVertTable[0]] = recalPoint(vPos,VEC3(interp, 0., 0.));
 		m_Buffer->setPointEdge0(_lX, _lY,lVertTable[0]);
+		if (m_recordSeams)
+			storeSeamVertex(0, _lX, _lY, _lZ, lVertTable[0]);
 	}
 }
 
@@ -324,6 +707,8 @@ void MarchingCube<DataType, Windowing, PFP>::createPointEdge1(const unsigned cha
 		lVertTable[1] = m_map->template newCell<VERTEX>();
 		m_positions[lVertTable[1]] = recalPoint(vPos,VEC3(1.,interp, 0.));
 		m_Buffer->setPointEdge1(_lX, _lY,lVertTable[1]);
+		if (m_recordSeams)
+			storeSeamVertex(1, _lX, _lY, _lZ, lVertTable[1]);
 	}
 }
 
@@ -339,6 +724,8 @@ void MarchingCube<DataType, Windowing, PFP>::createPointEdge2(const unsigned cha
 		lVertTable[2] = m_map->template newCell<VERTEX>();
 		m_positions[lVertTable[2]] = recalPoint(vPos,VEC3(interp, 1., 0.));
 		m_Buffer->setPointEdge2(_lX, _lY,lVertTable[2]);
+		if (m_recordSeams)
+			storeSeamVertex(2, _lX, _lY, _lZ, lVertTable[2]);
 	}
 }
 
@@ -354,6 +741,8 @@ void MarchingCube<DataType, Windowing, PFP>::createPointEdge3(const unsigned cha
 		lVertTable[3] = m_map->template newCell<VERTEX>();
 		m_positions[lVertTable[3]] = recalPoint(vPos,VEC3(0., interp, 0.));
 		m_Buffer->setPointEdge3(_lX, _lY,lVertTable[3]);
+		if (m_recordSeams)
+			storeSeamVertex(3, _lX, _lY, _lZ, lVertTable[3]);
 	}
 }
 
@@ -369,6 +758,8 @@ void MarchingCube<DataType, Windowing, PFP>::createPointEdge4(const unsigned cha
 		lVertTable[4] = m_map->template newCell<VERTEX>();
 		m_positions[lVertTable[4]] = recalPoint(vPos,VEC3(interp, 0., 1.));
 		m_Buffer->setPointEdge4(_lX, _lY,lVertTable[4]);
+		if (m_recordSeams)
+			storeSeamVertex(4, _lX, _lY, _lZ, lVertTable[4]);
 	}
 }
 
@@ -384,6 +775,8 @@ void MarchingCube<DataType, Windowing, PFP>::createPointEdge5(const unsigned cha
 		lVertTable[5] = m_map->template newCell<VERTEX>();
 		m_positions[lVertTable[5]] = recalPoint(vPos,VEC3(1., interp, 1.));
 		m_Buffer->setPointEdge5(_lX, _lY,lVertTable[5]);
+		if (m_recordSeams)
+			storeSeamVertex(5, _lX, _lY, _lZ, lVertTable[5]);
 	}
 }
 
@@ -399,6 +792,8 @@ void MarchingCube<DataType, Windowing, PFP>::createPointEdge6(const unsigned cha
 		lVertTable[6] = m_map->template newCell<VERTEX>();
 		m_positions[lVertTable[6]] = recalPoint(vPos,VEC3(interp, 1., 1.));
 		m_Buffer->setPointEdge6(_lX, _lY,lVertTable[6]);
+		if (m_recordSeams)
+			storeSeamVertex(6, _lX, _lY, _lZ, lVertTable[6]);
 	}
 }
 
@@ -414,6 +809,8 @@ void MarchingCube<DataType, Windowing, PFP>::createPointEdge7(const unsigned cha
 		lVertTable[7] = m_map->template newCell<VERTEX>();
 		m_positions[lVertTable[7]] = recalPoint(vPos,VEC3(0., interp, 1.));
 		m_Buffer->setPointEdge7(_lX, _lY,lVertTable[7]);
+		if (m_recordSeams)
+			storeSeamVertex(7, _lX, _lY, _lZ, lVertTable[7]);
 	}
 }
 
@@ -480,6 +877,9 @@ void MarchingCube<DataType, Windowing, PFP>::createPointEdge11(const unsigned ch
 template< typename  DataType, template < typename D2 > class Windowing, typename PFP >
 void MarchingCube<DataType, Windowing, PFP>::createFaces_1(DataType *vox, const int _lX, const int _lY, const int _lZ, unsigned char tag)
 {
+	if (!activeCube(_lX, _lY, _lZ))
+		return;
+
 	unsigned char ucCubeIndex = computeIndex(vox);
 	if ((ucCubeIndex == 0) || (ucCubeIndex == 255))
 		return;
@@ -542,6 +942,9 @@ void MarchingCube<DataType, Windowing, PFP>::createFaces_1(DataType *vox, const
 template< typename  DataType, template < typename D2 > class Windowing, typename PFP >
 void MarchingCube<DataType, Windowing, PFP>::createFaces_2(DataType *vox, const int _lX, const int _lY, const int _lZ, unsigned char tag)
 {
+	if (!activeCube(_lX, _lY, _lZ))
+		return;
+
 	unsigned char ucCubeIndex = computeIndex(vox);
 	if ((ucCubeIndex == 0) || (ucCubeIndex == 255))
 		return;
@@ -593,6 +996,9 @@ void MarchingCube<DataType, Windowing, PFP>::createFaces_2(DataType *vox, const
 template< typename  DataType, template < typename D2 > class Windowing, typename PFP >
 void MarchingCube<DataType, Windowing, PFP>::createFaces_3(DataType *vox, const int _lX, const int _lY, const int _lZ, unsigned char tag)
 {
+	if (!activeCube(_lX, _lY, _lZ))
+		return;
+
 	unsigned char ucCubeIndex = computeIndex(vox);
 	if ((ucCubeIndex == 0) || (ucCubeIndex == 255))
 		return;
@@ -645,6 +1051,9 @@ void MarchingCube<DataType, Windowing, PFP>::createFaces_3(DataType *vox, const
 template< typename  DataType, template < typename D2 > class Windowing, typename PFP >
 void MarchingCube<DataType, Windowing, PFP>::createFaces_4(DataType *vox, const int _lX, const int _lY, const int _lZ, unsigned char tag)
 {
+	if (!activeCube(_lX, _lY, _lZ))
+		return;
+
 	unsigned char ucCubeIndex = computeIndex(vox);
 	if ((ucCubeIndex == 0) || (ucCubeIndex == 255))
 		return;
@@ -700,6 +1109,9 @@ void MarchingCube<DataType, Windowing, PFP>::createFaces_4(DataType *vox, const
 template< typename  DataType, template < typename D2 > class Windowing, typename PFP >
 void MarchingCube<DataType, Windowing, PFP>::createFaces_5(DataType *vox, const int _lX, const int _lY, const int _lZ, unsigned char tag)
 {
+	if (!activeCube(_lX, _lY, _lZ))
+		return;
+
 	unsigned char ucCubeIndex = computeIndex(vox);
 	if ((ucCubeIndex == 0) || (ucCubeIndex == 255))
 		return;
@@ -753,6 +1165,9 @@ void MarchingCube<DataType, Windowing, PFP>::createFaces_5(DataType *vox, const
 template< typename  DataType, template < typename D2 > class Windowing, typename PFP >
 void MarchingCube<DataType, Windowing, PFP>::createFaces_6(DataType *vox, const int _lX, const int _lY, const int _lZ, unsigned char tag)
 {
+	if (!activeCube(_lX, _lY, _lZ))
+		return;
+
 	unsigned char ucCubeIndex = computeIndex(vox);
 	if ((ucCubeIndex == 0) || (ucCubeIndex == 255))
 		return;
@@ -811,6 +1226,9 @@ void MarchingCube<DataType, Windowing, PFP>::createFaces_6(DataType *vox, const
 template< typename  DataType, template < typename D2 > class Windowing, typename PFP >
 void MarchingCube<DataType, Windowing, PFP>::createFaces_7(DataType *vox, const int _lX, const int _lY, const int _lZ, unsigned char tag)
 {
+	if (!activeCube(_lX, _lY, _lZ))
+		return;
+
 	unsigned char ucCubeIndex = computeIndex(vox);
 	if ((ucCubeIndex == 0) || (ucCubeIndex == 255))
 		return;
@@ -869,6 +1287,9 @@ void MarchingCube<DataType, Windowing, PFP>::createFaces_7(DataType *vox, const
 template< typename  DataType, template < typename D2 > class Windowing, typename PFP >
 void MarchingCube<DataType, Windowing, PFP>::createFaces_8(DataType *vox, const int _lX, const int _lY, const int _lZ, unsigned char tag)
 {
+	if (!activeCube(_lX, _lY, _lZ))
+		return;
+
 	unsigned char ucCubeIndex = computeIndex(vox);
 	if ((ucCubeIndex == 0) || (ucCubeIndex == 255))
 		return;
@@ -956,15 +1377,19 @@ void MarchingCube<DataType, Windowing, PFP>::setNeighbour(L_DART d1, L_DART d2)
 }
 
 template< typename  DataType, template < typename D2 > class Windowing, typename PFP >
-void MarchingCube<DataType, Windowing, PFP>::createLocalFaces(const unsigned char _ucCubeIndex, int _lX, int _lY, int /*_lZ*/,  unsigned int  const *_lVertTable, const unsigned short _usMask, float /*curv*/, unsigned char /*tag*/)
+void MarchingCube<DataType, Windowing, PFP>::createLocalFaces(const unsigned char _ucCubeIndex, int _lX, int _lY, int _lZ,  unsigned int  const *_lVertTable, const unsigned short _usMask, float /*curv*/, unsigned char /*tag*/)
 {
-// TODO parametre _LZ not used => a supprimer ?
 // TODO parametre curv not used => a supprimer ?
 // TODO parametre tag not used => a supprimer ?
 	
-	#define EVENMASK	0x55
 	#define ODDMASK	0xAA
 
+// faces of the cube whose neighbours are already in the buffer:
+// the bottom face (code 16) of the first slice of a slab is sewn later
+	unsigned char evenMask = 0x55;
+	if (m_recordSeams && _lZ == m_zBegin)
+		evenMask &= ~16;
+
 // initialize number of created face to 0
 	int lNumFaces = 0;
 
@@ -1028,7 +1453,7 @@ void MarchingCube<DataType, Windowing, PFP>::createLocalFaces(const unsigned cha
 				break;
 			default: // -1
 				unsigned char ucCodeEdgeFace = accelMCTable::m_EdgeCode[lIndexP1] & accelMCTable::m_EdgeCode[lIndexP2];
-				if (ucCodeEdgeFace & EVENMASK)	// the edge has a neighbour
+				if (ucCodeEdgeFace & evenMask)	// the edge has a neighbour
 				{
 					L_DART neighbour = m_Buffer->getExternalNeighbour(lIndexP1 , _lX, _lY);	// get neighbour from buffer
 					setNeighbour(edge,neighbour);
@@ -1057,7 +1482,7 @@ void MarchingCube<DataType, Windowing, PFP>::createLocalFaces(const unsigned cha
 				break;
 			default: // -1
 				unsigned char ucCodeEdgeFace = accelMCTable::m_EdgeCode[lIndexP2] & accelMCTable::m_EdgeCode[lIndexP3];
-				if (ucCodeEdgeFace & EVENMASK)	// the edge has a neighbour
+				if (ucCodeEdgeFace & evenMask)	// the edge has a neighbour
 				{
 					L_DART neighbour = m_Buffer->getExternalNeighbour(lIndexP2 , _lX, _lY);	// get neighbour from buffer
 					setNeighbour(edge,neighbour);
@@ -1086,7 +1511,7 @@ void MarchingCube<DataType, Windowing, PFP>::createLocalFaces(const unsigned cha
 				break;
 			default: // -1
 				unsigned char ucCodeEdgeFace = accelMCTable::m_EdgeCode[lIndexP3] & accelMCTable::m_EdgeCode[lIndexP1];
-				if (ucCodeEdgeFace & EVENMASK)	// the edge has a neighbour
+				if (ucCodeEdgeFace & evenMask)	// the edge has a neighbour
 				{
 					L_DART neighbour = m_Buffer->getExternalNeighbour(lIndexP3 , _lX, _lY);	// get neighbour from buffer
 					setNeighbour(edge,neighbour);
@@ -1151,7 +1576,6 @@ void MarchingCube<DataType, Windowing, PFP>::createLocalFaces(const unsigned cha
 // 		lFacesTab[i] = m_map->end();
 // 	}
 
-	#undef EVENMASK
 	#undef ODDMASK
 }
 
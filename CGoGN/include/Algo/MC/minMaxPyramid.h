@@ -0,0 +1,129 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef MINMAXPYRAMID_H
+#define MINMAXPYRAMID_H
+
+#include "Algo/MC/image.h"
+
+#include "Topology/generic/parallelRange.h"
+
+#include <vector>
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Surface
+{
+
+namespace MC
+{
+
+/**
+ * Min/max pyramid of the bricks of a voxel image
+ *
+ * Level 0 cuts the cubes of the image (between voxel centers) in bricks of
+ * brickSize^3 cubes and stores the min and max values of the voxels of each
+ * brick (its brickSize+1 voxels wide corners included). Level l+1 groups the
+ * bricks of level l by 2x2x2, up to one brick.
+ * The image is read once, by slices of bricks, so that a mapped image
+ * (Image::loadRaw(filename, true)) is streamed.
+ *
+ * @param DataType the type of voxel image
+ */
+template <typename DataType>
+class MinMaxPyramid
+{
+protected:
+	unsigned int m_brickShift;
+
+	/// number of bricks along X, Y and Z of each level
+	std::vector<unsigned int> m_nbX;
+	std::vector<unsigned int> m_nbY;
+	std::vector<unsigned int> m_nbZ;
+
+	/// min and max values of the bricks of each level
+	std::vector< std::vector<DataType> > m_min;
+	std::vector< std::vector<DataType> > m_max;
+
+	inline unsigned int index(unsigned int level, unsigned int bx, unsigned int by, unsigned int bz) const
+	{
+		return (bz * m_nbY[level] + by) * m_nbX[level] + bx;
+	}
+
+	template <typename Windowing>
+	unsigned int markActive(const Windowing& wind, unsigned int level, unsigned int bx, unsigned int by, unsigned int bz, std::vector<unsigned char>& active) const;
+
+public:
+	/**
+	 * build the pyramid
+	 * @param img the voxel image
+	 * @param brickSize number of cubes of the edge of a brick (rounded to a power of two)
+	 * @param nbth number of threads
+	 */
+	MinMaxPyramid(const Image<DataType>& img, unsigned int brickSize = 8, unsigned int nbth = CGoGN::Parallel::NumberOfThreads);
+
+	unsigned int getNbLevels() const { return (unsigned int)(m_min.size()); }
+
+	unsigned int getBrickSize() const { return 1u << m_brickShift; }
+
+	/**
+	 * log2 of the brick size: the brick of cube x is x >> getBrickShift()
+	 */
+	unsigned int getBrickShift() const { return m_brickShift; }
+
+	unsigned int getNbBricksX(unsigned int level = 0) const { return m_nbX[level]; }
+	unsigned int getNbBricksY(unsigned int level = 0) const { return m_nbY[level]; }
+	unsigned int getNbBricksZ(unsigned int level = 0) const { return m_nbZ[level]; }
+
+	DataType getMin(unsigned int level, unsigned int bx, unsigned int by, unsigned int bz) const { return m_min[level][index(level, bx, by, bz)]; }
+
+	DataType getMax(unsigned int level, unsigned int bx, unsigned int by, unsigned int bz) const { return m_max[level][index(level, bx, by, bz)]; }
+
+	/**
+	 * compute the bricks of level 0 that can contain a part of the surface:
+	 * the pyramid is descended from its top, skipping the bricks that are
+	 * uniform for the windowing (see Windowing::uniform)
+	 * @param wind the windowing
+	 * @param active flag of each brick of level 0, index (bz*nbY + by)*nbX + bx (filled)
+	 * @return the number of active bricks
+	 */
+	template <typename Windowing>
+	unsigned int activeBricks(const Windowing& wind, std::vector<unsigned char>& active) const;
+};
+
+} // namespace MC
+
+} // namespace Surface
+
+} // namespace Algo
+
+} // namespace CGoGN
+
+#include "Algo/MC/minMaxPyramid.hpp"
+
+#endif
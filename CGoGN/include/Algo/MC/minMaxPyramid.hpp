@@ -0,0 +1,175 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include <algorithm>
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Surface
+{
+
+namespace MC
+{
+
+template <typename DataType>
+MinMaxPyramid<DataType>::MinMaxPyramid(const Image<DataType>& img, unsigned int brickSize, unsigned int nbth):
+	m_brickShift(0)
+{
+	while ((2u << m_brickShift) <= brickSize)
+		++m_brickShift;
+	const int bs = 1 << m_brickShift;
+
+	const int wx = img.getWidthX();
+	const int wy = img.getWidthY();
+	const int wz = img.getWidthZ();
+
+	// level 0: bricks of cubes (wx-1 cubes along X)
+	m_nbX.push_back((std::max(wx - 1, 1) + bs - 1) >> m_brickShift);
+	m_nbY.push_back((std::max(wy - 1, 1) + bs - 1) >> m_brickShift);
+	m_nbZ.push_back((std::max(wz - 1, 1) + bs - 1) >> m_brickShift);
+	const unsigned int nbXY = m_nbX[0] * m_nbY[0];
+	m_min.push_back(std::vector<DataType>(nbXY * m_nbZ[0]));
+	m_max.push_back(std::vector<DataType>(nbXY * m_nbZ[0]));
+
+	// one slice of bricks after the other
+	for (unsigned int bz = 0; bz < m_nbZ[0]; ++bz)
+	{
+		const int z0 = int(bz) * bs;
+		const int z1 = std::min(z0 + bs, wz - 1);
+		img.prefetchSlices(z1 + 1, std::min(z1 + bs + 1, wz));
+
+		CGoGN::Parallel::foreach_index(nbXY, [&] (unsigned int i, unsigned int)
+		{
+			const int x0 = int(i % m_nbX[0]) * bs;
+			const int y0 = int(i / m_nbX[0]) * bs;
+			const int x1 = std::min(x0 + bs, wx - 1);
+			const int y1 = std::min(y0 + bs, wy - 1);
+
+			const DataType* first = img.getVoxelPtr(x0, y0, z0);
+			DataType vmin = *first;
+			DataType vmax = *first;
+			for (int z = z0; z <= z1; ++z)
+			{
+				for (int y = y0; y <= y1; ++y)
+				{
+					const DataType* ptr = img.getVoxelPtr(x0, y, z);
+					for (int x = x0; x <= x1; ++x, ++ptr)
+					{
+						if (*ptr < vmin)
+							vmin = *ptr;
+						if (vmax < *ptr)
+							vmax = *ptr;
+					}
+				}
+			}
+			m_min[0][bz * nbXY + i] = vmin;
+			m_max[0][bz * nbXY + i] = vmax;
+		}, nbth);
+
+		// the first slice of voxels of the brick is the last one of the previous slice of bricks
+		img.releaseSlices(z0, z1);
+	}
+
+	// upper levels
+	while (m_nbX.back() > 1 || m_nbY.back() > 1 || m_nbZ.back() > 1)
+	{
+		const unsigned int l = getNbLevels() - 1;
+		m_nbX.push_back((m_nbX[l] + 1) / 2);
+		m_nbY.push_back((m_nbY[l] + 1) / 2);
+		m_nbZ.push_back((m_nbZ[l] + 1) / 2);
+		m_min.push_back(std::vector<DataType>(m_nbX[l + 1] * m_nbY[l + 1] * m_nbZ[l + 1]));
+		m_max.push_back(std::vector<DataType>(m_nbX[l + 1] * m_nbY[l + 1] * m_nbZ[l + 1]));
+
+		for (unsigned int bz = 0; bz < m_nbZ[l + 1]; ++bz)
+		{
+			for (unsigned int by = 0; by < m_nbY[l + 1]; ++by)
+			{
+				for (unsigned int bx = 0; bx < m_nbX[l + 1]; ++bx)
+				{
+					unsigned int first = index(l, 2 * bx, 2 * by, 2 * bz);
+					DataType vmin = m_min[l][first];
+					DataType vmax = m_max[l][first];
+					for (unsigned int z = 2 * bz; z < std::min(2 * bz + 2, m_nbZ[l]); ++z)
+					{
+						for (unsigned int y = 2 * by; y < std::min(2 * by + 2, m_nbY[l]); ++y)
+						{
+							for (unsigned int x = 2 * bx; x < std::min(2 * bx + 2, m_nbX[l]); ++x)
+							{
+								unsigned int j = index(l, x, y, z);
+								if (m_min[l][j] < vmin)
+									vmin = m_min[l][j];
+								if (vmax < m_max[l][j])
+									vmax = m_max[l][j];
+							}
+						}
+					}
+					m_min[l + 1][index(l + 1, bx, by, bz)] = vmin;
+					m_max[l + 1][index(l + 1, bx, by, bz)] = vmax;
+				}
+			}
+		}
+	}
+}
+
+template <typename DataType>
+template <typename Windowing>
+unsigned int MinMaxPyramid<DataType>::markActive(const Windowing& wind, unsigned int level, unsigned int bx, unsigned int by, unsigned int bz, std::vector<unsigned char>& active) const
+{
+	unsigned int i = index(level, bx, by, bz);
+	if (wind.uniform(m_min[level][i], m_max[level][i]))
+		return 0;
+
+	if (level == 0)
+	{
+		active[i] = 1;
+		return 1;
+	}
+
+	unsigned int nb = 0;
+	for (unsigned int z = 2 * bz; z < std::min(2 * bz + 2, m_nbZ[level - 1]); ++z)
+		for (unsigned int y = 2 * by; y < std::min(2 * by + 2, m_nbY[level - 1]); ++y)
+			for (unsigned int x = 2 * bx; x < std::min(2 * bx + 2, m_nbX[level - 1]); ++x)
+				nb += markActive(wind, level - 1, x, y, z, active);
+	return nb;
+}
+
+template <typename DataType>
+template <typename Windowing>
+unsigned int MinMaxPyramid<DataType>::activeBricks(const Windowing& wind, std::vector<unsigned char>& active) const
+{
+	active.assign(m_nbX[0] * m_nbY[0] * m_nbZ[0], 0);
+	return markActive(wind, getNbLevels() - 1, 0, 0, 0, active);
+}
+
+} // namespace MC
+
+} // namespace Surface
+
+} // namespace Algo
+
+} // namespace CGoGN
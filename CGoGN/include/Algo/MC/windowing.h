@@ -49,6 +49,7 @@ namespace MC
  * and minimum interface are function
  * - inside
  * - interpole
+ * - uniform (only needed for skipping of bricks with a MinMaxPyramid)
  *
  */
 template<class DataType>
@@ -92,6 +93,14 @@ public:
 		m_min = min;
 		m_max = max;
 	}
+
+	/**
+	 * @return true if all values of [vmin,vmax] are inside or all are outside
+	 * (default: unknown, false)
+	 */
+	bool uniform(DataType /*vmin*/, DataType /*vmax*/) const {
+		return false;
+	}
 };
 
 /**
@@ -126,6 +135,14 @@ public:
     float interpole(DataType /*val1*/, DataType /*val2*/) const {
 		return 0.5f;
 	}
+
+	/**
+	 * @return true if all values of [vmin,vmax] are inside or all are outside
+	 * (values are not supposed ordered, as for vector images: only a constant range is uniform)
+	 */
+	bool uniform(DataType vmin, DataType vmax) const {
+		return vmin == vmax;
+	}
 };
 
 /**
@@ -161,6 +178,14 @@ public:
 	float interpole(DataType, DataType) const {
 		return 0.5f;
 	}
+
+	/**
+	 * @return true if all values of [vmin,vmax] are inside or all are outside
+	 * (values are not supposed ordered, as for vector images: only a constant range is uniform)
+	 */
+	bool uniform(DataType vmin, DataType vmax) const {
+		return vmin == vmax;
+	}
 };
 
 /**
@@ -195,6 +220,13 @@ public:
 	float interpole(DataType val1, DataType val2) const {
 		return  static_cast<float>(this->m_value - val1) / static_cast<float>(val2 - val1);
 	}
+
+	/**
+	 * @return true if all values of [vmin,vmax] are inside or all are outside
+	 */
+	bool uniform(DataType vmin, DataType vmax) const {
+		return (vmin >= this->m_value) || (vmax < this->m_value);
+	}
 };
 
 /**
@@ -229,6 +261,13 @@ public:
 	float interpole(DataType val1, DataType val2) const {
 		return  static_cast<float>(this->m_value - val1) / static_cast<float>(val2 - val1);
 	}
+
+	/**
+	 * @return true if all values of [vmin,vmax] are inside or all are outside
+	 */
+	bool uniform(DataType vmin, DataType vmax) const {
+		return (vmax <= this->m_value) || (vmin > this->m_value);
+	}
 };
 
 
@@ -277,6 +316,13 @@ public:
 		}
 		return static_cast<float>(this->m_max - val2) / static_cast<float>(val1 - val2);
 	}
+
+	/**
+	 * @return true if all values of [vmin,vmax] are inside or all are outside
+	 */
+	bool uniform(DataType vmin, DataType vmax) const {
+		return (vmax < this->m_min) || (vmin > this->m_max) || ((vmin >= this->m_min) && (vmax <= this->m_max));
+	}
 };
 
 }
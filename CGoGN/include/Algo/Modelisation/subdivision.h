@@ -204,6 +204,37 @@ void computeBoundaryConstraintDual(typename PFP::MAP& map, VertexAttribute<typen
 template <typename PFP>
 void computeBoundaryConstraintKeepingOldVerticesDual(typename PFP::MAP& map, VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position);
 
+namespace Parallel
+{
+
+/*
+ * two-phase versions of the subdivision schemes, same result as the sequential ones:
+ * - the new points (edge, face and vertex points) are computed in parallel on the
+ *   control mesh and stored in preallocated tables. The vertex points that the sequential
+ *   versions update in place from already moved neighbours (all of them for Loop, the
+ *   boundary ones for Catmull-Clark) are computed in the same order, in place.
+ * - the darts and cells are created sequentially in the order of the sequential version,
+ *   then the darts are linked and embedded in parallel (Map2::cutEdgeWithDarts and
+ *   Map2::splitFaceWithDarts, one task by edge then by face)
+ * When edges or faces are embedded, the topology is built with the embedded operators
+ * of the map (sequentially). Maps that are not 2-maps, and open maps for Loop, use the
+ * sequential versions.
+ */
+
+/**
+ * Catmull-Clark subdivision scheme
+ */
+template <typename PFP, typename EMBV>
+void CatmullClarkSubdivision(typename PFP::MAP& map, EMBV& attributs, unsigned int nbth = CGoGN::Parallel::NumberOfThreads) ;
+
+/**
+ * Loop subdivision scheme
+ */
+template <typename PFP, typename EMBV>
+void LoopSubdivision(typename PFP::MAP& map, EMBV& attributs, unsigned int nbth = CGoGN::Parallel::NumberOfThreads) ;
+
+} // namespace Parallel
+
 } // namespace Modelisation
 
 } // namespace Surface
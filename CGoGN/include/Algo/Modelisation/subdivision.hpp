@@ -25,6 +25,11 @@
 #include "Algo/Geometry/basic.h"
 #include "Algo/Geometry/centroid.h"
 #include "Topology/generic/autoAttributeHandler.h"
+#include "Topology/generic/parallelRange.h"
+#include "Topology/map/map2.h"
+
+#include <atomic>
+#include <type_traits>
 
 
 namespace CGoGN
@@ -1180,6 +1185,545 @@ void computeBoundaryConstraintKeepingOldVerticesDual(typename PFP::MAP& map, Ver
 	}
 }
 
+namespace Parallel
+{
+
+/**
+ * cells of the control mesh, in the order of the sequential subdivisions
+ */
+template <typename MAP>
+struct ControlCells
+{
+	std::vector<Dart> edges;				// smallest non boundary dart of each edge (order of the cuts)
+	std::vector<Dart> faces;				// smallest dart of each non boundary face
+	std::vector<unsigned int> edgeOfDart;	// dart index -> index in edges
+	std::vector<unsigned int> faceOfDart;	// non boundary dart index -> index in faces
+	std::vector<Dart> vertices;				// first dart of each vertex line in the order of the cuts
+
+	ControlCells(MAP& map, unsigned int nbth);
+};
+
+/**
+ * darts d of the map such that select(d), in index order
+ */
+template <typename MAP, typename FUNC>
+void selectDarts(MAP& map, FUNC select, std::vector<Dart>& darts, unsigned int nbth)
+{
+	const AttributeContainer& cont = map.getDartContainer();
+	const unsigned int nb = cont.realEnd();
+
+	std::vector< std::vector<Dart> > selected(CGoGN::Parallel::nbTasksOfRange(nb, nbth));
+	CGoGN::Parallel::foreach_index(nb, [&] (unsigned int i, unsigned int task)
+	{
+		if (cont.used(i) && select(Dart(i)))
+			selected[task].push_back(Dart(i));
+	}, nbth);
+
+	unsigned int nbSelected = 0;
+	for (unsigned int t = 0; t < selected.size(); ++t)
+		nbSelected += (unsigned int)(selected[t].size());
+	darts.clear();
+	darts.reserve(nbSelected);
+	for (unsigned int t = 0; t < selected.size(); ++t)
+		darts.insert(darts.end(), selected[t].begin(), selected[t].end());
+}
+
+template <typename MAP>
+ControlCells<MAP>::ControlCells(MAP& map, unsigned int nbth)
+{
+	selectDarts(map, [&] (Dart d) -> bool
+	{
+		if (map.template isBoundaryMarked<2>(d))
+			return false;
+		Dart e = map.phi2(d);
+		return map.template isBoundaryMarked<2>(e) || d.index < e.index;
+	}, edges, nbth);
+
+	selectDarts(map, [&] (Dart d) -> bool
+	{
+		if (map.template isBoundaryMarked<2>(d))
+			return false;
+		for (Dart it = map.phi1(d); it != d; it = map.phi1(it))
+		{
+			if (it.index < d.index)
+				return false;
+		}
+		return true;
+	}, faces, nbth);
+
+	const unsigned int nbEdges = (unsigned int)(edges.size());
+	edgeOfDart.resize(map.getDartContainer().realEnd());
+	CGoGN::Parallel::foreach_index(nbEdges, [&] (unsigned int k, unsigned int)
+	{
+		edgeOfDart[edges[k].index] = k;
+		edgeOfDart[map.phi2(edges[k]).index] = k;
+	}, nbth);
+
+	faceOfDart.resize(map.getDartContainer().realEnd());
+	CGoGN::Parallel::foreach_index((unsigned int)(faces.size()), [&] (unsigned int f, unsigned int)
+	{
+		Dart it = faces[f];
+		do
+		{
+			faceOfDart[it.index] = f;
+			it = map.phi1(it);
+		} while (it != faces[f]);
+	}, nbth);
+
+	// the first dart of a vertex line is the first one met when cutting the edges (d then phi2(d))
+	std::vector< std::atomic<unsigned int> > first(map.template getAttributeContainer<VERTEX>().realEnd());
+	CGoGN::Parallel::foreach_index((unsigned int)(first.size()), [&] (unsigned int i, unsigned int)
+	{
+		first[i].store(EMBNULL, std::memory_order_relaxed);
+	}, nbth);
+	CGoGN::Parallel::foreach_index(2 * nbEdges, [&] (unsigned int key, unsigned int)
+	{
+		Dart x = (key & 1) ? map.phi2(edges[key >> 1]) : edges[key >> 1];
+		std::atomic<unsigned int>& f = first[map.template getEmbedding<VERTEX>(x)];
+		unsigned int current = f.load(std::memory_order_relaxed);
+		while (key < current && !f.compare_exchange_weak(current, key, std::memory_order_relaxed))
+			;
+	}, nbth);
+
+	std::vector< std::vector<Dart> > selected(CGoGN::Parallel::nbTasksOfRange(2 * nbEdges, nbth));
+	CGoGN::Parallel::foreach_index(2 * nbEdges, [&] (unsigned int key, unsigned int task)
+	{
+		Dart x = (key & 1) ? map.phi2(edges[key >> 1]) : edges[key >> 1];
+		if (first[map.template getEmbedding<VERTEX>(x)].load(std::memory_order_relaxed) == key)
+			selected[task].push_back(x);
+	}, nbth);
+	for (unsigned int t = 0; t < selected.size(); ++t)
+		vertices.insert(vertices.end(), selected[t].begin(), selected[t].end());
+}
+
+/**
+ * cut the edges of the control mesh in the order of cells.edges
+ * @param edgeDarts a dart of the new vertex of each edge
+ * @param edgeVertices the vertex line of the new vertex of each edge
+ * @param bulk darts created first then linked and embedded in parallel
+ */
+template <typename MAP>
+void cutEdges(MAP& map, const ControlCells<MAP>& cells, std::vector<Dart>& edgeDarts, std::vector<unsigned int>& edgeVertices, bool bulk, unsigned int nbth)
+{
+	const unsigned int nbEdges = (unsigned int)(cells.edges.size());
+	edgeDarts.resize(nbEdges);
+	edgeVertices.resize(nbEdges);
+
+	if (!bulk)
+	{
+		for (unsigned int k = 0; k < nbEdges; ++k)
+		{
+			edgeDarts[k] = map.cutEdge(cells.edges[k]);
+			edgeVertices[k] = map.template getEmbedding<VERTEX>(edgeDarts[k]);
+		}
+		return;
+	}
+
+	std::vector<Dart> oppositeDarts(nbEdges);
+	for (unsigned int k = 0; k < nbEdges; ++k)
+	{
+		edgeDarts[k] = map.newCycle(1);
+		oppositeDarts[k] = map.newCycle(1);
+		if (map.template isBoundaryMarked<2>(map.phi2(cells.edges[k])))
+			map.template boundaryMark<2>(oppositeDarts[k]);
+		edgeVertices[k] = map.template newCell<VERTEX>();
+	}
+
+	AttributeMultiVector<unsigned int>* vertexEmb = map.template getEmbeddingAttributeVector<VERTEX>();
+	CGoGN::Parallel::foreach_index(nbEdges, [&] (unsigned int k, unsigned int)
+	{
+		map.cutEdgeWithDarts(cells.edges[k], edgeDarts[k], oppositeDarts[k]);
+		(*vertexEmb)[edgeDarts[k].index] = edgeVertices[k];
+		(*vertexEmb)[oppositeDarts[k].index] = edgeVertices[k];
+	}, nbth);
+}
+
+/**
+ * split the face of d between d and e with the darts dd and ee and embed them
+ * (as the splitFace of the embedded maps)
+ */
+template <typename MAP>
+inline void splitFaceWithDarts(MAP& map, AttributeMultiVector<unsigned int>* vertexEmb, Dart d, Dart e, Dart dd, Dart ee)
+{
+	map.splitFaceWithDarts(d, e, dd, ee);
+	(*vertexEmb)[dd.index] = (*vertexEmb)[e.index];
+	(*vertexEmb)[ee.index] = (*vertexEmb)[d.index];
+}
+
+/**
+ * add the references of the darts of the vertices of the given darts to their (new) lines
+ * and update the quick traversal of the vertices if needed
+ */
+template <typename MAP>
+void refNewVertices(MAP& map, const std::vector<Dart>& vertexDarts, unsigned int nbth)
+{
+	AttributeContainer& vertexCont = map.template getAttributeContainer<VERTEX>();
+	CGoGN::Parallel::foreach_index((unsigned int)(vertexDarts.size()), [&] (unsigned int i, unsigned int)
+	{
+		unsigned int nb = 0;
+		map.foreach_dart_of_orbit(Vertex(vertexDarts[i]), [&] (Dart) { ++nb; });
+		unsigned int emb = map.template getEmbedding<VERTEX>(vertexDarts[i]);
+		vertexCont.setNbRefs(emb, vertexCont.getNbRefs(emb) + nb);
+	}, nbth);
+
+	if (map.template getQuickTraversal<VERTEX>() != NULL)
+		map.template updateQuickTraversal<MAP, VERTEX>();
+}
+
+template <typename PFP, typename EMBV>
+void CatmullClarkSubdivision(typename PFP::MAP& map, EMBV& attributs, unsigned int, std::false_type)
+{
+	Algo::Surface::Modelisation::CatmullClarkSubdivision<PFP, EMBV>(map, attributs);
+}
+
+template <typename PFP, typename EMBV>
+void CatmullClarkSubdivision(typename PFP::MAP& map, EMBV& attributs, unsigned int nbth, std::true_type)
+{
+	typedef typename PFP::MAP MAP;
+	typedef typename EMBV::DATA_TYPE EMB;
+
+	if (std::is_same<typename MAP::IMPL, MapMulti>::value || map.getDartContainer().hasBrowser())
+	{
+		Algo::Surface::Modelisation::CatmullClarkSubdivision<PFP, EMBV>(map, attributs);
+		return;
+	}
+
+	ControlCells<MAP> cells(map, nbth);
+	const unsigned int nbEdges = (unsigned int)(cells.edges.size());
+	const unsigned int nbFaces = (unsigned int)(cells.faces.size());
+	const unsigned int nbVertices = (unsigned int)(cells.vertices.size());
+
+	// first phase: face, edge and vertex points
+
+	std::vector<EMB> facePoints(nbFaces);
+	std::vector<unsigned int> faceBegin(nbFaces + 1);	// darts created in face f: [faceBegin[f], faceBegin[f+1][
+	faceBegin[0] = 0;
+	CGoGN::Parallel::foreach_index(nbFaces, [&] (unsigned int f, unsigned int)
+	{
+		EMB center(0.0);
+		unsigned int count = 0 ;
+		Dart it = cells.faces[f];
+		do
+		{
+			center += attributs[it];
+			++count ;
+			it = map.phi1(it);
+		} while(it != cells.faces[f]);
+		center /= float(count);
+		facePoints[f] = center;
+		faceBegin[f + 1] = 2 * count;
+	}, nbth);
+	for (unsigned int f = 0; f < nbFaces; ++f)
+		faceBegin[f + 1] += faceBegin[f];
+
+	std::vector<EMB> edgePoints(nbEdges);
+	CGoGN::Parallel::foreach_index(nbEdges, [&] (unsigned int k, unsigned int)
+	{
+		Dart d = cells.edges[k];
+		Dart e = map.phi2(d);
+		EMB& p = edgePoints[k];
+		p = attributs[d];
+		p += attributs[map.phi1(d)];
+		p *= 0.5;
+		if (!map.template isBoundaryMarked<2>(e))
+			p += (facePoints[cells.faceOfDart[d.index]] + facePoints[cells.faceOfDart[e.index]]) / 4.0 - (p / 2.0);
+	}, nbth);
+
+	auto vertexPoint = [&] (Dart v, bool& boundary) -> EMB
+	{
+		EMB sumFace(0.0);
+		EMB sumEdge(0.0);
+		int n = 0;
+		boundary = false;
+		Dart x = v;
+		do
+		{
+			// in a hole, the face point is the next vertex
+			if (map.template isBoundaryMarked<2>(x))
+			{
+				sumFace += attributs[map.phi1(x)];
+				boundary = true;
+			}
+			else
+				sumFace += facePoints[cells.faceOfDart[x.index]];
+			sumEdge += edgePoints[cells.edgeOfDart[x.index]];
+			++n;
+			x = map.phi2_1(x);
+		} while (x != v);
+
+		EMB deltaV = attributs[v] * float(-3*n);
+		deltaV += sumFace;
+		deltaV += 2.0*sumEdge;
+		deltaV /= float(n*n);
+
+		EMB p = attributs[v];
+		p += deltaV;
+		return p;
+	};
+
+	std::vector<EMB> vertexPoints(nbVertices);
+	std::vector<unsigned char> boundaryVertices(nbVertices, 0);
+	CGoGN::Parallel::foreach_index(nbVertices, [&] (unsigned int i, unsigned int)
+	{
+		bool boundary;
+		EMB p = vertexPoint(cells.vertices[i], boundary);
+		if (boundary)
+			boundaryVertices[i] = 1;
+		else
+			vertexPoints[i] = p;
+	}, nbth);
+
+	// as in the sequential version, a boundary vertex reads its neighbours
+	// along the hole once they are moved: they are computed in order, in place
+	for (unsigned int i = 0; i < nbVertices; ++i)
+	{
+		if (boundaryVertices[i])
+		{
+			bool boundary;
+			vertexPoints[i] = vertexPoint(cells.vertices[i], boundary);
+			attributs[cells.vertices[i]] = vertexPoints[i];
+		}
+	}
+
+	// second phase: topology
+
+	const bool bulk = !map.template isOrbitEmbedded<EDGE>() && !map.template isOrbitEmbedded<FACE>();
+
+	std::vector<Dart> edgeDarts;
+	std::vector<unsigned int> edgeVertices;
+	std::vector<Dart> faceDarts(nbFaces);
+	std::vector<unsigned int> faceVertices(nbFaces);
+
+	if (bulk)
+	{
+		// creation of the darts and vertex lines in the order of the sequential version
+		std::vector<Dart> newDarts;
+		cutEdges(map, cells, edgeDarts, edgeVertices, true, nbth);
+		newDarts.resize(faceBegin[nbFaces]);
+		for (unsigned int f = 0; f < nbFaces; ++f)
+		{
+			for (unsigned int j = faceBegin[f]; j < faceBegin[f + 1]; ++j)
+				newDarts[j] = map.newCycle(1);
+			faceVertices[f] = map.template newCell<VERTEX>();
+		}
+
+		// quadrangulation of the faces (see quadranguleFace)
+		AttributeMultiVector<unsigned int>* vertexEmb = map.template getEmbeddingAttributeVector<VERTEX>();
+		CGoGN::Parallel::foreach_index(nbFaces, [&] (unsigned int f, unsigned int)
+		{
+			const Dart* nd = &newDarts[faceBegin[f]];
+			Dart d = map.phi1(cells.faces[f]);
+			splitFaceWithDarts(map, vertexEmb, d, map.template phi<11>(d), nd[0], nd[1]);
+			map.cutEdgeWithDarts(map.phi_1(d), nd[2], nd[3]);
+			(*vertexEmb)[nd[2].index] = faceVertices[f];
+			(*vertexEmb)[nd[3].index] = faceVertices[f];
+			Dart x = map.phi2(map.phi_1(d));
+			Dart dd = map.template phi<1111>(x);
+			unsigned int j = 4;
+			while(dd != x)
+			{
+				Dart next = map.template phi<11>(dd);
+				splitFaceWithDarts(map, vertexEmb, dd, map.phi1(x), nd[j], nd[j + 1]);
+				j += 2;
+				dd = next;
+			}
+			assert(j == faceBegin[f + 1] - faceBegin[f]);
+			faceDarts[f] = nd[2];
+		}, nbth);
+
+		refNewVertices(map, edgeDarts, nbth);
+		refNewVertices(map, faceDarts, nbth);
+	}
+	else
+	{
+		cutEdges(map, cells, edgeDarts, edgeVertices, false, nbth);
+		for (unsigned int f = 0; f < nbFaces; ++f)
+		{
+			faceDarts[f] = quadranguleFace<PFP>(map, cells.faces[f]);
+			faceVertices[f] = map.template getEmbedding<VERTEX>(faceDarts[f]);
+		}
+	}
+
+	// new points
+	CGoGN::Parallel::foreach_index(nbFaces, [&] (unsigned int f, unsigned int)
+	{
+		attributs[faceVertices[f]] = facePoints[f];
+	}, nbth);
+	CGoGN::Parallel::foreach_index(nbEdges, [&] (unsigned int k, unsigned int)
+	{
+		attributs[edgeVertices[k]] = edgePoints[k];
+	}, nbth);
+	CGoGN::Parallel::foreach_index(nbVertices, [&] (unsigned int i, unsigned int)
+	{
+		attributs[cells.vertices[i]] = vertexPoints[i];
+	}, nbth);
+}
+
+template <typename PFP, typename EMBV>
+void CatmullClarkSubdivision(typename PFP::MAP& map, EMBV& attributs, unsigned int nbth)
+{
+	typedef typename PFP::MAP MAP;
+	CatmullClarkSubdivision<PFP, EMBV>(map, attributs, nbth, std::is_base_of<Map2<typename MAP::IMPL>, MAP>());
+}
+
+template <typename PFP, typename EMBV>
+void LoopSubdivision(typename PFP::MAP& map, EMBV& attributs, unsigned int, std::false_type)
+{
+	Algo::Surface::Modelisation::LoopSubdivision<PFP, EMBV>(map, attributs);
+}
+
+template <typename PFP, typename EMBV>
+void LoopSubdivision(typename PFP::MAP& map, EMBV& attributs, unsigned int nbth, std::true_type)
+{
+	typedef typename PFP::MAP MAP;
+	typedef typename EMBV::DATA_TYPE EMB;
+
+	if (std::is_same<typename MAP::IMPL, MapMulti>::value || map.getDartContainer().hasBrowser())
+	{
+		Algo::Surface::Modelisation::LoopSubdivision<PFP, EMBV>(map, attributs);
+		return;
+	}
+
+	ControlCells<MAP> cells(map, nbth);
+	const unsigned int nbEdges = (unsigned int)(cells.edges.size());
+	const unsigned int nbFaces = (unsigned int)(cells.faces.size());
+	const unsigned int nbVertices = (unsigned int)(cells.vertices.size());
+
+	// the sequential version also splits the holes, which is not done here
+	for (unsigned int k = 0; k < nbEdges; ++k)
+	{
+		if (map.template isBoundaryMarked<2>(map.phi2(cells.edges[k])))
+		{
+			Algo::Surface::Modelisation::LoopSubdivision<PFP, EMBV>(map, attributs);
+			return;
+		}
+	}
+
+	// first phase: edge and vertex points
+
+	std::vector<EMB> edgePoints(nbEdges);
+	CGoGN::Parallel::foreach_index(nbEdges, [&] (unsigned int k, unsigned int)
+	{
+		Dart d = cells.edges[k];
+		Dart e = map.phi2(d);
+		EMB& p = edgePoints[k];
+		p = attributs[d];
+		p += attributs[map.phi1(d)];
+		p *= 0.5;
+		if (!map.template isBoundaryMarked<2>(e))
+		{
+			p *= 0.75;
+			EMB temp = attributs[map.phi1(map.phi1(d))];
+			temp += attributs[map.phi_1(e)];
+			temp *= 1.0 / 8.0;
+			p += temp;
+		}
+	}, nbth);
+
+	// as in the sequential version, the vertex rule is applied in place:
+	// a vertex reads the neighbours already moved, so they are computed in order
+	for (unsigned int i = 0; i < nbVertices; ++i)
+	{
+		Dart v = cells.vertices[i];
+		EMB temp(0.0);
+		int n = 0;
+		Dart x = v;
+		do
+		{
+			temp += attributs[map.phi1(x)];
+			++n;
+			x = map.phi2_1(x);
+		} while (x != v);
+		EMB emcp = attributs[v];
+		if (n == 6)
+		{
+			temp /= 16.0;
+			emcp *= 10.0/16.0;
+			emcp += temp;
+		}
+		else
+		{
+			double beta = betaF(n) ;
+			temp *= (beta / double(n));
+			emcp *= (1.0f - beta);
+			emcp += temp;
+		}
+		attributs[v] = emcp;
+	}
+
+	// second phase: topology
+
+	const bool bulk = !map.template isOrbitEmbedded<EDGE>() && !map.template isOrbitEmbedded<FACE>();
+
+	std::vector<Dart> edgeDarts;
+	std::vector<unsigned int> edgeVertices;
+	cutEdges(map, cells, edgeDarts, edgeVertices, bulk, nbth);
+
+	// the faces are split from their first new dart, by increasing index
+	std::vector<Dart> faceDarts(nbFaces);
+	CGoGN::Parallel::foreach_index(nbFaces, [&] (unsigned int f, unsigned int)
+	{
+		Dart first = map.phi1(cells.faces[f]);
+		for (Dart it = map.template phi<11>(first); it != first; it = map.template phi<11>(it))
+		{
+			if (it.index < first.index)
+				first = it;
+		}
+		faceDarts[f] = first;
+	}, nbth);
+	CGoGN::Parallel::sort(faceDarts, nbth);
+
+	if (bulk)
+	{
+		std::vector<Dart> newDarts(6 * nbFaces);
+		for (unsigned int j = 0; j < 6 * nbFaces; ++j)
+			newDarts[j] = map.newCycle(1);
+
+		AttributeMultiVector<unsigned int>* vertexEmb = map.template getEmbeddingAttributeVector<VERTEX>();
+		CGoGN::Parallel::foreach_index(nbFaces, [&] (unsigned int f, unsigned int)
+		{
+			const Dart* nd = &newDarts[6 * f];
+			Dart dd = faceDarts[f];
+			for (unsigned int j = 0; j < 6; j += 2)
+			{
+				Dart e = map.template phi<11>(dd);
+				splitFaceWithDarts(map, vertexEmb, dd, e, nd[j], nd[j + 1]);
+				dd = e;
+			}
+		}, nbth);
+
+		refNewVertices(map, edgeDarts, nbth);
+	}
+	else
+	{
+		for (unsigned int f = 0; f < nbFaces; ++f)
+		{
+			Dart dd = faceDarts[f];
+			for (unsigned int j = 0; j < 3; ++j)
+			{
+				Dart e = map.template phi<11>(dd);
+				map.splitFace(dd, e);
+				dd = e;
+			}
+		}
+	}
+
+	// new points
+	CGoGN::Parallel::foreach_index(nbEdges, [&] (unsigned int k, unsigned int)
+	{
+		attributs[edgeVertices[k]] = edgePoints[k];
+	}, nbth);
+}
+
+template <typename PFP, typename EMBV>
+void LoopSubdivision(typename PFP::MAP& map, EMBV& attributs, unsigned int nbth)
+{
+	typedef typename PFP::MAP MAP;
+	LoopSubdivision<PFP, EMBV>(map, attributs, nbth, std::is_base_of<Map2<typename MAP::IMPL>, MAP>());
+}
+
+} // namespace Parallel
+
 } // namespace Modelisation
 
 } // namespace Surface
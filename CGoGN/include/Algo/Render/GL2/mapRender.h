@@ -29,15 +29,19 @@
 
 #include <vector>
 #include <list>
+#include <algorithm>
 #include <set>
+#include <map>
 #include <utility>
 
 #include "Utils/gl_def.h"
 #include "Topology/generic/dart.h"
 #include "Topology/generic/functor.h"
 #include "Topology/generic/attributeHandler.h"
+#include "Topology/generic/traversor/traversorCell.h"
 #include "Container/convert.h"
 #include "Geometry/vector_gen.h"
+#include "Algo/Render/vertexCache.h"
 
 // forward definition
 namespace CGoGN { namespace Utils { class GLSLShader; } }
@@ -163,71 +167,221 @@ protected:
 	 * @param tableIndices the indices table
 	 */
 	template <typename PFP>
-	void addTri(typename PFP::MAP& map, Face f, std::vector<GLuint>& tableIndices) ;
+	static void addTri(typename PFP::MAP& map, Face f, std::vector<GLuint>& tableIndices) ;
 
 	template<typename PFP>
-	inline void addEarTri(typename PFP::MAP& map, Face f, std::vector<GLuint>& tableIndices, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>* position);
+	static inline void addEarTri(typename PFP::MAP& map, Face f, std::vector<GLuint>& tableIndices, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>* position);
+
+	/**
+	 * triangles of a face (ear triangulation of the polygonal faces if position is given)
+	 */
+	template<typename PFP>
+	static inline void addFace(typename PFP::MAP& map, Face f, std::vector<GLuint>& tableIndices, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>* position);
 
 	template<typename PFP>
-	float computeEarAngle(const typename PFP::VEC3& P1, const typename PFP::VEC3& P2, const typename PFP::VEC3& P3, const typename PFP::VEC3& normalPoly);
+	static float computeEarAngle(const typename PFP::VEC3& P1, const typename PFP::VEC3& P2, const typename PFP::VEC3& P3, const typename PFP::VEC3& normalPoly);
 
 	template<typename PFP>
-	bool computeEarIntersection(const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, VertexPoly* vp, const typename PFP::VEC3& normalPoly);
+	static bool computeEarIntersection(const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, VertexPoly* vp, const typename PFP::VEC3& normalPoly);
 
 	template<typename PFP>
-	void recompute2Ears(const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, VertexPoly* vp, const typename PFP::VEC3& normalPoly, VPMS& ears, bool convex);
+	static void recompute2Ears(const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position, VertexPoly* vp, const typename PFP::VEC3& normalPoly, VPMS& ears, bool convex);
 
 	template<typename VEC3>
-	bool inTriangle(const VEC3& P, const VEC3& normal, const VEC3& Ta, const VEC3& Tb, const VEC3& Tc);
+	static bool inTriangle(const VEC3& P, const VEC3& normal, const VEC3& Ta, const VEC3& Tb, const VEC3& Tc);
+
+	/**
+	 * fill tableIndices with the indices that addCell(cell, indices) gives for each cell of ORBIT.
+	 * With nbth > 1 the cells are dealt by ranges (tasks) to the threads, each task fills
+	 * its own buffer and the buffers are concatenated in the order of the tasks
+	 */
+	template <unsigned int ORBIT, typename MAP, typename FUNC>
+	static void buildIndices(MAP& map, std::vector<GLuint>& tableIndices, FUNC addCell, TraversalOptim opt, unsigned int nbth) ;
+
+public:
+	/**
+	 * CPU table of the triangles of the faces, patched face by face after local modifications.
+	 * Each face owns a slot (contiguous range of indices); the slot of a modified face is
+	 * rewritten in place when the number of triangles does not change, otherwise it is
+	 * filled with degenerated triangles and the new triangles take a free slot of the same
+	 * size or are appended. The table is compacted when the dead indices outnumber the others.
+	 */
+	class CGoGN_ALGO_API TriangleTable
+	{
+		/// indices of the triangles
+		std::vector<GLuint> m_indices ;
+
+		/// first index and number of indices of each slot
+		std::vector<unsigned int> m_slotBegin ;
+		std::vector<unsigned int> m_slotNb ;
+
+		/// generation of each slot (incremented when the slot is released)
+		std::vector<unsigned int> m_slotGen ;
+
+		/// released slots by size
+		std::map<unsigned int, std::vector<unsigned int> > m_freeSlots ;
+
+		/// slot and generation of the face of each dart (indexed by dart index)
+		std::vector< std::pair<unsigned int, unsigned int> > m_dartSlot ;
+
+		/// darts of the faces to triangulate at next update
+		std::vector<Dart> m_dirty ;
+
+		unsigned int m_nbDeadIndices ;
+
+		/// ranges of indices modified since the last call to clearModifications
+		std::vector< std::pair<unsigned int, unsigned int> > m_modified ;
+		bool m_allModified ;
+
+		void releaseSlot(unsigned int slot) ;
+
+		unsigned int newSlot(unsigned int nb) ;
+
+		void compact() ;
+
+		template <typename MAP>
+		void releaseFaceSlots(MAP& map, Face f) ;
+
+	public:
+		TriangleTable() : m_nbDeadIndices(0), m_allModified(true) {}
+
+		/**
+		 * (re)build the table by a traversal of the faces of the map
+		 * @param position if not NULL, polygonal faces are ear triangulated
+		 * @param nbth number of threads
+		 */
+		template <typename PFP>
+		void init(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>* position, unsigned int nbth = CGoGN::Parallel::NumberOfThreads) ;
+
+		/**
+		 * face f has been created or modified (it is triangulated at next update).
+		 * All the faces that share the darts of a modified face must be notified.
+		 */
+		template <typename MAP>
+		void setFaceDirty(MAP& map, Face f) ;
+
+		/**
+		 * face f is going to be removed (to call before the removal)
+		 */
+		template <typename MAP>
+		void setFaceRemoved(MAP& map, Face f) ;
+
+		/**
+		 * triangulate the dirty faces and patch the table
+		 */
+		template <typename PFP>
+		void update(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>* position) ;
+
+		const std::vector<GLuint>& indices() const { return m_indices ; }
+
+		unsigned int nbDeadIndices() const { return m_nbDeadIndices ; }
+
+		/// true if the whole table must be transfered (init, compaction)
+		bool allModified() const { return m_allModified ; }
+
+		/// sorted disjoint ranges [begin, end[ of modified indices
+		std::vector< std::pair<unsigned int, unsigned int> > modifiedRanges() const ;
+
+		void clearModifications() ;
+	} ;
+
+protected:
+	/// incremental triangles (NULL if not enabled)
+	TriangleTable* m_triangleTable ;
+
+	/// transfer the modified parts of the triangle table in the TRIANGLES VBO
+	void uploadTriangleTable() ;
+
+	/// size of the vertex cache the triangles are reordered for (0: no reordering)
+	unsigned int m_vertexCacheSize ;
 
 public:
 	/**
 	 * creation of indices table of triangles (optimized order)
 	 * @param tableIndices the table where indices are stored
+	 * @param nbth number of threads of the non optimized version (optimized order is sequential)
 	 */
 	template <typename PFP>
-	void initTriangles(typename PFP::MAP& map, std::vector<GLuint>& tableIndices, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>* position) ;
+	static void initTriangles(typename PFP::MAP& map, std::vector<GLuint>& tableIndices, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>* position, unsigned int nbth = CGoGN::Parallel::NumberOfThreads) ;
 	template <typename PFP>
-	void initTrianglesOptimized(typename PFP::MAP& map, std::vector<GLuint>& tableIndices, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>* position) ;
+	static void initTrianglesOptimized(typename PFP::MAP& map, std::vector<GLuint>& tableIndices, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>* position) ;
 
 	/**
 	 * creation of indices table of lines (optimized order)
 	 * @param tableIndices the table where indices are stored
 	 */
 	template <typename PFP>
-	void initLines(typename PFP::MAP& map, std::vector<GLuint>& tableIndices) ;
+	static void initLines(typename PFP::MAP& map, std::vector<GLuint>& tableIndices, unsigned int nbth = CGoGN::Parallel::NumberOfThreads) ;
 	template <typename PFP>
-	void initLinesOptimized(typename PFP::MAP& map, std::vector<GLuint>& tableIndices) ;
+	static void initLinesOptimized(typename PFP::MAP& map, std::vector<GLuint>& tableIndices) ;
 
 	/**
 	 * creation of indices table of points
 	 * @param tableIndices the table where indices are stored
 	 */
 	template <typename PFP>
-	void initPoints(typename PFP::MAP& map, std::vector<GLuint>& tableIndices) ;
+	static void initPoints(typename PFP::MAP& map, std::vector<GLuint>& tableIndices, unsigned int nbth = CGoGN::Parallel::NumberOfThreads) ;
 
 	/**
 	 * creation of indices table of points
 	 * @param tableIndices the table where indices are stored
 	 */
 	template <typename PFP>
-	void initBoundaries(typename PFP::MAP& map, std::vector<GLuint>& tableIndices) ;
+	static void initBoundaries(typename PFP::MAP& map, std::vector<GLuint>& tableIndices, unsigned int nbth = CGoGN::Parallel::NumberOfThreads) ;
 	/**
 	 * initialization of the VBO indices primitives
 	 * computed by a traversal of the map
 	 * @param prim primitive to draw: POINTS, LINES, TRIANGLES
 	 */
 	template <typename PFP>
-	void initPrimitives(typename PFP::MAP& map, int prim, bool optimized = true) ;
+	void initPrimitives(typename PFP::MAP& map, int prim, bool optimized = true, unsigned int nbth = CGoGN::Parallel::NumberOfThreads) ;
 
 	template <typename PFP>
-	void initPrimitives(typename PFP::MAP& map, int prim, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>* position, bool optimized = true) ;
+	void initPrimitives(typename PFP::MAP& map, int prim, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>* position, bool optimized = true, unsigned int nbth = CGoGN::Parallel::NumberOfThreads) ;
 
 	/**
 	 * add primitives to the VBO of indices
 	 */
 	template <typename PFP>
-	void addPrimitives(typename PFP::MAP& map, int prim, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>* position, bool optimized = true);
+	void addPrimitives(typename PFP::MAP& map, int prim, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>* position, bool optimized = true, unsigned int nbth = CGoGN::Parallel::NumberOfThreads);
+
+	/**
+	 * incremental mode of the TRIANGLES primitive: the triangles are kept in a TriangleTable,
+	 * the modified faces are notified (setFaceDirty / setFaceRemoved) and only the modified
+	 * ranges of the VBO are updated by updateTriangles. initPrimitives(TRIANGLES) rebuilds the table.
+	 */
+	template <typename PFP>
+	void enableIncrementalTriangles(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>* position = NULL, unsigned int nbth = CGoGN::Parallel::NumberOfThreads) ;
+
+	void disableIncrementalTriangles() ;
+
+	bool isIncrementalTriangles() const { return m_triangleTable != NULL ; }
+
+	/**
+	 * face f has been created or modified
+	 * (without incremental mode the TRIANGLES primitive is set dirty)
+	 */
+	template <typename MAP>
+	void setFaceDirty(MAP& map, Face f) ;
+
+	/**
+	 * face f is going to be removed
+	 */
+	template <typename MAP>
+	void setFaceRemoved(MAP& map, Face f) ;
+
+	/**
+	 * triangulate the notified faces and patch the TRIANGLES VBO
+	 */
+	template <typename PFP>
+	void updateTriangles(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>* position = NULL) ;
+
+	/**
+	 * reorder the triangles of the TRIANGLES primitive built by initPrimitives / addPrimitives
+	 * for the post-transform vertex cache (see Algo::Render::VertexCache)
+	 * @param cacheSize size of the vertex cache (0 to disable)
+	 */
+	void setVertexCacheOptimization(unsigned int cacheSize) { m_vertexCacheSize = cacheSize ; }
 
 	/**
 	 * initialization of the VBO indices primitives
@@ -302,27 +302,60 @@ inline void MapRender::addTri(typename PFP::MAP& map, Face f, std::vector<GLuint
 }
 
 template<typename PFP>
-void MapRender::initTriangles(typename PFP::MAP& map, std::vector<GLuint>& tableIndices, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>* position)
+inline void MapRender::addFace(typename PFP::MAP& map, Face f, std::vector<GLuint>& tableIndices, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>* position)
 {
-	tableIndices.reserve(4 * map.getNbDarts() / 3);
+	if(position == NULL || map.faceDegree(f) == 3)
+		addTri<PFP>(map, f, tableIndices);
+	else
+		addEarTri<PFP>(map, f, tableIndices, position);
+}
 
-	if(position == NULL)
+template <unsigned int ORBIT, typename MAP, typename FUNC>
+void MapRender::buildIndices(MAP& map, std::vector<GLuint>& tableIndices, FUNC addCell, TraversalOptim opt, unsigned int nbth)
+{
+	if (nbth < 2)
 	{
-		foreach_cell<FACE>(map, [&] (Face f)
+		foreach_cell<ORBIT>(map, [&] (Cell<ORBIT> c)
 		{
-			addTri<PFP>(map, f, tableIndices);
-		}, AUTO);
+			addCell(c, tableIndices);
+		}, opt);
+		return;
 	}
-	else
+
+	nbth = Parallel::checkNbThreads(nbth);
+	unsigned int nbTasks = (nbth - 1) * Parallel::NB_TASKS_PER_THREAD;
+	std::vector< std::vector<GLuint> > taskIndices(nbTasks);
+	for (unsigned int t = 0; t < nbTasks; ++t)
+		taskIndices[t].reserve(tableIndices.capacity() / nbTasks);
+
+	Parallel::foreach_cell_tasks<ORBIT>(map, [&] (Cell<ORBIT> c, unsigned int, unsigned int task)
 	{
-		foreach_cell<FACE>(map, [&] (Face f)
-		{
-			if(map.faceDegree(f) == 3)
-				addTri<PFP>(map, f, tableIndices);
-			else
-				addEarTri<PFP>(map, f, tableIndices, position);
-		}, AUTO);
-	}
+		addCell(c, taskIndices[task]);
+	}, opt, nbth - 1);
+
+	// concatenation of the buffers of the tasks
+	std::vector<unsigned int> offsets(nbTasks + 1);
+	offsets[0] = (unsigned int)(tableIndices.size());
+	for (unsigned int t = 0; t < nbTasks; ++t)
+		offsets[t + 1] = offsets[t] + (unsigned int)(taskIndices[t].size());
+	tableIndices.resize(offsets[nbTasks]);
+
+	Parallel::getThreadPool(nbth - 1).exec(nbTasks, [&] (unsigned int task, unsigned int)
+	{
+		std::copy(taskIndices[task].begin(), taskIndices[task].end(), tableIndices.begin() + offsets[task]);
+		std::vector<GLuint>().swap(taskIndices[task]);
+	}, nbth - 1);
+}
+
+template<typename PFP>
+void MapRender::initTriangles(typename PFP::MAP& map, std::vector<GLuint>& tableIndices, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>* position, unsigned int nbth)
+{
+	tableIndices.reserve(4 * map.getNbDarts() / 3);
+
+	buildIndices<FACE>(map, tableIndices, [&] (Face f, std::vector<GLuint>& indices)
+	{
+		addFace<PFP>(map, f, indices, position);
+	}, AUTO, nbth);
 }
 
 template<typename PFP>
@@ -342,17 +375,7 @@ void MapRender::initTrianglesOptimized(typename PFP::MAP& map, std::vector<GLuin
 			std::list<Dart> bound;
 
 			if (!map.template isBoundaryMarked<PFP::MAP::DIMENSION>(dd))
-			{
-				if(position == NULL)
-					addTri<PFP>(map, dd, tableIndices);
-				else
-				{
-					if(map.faceDegree(dd) == 3)
-						addTri<PFP>(map, dd, tableIndices);
-					else
-						addEarTri<PFP>(map, dd, tableIndices, position);
-				}
-			}
+				addFace<PFP>(map, dd, tableIndices, position);
 			m.template markOrbit<FACE>(dd);
 			bound.push_back(dd);
 			int nb = 1;
@@ -368,17 +391,7 @@ void MapRender::initTrianglesOptimized(typename PFP::MAP& map, std::vector<GLuin
 						if (!m.isMarked(f))
 						{
 							if ( !map.template isBoundaryMarked<PFP::MAP::DIMENSION>(f))
-							{
-								if(position == NULL)
-									addTri<PFP>(map, f, tableIndices);
-								else
-								{
-									if(map.faceDegree(f) == 3)
-										addTri<PFP>(map, f, tableIndices);
-									else
-										addEarTri<PFP>(map, f, tableIndices, position);
-								}
-							}
+								addFace<PFP>(map, f, tableIndices, position);
 							m.template markOrbit<FACE>(f);
 							bound.push_back(map.phi1(f));
 							++nb;
@@ -402,35 +415,30 @@ void MapRender::initTrianglesOptimized(typename PFP::MAP& map, std::vector<GLuin
 }
 
 template<typename PFP>
-void MapRender::initLines(typename PFP::MAP& map, std::vector<GLuint>& tableIndices)
+void MapRender::initLines(typename PFP::MAP& map, std::vector<GLuint>& tableIndices, unsigned int nbth)
 {
 	tableIndices.reserve(map.getNbDarts());
 
-//	TraversorE<typename PFP::MAP> trav(map);
-	foreach_cell<EDGE>(map, [&] (Edge e)
+	buildIndices<EDGE>(map, tableIndices, [&] (Edge e, std::vector<GLuint>& indices)
 	{
-		tableIndices.push_back(map.template getEmbedding<VERTEX>(e.dart));
-		tableIndices.push_back(map.template getEmbedding<VERTEX>(map.phi1(e)));
-	}
-	,AUTO);
+		indices.push_back(map.template getEmbedding<VERTEX>(e.dart));
+		indices.push_back(map.template getEmbedding<VERTEX>(map.phi1(e)));
+	}, AUTO, nbth);
 }
 
 template<typename PFP>
-void MapRender::initBoundaries(typename PFP::MAP& map, std::vector<GLuint>& tableIndices)
+void MapRender::initBoundaries(typename PFP::MAP& map, std::vector<GLuint>& tableIndices, unsigned int nbth)
 {
 	tableIndices.reserve(map.getNbDarts()); //TODO optimisation ?
 
-//	TraversorE<typename PFP::MAP> trav(map);
-//	for (Dart d = trav.begin(); d != trav.end(); d = trav.next())
-	foreach_cell<EDGE>(map, [&] (Edge e)
+	buildIndices<EDGE>(map, tableIndices, [&] (Edge e, std::vector<GLuint>& indices)
 	{
 		if (map.isBoundaryEdge(e))
 		{
-			tableIndices.push_back(map.template getEmbedding<VERTEX>(e.dart));
-			tableIndices.push_back(map.template getEmbedding<VERTEX>(map.phi1(e)));
+			indices.push_back(map.template getEmbedding<VERTEX>(e.dart));
+			indices.push_back(map.template getEmbedding<VERTEX>(map.phi1(e)));
 		}
-	}
-	,AUTO);
+	}, AUTO, nbth);
 }
 
 template<typename PFP>
@@ -481,51 +489,58 @@ void MapRender::initLinesOptimized(typename PFP::MAP& map, std::vector<GLuint>&
 }
 
 template<typename PFP>
-void MapRender::initPoints(typename PFP::MAP& map, std::vector<GLuint>& tableIndices)
+void MapRender::initPoints(typename PFP::MAP& map, std::vector<GLuint>& tableIndices, unsigned int nbth)
 {
 	tableIndices.reserve(map.getNbDarts() / 5);
 
-//	TraversorV<typename PFP::MAP> trav(map);
-	foreach_cell<VERTEX>(map, [&] (Vertex v)
+	buildIndices<VERTEX>(map, tableIndices, [&] (Vertex v, std::vector<GLuint>& indices)
 	{
-		tableIndices.push_back(map.getEmbedding(v));
-	}
-	,FORCE_CELL_MARKING); //
+		indices.push_back(map.getEmbedding(v));
+	}, FORCE_CELL_MARKING, nbth);
 }
 
 template<typename PFP>
-void MapRender::initPrimitives(typename PFP::MAP& map, int prim, bool optimized)
+void MapRender::initPrimitives(typename PFP::MAP& map, int prim, bool optimized, unsigned int nbth)
 {
-	initPrimitives<PFP>(map, prim, NULL, optimized) ;
+	initPrimitives<PFP>(map, prim, NULL, optimized, nbth) ;
 }
 
 template <typename PFP>
-void MapRender::initPrimitives(typename PFP::MAP& map, int prim, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>* position, bool optimized)
+void MapRender::initPrimitives(typename PFP::MAP& map, int prim, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>* position, bool optimized, unsigned int nbth)
 {
+	if (prim == TRIANGLES && m_triangleTable != NULL)
+	{
+		m_triangleTable->init<PFP>(map, position, nbth);
+		uploadTriangleTable();
+		return;
+	}
+
 	std::vector<GLuint> tableIndices;
 
 	switch(prim)
 	{
 		case POINTS:
 
-			initPoints<PFP>(map, tableIndices);
+			initPoints<PFP>(map, tableIndices, nbth);
 			break;
 		case LINES:
 			if(optimized)
 				initLinesOptimized<PFP>(map, tableIndices);
 			else
-				initLines<PFP>(map, tableIndices) ;
+				initLines<PFP>(map, tableIndices, nbth) ;
 			break;
 		case TRIANGLES:
 			if(optimized)
 				initTrianglesOptimized<PFP>(map, tableIndices, position);
 			else
-				initTriangles<PFP>(map, tableIndices, position) ;
+				initTriangles<PFP>(map, tableIndices, position, nbth) ;
+			if (m_vertexCacheSize > 0)
+				VertexCache::optimizeTriangles(tableIndices, m_vertexCacheSize);
 			break;
 		case FLAT_TRIANGLES:
 			break;
 		case BOUNDARY:
-			initBoundaries<PFP>(map, tableIndices) ;
+			initBoundaries<PFP>(map, tableIndices, nbth) ;
 			break;
 		default:
 			CGoGNerr << "problem initializing VBO indices" << CGoGNendl;
@@ -544,7 +559,7 @@ void MapRender::initPrimitives(typename PFP::MAP& map, int prim, const VertexAtt
 }
 
 template <typename PFP>
-void MapRender::addPrimitives(typename PFP::MAP& map, int prim, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>* position, bool optimized)
+void MapRender::addPrimitives(typename PFP::MAP& map, int prim, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>* position, bool optimized, unsigned int nbth)
 {
 	std::vector<GLuint> tableIndices;
 
@@ -552,24 +567,26 @@ void MapRender::addPrimitives(typename PFP::MAP& map, int prim, const VertexAttr
 	{
 		case POINTS:
 
-			initPoints<PFP>(map, tableIndices);
+			initPoints<PFP>(map, tableIndices, nbth);
 			break;
 		case LINES:
 			if(optimized)
 				initLinesOptimized<PFP>(map, tableIndices);
 			else
-				initLines<PFP>(map, tableIndices) ;
+				initLines<PFP>(map, tableIndices, nbth) ;
 			break;
 		case TRIANGLES:
 			if(optimized)
 				initTrianglesOptimized<PFP>(map, tableIndices, position);
 			else
-				initTriangles<PFP>(map, tableIndices, position) ;
+				initTriangles<PFP>(map, tableIndices, position, nbth) ;
+			if (m_vertexCacheSize > 0)
+				VertexCache::optimizeTriangles(tableIndices, m_vertexCacheSize);
 			break;
 		case FLAT_TRIANGLES:
 			break;
 		case BOUNDARY:
-			initBoundaries<PFP>(map, tableIndices) ;
+			initBoundaries<PFP>(map, tableIndices, nbth) ;
 			break;
 		default:
 			CGoGNerr << "problem initializing VBO indices" << CGoGNendl;
@@ -603,6 +620,232 @@ void MapRender::addPrimitives(typename PFP::MAP& map, int prim, const VertexAttr
 	m_nbIndices[prim] += GLuint(tableIndices.size());
 }
 
+/****************************************
+ *        INCREMENTAL TRIANGLES         *
+ ****************************************/
+
+template <typename PFP>
+void MapRender::TriangleTable::init(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>* position, unsigned int nbth)
+{
+	// triangles of the faces of a task and darts of these faces
+	struct TaskFaces
+	{
+		std::vector<GLuint> indices;
+		std::vector<unsigned int> nbIndices;
+		std::vector<unsigned int> darts;
+		std::vector<unsigned int> nbDarts;
+		unsigned int maxDart;
+		TaskFaces() : maxDart(0) {}
+	};
+
+	m_indices.clear();
+	m_slotBegin.clear();
+	m_slotNb.clear();
+	m_slotGen.clear();
+	m_freeSlots.clear();
+	m_dirty.clear();
+	m_modified.clear();
+	m_nbDeadIndices = 0;
+	m_allModified = true;
+
+	unsigned int nbTasks = 1;
+	if (nbth >= 2)
+	{
+		nbth = Parallel::checkNbThreads(nbth);
+		nbTasks = (nbth - 1) * Parallel::NB_TASKS_PER_THREAD;
+	}
+	std::vector<TaskFaces> tasks(nbTasks);
+
+	auto addFaceOfTask = [&] (Face f, TaskFaces& tf)
+	{
+		unsigned int nb = (unsigned int)(tf.indices.size());
+		MapRender::addFace<PFP>(map, f, tf.indices, position);
+		tf.nbIndices.push_back((unsigned int)(tf.indices.size()) - nb);
+		nb = (unsigned int)(tf.darts.size());
+		map.foreach_dart_of_orbit(f, [&] (Dart d)
+		{
+			unsigned int i = map.dartIndex(d);
+			tf.darts.push_back(i);
+			if (i > tf.maxDart)
+				tf.maxDart = i;
+		});
+		tf.nbDarts.push_back((unsigned int)(tf.darts.size()) - nb);
+	};
+
+	if (nbth < 2)
+		foreach_cell<FACE>(map, [&] (Face f) { addFaceOfTask(f, tasks[0]); });
+	else
+		Parallel::foreach_cell_tasks<FACE>(map, [&] (Face f, unsigned int, unsigned int task) { addFaceOfTask(f, tasks[task]); }, AUTO, nbth - 1);
+
+	// offsets of the tasks in the table of indices and in the slots
+	std::vector<unsigned int> indexOffsets(nbTasks + 1, 0u);
+	std::vector<unsigned int> slotOffsets(nbTasks + 1, 0u);
+	unsigned int maxDart = 0;
+	for (unsigned int t = 0; t < nbTasks; ++t)
+	{
+		indexOffsets[t + 1] = indexOffsets[t] + (unsigned int)(tasks[t].indices.size());
+		slotOffsets[t + 1] = slotOffsets[t] + (unsigned int)(tasks[t].nbIndices.size());
+		maxDart = std::max(maxDart, tasks[t].maxDart);
+	}
+	m_indices.resize(indexOffsets[nbTasks]);
+	m_slotBegin.resize(slotOffsets[nbTasks]);
+	m_slotNb.resize(slotOffsets[nbTasks]);
+	m_slotGen.assign(slotOffsets[nbTasks], 0u);
+	m_dartSlot.assign(maxDart + 1, std::make_pair(EMBNULL, 0u));
+
+	auto fillTask = [&] (unsigned int task)
+	{
+		TaskFaces& tf = tasks[task];
+		std::copy(tf.indices.begin(), tf.indices.end(), m_indices.begin() + indexOffsets[task]);
+		unsigned int begin = indexOffsets[task];
+		unsigned int d = 0;
+		for (unsigned int k = 0; k < tf.nbIndices.size(); ++k)
+		{
+			unsigned int slot = slotOffsets[task] + k;
+			m_slotBegin[slot] = begin;
+			m_slotNb[slot] = tf.nbIndices[k];
+			begin += tf.nbIndices[k];
+			for (unsigned int e = d + tf.nbDarts[k]; d < e; ++d)
+				m_dartSlot[tf.darts[d]] = std::make_pair(slot, 0u);
+		}
+		TaskFaces().indices.swap(tf.indices);
+	};
+
+	if (nbth < 2)
+		fillTask(0);
+	else
+		Parallel::getThreadPool(nbth - 1).exec(nbTasks, [&] (unsigned int task, unsigned int) { fillTask(task); }, nbth - 1);
+}
+
+template <typename MAP>
+void MapRender::TriangleTable::releaseFaceSlots(MAP& map, Face f)
+{
+	map.foreach_dart_of_orbit(f, [&] (Dart d)
+	{
+		unsigned int i = map.dartIndex(d);
+		if (i < m_dartSlot.size())
+		{
+			std::pair<unsigned int, unsigned int>& ds = m_dartSlot[i];
+			if (ds.first != EMBNULL && m_slotGen[ds.first] == ds.second)
+				releaseSlot(ds.first);
+			ds.first = EMBNULL;
+		}
+	});
+}
+
+template <typename MAP>
+void MapRender::TriangleTable::setFaceDirty(MAP& /*map*/, Face f)
+{
+	m_dirty.push_back(f.dart);
+}
+
+template <typename MAP>
+void MapRender::TriangleTable::setFaceRemoved(MAP& map, Face f)
+{
+	releaseFaceSlots(map, f);
+
+	// the darts of the face must not be used by the next update
+	if (!m_dirty.empty())
+	{
+		std::vector<Dart> darts;
+		map.foreach_dart_of_orbit(f, [&] (Dart d) { darts.push_back(d); });
+		std::sort(darts.begin(), darts.end());
+		m_dirty.erase(std::remove_if(m_dirty.begin(), m_dirty.end(), [&] (Dart d)
+		{
+			return std::binary_search(darts.begin(), darts.end(), d);
+		}), m_dirty.end());
+	}
+}
+
+template <typename PFP>
+void MapRender::TriangleTable::update(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>* position)
+{
+	typedef typename PFP::MAP MAP;
+
+	DartMarkerStore<MAP> done(map);
+	std::vector<GLuint> triangles;
+
+	for (std::vector<Dart>::const_iterator it = m_dirty.begin(); it != m_dirty.end(); ++it)
+	{
+		if (done.isMarked(*it))
+			continue;
+
+		// the first dart of the face that is not in the boundary (as given by the traversals):
+		// the face is triangulated as by a full build
+		Dart d = NIL;
+		map.foreach_dart_of_orbit(Face(*it), [&] (Dart e)
+		{
+			if (!map.template isBoundaryMarked<MAP::DIMENSION>(e) && (d == NIL || map.dartIndex(e) < map.dartIndex(d)))
+				d = e;
+		});
+		done.template markOrbit<FACE>(*it);
+		if (d == NIL)
+			continue;
+
+		Face f(d);
+		releaseFaceSlots(map, f);
+
+		triangles.clear();
+		MapRender::addFace<PFP>(map, f, triangles, position);
+		unsigned int nb = (unsigned int)(triangles.size());
+		unsigned int slot = newSlot(nb);
+		std::copy(triangles.begin(), triangles.end(), m_indices.begin() + m_slotBegin[slot]);
+		m_modified.push_back(std::make_pair(m_slotBegin[slot], m_slotBegin[slot] + nb));
+
+		map.foreach_dart_of_orbit(f, [&] (Dart e)
+		{
+			unsigned int i = map.dartIndex(e);
+			if (i >= m_dartSlot.size())
+				m_dartSlot.resize(i + 1, std::make_pair(EMBNULL, 0u));
+			m_dartSlot[i] = std::make_pair(slot, m_slotGen[slot]);
+		});
+	}
+	m_dirty.clear();
+
+	if (2 * m_nbDeadIndices > m_indices.size())
+		compact();
+}
+
+template <typename PFP>
+void MapRender::enableIncrementalTriangles(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>* position, unsigned int nbth)
+{
+	if (m_triangleTable == NULL)
+		m_triangleTable = new TriangleTable();
+	m_triangleTable->init<PFP>(map, position, nbth);
+	uploadTriangleTable();
+}
+
+template <typename MAP>
+void MapRender::setFaceDirty(MAP& map, Face f)
+{
+	if (m_triangleTable != NULL)
+		m_triangleTable->setFaceDirty(map, f);
+	else
+		setPrimitiveDirty(TRIANGLES);
+}
+
+template <typename MAP>
+void MapRender::setFaceRemoved(MAP& map, Face f)
+{
+	if (m_triangleTable != NULL)
+		m_triangleTable->setFaceRemoved(map, f);
+	else
+		setPrimitiveDirty(TRIANGLES);
+}
+
+template <typename PFP>
+void MapRender::updateTriangles(typename PFP::MAP& map, const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>* position)
+{
+	if (m_triangleTable == NULL)
+	{
+		if (!m_indexBufferUpToDate[TRIANGLES])
+			initPrimitives<PFP>(map, TRIANGLES, position);
+		return;
+	}
+	m_triangleTable->update<PFP>(map, position);
+	uploadTriangleTable();
+}
+
 } // namespace GL2
 
 } // namespace Render
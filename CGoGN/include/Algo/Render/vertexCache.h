@@ -0,0 +1,115 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef __ALGO_RENDER_VERTEX_CACHE_H__
+#define __ALGO_RENDER_VERTEX_CACHE_H__
+
+#include <vector>
+
+#include "Topology/generic/cells.h"
+#include "Container/attributeContainer.h"
+
+#ifdef WIN32
+#ifndef CGoGN_ALGO_API
+#if defined CGoGN_ALGO_DLL_EXPORT
+#define CGoGN_ALGO_API __declspec(dllexport)
+#else
+#define CGoGN_ALGO_API __declspec(dllimport)
+#endif
+#endif
+#else
+#define CGoGN_ALGO_API
+#endif
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Render
+{
+
+/**
+ * Post-transform vertex cache optimization of triangle index tables
+ * (as built by MapRender::initTriangles) and vertex fetch reordering
+ */
+namespace VertexCache
+{
+
+/**
+ * reorder the triangles of an index table to improve the reuse of the
+ * post-transform vertex cache (T. Forsyth, "Linear-Speed Vertex Cache Optimisation").
+ * The orientation of the triangles is kept.
+ * @param indices table of triangle indices (3 per triangle), reordered in place
+ * @param cacheSize size of the simulated LRU cache (in [4,64])
+ */
+CGoGN_ALGO_API void optimizeTriangles(std::vector<unsigned int>& indices, unsigned int cacheSize = 32);
+
+/**
+ * number of vertex cache misses of an index table for a FIFO cache
+ * @param nbVertices filled with the number of different vertices referenced by the table
+ */
+CGoGN_ALGO_API unsigned int nbCacheMisses(const std::vector<unsigned int>& indices, unsigned int cacheSize, unsigned int& nbVertices);
+
+/**
+ * average cache miss ratio: transformed vertices per triangle (between 0.5 and 3)
+ */
+CGoGN_ALGO_API float computeACMR(const std::vector<unsigned int>& indices, unsigned int cacheSize = 32);
+
+/**
+ * average transform to vertex ratio: transformed vertices per referenced vertex (1 is optimal)
+ */
+CGoGN_ALGO_API float computeATVR(const std::vector<unsigned int>& indices, unsigned int cacheSize = 32);
+
+/**
+ * compute the permutation of the used lines of a container that stores the vertices
+ * in their order of first use by the index table (unreferenced lines go after)
+ * @param indices table of indices
+ * @param cont container of the indexed elements
+ * @param mapOldNew new index of each used line of cont
+ */
+CGoGN_ALGO_API void computeFetchOrder(const std::vector<unsigned int>& indices, const AttributeContainer& cont, std::vector<unsigned int>& mapOldNew);
+
+/**
+ * permute the vertex container of the map in the fetch order of the index table
+ * so that the attribute VBOs are read sequentially, and renumber the table.
+ * The other index tables and the VBOs of vertex attributes have to be updated after.
+ * @param map the map
+ * @param indices table of vertex indices (usually optimized by optimizeTriangles before)
+ */
+template <typename MAP>
+void reorderVertices(MAP& map, std::vector<unsigned int>& indices);
+
+} // namespace VertexCache
+
+} // namespace Render
+
+} // namespace Algo
+
+} // namespace CGoGN
+
+#include "Algo/Render/vertexCache.hpp"
+
+#endif
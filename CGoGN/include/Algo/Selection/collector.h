@@ -30,12 +30,15 @@
 
 #include "Topology/generic/traversor/traversor2.h"
 
+#include "Algo/Geometry/kdTree.h"
+
 #include <algorithm>
 
 /*****************************************
  * Class hierarchy :
  * Collector (virtual)
  * - Collector_WithinSphere
+ *   - Collector_WithinSphere_KdTree
  * - Collector_OneRing
  ****************************************/
 
@@ -244,6 +247,55 @@ public:
 	REAL borderEdgeRatio(Dart d, const VertexAttribute<VEC3, MAP>& pos);
 };
 
+/*********************************************************
+ * Collector Within Sphere (kd-tree)
+ *********************************************************/
+
+/*
+ * same primitives as Collector_WithinSphere, the vertices within the sphere being given
+ * by a kd-tree of the positions (built on the lines of the position attribute):
+ * no marker of the map is used, so that one collector by thread can be used in parallel.
+ * insideVertices and border are in the same order as with Collector_WithinSphere,
+ * an inside edge (triangle) is stored with the dart of its vertex of smallest embedding.
+ * The boundary faces are never inside faces.
+ * The kd-tree has to be rebuilt when the positions are modified.
+ */
+template <typename PFP>
+class Collector_WithinSphere_KdTree : public Collector_WithinSphere<PFP>
+{
+	typedef typename PFP::MAP MAP ;
+	typedef typename PFP::VEC3 VEC3 ;
+	typedef typename PFP::REAL REAL ;
+
+protected:
+	const Algo::Geometry::KdTree<VEC3>& kdTree;
+
+	/// sorted lines of the vertices within the sphere
+	std::vector<unsigned int> inSphere;
+	/// vertices of inSphere already collected
+	std::vector<unsigned char> reached;
+
+	void gatherInSphere(Dart d);
+
+	/// index of line in inSphere (size of inSphere if outside)
+	inline unsigned int inSphereIndex(unsigned int line) const
+	{
+		std::vector<unsigned int>::const_iterator it = std::lower_bound(inSphere.begin(), inSphere.end(), line);
+		if (it != inSphere.end() && *it == line)
+			return (unsigned int)(it - inSphere.begin());
+		return (unsigned int)(inSphere.size());
+	}
+
+public:
+	Collector_WithinSphere_KdTree(MAP& m, const VertexAttribute<VEC3, MAP>& p, const Algo::Geometry::KdTree<VEC3>& tree, REAL r = 0) :
+		Collector_WithinSphere<PFP>(m, p, r),
+		kdTree(tree)
+	{}
+
+	void collectAll(Dart d);
+	void collectBorder(Dart d);
+};
+
 /*********************************************************
  * Collector Normal Angle (Vertices)
  *********************************************************/
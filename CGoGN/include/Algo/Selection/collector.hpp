@@ -438,6 +438,107 @@ typename PFP::REAL Collector_WithinSphere<PFP>::borderEdgeRatio(Dart d, const Ve
 	return alpha;
 }
 
+/*********************************************************
+ * Collector Within Sphere (kd-tree)
+ *********************************************************/
+
+template <typename PFP>
+void Collector_WithinSphere_KdTree<PFP>::gatherInSphere(Dart d)
+{
+	const VEC3& centerPosition = this->position[d];
+
+	// the tree is queried with a slightly larger radius, the test is the one of Collector_WithinSphere
+	inSphere.clear();
+	kdTree.foreachWithinRadius(centerPosition, this->radius * REAL(1.0001), [&] (unsigned int line, REAL)
+	{
+		if (Geom::isPointInSphere(this->position[line], centerPosition, this->radius))
+			inSphere.push_back(line);
+	});
+	inSphere.push_back(this->map.template getEmbedding<VERTEX>(d)); // the center is always inside
+	std::sort(inSphere.begin(), inSphere.end());
+	inSphere.erase(std::unique(inSphere.begin(), inSphere.end()), inSphere.end());
+	reached.assign(inSphere.size(), 0);
+}
+
+template <typename PFP>
+void Collector_WithinSphere_KdTree<PFP>::collectAll(Dart d)
+{
+	this->init(d);
+	this->isInsideCollected = true;
+	gatherInSphere(d);
+
+	const unsigned int outside = (unsigned int)(inSphere.size());
+	this->insideVertices.push_back(d);
+	reached[inSphereIndex(this->map.template getEmbedding<VERTEX>(d))] = 1;
+
+	unsigned int i = 0;
+	while (i < this->insideVertices.size())
+	{
+		Dart end = this->insideVertices[i];
+		const unsigned int lv = this->map.template getEmbedding<VERTEX>(end);
+		Dart e = end;
+		do
+		{
+			const Dart f = this->map.phi1(e);
+			const unsigned int lf = this->map.template getEmbedding<VERTEX>(f);
+			const unsigned int kf = inSphereIndex(lf);
+			if (kf == outside)
+				this->border.push_back(e);
+			else
+			{
+				if (!reached[kf])
+				{
+					this->insideVertices.push_back(f);
+					reached[kf] = 1;
+				}
+				if (lv < lf)
+				{
+					this->insideEdges.push_back(e);
+					const Dart g = this->map.phi1(f);
+					const unsigned int lg = this->map.template getEmbedding<VERTEX>(g);
+					if (lv < lg && inSphereIndex(lg) != outside && !this->map.isBoundaryMarked(2, e))
+						this->insideFaces.push_back(e);
+				}
+			}
+			e = this->map.phi2_1(e);
+		} while (e != end);
+		++i;
+	}
+}
+
+template <typename PFP>
+void Collector_WithinSphere_KdTree<PFP>::collectBorder(Dart d)
+{
+	this->init(d);
+	gatherInSphere(d);
+
+	const unsigned int outside = (unsigned int)(inSphere.size());
+	this->insideVertices.push_back(d);
+	reached[inSphereIndex(this->map.template getEmbedding<VERTEX>(d))] = 1;
+
+	unsigned int i = 0;
+	while (i < this->insideVertices.size())
+	{
+		Dart end = this->insideVertices[i];
+		Dart e = end;
+		do
+		{
+			const Dart f = this->map.phi1(e);
+			const unsigned int kf = inSphereIndex(this->map.template getEmbedding<VERTEX>(f));
+			if (kf == outside)
+				this->border.push_back(e);
+			else if (!reached[kf])
+			{
+				this->insideVertices.push_back(f);
+				reached[kf] = 1;
+			}
+			e = this->map.phi2_1(e);
+		} while (e != end);
+		++i;
+	}
+	this->insideVertices.clear();
+}
+
 /*********************************************************
  * Collector Normal Angle (Vertices)
  *********************************************************/
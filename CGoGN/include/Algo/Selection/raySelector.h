@@ -27,6 +27,7 @@
 
 #include <vector>
 #include "Algo/Selection/raySelectFunctor.hpp"
+#include "Algo/Geometry/faceBVH.h"
 
 namespace CGoGN
 {
@@ -155,6 +156,77 @@ void vertexRaySelection(
 		const typename PFP::VEC3& rayAB,
 		Vertex& vertex);
 
+/**
+ * Versions of the ray selection functions accelerated by a FaceBVH of the faces of the map
+ * (the BVH has to be up to date with the position: refit after a move, build after a
+ * topological modification). They give the same cells as the exhaustive versions.
+ */
+template<typename PFP>
+void facesRaySelection(
+		typename PFP::MAP& map,
+		const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+		const Geometry::FaceBVH<PFP>& bvh,
+		const typename PFP::VEC3& rayA,
+		const typename PFP::VEC3& rayAB,
+		std::vector<Face>& vecFaces,
+		std::vector<typename PFP::VEC3>& iPoints);
+
+template<typename PFP>
+void facesRaySelection(
+		typename PFP::MAP& map,
+		const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+		const Geometry::FaceBVH<PFP>& bvh,
+		const typename PFP::VEC3& rayA,
+		const typename PFP::VEC3& rayAB,
+		std::vector<Face>& vecFaces);
+
+template<typename PFP>
+void faceRaySelection(
+		typename PFP::MAP& map,
+		const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+		const Geometry::FaceBVH<PFP>& bvh,
+		const typename PFP::VEC3& rayA,
+		const typename PFP::VEC3& rayAB,
+		Face& face);
+
+template<typename PFP>
+void edgesRaySelection(
+		typename PFP::MAP& map,
+		const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+		const Geometry::FaceBVH<PFP>& bvh,
+		const typename PFP::VEC3& rayA,
+		const typename PFP::VEC3& rayAB,
+		std::vector<Edge>& vecEdges,
+		float distMax);
+
+template<typename PFP>
+void edgeRaySelection(
+		typename PFP::MAP& map,
+		const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+		const Geometry::FaceBVH<PFP>& bvh,
+		const typename PFP::VEC3& rayA,
+		const typename PFP::VEC3& rayAB,
+		Edge& edge);
+
+template<typename PFP>
+void verticesRaySelection(
+		typename PFP::MAP& map,
+		const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+		const Geometry::FaceBVH<PFP>& bvh,
+		const typename PFP::VEC3& rayA,
+		const typename PFP::VEC3& rayAB,
+		std::vector<Vertex>& vecVertices,
+		float dist);
+
+template<typename PFP>
+void vertexRaySelection(
+		typename PFP::MAP& map,
+		const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+		const Geometry::FaceBVH<PFP>& bvh,
+		const typename PFP::VEC3& rayA,
+		const typename PFP::VEC3& rayAB,
+		Vertex& vertex);
+
 /**
  * Volume selection, not yet functional
  */
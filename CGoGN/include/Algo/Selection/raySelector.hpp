@@ -27,6 +27,8 @@
 #include "Geometry/distances.h"
 #include "Geometry/intersection.h"
 #include "Algo/Geometry/centroid.h"
+#include "Topology/generic/dartmarker.h"
+#include "Topology/generic/cellmarker.h"
 
 namespace CGoGN
 {
@@ -52,6 +54,42 @@ struct FaceInter
 	FaceInter() {}
 };
 
+/**
+ * sort the intersected faces and their intersection points from closest to farthest
+ */
+template <typename PFP>
+void sortFacesByDistance(
+		const typename PFP::VEC3& rayA,
+		std::vector<Face>& vecFaces,
+		std::vector<typename PFP::VEC3>& iPoints)
+{
+	if(vecFaces.size() > 0)
+	{
+		// compute all distances to observer for each intersected face
+		// and put them in a vector for sorting
+		typedef std::pair<typename PFP::REAL, FaceInter<PFP> > faceInterDist;
+		std::vector<faceInterDist> dist;
+
+		unsigned int nbi = (unsigned int)(vecFaces.size());
+		dist.resize(nbi);
+		for (unsigned int i = 0; i < nbi; ++i)
+		{
+			dist[i].first = (iPoints[i] - rayA).norm2();
+			dist[i].second = FaceInter<PFP>(vecFaces[i], iPoints[i]);
+		}
+
+		// sort the vector of pair dist/dart
+		std::sort(dist.begin(), dist.end(), distOrdering<typename PFP::REAL, FaceInter<PFP> >);
+
+		// store result in returned vectors
+		for (unsigned int i = 0; i < nbi; ++i)
+		{
+			vecFaces[i] = dist[i].second.f;
+			iPoints[i] = dist[i].second.i;
+		}
+	}
+}
+
 /**
  * Function that does the selection of faces, returned faces and intersection points are sorted from closest to farthest
  * @param map the map we want to test
@@ -99,31 +137,7 @@ void facesRaySelection(
 		} while ((ddd != f.dart) && notfound);
 	});
 
-	if(vecFaces.size() > 0)
-	{
-		// compute all distances to observer for each intersected face
-		// and put them in a vector for sorting
-		typedef std::pair<typename PFP::REAL, FaceInter<PFP> > faceInterDist;
-		std::vector<faceInterDist> dist;
-
-		unsigned int nbi = (unsigned int)(vecFaces.size());
-		dist.resize(nbi);
-		for (unsigned int i = 0; i < nbi; ++i)
-		{
-			dist[i].first = (iPoints[i] - rayA).norm2();
-			dist[i].second = FaceInter<PFP>(vecFaces[i], iPoints[i]);
-		}
-
-		// sort the vector of pair dist/dart
-		std::sort(dist.begin(), dist.end(), distOrdering<typename PFP::REAL, FaceInter<PFP> >);
-
-		// store result in returned vectors
-		for (unsigned int i = 0; i < nbi; ++i)
-		{
-			vecFaces[i] = dist[i].second.f;
-			iPoints[i] = dist[i].second.i;
-		}
-	}
+	sortFacesByDistance<PFP>(rayA, vecFaces, iPoints);
 }
 
 /**
@@ -176,6 +190,44 @@ void faceRaySelection(
 		face = NIL;
 }
 
+/**
+ * sort the selected edges from closest to farthest (distance of their middle)
+ */
+template <typename PFP>
+void sortEdgesByDistance(
+		typename PFP::MAP& map,
+		const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+		const typename PFP::VEC3& rayA,
+		std::vector<Edge>& vecEdges)
+{
+	if(vecEdges.size() > 0)
+	{
+		typedef std::pair<typename PFP::REAL, Edge> EdgeDist;
+		std::vector<EdgeDist> distnedge;
+
+		unsigned int nbi = (unsigned int)(vecEdges.size());
+		distnedge.resize(nbi);
+
+		// compute all distances to observer for each middle of intersected edge
+		// and put them in a vector for sorting
+		for (unsigned int i = 0; i < nbi; ++i)
+		{
+			Edge e = vecEdges[i];
+			distnedge[i].second = e;
+			typename PFP::VEC3 V = (position[e.dart] + position[map.phi1(e.dart)]) / typename PFP::REAL(2);
+			V -= rayA;
+			distnedge[i].first = V.norm2();
+		}
+
+		// sort the vector of pair dist/edge
+		std::sort(distnedge.begin(), distnedge.end(), distOrdering<typename PFP::REAL, Edge>);
+
+		// store sorted darts in returned vector
+		for (unsigned int i = 0; i < nbi; ++i)
+			vecEdges[i] = distnedge[i].second;
+	}
+}
+
 /**
  * Function that does the selection of edges, returned edges are sorted from closest to farthest
  * @param map the map we want to test
@@ -212,32 +264,34 @@ void edgesRaySelection(
 			vecEdges.push_back(e);
 	});
 
-	if(vecEdges.size() > 0)
-	{
-		typedef std::pair<typename PFP::REAL, Edge> EdgeDist;
-		std::vector<EdgeDist> distnedge;
-
-		unsigned int nbi = (unsigned int)(vecEdges.size());
-		distnedge.resize(nbi);
+	sortEdgesByDistance<PFP>(map, position, rayA, vecEdges);
+}
 
-		// compute all distances to observer for each middle of intersected edge
-		// and put them in a vector for sorting
-		for (unsigned int i = 0; i < nbi; ++i)
+/**
+ * edge of face f closest to the point ip
+ */
+template <typename PFP>
+Edge closestEdgeOfFace(
+		typename PFP::MAP& map,
+		const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+		Face f,
+		const typename PFP::VEC3& ip)
+{
+	Dart it = f.dart;
+	typename PFP::REAL minDist = squaredDistanceLine2Point(position[it], position[map.phi1(it)], ip);
+	Edge edge = it;
+	it = map.phi1(it);
+	while(it != f.dart)
+	{
+		typename PFP::REAL dist = squaredDistanceLine2Point(position[it], position[map.phi1(it)], ip);
+		if(dist < minDist)
 		{
-			Edge e = vecEdges[i];
-			distnedge[i].second = e;
-			typename PFP::VEC3 V = (position[e.dart] + position[map.phi1(e.dart)]) / typename PFP::REAL(2);
-			V -= rayA;
-			distnedge[i].first = V.norm2();
+			minDist = dist;
+			edge = it;
 		}
-
-		// sort the vector of pair dist/edge
-		std::sort(distnedge.begin(), distnedge.end(), distOrdering<typename PFP::REAL, Edge>);
-
-		// store sorted darts in returned vector
-		for (unsigned int i = 0; i < nbi; ++i)
-			vecEdges[i] = distnedge[i].second;
+		it = map.phi1(it);
 	}
+	return edge;
 }
 
 /**
@@ -265,29 +319,45 @@ void edgeRaySelection(
 	facesRaySelection<PFP>(map, position, rayA, rayAB, vecFaces, iPoints);
 
 	if(vecFaces.size() > 0)
+		edge = closestEdgeOfFace<PFP>(map, position, vecFaces[0], iPoints[0]);
+	else
+		edge = NIL;
+}
+
+/**
+ * sort the selected vertices from closest to farthest
+ */
+template <typename PFP>
+void sortVerticesByDistance(
+		const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+		const typename PFP::VEC3& rayA,
+		std::vector<Vertex>& vecVertices)
+{
+	if(vecVertices.size() > 0)
 	{
-		// recuperation du point d'intersection sur la face la plus proche
-		typename PFP::VEC3 ip = iPoints[0];
+		typedef std::pair<typename PFP::REAL, Vertex> VertexDist;
+		std::vector<VertexDist> distnvertex;
 
-		// recuperation de l'arete la plus proche du point d'intersection
-		Face f = vecFaces[0];
-		Dart it = f.dart;
-		typename PFP::REAL minDist = squaredDistanceLine2Point(position[it], position[map.phi1(it)], ip);
-		edge = it;
-		it = map.phi1(it);
-		while(it != f.dart)
+		unsigned int nbi = (unsigned int)(vecVertices.size());
+		distnvertex.resize(nbi);
+
+		// compute all distances to observer for each intersected vertex
+		// and put them in a vector for sorting
+		for (unsigned int i = 0; i < nbi; ++i)
 		{
-			typename PFP::REAL dist = squaredDistanceLine2Point(position[it], position[map.phi1(it)], ip);
-			if(dist < minDist)
-			{
-				minDist = dist;
-				edge = it;
-			}
-			it = map.phi1(it);
+			Vertex v = vecVertices[i];
+			distnvertex[i].second = v;
+			typename PFP::VEC3 V = position[v] - rayA;
+			distnvertex[i].first = V.norm2();
 		}
+
+		// sort the vector of pair dist/dart
+		std::sort(distnvertex.begin(), distnvertex.end(), distOrdering<typename PFP::REAL, Vertex>);
+
+		// store sorted darts in returned vector
+		for (unsigned int i = 0; i < nbi; ++i)
+			vecVertices[i] = distnvertex[i].second;
 	}
-	else
-		edge = NIL;
 }
 
 /**
@@ -323,31 +393,34 @@ void verticesRaySelection(
 			vecVertices.push_back(v);
 	});
 
-	if(vecVertices.size() > 0)
-	{
-		typedef std::pair<typename PFP::REAL, Vertex> VertexDist;
-		std::vector<VertexDist> distnvertex;
-
-		unsigned int nbi = (unsigned int)(vecVertices.size());
-		distnvertex.resize(nbi);
+	sortVerticesByDistance<PFP>(position, rayA, vecVertices);
+}
 
-		// compute all distances to observer for each intersected vertex
-		// and put them in a vector for sorting
-		for (unsigned int i = 0; i < nbi; ++i)
+/**
+ * vertex of face f closest to the point ip
+ */
+template <typename PFP>
+Vertex closestVertexOfFace(
+		typename PFP::MAP& map,
+		const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+		Face f,
+		const typename PFP::VEC3& ip)
+{
+	Dart it = f.dart;
+	typename PFP::REAL minDist = (ip - position[it]).norm2();
+	Vertex vertex = it;
+	it = map.phi1(it);
+	while(it != f.dart)
+	{
+		typename PFP::REAL dist = (ip - position[it]).norm2();
+		if(dist < minDist)
 		{
-			Vertex v = vecVertices[i];
-			distnvertex[i].second = v;
-			typename PFP::VEC3 V = position[v] - rayA;
-			distnvertex[i].first = V.norm2();
+			minDist = dist;
+			vertex = it;
 		}
-
-		// sort the vector of pair dist/dart
-		std::sort(distnvertex.begin(), distnvertex.end(), distOrdering<typename PFP::REAL, Vertex>);
-
-		// store sorted darts in returned vector
-		for (unsigned int i = 0; i < nbi; ++i)
-			vecVertices[i] = distnvertex[i].second;
+		it = map.phi1(it);
 	}
+	return vertex;
 }
 
 /**
@@ -375,27 +448,167 @@ void vertexRaySelection(
 	facesRaySelection<PFP>(map, position, rayA, rayAB, vecFaces, iPoints);
 
 	if(vecFaces.size() > 0)
+		vertex = closestVertexOfFace<PFP>(map, position, vecFaces[0], iPoints[0]);
+	else
+		vertex = NIL;
+}
+
+/**
+ * Selection of faces accelerated by a FaceBVH (same result as without the BVH)
+ * @param bvh tree of the faces of the map (up to date with position)
+ */
+template<typename PFP>
+void facesRaySelection(
+		typename PFP::MAP& /*map*/,
+		const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& /*position*/,
+		const Geometry::FaceBVH<PFP>& bvh,
+		const typename PFP::VEC3& rayA,
+		const typename PFP::VEC3& rayAB,
+		std::vector<Face>& vecFaces,
+		std::vector<typename PFP::VEC3>& iPoints)
+{
+	bvh.allHits(rayA, rayAB, vecFaces, iPoints);
+	sortFacesByDistance<PFP>(rayA, vecFaces, iPoints);
+}
+
+template<typename PFP>
+void facesRaySelection(
+		typename PFP::MAP& map,
+		const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+		const Geometry::FaceBVH<PFP>& bvh,
+		const typename PFP::VEC3& rayA,
+		const typename PFP::VEC3& rayAB,
+		std::vector<Face>& vecFaces)
+{
+	std::vector<typename PFP::VEC3> iPoints;
+	facesRaySelection<PFP>(map, position, bvh, rayA, rayAB, vecFaces, iPoints);
+}
+
+template<typename PFP>
+void faceRaySelection(
+		typename PFP::MAP& /*map*/,
+		const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& /*position*/,
+		const Geometry::FaceBVH<PFP>& bvh,
+		const typename PFP::VEC3& rayA,
+		const typename PFP::VEC3& rayAB,
+		Face& face)
+{
+	typename PFP::VEC3 ip;
+	bvh.closestHit(rayA, rayAB, face, ip);
+}
+
+/**
+ * Selection of edges accelerated by a FaceBVH: only the edges of the faces
+ * whose box is closer than distMax from the ray are tested
+ */
+template<typename PFP>
+void edgesRaySelection(
+		typename PFP::MAP& map,
+		const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+		const Geometry::FaceBVH<PFP>& bvh,
+		const typename PFP::VEC3& rayA,
+		const typename PFP::VEC3& rayAB,
+		std::vector<Edge>& vecEdges,
+		float distMax)
+{
+	typename PFP::REAL dist2 = distMax * distMax;
+	typename PFP::REAL AB2 = rayAB * rayAB;
+
+	vecEdges.reserve(256);
+	vecEdges.clear();
+
+	DartMarkerStore<typename PFP::MAP> dm(map);
+	bvh.foreachFaceNearLine(rayA, rayAB, distMax, [&] (Face f)
 	{
-		// recuperation du point d'intersection sur la face la plus proche
-		typename PFP::VEC3 ip = iPoints[0];
+		Dart it = f.dart;
+		do
+		{
+			if (!dm.isMarked(it))
+			{
+				Edge e(it);
+				dm.markOrbit(e);
+				typename PFP::REAL ld2 = Geom::squaredDistanceLine2Seg(rayA, rayAB, AB2, position[it], position[map.phi1(it)]);
+				if (ld2 < dist2)
+					vecEdges.push_back(e);
+			}
+			it = map.phi1(it);
+		} while (it != f.dart);
+	});
+
+	sortEdgesByDistance<PFP>(map, position, rayA, vecEdges);
+}
 
-		// recuperation du sommet le plus proche du point d'intersection
-		Face f = vecFaces[0];
+template<typename PFP>
+void edgeRaySelection(
+		typename PFP::MAP& map,
+		const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+		const Geometry::FaceBVH<PFP>& bvh,
+		const typename PFP::VEC3& rayA,
+		const typename PFP::VEC3& rayAB,
+		Edge& edge)
+{
+	Face f;
+	typename PFP::VEC3 ip;
+	if (bvh.closestHit(rayA, rayAB, f, ip))
+		edge = closestEdgeOfFace<PFP>(map, position, f, ip);
+	else
+		edge = NIL;
+}
+
+/**
+ * Selection of vertices accelerated by a FaceBVH: only the vertices of the faces
+ * whose box is closer than dist from the ray are tested
+ */
+template<typename PFP>
+void verticesRaySelection(
+		typename PFP::MAP& map,
+		const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+		const Geometry::FaceBVH<PFP>& bvh,
+		const typename PFP::VEC3& rayA,
+		const typename PFP::VEC3& rayAB,
+		std::vector<Vertex>& vecVertices,
+		float dist)
+{
+	typename PFP::REAL dist2 = dist * dist;
+	typename PFP::REAL AB2 = rayAB * rayAB;
+
+	vecVertices.reserve(256);
+	vecVertices.clear();
+
+	CellMarkerStore<typename PFP::MAP, VERTEX> cm(map);
+	bvh.foreachFaceNearLine(rayA, rayAB, dist, [&] (Face f)
+	{
 		Dart it = f.dart;
-		typename PFP::REAL minDist = (ip - position[it]).norm2();
-		vertex = it;
-		it = map.phi1(it);
-		while(it != f.dart)
+		do
 		{
-			typename PFP::REAL dist = (ip - position[it]).norm2();
-			if(dist < minDist)
+			Vertex v(it);
+			if (!cm.isMarked(v))
 			{
-				minDist = dist;
-				vertex = it;
+				cm.mark(v);
+				typename PFP::REAL ld2 = Geom::squaredDistanceLine2Point(rayA, rayAB, AB2, position[v]);
+				if (ld2 < dist2)
+					vecVertices.push_back(v);
 			}
 			it = map.phi1(it);
-		}
-	}
+		} while (it != f.dart);
+	});
+
+	sortVerticesByDistance<PFP>(position, rayA, vecVertices);
+}
+
+template<typename PFP>
+void vertexRaySelection(
+		typename PFP::MAP& map,
+		const VertexAttribute<typename PFP::VEC3, typename PFP::MAP>& position,
+		const Geometry::FaceBVH<PFP>& bvh,
+		const typename PFP::VEC3& rayA,
+		const typename PFP::VEC3& rayAB,
+		Vertex& vertex)
+{
+	Face f;
+	typename PFP::VEC3 ip;
+	if (bvh.closestHit(rayA, rayAB, f, ip))
+		vertex = closestVertexOfFace<PFP>(map, position, f, ip);
 	else
 		vertex = NIL;
 }
@@ -25,6 +25,10 @@
 #include <Eigen/Dense>
 #include <Eigen/Eigenvalues>
 
+#include "Topology/generic/parallelRange.h"
+
+#include <vector>
+
 #ifndef _SHAPE_MATCHING_H_
 #define _SHAPE_MATCHING_H_
 
@@ -57,25 +61,87 @@ protected:
 	VertexAttribute<REAL, MAP>& m_mass;  // m_i : mass
 	VertexAttribute<VEC3, MAP> m_goal;
 
+    // lines of the vertices in the containers (buffers are indexed in this order)
+    std::vector<unsigned int> m_lines;
+
+    // m_i
+    std::vector<double> m_m;
+
     // q_{i} = x^{0} - x^{0}_{cm}
-    std::vector<Eigen::Vector3d> m_q;
+    std::vector<double> m_qx;
+    std::vector<double> m_qy;
+    std::vector<double> m_qz;
+
+    // x_{i} (copied at each step)
+    std::vector<double> m_x;
+    std::vector<double> m_y;
+    std::vector<double> m_z;
+
+    // partial sums of the reductions (one set of values per task)
+    std::vector<double> m_partials;
+
+    void initBuffers();
+
+    /**
+     * sum over the vertices: f(k, sums) adds the nbValues values of vertex k to sums
+     * (partial sums by task, added in the order of the tasks)
+     */
+    template <typename FUNC>
+    void reduce(unsigned int nbValues, FUNC f, double* sums, unsigned int nbth);
+
+    /**
+     * copy the positions in the buffers
+     * @return the mass center x_{cm}
+     */
+    Eigen::Vector3d gatherPositions(unsigned int nbth);
+
+    /**
+     * A_{pq} = Sum_i{ p_{i} q_i^{T} } with p_{i} = x_{i} - x_{cm} (positions of the buffers)
+     */
+    Eigen::Matrix3d computeApq(const Eigen::Vector3d& xcm, unsigned int nbth);
+
+    /**
+     * rotational part of A_{pq}
+     */
+    static Eigen::Matrix3d rotation(const Eigen::Matrix3d& apq);
+
+    /**
+     * g_{i} = T * q_i + x_{cm}
+     */
+    void computeGoals(const Eigen::Matrix3d& T, const Eigen::Vector3d& xcm, unsigned int nbth);
 
 public:
 	ShapeMatching(MAP& map, VertexAttribute<VEC3, MAP>& position, VertexAttribute<REAL, MAP>& mass);
 
     virtual ~ShapeMatching();
 
-    Eigen::Vector3d massCenter();
+    Eigen::Vector3d massCenter(unsigned int nbth = CGoGN::Parallel::NumberOfThreads);
 
-    void initialize();
+    virtual void initialize(unsigned int nbth = CGoGN::Parallel::NumberOfThreads);
 
-    void shapeMatch();
+    /**
+     * compute the goal positions
+     * (no allocation once the buffers are initialized; the sums are parallel reductions)
+     */
+    virtual void shapeMatch(unsigned int nbth = CGoGN::Parallel::NumberOfThreads);
 
-	void computeVelocities(VertexAttribute<VEC3, MAP>& velocity, VertexAttribute<VEC3, MAP>& fext, REAL h, REAL alpha);
+	void computeVelocities(VertexAttribute<VEC3, MAP>& velocity, VertexAttribute<VEC3, MAP>& fext, REAL h, REAL alpha, unsigned int nbth = CGoGN::Parallel::NumberOfThreads);
 
-	void applyVelocities(VertexAttribute<VEC3, MAP>& velocity, REAL h);
+	void applyVelocities(VertexAttribute<VEC3, MAP>& velocity, REAL h, unsigned int nbth = CGoGN::Parallel::NumberOfThreads);
 };
 
+namespace Parallel
+{
+
+/**
+ * shapeMatch of several independent solvers (of different maps):
+ * the solvers are distributed on the threads, each one is computed sequentially
+ */
+template <typename PFP>
+void shapeMatch(const std::vector<ShapeMatching<PFP>*>& solvers, unsigned int nbth = CGoGN::Parallel::NumberOfThreads);
+
+} // namespace Parallel
+
 } // namespace ShapeMatching
 
 } // namespace Simulation
@@ -22,6 +22,8 @@
 *                                                                              *
 *******************************************************************************/
 
+#include <algorithm>
+
 namespace CGoGN
 {
 
@@ -44,10 +46,6 @@ ShapeMatching<PFP>::ShapeMatching(MAP& map, VertexAttribute<VEC3, MAP>& position
     m_position(position),
     m_mass(mass)
 {
-    unsigned int nbE = m_position.nbElements();
-
-    m_q.reserve(nbE);
-
 	m_goal = this->m_map.template getAttribute<VEC3, VERTEX, MAP>("goal");
 
     if(!m_goal.isValid())
@@ -62,92 +60,132 @@ ShapeMatching<PFP>::~ShapeMatching()
 }
 
 template <typename PFP>
-Eigen::Vector3d ShapeMatching<PFP>::massCenter() //
+void ShapeMatching<PFP>::initBuffers()
 {
-    Eigen::Vector3d xcm = Eigen::Vector3d::Zero();
-    REAL m = 0.0;
-
+    m_lines.clear();
+    m_m.clear();
     for(unsigned int i = m_position.begin() ; i < m_position.end() ; m_position.next(i))
     {
-        Eigen::Vector3d tmp ;
-        for (unsigned int j = 0 ; j < 3 ; ++j)
-            tmp(j) = m_position[i][j] ;
-
-        xcm += m_mass[i] * tmp;
-        m += m_mass[i];
+        m_lines.push_back(i);
+        m_m.push_back(m_mass[i]);
     }
 
-    xcm /= m;
-
-    return xcm;
+    unsigned int nb = (unsigned int)(m_lines.size());
+    m_x.resize(nb);
+    m_y.resize(nb);
+    m_z.resize(nb);
 }
 
-/**
- * Initialize pre-computed ....
- * First, \f$ x^{0}_{cm} \f$
- * In a second step, \f$ q_{i} = x^{0}_{i} - x^{0}_{cm} \f$
- */
 template <typename PFP>
-void ShapeMatching<PFP>::initialize()
+template <typename FUNC>
+void ShapeMatching<PFP>::reduce(unsigned int nbValues, FUNC f, double* sums, unsigned int nbth)
 {
-    Eigen::Vector3d x0cm = massCenter();
+    unsigned int nb = (unsigned int)(m_lines.size());
+    unsigned int nbTasks = CGoGN::Parallel::nbTasksOfRange(nb, nbth);
+    if(m_partials.size() < nbTasks * nbValues)
+        m_partials.resize(nbTasks * nbValues);
+    std::fill(m_partials.begin(), m_partials.begin() + nbTasks * nbValues, 0.0);
 
-    for(unsigned int i = m_position.begin() ; i < m_position.end() ; m_position.next(i))
+    CGoGN::Parallel::foreach_index(nb, [&] (unsigned int k, unsigned int task)
     {
-        Eigen::Vector3d tmp ;
-        for (unsigned int j = 0 ; j < 3 ; ++j)
-            tmp(j) = m_position[i][j] ;
-
-        Eigen::Vector3d qi = tmp - x0cm;
-
-        m_q.push_back(qi); //q_{i} = x^{0}_{i} - x^{0}_{cm}
-    }
+        f(k, &m_partials[task * nbValues]);
+    }, nbth);
+
+    for(unsigned int j = 0 ; j < nbValues ; ++j)
+        sums[j] = 0.0;
+    for(unsigned int t = 0 ; t < nbTasks ; ++t)
+        for(unsigned int j = 0 ; j < nbValues ; ++j)
+            sums[j] += m_partials[t * nbValues + j];
 }
 
 template <typename PFP>
-void ShapeMatching<PFP>::shapeMatch()
+Eigen::Vector3d ShapeMatching<PFP>::gatherPositions(unsigned int nbth)
 {
-    // p_{i}
-    std::vector<Eigen::Vector3d> m_p;
-
-    m_p.reserve(m_position.nbElements());
-
-    //1.
-    Eigen::Vector3d xcm = massCenter();
-
-    for(unsigned int i = m_position.begin() ; i < m_position.end() ; m_position.next(i))
+    double sums[4];
+    reduce(4, [&] (unsigned int k, double* s)
     {
-        Eigen::Vector3d tmp ;
-        for (unsigned int j = 0 ; j < 3 ; ++j)
-            tmp(j) = m_position[i][j] ;
+        const VEC3& x = m_position[m_lines[k]];
+        m_x[k] = x[0];
+        m_y[k] = x[1];
+        m_z[k] = x[2];
+        s[0] += m_m[k] * m_x[k];
+        s[1] += m_m[k] * m_y[k];
+        s[2] += m_m[k] * m_z[k];
+        s[3] += m_m[k];
+    }, sums, nbth);
+
+    return Eigen::Vector3d(sums[0], sums[1], sums[2]) / sums[3];
+}
 
-        Eigen::Vector3d pi = tmp - xcm ;
+template <typename PFP>
+Eigen::Vector3d ShapeMatching<PFP>::massCenter(unsigned int nbth)
+{
+    if(m_lines.empty())
+        initBuffers();
 
-        m_p.push_back(pi) ; //p_{i} = x_{i} - x_{cm}
+    return gatherPositions(nbth);
+}
 
-    }
+/**
+ * Initialize pre-computed ....
+ * First, \f$ x^{0}_{cm} \f$
+ * In a second step, \f$ q_{i} = x^{0}_{i} - x^{0}_{cm} \f$
+ */
+template <typename PFP>
+void ShapeMatching<PFP>::initialize(unsigned int nbth)
+{
+    initBuffers();
 
-    //2.
-    Eigen::Matrix3d apq = Eigen::Matrix3d::Zero();
+    Eigen::Vector3d x0cm = gatherPositions(nbth);
 
-    for(unsigned int i=0 ; i < m_p.size() ; ++i)
+    unsigned int nb = (unsigned int)(m_lines.size());
+    m_qx.resize(nb);
+    m_qy.resize(nb);
+    m_qz.resize(nb);
+    CGoGN::Parallel::foreach_index(nb, [&] (unsigned int k, unsigned int)
     {
-        apq(0,0) += m_p[i][0] * m_q[i][0];
-        apq(0,1) += m_p[i][0] * m_q[i][1];
-        apq(0,2) += m_p[i][0] * m_q[i][2];
-
-        apq(1,0) += m_p[i][1] * m_q[i][0];
-        apq(1,1) += m_p[i][1] * m_q[i][1];
-        apq(1,2) += m_p[i][1] * m_q[i][2];
+        m_qx[k] = m_x[k] - x0cm(0); //q_{i} = x^{0}_{i} - x^{0}_{cm}
+        m_qy[k] = m_y[k] - x0cm(1);
+        m_qz[k] = m_z[k] - x0cm(2);
+    }, nbth);
+}
 
-        apq(2,0) += m_p[i][2] * m_q[i][0];
-        apq(2,1) += m_p[i][2] * m_q[i][1];
-        apq(2,2) += m_p[i][2] * m_q[i][2];
-    }
+template <typename PFP>
+Eigen::Matrix3d ShapeMatching<PFP>::computeApq(const Eigen::Vector3d& xcm, unsigned int nbth)
+{
+    double sums[9];
+    reduce(9, [&] (unsigned int k, double* s)
+    {
+        double px = m_x[k] - xcm(0); //p_{i} = x_{i} - x_{cm}
+        double py = m_y[k] - xcm(1);
+        double pz = m_z[k] - xcm(2);
+
+        s[0] += px * m_qx[k];
+        s[1] += px * m_qy[k];
+        s[2] += px * m_qz[k];
+
+        s[3] += py * m_qx[k];
+        s[4] += py * m_qy[k];
+        s[5] += py * m_qz[k];
+
+        s[6] += pz * m_qx[k];
+        s[7] += pz * m_qy[k];
+        s[8] += pz * m_qz[k];
+    }, sums, nbth);
+
+    Eigen::Matrix3d apq;
+    apq << sums[0], sums[1], sums[2],
+           sums[3], sums[4], sums[5],
+           sums[6], sums[7], sums[8];
+    return apq;
+}
 
+template <typename PFP>
+Eigen::Matrix3d ShapeMatching<PFP>::rotation(const Eigen::Matrix3d& apq)
+{
     Eigen::Matrix3d S = apq.transpose() * apq ; //symmetric matrix
 
-    //3. Jacobi Diagonalisation
+    //Jacobi Diagonalisation
     Eigen::EigenSolver<Eigen::Matrix3d> es(S);
 
     //V * D * V^(-1)
@@ -166,41 +204,73 @@ void ShapeMatching<PFP>::shapeMatch()
     S = U * D * U.transpose();
 
     // Now we can get the rotation part
-    Eigen::Matrix3d R = apq * S; //S^{-1}
+    return apq * S; //S^{-1}
+}
 
-    //4.
-    for(unsigned int i = m_goal.begin() ; i < m_goal.end() ; m_goal.next(i))
+template <typename PFP>
+void ShapeMatching<PFP>::computeGoals(const Eigen::Matrix3d& T, const Eigen::Vector3d& xcm, unsigned int nbth)
+{
+    CGoGN::Parallel::foreach_index((unsigned int)(m_lines.size()), [&] (unsigned int k, unsigned int)
     {
-       Eigen::Vector3d tmp = R * m_q[i] + xcm; // g_{i} = R * q_i + x_{cm}
+        Eigen::Vector3d tmp = T * Eigen::Vector3d(m_qx[k], m_qy[k], m_qz[k]) + xcm; // g_{i} = T * q_i + x_{cm}
 
-       VEC3 g;
-       for (unsigned int j = 0 ; j < 3 ; ++j)
-            g[j] = tmp(j);
+        VEC3& g = m_goal[m_lines[k]];
+        for (unsigned int j = 0 ; j < 3 ; ++j)
+            g[j] = REAL(tmp(j));
+    }, nbth);
+}
 
-       m_goal[i] = g;
-    }
+template <typename PFP>
+void ShapeMatching<PFP>::shapeMatch(unsigned int nbth)
+{
+    //1.
+    Eigen::Vector3d xcm = gatherPositions(nbth);
+
+    //2.
+    Eigen::Matrix3d apq = computeApq(xcm, nbth);
+
+    //3.
+    Eigen::Matrix3d R = rotation(apq);
+
+    //4.
+    computeGoals(R, xcm, nbth);
 }
 
 
 // \alpha : stiffness | v_i : velocity | f_ext : force exterieure
 template <typename PFP>
-void ShapeMatching<PFP>::computeVelocities(VertexAttribute<VEC3, MAP>& velocity, VertexAttribute<VEC3, MAP>& fext, REAL h, REAL alpha)
+void ShapeMatching<PFP>::computeVelocities(VertexAttribute<VEC3, MAP>& velocity, VertexAttribute<VEC3, MAP>& fext, REAL h, REAL alpha, unsigned int nbth)
 {
-    for(unsigned int i = velocity.begin() ; i < velocity.end() ; velocity.next(i))
+    CGoGN::Parallel::foreach_index((unsigned int)(m_lines.size()), [&] (unsigned int k, unsigned int)
     {
+        unsigned int i = m_lines[k];
         velocity[i] = velocity[i] + alpha * ((m_goal[i] - m_position[i]) / h ) + (h * fext[i]) / m_mass[i];
-    }
+    }, nbth);
 }
 
 template <typename PFP>
-void ShapeMatching<PFP>::applyVelocities(VertexAttribute<VEC3, MAP>& velocity, REAL h)
+void ShapeMatching<PFP>::applyVelocities(VertexAttribute<VEC3, MAP>& velocity, REAL h, unsigned int nbth)
 {
-    for(unsigned int i = m_position.begin() ; i < m_position.end() ; m_position.next(i))
+    CGoGN::Parallel::foreach_index((unsigned int)(m_lines.size()), [&] (unsigned int k, unsigned int)
     {
+        unsigned int i = m_lines[k];
         m_position[i] = m_position[i] + h * velocity[i];
-    }
+    }, nbth);
+}
+
+namespace Parallel
+{
+
+template <typename PFP>
+void shapeMatch(const std::vector<ShapeMatching<PFP>*>& solvers, unsigned int nbth)
+{
+    CGoGN::Parallel::foreach_index((unsigned int)(solvers.size()), [&] (unsigned int i, unsigned int)
+    {
+        solvers[i]->shapeMatch(1);
+    }, nbth);
 }
 
+} // namespace Parallel
 
 } // namespace ShapeMatching
 
@@ -68,9 +68,9 @@ public:
     ~ShapeMatchingLinear()
     { }
 
-    void initialize();
+    void initialize(unsigned int nbth = CGoGN::Parallel::NumberOfThreads);
 
-    void shapeMatch();
+    void shapeMatch(unsigned int nbth = CGoGN::Parallel::NumberOfThreads);
 };
 
 } // namespace ShapeMatching
@@ -44,95 +44,35 @@ void ShapeMatchingLinear<PFP>::computeAqqMatrix()
 
     m_aqq = Eigen::Matrix3d::Zero();
 
-    for(unsigned int i = 0 ; i < this->m_q.size() ; ++i)
+    for(unsigned int k = 0 ; k < this->m_lines.size() ; ++k)
     {
-        m_aqq(0,0) += this->m_q[i][0] * this->m_q[i][0];
-        m_aqq(1,0) += this->m_q[i][1] * this->m_q[i][0];
-        m_aqq(2,0) += this->m_q[i][2] * this->m_q[i][0];
-
-        m_aqq(0,1) += this->m_q[i][0] * this->m_q[i][1];
-        m_aqq(1,1) += this->m_q[i][1] * this->m_q[i][1];
-        m_aqq(2,1) += this->m_q[i][2] * this->m_q[i][1];
-
-        m_aqq(0,2) += this->m_q[i][0] * this->m_q[i][2];
-        m_aqq(1,2) += this->m_q[i][1] * this->m_q[i][2];
-        m_aqq(2,2) += this->m_q[i][2] * this->m_q[i][2];
+        Eigen::Vector3d q(this->m_qx[k], this->m_qy[k], this->m_qz[k]);
+        m_aqq += q * q.transpose();
     }
 
-    m_aqq = m_aqq.inverse();
+    m_aqq = m_aqq.inverse().eval();
 }
 
 
 template <typename PFP>
-void ShapeMatchingLinear<PFP>::initialize()
+void ShapeMatchingLinear<PFP>::initialize(unsigned int nbth)
 {
-    this->ShapeMatching<PFP>::initialize();
+    this->ShapeMatching<PFP>::initialize(nbth);
 
     computeAqqMatrix();
 }
 
 template <typename PFP>
-void ShapeMatchingLinear<PFP>::shapeMatch()
+void ShapeMatchingLinear<PFP>::shapeMatch(unsigned int nbth)
 {
-    // p_{i}
-    std::vector<Eigen::Vector3d> m_p;
-
-    m_p.reserve(this->m_position.nbElements());
-
     //1.
-    Eigen::Vector3d xcm = this->massCenter();
-
-    for(unsigned int i = this->m_position.begin() ; i < this->m_position.end() ; this->m_position.next(i))
-    {
-       //this->m_p[i] = VEC3(this->m_position[i] - xcm); //p_{i} = x_{i} - x_{cm}
-
-        Eigen::Vector3d tmp ;
-        for (unsigned int j = 0 ; j < 3 ; ++j)
-            tmp(j) = this->m_position[i][j] ;
-
-       m_p[i] = tmp - xcm; //p_{i} = x_{i} - x_{cm}
-    }
+    Eigen::Vector3d xcm = this->gatherPositions(nbth);
 
     //2.
-    Eigen::Matrix3d apq = Eigen::Matrix3d::Zero();
-
-    for(unsigned int i=0 ; i < m_p.size() ; ++i)
-    {
-        apq(0,0) += m_p[i][0] * this->m_q[i][0];
-        apq(0,1) += m_p[i][0] * this->m_q[i][1];
-        apq(0,2) += m_p[i][0] * this->m_q[i][2];
-
-        apq(1,0) += m_p[i][1] * this->m_q[i][0];
-        apq(1,1) += m_p[i][1] * this->m_q[i][1];
-        apq(1,2) += m_p[i][1] * this->m_q[i][2];
-
-        apq(2,0) += m_p[i][2] * this->m_q[i][0];
-        apq(2,1) += m_p[i][2] * this->m_q[i][1];
-        apq(2,2) += m_p[i][2] * this->m_q[i][2];
-    }
+    Eigen::Matrix3d apq = this->computeApq(xcm, nbth);
 
-    Eigen::Matrix3d S = apq.transpose() * apq ; //symmetric matrix
-
-    //3. Jacobi Diagonalisation
-    Eigen::EigenSolver<Eigen::Matrix3d> es(S);
-
-    //V * D * V^(-1)
-    Eigen::Matrix3d D = es.pseudoEigenvalueMatrix();
-    Eigen::Matrix3d U = es.pseudoEigenvectors() ;
-
-    for(int j = 0; j < 3; j++)
-    {
-        if(D(j,j) <= 0)
-        {
-            D(j,j) = 0.05f;
-        }
-        D(j,j) = 1.0f/sqrt(D(j,j));
-    }
-
-    S = U * D * U.transpose();
-
-
-    Eigen::Matrix3d R = apq * S; //S^{-1}
+    //3.
+    Eigen::Matrix3d R = this->rotation(apq);
 
     //4.
     Eigen::Matrix3d A = apq * m_aqq; //
@@ -143,17 +83,17 @@ void ShapeMatchingLinear<PFP>::shapeMatch()
     // \beta * A + (1 - \beta) * R
     if(std::isfinite(det))
     {
-        R(0,0) += (m_beta * A(0,0) * det) + ((1.0f - m_beta) * R(0,0));
-        R(0,1) += (m_beta * A(0,1) * det) + ((1.0f - m_beta) * R(0,1));
-        R(0,2) += (m_beta * A(0,2) * det) + ((1.0f - m_beta) * R(0,2));
+        R(0,0) = (m_beta * A(0,0) * det) + ((1.0f - m_beta) * R(0,0));
+        R(0,1) = (m_beta * A(0,1) * det) + ((1.0f - m_beta) * R(0,1));
+        R(0,2) = (m_beta * A(0,2) * det) + ((1.0f - m_beta) * R(0,2));
 
-        R(1,0) += (m_beta * A(1,0) * det) + ((1.0f - m_beta) * R(1,0));
-        R(1,1) += (m_beta * A(1,1) * det) + ((1.0f - m_beta) * R(1,1));
-        R(1,2) += (m_beta * A(1,2) * det) + ((1.0f - m_beta) * R(1,2));
+        R(1,0) = (m_beta * A(1,0) * det) + ((1.0f - m_beta) * R(1,0));
+        R(1,1) = (m_beta * A(1,1) * det) + ((1.0f - m_beta) * R(1,1));
+        R(1,2) = (m_beta * A(1,2) * det) + ((1.0f - m_beta) * R(1,2));
 
-        R(2,0) += (m_beta * A(2,0) * det) + ((1.0f - m_beta) * R(2,0));
-        R(2,1) += (m_beta * A(2,1) * det) + ((1.0f - m_beta) * R(2,1));
-        R(2,2) += (m_beta * A(2,2) * det) + ((1.0f - m_beta) * R(2,2));
+        R(2,0) = (m_beta * A(2,0) * det) + ((1.0f - m_beta) * R(2,0));
+        R(2,1) = (m_beta * A(2,1) * det) + ((1.0f - m_beta) * R(2,1));
+        R(2,2) = (m_beta * A(2,2) * det) + ((1.0f - m_beta) * R(2,2));
     }
     else
     {
@@ -162,19 +102,7 @@ void ShapeMatchingLinear<PFP>::shapeMatch()
     }
 
     //5.
-    for(unsigned int i = this->m_goal.begin() ; i < this->m_goal.end() ; this->m_goal.next(i))
-    {
-        //this->m_goal[i] = R * this->m_q[i] + xcm; // g_{i} = R * q_i + x_{cm}
-
-        Eigen::Vector3d tmp = R * this->m_q[i] + xcm; // g_{i} = R * q_i + x_{cm}
-
-        VEC3 g;
-        for (unsigned int j = 0 ; j < 3 ; ++j)
-			g[j] = REAL(tmp(j));
-
-         this->m_goal[i] = g;
-    }
-
+    this->computeGoals(R, xcm, nbth);
 }
 
 } // namespace ShapeMatching
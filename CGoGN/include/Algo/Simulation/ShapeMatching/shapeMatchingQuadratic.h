@@ -72,9 +72,9 @@ public:
     ~ShapeMatchingQuadratic()
     { }
 
-    void initialize();
+    void initialize(unsigned int nbth = CGoGN::Parallel::NumberOfThreads);
 
-    void shapeMatch();
+    void shapeMatch(unsigned int nbth = CGoGN::Parallel::NumberOfThreads);
 };
 
 } // namespace ShapeMatching
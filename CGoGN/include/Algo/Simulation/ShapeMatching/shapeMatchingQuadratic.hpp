@@ -38,24 +38,18 @@ namespace ShapeMatching
 {
 
 template <typename PFP>
-void ShapeMatchingQuadratic<PFP>::initialize()
+void ShapeMatchingQuadratic<PFP>::initialize(unsigned int nbth)
 {
     //compute q : needed to compute R
-
-    Eigen::Vector3d x0cm = this->ShapeMatching<PFP>::massCenter();
+    this->ShapeMatching<PFP>::initialize(nbth);
 
     //compute q~
-    for(unsigned int i = this->m_position.begin() ; i < this->m_position.end() ; this->m_position.next(i))
+    m_qtild.resize(this->m_lines.size());
+    for(unsigned int k = 0 ; k < this->m_lines.size() ; ++k)
     {
-        Eigen::Vector3d tmp ;
-        for (unsigned int j = 0 ; j < 3 ; ++j)
-            tmp(j) = this->m_position[i][j] ;
-
-        Eigen::Vector3d qi = tmp - x0cm;
-
-        this->m_q.push_back(qi);
+        Eigen::Vector3d qi(this->m_qx[k], this->m_qy[k], this->m_qz[k]);
 
-        Vec9d m_qitild;
+        Vec9d& m_qitild = m_qtild[k];
 
         m_qitild(0) = qi(0);
         m_qitild(1) = qi(1);
@@ -68,8 +62,6 @@ void ShapeMatchingQuadratic<PFP>::initialize()
         m_qitild(6) = qi(0) * qi(1) ;
         m_qitild(7) = qi(1) * qi(2) ;
         m_qitild(8) = qi(2) * qi(0) ;
-
-        m_qtild.push_back(m_qitild);
     }
 
     //compute Aqq~
@@ -78,7 +70,7 @@ void ShapeMatchingQuadratic<PFP>::initialize()
     for(unsigned int i = 0 ; i < m_qtild.size() ; ++i)
         for(int x=0;x<9;++x)
             for(int y=0;y<9;++y)
-                m_aqqtild(x,y) += this->m_mass[i] * m_qtild[i][x] * m_qtild[i][y];
+                m_aqqtild(x,y) += this->m_m[i] * m_qtild[i][x] * m_qtild[i][y];
 
     Eigen::FullPivLU<Matrix9d> lu(m_aqqtild);
     m_aqqtild = lu.inverse();
@@ -89,69 +81,30 @@ void ShapeMatchingQuadratic<PFP>::initialize()
 }
 
 template <typename PFP>
-void ShapeMatchingQuadratic<PFP>::shapeMatch()
+void ShapeMatchingQuadratic<PFP>::shapeMatch(unsigned int nbth)
 {
-    // p_{i}
-    std::vector<Eigen::Vector3d> m_p;
-
-    m_p.reserve(this->m_position.nbElements());
-
-    //1.
-    Matrix39d Apqtild;
-    Apqtild.setZero(3,9);
-
     //1.bis needed to compute R
-    Eigen::Vector3d xcm = this->massCenter();
-
-
-    Eigen::Matrix3d apq = Eigen::Matrix3d::Zero();
-    for(unsigned int i = this->m_position.begin() ; i < this->m_position.end() ; this->m_position.next(i))
-    {
-       //this->m_p[i] = VEC3(this->m_position[i] - xcm); //p_{i} = x_{i} - x_{cm}
-
-        Eigen::Vector3d tmp ;
-        for (unsigned int j = 0 ; j < 3 ; ++j)
-            tmp(j) = this->m_position[i][j] ;
-
-       Eigen::Vector3d pi = tmp - xcm; //p_{i} = x_{i} - x_{cm}
+    Eigen::Vector3d xcm = this->gatherPositions(nbth);
 
-       m_p.push_back(pi) ;
-
-        //2.
-       for(unsigned int x=0; x<3; x++ )
-           for(unsigned int y=0; y<9; y++ )
-           {
-               if(y<3)
-                   apq(x,y) += m_p[i][x] * this->m_q[i][y];
-
-               Apqtild(x,y) += m_p[i][x] * m_qtild[i][y];
-           }
-
-    }
-
-
-    Eigen::Matrix3d S = apq.transpose() * apq ; //symmetric matrix
-
-    //3. Jacobi Diagonalisation
-    Eigen::EigenSolver<Eigen::Matrix3d> es(S);
-
-    //V * D * V^(-1)
-    Eigen::Matrix3d D = es.pseudoEigenvalueMatrix();
-    Eigen::Matrix3d U = es.pseudoEigenvectors() ;
-
-    for(int j = 0; j < 3; j++)
+    //1. & 2. A_{pq} (first 3 columns of A_{pq}~) and A_{pq}~
+    double sums[27];
+    this->reduce(27, [&] (unsigned int k, double* s)
     {
-        if(D(j,j) <= 0)
-        {
-            D(j,j) = 0.05f;
-        }
-        D(j,j) = 1.0f/sqrt(D(j,j));
-    }
+        double p[3] = { this->m_x[k] - xcm(0), this->m_y[k] - xcm(1), this->m_z[k] - xcm(2) }; //p_{i} = x_{i} - x_{cm}
+        const Vec9d& qt = m_qtild[k];
+        for(unsigned int x = 0 ; x < 3 ; ++x)
+            for(unsigned int y = 0 ; y < 9 ; ++y)
+                s[9 * x + y] += p[x] * qt(y);
+    }, sums, nbth);
 
-    S = U * D * U.transpose();
+    Matrix39d Apqtild;
+    for(unsigned int x = 0 ; x < 3 ; ++x)
+        for(unsigned int y = 0 ; y < 9 ; ++y)
+            Apqtild(x,y) = sums[9 * x + y];
 
-    Eigen::Matrix3d R = apq * S; //S^{-1}
+    Eigen::Matrix3d apq = Apqtild.block<3,3>(0,0);
 
+    Eigen::Matrix3d R = this->rotation(apq);
 
     // compute R~
     Matrix39d Rtild;
@@ -165,7 +118,7 @@ void ShapeMatchingQuadratic<PFP>::shapeMatch()
        // compute quadratic deformation
     Matrix39d Atild = Apqtild * m_aqqtild;
 
-    REAL det = Atild.determinant();
+    REAL det = Atild.block<3,3>(0,0).determinant(); // linear part
     det = 1.0f/powf(fabs(det),1.0f/9.0f);
 
     if(det<0.0f)
@@ -175,19 +128,15 @@ void ShapeMatchingQuadratic<PFP>::shapeMatch()
     Matrix39d T = this->m_beta * Atild * det + (1.0f - this->m_beta) * Rtild;
 
     //5.
-    for(unsigned int i = this->m_goal.begin() ; i < this->m_goal.end() ; this->m_goal.next(i))
+    CGoGN::Parallel::foreach_index((unsigned int)(this->m_lines.size()), [&] (unsigned int k, unsigned int)
     {
-
-        Eigen::Vector3d tmp = T * this->m_qtild[i];
+        Eigen::Vector3d tmp = T * m_qtild[k];
         tmp += xcm; // g_{i} = T * q_i + x_{cm}
 
-        VEC3 g;
+        VEC3& g = this->m_goal[this->m_lines[k]];
         for (unsigned int j = 0 ; j < 3 ; ++j)
-             g[j] = tmp(j);
-
-         this->m_goal[i] = g;
-    }
-
+             g[j] = REAL(tmp(j));
+    }, nbth);
 }
 
 } // namespace ShapeMatching
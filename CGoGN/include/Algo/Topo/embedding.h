@@ -108,7 +108,16 @@ inline void copyCellAttributes(MAP& m, Cell<ORBIT> d, Cell<ORBIT> e)
 		if(dE == EMBNULL)	// if the dest is NULL, create a new cell
 			dE = setOrbitEmbeddingOnNewCell(m, d) ;
 		AttributeContainer& cont = m.template getAttributeContainer<ORBIT>();
-		cont.copyLine(dE, eE) ;	// copy the data
+		const AttributeMultiVector<Dart>* quick = m.template getQuickTraversal<ORBIT>();
+		if (quick != NULL)	// the quick traversal dart of the dest must not be copied
+		{
+			AttributeMultiVector<Dart>* quickDest = cont.template getDataVector<Dart>(quick->getIndex());
+			Dart q = (*quickDest)[dE];
+			cont.copyLine(dE, eE) ;	// copy the data
+			(*quickDest)[dE] = q;
+		}
+		else
+			cont.copyLine(dE, eE) ;	// copy the data
 	}
 }
 
@@ -145,6 +145,18 @@ protected:
 	 */
 	std::map<std::string, RegisteredBaseAttribute*>* m_attributes_registry_map;
 
+	/**
+	 * allocator of the blocks of the attributes
+	 */
+	std::shared_ptr<BlockAllocator> m_blockAllocator;
+
+	/**
+	 * size of the blocks of lines: 1 << m_blockShift (line i is in block i >> m_blockShift
+	 * at position i & m_blockMask)
+	 */
+	unsigned int m_blockShift;
+	unsigned int m_blockMask;
+
 public:
 	AttributeContainer();
 
@@ -158,6 +170,24 @@ public:
 
 	void setContainerBrowser(ContainerBrowser* bro) { m_currentBrowser = bro; }
 
+	/**
+	 * get the allocator of the blocks of the attributes
+	 */
+	const std::shared_ptr<BlockAllocator>& getBlockAllocator() const { return m_blockAllocator; }
+
+	/**
+	 * change the allocator of the blocks of all (current and future) attributes
+	 */
+	void setBlockAllocator(std::shared_ptr<BlockAllocator> alloc);
+
+	/**
+	 * set the number of lines of the blocks of the container
+	 * only possible while the container has no block (e.g. at map creation)
+	 * @param nbLines power of two in [_BLOCKSIZE_MIN_, _BLOCKSIZE_MAX_]
+	 * @return false if not possible
+	 */
+	bool setBlockSize(unsigned int nbLines);
+
 	bool hasBrowser() { return m_currentBrowser != NULL; }
 
 	/**************************************
@@ -248,6 +278,26 @@ public:
 	*/
 	inline bool used(unsigned int index) const;
 
+	/**
+	* number of lines of the blocks of the container (power of two)
+	*/
+	inline unsigned int getBlockSize() const;
+
+	/**
+	* log2 of the block size
+	*/
+	inline unsigned int getBlockShift() const;
+
+	/**
+	* number of blocks of lines of the container
+	*/
+	inline unsigned int nbBlocks() const;
+
+	/**
+	* number of used lines in block b (lines [b*getBlockSize(), (b+1)*getBlockSize()[ )
+	*/
+	inline unsigned int nbUsedLinesInBlock(unsigned int b) const;
+
 	/**
 	 * @brief check if container contain marker attribute
 	 */
@@ -368,6 +418,12 @@ public:
 	 */
 	void compact(std::vector<unsigned int>& mapOldNew);
 
+	/**
+	 * permute the lines of the container (data, markers and ref counters)
+	 * @param mapOldNew new index of each used line, a permutation of the used lines (holes are ignored and stay holes)
+	 */
+	void permute(const std::vector<unsigned int>& mapOldNew);
+
 	/**
 	 * Test the fragmentation of container,
 	 * in fact just size/max_size
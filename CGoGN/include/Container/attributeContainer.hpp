@@ -77,6 +77,8 @@ AttributeMultiVector<T>* AttributeContainer::addAttribute(const std::string& att
 	// create the new attribute
 	std::string typeName = nameOfType(T()) ;
 	AttributeMultiVector<T>* amv = new AttributeMultiVector<T>(attribName, typeName) ;
+	amv->setBlockAllocator(m_blockAllocator) ;
+	amv->setBlockShift(m_blockShift) ;
 
 	if(!m_freeIndices.empty())
 	{
@@ -125,6 +127,8 @@ void AttributeContainer::addAttribute(const std::string& attribName, const std::
 
 	// create the new attribute
 	AttributeMultiVector<T>* amv = new AttributeMultiVector<T>(attribName, nametype);
+	amv->setBlockAllocator(m_blockAllocator) ;
+	amv->setBlockShift(m_blockShift) ;
 
 	m_tableAttribs[index] = amv;
 	amv->setOrbit(m_orbit) ;
@@ -224,7 +228,7 @@ inline unsigned int AttributeContainer::size() const
 
 inline unsigned int AttributeContainer::capacity() const
 {
-	return uint32(m_holesBlocks.size() * _BLOCKSIZE_);
+	return uint32(m_holesBlocks.size()) << m_blockShift;
 }
 
 inline unsigned int AttributeContainer::memoryTotalSize() const
@@ -239,7 +243,27 @@ inline unsigned int AttributeContainer::memorySize() const
 
 inline bool AttributeContainer::used(unsigned int index) const
 {
-	return m_holesBlocks[index / _BLOCKSIZE_]->used(index % _BLOCKSIZE_) != 0;
+	return m_holesBlocks[index >> m_blockShift]->used(index & m_blockMask) != 0;
+}
+
+inline unsigned int AttributeContainer::getBlockSize() const
+{
+	return m_blockMask + 1;
+}
+
+inline unsigned int AttributeContainer::getBlockShift() const
+{
+	return m_blockShift;
+}
+
+inline unsigned int AttributeContainer::nbBlocks() const
+{
+	return uint32(m_holesBlocks.size());
+}
+
+inline unsigned int AttributeContainer::nbUsedLinesInBlock(unsigned int b) const
+{
+	return m_holesBlocks[b]->nbUsed();
 }
 
 inline float AttributeContainer::fragmentation()
@@ -373,12 +397,12 @@ inline void AttributeContainer::copyLine(unsigned int dstIndex, unsigned int src
 
 inline void AttributeContainer::refLine(unsigned int index)
 {
-	m_holesBlocks[index / _BLOCKSIZE_]->ref(index % _BLOCKSIZE_);
+	m_holesBlocks[index >> m_blockShift]->ref(index & m_blockMask);
 }
 
 inline bool AttributeContainer::unrefLine(unsigned int index)
 {
-	if (m_holesBlocks[index / _BLOCKSIZE_]->unref(index % _BLOCKSIZE_))
+	if (m_holesBlocks[index >> m_blockShift]->unref(index & m_blockMask))
 	{
 		--m_size;
 		return true;
@@ -388,15 +412,15 @@ inline bool AttributeContainer::unrefLine(unsigned int index)
 
 inline unsigned int AttributeContainer::getNbRefs(unsigned int index) const
 {
-	unsigned int bi = index / _BLOCKSIZE_;
-	unsigned int j = index % _BLOCKSIZE_;
+	unsigned int bi = index >> m_blockShift;
+	unsigned int j = index & m_blockMask;
 
 	return m_holesBlocks[bi]->nbRefs(j);
 }
 
 inline void AttributeContainer::setNbRefs(unsigned int index, unsigned int nb)
 {
-	m_holesBlocks[index / _BLOCKSIZE_]->setNbRefs(index % _BLOCKSIZE_, nb);
+	m_holesBlocks[index >> m_blockShift]->setNbRefs(index & m_blockMask, nb);
 }
 
 /**************************************
@@ -466,7 +490,7 @@ template <typename T>
 inline T& AttributeContainer::getData(unsigned int attrIndex, unsigned int eltIndex)
 {
 	assert(eltIndex < m_maxSize || !"getData: element index out of bounds");
-	assert(m_holesBlocks[eltIndex / _BLOCKSIZE_]->used(eltIndex % _BLOCKSIZE_) || !"getData: element does not exist");
+	assert(m_holesBlocks[eltIndex >> m_blockShift]->used(eltIndex & m_blockMask) || !"getData: element does not exist");
 	assert((m_tableAttribs[attrIndex] != NULL) || !"getData: attribute does not exist");
 
 	AttributeMultiVector<T>* atm = dynamic_cast<AttributeMultiVector<T>*>(m_tableAttribs[attrIndex]);
@@ -479,7 +503,7 @@ template <typename T>
 inline const T& AttributeContainer::getData(unsigned int attrIndex, unsigned int eltIndex) const
 {
 	assert(eltIndex < m_maxSize || !"getData: element index out of bounds");
-	assert(m_holesBlocks[eltIndex / _BLOCKSIZE_]->used(eltIndex % _BLOCKSIZE_) || !"getData: element does not exist");
+	assert(m_holesBlocks[eltIndex >> m_blockShift]->used(eltIndex & m_blockMask) || !"getData: element does not exist");
 	assert((m_tableAttribs[attrIndex] != NULL) || !"getData: attribute does not exist");
 
 	AttributeMultiVector<T>* atm = dynamic_cast<AttributeMultiVector<T>*>(m_tableAttribs[attrIndex]);
@@ -492,7 +516,7 @@ template <typename T>
 inline void AttributeContainer::setData(unsigned int attrIndex, unsigned int eltIndex, const T& data)
 {
 	assert(eltIndex < m_maxSize || !"getData: element index out of bounds");
-	assert(m_holesBlocks[eltIndex / _BLOCKSIZE_]->used(eltIndex % _BLOCKSIZE_) || !"getData: element does not exist");
+	assert(m_holesBlocks[eltIndex >> m_blockShift]->used(eltIndex & m_blockMask) || !"getData: element does not exist");
 	assert((m_tableAttribs[attrIndex] != NULL) || !"getData: attribute does not exist");
 
 	AttributeMultiVector<T>* atm = dynamic_cast<AttributeMultiVector<T>*>(m_tableAttribs[attrIndex]);
@@ -30,10 +30,14 @@
 #include <sstream>
 #include <fstream>
 #include <cstring>
+#include <algorithm>
 
 #include <typeinfo>
+#include <memory>
+#include <cassert>
 
 #include "Container/sizeblock.h"
+#include "Container/blockAllocator.h"
 
 namespace CGoGN
 {
@@ -79,6 +83,17 @@ protected:
 	 */
 	unsigned int m_index;
 
+	/**
+	 * allocator of the blocks of data
+	 */
+	std::shared_ptr<BlockAllocator> m_blockAllocator;
+
+	/**
+	 * block size is 1 << m_blockShift, element i is at [i >> m_blockShift][i & m_blockMask]
+	 */
+	unsigned int m_blockShift;
+	unsigned int m_blockMask;
+
 public:
 	AttributeMultiVectorGen(const std::string& strName, const std::string& strType);
 
@@ -127,6 +142,27 @@ public:
 	 */
 	unsigned int getBlockSize() const;
 
+	/**
+	 * get log2 of block size
+	 */
+	unsigned int getBlockShift() const;
+
+	/**
+	 * set block size to 1 << shift (only before the first block is added)
+	 */
+	void setBlockShift(unsigned int shift);
+
+	/**
+	 * get the allocator of the blocks of data
+	 */
+	const std::shared_ptr<BlockAllocator>& getBlockAllocator() const;
+
+	/**
+	 * change the allocator of the blocks of data
+	 * (existing blocks are moved to the new allocator)
+	 */
+	virtual void setBlockAllocator(std::shared_ptr<BlockAllocator> alloc) = 0;
+
 	/**************************************
 	 *       MULTI VECTOR MANAGEMENT      *
 	 **************************************/
@@ -190,7 +226,7 @@ public:
 
 	virtual bool loadBin(CGoGNistream& fs) = 0;
 
-	static bool skipLoadBin(CGoGNistream& fs);
+	static bool skipLoadBin(CGoGNistream& fs, unsigned int blockSize = _BLOCKSIZE_);
 
 	/**
 	 * lecture binaire
@@ -216,6 +252,16 @@ class AttributeMultiVector : public AttributeMultiVectorGen
 
 	inline void setTypeCode();
 
+	/**
+	 * allocate and construct a block of data with the allocator
+	 */
+	T* newBlock();
+
+	/**
+	 * destruct a block of data and give it back to the allocator
+	 */
+	void deleteBlock(T* ptr);
+
 public:
 	AttributeMultiVector(const std::string& strName, const std::string& strType);
 
@@ -247,6 +293,8 @@ public:
 
 	int getSizeOfType() const;
 
+	void setBlockAllocator(std::shared_ptr<BlockAllocator> alloc);
+
 	/**************************************
 	 *             DATA ACCESS            *
 	 **************************************/
@@ -27,10 +27,13 @@ namespace CGoGN
 {
 
 inline AttributeMultiVectorGen::AttributeMultiVectorGen(const std::string& strName, const std::string& strType):
-	m_attrName(strName), m_typeName(strType)
+	m_attrName(strName), m_typeName(strType), m_blockAllocator(BlockAllocator::getDefault()),
+	m_blockShift(_BLOCKSIZE_SHIFT_), m_blockMask(_BLOCKSIZE_ - 1)
 {}
 
-inline AttributeMultiVectorGen::AttributeMultiVectorGen()
+inline AttributeMultiVectorGen::AttributeMultiVectorGen():
+	m_blockAllocator(BlockAllocator::getDefault()),
+	m_blockShift(_BLOCKSIZE_SHIFT_), m_blockMask(_BLOCKSIZE_ - 1)
 {}
 
 inline AttributeMultiVectorGen::~AttributeMultiVectorGen()
@@ -82,7 +85,19 @@ inline void AttributeMultiVectorGen::setTypeName(const std::string& n)
 
 inline unsigned int AttributeMultiVectorGen::getBlockSize() const
 {
-	return _BLOCKSIZE_ ;
+	return m_blockMask + 1 ;
+}
+
+inline unsigned int AttributeMultiVectorGen::getBlockShift() const
+{
+	return m_blockShift ;
+}
+
+inline void AttributeMultiVectorGen::setBlockShift(unsigned int shift)
+{
+	assert(getNbBlocks() == 0 || !"setBlockShift: attribute already has blocks");
+	m_blockShift = shift ;
+	m_blockMask = (1u << shift) - 1 ;
 }
 
 inline CGoGNCodeType AttributeMultiVectorGen::getTypeCode() const
@@ -90,6 +105,11 @@ inline CGoGNCodeType AttributeMultiVectorGen::getTypeCode() const
 	return m_typeCode;
 }
 
+inline const std::shared_ptr<BlockAllocator>& AttributeMultiVectorGen::getBlockAllocator() const
+{
+	return m_blockAllocator;
+}
+
 /***************************************************************************************************/
 /***************************************************************************************************/
 
@@ -110,8 +130,7 @@ AttributeMultiVector<T>::AttributeMultiVector()
 template <typename T>
 AttributeMultiVector<T>::~AttributeMultiVector()
 {
-	for (typename std::vector< T* >::iterator it = m_tableData.begin(); it != m_tableData.end(); ++it)
-		delete[] (*it);
+	clear();
 }
 
 template <typename T>
@@ -126,10 +145,27 @@ inline AttributeMultiVectorGen* AttributeMultiVector<T>::new_obj()
  *       MULTI VECTOR MANAGEMENT      *
  **************************************/
 
+template <typename T>
+T* AttributeMultiVector<T>::newBlock()
+{
+	T* ptr = static_cast<T*>(m_blockAllocator->allocate(getBlockSize() * sizeof(T)));
+	for (unsigned int i = 0; i < getBlockSize(); ++i)
+		new (ptr + i) T;
+	return ptr;
+}
+
+template <typename T>
+void AttributeMultiVector<T>::deleteBlock(T* ptr)
+{
+	for (unsigned int i = 0; i < getBlockSize(); ++i)
+		ptr[i].~T();
+	m_blockAllocator->release(ptr, getBlockSize() * sizeof(T));
+}
+
 template <typename T>
 inline void AttributeMultiVector<T>::addBlock()
 {
-	T* ptr = new T[_BLOCKSIZE_];
+	T* ptr = newBlock();
 	m_tableData.push_back(ptr);
 	// init
 //	T* endPtr = ptr + _BLOCKSIZE_;
@@ -148,7 +184,7 @@ void AttributeMultiVector<T>::setNbBlocks(unsigned int nbb)
 	else
 	{
 		for (size_t i = nbb; i < m_tableData.size(); ++i)
-			delete[] m_tableData[i];
+			deleteBlock(m_tableData[i]);
 		m_tableData.resize(nbb);
 	}
 }
@@ -191,7 +227,7 @@ bool AttributeMultiVector<T>::copy(const AttributeMultiVectorGen* atmvg)
 	}
 
 	for (unsigned int i = 0; i < atmv->m_tableData.size(); ++i)
-		std::memcpy( (void*) m_tableData[i], (void*) atmv->m_tableData[i], _BLOCKSIZE_ * sizeof(T));
+		std::memcpy( (void*) m_tableData[i], (void*) atmv->m_tableData[i], getBlockSize() * sizeof(T));
 
 	return true;
 }
@@ -213,6 +249,7 @@ bool AttributeMultiVector<T>::swap(AttributeMultiVectorGen* atmvg)
 	}
 
 	m_tableData.swap(atmv->m_tableData) ;
+	m_blockAllocator.swap(atmv->m_blockAllocator) ;
 	return true;
 }
 
@@ -232,8 +269,13 @@ bool AttributeMultiVector<T>::merge(const AttributeMultiVectorGen& att)
 		return false;
 	}
 
+	// blocks are copied: each attribute frees its own blocks with its own allocator
 	for (typename std::vector<T*>::const_iterator it = attrib->m_tableData.begin(); it != attrib->m_tableData.end(); ++it)
-		m_tableData.push_back(*it);
+	{
+		T* ptr = newBlock();
+		std::copy(*it, *it + getBlockSize(), ptr);
+		m_tableData.push_back(ptr);
+	}
 
 	return true;
 }
@@ -242,7 +284,7 @@ template <typename T>
 inline void AttributeMultiVector<T>::clear()
 {
 	for (typename std::vector< T* >::iterator it = m_tableData.begin(); it != m_tableData.end(); ++it)
-		delete[] (*it);
+		deleteBlock(*it);
 	m_tableData.clear();
 }
 
@@ -252,6 +294,25 @@ inline int AttributeMultiVector<T>::getSizeOfType() const
 	return sizeof(T);
 }
 
+template <typename T>
+void AttributeMultiVector<T>::setBlockAllocator(std::shared_ptr<BlockAllocator> alloc)
+{
+	if (alloc == m_blockAllocator)
+		return;
+
+	std::shared_ptr<BlockAllocator> old = m_blockAllocator;
+	for (typename std::vector<T*>::iterator it = m_tableData.begin(); it != m_tableData.end(); ++it)
+	{
+		m_blockAllocator = alloc;
+		T* ptr = newBlock();
+		std::copy(*it, *it + getBlockSize(), ptr);
+		m_blockAllocator = old;
+		deleteBlock(*it);
+		*it = ptr;
+	}
+	m_blockAllocator = alloc;
+}
+
 /**************************************
  *             DATA ACCESS            *
  **************************************/
@@ -259,19 +320,19 @@ inline int AttributeMultiVector<T>::getSizeOfType() const
 template <typename T>
 inline T& AttributeMultiVector<T>::operator[](unsigned int i)
 {
-	return m_tableData[i / _BLOCKSIZE_][i % _BLOCKSIZE_];
+	return m_tableData[i >> m_blockShift][i & m_blockMask];
 }
 
 template <typename T>
 inline const T& AttributeMultiVector<T>::operator[](unsigned int i) const
 {
-	return m_tableData[i / _BLOCKSIZE_][i % _BLOCKSIZE_];
+	return m_tableData[i >> m_blockShift][i & m_blockMask];
 }
 
 template <typename T>
 unsigned int AttributeMultiVector<T>::getBlocksPointers(std::vector<void*>& addr, unsigned int& byteBlockSize) const
 {
-	byteBlockSize = _BLOCKSIZE_ * sizeof(T);
+	byteBlockSize = getBlockSize() * sizeof(T);
 
 	addr.reserve(m_tableData.size());
 	addr.clear();
@@ -289,21 +350,21 @@ unsigned int AttributeMultiVector<T>::getBlocksPointers(std::vector<void*>& addr
 template <typename T>
 inline void AttributeMultiVector<T>::initElt(unsigned int id)
 {
-	m_tableData[id / _BLOCKSIZE_][id % _BLOCKSIZE_] = T(); // T(0);
+	m_tableData[id >> m_blockShift][id & m_blockMask] = T(); // T(0);
 }
 
 template <typename T>
 inline void AttributeMultiVector<T>::copyElt(unsigned int dst, unsigned int src)
 {
-	m_tableData[dst / _BLOCKSIZE_][dst % _BLOCKSIZE_] = m_tableData[src / _BLOCKSIZE_][src % _BLOCKSIZE_];
+	m_tableData[dst >> m_blockShift][dst & m_blockMask] = m_tableData[src >> m_blockShift][src & m_blockMask];
 }
 
 template <typename T>
 void AttributeMultiVector<T>::swapElt(unsigned int id1, unsigned int id2)
 {
-	T data = m_tableData[id1 / _BLOCKSIZE_][id1 % _BLOCKSIZE_] ;
-	m_tableData[id1 / _BLOCKSIZE_][id1 % _BLOCKSIZE_] = m_tableData[id2 / _BLOCKSIZE_][id2 % _BLOCKSIZE_] ;
-	m_tableData[id2 / _BLOCKSIZE_][id2 % _BLOCKSIZE_] = data ;
+	T data = m_tableData[id1 >> m_blockShift][id1 & m_blockMask] ;
+	m_tableData[id1 >> m_blockShift][id1 & m_blockMask] = m_tableData[id2 >> m_blockShift][id2 & m_blockMask] ;
+	m_tableData[id2 >> m_blockShift][id2 & m_blockMask] = data ;
 }
 
 template <typename T>
@@ -336,13 +397,13 @@ void AttributeMultiVector<T>::saveBin(CGoGNostream& fs, unsigned int id)
 	fs.write(reinterpret_cast<const char*>(buffer),(len1+len2)*sizeof(char));
 
 	nbs[0] = int(m_tableData.size());
-	nbs[1] = nbs[0] * _BLOCKSIZE_* sizeof(T);
+	nbs[1] = nbs[0] * getBlockSize()* sizeof(T);
 	fs.write(reinterpret_cast<const char*>(nbs),2*sizeof(unsigned int));
 
 	// store data blocks
 	for(unsigned int i=0; i<nbs[0]; ++i)
 	{
-		fs.write(reinterpret_cast<const char*>(m_tableData[i]),_BLOCKSIZE_*sizeof(T));
+		fs.write(reinterpret_cast<const char*>(m_tableData[i]),getBlockSize()*sizeof(T));
 	}
 }
 
@@ -376,15 +437,15 @@ bool AttributeMultiVector<T>::loadBin(CGoGNistream& fs)
 	m_tableData.resize(nb);
 	for(unsigned int i = 0; i < nb; ++i)
 	{
-		T* ptr = new T[_BLOCKSIZE_];
-		fs.read(reinterpret_cast<char*>(ptr),_BLOCKSIZE_*sizeof(T));
+		T* ptr = newBlock();
+		fs.read(reinterpret_cast<char*>(ptr),getBlockSize()*sizeof(T));
 		m_tableData[i] = ptr;
 	}
 
 	return true;
 }
 
-inline bool AttributeMultiVectorGen::skipLoadBin(CGoGNistream& fs)
+inline bool AttributeMultiVectorGen::skipLoadBin(CGoGNistream& fs, unsigned int blockSize)
 {
 	unsigned int nbs[2];
 	fs.read(reinterpret_cast<char*>(nbs), 2*sizeof(unsigned int));
@@ -393,18 +454,18 @@ inline bool AttributeMultiVectorGen::skipLoadBin(CGoGNistream& fs)
 	unsigned int nbb = nbs[1];
 
 	// check if nbb ok
-	if (nbb % _BLOCKSIZE_ != 0)
+	if (nbb % blockSize != 0)
 	{
 		CGoGNerr << "Error skipping wrong number of byte in attributes reading"<< CGoGNendl;
 		return false;
 	}
 
 	// skip data (no seek because of pb with gzstream)
-	char* ptr = new char[_BLOCKSIZE_];
+	char* ptr = new char[blockSize];
 	while (nbb != 0)
 	{
-		nbb -= _BLOCKSIZE_;
-		fs.read(reinterpret_cast<char*>(ptr),_BLOCKSIZE_);
+		nbb -= blockSize;
+		fs.read(reinterpret_cast<char*>(ptr),blockSize);
 	}
 	delete[] ptr;
 
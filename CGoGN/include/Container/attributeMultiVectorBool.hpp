@@ -45,6 +45,16 @@ class AttributeMultiVector<MarkerBool> : public AttributeMultiVectorGen
 	*/
 	std::vector< unsigned int* > m_tableData;
 
+	/**
+	 * allocate a block of bits (all false) with the allocator
+	 */
+	unsigned int* newBlock()
+	{
+		unsigned int* ptr = static_cast<unsigned int*>(m_blockAllocator->allocate(getBlockSize()/8));
+		memset(ptr,0,getBlockSize()/8);
+		return ptr;
+	}
+
 public:
 	AttributeMultiVector(const std::string& strName, const std::string& strType):
 		AttributeMultiVectorGen(strName, strType)
@@ -57,7 +67,10 @@ public:
 		m_tableData.reserve(1024);
 	}
 
-	~AttributeMultiVector() {}
+	~AttributeMultiVector()
+	{
+		clear();
+	}
 
 	inline AttributeMultiVectorGen* new_obj()
 	{
@@ -72,9 +85,7 @@ public:
 
 	void addBlock()
 	{
-		unsigned int* ptr = new unsigned int[_BLOCKSIZE_/32];
-		memset(ptr,0,_BLOCKSIZE_/8);
-		m_tableData.push_back(ptr);
+		m_tableData.push_back(newBlock());
 //		std::cout << "Marker "<<this->getName()<<" - addBlock"<< std::endl;
 	}
 
@@ -87,8 +98,8 @@ public:
 		}
 		else
 		{
-			for (size_t i = m_tableData.size()-1; i>=nbb; --i)
-				delete[] m_tableData[i];
+			for (size_t i = nbb; i < m_tableData.size(); ++i)
+				m_blockAllocator->release(m_tableData[i], getBlockSize()/8);
 
 			m_tableData.resize(nbb);
 		}
@@ -118,7 +129,7 @@ public:
 //		}
 
 		for (unsigned int i = 0; i < atmv->m_tableData.size(); ++i)
-			memcpy(m_tableData[i],atmv->m_tableData[i],_BLOCKSIZE_/8);
+			memcpy(m_tableData[i],atmv->m_tableData[i],getBlockSize()/8);
 
 		return true;
 	}
@@ -139,6 +150,7 @@ public:
 		}
 
 		m_tableData.swap(atmv->m_tableData) ;
+		m_blockAllocator.swap(atmv->m_blockAllocator) ;
 		return true;
 	}
 
@@ -158,7 +170,11 @@ public:
 		}
 
 		for (auto it = attrib->m_tableData.begin(); it != attrib->m_tableData.end(); ++it)
-			m_tableData.push_back(*it);
+		{
+			unsigned int* ptr = newBlock();
+			memcpy(ptr,*it,getBlockSize()/8);
+			m_tableData.push_back(ptr);
+		}
 
 		return true;
 	}
@@ -166,7 +182,7 @@ public:
 	void clear()
 	{
 		for (auto it=m_tableData.begin(); it !=m_tableData.end(); ++it)
-			delete[] *it;
+			m_blockAllocator->release(*it, getBlockSize()/8);
 		m_tableData.clear();
 	}
 
@@ -175,12 +191,27 @@ public:
 		return sizeof(bool); // ?
 	}
 
+	void setBlockAllocator(std::shared_ptr<BlockAllocator> alloc)
+	{
+		if (alloc == m_blockAllocator)
+			return;
+
+		for (auto it = m_tableData.begin(); it != m_tableData.end(); ++it)
+		{
+			unsigned int* ptr = static_cast<unsigned int*>(alloc->allocate(getBlockSize()/8));
+			memcpy(ptr,*it,getBlockSize()/8);
+			m_blockAllocator->release(*it, getBlockSize()/8);
+			*it = ptr;
+		}
+		m_blockAllocator = alloc;
+	}
+
 	inline void allFalse()
 	{
 		for (unsigned int i = 0; i < m_tableData.size(); ++i)
 		{
 			unsigned int *ptr =m_tableData[i];
-			for (unsigned int j=0; j<_BLOCKSIZE_/32;++j)
+			for (unsigned int j=0; j<getBlockSize()/32;++j)
 				*ptr++ = 0;
 		}
 		//memset(m_tableData[i],0,_BLOCKSIZE_/8);
@@ -191,7 +222,7 @@ public:
 		for (unsigned int i = 0; i < m_tableData.size(); ++i)
 		{
 			unsigned int *ptr =m_tableData[i];
-			for (unsigned int j=0; j<_BLOCKSIZE_/32;++j)
+			for (unsigned int j=0; j<getBlockSize()/32;++j)
 				*ptr++ = 0xffffffff;
 		}
 		//memset(m_tableData[i],0,_BLOCKSIZE_/8);
@@ -202,7 +233,7 @@ public:
 		for (unsigned int i = 0; i < m_tableData.size(); ++i)
 		{
 			unsigned int *ptr =m_tableData[i];
-			for (unsigned int j=0; j<_BLOCKSIZE_/32;++j)
+			for (unsigned int j=0; j<getBlockSize()/32;++j)
 				if (*ptr++ != 0)
 					return false;
 		}
@@ -214,7 +245,7 @@ public:
 		for (unsigned int i = 0; i < m_tableData.size(); ++i)
 		{
 			unsigned int *ptr =m_tableData[i];
-			for (unsigned int j=0; j<_BLOCKSIZE_/32;++j)
+			for (unsigned int j=0; j<getBlockSize()/32;++j)
 				if (*ptr++ != 0xffffffff)
 					return false;
 		}
@@ -228,8 +259,8 @@ public:
 
 	inline void setFalse(unsigned int i)
 	{
-		unsigned int jj = i / _BLOCKSIZE_;
-		unsigned int j = i % _BLOCKSIZE_;
+		unsigned int jj = i >> m_blockShift;
+		unsigned int j = i & m_blockMask;
 		unsigned int x = j/32;
 		unsigned int y = j%32;
 		unsigned int mask = 1 << y;
@@ -238,8 +269,8 @@ public:
 
 	inline void setTrue(unsigned int i)
 	{
-		unsigned int jj = i / _BLOCKSIZE_;
-		unsigned int j = i % _BLOCKSIZE_;
+		unsigned int jj = i >> m_blockShift;
+		unsigned int j = i & m_blockMask;
 		unsigned int x = j/32;
 		unsigned int y = j%32;
 		unsigned int mask = 1 << y;
@@ -248,8 +279,8 @@ public:
 
 	inline void setVal(unsigned int i, bool b)
 	{
-		unsigned int jj = i / _BLOCKSIZE_;
-		unsigned int j = i % _BLOCKSIZE_;
+		unsigned int jj = i >> m_blockShift;
+		unsigned int j = i & m_blockMask;
 		unsigned int x = j/32;
 		unsigned int y = j%32;
 		unsigned int mask = 1 << y;
@@ -266,8 +297,8 @@ public:
 	 */
 	inline bool operator[](unsigned int i) const
 	{
-		unsigned int jj = i / _BLOCKSIZE_;
-		unsigned int j = i % _BLOCKSIZE_;
+		unsigned int jj = i >> m_blockShift;
+		unsigned int j = i & m_blockMask;
 		unsigned int x = j/32;
 		unsigned int y = j%32;
 
@@ -361,11 +392,11 @@ public:
 		fs.write(reinterpret_cast<const char*>(buffer),(len1+len2)*sizeof(char));
 
 		nbs[0] = int(m_tableData.size());
-		nbs[1] = nbs[0] * _BLOCKSIZE_/32;
+		nbs[1] = nbs[0] * getBlockSize()/8;
 		fs.write(reinterpret_cast<const char*>(nbs),2*sizeof(unsigned int));
 
 		for (auto ptrIt = m_tableData.begin(); ptrIt!=m_tableData.end(); ++ptrIt)
-			fs.write(reinterpret_cast<const char*>(*ptrIt),_BLOCKSIZE_/8);
+			fs.write(reinterpret_cast<const char*>(*ptrIt),getBlockSize()/8);
 	}
 
 
@@ -385,8 +416,8 @@ public:
 
 		for(unsigned int i = 0; i < nb; ++i)
 		{
-			m_tableData[i] = new unsigned int[_BLOCKSIZE_/32];
-			fs.read(reinterpret_cast<char*>(m_tableData[i]),_BLOCKSIZE_/8);
+			m_tableData[i] = static_cast<unsigned int*>(m_blockAllocator->allocate(getBlockSize()/8));
+			fs.read(reinterpret_cast<char*>(m_tableData[i]),getBlockSize()/8);
 		}
 
 		return true;
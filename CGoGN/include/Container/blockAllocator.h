@@ -0,0 +1,151 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef __BLOCK_ALLOCATOR__
+#define __BLOCK_ALLOCATOR__
+
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <cstddef>
+
+#ifdef WIN32
+#if defined CGoGN_CONTAINER_DLL_EXPORT
+#define CGoGN_CONTAINER_API __declspec(dllexport)
+#else
+#define CGoGN_CONTAINER_API __declspec(dllimport)
+#endif
+#else
+#define CGoGN_CONTAINER_API
+#endif
+
+namespace CGoGN
+{
+
+/**
+ * Allocator of the blocks of data of the AttributeMultiVectors.
+ * Each AttributeMultiVector keeps a shared pointer on the allocator of its blocks,
+ * so an allocator lives as long as one of its blocks.
+ */
+class CGoGN_CONTAINER_API BlockAllocator
+{
+public:
+	virtual ~BlockAllocator() {}
+
+	/**
+	 * allocate a block of nbBytes (aligned at least as a new[])
+	 */
+	virtual void* allocate(std::size_t nbBytes) = 0;
+
+	/**
+	 * give back a block allocated with the same nbBytes
+	 */
+	virtual void release(void* ptr, std::size_t nbBytes) = 0;
+
+	/**
+	 * give back several blocks of nbBytes
+	 */
+	virtual void release(const std::vector<void*>& ptrs, std::size_t nbBytes);
+
+	/**
+	 * allocator given to new containers (heap allocator by default)
+	 */
+	static std::shared_ptr<BlockAllocator> getDefault();
+
+	/**
+	 * change the allocator given to containers created after the call
+	 */
+	static void setDefault(std::shared_ptr<BlockAllocator> alloc);
+};
+
+/**
+ * blocks allocated one by one with new[] / delete[]
+ */
+class CGoGN_CONTAINER_API HeapBlockAllocator : public BlockAllocator
+{
+public:
+	void* allocate(std::size_t nbBytes);
+
+	void release(void* ptr, std::size_t nbBytes);
+};
+
+/**
+ * blocks carved from big aligned slabs (2MB by default, the size of a huge page)
+ * Released blocks are kept in free lists (one by size) and recycled
+ * by next allocations; slabs are freed with the arena.
+ */
+class CGoGN_CONTAINER_API ArenaBlockAllocator : public BlockAllocator
+{
+protected:
+	std::size_t m_slabSize;
+
+	bool m_hugePages;
+
+	/// slabs and big blocks allocated by the arena
+	std::vector<void*> m_slabs;
+
+	/// free space of the current slab
+	char* m_current;
+	std::size_t m_remaining;
+
+	/// released blocks by size
+	std::map< std::size_t, std::vector<void*> > m_freeBlocks;
+
+	std::size_t m_nbBytesReserved;
+
+	std::mutex m_mutex;
+
+	void* newSlab(std::size_t nbBytes);
+
+	/// blocks bigger than that get their own slab
+	inline std::size_t maxCarvedSize() const { return m_slabSize / 4; }
+
+	/// carved blocks are multiple of cache lines
+	static inline std::size_t roundSize(std::size_t nbBytes) { return (nbBytes + 63) & ~std::size_t(63); }
+
+public:
+	/**
+	 * @param hugePages advise the system to back the slabs with huge pages (linux only)
+	 * @param slabSize size of the slabs (multiple of 2MB for huge pages)
+	 */
+	ArenaBlockAllocator(bool hugePages = true, std::size_t slabSize = 2 * 1024 * 1024);
+
+	~ArenaBlockAllocator();
+
+	void* allocate(std::size_t nbBytes);
+
+	void release(void* ptr, std::size_t nbBytes);
+
+	void release(const std::vector<void*>& ptrs, std::size_t nbBytes);
+
+	/**
+	 * memory taken from the system by the arena
+	 */
+	std::size_t nbBytesReserved() const { return m_nbBytesReserved; }
+};
+
+} // namespace CGoGN
+
+#endif
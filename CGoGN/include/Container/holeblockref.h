@@ -55,11 +55,17 @@ protected:
 	*/
 	unsigned int m_nb;
 
+	/**
+	* max nb elements in block
+	*/
+	unsigned int m_blockSize;
+
 public:
 	/**
 	* constructor
+	* @param blockSize number of lines of the block
 	*/
-	HoleBlockRef();
+	HoleBlockRef(unsigned int blockSize = _BLOCKSIZE_);
 
 	/**
 	 * copy constructor
@@ -96,13 +102,18 @@ public:
 	/**
 	* is the block full
 	*/
-	inline bool full() const { return m_nb == _BLOCKSIZE_;  }
+	inline bool full() const { return m_nb == m_blockSize;  }
 
 	/**
 	*  is the block empty
 	*/
 	inline bool empty() const { return m_nb == 0; }
 
+	/**
+	* number of used elements of the block
+	*/
+	inline unsigned int nbUsed() const { return m_nb; }
+
 	/**
 	* is this index used or not
 	*/
@@ -26,15 +26,26 @@
 #define _SIZEBLOCK_H_
 
 #include "Utils/gzstream.h"
+#include "Utils/binaryStream.h"
 #include "Utils/cgognStream.h"
 
+/// default number of lines of the blocks of a container (power of two)
 const unsigned int _BLOCKSIZE_ = 4096;
+const unsigned int _BLOCKSIZE_SHIFT_ = 12;
+
+/// bounds of the block size of a container (MarkerBool blocks store 32 lines per word)
+const unsigned int _BLOCKSIZE_MIN_ = 32;
+const unsigned int _BLOCKSIZE_MAX_ = 1u << 24;
 
 //typedef std::ifstream CGoGNistream;
 //typedef std::ofstream CGoGNostream;
 
-/// use everywhere in save/load compressed stream
-typedef igzstream CGoGNistream;
-typedef ogzstream CGoGNostream;
+/// use everywhere in save/load binary stream (gzip, raw or LZ4)
+typedef CGoGN::Utils::BinaryIStream CGoGNistream;
+typedef CGoGN::Utils::BinaryOStream CGoGNostream;
+
+/// version of the binary map files, stored in the 256 bytes header (uint at 68, format at 72)
+/// 1: gzip only, no version in header (0xFFFFFFFF), 2: gzip, raw or LZ4
+const unsigned int _MAPBIN_VERSION_ = 2;
 
 #endif /* SIZEBLOCK_H_ */
@@ -25,6 +25,8 @@
 #ifndef __BOUNDING_BOX__
 #define __BOUNDING_BOX__
 
+#include <string>
+
 namespace CGoGN
 {
 
@@ -38,6 +40,8 @@ template <typename VEC>
 class BoundingBox
 {
 public:
+	static std::string CGoGNnameOfType() { return std::string("Geom::BoundingBox<") + VEC::CGoGNnameOfType() + std::string(">") ; }
+
 	/**********************************************/
 	/*                CONSTRUCTORS                */
 	/**********************************************/
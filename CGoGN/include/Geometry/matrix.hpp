@@ -480,6 +480,133 @@ Matrix<M,N,T> transposed_vectors_mult(const Vector<M,T>& v1, const Vector<N,T>&
 	return res ;
 }
 
+/**********************************************/
+/*            SIMD SPECIALIZATIONS            */
+/**********************************************/
+
+#ifdef CGOGN_SIMD_SSE2
+
+// the rows of the result are combinations of the rows of m, in the order of the generic product
+
+template <>
+template <>
+inline Matrix<3,3,float> Matrix<3,3,float>::operator*<3>(const Matrix<3,3,float>& m) const
+{
+	Matrix<3,3,float> res ;
+	__m128 r0 = SIMD::load3(m.m_data[0]) ;
+	__m128 r1 = SIMD::load3(m.m_data[1]) ;
+	__m128 r2 = SIMD::load3(m.m_data[2]) ;
+	for(unsigned int i = 0; i < 3; ++i)
+	{
+		__m128 s = _mm_mul_ps(_mm_set1_ps(m_data[i][0]), r0) ;
+		s = _mm_add_ps(s, _mm_mul_ps(_mm_set1_ps(m_data[i][1]), r1)) ;
+		s = _mm_add_ps(s, _mm_mul_ps(_mm_set1_ps(m_data[i][2]), r2)) ;
+		SIMD::store3(res.m_data[i], s) ;
+	}
+	return res ;
+}
+
+template <>
+template <>
+inline Matrix<4,4,float> Matrix<4,4,float>::operator*<4>(const Matrix<4,4,float>& m) const
+{
+	Matrix<4,4,float> res ;
+	__m128 r0 = _mm_loadu_ps(m.m_data[0]) ;
+	__m128 r1 = _mm_loadu_ps(m.m_data[1]) ;
+	__m128 r2 = _mm_loadu_ps(m.m_data[2]) ;
+	__m128 r3 = _mm_loadu_ps(m.m_data[3]) ;
+	for(unsigned int i = 0; i < 4; ++i)
+	{
+		__m128 s = _mm_mul_ps(_mm_set1_ps(m_data[i][0]), r0) ;
+		s = _mm_add_ps(s, _mm_mul_ps(_mm_set1_ps(m_data[i][1]), r1)) ;
+		s = _mm_add_ps(s, _mm_mul_ps(_mm_set1_ps(m_data[i][2]), r2)) ;
+		s = _mm_add_ps(s, _mm_mul_ps(_mm_set1_ps(m_data[i][3]), r3)) ;
+		_mm_storeu_ps(res.m_data[i], s) ;
+	}
+	return res ;
+}
+
+template <>
+inline Vector<4,float> Matrix<4,4,float>::operator*(const Vector<4,float>& v) const
+{
+	// combination of the columns
+	__m128 c0 = _mm_loadu_ps(m_data[0]) ;
+	__m128 c1 = _mm_loadu_ps(m_data[1]) ;
+	__m128 c2 = _mm_loadu_ps(m_data[2]) ;
+	__m128 c3 = _mm_loadu_ps(m_data[3]) ;
+	_MM_TRANSPOSE4_PS(c0, c1, c2, c3) ;
+	__m128 w = _mm_loadu_ps(v.data()) ;
+	__m128 s = _mm_mul_ps(c0, _mm_shuffle_ps(w, w, _MM_SHUFFLE(0, 0, 0, 0))) ;
+	s = _mm_add_ps(s, _mm_mul_ps(c1, _mm_shuffle_ps(w, w, _MM_SHUFFLE(1, 1, 1, 1)))) ;
+	s = _mm_add_ps(s, _mm_mul_ps(c2, _mm_shuffle_ps(w, w, _MM_SHUFFLE(2, 2, 2, 2)))) ;
+	s = _mm_add_ps(s, _mm_mul_ps(c3, _mm_shuffle_ps(w, w, _MM_SHUFFLE(3, 3, 3, 3)))) ;
+	Vector<4,float> res ;
+	_mm_storeu_ps(res.data(), s) ;
+	return res ;
+}
+
+#ifdef CGOGN_SIMD_AVX
+
+template <>
+template <>
+inline Matrix<3,3,double> Matrix<3,3,double>::operator*<3>(const Matrix<3,3,double>& m) const
+{
+	Matrix<3,3,double> res ;
+	__m256d r0 = SIMD::load3(m.m_data[0]) ;
+	__m256d r1 = SIMD::load3(m.m_data[1]) ;
+	__m256d r2 = SIMD::load3(m.m_data[2]) ;
+	for(unsigned int i = 0; i < 3; ++i)
+	{
+		__m256d s = _mm256_mul_pd(_mm256_set1_pd(m_data[i][0]), r0) ;
+		s = _mm256_add_pd(s, _mm256_mul_pd(_mm256_set1_pd(m_data[i][1]), r1)) ;
+		s = _mm256_add_pd(s, _mm256_mul_pd(_mm256_set1_pd(m_data[i][2]), r2)) ;
+		SIMD::store3(res.m_data[i], s) ;
+	}
+	return res ;
+}
+
+#else
+
+template <>
+template <>
+inline Matrix<3,3,double> Matrix<3,3,double>::operator*<3>(const Matrix<3,3,double>& m) const
+{
+	Matrix<3,3,double> res ;
+	SIMD::Double3 r[3] = { SIMD::load3(m.m_data[0]), SIMD::load3(m.m_data[1]), SIMD::load3(m.m_data[2]) } ;
+	for(unsigned int i = 0; i < 3; ++i)
+	{
+		SIMD::Double3 s ;
+		__m128d a = _mm_set1_pd(m_data[i][0]) ;
+		s.xy = _mm_mul_pd(a, r[0].xy) ;
+		s.z = _mm_mul_sd(a, r[0].z) ;
+		for(unsigned int k = 1; k < 3; ++k)
+		{
+			a = _mm_set1_pd(m_data[i][k]) ;
+			s.xy = _mm_add_pd(s.xy, _mm_mul_pd(a, r[k].xy)) ;
+			s.z = _mm_add_sd(s.z, _mm_mul_sd(a, r[k].z)) ;
+		}
+		SIMD::store3(res.m_data[i], s) ;
+	}
+	return res ;
+}
+
+#endif
+
+// Vector / Matrix multiplication: combination of the rows
+inline Vector<4,float> operator*(const Vector<4,float>& v, const Matrix<4,4,float>& m)
+{
+	__m128 w = _mm_loadu_ps(v.data()) ;
+	__m128 s = _mm_mul_ps(_mm_shuffle_ps(w, w, _MM_SHUFFLE(0, 0, 0, 0)), _mm_loadu_ps(&m(0,0))) ;
+	s = _mm_add_ps(s, _mm_mul_ps(_mm_shuffle_ps(w, w, _MM_SHUFFLE(1, 1, 1, 1)), _mm_loadu_ps(&m(1,0)))) ;
+	s = _mm_add_ps(s, _mm_mul_ps(_mm_shuffle_ps(w, w, _MM_SHUFFLE(2, 2, 2, 2)), _mm_loadu_ps(&m(2,0)))) ;
+	s = _mm_add_ps(s, _mm_mul_ps(_mm_shuffle_ps(w, w, _MM_SHUFFLE(3, 3, 3, 3)), _mm_loadu_ps(&m(3,0)))) ;
+	Vector<4,float> res ;
+	_mm_storeu_ps(res.data(), s) ;
+	return res ;
+}
+
+#endif // CGOGN_SIMD_SSE2
+
 } // namespace Geom
 
 } // namespace CGoGN
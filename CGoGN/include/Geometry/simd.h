@@ -0,0 +1,156 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#ifndef __GEOM_SIMD__
+#define __GEOM_SIMD__
+
+/*
+ * SSE/AVX support of the small vectors and matrices (see vector_gen.hpp and matrix.hpp).
+ * SSE2 is used when the compiler targets it (always on x86-64), AVX when it is
+ * enabled by the compiler flags (-mavx). Define CGOGN_NO_SIMD (CMake option
+ * CGoGN_WITH_SIMD) to use only the generic loops.
+ *
+ * Specialized: Vector<4,float>, Vector<4,double> (AVX), the 3x3 and 4x4 float
+ * products and the 3x3 double product.
+ * Vector<3,T> keeps its packed layout (it is the layout of the attributes, of the
+ * VBOs and of the files): the loads and stores of 3 components in SSE registers cost
+ * more than the operations, and the compilers already vectorize the generic loops
+ * of the expressions (normals, areas...), so it is not specialized.
+ * The matrix rows of 3 components are loaded without touching the memory after them.
+ *
+ * The kernels do the operations of the generic code in the same order, so they give
+ * the same results (up to the fused multiply-adds the compiler may contract).
+ */
+
+#ifndef CGOGN_NO_SIMD
+	#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+		#define CGOGN_SIMD_SSE2
+		#include <emmintrin.h>
+	#endif
+	#if defined(CGOGN_SIMD_SSE2) && defined(__AVX__)
+		#define CGOGN_SIMD_AVX
+		#include <immintrin.h>
+	#endif
+#endif
+
+#ifdef CGOGN_SIMD_SSE2
+
+namespace CGoGN
+{
+
+namespace Geom
+{
+
+namespace SIMD
+{
+
+/**********************************************/
+/*                   FLOAT                    */
+/**********************************************/
+
+// (x,y,z,0) from 3 floats
+inline __m128 load3(const float* p)
+{
+	__m128 xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(p)));
+	__m128 z = _mm_load_ss(p + 2);
+	return _mm_movelh_ps(xy, z);
+}
+
+inline void store3(float* p, __m128 v)
+{
+	_mm_store_sd(reinterpret_cast<double*>(p), _mm_castps_pd(v));
+	_mm_store_ss(p + 2, _mm_movehl_ps(v, v));
+}
+
+// (((v0 + v1) + v2) + v3)
+inline float sum4(__m128 v)
+{
+	__m128 s = _mm_add_ss(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)));
+	s = _mm_add_ss(s, _mm_movehl_ps(v, v));
+	s = _mm_add_ss(s, _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3)));
+	return _mm_cvtss_f32(s);
+}
+
+/**********************************************/
+/*                   DOUBLE                   */
+/**********************************************/
+
+#ifdef CGOGN_SIMD_AVX
+
+// (x,y,z,0) from 3 doubles
+inline __m256d load3(const double* p)
+{
+	return _mm256_insertf128_pd(_mm256_castpd128_pd256(_mm_loadu_pd(p)), _mm_load_sd(p + 2), 1);
+}
+
+inline void store3(double* p, __m256d v)
+{
+	_mm_storeu_pd(p, _mm256_castpd256_pd128(v));
+	_mm_store_sd(p + 2, _mm256_extractf128_pd(v, 1));
+}
+
+// (((v0 + v1) + v2) + v3)
+inline double sum4(__m256d v)
+{
+	__m128d lo = _mm256_castpd256_pd128(v);
+	__m128d hi = _mm256_extractf128_pd(v, 1);
+	__m128d s = _mm_add_sd(lo, _mm_unpackhi_pd(lo, lo));
+	s = _mm_add_sd(s, hi);
+	s = _mm_add_sd(s, _mm_unpackhi_pd(hi, hi));
+	return _mm_cvtsd_f64(s);
+}
+
+#else
+
+// 3 doubles as a pair (x,y) and a scalar (z,0)
+struct Double3
+{
+	__m128d xy;
+	__m128d z;
+};
+
+inline Double3 load3(const double* p)
+{
+	Double3 r = { _mm_loadu_pd(p), _mm_load_sd(p + 2) };
+	return r;
+}
+
+inline void store3(double* p, const Double3& v)
+{
+	_mm_storeu_pd(p, v.xy);
+	_mm_store_sd(p + 2, v.z);
+}
+
+#endif
+
+} // namespace SIMD
+
+} // namespace Geom
+
+} // namespace CGoGN
+
+#endif
+
+#endif
@@ -32,6 +32,7 @@
 
 #include "Utils/static_assert.h"
 #include "Utils/nameTypes.h"
+#include "Geometry/simd.h"
 
 namespace CGoGN
 {
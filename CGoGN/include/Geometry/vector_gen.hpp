@@ -501,6 +501,104 @@ inline Vector<DIM, T> slerp(const Vector<DIM, T>& v1, const Vector<DIM, T>& v2,
 	return res ;
 }
 
+/**********************************************/
+/*            SIMD SPECIALIZATIONS            */
+/**********************************************/
+
+#ifdef CGOGN_SIMD_SSE2
+
+// Vector<4, float>
+
+template <>
+inline Vector<4, float>& Vector<4, float>::operator+=(const Vector<4, float>& v)
+{
+	_mm_storeu_ps(m_data, _mm_add_ps(_mm_loadu_ps(m_data), _mm_loadu_ps(v.m_data))) ;
+	return *this ;
+}
+
+template <>
+inline Vector<4, float>& Vector<4, float>::operator-=(const Vector<4, float>& v)
+{
+	_mm_storeu_ps(m_data, _mm_sub_ps(_mm_loadu_ps(m_data), _mm_loadu_ps(v.m_data))) ;
+	return *this ;
+}
+
+template <>
+inline Vector<4, float> Vector<4, float>::operator+(const Vector<4, float>& v) const
+{
+	Vector<4, float> res(*this) ;
+	return res += v ;
+}
+
+template <>
+inline Vector<4, float> Vector<4, float>::operator-(const Vector<4, float>& v) const
+{
+	Vector<4, float> res(*this) ;
+	return res -= v ;
+}
+
+template <>
+inline float Vector<4, float>::operator*(const Vector<4, float>& v) const
+{
+	return SIMD::sum4(_mm_mul_ps(_mm_loadu_ps(m_data), _mm_loadu_ps(v.m_data))) ;
+}
+
+template <>
+inline float Vector<4, float>::norm2() const
+{
+	__m128 a = _mm_loadu_ps(m_data) ;
+	return SIMD::sum4(_mm_mul_ps(a, a)) ;
+}
+
+#ifdef CGOGN_SIMD_AVX
+
+// Vector<4, double>
+
+template <>
+inline Vector<4, double>& Vector<4, double>::operator+=(const Vector<4, double>& v)
+{
+	_mm256_storeu_pd(m_data, _mm256_add_pd(_mm256_loadu_pd(m_data), _mm256_loadu_pd(v.m_data))) ;
+	return *this ;
+}
+
+template <>
+inline Vector<4, double>& Vector<4, double>::operator-=(const Vector<4, double>& v)
+{
+	_mm256_storeu_pd(m_data, _mm256_sub_pd(_mm256_loadu_pd(m_data), _mm256_loadu_pd(v.m_data))) ;
+	return *this ;
+}
+
+template <>
+inline Vector<4, double> Vector<4, double>::operator+(const Vector<4, double>& v) const
+{
+	Vector<4, double> res(*this) ;
+	return res += v ;
+}
+
+template <>
+inline Vector<4, double> Vector<4, double>::operator-(const Vector<4, double>& v) const
+{
+	Vector<4, double> res(*this) ;
+	return res -= v ;
+}
+
+template <>
+inline double Vector<4, double>::operator*(const Vector<4, double>& v) const
+{
+	return SIMD::sum4(_mm256_mul_pd(_mm256_loadu_pd(m_data), _mm256_loadu_pd(v.m_data))) ;
+}
+
+template <>
+inline double Vector<4, double>::norm2() const
+{
+	__m256d a = _mm256_loadu_pd(m_data) ;
+	return SIMD::sum4(_mm256_mul_pd(a, a)) ;
+}
+
+#endif // CGOGN_SIMD_AVX
+
+#endif // CGOGN_SIMD_SSE2
+
 } // namespace Geom
 
 } // namespace CGoGN
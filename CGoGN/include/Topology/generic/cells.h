@@ -123,6 +123,9 @@ typedef Cell<VOLUME> Vol;  // not Volume because of the namespace Volume
 namespace Parallel
 {
 const unsigned int SIZE_BUFFER_THREAD = 1024;
+
+/// number of ranges dealt to each thread by // traversals (load balanced by work stealing)
+const unsigned int NB_TASKS_PER_THREAD = 8;
 }
 
 }
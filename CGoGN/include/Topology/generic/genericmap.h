@@ -41,6 +41,7 @@
 #include "Topology/generic/cells.h"
 #include "Topology/generic/marker.h"
 #include "Topology/generic/functor.h"
+#include "Topology/generic/quickLocalTraversal.h"
 
 #include <thread>
 #include <mutex>
@@ -50,6 +51,11 @@
 namespace CGoGN
 {
 
+namespace Utils
+{
+class ThreadPool;
+}
+
 namespace Parallel
 {
 /**
@@ -69,6 +75,14 @@ inline int getSystemNumberOfCores(bool hyperthreading=false)
 	return std::thread::hardware_concurrency();
 }
 
+/**
+ * @brief get the persistent pool of worker threads shared by all // traversals
+ * (created at first call and grown when more workers are asked for)
+ * @param nbWorkers minimal number of workers of the pool
+ * @return the pool
+ */
+CGoGN_TOPO_API Utils::ThreadPool& getThreadPool(unsigned int nbWorkers);
+
 }
 
 // forward
@@ -121,8 +135,8 @@ public:
 	/// compute thread index in the table of thread
 	inline unsigned int getCurrentThreadIndex() const;
 
-//	/// register the given thread ID for access to resources on this map
-//	inline void addThreadId(const std::thread::id id);
+	/// register the given thread ID for access to resources on this map (return false if already known)
+	inline bool addThreadId(const std::thread::id id);
 
 	/// unregister the given thread to access resources on this map
 	inline void removeThreadId(const std::thread::id id);
@@ -169,8 +183,19 @@ protected:
 	 * (initialized by enableQuickTraversal function)
 	 */
 	AttributeMultiVector<Dart>* m_quickTraversal[NB_ORBITS] ;
-	AttributeMultiVector<NoTypeNameAttribute<std::vector<Dart> > >* m_quickLocalIncidentTraversal[NB_ORBITS][NB_ORBITS] ;
-	AttributeMultiVector<NoTypeNameAttribute<std::vector<Dart> > >* m_quickLocalAdjacentTraversal[NB_ORBITS][NB_ORBITS] ;
+
+	/**
+	 * false when a quick traversal table may reference a dart that left its cell
+	 * (partial re-embedding of a cell, compaction of darts)
+	 */
+	bool m_quickTraversalUpToDate[NB_ORBITS] ;
+
+	/**
+	 * Quick incident / adjacent traversal tables (CSR packed)
+	 * (initialized by enableQuickIncidentTraversal / enableQuickAdjacentTraversal functions)
+	 */
+	QuickLocalTraversal* m_quickLocalIncidentTraversal[NB_ORBITS][NB_ORBITS] ;
+	QuickLocalTraversal* m_quickLocalAdjacentTraversal[NB_ORBITS][NB_ORBITS] ;
 
 	std::vector< AttributeMultiVector<MarkerBool>* > m_markVectors_free[NB_ORBITS][NB_THREADS] ;
 	std::mutex m_MarkerStorageMutex[NB_ORBITS];
@@ -409,6 +434,21 @@ public:
 	 */
 	void swapEmbeddingContainers(unsigned int orbit1, unsigned int orbit2) ;
 
+	/**
+	 * change the allocator of the blocks of all the attributes of the map
+	 * (e.g. an ArenaBlockAllocator to get blocks from huge pages)
+	 */
+	virtual void setBlockAllocator(std::shared_ptr<BlockAllocator> alloc) ;
+
+	/**
+	 * set the number of lines of the blocks of all the attribute containers
+	 * (small blocks for many small maps, big blocks for huge maps)
+	 * only possible on a map without any dart (i.e. just after its creation)
+	 * @param nbLines power of two in [_BLOCKSIZE_MIN_, _BLOCKSIZE_MAX_]
+	 * @return false if not possible
+	 */
+	virtual bool setBlockSize(unsigned int nbLines) ;
+
 	/**
 	 * static function for type registration
 	 */
@@ -462,12 +502,13 @@ public:
 	/**
 	 * Save map in a binary file
 	 * @param filename the file name
+	 * @param format encoding of the file: gzip (default), raw (fastest) or LZ4
 	 * @return true if OK
 	 */
-	virtual bool saveMapBin(const std::string& filename) const = 0;
+	virtual bool saveMapBin(const std::string& filename, Utils::BinaryFormat format = Utils::BIN_GZIP) const = 0;
 
 	/**
-	 * Load map from a binary file
+	 * Load map from a binary file (any format, detected from the file)
 	 * @param filename the file name
 	 * @return true if OK
 	 */
@@ -505,6 +546,14 @@ public:
 	 */
 	void compactOrbitContainer(unsigned int orbit, float frag=1.0);
 
+	/**
+	 * permute the lines of a container (and update embedding attribute of topo)
+	 * Attributes of the orbit (and quick traversal tables) follow their cell.
+	 * @param orbit orbit of container to permute
+	 * @param mapOldNew new index of each used line (permutation of the used lines)
+	 */
+	void permuteOrbitContainer(unsigned int orbit, const std::vector<unsigned int>& mapOldNew);
+
 	/**
 	 * @brief compact if containers are fragmented.
 	 * @warning the quickTraversals needs to be updated
@@ -51,17 +51,17 @@ inline unsigned int GenericMap::getCurrentThreadIndex() const
 	}
 }
 
-//inline void GenericMap::addThreadId(const std::thread::id id)
-//{
-//	for (unsigned int i = 0; i < m_thread_ids.size(); ++i)
-//	{
-//		if (m_thread_ids[i] == id)
-//			return;
-//	}
-//	assert(m_thread_ids.size() < NB_THREADS + 1);
-//	if (m_authorizeExternalThreads)
-//		m_thread_ids.push_back(id);
-//}
+inline bool GenericMap::addThreadId(const std::thread::id id)
+{
+	for (unsigned int i = 0; i < m_thread_ids.size(); ++i)
+	{
+		if (m_thread_ids[i] == id)
+			return false;
+	}
+	assert(m_thread_ids.size() < NB_THREADS + 1);
+	m_thread_ids.push_back(id);
+	return true;
+}
 
 inline void GenericMap::removeThreadId(const std::thread::id id)
 {
@@ -196,7 +196,12 @@ inline void GenericMap::deleteDartLine(unsigned int index)
 		{
 			unsigned int emb = (*m_embeddings[orbit])[index] ;		// get the embedding of the dart
 			if(emb != EMBNULL)
-				m_attribs[orbit].unrefLine(emb);					// and unref the corresponding line
+			{
+				// and unref the corresponding line
+				// (a surviving cell may have lost the dart of its quick traversal table)
+				if (!m_attribs[orbit].unrefLine(emb) && m_quickTraversal[orbit] != NULL)
+					m_quickTraversalUpToDate[orbit] = false;
+			}
 		}
 	}
 }
@@ -252,6 +257,8 @@ inline void GenericMap::copyCell(unsigned int i, unsigned int j)
 {
 	assert(isOrbitEmbedded<ORBIT>() || !"Invalid parameter: orbit not embedded");
 	m_attribs[ORBIT].copyLine(i, j) ;
+	if (m_quickTraversal[ORBIT] != NULL)	// the quick traversal dart has been copied too
+		m_quickTraversalUpToDate[ORBIT] = false;
 }
 
 template <unsigned int ORBIT>
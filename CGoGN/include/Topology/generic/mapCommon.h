@@ -223,32 +223,59 @@ public:
 	template <unsigned int ORBIT>
 	const AttributeMultiVector<Dart>* getQuickTraversal() const;
 
+	/**
+	 * is the quick traversal table of ORBIT valid without a call to updateQuickTraversal
+	 */
+	template <unsigned int ORBIT>
+	bool isQuickTraversalUpToDate() const;
+
 	template <unsigned int ORBIT>
 	void disableQuickTraversal() ;
 
+protected:
+	/**
+	 * keep the quick traversal table of ORBIT valid when dart d goes from cell oldEmb to cell newEmb
+	 */
+	template <unsigned int ORBIT>
+	inline void updateQuickTraversalDart(Dart d, unsigned int oldEmb, unsigned int newEmb) ;
+
+public:
+	/**
+	 * tables of the incident (adjacent) cells of each cell of ORBIT, packed in CSR form
+	 * (see QuickLocalTraversal) and used by the local traversors of the cells.
+	 * The cells of ORBIT must be embedded. The tables are built in parallel by nbth threads
+	 * (nbth < 2: sequential build); they must be updated after a topological modification.
+	 */
 	template <typename MAP, unsigned int ORBIT, unsigned int INCI>
-	void enableQuickIncidentTraversal();
+	void enableQuickIncidentTraversal(unsigned int nbth = Parallel::NumberOfThreads);
 
 	template <typename MAP, unsigned int ORBIT, unsigned int INCI>
-	void updateQuickIncidentTraversal();
+	void updateQuickIncidentTraversal(unsigned int nbth = Parallel::NumberOfThreads);
 
 	template <unsigned int ORBIT, unsigned int INCI>
-	const AttributeMultiVector<NoTypeNameAttribute<std::vector<Dart> > >* getQuickIncidentTraversal() const;
+	const QuickLocalTraversal* getQuickIncidentTraversal() const;
 
 	template <unsigned int ORBIT, unsigned int INCI>
 	void disableQuickIncidentTraversal();
 
 	template <typename MAP, unsigned int ORBIT, unsigned int ADJ>
-	void enableQuickAdjacentTraversal();
+	void enableQuickAdjacentTraversal(unsigned int nbth = Parallel::NumberOfThreads);
 
 	template <typename MAP, unsigned int ORBIT, unsigned int ADJ>
-	void updateQuickAdjacentTraversal();
+	void updateQuickAdjacentTraversal(unsigned int nbth = Parallel::NumberOfThreads);
 
-	template <unsigned int ORBIT, unsigned int INCI>
-	const AttributeMultiVector<NoTypeNameAttribute<std::vector<Dart> > >* getQuickAdjacentTraversal() const;
+	template <unsigned int ORBIT, unsigned int ADJ>
+	const QuickLocalTraversal* getQuickAdjacentTraversal() const;
 
 	template <unsigned int ORBIT, unsigned int ADJ>
 	void disableQuickAdjacentTraversal();
+
+protected:
+	/**
+	 * fill table with the lists of the cells of orbit orbY incident (adjacent) to each cell of ORBIT
+	 */
+	template <typename MAP, unsigned int ORBIT>
+	void buildQuickLocalTraversal(QuickLocalTraversal& table, unsigned int orbY, bool adjacent, unsigned int nbth);
 };
 
 } //namespace CGoGN
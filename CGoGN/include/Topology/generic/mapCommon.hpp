@@ -91,6 +91,9 @@ void MapCommon<MAP_IMPL>::setDartEmbedding(Dart d, unsigned int emb)
 		this->m_attribs[ORBIT].refLine(emb);	// ref the new emb
 
 	(*this->m_embeddings[ORBIT])[this->dartIndex(d)] = emb ; // finally affect the embedding to the dart
+
+	if (this->m_quickTraversal[ORBIT] != NULL)
+		updateQuickTraversalDart<ORBIT>(d, old, emb);
 }
 
 	template <typename MAP_IMPL>
@@ -99,6 +102,7 @@ void MapCommon<MAP_IMPL>::setDartEmbedding(Dart d, unsigned int emb)
 	{
 		assert(this->template isOrbitEmbedded<ORBIT>() || !"Invalid parameter: orbit not embedded");
 		(*this->m_embeddings[ORBIT])[this->dartIndex(d)] = emb ; // affect the embedding to the dart
+		this->m_quickTraversalUpToDate[ORBIT] = false;
 	}
 
 template <typename MAP_IMPL>
@@ -111,6 +115,9 @@ void MapCommon<MAP_IMPL>::initDartEmbedding(Dart d, unsigned int emb)
 	if(emb != EMBNULL)
 		this->m_attribs[ORBIT].refLine(emb);	// ref the new emb
 	(*this->m_embeddings[ORBIT])[this->dartIndex(d)] = emb ; // affect the embedding to the dart
+
+	if (this->m_quickTraversal[ORBIT] != NULL)
+		updateQuickTraversalDart<ORBIT>(d, EMBNULL, emb);
 }
 
 template <typename MAP_IMPL>
@@ -313,6 +320,26 @@ inline void MapCommon<MAP_IMPL>::updateQuickTraversal()
 	foreach_cell<ORBIT>(static_cast<MAP&>(*this), [&] (Cell<ORBIT> c) {
 		(*this->m_quickTraversal[ORBIT])[getEmbedding(c)] = c.dart ;
 	}, FORCE_CELL_MARKING);
+	this->m_quickTraversalUpToDate[ORBIT] = true;
+}
+
+template <typename MAP_IMPL>
+template <unsigned int ORBIT>
+inline void MapCommon<MAP_IMPL>::updateQuickTraversalDart(Dart d, unsigned int oldEmb, unsigned int newEmb)
+{
+	// the table of the left cell loses its dart: a full update is needed
+	if (oldEmb != EMBNULL && this->m_attribs[ORBIT].used(oldEmb) && (*this->m_quickTraversal[ORBIT])[oldEmb] == d)
+		this->m_quickTraversalUpToDate[ORBIT] = false;
+
+	if (newEmb != EMBNULL && !isBoundaryMarked(this->dimension(), d))
+		(*this->m_quickTraversal[ORBIT])[newEmb] = d;
+}
+
+template <typename MAP_IMPL>
+template <unsigned int ORBIT>
+inline bool MapCommon<MAP_IMPL>::isQuickTraversalUpToDate() const
+{
+	return this->m_quickTraversalUpToDate[ORBIT];
 }
 
 template <typename MAP_IMPL>
@@ -333,9 +360,71 @@ inline void MapCommon<MAP_IMPL>::disableQuickTraversal()
 	}
 }
 
+template <typename MAP_IMPL>
+template <typename MAP, unsigned int ORBIT>
+void MapCommon<MAP_IMPL>::buildQuickLocalTraversal(QuickLocalTraversal& table, unsigned int orbY, bool adjacent, unsigned int nbth)
+{
+	MAP& map = static_cast<MAP&>(*this) ;
+	AttributeMultiVector<unsigned int>& begins = *table.getBegins() ;
+	std::vector<Dart>& darts = table.getDarts() ;
+	unsigned int dim = this->dimension() ;
+
+	// append the NIL terminated list of the cells of c to buffer
+	auto appendList = [&] (Cell<ORBIT> c, std::vector<Dart>& buffer)
+	{
+		assert(getEmbedding(c) != EMBNULL || !"quick local traversal of a not embedded cell") ;
+		Traversor* tra_loc = adjacent ?
+			TraversorFactory<MAP>::createAdjacent(map, c.dart, dim, ORBIT, orbY) :
+			TraversorFactory<MAP>::createIncident(map, c.dart, dim, ORBIT, orbY) ;
+		for (Dart e = tra_loc->begin(); e != tra_loc->end(); e = tra_loc->next())
+			buffer.push_back(e) ;
+		delete tra_loc ;
+		buffer.push_back(NIL) ;
+	} ;
+
+	darts.resize(1) ;
+
+	if (nbth < 2)
+	{
+		foreach_cell<ORBIT>(map, [&] (Cell<ORBIT> c)
+		{
+			begins[getEmbedding(c)] = (unsigned int)(darts.size()) ;
+			appendList(c, darts) ;
+		}) ;
+		return ;
+	}
+
+	// each task packs the lists of its cells in its own buffer ...
+	nbth = Parallel::checkNbThreads(nbth) ;
+	unsigned int nbTasks = (nbth - 1) * Parallel::NB_TASKS_PER_THREAD ;
+	std::vector< std::vector<Dart> > taskDarts(nbTasks) ;
+	std::vector< std::vector< std::pair<unsigned int, unsigned int> > > taskCells(nbTasks) ;
+
+	Parallel::foreach_cell_tasks<ORBIT>(map, [&] (Cell<ORBIT> c, unsigned int, unsigned int task)
+	{
+		taskCells[task].push_back(std::make_pair(getEmbedding(c), (unsigned int)(taskDarts[task].size()))) ;
+		appendList(c, taskDarts[task]) ;
+	}, AUTO, nbth - 1) ;
+
+	// ... then the buffers are copied at their offset in the packed table
+	std::vector<unsigned int> taskOffsets(nbTasks + 1) ;
+	taskOffsets[0] = 1 ;
+	for (unsigned int t = 0; t < nbTasks; ++t)
+		taskOffsets[t + 1] = taskOffsets[t] + (unsigned int)(taskDarts[t].size()) ;
+	darts.resize(taskOffsets[nbTasks]) ;
+
+	Parallel::getThreadPool(nbth - 1).exec(nbTasks, [&] (unsigned int task, unsigned int)
+	{
+		std::copy(taskDarts[task].begin(), taskDarts[task].end(), darts.begin() + taskOffsets[task]) ;
+		for (std::vector< std::pair<unsigned int, unsigned int> >::const_iterator it = taskCells[task].begin(); it != taskCells[task].end(); ++it)
+			begins[it->first] = taskOffsets[task] + it->second ;
+		std::vector<Dart>().swap(taskDarts[task]) ;
+	}, nbth - 1) ;
+}
+
 template <typename MAP_IMPL>
 template <typename MAP, unsigned int ORBIT, unsigned int INCI>
-inline void MapCommon<MAP_IMPL>::enableQuickIncidentTraversal()
+inline void MapCommon<MAP_IMPL>::enableQuickIncidentTraversal(unsigned int nbth)
 {
 	if(this->m_quickLocalIncidentTraversal[ORBIT][INCI] == NULL)
 	{
@@ -343,43 +432,27 @@ inline void MapCommon<MAP_IMPL>::enableQuickIncidentTraversal()
 			this->template addEmbedding<ORBIT>() ;
 		std::stringstream ss;
 		ss << "quickIncidentTraversal_" << INCI;
-		this->m_quickLocalIncidentTraversal[ORBIT][INCI] = this->m_attribs[ORBIT].template addAttribute<NoTypeNameAttribute<std::vector<Dart> > >(ss.str()) ;
+		this->m_quickLocalIncidentTraversal[ORBIT][INCI] = new QuickLocalTraversal(this->m_attribs[ORBIT].template addAttribute<unsigned int>(ss.str())) ;
 	}
-	updateQuickIncidentTraversal<MAP, ORBIT, INCI>() ;
+	updateQuickIncidentTraversal<MAP, ORBIT, INCI>(nbth) ;
 }
 
 template <typename MAP_IMPL>
 template <typename MAP, unsigned int ORBIT, unsigned int INCI>
-inline void MapCommon<MAP_IMPL>::updateQuickIncidentTraversal()
+inline void MapCommon<MAP_IMPL>::updateQuickIncidentTraversal(unsigned int nbth)
 {
 	assert(this->m_quickLocalIncidentTraversal[ORBIT][INCI] != NULL || !"updateQuickTraversal on a disabled orbit") ;
 
-	AttributeMultiVector<NoTypeNameAttribute<std::vector<Dart> > >* ptrVD = this->m_quickLocalIncidentTraversal[ORBIT][INCI];
+	// the traversors used to fill the table must not read it
+	QuickLocalTraversal* table = this->m_quickLocalIncidentTraversal[ORBIT][INCI];
 	this->m_quickLocalIncidentTraversal[ORBIT][INCI] = NULL;
-
-	std::vector<Dart> buffer;
-	buffer.reserve(100);
-
-	TraversorCell<MAP, ORBIT> tra_glob(*this);
-	for (Dart d = tra_glob.begin(); d != tra_glob.end(); d = tra_glob.next())
-	{
-		buffer.clear();
-		Traversor* tra_loc = TraversorFactory<MAP>::createIncident(*this, d, this->dimension(), ORBIT, INCI);
-		for (Dart e = tra_loc->begin(); e != tra_loc->end(); e = tra_loc->next())
-			buffer.push_back(e);
-		delete tra_loc;
-		buffer.push_back(NIL);
-		std::vector<Dart>& vd = (*ptrVD)[getEmbedding<ORBIT>(d)];
-		vd.reserve(buffer.size());
-		vd.assign(buffer.begin(), buffer.end());
-	}
-
-	this->m_quickLocalIncidentTraversal[ORBIT][INCI] = ptrVD;
+	buildQuickLocalTraversal<MAP, ORBIT>(*table, INCI, false, nbth) ;
+	this->m_quickLocalIncidentTraversal[ORBIT][INCI] = table;
 }
 
 template <typename MAP_IMPL>
 template <unsigned int ORBIT, unsigned int INCI>
-inline const AttributeMultiVector<NoTypeNameAttribute<std::vector<Dart> > >* MapCommon<MAP_IMPL>::getQuickIncidentTraversal() const
+inline const QuickLocalTraversal* MapCommon<MAP_IMPL>::getQuickIncidentTraversal() const
 {
 	return this->m_quickLocalIncidentTraversal[ORBIT][INCI] ;
 }
@@ -390,58 +463,42 @@ inline void MapCommon<MAP_IMPL>::disableQuickIncidentTraversal()
 {
 	if(this->m_quickLocalIncidentTraversal[ORBIT][INCI] != NULL)
 	{
-		this->m_attribs[ORBIT].template removeAttribute<Dart>(this->m_quickLocalIncidentTraversal[ORBIT][INCI]->getIndex()) ;
+		this->m_attribs[ORBIT].template removeAttribute<unsigned int>(this->m_quickLocalIncidentTraversal[ORBIT][INCI]->getBegins()->getIndex()) ;
+		delete this->m_quickLocalIncidentTraversal[ORBIT][INCI] ;
 		this->m_quickLocalIncidentTraversal[ORBIT][INCI] = NULL ;
 	}
 }
 
 template <typename MAP_IMPL>
 template <typename MAP, unsigned int ORBIT, unsigned int ADJ>
-inline void MapCommon<MAP_IMPL>::enableQuickAdjacentTraversal()
+inline void MapCommon<MAP_IMPL>::enableQuickAdjacentTraversal(unsigned int nbth)
 {
 	if(this->m_quickLocalAdjacentTraversal[ORBIT][ADJ] == NULL)
 	{
 		if(!this->template isOrbitEmbedded<ORBIT>())
 			this->template addEmbedding<ORBIT>() ;
 		std::stringstream ss;
-		ss << "quickAdjacentTraversal" << ADJ;
-		this->m_quickLocalAdjacentTraversal[ORBIT][ADJ] = this->m_attribs[ORBIT].template addAttribute<NoTypeNameAttribute<std::vector<Dart> > >(ss.str()) ;
+		ss << "quickAdjacentTraversal_" << ADJ;
+		this->m_quickLocalAdjacentTraversal[ORBIT][ADJ] = new QuickLocalTraversal(this->m_attribs[ORBIT].template addAttribute<unsigned int>(ss.str())) ;
 	}
-	updateQuickAdjacentTraversal<MAP, ORBIT, ADJ>() ;
+	updateQuickAdjacentTraversal<MAP, ORBIT, ADJ>(nbth) ;
 }
 
 template <typename MAP_IMPL>
 template <typename MAP, unsigned int ORBIT, unsigned int ADJ>
-inline void MapCommon<MAP_IMPL>::updateQuickAdjacentTraversal()
+inline void MapCommon<MAP_IMPL>::updateQuickAdjacentTraversal(unsigned int nbth)
 {
 	assert(this->m_quickLocalAdjacentTraversal[ORBIT][ADJ] != NULL || !"updateQuickTraversal on a disabled orbit") ;
 
-	AttributeMultiVector<NoTypeNameAttribute<std::vector<Dart> > >* ptrVD = this->m_quickLocalAdjacentTraversal[ORBIT][ADJ];
+	QuickLocalTraversal* table = this->m_quickLocalAdjacentTraversal[ORBIT][ADJ];
 	this->m_quickLocalAdjacentTraversal[ORBIT][ADJ] = NULL;
-
-	std::vector<Dart> buffer;
-	buffer.reserve(100);
-
-	TraversorCell<MAP, ORBIT> tra_glob(*this);
-	for (Dart d = tra_glob.begin(); d != tra_glob.end(); d = tra_glob.next())
-	{
-		buffer.clear();
-		Traversor* tra_loc = TraversorFactory<MAP>::createAdjacent(*this, d, this->dimension(), ORBIT, ADJ);
-		for (Dart e = tra_loc->begin(); e != tra_loc->end(); e = tra_loc->next())
-			buffer.push_back(e);
-		buffer.push_back(NIL);
-		delete tra_loc;
-		std::vector<Dart>& vd = (*ptrVD)[getEmbedding<ORBIT>(d)];
-		vd.reserve(buffer.size());
-		vd.assign(buffer.begin(),buffer.end());
-	}
-
-	this->m_quickLocalAdjacentTraversal[ORBIT][ADJ] = ptrVD;
+	buildQuickLocalTraversal<MAP, ORBIT>(*table, ADJ, true, nbth) ;
+	this->m_quickLocalAdjacentTraversal[ORBIT][ADJ] = table;
 }
 
 template <typename MAP_IMPL>
 template <unsigned int ORBIT, unsigned int ADJ>
-inline const AttributeMultiVector<NoTypeNameAttribute<std::vector<Dart> > >* MapCommon<MAP_IMPL>::getQuickAdjacentTraversal() const
+inline const QuickLocalTraversal* MapCommon<MAP_IMPL>::getQuickAdjacentTraversal() const
 {
 	return this->m_quickLocalAdjacentTraversal[ORBIT][ADJ] ;
 }
@@ -452,7 +509,8 @@ inline void MapCommon<MAP_IMPL>::disableQuickAdjacentTraversal()
 {
 	if(this->m_quickLocalAdjacentTraversal[ORBIT][ADJ] != NULL)
 	{
-		this->m_attribs[ORBIT].template removeAttribute<Dart>(this->m_quickLocalAdjacentTraversal[ORBIT][ADJ]->getIndex()) ;
+		this->m_attribs[ORBIT].template removeAttribute<unsigned int>(this->m_quickLocalAdjacentTraversal[ORBIT][ADJ]->getBegins()->getIndex()) ;
+		delete this->m_quickLocalAdjacentTraversal[ORBIT][ADJ] ;
 		this->m_quickLocalAdjacentTraversal[ORBIT][ADJ] = NULL ;
 	}
 }
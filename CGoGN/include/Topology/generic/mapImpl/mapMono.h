@@ -106,6 +106,19 @@ protected:
 	template <int I>
 	inline void permutationUnsew(Dart d);
 
+	/**
+	 * exchange permutation I and its inverse
+	 */
+	template <int I>
+	inline void reversePermutation();
+
+	/**
+	 * replace permutation I and its inverse by the content of phi and phi_inv
+	 * (the content of phi and phi_inv is undefined afterwards)
+	 */
+	template <int I>
+	inline void replacePermutation(AttributeMultiVector<Dart>* phi, AttributeMultiVector<Dart>* phi_inv);
+
 	virtual void compactTopo();
 
 	/****************************************
@@ -145,7 +158,7 @@ public:
 	 *             SAVE & LOAD              *
 	 ****************************************/
 
-	bool saveMapBin(const std::string& filename) const;
+	bool saveMapBin(const std::string& filename, Utils::BinaryFormat format = Utils::BIN_GZIP) const;
 
 	bool loadMapBin(const std::string& filename);
 
@@ -186,6 +186,19 @@ inline void MapMono::permutationUnsew(Dart d)
 	(*m_permutation_inv[I])[e.index] = e ;
 }
 
+template <int I>
+inline void MapMono::reversePermutation()
+{
+	m_permutation[I]->swap(m_permutation_inv[I]) ;
+}
+
+template <int I>
+inline void MapMono::replacePermutation(AttributeMultiVector<Dart>* phi, AttributeMultiVector<Dart>* phi_inv)
+{
+	m_permutation[I]->swap(phi) ;
+	m_permutation_inv[I]->swap(phi_inv) ;
+}
+
 
 /****************************************
  *           DARTS TRAVERSALS           *
@@ -0,0 +1,221 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#ifndef __MAP_MONO_AOS__
+#define __MAP_MONO_AOS__
+
+#include "Topology/generic/genericmap.h"
+
+#include <sstream>
+
+namespace CGoGN
+{
+
+/**
+ * relations of a dart, stored side by side (one element of the "relations" dart attribute)
+ * - NB_INV: max number of involutions
+ * - NB_PERM: max number of permutations (and of inverse permutations)
+ */
+template <unsigned int NB_INV, unsigned int NB_PERM>
+struct DartRelations
+{
+	Dart involution[NB_INV > 0 ? NB_INV : 1];
+	Dart permutation[NB_PERM > 0 ? NB_PERM : 1];
+	Dart permutation_inv[NB_PERM > 0 ? NB_PERM : 1];
+
+	static std::string CGoGNnameOfType();
+
+	friend std::ostream& operator<<(std::ostream& out, const DartRelations& r)
+	{
+		for (unsigned int i = 0; i < NB_INV; ++i)
+			out << r.involution[i] << " ";
+		for (unsigned int i = 0; i < NB_PERM; ++i)
+			out << r.permutation[i] << " " << r.permutation_inv[i] << " ";
+		return out;
+	}
+};
+
+/**
+ * Mono-resolution map implementation with interleaved topology storage:
+ * all the relations (phi1, phi_1, phi2, phi3...) of a dart are stored in
+ * one element of a single dart attribute, so that a dart walk reads one
+ * cache line where MapMono reads one line per relation.
+ * Same interface as MapMono: Map2< MapMonoAoS<> >, Map3< MapMonoAoS<> >.
+ * The default capacity (2 involutions, 1 permutation) fits Map1, Map2 and Map3
+ * (16 bytes per dart) and lets Map3::moveFrom take a Map2 of the same type.
+ * Embeddings are still stored in separate dart attributes (GenericMap).
+ */
+template <unsigned int NB_INV = 2, unsigned int NB_PERM = 1>
+class MapMonoAoS : public GenericMap
+{
+	template<typename MAP> friend class DartMarkerTmpl ;
+	template<typename MAP> friend class DartMarkerStore ;
+
+public:
+	typedef DartRelations<NB_INV, NB_PERM> Relations;
+
+	MapMonoAoS();
+
+	inline virtual void clear(bool removeAttrib);
+
+protected:
+	// protected copy constructor to prevent the copy of map
+	MapMonoAoS(const MapMonoAoS& m): GenericMap(m), m_relations(NULL), m_nbInvolutions(0), m_nbPermutations(0) {}
+
+	AttributeMultiVector<Relations>* m_relations;
+
+	unsigned int m_nbInvolutions;
+	unsigned int m_nbPermutations;
+
+	/****************************************
+	 *          DARTS MANAGEMENT            *
+	 ****************************************/
+
+	inline Dart newDart();
+
+	inline virtual void deleteDart(Dart d);
+
+public:
+	inline unsigned int dartIndex(Dart d) const;
+
+	inline Dart indexDart(unsigned int index) const;
+
+	inline unsigned int getNbDarts() const;
+
+	inline AttributeContainer& getDartContainer();
+
+	/****************************************
+	 *        RELATIONS MANAGEMENT          *
+	 ****************************************/
+
+protected:
+	/**
+	 * get (or create) the relations attribute of the dart container
+	 */
+	inline void getRelationsAttribute();
+
+	inline void addInvolution();
+	inline void addPermutation();
+	inline void removeLastInvolutionPtr(); // for moveFrom
+
+	virtual unsigned int getNbInvolutions() const = 0;
+	virtual unsigned int getNbPermutations() const = 0;
+
+	template <int I>
+	inline Dart getInvolution(Dart d) const;
+
+	template <int I>
+	inline Dart getPermutation(Dart d) const;
+
+	template <int I>
+	inline Dart getPermutationInv(Dart d) const;
+
+	template <int I>
+	inline void involutionSew(Dart d, Dart e);
+
+	template <int I>
+	inline void involutionUnsew(Dart d);
+
+	template <int I>
+	inline void permutationSew(Dart d, Dart e);
+
+	template <int I>
+	inline void permutationUnsew(Dart d);
+
+	/**
+	 * exchange permutation I and its inverse
+	 */
+	template <int I>
+	inline void reversePermutation();
+
+	/**
+	 * replace permutation I and its inverse by the content of phi and phi_inv
+	 * (the content of phi and phi_inv is undefined afterwards)
+	 */
+	template <int I>
+	inline void replacePermutation(AttributeMultiVector<Dart>* phi, AttributeMultiVector<Dart>* phi_inv);
+
+	virtual void compactTopo();
+
+	/****************************************
+	 *           DARTS TRAVERSALS           *
+	 ****************************************/
+public:
+	/**
+	 * Begin of map
+	 * @return the first dart of the map
+	 */
+	inline Dart begin() const;
+
+	/**
+	 * End of map
+	 * @return the end iterator (next of last) of the map
+	 */
+	inline Dart end() const;
+
+	/**
+	 * allow to go from a dart to the next
+	 * in the order of storage
+	 * @param d reference to the dart to be modified
+	 */
+	inline void next(Dart& d) const;
+
+	/**
+	 * Apply a functor on each dart of the map
+	 * @param f a callable taking a Dart parameter
+	 */
+	template <typename FUNC>
+	void foreach_dart(FUNC f) ;
+
+	template <typename FUNC>
+	void foreach_dart(FUNC& f) ;
+
+	/****************************************
+	 *             SAVE & LOAD              *
+	 ****************************************/
+
+	/**
+	 * type tag written in the files: the relations are not stored as in the files of MapMono
+	 */
+	std::string aosTypeName() const { return this->mapTypeName() + "_AoS"; }
+
+	bool saveMapBin(const std::string& filename, Utils::BinaryFormat format = Utils::BIN_GZIP) const;
+
+	/**
+	 * load a map saved by a MapMonoAoS or by a MapMono
+	 * (separated relations are interleaved by restore_topo_shortcuts)
+	 */
+	bool loadMapBin(const std::string& filename);
+
+	bool copyFrom(const GenericMap& map);
+
+	void restore_topo_shortcuts();
+} ;
+
+} //namespace CGoGN
+
+#include "Topology/generic/mapImpl/mapMonoAoS.hpp"
+
+#endif
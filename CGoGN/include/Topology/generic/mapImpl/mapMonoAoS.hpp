@@ -0,0 +1,509 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+namespace CGoGN
+{
+
+template <unsigned int NB_INV, unsigned int NB_PERM>
+std::string DartRelations<NB_INV, NB_PERM>::CGoGNnameOfType()
+{
+	std::stringstream ss;
+	ss << "DartRelations<" << NB_INV << "," << NB_PERM << ">";
+	return ss.str();
+}
+
+template <unsigned int NB_INV, unsigned int NB_PERM>
+MapMonoAoS<NB_INV, NB_PERM>::MapMonoAoS() :
+	m_relations(NULL),
+	m_nbInvolutions(0),
+	m_nbPermutations(0)
+{
+	std::string nameType = Relations::CGoGNnameOfType();
+	if (m_attributes_registry_map->find(nameType) == m_attributes_registry_map->end())
+		registerAttribute<Relations>(nameType);
+}
+
+template <unsigned int NB_INV, unsigned int NB_PERM>
+inline void MapMonoAoS<NB_INV, NB_PERM>::clear(bool removeAttrib)
+{
+	GenericMap::clear(removeAttrib) ;
+	if (removeAttrib)
+	{
+		m_relations = NULL;
+		m_nbInvolutions = 0;
+		m_nbPermutations = 0;
+	}
+}
+
+/****************************************
+ *          DARTS MANAGEMENT            *
+ ****************************************/
+
+template <unsigned int NB_INV, unsigned int NB_PERM>
+inline Dart MapMonoAoS<NB_INV, NB_PERM>::newDart()
+{
+	Dart d = GenericMap::newDart() ;
+
+	Relations& r = (*m_relations)[d.index] ;
+	for (unsigned int i = 0; i < NB_INV; ++i)
+		r.involution[i] = d ;
+	for (unsigned int i = 0; i < NB_PERM; ++i)
+	{
+		r.permutation[i] = d ;
+		r.permutation_inv[i] = d ;
+	}
+
+	return d ;
+}
+
+template <unsigned int NB_INV, unsigned int NB_PERM>
+inline void MapMonoAoS<NB_INV, NB_PERM>::deleteDart(Dart d)
+{
+	deleteDartLine(d.index) ;
+}
+
+template <unsigned int NB_INV, unsigned int NB_PERM>
+inline unsigned int MapMonoAoS<NB_INV, NB_PERM>::dartIndex(Dart d) const
+{
+	return d.index;
+}
+
+template <unsigned int NB_INV, unsigned int NB_PERM>
+inline Dart MapMonoAoS<NB_INV, NB_PERM>::indexDart(unsigned int index) const
+{
+	return Dart(index);
+}
+
+template <unsigned int NB_INV, unsigned int NB_PERM>
+inline unsigned int MapMonoAoS<NB_INV, NB_PERM>::getNbDarts() const
+{
+	return m_attribs[DART].size() ;
+}
+
+template <unsigned int NB_INV, unsigned int NB_PERM>
+inline AttributeContainer& MapMonoAoS<NB_INV, NB_PERM>::getDartContainer()
+{
+	return m_attribs[DART];
+}
+
+/****************************************
+ *        RELATIONS MANAGEMENT          *
+ ****************************************/
+
+template <unsigned int NB_INV, unsigned int NB_PERM>
+inline void MapMonoAoS<NB_INV, NB_PERM>::getRelationsAttribute()
+{
+	AttributeContainer& cont = m_attribs[DART] ;
+	unsigned int index = cont.getAttributeIndex("relations") ;
+	if (index != AttributeContainer::UNKNOWN)
+		m_relations = cont.getDataVector<Relations>(index) ;
+	else
+		m_relations = cont.addAttribute<Relations>("relations") ;
+}
+
+template <unsigned int NB_INV, unsigned int NB_PERM>
+inline void MapMonoAoS<NB_INV, NB_PERM>::addInvolution()
+{
+	assert(m_nbInvolutions < NB_INV || !"MapMonoAoS: no room for another involution");
+
+	// the container may have been swapped (moveFrom)
+	getRelationsAttribute() ;
+
+	// set new relation to fix point for all the darts of the map
+	AttributeContainer& cont = m_attribs[DART] ;
+	for (unsigned int i = cont.begin(); i < cont.end(); cont.next(i))
+		(*m_relations)[i].involution[m_nbInvolutions] = Dart(i) ;
+	++m_nbInvolutions ;
+}
+
+template <unsigned int NB_INV, unsigned int NB_PERM>
+inline void MapMonoAoS<NB_INV, NB_PERM>::removeLastInvolutionPtr()
+{
+	--m_nbInvolutions ;
+}
+
+template <unsigned int NB_INV, unsigned int NB_PERM>
+inline void MapMonoAoS<NB_INV, NB_PERM>::addPermutation()
+{
+	assert(m_nbPermutations < NB_PERM || !"MapMonoAoS: no room for another permutation");
+
+	getRelationsAttribute() ;
+
+	AttributeContainer& cont = m_attribs[DART] ;
+	for (unsigned int i = cont.begin(); i < cont.end(); cont.next(i))
+	{
+		(*m_relations)[i].permutation[m_nbPermutations] = Dart(i) ;
+		(*m_relations)[i].permutation_inv[m_nbPermutations] = Dart(i) ;
+	}
+	++m_nbPermutations ;
+}
+
+template <unsigned int NB_INV, unsigned int NB_PERM>
+template <int I>
+inline Dart MapMonoAoS<NB_INV, NB_PERM>::getInvolution(Dart d) const
+{
+	return (*m_relations)[d.index].involution[I];
+}
+
+template <unsigned int NB_INV, unsigned int NB_PERM>
+template <int I>
+inline Dart MapMonoAoS<NB_INV, NB_PERM>::getPermutation(Dart d) const
+{
+	return (*m_relations)[d.index].permutation[I];
+}
+
+template <unsigned int NB_INV, unsigned int NB_PERM>
+template <int I>
+inline Dart MapMonoAoS<NB_INV, NB_PERM>::getPermutationInv(Dart d) const
+{
+	return (*m_relations)[d.index].permutation_inv[I];
+}
+
+template <unsigned int NB_INV, unsigned int NB_PERM>
+template <int I>
+inline void MapMonoAoS<NB_INV, NB_PERM>::involutionSew(Dart d, Dart e)
+{
+	Relations& rd = (*m_relations)[d.index] ;
+	Relations& re = (*m_relations)[e.index] ;
+	assert(rd.involution[I] == d) ;
+	assert(re.involution[I] == e) ;
+	rd.involution[I] = e ;
+	re.involution[I] = d ;
+}
+
+template <unsigned int NB_INV, unsigned int NB_PERM>
+template <int I>
+inline void MapMonoAoS<NB_INV, NB_PERM>::involutionUnsew(Dart d)
+{
+	Dart e = (*m_relations)[d.index].involution[I] ;
+	(*m_relations)[d.index].involution[I] = d ;
+	(*m_relations)[e.index].involution[I] = e ;
+}
+
+template <unsigned int NB_INV, unsigned int NB_PERM>
+template <int I>
+inline void MapMonoAoS<NB_INV, NB_PERM>::permutationSew(Dart d, Dart e)
+{
+	Dart f = (*m_relations)[d.index].permutation[I] ;
+	Dart g = (*m_relations)[e.index].permutation[I] ;
+	(*m_relations)[d.index].permutation[I] = g ;
+	(*m_relations)[e.index].permutation[I] = f ;
+	(*m_relations)[g.index].permutation_inv[I] = d ;
+	(*m_relations)[f.index].permutation_inv[I] = e ;
+}
+
+template <unsigned int NB_INV, unsigned int NB_PERM>
+template <int I>
+inline void MapMonoAoS<NB_INV, NB_PERM>::permutationUnsew(Dart d)
+{
+	Dart e = (*m_relations)[d.index].permutation[I] ;
+	Dart f = (*m_relations)[e.index].permutation[I] ;
+	(*m_relations)[d.index].permutation[I] = f ;
+	(*m_relations)[e.index].permutation[I] = e ;
+	(*m_relations)[f.index].permutation_inv[I] = d ;
+	(*m_relations)[e.index].permutation_inv[I] = e ;
+}
+
+template <unsigned int NB_INV, unsigned int NB_PERM>
+template <int I>
+inline void MapMonoAoS<NB_INV, NB_PERM>::reversePermutation()
+{
+	AttributeContainer& cont = m_attribs[DART] ;
+	for (unsigned int i = cont.begin(); i < cont.end(); cont.next(i))
+	{
+		Relations& r = (*m_relations)[i] ;
+		std::swap(r.permutation[I], r.permutation_inv[I]) ;
+	}
+}
+
+template <unsigned int NB_INV, unsigned int NB_PERM>
+template <int I>
+inline void MapMonoAoS<NB_INV, NB_PERM>::replacePermutation(AttributeMultiVector<Dart>* phi, AttributeMultiVector<Dart>* phi_inv)
+{
+	AttributeContainer& cont = m_attribs[DART] ;
+	for (unsigned int i = cont.begin(); i < cont.end(); cont.next(i))
+	{
+		Relations& r = (*m_relations)[i] ;
+		r.permutation[I] = (*phi)[i] ;
+		r.permutation_inv[I] = (*phi_inv)[i] ;
+	}
+}
+
+template <unsigned int NB_INV, unsigned int NB_PERM>
+void MapMonoAoS<NB_INV, NB_PERM>::compactTopo()
+{
+	if (fragmentation(DART) == 1.0)
+		return;
+
+	std::vector<unsigned int> oldnew;
+	m_attribs[DART].compact(oldnew);
+
+	for (unsigned int i = m_attribs[DART].begin(); i != m_attribs[DART].end(); m_attribs[DART].next(i))
+	{
+		Relations& r = (*m_relations)[i] ;
+		for (unsigned int j = 0; j < m_nbPermutations; ++j)
+		{
+			Dart d = r.permutation[j];
+			if (oldnew[d.index] != AttributeContainer::UNKNOWN)
+				r.permutation[j] = Dart(oldnew[d.index]);
+			d = r.permutation_inv[j];
+			if (oldnew[d.index] != AttributeContainer::UNKNOWN)
+				r.permutation_inv[j] = Dart(oldnew[d.index]);
+		}
+		for (unsigned int j = 0; j < m_nbInvolutions; ++j)
+		{
+			Dart d = r.involution[j];
+			if (oldnew[d.index] != AttributeContainer::UNKNOWN)
+				r.involution[j] = Dart(oldnew[d.index]);
+		}
+	}
+}
+
+/****************************************
+ *           DARTS TRAVERSALS           *
+ ****************************************/
+
+template <unsigned int NB_INV, unsigned int NB_PERM>
+inline Dart MapMonoAoS<NB_INV, NB_PERM>::begin() const
+{
+	return Dart::create(m_attribs[DART].begin()) ;
+}
+
+template <unsigned int NB_INV, unsigned int NB_PERM>
+inline Dart MapMonoAoS<NB_INV, NB_PERM>::end() const
+{
+	return Dart::create(m_attribs[DART].end()) ;
+}
+
+template <unsigned int NB_INV, unsigned int NB_PERM>
+inline void MapMonoAoS<NB_INV, NB_PERM>::next(Dart& d) const
+{
+	m_attribs[DART].next(d.index) ;
+}
+
+template <unsigned int NB_INV, unsigned int NB_PERM>
+template <typename FUNC>
+inline void MapMonoAoS<NB_INV, NB_PERM>::foreach_dart(FUNC f)
+{
+	for (Dart d = begin(); d != end(); next(d))
+		f(d);
+}
+
+template <unsigned int NB_INV, unsigned int NB_PERM>
+template <typename FUNC>
+inline void MapMonoAoS<NB_INV, NB_PERM>::foreach_dart(FUNC& f)
+{
+	for (Dart d = begin(); d != end(); next(d))
+		f(d);
+}
+
+/****************************************
+ *             SAVE & LOAD              *
+ ****************************************/
+
+template <unsigned int NB_INV, unsigned int NB_PERM>
+bool MapMonoAoS<NB_INV, NB_PERM>::saveMapBin(const std::string& filename, Utils::BinaryFormat format) const
+{
+	// frames of compressed formats are compressed in parallel
+	unsigned int nbth = Parallel::NumberOfThreads;
+	Utils::ThreadPool* pool = (nbth > 1) ? &Parallel::getThreadPool(nbth - 1) : NULL;
+	CGoGNostream fs(filename.c_str(), std::ios::out|std::ios::binary, format, pool, nbth - 1);
+	if (!fs)
+	{
+		CGoGNerr << "Unable to open file for writing: " << filename << CGoGNendl;
+		return false;
+	}
+
+	// Entete
+	char* buff = new char[256];
+	for (int i = 0; i < 256; ++i)
+		buff[i] = char(255);
+
+	memcpy(buff, "CGoGN_Map", 10);
+
+	std::string mt = aosTypeName();
+	const char* mtc = mt.c_str();
+	memcpy(buff+32, mtc, mt.size()+1);
+	unsigned int *buffi = reinterpret_cast<unsigned int*>(buff + 64);
+	*buffi = NB_ORBITS;
+	buffi[1] = _MAPBIN_VERSION_;
+	buffi[2] = format;
+	fs.write(reinterpret_cast<const char*>(buff), 256);
+	delete[] buff;
+
+	// save all attribs
+	for (unsigned int i = 0; i < NB_ORBITS; ++i)
+		m_attribs[i].saveBin(fs, i);
+
+	return true;
+}
+
+template <unsigned int NB_INV, unsigned int NB_PERM>
+bool MapMonoAoS<NB_INV, NB_PERM>::loadMapBin(const std::string& filename)
+{
+	unsigned int nbth = Parallel::NumberOfThreads;
+	Utils::ThreadPool* pool = (nbth > 1) ? &Parallel::getThreadPool(nbth - 1) : NULL;
+	CGoGNistream fs(filename.c_str(), std::ios::in|std::ios::binary, pool, nbth - 1);
+	if (!fs)
+	{
+		CGoGNerr << "Unable to open file for loading" << CGoGNendl;
+		return false;
+	}
+
+	GenericMap::clear(true);
+
+	// read info
+	char* buff = new char[256];
+	fs.read(reinterpret_cast<char*>(buff), 256);
+
+	std::string buff_str(buff);
+	std::string fileType(buff + 32);
+	unsigned int nbo = *reinterpret_cast<unsigned int*>(buff + 64);
+	unsigned int version = *reinterpret_cast<unsigned int*>(buff + 68);
+	delete[] buff;
+
+	// Check file type
+	if (buff_str == "CGoGN_MRMap")
+	{
+		CGoGNerr<< "Wrong binary file format, file is a MR-Map"<< CGoGNendl;
+		return false;
+	}
+	if (buff_str != "CGoGN_Map")
+	{
+		CGoGNerr<< "Wrong binary file format"<< CGoGNendl;
+		return false;
+	}
+
+	// Check map type (files of MapMono are interleaved by restore_topo_shortcuts)
+	std::string localType = this->mapTypeName();
+	if (fileType != aosTypeName() && fileType != localType)
+	{
+		CGoGNerr << "Not possible to load "<< fileType << " into " << localType << " object" << CGoGNendl;
+		return false;
+	}
+
+	// Check max nb orbit
+	if (nbo != NB_ORBITS)
+	{
+		CGoGNerr << "Wrong max orbit number in file" << CGoGNendl;
+		return  false;
+	}
+
+	// Check version (no version in files of version 1)
+	if (version != 0xFFFFFFFF && version > _MAPBIN_VERSION_)
+	{
+		CGoGNerr << "Binary file of a newer version (" << version << ")" << CGoGNendl;
+		return false;
+	}
+
+	// load attrib container
+	for (unsigned int i = 0; i < NB_ORBITS; ++i)
+	{
+		unsigned int id = AttributeContainer::loadBinId(fs);
+		m_attribs[id].loadBin(fs);
+	}
+
+	// restore shortcuts
+	GenericMap::restore_shortcuts();
+	restore_topo_shortcuts();
+
+	return true;
+}
+
+template <unsigned int NB_INV, unsigned int NB_PERM>
+bool MapMonoAoS<NB_INV, NB_PERM>::copyFrom(const GenericMap& map)
+{
+	const MapMonoAoS* mapM = dynamic_cast<const MapMonoAoS*>(&map);
+	if (mapM == NULL || mapTypeName() != map.mapTypeName())
+	{
+		CGoGNerr << "try to copy from incompatible type map" << CGoGNendl;
+		return false;
+	}
+
+	// clear the map but do not insert boundary markers dart attribute
+	GenericMap::init(false);
+
+	// copy attrib containers
+	for (unsigned int i = 0; i < NB_ORBITS; ++i)
+		m_attribs[i].copyFrom(mapM->m_attribs[i]);
+
+	GenericMap::garbageMarkVectors();
+
+	// restore shortcuts
+	GenericMap::restore_shortcuts();
+	restore_topo_shortcuts();
+
+	return true;
+}
+
+template <unsigned int NB_INV, unsigned int NB_PERM>
+void MapMonoAoS<NB_INV, NB_PERM>::restore_topo_shortcuts()
+{
+	m_nbInvolutions = getNbInvolutions();
+	m_nbPermutations = getNbPermutations();
+
+	AttributeContainer& cont = m_attribs[DART];
+	bool interleaved = cont.getAttributeIndex("relations") != AttributeContainer::UNKNOWN;
+
+	getRelationsAttribute();
+	if (interleaved)
+		return;
+
+	// map stored by a MapMono: interleave the separated relations
+	std::vector<std::string> listeNames;
+	cont.getAttributesNames(listeNames);
+
+	for (unsigned int i = 0; i < listeNames.size(); ++i)
+	{
+		const std::string& name = listeNames[i];
+		std::string sub = name.substr(0, name.size() - 1);
+		unsigned int relNum = name[name.size() - 1] - '0';
+
+		unsigned int kind;
+		if (sub == "involution_" && relNum < NB_INV)
+			kind = 0;
+		else if (sub == "permutation_" && relNum < NB_PERM)
+			kind = 1;
+		else if (sub == "permutation_inv_" && relNum < NB_PERM)
+			kind = 2;
+		else
+			continue;
+
+		AttributeMultiVector<Dart>* rel = getRelation(name);
+		for (unsigned int j = cont.begin(); j < cont.end(); cont.next(j))
+		{
+			Relations& r = (*m_relations)[j];
+			switch (kind)
+			{
+				case 0: r.involution[relNum] = (*rel)[j]; break;
+				case 1: r.permutation[relNum] = (*rel)[j]; break;
+				default: r.permutation_inv[relNum] = (*rel)[j]; break;
+			}
+		}
+		cont.removeAttribute<Dart>(name);
+	}
+}
+
+} // namespace CGoGN
@@ -169,8 +169,35 @@ protected:
 	template <int I>
 	inline void permutationUnsew(Dart d);
 
+	/**
+	 * exchange permutation I and its inverse
+	 */
+	template <int I>
+	inline void reversePermutation();
+
+	/**
+	 * replace permutation I and its inverse by the content of phi and phi_inv
+	 * (the content of phi and phi_inv is undefined afterwards)
+	 */
+	template <int I>
+	inline void replacePermutation(AttributeMultiVector<Dart>* phi, AttributeMultiVector<Dart>* phi_inv);
+
 	virtual void compactTopo();
 
+public:
+	/**
+	 * change the allocator of the blocks of all the attributes of the map,
+	 * MR container included
+	 */
+	virtual void setBlockAllocator(std::shared_ptr<BlockAllocator> alloc);
+
+	/**
+	 * set the number of lines of the blocks of all the attribute containers,
+	 * MR container (dart indices of each level, insertion levels, markers) included
+	 * @return false if not possible (the map has darts)
+	 */
+	virtual bool setBlockSize(unsigned int nbLines);
+
 	/****************************************
 	 *      MR CONTAINER MANAGEMENT         *
 	 ****************************************/
@@ -299,7 +326,7 @@ public:
 	 *             SAVE & LOAD              *
 	 ****************************************/
 
-	bool saveMapBin(const std::string& filename) const;
+	bool saveMapBin(const std::string& filename, Utils::BinaryFormat format = Utils::BIN_GZIP) const;
 
 	bool loadMapBin(const std::string& filename);
 
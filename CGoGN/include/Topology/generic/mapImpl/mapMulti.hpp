@@ -297,6 +297,19 @@ inline void MapMulti::permutationUnsew(Dart d)
 	(*m_permutation_inv[I])[e_index] = e ;
 }
 
+template <int I>
+inline void MapMulti::reversePermutation()
+{
+	m_permutation[I]->swap(m_permutation_inv[I]) ;
+}
+
+template <int I>
+inline void MapMulti::replacePermutation(AttributeMultiVector<Dart>* phi, AttributeMultiVector<Dart>* phi_inv)
+{
+	m_permutation[I]->swap(phi) ;
+	m_permutation_inv[I]->swap(phi_inv) ;
+}
+
 /****************************************
  *      MR CONTAINER MANAGEMENT         *
  ****************************************/
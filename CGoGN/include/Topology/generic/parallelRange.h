@@ -0,0 +1,78 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#ifndef __PARALLEL_RANGE_H__
+#define __PARALLEL_RANGE_H__
+
+#include "Topology/generic/genericmap.h"
+
+#include <vector>
+
+namespace CGoGN
+{
+
+namespace Parallel
+{
+
+/**
+ * Parallel loops and sort over index ranges (no map involved).
+ * As for the reductions, nbth-1 workers of the pool are used (nbth < 2: sequential).
+ */
+
+/**
+ * @brief foreach_index apply func on each index of [0,nb[
+ * @param nb number of indices
+ * @param func func(unsigned int i, unsigned int task): the task (fixed contiguous range
+ * of indices, in [0, (nbth-1)*NB_TASKS_PER_THREAD[) can be used to index per task data
+ * @param nbth number of used threads
+ */
+template <typename FUNC>
+void foreach_index(unsigned int nb, FUNC func, unsigned int nbth = NumberOfThreads);
+
+/**
+ * @brief number of tasks used by foreach_index for nb indices
+ */
+inline unsigned int nbTasksOfRange(unsigned int nb, unsigned int nbth = NumberOfThreads);
+
+/**
+ * @brief sort a vector: parallel sort of chunks followed by parallel pairwise merges
+ * (same result as std::stable_sort)
+ * @param v the vector to sort
+ * @param comp strict weak ordering
+ * @param nbth number of used threads
+ */
+template <typename T, typename COMP>
+void sort(std::vector<T>& v, COMP comp, unsigned int nbth = NumberOfThreads);
+
+template <typename T>
+void sort(std::vector<T>& v, unsigned int nbth = NumberOfThreads);
+
+} // namespace Parallel
+
+} // namespace CGoGN
+
+#include "Topology/generic/parallelRange.hpp"
+
+#endif
@@ -0,0 +1,122 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#include "Utils/threadPool.h"
+
+#include <algorithm>
+#include <functional>
+
+namespace CGoGN
+{
+
+namespace Parallel
+{
+
+inline unsigned int nbTasksOfRange(unsigned int nb, unsigned int nbth)
+{
+	if (nbth < 2)
+		return std::min(nb, 1u);
+	return std::min(nb, (nbth - 1) * NB_TASKS_PER_THREAD);
+}
+
+template <typename FUNC>
+void foreach_index(unsigned int nb, FUNC func, unsigned int nbth)
+{
+	if (nbth < 2)
+	{
+		for (unsigned int i = 0; i < nb; ++i)
+			func(i, 0);
+		return;
+	}
+
+	unsigned int nbTasks = nbTasksOfRange(nb, nbth);
+	getThreadPool(nbth - 1).exec(nbTasks, [&] (unsigned int task, unsigned int)
+	{
+		unsigned int b = (unsigned int)((unsigned long long)(nb) * task / nbTasks);
+		unsigned int e = (unsigned int)((unsigned long long)(nb) * (task + 1) / nbTasks);
+		for (unsigned int i = b; i < e; ++i)
+			func(i, task);
+	}, nbth - 1);
+}
+
+template <typename T, typename COMP>
+void sort(std::vector<T>& v, COMP comp, unsigned int nbth)
+{
+	unsigned int nb = (unsigned int)(v.size());
+	unsigned int nbChunks = (nbth < 2) ? 1 : std::min(nb / 1024 + 1, nbth - 1);
+	if (nbChunks < 2)
+	{
+		std::stable_sort(v.begin(), v.end(), comp);
+		return;
+	}
+
+	// bounds of the sorted runs
+	std::vector<unsigned int> bounds(nbChunks + 1);
+	for (unsigned int i = 0; i <= nbChunks; ++i)
+		bounds[i] = (unsigned int)((unsigned long long)(nb) * i / nbChunks);
+
+	Utils::ThreadPool& pool = getThreadPool(nbth - 1);
+	pool.exec(nbChunks, [&] (unsigned int task, unsigned int)
+	{
+		std::stable_sort(v.begin() + bounds[task], v.begin() + bounds[task + 1], comp);
+	}, nbth - 1);
+
+	// merge the runs two by two, alternating between v and a buffer
+	std::vector<T> buffer(nb);
+	std::vector<T>* src = &v;
+	std::vector<T>* dst = &buffer;
+	while (bounds.size() > 2)
+	{
+		unsigned int nbRuns = (unsigned int)(bounds.size()) - 1;
+		unsigned int nbMerges = (nbRuns + 1) / 2;
+		pool.exec(nbMerges, [&] (unsigned int task, unsigned int)
+		{
+			unsigned int b = bounds[2 * task];
+			unsigned int m = bounds[std::min(2 * task + 1, nbRuns)];
+			unsigned int e = bounds[std::min(2 * task + 2, nbRuns)];
+			std::merge(src->begin() + b, src->begin() + m, src->begin() + m, src->begin() + e, dst->begin() + b, comp);
+		}, nbth - 1);
+
+		std::vector<unsigned int> newBounds;
+		for (unsigned int i = 0; i < nbRuns; i += 2)
+			newBounds.push_back(bounds[i]);
+		newBounds.push_back(nb);
+		bounds.swap(newBounds);
+		std::swap(src, dst);
+	}
+
+	if (src != &v)
+		v.swap(buffer);
+}
+
+template <typename T>
+void sort(std::vector<T>& v, unsigned int nbth)
+{
+	sort(v, std::less<T>(), nbth);
+}
+
+} // namespace Parallel
+
+} // namespace CGoGN
@@ -0,0 +1,70 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef __QUICK_LOCAL_TRAVERSAL_H__
+#define __QUICK_LOCAL_TRAVERSAL_H__
+
+#include "Container/attributeMultiVector.h"
+#include "Topology/generic/dart.h"
+
+#include <vector>
+
+namespace CGoGN
+{
+
+/**
+ * Table of the incident (or adjacent) cells of each cell of an orbit, packed in CSR form:
+ * the darts of all the lists are stored contiguously (each list ends with NIL) and an
+ * attribute of the orbit container gives the beginning of the list of each cell.
+ * The first entry of the darts is a NIL shared by the cells created after the last update
+ * (their begin is 0), which get an empty list.
+ */
+class QuickLocalTraversal
+{
+	AttributeMultiVector<unsigned int>* m_begins ;
+
+	std::vector<Dart> m_darts ;
+
+public:
+	QuickLocalTraversal(AttributeMultiVector<unsigned int>* begins) :
+		m_begins(begins),
+		m_darts(1, NIL)
+	{}
+
+	/// attribute (of the orbit container) of the beginnings of the lists
+	AttributeMultiVector<unsigned int>* getBegins() const { return m_begins ; }
+
+	/// darts of all the lists (the first one is the shared empty list)
+	std::vector<Dart>& getDarts() { return m_darts ; }
+
+	/// NIL terminated list of the darts of the incident / adjacent cells of cell emb
+	inline const Dart* operator[](unsigned int emb) const
+	{
+		return &m_darts[(*m_begins)[emb]] ;
+	}
+} ;
+
+} // namespace CGoGN
+
+#endif
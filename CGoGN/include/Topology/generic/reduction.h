@@ -0,0 +1,96 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#ifndef __PARALLEL_REDUCTION_H__
+#define __PARALLEL_REDUCTION_H__
+
+#include "Topology/generic/traversor/traversorCell.h"
+#include "Topology/generic/attributeHandler.h"
+
+namespace CGoGN
+{
+
+namespace Parallel
+{
+
+/**
+ * Parallel reductions
+ * Each task (fixed range of cells, lines or indices) accumulates in its own partial,
+ * partials are padded to avoid false sharing between threads and are combined
+ * in the order of the tasks: for a given number of threads the result does not
+ * depend on the scheduling (work stealing) of the tasks.
+ *  - map_fn(T& partial, element) accumulates the contribution of element in partial
+ *  - combine_fn(T& a, const T& b) accumulates b in a
+ * identity must be neutral for combine_fn.
+ */
+
+/// size used to separate the partials of the threads
+const unsigned int CACHE_LINE_SIZE = 64;
+
+/**
+ * @brief reduce_cell reduction over the cells of a map
+ * @param map
+ * @param identity initial value of each partial
+ * @param map_fn map_fn(T& partial, Cell<ORBIT> c)
+ * @param combine_fn combine_fn(T& a, const T& b)
+ * @param opt optimization param of traversal
+ * @param nbth number of used threads
+ * @return the reduced value
+ */
+template <unsigned int ORBIT, typename MAP, typename T, typename MAP_FN, typename COMBINE_FN>
+T reduce_cell(MAP& map, const T& identity, MAP_FN map_fn, COMBINE_FN combine_fn, TraversalOptim opt = AUTO, unsigned int nbth = NumberOfThreads);
+
+/**
+ * @brief reduce_attribute reduction over the values of an attribute
+ * (all the used lines of the container, browser is ignored)
+ * @param attr
+ * @param identity initial value of each partial
+ * @param map_fn map_fn(T& partial, const DATA_TYPE& value)
+ * @param combine_fn combine_fn(T& a, const T& b)
+ * @param nbth number of used threads
+ * @return the reduced value
+ */
+template <typename T, typename DATA, unsigned int ORBIT, typename MAP, typename MAP_FN, typename COMBINE_FN>
+T reduce_attribute(const AttributeHandler<DATA, ORBIT, MAP>& attr, const T& identity, MAP_FN map_fn, COMBINE_FN combine_fn, unsigned int nbth = NumberOfThreads);
+
+/**
+ * @brief reduce_range reduction over the indices [0,nb[
+ * @param nb number of indices
+ * @param identity initial value of each partial
+ * @param map_fn map_fn(T& partial, unsigned int i)
+ * @param combine_fn combine_fn(T& a, const T& b)
+ * @param nbth number of used threads
+ * @return the reduced value
+ */
+template <typename T, typename MAP_FN, typename COMBINE_FN>
+T reduce_range(unsigned int nb, const T& identity, MAP_FN map_fn, COMBINE_FN combine_fn, unsigned int nbth = NumberOfThreads);
+
+} // namespace Parallel
+
+} // namespace CGoGN
+
+#include "Topology/generic/reduction.hpp"
+
+#endif
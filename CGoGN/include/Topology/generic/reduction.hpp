@@ -0,0 +1,102 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+namespace CGoGN
+{
+
+namespace Parallel
+{
+
+/// partial result of one task, alone on its cache line(s)
+template <typename T>
+struct PaddedPartial
+{
+	T value;
+	char padding[CACHE_LINE_SIZE];
+
+	PaddedPartial(const T& v) : value(v), padding() {}
+};
+
+template <typename T, typename COMBINE_FN>
+T combinePartials(const T& identity, const std::vector< PaddedPartial<T> >& partials, COMBINE_FN& combine_fn)
+{
+	T result(identity);
+	for (typename std::vector< PaddedPartial<T> >::const_iterator it = partials.begin(); it != partials.end(); ++it)
+		combine_fn(result, it->value);
+	return result;
+}
+
+template <unsigned int ORBIT, typename MAP, typename T, typename MAP_FN, typename COMBINE_FN>
+T reduce_cell(MAP& map, const T& identity, MAP_FN map_fn, COMBINE_FN combine_fn, TraversalOptim opt, unsigned int nbth)
+{
+	nbth = checkNbThreads(nbth);
+	std::vector< PaddedPartial<T> > partials((nbth - 1) * NB_TASKS_PER_THREAD, PaddedPartial<T>(identity));
+
+	foreach_cell_tasks<ORBIT>(map, [&] (Cell<ORBIT> c, unsigned int, unsigned int task)
+	{
+		map_fn(partials[task].value, c);
+	}, opt, nbth - 1);
+
+	return combinePartials(identity, partials, combine_fn);
+}
+
+template <typename T, typename DATA, unsigned int ORBIT, typename MAP, typename MAP_FN, typename COMBINE_FN>
+T reduce_attribute(const AttributeHandler<DATA, ORBIT, MAP>& attr, const T& identity, MAP_FN map_fn, COMBINE_FN combine_fn, unsigned int nbth)
+{
+	nbth = checkNbThreads(nbth);
+	std::vector< PaddedPartial<T> > partials((nbth - 1) * NB_TASKS_PER_THREAD, PaddedPartial<T>(identity));
+
+	const AttributeContainer& cont = attr.map()->template getAttributeContainer<ORBIT>();
+	const AttributeMultiVector<DATA>* data = attr.getDataVector();
+	foreach_line_by_blocks(cont, [&] (unsigned int i, unsigned int, unsigned int task)
+	{
+		map_fn(partials[task].value, (*data)[i]);
+	}, getThreadPool(nbth - 1), nbth - 1);
+
+	return combinePartials(identity, partials, combine_fn);
+}
+
+template <typename T, typename MAP_FN, typename COMBINE_FN>
+T reduce_range(unsigned int nb, const T& identity, MAP_FN map_fn, COMBINE_FN combine_fn, unsigned int nbth)
+{
+	nbth = checkNbThreads(nbth);
+	unsigned int nbTasks = std::min(nb, (nbth - 1) * NB_TASKS_PER_THREAD);
+	std::vector< PaddedPartial<T> > partials(nbTasks, PaddedPartial<T>(identity));
+
+	getThreadPool(nbth - 1).exec(nbTasks, [&] (unsigned int task, unsigned int)
+	{
+		unsigned int b = (unsigned int)((unsigned long long)(nb) * task / nbTasks);
+		unsigned int e = (unsigned int)((unsigned long long)(nb) * (task + 1) / nbTasks);
+		T& partial = partials[task].value;
+		for (unsigned int i = b; i < e; ++i)
+			map_fn(partial, i);
+	}, nbth - 1);
+
+	return combinePartials(identity, partials, combine_fn);
+}
+
+} // namespace Parallel
+
+} // namespace CGoGN
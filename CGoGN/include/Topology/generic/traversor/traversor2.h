@@ -44,8 +44,8 @@ private:
 	const MAP& m ;
 	Edge start ;
 	Edge current ;
-	const std::vector<Dart>* m_QLT;
-	std::vector<Dart>::const_iterator m_ItDarts;
+	const Dart* m_QLT;
+	const Dart* m_ItDarts;
 public:
 	Traversor2VE(const MAP& map, Vertex dart) ;
 
@@ -66,8 +66,8 @@ private:
 	const MAP& m ;
 	Face start ;
 	Face current ;
-	const std::vector<Dart>* m_QLT;
-	std::vector<Dart>::const_iterator m_ItDarts;
+	const Dart* m_QLT;
+	const Dart* m_ItDarts;
 public:
 	Traversor2VF(const MAP& map, Vertex dart) ;
 
@@ -88,8 +88,8 @@ private:
 	const MAP& m ;
 	Vertex start ;
 	Vertex current ;
-	const std::vector<Dart>* m_QLT;
-	std::vector<Dart>::const_iterator m_ItDarts;
+	const Dart* m_QLT;
+	const Dart* m_ItDarts;
 public:
 	Traversor2VVaE(const MAP& map, Vertex dart) ;
 
@@ -112,8 +112,8 @@ private:
 	Vertex current ;
 
 	Vertex stop ;
-	const std::vector<Dart>* m_QLT;
-	std::vector<Dart>::const_iterator m_ItDarts;
+	const Dart* m_QLT;
+	const Dart* m_ItDarts;
 public:
 	Traversor2VVaF(const MAP& map, Vertex dart) ;
 
@@ -138,8 +138,8 @@ private:
 	const MAP& m ;
 	Vertex start ;
 	Vertex current ;
-	const std::vector<Dart>* m_QLT;
-	std::vector<Dart>::const_iterator m_ItDarts;
+	const Dart* m_QLT;
+	const Dart* m_ItDarts;
 public:
 	Traversor2EV(const MAP& map, Edge dart) ;
 
@@ -160,8 +160,8 @@ private:
 	const MAP& m ;
 	Face start ;
 	Face current ;
-	const std::vector<Dart>* m_QLT;
-	std::vector<Dart>::const_iterator m_ItDarts;
+	const Dart* m_QLT;
+	const Dart* m_ItDarts;
 public:
 	Traversor2EF(const MAP& map, Edge dart) ;
 
@@ -184,8 +184,8 @@ private:
 	Edge current ;
 
 	Edge stop1, stop2 ;
-	const std::vector<Dart>* m_QLT;
-	std::vector<Dart>::const_iterator m_ItDarts;
+	const Dart* m_QLT;
+	const Dart* m_ItDarts;
 public:
 	Traversor2EEaV(const MAP& map, Edge dart) ;
 
@@ -208,8 +208,8 @@ private:
 	Edge current ;
 
 	Edge stop1, stop2 ;
-	const std::vector<Dart>* m_QLT;
-	std::vector<Dart>::const_iterator m_ItDarts;
+	const Dart* m_QLT;
+	const Dart* m_ItDarts;
 public:
 	Traversor2EEaF(const MAP& map, Edge dart) ;
 
@@ -234,8 +234,8 @@ private:
 	const MAP& m ;
 	Vertex start ;
 	Vertex current ;
-	const std::vector<Dart>* m_QLT;
-	std::vector<Dart>::const_iterator m_ItDarts;
+	const Dart* m_QLT;
+	const Dart* m_ItDarts;
 public:
 	Traversor2FV(const MAP& map, Face dart) ;
 
@@ -265,8 +265,8 @@ private:
 	const MAP& m ;
 	Edge start ;
 	Edge current ;
-	const std::vector<Dart>* m_QLT;
-	std::vector<Dart>::const_iterator m_ItDarts;
+	const Dart* m_QLT;
+	const Dart* m_ItDarts;
 public:
 	Traversor2FE(const MAP& map, Face dart) ;
 
@@ -290,8 +290,8 @@ private:
 	Face current ;
 
 	Face stop ;
-	const std::vector<Dart>* m_QLT;
-	std::vector<Dart>::const_iterator m_ItDarts;
+	const Dart* m_QLT;
+	const Dart* m_ItDarts;
 public:
 	Traversor2FFaV(const MAP& map, Face dart) ;
 
@@ -313,8 +313,8 @@ private:
 	const MAP& m ;
 	Face start ;
 	Face current ;
-	const std::vector<Dart>* m_QLT;
-	std::vector<Dart>::const_iterator m_ItDarts;
+	const Dart* m_QLT;
+	const Dart* m_ItDarts;
 public:
 	Traversor2FFaE(const MAP& map, Face dart) ;
 
@@ -43,8 +43,8 @@ private:
 	const MAP& m ;
 	Dart start ;
 	Dart current ;
-	const std::vector<Dart>* m_QLT;
-	std::vector<Dart>::const_iterator m_ItDarts;
+	const Dart* m_QLT;
+	const Dart* m_ItDarts;
 public:
 	VTraversor2VE(const MAP& map, Dart dart) ;
 
@@ -61,8 +61,8 @@ private:
 	const MAP& m ;
 	Dart start ;
 	Dart current ;
-	const std::vector<Dart>* m_QLT;
-	std::vector<Dart>::const_iterator m_ItDarts;
+	const Dart* m_QLT;
+	const Dart* m_ItDarts;
 public:
 	VTraversor2VF(const MAP& map, Dart dart) ;
 
@@ -79,8 +79,8 @@ private:
 	const MAP& m ;
 	Dart start ;
 	Dart current ;
-	const std::vector<Dart>* m_QLT;
-	std::vector<Dart>::const_iterator m_ItDarts;
+	const Dart* m_QLT;
+	const Dart* m_ItDarts;
 public:
 	VTraversor2VVaE(const MAP& map, Dart dart) ;
 
@@ -99,8 +99,8 @@ private:
 	Dart current ;
 
 	Dart stop ;
-	const std::vector<Dart>* m_QLT;
-	std::vector<Dart>::const_iterator m_ItDarts;
+	const Dart* m_QLT;
+	const Dart* m_ItDarts;
 public:
 	VTraversor2VVaF(const MAP& map, Dart dart) ;
 
@@ -121,8 +121,8 @@ private:
 	const MAP& m ;
 	Dart start ;
 	Dart current ;
-	const std::vector<Dart>* m_QLT;
-	std::vector<Dart>::const_iterator m_ItDarts;
+	const Dart* m_QLT;
+	const Dart* m_ItDarts;
 public:
 	VTraversor2EV(const MAP& map, Dart dart) ;
 
@@ -139,8 +139,8 @@ private:
 	const MAP& m ;
 	Dart start ;
 	Dart current ;
-	const std::vector<Dart>* m_QLT;
-	std::vector<Dart>::const_iterator m_ItDarts;
+	const Dart* m_QLT;
+	const Dart* m_ItDarts;
 public:
 	VTraversor2EF(const MAP& map, Dart dart) ;
 
@@ -159,8 +159,8 @@ private:
 	Dart current ;
 
 	Dart stop1, stop2 ;
-	const std::vector<Dart>* m_QLT;
-	std::vector<Dart>::const_iterator m_ItDarts;
+	const Dart* m_QLT;
+	const Dart* m_ItDarts;
 public:
 	VTraversor2EEaV(const MAP& map, Dart dart) ;
 
@@ -179,8 +179,8 @@ private:
 	Dart current ;
 
 	Dart stop1, stop2 ;
-	const std::vector<Dart>* m_QLT;
-	std::vector<Dart>::const_iterator m_ItDarts;
+	const Dart* m_QLT;
+	const Dart* m_ItDarts;
 public:
 	VTraversor2EEaF(const MAP& map, Dart dart) ;
 
@@ -201,8 +201,8 @@ private:
 	const MAP& m ;
 	Dart start ;
 	Dart current ;
-	const std::vector<Dart>* m_QLT;
-	std::vector<Dart>::const_iterator m_ItDarts;
+	const Dart* m_QLT;
+	const Dart* m_ItDarts;
 public:
 	VTraversor2FV(const MAP& map, Dart dart) ;
 
@@ -230,8 +230,8 @@ private:
 	Dart current ;
 
 	Dart stop ;
-	const std::vector<Dart>* m_QLT;
-	std::vector<Dart>::const_iterator m_ItDarts;
+	const Dart* m_QLT;
+	const Dart* m_ItDarts;
 public:
 	VTraversor2FFaV(const MAP& map, Dart dart) ;
 
@@ -248,8 +248,8 @@ private:
 	const MAP& m ;
 	Dart start ;
 	Dart current ;
-	const std::vector<Dart>* m_QLT;
-	std::vector<Dart>::const_iterator m_ItDarts;
+	const Dart* m_QLT;
+	const Dart* m_ItDarts;
 public:
 	VTraversor2FFaE(const MAP& map, Dart dart) ;
 
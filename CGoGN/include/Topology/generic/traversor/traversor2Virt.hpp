@@ -32,12 +32,12 @@ namespace CGoGN
 // VTraversor2VE
 
 template <typename MAP>
-VTraversor2VE<MAP>::VTraversor2VE(const MAP& map, Dart dart) : m(map), start(dart),m_QLT(NULL)
+VTraversor2VE<MAP>::VTraversor2VE(const MAP& map, Dart dart) : m(map), start(dart),m_QLT(NULL), m_ItDarts(NULL)
 {
-	const AttributeMultiVector<NoTypeNameAttribute<std::vector<Dart> > >* quickTraversal = map.template getQuickIncidentTraversal<VERTEX,EDGE>() ;
+	const QuickLocalTraversal* quickTraversal = map.template getQuickIncidentTraversal<VERTEX,EDGE>() ;
 	if (quickTraversal != NULL)
 	{
-		m_QLT  = &(quickTraversal->operator[](map.template getEmbedding<VERTEX>(dart)));
+		m_QLT  = (*quickTraversal)[map.template getEmbedding<VERTEX>(dart)];
 	}
 }
 
@@ -46,7 +46,7 @@ Dart VTraversor2VE<MAP>::begin()
 {
 	if(m_QLT != NULL)
 	{
-		m_ItDarts = m_QLT->begin();
+		m_ItDarts = m_QLT;
 		return *m_ItDarts++;
 	}
 
@@ -81,12 +81,12 @@ Dart VTraversor2VE<MAP>::next()
 // VTraversor2VF
 
 template <typename MAP>
-VTraversor2VF<MAP>::VTraversor2VF(const MAP& map, Dart dart) : m(map), start(dart),m_QLT(NULL)
+VTraversor2VF<MAP>::VTraversor2VF(const MAP& map, Dart dart) : m(map), start(dart),m_QLT(NULL), m_ItDarts(NULL)
 {
-	const AttributeMultiVector<NoTypeNameAttribute<std::vector<Dart> > >* quickTraversal = map.template getQuickIncidentTraversal<VERTEX,FACE>() ;
+	const QuickLocalTraversal* quickTraversal = map.template getQuickIncidentTraversal<VERTEX,FACE>() ;
 	if (quickTraversal != NULL)
 	{
-		m_QLT  = &(quickTraversal->operator[](map.template getEmbedding<VERTEX>(dart)));
+		m_QLT  = (*quickTraversal)[map.template getEmbedding<VERTEX>(dart)];
 	}
 	else
 	{
@@ -100,7 +100,7 @@ Dart VTraversor2VF<MAP>::begin()
 {
 	if(m_QLT != NULL)
 	{
-		m_ItDarts = m_QLT->begin();
+		m_ItDarts = m_QLT;
 		return *m_ItDarts++;
 	}
 
@@ -135,12 +135,12 @@ Dart VTraversor2VF<MAP>::next()
 // VTraversor2VVaE
 
 template <typename MAP>
-VTraversor2VVaE<MAP>::VTraversor2VVaE(const MAP& map, Dart dart) : m(map),m_QLT(NULL)
+VTraversor2VVaE<MAP>::VTraversor2VVaE(const MAP& map, Dart dart) : m(map),m_QLT(NULL), m_ItDarts(NULL)
 {
-	const AttributeMultiVector<NoTypeNameAttribute<std::vector<Dart> > >* quickTraversal = map.template getQuickAdjacentTraversal<VERTEX,EDGE>() ;
+	const QuickLocalTraversal* quickTraversal = map.template getQuickAdjacentTraversal<VERTEX,EDGE>() ;
 	if (quickTraversal != NULL)
 	{
-		m_QLT  = &(quickTraversal->operator[](map.template getEmbedding<VERTEX>(dart)));
+		m_QLT  = (*quickTraversal)[map.template getEmbedding<VERTEX>(dart)];
 	}
 	else
 	{
@@ -153,7 +153,7 @@ Dart VTraversor2VVaE<MAP>::begin()
 {
 	if(m_QLT != NULL)
 	{
-		m_ItDarts = m_QLT->begin();
+		m_ItDarts = m_QLT;
 		return *m_ItDarts++;
 	}
 
@@ -186,12 +186,12 @@ Dart VTraversor2VVaE<MAP>::next()
 // VTraversor2VVaF
 
 template <typename MAP>
-VTraversor2VVaF<MAP>::VTraversor2VVaF(const MAP& map, Dart dart) : m(map),m_QLT(NULL)
+VTraversor2VVaF<MAP>::VTraversor2VVaF(const MAP& map, Dart dart) : m(map),m_QLT(NULL), m_ItDarts(NULL)
 {
-	const AttributeMultiVector<NoTypeNameAttribute<std::vector<Dart> > >* quickTraversal = map.template getQuickAdjacentTraversal<VERTEX,FACE>() ;
+	const QuickLocalTraversal* quickTraversal = map.template getQuickAdjacentTraversal<VERTEX,FACE>() ;
 	if (quickTraversal != NULL)
 	{
-		m_QLT  = &(quickTraversal->operator[](map.template getEmbedding<VERTEX>(dart)));
+		m_QLT  = (*quickTraversal)[map.template getEmbedding<VERTEX>(dart)];
 	}
 	else
 	{
@@ -209,7 +209,7 @@ Dart VTraversor2VVaF<MAP>::begin()
 {
 	if(m_QLT != NULL)
 	{
-		m_ItDarts = m_QLT->begin();
+		m_ItDarts = m_QLT;
 		return *m_ItDarts++;
 	}
 
@@ -260,12 +260,12 @@ Dart VTraversor2VVaF<MAP>::next()
 // VTraversor2EV
 
 template <typename MAP>
-VTraversor2EV<MAP>::VTraversor2EV(const MAP& map, Dart dart) : m(map), start(dart),m_QLT(NULL)
+VTraversor2EV<MAP>::VTraversor2EV(const MAP& map, Dart dart) : m(map), start(dart),m_QLT(NULL), m_ItDarts(NULL)
 {
-	const AttributeMultiVector<NoTypeNameAttribute<std::vector<Dart> > >* quickTraversal = map.template getQuickIncidentTraversal<EDGE,VERTEX>() ;
+	const QuickLocalTraversal* quickTraversal = map.template getQuickIncidentTraversal<EDGE,VERTEX>() ;
 	if (quickTraversal != NULL)
 	{
-		m_QLT  = &(quickTraversal->operator[](map.template getEmbedding<EDGE>(dart)));
+		m_QLT  = (*quickTraversal)[map.template getEmbedding<EDGE>(dart)];
 	}
 }
 
@@ -274,7 +274,7 @@ Dart VTraversor2EV<MAP>::begin()
 {
 	if(m_QLT != NULL)
 	{
-		m_ItDarts = m_QLT->begin();
+		m_ItDarts = m_QLT;
 		return *m_ItDarts++;
 	}
 
@@ -307,12 +307,12 @@ Dart VTraversor2EV<MAP>::next()
 // VTraversor2EF
 
 template <typename MAP>
-VTraversor2EF<MAP>::VTraversor2EF(const MAP& map, Dart dart) : m(map), start(dart),m_QLT(NULL)
+VTraversor2EF<MAP>::VTraversor2EF(const MAP& map, Dart dart) : m(map), start(dart),m_QLT(NULL), m_ItDarts(NULL)
 {
-	const AttributeMultiVector<NoTypeNameAttribute<std::vector<Dart> > >* quickTraversal = map.template getQuickIncidentTraversal<EDGE,FACE>() ;
+	const QuickLocalTraversal* quickTraversal = map.template getQuickIncidentTraversal<EDGE,FACE>() ;
 	if (quickTraversal != NULL)
 	{
-		m_QLT  = &(quickTraversal->operator[](map.template getEmbedding<EDGE>(dart)));
+		m_QLT  = (*quickTraversal)[map.template getEmbedding<EDGE>(dart)];
 	}
 	else
 	{
@@ -326,7 +326,7 @@ Dart VTraversor2EF<MAP>::begin()
 {
 	if(m_QLT != NULL)
 	{
-		m_ItDarts = m_QLT->begin();
+		m_ItDarts = m_QLT;
 		return *m_ItDarts++;
 	}
 
@@ -359,12 +359,12 @@ Dart VTraversor2EF<MAP>::next()
 // VTraversor2EEaV
 
 template <typename MAP>
-VTraversor2EEaV<MAP>::VTraversor2EEaV(const MAP& map, Dart dart) : m(map),m_QLT(NULL)
+VTraversor2EEaV<MAP>::VTraversor2EEaV(const MAP& map, Dart dart) : m(map),m_QLT(NULL), m_ItDarts(NULL)
 {
-	const AttributeMultiVector<NoTypeNameAttribute<std::vector<Dart> > >* quickTraversal = map.template getQuickAdjacentTraversal<EDGE,VERTEX>() ;
+	const QuickLocalTraversal* quickTraversal = map.template getQuickAdjacentTraversal<EDGE,VERTEX>() ;
 	if (quickTraversal != NULL)
 	{
-		m_QLT  = &(quickTraversal->operator[](map.template getEmbedding<EDGE>(dart)));
+		m_QLT  = (*quickTraversal)[map.template getEmbedding<EDGE>(dart)];
 	}
 	else
 	{
@@ -379,7 +379,7 @@ Dart VTraversor2EEaV<MAP>::begin()
 {
 	if(m_QLT != NULL)
 	{
-		m_ItDarts = m_QLT->begin();
+		m_ItDarts = m_QLT;
 		return *m_ItDarts++;
 	}
 
@@ -414,12 +414,12 @@ Dart VTraversor2EEaV<MAP>::next()
 // VTraversor2EEaF
 
 template <typename MAP>
-VTraversor2EEaF<MAP>::VTraversor2EEaF(const MAP& map, Dart dart) : m(map),m_QLT(NULL)
+VTraversor2EEaF<MAP>::VTraversor2EEaF(const MAP& map, Dart dart) : m(map),m_QLT(NULL), m_ItDarts(NULL)
 {
-	const AttributeMultiVector<NoTypeNameAttribute<std::vector<Dart> > >* quickTraversal = map.template getQuickAdjacentTraversal<EDGE,FACE>() ;
+	const QuickLocalTraversal* quickTraversal = map.template getQuickAdjacentTraversal<EDGE,FACE>() ;
 	if (quickTraversal != NULL)
 	{
-		m_QLT  = &(quickTraversal->operator[](map.template getEmbedding<EDGE>(dart)));
+		m_QLT  = (*quickTraversal)[map.template getEmbedding<EDGE>(dart)];
 	}
 	else
 	{
@@ -437,7 +437,7 @@ Dart VTraversor2EEaF<MAP>::begin()
 {
 	if(m_QLT != NULL)
 	{
-		m_ItDarts = m_QLT->begin();
+		m_ItDarts = m_QLT;
 		return *m_ItDarts++;
 	}
 
@@ -481,12 +481,12 @@ Dart VTraversor2EEaF<MAP>::next()
 // VTraversor2FV
 
 template <typename MAP>
-VTraversor2FV<MAP>::VTraversor2FV(const MAP& map, Dart dart) : m(map), start(dart),m_QLT(NULL)
+VTraversor2FV<MAP>::VTraversor2FV(const MAP& map, Dart dart) : m(map), start(dart),m_QLT(NULL), m_ItDarts(NULL)
 {
-	const AttributeMultiVector<NoTypeNameAttribute<std::vector<Dart> > >* quickTraversal = map.template getQuickIncidentTraversal<FACE,VERTEX>() ;
+	const QuickLocalTraversal* quickTraversal = map.template getQuickIncidentTraversal<FACE,VERTEX>() ;
 	if (quickTraversal != NULL)
 	{
-		m_QLT  = &(quickTraversal->operator[](map.template getEmbedding<FACE>(dart)));
+		m_QLT  = (*quickTraversal)[map.template getEmbedding<FACE>(dart)];
 	}
 }
 
@@ -495,7 +495,7 @@ Dart VTraversor2FV<MAP>::begin()
 {
 	if(m_QLT != NULL)
 	{
-		m_ItDarts = m_QLT->begin();
+		m_ItDarts = m_QLT;
 		return *m_ItDarts++;
 	}
 
@@ -528,12 +528,12 @@ Dart VTraversor2FV<MAP>::next()
 // VTraversor2FFaV
 
 template <typename MAP>
-VTraversor2FFaV<MAP>::VTraversor2FFaV(const MAP& map, Dart dart) : m(map),m_QLT(NULL)
+VTraversor2FFaV<MAP>::VTraversor2FFaV(const MAP& map, Dart dart) : m(map),m_QLT(NULL), m_ItDarts(NULL)
 {
-	const AttributeMultiVector<NoTypeNameAttribute<std::vector<Dart> > >* quickTraversal = map.template getQuickAdjacentTraversal<FACE,VERTEX>() ;
+	const QuickLocalTraversal* quickTraversal = map.template getQuickAdjacentTraversal<FACE,VERTEX>() ;
 	if (quickTraversal != NULL)
 	{
-		m_QLT  = &(quickTraversal->operator[](map.template getEmbedding<FACE>(dart)));
+		m_QLT  = (*quickTraversal)[map.template getEmbedding<FACE>(dart)];
 	}
 	else
 	{
@@ -555,7 +555,7 @@ Dart VTraversor2FFaV<MAP>::begin()
 {
 	if(m_QLT != NULL)
 	{
-		m_ItDarts = m_QLT->begin();
+		m_ItDarts = m_QLT;
 		return *m_ItDarts++;
 	}
 
@@ -602,12 +602,12 @@ Dart VTraversor2FFaV<MAP>::next()
 // VTraversor2FFaE
 
 template <typename MAP>
-VTraversor2FFaE<MAP>::VTraversor2FFaE(const MAP& map, Dart dart) : m(map),m_QLT(NULL)
+VTraversor2FFaE<MAP>::VTraversor2FFaE(const MAP& map, Dart dart) : m(map),m_QLT(NULL), m_ItDarts(NULL)
 {
-	const AttributeMultiVector<NoTypeNameAttribute<std::vector<Dart> > >* quickTraversal = map.template getQuickAdjacentTraversal<FACE,EDGE>() ;
+	const QuickLocalTraversal* quickTraversal = map.template getQuickAdjacentTraversal<FACE,EDGE>() ;
 	if (quickTraversal != NULL)
 	{
-		m_QLT  = &(quickTraversal->operator[](map.template getEmbedding<FACE>(dart)));
+		m_QLT  = (*quickTraversal)[map.template getEmbedding<FACE>(dart)];
 	}
 	else
 	{
@@ -626,7 +626,7 @@ Dart VTraversor2FFaE<MAP>::begin()
 {
 	if(m_QLT != NULL)
 	{
-		m_ItDarts = m_QLT->begin();
+		m_ItDarts = m_QLT;
 		return *m_ItDarts++;
 	}
 
@@ -102,13 +102,14 @@ Traversor3XY<MAP, ORBX, ORBY>::Traversor3XY(const MAP& map, Cell<ORBX> c, bool f
 	m_cmark(NULL),
 	m_tradoo(map, c),
 	m_QLT(NULL),
+	m_ItDarts(NULL),
 	m_allocated(true),
 	m_first(true)
 {
-	const AttributeMultiVector<NoTypeNameAttribute<std::vector<Dart> > >* quickTraversal = map.template getQuickIncidentTraversal<ORBX,ORBY>() ;
+	const QuickLocalTraversal* quickTraversal = map.template getQuickIncidentTraversal<ORBX,ORBY>() ;
 	if (quickTraversal != NULL)
 	{
-		m_QLT = &(quickTraversal->operator[](map.getEmbedding(c)));
+		m_QLT = (*quickTraversal)[map.getEmbedding(c)];
 	}
 	else
 	{
@@ -124,6 +125,7 @@ Traversor3XY<MAP, ORBX, ORBY>::Traversor3XY(const MAP& map, Cell<ORBX> c, Marker
 	m_map(map),
 	m_tradoo(map, c),
 	m_QLT(NULL),
+	m_ItDarts(NULL),
 	m_allocated(false),
 	m_first(true)
 {
@@ -148,7 +150,7 @@ Cell<ORBY> Traversor3XY<MAP, ORBX, ORBY>::begin()
 {
 	if(m_QLT != NULL)
 	{
-		m_ItDarts = m_QLT->begin();
+		m_ItDarts = m_QLT;
 		return *m_ItDarts++;
 	}
 
@@ -257,12 +259,13 @@ Cell<ORBY> Traversor3XY<MAP, ORBX, ORBY>::next()
 template <typename MAP, unsigned int ORBX, unsigned int ORBY>
 Traversor3XXaY<MAP, ORBX, ORBY>::Traversor3XXaY(const MAP& map, Cell<ORBX> c, bool forceDartMarker):
 	m_map(map),
-	m_QLT(NULL)
+	m_QLT(NULL),
+	m_ItDarts(NULL)
 {
-	const AttributeMultiVector<NoTypeNameAttribute<std::vector<Dart> > >* quickTraversal =  map.template getQuickAdjacentTraversal<ORBX,ORBY>() ;
+	const QuickLocalTraversal* quickTraversal =  map.template getQuickAdjacentTraversal<ORBX,ORBY>() ;
 	if (quickTraversal != NULL)
 	{
-		m_QLT  = &(quickTraversal->operator[](map.getEmbedding(c)));
+		m_QLT  = (*quickTraversal)[map.getEmbedding(c)];
 	}
 	else
 	{
@@ -285,7 +288,7 @@ Cell<ORBX> Traversor3XXaY<MAP, ORBX, ORBY>::begin()
 {
 	if(m_QLT != NULL)
 	{
-		m_ItDarts = m_QLT->begin();
+		m_ItDarts = m_QLT;
 		return *m_ItDarts++;
 	}
 
@@ -71,8 +71,8 @@ private:
 	Dart m_current ;
 	TraversorDartsOfOrbit<MAP, ORBX> m_tradoo;
 
-	const std::vector<Dart>* m_QLT;
-	std::vector<Dart>::const_iterator m_ItDarts;
+	const Dart* m_QLT;
+	const Dart* m_ItDarts;
 
 	bool m_allocated;
 	bool m_first;
@@ -99,8 +99,8 @@ private:
 	std::vector<Dart> m_vecDarts;
 	std::vector<Dart>::iterator m_iter;
 
-	const std::vector<Dart>* m_QLT;
-	std::vector<Dart>::const_iterator m_ItDarts;
+	const Dart* m_QLT;
+	const Dart* m_ItDarts;
 
 public:
 	VTraversor3XXaY(MAP& map, Dart dart, bool forceDartMarker = false);
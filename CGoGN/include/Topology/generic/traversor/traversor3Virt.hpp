@@ -102,13 +102,14 @@ VTraversor3XY<MAP, ORBX, ORBY>::VTraversor3XY(MAP& map, Dart dart, bool forceDar
 	m_cmark(NULL),
 	m_tradoo(map, dart),
 	m_QLT(NULL),
+	m_ItDarts(NULL),
 	m_allocated(true),
 	m_first(true)
 {
-	const AttributeMultiVector<NoTypeNameAttribute<std::vector<Dart> > >* quickTraversal = map.template getQuickIncidentTraversal<ORBX,ORBY>() ;
+	const QuickLocalTraversal* quickTraversal = map.template getQuickIncidentTraversal<ORBX,ORBY>() ;
 	if (quickTraversal != NULL)
 	{
-		m_QLT  = &(quickTraversal->operator[](map.template getEmbedding<ORBX>(dart)));
+		m_QLT  = (*quickTraversal)[map.template getEmbedding<ORBX>(dart)];
 	}
 	else
 	{
@@ -124,6 +125,7 @@ VTraversor3XY<MAP, ORBX, ORBY>::VTraversor3XY(MAP& map, Dart dart, VMarkerForTra
 	m_map(map),
 	m_tradoo(map, dart),
 	m_QLT(NULL),
+	m_ItDarts(NULL),
 	m_allocated(false),
 	m_first(true)
 {
@@ -148,7 +150,7 @@ Dart VTraversor3XY<MAP, ORBX, ORBY>::begin()
 {
 	if(m_QLT != NULL)
 	{
-		m_ItDarts = m_QLT->begin();
+		m_ItDarts = m_QLT;
 		return *m_ItDarts++;
 	}
 
@@ -256,12 +258,12 @@ Dart VTraversor3XY<MAP, ORBX, ORBY>::next()
 
 template <typename MAP, unsigned int ORBX, unsigned int ORBY>
 VTraversor3XXaY<MAP, ORBX, ORBY>::VTraversor3XXaY(MAP& map, Dart dart, bool forceDartMarker):
-	m_map(map),m_QLT(NULL)
+	m_map(map),m_QLT(NULL), m_ItDarts(NULL)
 {
-	const AttributeMultiVector<NoTypeNameAttribute<std::vector<Dart> > >* quickTraversal = map.template getQuickAdjacentTraversal<ORBX,ORBY>() ;
+	const QuickLocalTraversal* quickTraversal = map.template getQuickAdjacentTraversal<ORBX,ORBY>() ;
 	if (quickTraversal != NULL)
 	{
-		m_QLT  = &(quickTraversal->operator[](map.template getEmbedding<ORBX>(dart)));
+		m_QLT  = (*quickTraversal)[map.template getEmbedding<ORBX>(dart)];
 	}
 	else
 	{
@@ -284,7 +286,7 @@ Dart VTraversor3XXaY<MAP, ORBX, ORBY>::begin()
 {
 	if(m_QLT != NULL)
 	{
-		m_ItDarts = m_QLT->begin();
+		m_ItDarts = m_QLT;
 		return *m_ItDarts++;
 	}
 
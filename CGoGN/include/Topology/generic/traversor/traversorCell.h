@@ -43,7 +43,11 @@ namespace CGoGN
  *  - OPT type of optimization
  */
 
-enum TraversalOptim {AUTO=0, FORCE_DART_MARKING, FORCE_CELL_MARKING, FORCE_QUICK_TRAVERSAL};
+/*
+ * FORCE_CONTAINER_RANGES: sequential traversals behave as FORCE_QUICK_TRAVERSAL,
+ * parallel traversals split the blocks of the orbit container in index ranges
+ */
+enum TraversalOptim {AUTO=0, FORCE_DART_MARKING, FORCE_CELL_MARKING, FORCE_QUICK_TRAVERSAL, FORCE_CONTAINER_RANGES};
 
 template <typename MAP, unsigned int ORBIT, TraversalOptim OPT = AUTO>
 class TraversorCell
@@ -139,6 +143,19 @@ namespace Parallel
 template <unsigned int ORBIT, typename MAP, typename FUNC>
 void foreach_cell(MAP& map, FUNC func, TraversalOptim opt = AUTO, unsigned int nbth = NumberOfThreads);
 
+/**
+ * @brief foreach_cell_by_container traverse the cells by contiguous ranges of lines
+ * of the ORBIT container (no marker, no shared iterator).
+ * The quick traversal table (cell -> dart) is enabled if needed and kept up to date
+ * by the embedding functions of the map. The browser of the container is ignored.
+ * As with enableQuickTraversal, later AUTO traversals of ORBIT use the table.
+ * @param map
+ * @param func function to apply on cells: func(Cell<ORBIT> c, unsigned int thread)
+ * @param nbth number of used threads
+ */
+template <unsigned int ORBIT, typename MAP, typename FUNC>
+void foreach_cell_by_container(MAP& map, FUNC func, unsigned int nbth = NumberOfThreads);
+
 } // namespace Parallel
 
 
@@ -22,12 +22,17 @@
 *                                                                              *
 *******************************************************************************/
 
-#include "Utils/threadbarrier.h"
+#include "Utils/threadPool.h"
 #include <vector>
+#include <atomic>
+#include <algorithm>
+#include <type_traits>
 
 namespace CGoGN
 {
 
+class MapMulti;
+
 template <typename MAP, unsigned int ORBIT, TraversalOptim OPT>
 TraversorCell<MAP, ORBIT, OPT>::TraversorCell(const MAP& map, bool forceDartMarker) :
 	m(map),
@@ -47,6 +52,7 @@ TraversorCell<MAP, ORBIT, OPT>::TraversorCell(const MAP& map, bool forceDartMark
 		case FORCE_CELL_MARKING:
 			cmark = new CellMarker<MAP, ORBIT>(map) ;
 			break;
+		case FORCE_CONTAINER_RANGES:
 		case FORCE_QUICK_TRAVERSAL:
 			quickTraversal = map.template getQuickTraversal<ORBIT>() ;
 			assert(quickTraversal != NULL);
@@ -147,6 +153,7 @@ Cell<ORBIT> TraversorCell<MAP, ORBIT, OPT>::begin()
 				cmark->mark(current) ;
 		}
 			break;
+		case FORCE_CONTAINER_RANGES:
 		case FORCE_QUICK_TRAVERSAL:
 		{
 			qCurrent = cont->begin() ;
@@ -237,6 +244,7 @@ Cell<ORBIT> TraversorCell<MAP, ORBIT, OPT>::next()
 				cmark->mark(current) ;
 		}
 			break;
+		case FORCE_CONTAINER_RANGES:
 		case FORCE_QUICK_TRAVERSAL:
 		{
 			cont->next(qCurrent) ;
@@ -304,6 +312,7 @@ void TraversorCell<MAP, ORBIT, OPT>::skip(Cell<ORBIT> c)
 		case FORCE_CELL_MARKING:
 			cmark->mark(c) ;
 			break;
+		case FORCE_CONTAINER_RANGES:
 		case FORCE_QUICK_TRAVERSAL:
 			break;
 		case AUTO:
@@ -359,6 +368,7 @@ Cell<ORBIT> TraversorCellOdd<MAP, ORBIT, OPT>::begin()
 				this->cmark->unmark(this->current) ;
 		}
 			break;
+		case FORCE_CONTAINER_RANGES:
 		case FORCE_QUICK_TRAVERSAL:
 		{
 			this->qCurrent = this->cont->begin() ;
@@ -433,6 +443,7 @@ Cell<ORBIT> TraversorCellOdd<MAP, ORBIT, OPT>::next()
 				this->cmark->unmark(this->current) ;
 		}
 			break;
+		case FORCE_CONTAINER_RANGES:
 		case FORCE_QUICK_TRAVERSAL:
 		{
 			this->cont->next(this->qCurrent) ;
@@ -512,6 +523,7 @@ inline void foreach_cell(const MAP& map, FUNC f, TraversalOptim opt)
 				f(c);
 		}
 			break;
+		case FORCE_CONTAINER_RANGES:
 		case FORCE_QUICK_TRAVERSAL:
 		{
 			TraversorCell<MAP, ORBIT,FORCE_QUICK_TRAVERSAL> trav(map, false);
@@ -551,6 +563,7 @@ inline void foreach_cell_until(const MAP& map, FUNC f, TraversalOptim opt)
 					break;
 		}
 			break;
+		case FORCE_CONTAINER_RANGES:
 		case FORCE_QUICK_TRAVERSAL:
 		{
 			TraversorCell<MAP, ORBIT,FORCE_QUICK_TRAVERSAL> trav(map, false);
@@ -769,131 +782,215 @@ namespace Parallel
 //}
 
 
-/// internal functor for boost call
-template <TraversalOptim OPT, unsigned int ORBIT, typename MAP, typename FUNC>
-class ThreadFunction
+/**
+ * register the workers of the pool in the thread table of the map (needed for markers and buffers).
+ * The workers are persistent: they stay registered, so the table is only modified by the calling
+ * thread before the tasks are launched, never while they read it. Nothing is done from a worker
+ * (nested traversal executed inline, the worker is already registered)
+ */
+inline void registerThreads(GenericMap& map, const Utils::ThreadPool& pool, unsigned int nbth)
 {
-protected:
-	typedef Cell<ORBIT> CELL;
-
-	std::vector<CELL> m_cells;
-
-	unsigned int m_id;
-	FUNC m_lambda;
-	std::thread::id& m_threadId; // ref on thread::id in table of threads in genericMap for init at operator()
-	std::mutex& m_mutex_map;
-	TraversorCell<MAP, ORBIT, OPT>& m_trav;
-	Cell<ORBIT>& m_current_cell;
+	if (pool.currentWorker() != 0)
+		return;
+	for (unsigned int i = 0; i < nbth; ++i)
+		map.addThreadId(pool.getThreadId(i));
+}
 
+/**
+ * apply func(line, thread, task) on each used line of a container.
+ * The blocks of the container are dealt by contiguous ranges (tasks) to the threads;
+ * the counters of the hole blocks allow to skip empty blocks and to not test the lines of full ones
+ */
+template <typename FUNC>
+void foreach_line_by_blocks(const AttributeContainer& cont, FUNC func, Utils::ThreadPool& pool, unsigned int nbth)
+{
+	unsigned int nbBlocks = cont.nbBlocks();
+	unsigned int blockSize = cont.getBlockSize();
+	unsigned int nbTasks = std::min(nbBlocks, nbth * NB_TASKS_PER_THREAD);
 
-public:
-	ThreadFunction(FUNC func,unsigned int id, std::thread::id& threadId, std::mutex& mutmap, TraversorCell<MAP, ORBIT, OPT>& trav, Cell<ORBIT>& current_cell) :
-		m_id(id), m_lambda(func), m_threadId(threadId),
-		m_mutex_map(mutmap), m_trav(trav), m_current_cell(current_cell)
+	pool.exec(nbTasks, [&] (unsigned int task, unsigned int thr)
 	{
-	}
+		unsigned int bb = (unsigned int)((unsigned long long)(nbBlocks) * task / nbTasks);
+		unsigned int be = (unsigned int)((unsigned long long)(nbBlocks) * (task + 1) / nbTasks);
+		for (unsigned int b = bb; b < be; ++b)
+		{
+			unsigned int nbUsed = cont.nbUsedLinesInBlock(b);
+			unsigned int i = b * blockSize;
+			unsigned int e = i + blockSize;
+			if (nbUsed == blockSize)
+			{
+				for (; i < e; ++i)
+					func(i, thr, task);
+			}
+			else
+			{
+				// stop as soon as all used lines of the block are found
+				for (; (nbUsed > 0) && (i < e); ++i)
+				{
+					if (cont.used(i))
+					{
+						func(i, thr, task);
+						--nbUsed;
+					}
+				}
+			}
+		}
+	}, nbth);
+}
 
-	ThreadFunction(const ThreadFunction<OPT,ORBIT,MAP,FUNC>& tf):
-		 m_id(tf.m_id), m_lambda(tf.m_lambda),
-		 m_mutex_map(tf.mutmap), m_trav(tf.trav), m_current_cell(tf.current_cell)
-	{}
+/**
+ * cells of an embedded orbit of a mono-resolution map (dart index = line index): the darts are traversed twice,
+ * first to elect the dart of smallest index of each cell (the one sequential traversal gives),
+ * then to apply the function on the elected darts
+ */
+template <unsigned int ORBIT, typename MAP, typename FUNC>
+void foreach_cell_by_darts(MAP& map, FUNC& func, Utils::ThreadPool& pool, unsigned int nbth)
+{
+	const AttributeContainer& dartCont = map.getDartContainer();
+	const AttributeContainer& cellCont = map.template getAttributeContainer<ORBIT>();
+	unsigned int dim = map.dimension();
 
-	std::thread::id& getThreadId() { return m_threadId; }
+	std::vector< std::atomic<unsigned int> > elected(cellCont.realEnd());
 
-	void operator()()
+	foreach_line_by_blocks(cellCont, [&] (unsigned int i, unsigned int, unsigned int)
 	{
-		// first thing to do set the thread id in genericMap
-		m_threadId = std::this_thread::get_id();
-
-		m_cells.reserve(SIZE_BUFFER_THREAD);
-
-		bool finished = false;
+		elected[i].store(EMBNULL, std::memory_order_relaxed);
+	}, pool, nbth);
 
-		while (!finished)
+	foreach_line_by_blocks(dartCont, [&] (unsigned int i, unsigned int, unsigned int)
+	{
+		Dart d(i);
+		if (!map.isBoundaryMarked(dim, d))
 		{
-			// get data
-			m_mutex_map.lock();
-			Cell<ORBIT> c_end = m_trav.end();
-			while ((m_current_cell.dart != c_end.dart) && (m_cells.size() <SIZE_BUFFER_THREAD) )
-			{
-				m_cells.push_back(m_current_cell);
-				m_current_cell = m_trav.next();
-			}
-			m_mutex_map.unlock();
+			std::atomic<unsigned int>& el = elected[map.template getEmbedding<ORBIT>(Cell<ORBIT>(d))];
+			unsigned int current = el.load(std::memory_order_relaxed);
+			while (i < current && !el.compare_exchange_weak(current, i, std::memory_order_relaxed))
+				;
+		}
+	}, pool, nbth);
 
-			// and traverse
-			if (m_cells.empty())
-				finished = true;
-			else
-			{
-				for (typename std::vector<CELL>::const_iterator it = m_cells.begin(); it != m_cells.end(); ++it)
-					m_lambda(*it, m_id);
-				m_cells.clear();
-			}
+	foreach_line_by_blocks(dartCont, [&] (unsigned int i, unsigned int thr, unsigned int task)
+	{
+		Dart d(i);
+		if (!map.isBoundaryMarked(dim, d))
+		{
+			Cell<ORBIT> c(d);
+			if (elected[map.template getEmbedding<ORBIT>(c)].load(std::memory_order_relaxed) == i)
+				func(c, thr, task);
 		}
-	}
-};
+	}, pool, nbth);
+}
 
 template <TraversalOptim OPT, unsigned int ORBIT, typename MAP, typename FUNC>
 void foreach_cell_tmpl(MAP& map, FUNC func, unsigned int nbth)
 {
+	Utils::ThreadPool& pool = getThreadPool(nbth);
+	registerThreads(map, pool, nbth);
 
-	TraversorCell<MAP, ORBIT, OPT> trav(map);
-	Cell<ORBIT> cell = trav.begin();
-
-	std::mutex mutex_map;
+	// cell to dart attribute: blocks of the orbit container
+	const AttributeMultiVector<Dart>* quickTraversal = NULL;
+	if ((OPT == FORCE_CONTAINER_RANGES) || (OPT == FORCE_QUICK_TRAVERSAL) || (OPT == AUTO))
+		quickTraversal = map.template getQuickTraversal<ORBIT>();
 
-	// launch threads
-	std::thread** threads = new std::thread*[nbth];
-	ThreadFunction<OPT,ORBIT,MAP,FUNC>** tfs = new ThreadFunction<OPT,ORBIT,MAP,FUNC>*[nbth];
-
-	for (unsigned int i = 0; i < nbth; ++i)
+	if ((quickTraversal != NULL) && ((OPT == FORCE_CONTAINER_RANGES) || !map.template getAttributeContainer<ORBIT>().hasBrowser()))
 	{
-		std::thread::id& threadId = map.addEmptyThreadId();
-		tfs[i] = new ThreadFunction<OPT,ORBIT,MAP,FUNC>(func, 1+i,threadId,mutex_map,trav,cell);
-		threads[i] = new std::thread( std::ref( *(tfs[i]) ) );
+		foreach_line_by_blocks(map.template getAttributeContainer<ORBIT>(), [&] (unsigned int i, unsigned int thr, unsigned int task)
+		{
+			func(Cell<ORBIT>((*quickTraversal)[i]), thr, task);
+		}, pool, nbth);
+		return;
 	}
 
-	// wait for all theads to be finished
-	for (unsigned int i = 0; i < nbth; ++i)
+	// embedded orbit: blocks of darts
+	if (((OPT == FORCE_CELL_MARKING) || (OPT == AUTO)) &&
+		!std::is_same<typename MAP::IMPL, MapMulti>::value &&
+		map.template isOrbitEmbedded<ORBIT>() &&
+		!map.getDartContainer().hasBrowser())
 	{
-		threads[i]->join();
-		delete threads[i];
-		map.removeThreadId(tfs[i]->getThreadId());
-		delete tfs[i];
+		foreach_cell_by_darts<ORBIT>(map, func, pool, nbth);
+		return;
 	}
 
-	delete[] tfs;
-	delete[] threads;
-}
+	// otherwise the cells are gathered by a sequential traversal and then dealt by ranges
+	std::vector< Cell<ORBIT> > cells;
+	cells.reserve(map.template getAttributeContainer<ORBIT>().size());
+	TraversorCell<MAP, ORBIT, OPT> trav(map);
+	for (Cell<ORBIT> c = trav.begin(), e = trav.end(); c.dart != e.dart; c = trav.next())
+		cells.push_back(c);
 
+	unsigned int nbCells = (unsigned int)(cells.size());
+	unsigned int nbTasks = std::min(nbCells, nbth * NB_TASKS_PER_THREAD);
+	pool.exec(nbTasks, [&] (unsigned int task, unsigned int thr)
+	{
+		unsigned int b = (unsigned int)((unsigned long long)(nbCells) * task / nbTasks);
+		unsigned int e = (unsigned int)((unsigned long long)(nbCells) * (task + 1) / nbTasks);
+		for (unsigned int i = b; i < e; ++i)
+			func(cells[i], thr, task);
+	}, nbth);
+}
 
-template <unsigned int ORBIT, typename MAP, typename FUNC>
-void foreach_cell(MAP& map, FUNC func, TraversalOptim opt, unsigned int nbth)
+/// check the number of threads: at least 2 and no more than what the thread table of maps accepts
+inline unsigned int checkNbThreads(unsigned int nbth)
 {
 	if (nbth < 2)
 	{
 		CGoGNerr << "Warning number of threads must be > 1 for //" << CGoGNendl;
-		nbth = 2;
+		return 2;
 	}
+	if (nbth > NB_THREADS)
+		return NB_THREADS;
+	return nbth;
+}
+
+/**
+ * traversal of the cells by nbWorkers threads of the pool.
+ * func(cell, thread, task): the task (in [0, nbWorkers*NB_TASKS_PER_THREAD[) is a fixed
+ * range of cells that does not depend on the thread which executes it
+ */
+template <unsigned int ORBIT, typename MAP, typename FUNC>
+void foreach_cell_tasks(MAP& map, FUNC func, TraversalOptim opt, unsigned int nbWorkers)
+{
 	switch(opt)
 	{
 		case FORCE_DART_MARKING:
-			foreach_cell_tmpl<FORCE_DART_MARKING,ORBIT,MAP,FUNC>(map,func,nbth-1);
+			foreach_cell_tmpl<FORCE_DART_MARKING,ORBIT,MAP,FUNC>(map,func,nbWorkers);
 			break;
 		case FORCE_CELL_MARKING:
-			foreach_cell_tmpl<FORCE_CELL_MARKING,ORBIT,MAP,FUNC>(map,func,nbth-1);
+			foreach_cell_tmpl<FORCE_CELL_MARKING,ORBIT,MAP,FUNC>(map,func,nbWorkers);
 			break;
 		case FORCE_QUICK_TRAVERSAL:
-			foreach_cell_tmpl<FORCE_QUICK_TRAVERSAL,ORBIT,MAP,FUNC>(map,func,nbth-1);
+			foreach_cell_tmpl<FORCE_QUICK_TRAVERSAL,ORBIT,MAP,FUNC>(map,func,nbWorkers);
+			break;
+		case FORCE_CONTAINER_RANGES:
+			if (map.template getQuickTraversal<ORBIT>() == NULL)
+				map.template enableQuickTraversal<MAP, ORBIT>();
+			else if (!map.template isQuickTraversalUpToDate<ORBIT>())
+				map.template updateQuickTraversal<MAP, ORBIT>();
+			foreach_cell_tmpl<FORCE_CONTAINER_RANGES,ORBIT,MAP,FUNC>(map,func,nbWorkers);
 			break;
 		case AUTO:
 		default:
-			foreach_cell_tmpl<AUTO,ORBIT,MAP,FUNC>(map,func,nbth-1);
+			foreach_cell_tmpl<AUTO,ORBIT,MAP,FUNC>(map,func,nbWorkers);
 			break;
 	}
 }
 
+template <unsigned int ORBIT, typename MAP, typename FUNC>
+void foreach_cell(MAP& map, FUNC func, TraversalOptim opt, unsigned int nbth)
+{
+	nbth = checkNbThreads(nbth);
+	foreach_cell_tasks<ORBIT>(map, [&func] (Cell<ORBIT> c, unsigned int thr, unsigned int)
+	{
+		func(c, thr);
+	}, opt, nbth-1);
+}
+
+template <unsigned int ORBIT, typename MAP, typename FUNC>
+void foreach_cell_by_container(MAP& map, FUNC func, unsigned int nbth)
+{
+	foreach_cell<ORBIT>(map, func, FORCE_CONTAINER_RANGES, nbth);
+}
+
 } // namespace Parallel
 
 } // namespace CGoGN
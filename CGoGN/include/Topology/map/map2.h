@@ -313,6 +313,33 @@ public:
 	void splitSurface(std::vector<Dart>& vd, bool firstSideClosed = true, bool secondSideClosed = true);
 	//@}
 
+	/*! @name Bulk Topological Operators
+	 *  cutEdge and splitFace with darts created beforehand (isolated darts, see newCycle(1)).
+	 *  They only write the relations of the darts of the modified faces, so that they can be
+	 *  applied concurrently to distinct edges (cutEdgeWithDarts) or faces (splitFaceWithDarts).
+	 *  The embeddings and boundary marks of the inserted darts are left to the caller.
+	 *************************************************************************/
+
+	//@{
+	//! Cut the edge of d inserting dart nd after d and dart ne after phi2(d)
+	/*! Same relations as cutEdge(d), that would return nd
+	 *  @param d a dart of the edge to cut
+	 *  @param nd an isolated dart
+	 *  @param ne an isolated dart
+	 */
+	void cutEdgeWithDarts(Dart d, Dart nd, Dart ne);
+
+	//! Split a face f between d and e inserting dart dd before d and dart ee before e
+	/*! Same relations as splitFace(d, e): dd and ee form the new edge
+	 *  \pre Darts d & e MUST belong to the same face
+	 *  @param d first dart in face f
+	 *  @param e second dart in face f
+	 *  @param dd an isolated dart
+	 *  @param ee an isolated dart
+	 */
+	void splitFaceWithDarts(Dart d, Dart e, Dart dd, Dart ee);
+	//@}
+
 	/*! @name Topological Queries
 	 *  Return or set various topological information
 	 *************************************************************************/
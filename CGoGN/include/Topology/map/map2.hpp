@@ -705,6 +705,31 @@ void Map2<MAP_IMPL>::splitSurface(std::vector<Dart>& vd, bool firstSideClosed, b
 		fillHole(e2) ;
 }
 
+/*! @name Bulk Topological Operators
+ *  cutEdge and splitFace with darts created beforehand
+ *************************************************************************/
+
+template <typename MAP_IMPL>
+void Map2<MAP_IMPL>::cutEdgeWithDarts(Dart d, Dart nd, Dart ne)
+{
+	Dart e = phi2(d);
+	phi2unsew(d);				// remove old phi2 links
+	this->phi1sew(d, nd);		// insert nd after d
+	this->phi1sew(e, ne);		// insert ne after phi2(d)
+	phi2sew(d, ne);				// correct the phi2 links
+	phi2sew(e, nd);
+}
+
+template <typename MAP_IMPL>
+void Map2<MAP_IMPL>::splitFaceWithDarts(Dart d, Dart e, Dart dd, Dart ee)
+{
+	assert(d != e) ;
+	this->phi1sew(this->phi_1(d), dd);		// insert dd before d
+	this->phi1sew(this->phi_1(e), ee);		// insert ee before e
+	this->phi1sew(this->phi_1(dd), this->phi_1(ee));	// split the cycle (no sameCycle check)
+	phi2sew(dd, ee);
+}
+
 /*! @name Topological Queries
  *  Return or set various topological information
  *************************************************************************/
@@ -1257,18 +1282,12 @@ void Map2<MAP_IMPL>::reverseOrientation()
 		this->removeAttribute(new_emb0) ;
 	}
 
-	DartAttribute<Dart, Map2<MAP_IMPL> > n_phi1(this, this->getPermutationAttribute(0)) ;
-	DartAttribute<Dart, Map2<MAP_IMPL> > n_phi_1(this, this->getPermutationInvAttribute(0)) ;
-
-	this->swapAttributes(n_phi1, n_phi_1) ;
+	MAP_IMPL::template reversePermutation<0>() ;
 }
 
 template <typename MAP_IMPL>
 void Map2<MAP_IMPL>::computeDual()
 {
-	DartAttribute<Dart, Map2<MAP_IMPL> > old_phi1(this, this->getPermutationAttribute(0)) ;
-	DartAttribute<Dart, Map2<MAP_IMPL> > old_phi_1(this, this->getPermutationInvAttribute(0)) ;
-
 	DartAttribute<Dart, Map2<MAP_IMPL> > new_phi1 = this->template addAttribute<Dart, DART, Map2<MAP_IMPL> >("new_phi1") ;
 	DartAttribute<Dart, Map2<MAP_IMPL> > new_phi_1 = this->template addAttribute<Dart, DART, Map2<MAP_IMPL> >("new_phi_1") ;
 
@@ -1280,8 +1299,7 @@ void Map2<MAP_IMPL>::computeDual()
 		new_phi_1[dd] = d ;
 	}
 
-	this->swapAttributes(old_phi1, new_phi1) ;
-	this->swapAttributes(old_phi_1, new_phi_1) ;
+	MAP_IMPL::template replacePermutation<0>(new_phi1.getDataVector(), new_phi_1.getDataVector()) ;
 
 	this->removeAttribute(new_phi1) ;
 	this->removeAttribute(new_phi_1) ;
@@ -0,0 +1,201 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#ifndef __BINARY_STREAM__
+#define __BINARY_STREAM__
+
+#include <iostream>
+#include <vector>
+#include <zlib.h>
+
+#include "Utils/dll.h"
+
+namespace CGoGN
+{
+
+namespace Utils
+{
+
+class ThreadPool;
+
+/**
+* encodings of the binary files (maps, containers)
+*/
+enum BinaryFormat
+{
+	BIN_GZIP = 0,	///< gzip (readable by gzstream), frames deflated in parallel
+	BIN_RAW,		///< no compression, large blocks written / read with one system call
+	BIN_LZ4			///< frames compressed with LZ4 (CGoGN built with CGoGN_WITH_LZ4)
+};
+
+/**
+* Stream buffer of binary files, the backend is chosen when opening for writing
+* and detected from the first bytes of the file when opening for reading.
+* Compressed backends cut the data in independent frames of 1MB that are
+* compressed (LZ4 frames are also decompressed) by waves, one frame per task
+* of the thread pool:
+* - gzip: each frame is a gzip member, the file is read with zlib as one gzip stream
+* - lz4: "CGoGNLZ4" followed by the frames [raw size, compressed size, data]
+* - raw: the data, written with pwrite and read with readv; blocks larger than
+*   the buffer go directly from / to the memory of the caller
+* As gzstreambuf, a buffer is used either for reading or for writing.
+*/
+class CGoGN_UTILS_API BinaryStreamBuf : public std::streambuf
+{
+protected:
+	BinaryFormat m_format;
+	int m_mode;
+	bool m_opened;
+
+	/// file descriptor (raw & lz4, and gzip writing)
+	int m_fd;
+	/// zlib file (gzip reading)
+	gzFile m_gzFile;
+	/// position of next write
+	long long m_offset;
+
+	ThreadPool* m_pool;
+	unsigned int m_nbWorkers;
+
+	/// frame of the put / get area
+	std::vector<char> m_buffer;
+
+	/// frames waiting for compression / decompressed frames not yet read
+	std::vector< std::vector<char> > m_frames;
+	/// compressed frames
+	std::vector< std::vector<char> > m_packed;
+	std::vector<unsigned int> m_sizes;
+	std::vector<unsigned int> m_packedSizes;
+	unsigned int m_nbFrames;
+	unsigned int m_currentFrame;
+
+	BinaryStreamBuf(const BinaryStreamBuf&);
+	BinaryStreamBuf& operator=(const BinaryStreamBuf&);
+
+	unsigned int waveSize() const;
+
+	/// run task(i) for i in [0,nb[ on the pool
+	void parallelFrames(unsigned int nb, void (BinaryStreamBuf::*task)(unsigned int));
+
+	bool writeData(const char* data, std::size_t nb);
+
+	/// write the put area (raw) or push it in the frames to compress
+	bool flushBuffer();
+
+	void compressFrame(unsigned int i);
+	bool writeFrames();
+
+	void decompressFrame(unsigned int i);
+	bool readFrames();
+
+	virtual int overflow(int c = EOF);
+	virtual int underflow();
+	virtual int sync();
+	virtual std::streamsize xsputn(const char* s, std::streamsize n);
+	virtual std::streamsize xsgetn(char* s, std::streamsize n);
+
+public:
+	BinaryStreamBuf();
+
+	~BinaryStreamBuf();
+
+	/**
+	* open a file
+	* @param name file name
+	* @param mode std::ios::in or std::ios::out (binary is implicit)
+	* @param format backend used for writing (ignored for reading)
+	* @param pool thread pool used to (de)compress the frames (NULL: sequential)
+	* @param nbWorkers number of workers of the pool to use (0: all)
+	* @return this or NULL if the file can not be opened
+	*/
+	BinaryStreamBuf* open(const char* name, int mode, BinaryFormat format = BIN_GZIP, ThreadPool* pool = NULL, unsigned int nbWorkers = 0);
+
+	/**
+	* flush and close the file
+	*/
+	BinaryStreamBuf* close();
+
+	bool is_open() const { return m_opened; }
+
+	BinaryFormat format() const { return m_format; }
+};
+
+class CGoGN_UTILS_API BinaryStreamBase : virtual public std::ios
+{
+protected:
+	BinaryStreamBuf buf;
+
+public:
+	BinaryStreamBase() { init(&buf); }
+	~BinaryStreamBase();
+	void open(const char* name, int mode, BinaryFormat format, ThreadPool* pool, unsigned int nbWorkers);
+	void close();
+	BinaryStreamBuf* rdbuf() { return &buf; }
+	BinaryFormat format() const { return buf.format(); }
+};
+
+/**
+* input file stream of any binary format (detected at opening)
+*/
+class CGoGN_UTILS_API BinaryIStream : public BinaryStreamBase, public std::istream
+{
+public:
+	BinaryIStream() : std::istream(&buf) {}
+	BinaryIStream(const char* name, int mode = std::ios::in, ThreadPool* pool = NULL, unsigned int nbWorkers = 0) :
+		std::istream(&buf)
+	{
+		BinaryStreamBase::open(name, mode, BIN_GZIP, pool, nbWorkers);
+	}
+	BinaryStreamBuf* rdbuf() { return BinaryStreamBase::rdbuf(); }
+	void open(const char* name, int mode = std::ios::in, ThreadPool* pool = NULL, unsigned int nbWorkers = 0)
+	{
+		BinaryStreamBase::open(name, mode, BIN_GZIP, pool, nbWorkers);
+	}
+};
+
+/**
+* output file stream with the chosen binary format
+*/
+class CGoGN_UTILS_API BinaryOStream : public BinaryStreamBase, public std::ostream
+{
+public:
+	BinaryOStream() : std::ostream(&buf) {}
+	BinaryOStream(const char* name, int mode = std::ios::out, BinaryFormat format = BIN_GZIP, ThreadPool* pool = NULL, unsigned int nbWorkers = 0) :
+		std::ostream(&buf)
+	{
+		BinaryStreamBase::open(name, mode, format, pool, nbWorkers);
+	}
+	BinaryStreamBuf* rdbuf() { return BinaryStreamBase::rdbuf(); }
+	void open(const char* name, int mode = std::ios::out, BinaryFormat format = BIN_GZIP, ThreadPool* pool = NULL, unsigned int nbWorkers = 0)
+	{
+		BinaryStreamBase::open(name, mode, format, pool, nbWorkers);
+	}
+};
+
+}
+
+}
+
+#endif
@@ -27,16 +27,69 @@
 
 
 #include <fstream>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <functional>
 
 namespace CGoGN
 {
 namespace Utils
 {
 
-void zlibVTUWriteCompressed( unsigned char* input, unsigned int nbBytes, std::ofstream& fout);
+class ThreadPool;
+
+/**
+* function that copies the bytes [offset, offset+nbBytes[ of the data to compress in dest
+* (called concurrently on different ranges)
+*/
+typedef std::function<void (unsigned int offset, unsigned int nbBytes, unsigned char* dest)> GatherFunction;
+
+/**
+* gather function of the array of elements of type T whose element k is value(k)
+*/
+template <typename T, typename VALUE>
+GatherFunction gatherElements(VALUE value)
+{
+	return [value] (unsigned int offset, unsigned int nbBytes, unsigned char* dest)
+	{
+		unsigned int k = offset / sizeof(T);
+		unsigned int skip = offset % sizeof(T);
+		while (nbBytes > 0)
+		{
+			T v = value(k++);
+			unsigned int n = std::min(nbBytes, (unsigned int)(sizeof(T)) - skip);
+			memcpy(dest, reinterpret_cast<const unsigned char*>(&v) + skip, n);
+			dest += n;
+			nbBytes -= n;
+			skip = 0;
+		}
+	};
+}
+
+/**
+* write data in the compressed format of VTK XML files (vtkZLibDataCompressor, UInt32 header):
+* header [nbBlocks, blockSize, lastBlockSize, compressedSize of each block] followed by
+* the blocks of 256KB of data, each deflated independently (in parallel)
+* @param input the data
+* @param nbBytes size of data
+* @param fout output file
+* @param level compression level (1: fast, 9: best)
+* @param pool thread pool used for the blocks (NULL: sequential)
+* @param nbWorkers number of workers of the pool to use (0: all)
+* @return number of bytes written
+*/
+unsigned int zlibVTUWriteCompressed(const unsigned char* input, unsigned int nbBytes, std::ofstream& fout, int level = 6, ThreadPool* pool = NULL, unsigned int nbWorkers = 0);
+
+/**
+* same as above, the data are not contiguous: each block is gathered when it is compressed
+* @param nbBytes size of data
+* @param gather function that copies a range of data
+* @param fout output file
+*/
+unsigned int zlibVTUWriteCompressed(unsigned int nbBytes, const GatherFunction& gather, FILE* fout, int level = 6, ThreadPool* pool = NULL, unsigned int nbWorkers = 0);
 
 }
 }
 
 #endif
-
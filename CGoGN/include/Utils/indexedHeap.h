@@ -0,0 +1,169 @@
+/*******************************************************************************
+ * CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+ * version 0.1                                                                  *
+ * Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+ *                                                                              *
+ * This library is free software; you can redistribute it and/or modify it      *
+ * under the terms of the GNU Lesser General Public License as published by the *
+ * Free Software Foundation; either version 2.1 of the License, or (at your     *
+ * option) any later version.                                                   *
+ *                                                                              *
+ * This library is distributed in the hope that it will be useful, but WITHOUT  *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+ * for more details.                                                            *
+ *                                                                              *
+ * You should have received a copy of the GNU Lesser General Public License     *
+ * along with this library; if not, write to the Free Software Foundation,      *
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+ *                                                                              *
+ * Web site: http://cgogn.unistra.fr/                                           *
+ * Contact information: cgogn@unistra.fr                                        *
+ *                                                                              *
+ *******************************************************************************/
+
+#ifndef __INDEXED_HEAP_H__
+#define __INDEXED_HEAP_H__
+
+#include <vector>
+#include <utility>
+#include <cassert>
+#include <cstddef>
+
+namespace CGoGN
+{
+
+namespace Utils
+{
+
+/**
+ * Priority queue of (key, value) pairs stored in a d-ary heap (ARITY children per node)
+ * with stable handles, used in place of a std::multimap<KEY, VALUE>:
+ * - insert returns a handle (iterator) that stays valid until the element is erased
+ * - begin() is the element of smallest key, the first inserted one among equal keys
+ *   (the order of a multimap, so that the results do not change)
+ * - erase and update (in place change of the key) of an element given by its handle
+ * No allocation is done once the heap has reached its maximal size
+ * (the slots of the erased elements are reused).
+ */
+template <typename KEY, typename VALUE, unsigned int ARITY = 4>
+class IndexedHeap
+{
+public:
+	typedef std::pair<KEY, VALUE> value_type ;
+
+	static const unsigned int NONE = 0xffffffff ;
+
+	/**
+	 * handle of an element (only gives a const access: use update to change the key)
+	 */
+	class iterator
+	{
+		friend class IndexedHeap<KEY, VALUE, ARITY> ;
+
+		const IndexedHeap<KEY, VALUE, ARITY>* m_heap ;
+		unsigned int m_slot ;
+
+		iterator(const IndexedHeap<KEY, VALUE, ARITY>* h, unsigned int s) : m_heap(h), m_slot(s) {}
+
+	public:
+		iterator() : m_heap(NULL), m_slot(NONE) {}
+
+		inline const value_type& operator*() const { return m_heap->m_values[m_slot] ; }
+		inline const value_type* operator->() const { return &(m_heap->m_values[m_slot]) ; }
+
+		inline bool operator==(const iterator& it) const { return m_slot == it.m_slot ; }
+		inline bool operator!=(const iterator& it) const { return m_slot != it.m_slot ; }
+
+		/// index of the element, in [0, nbSlots()[
+		inline unsigned int slot() const { return m_slot ; }
+	} ;
+
+protected:
+	struct Node
+	{
+		KEY key ;
+		unsigned long long order ;	// insertion order (to break ties as a multimap)
+		unsigned int slot ;
+	} ;
+
+	/// the heap (keys are copied in the nodes to avoid an indirection when comparing)
+	std::vector<Node> m_nodes ;
+	/// value of each slot
+	std::vector<value_type> m_values ;
+	/// position of each slot in the heap (NONE for free slots)
+	std::vector<unsigned int> m_position ;
+	std::vector<unsigned int> m_freeSlots ;
+	unsigned long long m_order ;
+
+	inline bool less(const Node& a, const Node& b) const
+	{
+		if (a.key < b.key) return true ;
+		if (b.key < a.key) return false ;
+		return a.order < b.order ;
+	}
+
+	inline void place(const Node& n, unsigned int pos)
+	{
+		m_nodes[pos] = n ;
+		m_position[n.slot] = pos ;
+	}
+
+	void siftUp(unsigned int pos) ;
+
+	void siftDown(unsigned int pos) ;
+
+	/// move the node at pos to its place
+	inline void fix(unsigned int pos)
+	{
+		if (pos > 0 && less(m_nodes[pos], m_nodes[(pos - 1) / ARITY]))
+			siftUp(pos) ;
+		else
+			siftDown(pos) ;
+	}
+
+public:
+	IndexedHeap() : m_order(0) {}
+
+	/**
+	 * insert an element
+	 * @return the handle of the element
+	 */
+	iterator insert(const value_type& kv) ;
+
+	/**
+	 * remove an element
+	 */
+	void erase(iterator it) ;
+
+	/**
+	 * change the key of an element, which is then ordered as if it had been removed and inserted again
+	 */
+	void update(iterator it, const KEY& key) ;
+
+	/**
+	 * element of smallest key (end() if empty)
+	 */
+	inline iterator begin() const { return m_nodes.empty() ? end() : iterator(this, m_nodes[0].slot) ; }
+
+	inline iterator end() const { return iterator(this, NONE) ; }
+
+	inline bool empty() const { return m_nodes.empty() ; }
+
+	inline unsigned int size() const { return (unsigned int)(m_nodes.size()) ; }
+
+	/// number of slots (maximal number of elements reached)
+	inline unsigned int nbSlots() const { return (unsigned int)(m_values.size()) ; }
+
+	void clear() ;
+
+	void reserve(unsigned int nb) ;
+} ;
+
+} // namespace Utils
+
+} // namespace CGoGN
+
+#include "Utils/indexedHeap.hpp"
+
+#endif
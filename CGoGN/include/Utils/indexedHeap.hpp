@@ -0,0 +1,154 @@
+/*******************************************************************************
+ * CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+ * version 0.1                                                                  *
+ * Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+ *                                                                              *
+ * This library is free software; you can redistribute it and/or modify it      *
+ * under the terms of the GNU Lesser General Public License as published by the *
+ * Free Software Foundation; either version 2.1 of the License, or (at your     *
+ * option) any later version.                                                   *
+ *                                                                              *
+ * This library is distributed in the hope that it will be useful, but WITHOUT  *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+ * for more details.                                                            *
+ *                                                                              *
+ * You should have received a copy of the GNU Lesser General Public License     *
+ * along with this library; if not, write to the Free Software Foundation,      *
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+ *                                                                              *
+ * Web site: http://cgogn.unistra.fr/                                           *
+ * Contact information: cgogn@unistra.fr                                        *
+ *                                                                              *
+ *******************************************************************************/
+
+namespace CGoGN
+{
+
+namespace Utils
+{
+
+template <typename KEY, typename VALUE, unsigned int ARITY>
+const unsigned int IndexedHeap<KEY, VALUE, ARITY>::NONE ;
+
+template <typename KEY, typename VALUE, unsigned int ARITY>
+void IndexedHeap<KEY, VALUE, ARITY>::siftUp(unsigned int pos)
+{
+	Node n = m_nodes[pos] ;
+	while (pos > 0)
+	{
+		unsigned int parent = (pos - 1) / ARITY ;
+		if (!less(n, m_nodes[parent]))
+			break ;
+		place(m_nodes[parent], pos) ;
+		pos = parent ;
+	}
+	place(n, pos) ;
+}
+
+template <typename KEY, typename VALUE, unsigned int ARITY>
+void IndexedHeap<KEY, VALUE, ARITY>::siftDown(unsigned int pos)
+{
+	const unsigned int nb = (unsigned int)(m_nodes.size()) ;
+	Node n = m_nodes[pos] ;
+	while (true)
+	{
+		unsigned int first = ARITY * pos + 1 ;
+		if (first >= nb)
+			break ;
+		unsigned int last = (first + ARITY < nb) ? first + ARITY : nb ;
+		unsigned int best = first ;
+		for (unsigned int c = first + 1; c < last; ++c)
+		{
+			if (less(m_nodes[c], m_nodes[best]))
+				best = c ;
+		}
+		if (!less(m_nodes[best], n))
+			break ;
+		place(m_nodes[best], pos) ;
+		pos = best ;
+	}
+	place(n, pos) ;
+}
+
+template <typename KEY, typename VALUE, unsigned int ARITY>
+typename IndexedHeap<KEY, VALUE, ARITY>::iterator IndexedHeap<KEY, VALUE, ARITY>::insert(const value_type& kv)
+{
+	unsigned int slot ;
+	if (m_freeSlots.empty())
+	{
+		slot = (unsigned int)(m_values.size()) ;
+		m_values.push_back(kv) ;
+		m_position.push_back(NONE) ;
+	}
+	else
+	{
+		slot = m_freeSlots.back() ;
+		m_freeSlots.pop_back() ;
+		m_values[slot] = kv ;
+	}
+
+	Node n ;
+	n.key = kv.first ;
+	n.order = m_order++ ;
+	n.slot = slot ;
+	m_nodes.push_back(n) ;
+	m_position[slot] = (unsigned int)(m_nodes.size()) - 1 ;
+	siftUp((unsigned int)(m_nodes.size()) - 1) ;
+
+	return iterator(this, slot) ;
+}
+
+template <typename KEY, typename VALUE, unsigned int ARITY>
+void IndexedHeap<KEY, VALUE, ARITY>::erase(iterator it)
+{
+	assert(it.m_slot < m_position.size() && m_position[it.m_slot] != NONE) ;
+
+	unsigned int pos = m_position[it.m_slot] ;
+	m_position[it.m_slot] = NONE ;
+	m_freeSlots.push_back(it.m_slot) ;
+
+	unsigned int last = (unsigned int)(m_nodes.size()) - 1 ;
+	if (pos != last)
+	{
+		place(m_nodes[last], pos) ;
+		m_nodes.pop_back() ;
+		fix(pos) ;
+	}
+	else
+		m_nodes.pop_back() ;
+}
+
+template <typename KEY, typename VALUE, unsigned int ARITY>
+void IndexedHeap<KEY, VALUE, ARITY>::update(iterator it, const KEY& key)
+{
+	assert(it.m_slot < m_position.size() && m_position[it.m_slot] != NONE) ;
+
+	unsigned int pos = m_position[it.m_slot] ;
+	m_values[it.m_slot].first = key ;
+	m_nodes[pos].key = key ;
+	m_nodes[pos].order = m_order++ ;
+	fix(pos) ;
+}
+
+template <typename KEY, typename VALUE, unsigned int ARITY>
+void IndexedHeap<KEY, VALUE, ARITY>::clear()
+{
+	m_nodes.clear() ;
+	m_values.clear() ;
+	m_position.clear() ;
+	m_freeSlots.clear() ;
+	m_order = 0 ;
+}
+
+template <typename KEY, typename VALUE, unsigned int ARITY>
+void IndexedHeap<KEY, VALUE, ARITY>::reserve(unsigned int nb)
+{
+	m_nodes.reserve(nb) ;
+	m_values.reserve(nb) ;
+	m_position.reserve(nb) ;
+}
+
+} // namespace Utils
+
+} // namespace CGoGN
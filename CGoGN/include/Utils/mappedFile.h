@@ -0,0 +1,111 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef __MAPPED_FILE__
+#define __MAPPED_FILE__
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+#include "Utils/dll.h"
+
+namespace CGoGN
+{
+
+namespace Utils
+{
+
+/**
+* File mapped in memory (whole file, private mapping).
+* The file is opened read only and never modified: pages written through
+* data() are private copies. The pages are read from the file on demand,
+* so only the part of the file in use occupies memory.
+* Without mmap (WIN32) the file is read in a buffer.
+*/
+class CGoGN_UTILS_API MappedFile
+{
+protected:
+	char* m_data;
+	std::size_t m_size;
+	bool m_mapped;
+
+	/// buffer used when the file can not be mapped
+	std::vector<char> m_buffer;
+
+	MappedFile(const MappedFile&);
+	MappedFile& operator=(const MappedFile&);
+
+public:
+	MappedFile();
+
+	/**
+	* destructor: unmap the file
+	*/
+	~MappedFile();
+
+	/**
+	* map a file (an already mapped file is closed before)
+	* @param filename name of file
+	* @return false if the file can not be opened or is empty
+	*/
+	bool open(const std::string& filename);
+
+	/**
+	* unmap the file
+	*/
+	void close();
+
+	bool isOpen() const { return m_data != NULL; }
+
+	/**
+	* true if the data are mapped (false if read in a buffer)
+	*/
+	bool isMapped() const { return m_mapped; }
+
+	/**
+	* size of the file in bytes
+	*/
+	std::size_t size() const { return m_size; }
+
+	const char* data() const { return m_data; }
+
+	char* data() { return m_data; }
+
+	/**
+	* advise that the range [offset, offset+length[ will be read soon (read ahead)
+	*/
+	void willNeed(std::size_t offset, std::size_t length) const;
+
+	/**
+	* advise that the range [offset, offset+length[ will not be read again soon:
+	* its pages are the first to be reclaimed (the data are kept)
+	*/
+	void dontNeed(std::size_t offset, std::size_t length) const;
+};
+
+}
+}
+
+#endif
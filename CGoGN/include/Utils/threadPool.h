@@ -0,0 +1,147 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#ifndef __THREAD_POOL__
+#define __THREAD_POOL__
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <deque>
+#include <vector>
+#include <functional>
+
+#include "Utils/dll.h"
+
+namespace CGoGN
+{
+
+namespace Utils
+{
+
+/**
+* Persistent pool of std::thread workers with work stealing.
+* Each worker owns a deque of task indices: it pops its own tasks from the
+* front and, when empty, steals from the back of the deques of the others.
+* Workers sleep between two calls to exec, so no thread is created
+* or joined per call.
+*/
+class CGoGN_UTILS_API ThreadPool
+{
+public:
+	/// task function: (task index, worker index in [1,nbWorkers])
+	typedef std::function<void (unsigned int, unsigned int)> TaskFunction;
+
+protected:
+	struct Worker
+	{
+		std::thread thread;
+		std::deque<unsigned int> tasks;
+		std::mutex mutex;
+	};
+
+	std::vector<Worker*> m_workers;
+
+	/// number of workers that take part to the current exec
+	std::atomic<unsigned int> m_nbActive;
+
+	/// function of the current exec
+	const TaskFunction* m_func;
+
+	/// number of tasks not yet finished
+	std::atomic<unsigned int> m_pending;
+
+	/// number of workers woken by the current exec that have not yet left runTasks
+	unsigned int m_busy;
+
+	/// incremented at each exec to wake up the workers
+	unsigned int m_generation;
+	bool m_stop;
+
+	std::mutex m_protect;
+	std::condition_variable m_condWork;
+	std::condition_variable m_condDone;
+
+	/// serialize the calls to exec / reserve from different threads
+	std::mutex m_execMutex;
+
+	void workerLoop(unsigned int w, unsigned int seenGeneration);
+
+	bool popTask(unsigned int w, unsigned int& task);
+
+	bool stealTask(unsigned int w, unsigned int& task);
+
+	void runTasks(unsigned int w);
+
+public:
+	/**
+	* constructor
+	* @param nbWorkers number of worker threads to launch
+	*/
+	ThreadPool(unsigned int nbWorkers);
+
+	/**
+	* destructor: wake up and join all workers
+	*/
+	~ThreadPool();
+
+	/**
+	* number of worker threads
+	*/
+	inline unsigned int nbWorkers() const { return (unsigned int)(m_workers.size()); }
+
+	/**
+	* std::thread::id of a worker (for registration in maps)
+	* @param w index of worker in [0,nbWorkers-1]
+	*/
+	inline std::thread::id getThreadId(unsigned int w) const { return m_workers[w]->thread.get_id(); }
+
+	/**
+	* @return index of calling thread in [1,nbWorkers] if it is a worker of the pool, 0 else
+	*/
+	unsigned int currentWorker() const;
+
+	/**
+	* launch new workers if there are less than nb
+	* (does nothing if called from a worker of the pool)
+	*/
+	void reserve(unsigned int nb);
+
+	/**
+	* execute func on each task index in [0,nbTasks[ and wait for completion.
+	* Tasks are dealt in contiguous packs to the first nbActive workers,
+	* which steal from each other when they run out of work.
+	* If called from a worker of the pool, tasks are executed inline.
+	* @param nbTasks number of tasks
+	* @param func function called with (task, worker)
+	* @param nbActive number of workers to use (0: all)
+	*/
+	void exec(unsigned int nbTasks, const TaskFunction& func, unsigned int nbActive = 0);
+};
+
+}
+}
+
+#endif
@@ -25,6 +25,7 @@
 #define CGoGN_ALGO_DLL_EXPORT 1
 
 #include "Algo/Histogram/histogram.h"
+#include "Topology/generic/reduction.h"
 
 
 namespace CGoGN
@@ -58,7 +59,7 @@ void Histogram::initDataConvert(const AttributeConvertGen& conv)
 	m_hcolmap.setMax(m_max);
 }
 
-void Histogram::populateHisto(unsigned int nbclasses)
+void Histogram::initClasses(unsigned int nbclasses)
 {
 	//compute nb classes if necesary
 	if (nbclasses == 0)
@@ -70,6 +71,25 @@ void Histogram::populateHisto(unsigned int nbclasses)
 
 	//compute width interv
 	m_interWidth = (m_max-m_min)/double(m_nbclasses);
+}
+
+void Histogram::updatePopulations()
+{
+    m_maxBar = 0;
+    for (unsigned int i = 0; i<m_nbclasses; ++i)
+    {
+    	if (m_populations[i] > m_maxBar)
+    		m_maxBar = m_populations[i];
+    }
+
+    // apply area correction on quantile if necessary
+    if (m_pop_quantiles.size() != 0 )
+       	quantilesAreaCorrection();
+}
+
+void Histogram::populateHisto(unsigned int nbclasses)
+{
+	initClasses(nbclasses);
 
 	// init to zero
 	m_populations.resize(m_nbclasses);
@@ -83,19 +103,40 @@ void Histogram::populateHisto(unsigned int nbclasses)
 		if (c != 0xffffffff)
 			m_populations[c]++;
 	}
-    m_maxBar = 0;
-    for (unsigned int i = 0; i<m_nbclasses; ++i)
-    {
-    	if (m_populations[i] > m_maxBar)
-    		m_maxBar = m_populations[i];
-    }
 
-    // apply area correction on quantile if necessary
-    if (m_pop_quantiles.size() != 0 )
-       	quantilesAreaCorrection();
+	updatePopulations();
+}
 
+namespace Parallel
+{
+
+void populateHisto(Histogram& histo, unsigned int nbclasses)
+{
+	histo.initClasses(nbclasses);
+
+	// whichClass needs the number of populations
+	histo.m_populations.assign(histo.m_nbclasses, 0);
+
+	// each task counts its part of the data, the counts are then summed
+	const std::vector<std::pair<double,unsigned int> >& data = histo.m_dataIdx;
+	histo.m_populations = CGoGN::Parallel::reduce_range(uint32(data.size()), std::vector<unsigned int>(histo.m_nbclasses, 0),
+		[&] (std::vector<unsigned int>& pop, unsigned int i)
+		{
+			unsigned int c = histo.whichClass(data[i].first);
+			if (c != 0xffffffff)
+				pop[c]++;
+		},
+		[] (std::vector<unsigned int>& a, const std::vector<unsigned int>& b)
+		{
+			for (unsigned int i = 0; i < a.size(); ++i)
+				a[i] += b[i];
+		});
+
+	histo.updatePopulations();
 }
 
+} // namespace Parallel
+
 void Histogram::populateQuantiles(unsigned int nbquantiles)
 {
 	if (!m_sorted)
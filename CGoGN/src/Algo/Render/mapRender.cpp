@@ -39,21 +39,162 @@ namespace Render
 namespace GL2
 {
 
-MapRender::MapRender()
+MapRender::MapRender() :
+	m_triangleTable(NULL),
+	m_vertexCacheSize(0)
 {
 	glGenBuffers(SIZE_BUFFER, m_indexBuffers) ;
 	for(unsigned int i = 0; i < SIZE_BUFFER; ++i)
 	{
 		m_nbIndices[i] = 0 ;
+		m_currentSize[i] = 0 ;
 		m_indexBufferUpToDate[i] = false;
 	}
 }
 
 MapRender::~MapRender()
 {
+	delete m_triangleTable;
 	glDeleteBuffers(4, m_indexBuffers);
 }
 
+void MapRender::TriangleTable::releaseSlot(unsigned int slot)
+{
+	unsigned int b = m_slotBegin[slot];
+	unsigned int e = b + m_slotNb[slot];
+	// degenerated triangles are not rasterized
+	if (b < e)
+	{
+		std::fill(m_indices.begin() + b, m_indices.begin() + e, m_indices[b]);
+		m_modified.push_back(std::make_pair(b, e));
+	}
+	m_nbDeadIndices += m_slotNb[slot];
+	++m_slotGen[slot];
+	m_freeSlots[m_slotNb[slot]].push_back(slot);
+}
+
+unsigned int MapRender::TriangleTable::newSlot(unsigned int nb)
+{
+	std::map<unsigned int, std::vector<unsigned int> >::iterator it = m_freeSlots.find(nb);
+	if (it != m_freeSlots.end())
+	{
+		unsigned int slot = it->second.back();
+		it->second.pop_back();
+		if (it->second.empty())
+			m_freeSlots.erase(it);
+		m_nbDeadIndices -= nb;
+		return slot;
+	}
+
+	unsigned int slot = (unsigned int)(m_slotBegin.size());
+	m_slotBegin.push_back((unsigned int)(m_indices.size()));
+	m_slotNb.push_back(nb);
+	m_slotGen.push_back(0);
+	m_indices.resize(m_indices.size() + nb);
+	return slot;
+}
+
+void MapRender::TriangleTable::compact()
+{
+	std::vector<bool> released(m_slotBegin.size(), false);
+	for (std::map<unsigned int, std::vector<unsigned int> >::const_iterator it = m_freeSlots.begin(); it != m_freeSlots.end(); ++it)
+		for (std::vector<unsigned int>::const_iterator s = it->second.begin(); s != it->second.end(); ++s)
+			released[*s] = true;
+
+	// slots are numbered in the order of their indices: the live ones are moved down
+	std::vector<unsigned int> newSlots(m_slotBegin.size(), EMBNULL);
+	unsigned int nbSlots = 0;
+	unsigned int nbIndices = 0;
+	for (unsigned int s = 0; s < m_slotBegin.size(); ++s)
+	{
+		if (released[s])
+			continue;
+		std::copy(m_indices.begin() + m_slotBegin[s], m_indices.begin() + m_slotBegin[s] + m_slotNb[s], m_indices.begin() + nbIndices);
+		m_slotBegin[nbSlots] = nbIndices;
+		m_slotNb[nbSlots] = m_slotNb[s];
+		nbIndices += m_slotNb[s];
+		newSlots[s] = nbSlots++;
+	}
+	m_indices.resize(nbIndices);
+	m_slotBegin.resize(nbSlots);
+	m_slotNb.resize(nbSlots);
+
+	for (std::vector< std::pair<unsigned int, unsigned int> >::iterator it = m_dartSlot.begin(); it != m_dartSlot.end(); ++it)
+	{
+		if (it->first != EMBNULL && m_slotGen[it->first] == it->second)
+			*it = std::make_pair(newSlots[it->first], 0u);
+		else
+			it->first = EMBNULL;
+	}
+	m_slotGen.assign(nbSlots, 0u);
+
+	m_freeSlots.clear();
+	m_nbDeadIndices = 0;
+	m_allModified = true;
+}
+
+std::vector< std::pair<unsigned int, unsigned int> > MapRender::TriangleTable::modifiedRanges() const
+{
+	std::vector< std::pair<unsigned int, unsigned int> > ranges;
+	if (m_allModified)
+	{
+		if (!m_indices.empty())
+			ranges.push_back(std::make_pair(0u, (unsigned int)(m_indices.size())));
+		return ranges;
+	}
+
+	std::vector< std::pair<unsigned int, unsigned int> > modified(m_modified);
+	std::sort(modified.begin(), modified.end());
+	for (std::vector< std::pair<unsigned int, unsigned int> >::const_iterator it = modified.begin(); it != modified.end(); ++it)
+	{
+		if (it->first == it->second)
+			continue;
+		if (!ranges.empty() && it->first <= ranges.back().second)
+			ranges.back().second = std::max(ranges.back().second, it->second);
+		else
+			ranges.push_back(*it);
+	}
+	return ranges;
+}
+
+void MapRender::TriangleTable::clearModifications()
+{
+	m_modified.clear();
+	m_allModified = false;
+}
+
+void MapRender::uploadTriangleTable()
+{
+	const std::vector<GLuint>& indices = m_triangleTable->indices();
+	GLuint nb = GLuint(indices.size());
+
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_indexBuffers[TRIANGLES]);
+	if (m_triangleTable->allModified() || nb > m_currentSize[TRIANGLES])
+	{
+		// room for the triangles appended by the next updates
+		m_currentSize[TRIANGLES] = nb + nb / 4 + 3;
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_currentSize[TRIANGLES] * sizeof(GLuint), NULL, GL_DYNAMIC_DRAW);
+		if (nb > 0)
+			glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, nb * sizeof(GLuint), &(indices[0]));
+	}
+	else
+	{
+		std::vector< std::pair<unsigned int, unsigned int> > ranges = m_triangleTable->modifiedRanges();
+		for (std::vector< std::pair<unsigned int, unsigned int> >::const_iterator it = ranges.begin(); it != ranges.end(); ++it)
+			glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, it->first * sizeof(GLuint), (it->second - it->first) * sizeof(GLuint), &(indices[it->first]));
+	}
+	m_triangleTable->clearModifications();
+
+	m_nbIndices[TRIANGLES] = nb;
+	m_indexBufferUpToDate[TRIANGLES] = true;
+}
+
+void MapRender::disableIncrementalTriangles()
+{
+	delete m_triangleTable;
+	m_triangleTable = NULL;
+}
+
 void MapRender::initPrimitives(int prim, std::vector<GLuint>& tableIndices)
 {
 	m_nbIndices[prim] = uint32(tableIndices.size()) ;
@@ -0,0 +1,280 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#include "Algo/Render/vertexCache.h"
+#include "Topology/generic/dart.h"
+
+#include <cmath>
+#include <algorithm>
+
+namespace CGoGN
+{
+
+namespace Algo
+{
+
+namespace Render
+{
+
+namespace VertexCache
+{
+
+namespace
+{
+
+const unsigned int MAX_CACHE_SIZE = 64;
+const unsigned int MAX_VALENCE_SCORE = 32;
+const unsigned int NO_TRIANGLE = 0xffffffff;
+
+// scores of the vertices depending on their position in the cache
+// and on the number of triangles that still use them (Forsyth)
+class VertexScores
+{
+	std::vector<float> m_cache;
+	std::vector<float> m_valence;
+
+public:
+	VertexScores(unsigned int cacheSize) : m_cache(cacheSize), m_valence(MAX_VALENCE_SCORE)
+	{
+		for (unsigned int i = 0; i < cacheSize; ++i)
+		{
+			if (i < 3)
+				m_cache[i] = 0.75f; // the last triangle has just been drawn, do not favor it
+			else
+				m_cache[i] = std::pow(1.0f - float(i - 3) / float(cacheSize - 3), 1.5f);
+		}
+		for (unsigned int i = 0; i < MAX_VALENCE_SCORE; ++i)
+			m_valence[i] = valenceScore(i);
+	}
+
+	static float valenceScore(unsigned int nbTriangles)
+	{
+		return 2.0f / std::sqrt(float(nbTriangles));
+	}
+
+	float operator()(int cachePos, unsigned int nbTriangles) const
+	{
+		if (nbTriangles == 0)
+			return -1.0f;
+		float s = nbTriangles < MAX_VALENCE_SCORE ? m_valence[nbTriangles] : valenceScore(nbTriangles);
+		if (cachePos >= 0)
+			s += m_cache[cachePos];
+		return s;
+	}
+};
+
+}
+
+void optimizeTriangles(std::vector<unsigned int>& indices, unsigned int cacheSize)
+{
+	const unsigned int nbTris = uint32(indices.size() / 3);
+	if (nbTris == 0)
+		return;
+
+	cacheSize = std::max(4u, std::min(cacheSize, MAX_CACHE_SIZE));
+	const VertexScores score(cacheSize);
+
+	const unsigned int nbVerts = *std::max_element(indices.begin(), indices.end()) + 1;
+
+	// triangles of each vertex (CSR), the first nbActive[v] ones are not drawn yet
+	std::vector<unsigned int> begins(nbVerts + 1, 0);
+	for (unsigned int i = 0; i < 3 * nbTris; ++i)
+		++begins[indices[i] + 1];
+	for (unsigned int v = 0; v < nbVerts; ++v)
+		begins[v + 1] += begins[v];
+	std::vector<unsigned int> triangles(3 * nbTris);
+	std::vector<unsigned int> nbActive(nbVerts, 0);
+	for (unsigned int i = 0; i < 3 * nbTris; ++i)
+	{
+		unsigned int v = indices[i];
+		triangles[begins[v] + nbActive[v]++] = i / 3;
+	}
+
+	std::vector<int> cachePos(nbVerts, -1);
+	std::vector<float> vertexScore(nbVerts);
+	for (unsigned int v = 0; v < nbVerts; ++v)
+		vertexScore[v] = score(-1, nbActive[v]);
+
+	std::vector<float> triangleScore(nbTris);
+	std::vector<bool> drawn(nbTris, false);
+	unsigned int best = 0;
+	for (unsigned int t = 0; t < nbTris; ++t)
+	{
+		triangleScore[t] = vertexScore[indices[3*t]] + vertexScore[indices[3*t+1]] + vertexScore[indices[3*t+2]];
+		if (triangleScore[t] > triangleScore[best])
+			best = t;
+	}
+
+	std::vector<unsigned int> result;
+	result.reserve(3 * nbTris);
+
+	std::vector<unsigned int> cache;
+	std::vector<unsigned int> newCache;
+	cache.reserve(cacheSize + 3);
+	newCache.reserve(cacheSize + 3);
+
+	unsigned int scan = 0;
+
+	for (unsigned int nbDrawn = 0; nbDrawn < nbTris; ++nbDrawn)
+	{
+		if (best == NO_TRIANGLE)
+		{
+			// no candidate around the cache: take the next triangle not drawn
+			while (drawn[scan])
+				++scan;
+			best = scan;
+		}
+
+		drawn[best] = true;
+		const unsigned int* tri = &indices[3 * best];
+		result.insert(result.end(), tri, tri + 3);
+
+		// remove the triangle from the active lists of its vertices
+		newCache.clear();
+		for (unsigned int i = 0; i < 3; ++i)
+		{
+			unsigned int v = tri[i];
+			unsigned int* list = &triangles[begins[v]];
+			unsigned int last = --nbActive[v];
+			*std::find(list, list + last, best) = list[last];
+			list[last] = best;
+
+			if (std::find(newCache.begin(), newCache.end(), v) == newCache.end())
+				newCache.push_back(v);
+		}
+
+		// LRU cache: the vertices of the triangle go to the front
+		const unsigned int nbFront = uint32(newCache.size());
+		for (std::vector<unsigned int>::const_iterator it = cache.begin(); it != cache.end(); ++it)
+		{
+			if (std::find(newCache.begin(), newCache.begin() + nbFront, *it) == newCache.begin() + nbFront)
+				newCache.push_back(*it);
+		}
+
+		for (unsigned int i = 0; i < newCache.size(); ++i)
+		{
+			unsigned int v = newCache[i];
+			cachePos[v] = i < cacheSize ? int(i) : -1;
+			vertexScore[v] = score(cachePos[v], nbActive[v]);
+		}
+
+		// update the triangles around the cache and elect the best one
+		best = NO_TRIANGLE;
+		float bestScore = -1.0f;
+		for (unsigned int i = 0; i < newCache.size(); ++i)
+		{
+			unsigned int v = newCache[i];
+			const unsigned int* list = &triangles[begins[v]];
+			for (unsigned int j = 0; j < nbActive[v]; ++j)
+			{
+				unsigned int t = list[j];
+				float s = vertexScore[indices[3*t]] + vertexScore[indices[3*t+1]] + vertexScore[indices[3*t+2]];
+				triangleScore[t] = s;
+				if (s > bestScore && i < cacheSize)
+				{
+					bestScore = s;
+					best = t;
+				}
+			}
+		}
+
+		if (newCache.size() > cacheSize)
+			newCache.resize(cacheSize);
+		cache.swap(newCache);
+	}
+
+	indices.swap(result);
+}
+
+unsigned int nbCacheMisses(const std::vector<unsigned int>& indices, unsigned int cacheSize, unsigned int& nbVertices)
+{
+	nbVertices = 0;
+	if (indices.empty())
+		return 0;
+
+	// FIFO cache: a vertex is in the cache if less than cacheSize misses occured since its insertion
+	std::vector<unsigned int> insertion(*std::max_element(indices.begin(), indices.end()) + 1, 0);
+	unsigned int misses = 0;
+	for (std::vector<unsigned int>::const_iterator it = indices.begin(); it != indices.end(); ++it)
+	{
+		unsigned int& ins = insertion[*it];
+		if (ins == 0)
+			++nbVertices;
+		if (ins == 0 || misses - ins >= cacheSize)
+			ins = ++misses;
+	}
+	return misses;
+}
+
+float computeACMR(const std::vector<unsigned int>& indices, unsigned int cacheSize)
+{
+	if (indices.size() < 3)
+		return 0.0f;
+	unsigned int nbVertices;
+	return float(nbCacheMisses(indices, cacheSize, nbVertices)) / float(indices.size() / 3);
+}
+
+float computeATVR(const std::vector<unsigned int>& indices, unsigned int cacheSize)
+{
+	unsigned int nbVertices;
+	unsigned int misses = nbCacheMisses(indices, cacheSize, nbVertices);
+	if (nbVertices == 0)
+		return 0.0f;
+	return float(misses) / float(nbVertices);
+}
+
+void computeFetchOrder(const std::vector<unsigned int>& indices, const AttributeContainer& cont, std::vector<unsigned int>& mapOldNew)
+{
+	std::vector<unsigned int> lines;
+	lines.reserve(cont.size());
+	for (unsigned int i = cont.realBegin(); i != cont.realEnd(); cont.realNext(i))
+		lines.push_back(i);
+
+	// rank of each line in the new order
+	std::vector<unsigned int> rank(cont.realEnd(), EMBNULL);
+	unsigned int r = 0;
+	for (std::vector<unsigned int>::const_iterator it = indices.begin(); it != indices.end(); ++it)
+	{
+		if (rank[*it] == EMBNULL)
+			rank[*it] = r++;
+	}
+	for (std::vector<unsigned int>::const_iterator it = lines.begin(); it != lines.end(); ++it)
+	{
+		if (rank[*it] == EMBNULL)
+			rank[*it] = r++;
+	}
+
+	// the holes of the container stay in place
+	mapOldNew.assign(cont.realEnd(), EMBNULL);
+	for (std::vector<unsigned int>::const_iterator it = lines.begin(); it != lines.end(); ++it)
+		mapOldNew[*it] = lines[rank[*it]];
+}
+
+} // namespace VertexCache
+
+} // namespace Render
+
+} // namespace Algo
+
+} // namespace CGoGN
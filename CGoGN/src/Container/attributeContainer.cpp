@@ -43,7 +43,10 @@ namespace CGoGN
 	m_size(0),
 	m_maxSize(0),
 	m_lineCost(0),
-	m_attributes_registry_map(NULL)
+	m_attributes_registry_map(NULL),
+	m_blockAllocator(BlockAllocator::getDefault()),
+	m_blockShift(_BLOCKSIZE_SHIFT_),
+	m_blockMask(_BLOCKSIZE_ - 1)
 {
 	m_holesBlocks.reserve(512);
 }
@@ -134,8 +137,17 @@ namespace CGoGN
 	m_holesBlocks.swap(cont.m_holesBlocks);
 	m_tableBlocksWithFree.swap(cont.m_tableBlocksWithFree);
 	m_tableBlocksEmpty.swap(cont.m_tableBlocksEmpty);
+	m_blockAllocator.swap(cont.m_blockAllocator);
 
-	unsigned int temp = m_nbAttributes;
+	unsigned int temp = m_blockShift;
+	m_blockShift = cont.m_blockShift;
+	cont.m_blockShift = temp;
+
+	temp = m_blockMask;
+	m_blockMask = cont.m_blockMask;
+	cont.m_blockMask = temp;
+
+	temp = m_nbAttributes;
 	m_nbAttributes = cont.m_nbAttributes;
 	cont.m_nbAttributes = temp;
 
@@ -156,6 +168,65 @@ namespace CGoGN
 	cont.m_lineCost = temp;
 }
 
+ void AttributeContainer::setBlockAllocator(std::shared_ptr<BlockAllocator> alloc)
+{
+	m_blockAllocator = alloc;
+
+	for (std::vector<AttributeMultiVectorGen*>::iterator it = m_tableAttribs.begin(); it != m_tableAttribs.end(); ++it)
+	{
+		if ((*it) != NULL)
+			(*it)->setBlockAllocator(alloc);
+	}
+
+	for (std::vector<AttributeMultiVector<MarkerBool>*>::iterator it = m_tableMarkerAttribs.begin(); it != m_tableMarkerAttribs.end(); ++it)
+	{
+		if ((*it) != NULL)
+			(*it)->setBlockAllocator(alloc);
+	}
+}
+
+ bool AttributeContainer::setBlockSize(unsigned int nbLines)
+{
+	if ((nbLines < _BLOCKSIZE_MIN_) || (nbLines > _BLOCKSIZE_MAX_) || ((nbLines & (nbLines - 1)) != 0))
+	{
+		CGoGNerr << "setBlockSize: " << nbLines << " is not a power of two in [" << _BLOCKSIZE_MIN_ << ", " << _BLOCKSIZE_MAX_ << "]" << CGoGNendl;
+		return false;
+	}
+
+	if (!m_holesBlocks.empty())
+	{
+		CGoGNerr << "setBlockSize: not possible on a non empty container" << CGoGNendl;
+		return false;
+	}
+
+	unsigned int shift = 0;
+	while ((1u << shift) != nbLines)
+		++shift;
+
+	m_blockShift = shift;
+	m_blockMask = nbLines - 1;
+
+	for (std::vector<AttributeMultiVectorGen*>::iterator it = m_tableAttribs.begin(); it != m_tableAttribs.end(); ++it)
+	{
+		if ((*it) != NULL)
+		{
+			(*it)->setNbBlocks(0);
+			(*it)->setBlockShift(shift);
+		}
+	}
+
+	for (std::vector<AttributeMultiVector<MarkerBool>*>::iterator it = m_tableMarkerAttribs.begin(); it != m_tableMarkerAttribs.end(); ++it)
+	{
+		if ((*it) != NULL)
+		{
+			(*it)->setNbBlocks(0);
+			(*it)->setBlockShift(shift);
+		}
+	}
+
+	return true;
+}
+
  void AttributeContainer::clear(bool removeAttrib)
 {
 	m_size = 0;
@@ -269,13 +340,13 @@ namespace CGoGN
 	m_tableBlocksWithFree.clear();
 
 	// compute nb block full
-	unsigned int nbb = m_size / _BLOCKSIZE_;
+	unsigned int nbb = m_size >> m_blockShift;
 	// update holeblock
 	for (unsigned int i=0; i<nbb; ++i)
-		m_holesBlocks[i]->compressFull(_BLOCKSIZE_);
+		m_holesBlocks[i]->compressFull(getBlockSize());
 
 	//update last holeblock
-	unsigned int nbe = m_size % _BLOCKSIZE_;
+	unsigned int nbe = m_size & m_blockMask;
 	if (nbe != 0)
 	{
 		m_holesBlocks[nbb]->compressFull(nbe);
@@ -297,6 +368,39 @@ namespace CGoGN
 	}
 }
 
+void AttributeContainer::permute(const std::vector<unsigned int>& mapOldNew)
+{
+	// apply the permutation cycle by cycle: the line at the start of a cycle
+	// is successively swapped with the destinations of the cycle
+	std::vector<bool> done(realEnd(), false);
+
+	for (unsigned int start = realBegin(); start != realEnd(); realNext(start))
+	{
+		if (done[start])
+			continue;
+		done[start] = true;
+
+		unsigned int i = mapOldNew[start];
+		while (i != start)
+		{
+			for (unsigned int j = 0; j < m_tableAttribs.size(); ++j)
+			{
+				if (m_tableAttribs[j] != NULL)
+					m_tableAttribs[j]->swapElt(start, i);
+			}
+			for (unsigned int j = 0; j < m_tableMarkerAttribs.size(); ++j)
+				m_tableMarkerAttribs[j]->swapElt(start, i);
+
+			unsigned int nb = getNbRefs(start);
+			setNbRefs(start, getNbRefs(i));
+			setNbRefs(i, nb);
+
+			done[i] = true;
+			i = mapOldNew[i];
+		}
+	}
+}
+
 
 /**************************************
  *          LINES MANAGEMENT          *
@@ -344,7 +448,7 @@ namespace CGoGN
 	// if no more rooms
 	if (m_tableBlocksWithFree.empty())
 	{
-		HoleBlockRef* ptr = new HoleBlockRef();					// new block
+		HoleBlockRef* ptr = new HoleBlockRef(getBlockSize());					// new block
 		unsigned int numBlock = uint32(m_holesBlocks.size());
 		m_tableBlocksWithFree.push_back(numBlock);	// add its future position to block_free
 		m_holesBlocks.push_back(ptr);							// and add it to block table
@@ -368,7 +472,7 @@ namespace CGoGN
 		// add new element in block and compute index
 
 		unsigned int ne = ptr->newRefElt(m_maxSize);
-		return _BLOCKSIZE_ * numBlock + ne;
+		return (numBlock << m_blockShift) + ne;
 	}
 	// else
 
@@ -379,14 +483,14 @@ namespace CGoGN
 
 	// add new element in block and compute index
 	unsigned int ne = block->newRefElt(m_maxSize);
-	unsigned int index = _BLOCKSIZE_ * bf + ne;
+	unsigned int index = (bf << m_blockShift) + ne;
 
-	if (ne == _BLOCKSIZE_-1)
+	if (ne == m_blockMask)
 	{
 		if (bf == (m_holesBlocks.size()-1))
 		{
 			// we are filling the last line of capacity
-			HoleBlockRef* ptr = new HoleBlockRef();					// new block
+			HoleBlockRef* ptr = new HoleBlockRef(getBlockSize());					// new block
 			unsigned int numBlock = uint32(m_holesBlocks.size());
 			m_tableBlocksWithFree.back() = numBlock;
 			m_tableBlocksWithFree.push_back(bf);
@@ -416,8 +520,8 @@ namespace CGoGN
 
  void AttributeContainer::removeLine(unsigned int index)
 {
-	unsigned int bi = index / _BLOCKSIZE_;
-	unsigned int j = index % _BLOCKSIZE_;
+	unsigned int bi = index >> m_blockShift;
+	unsigned int j = index & m_blockMask;
 
 	HoleBlockRef* block = m_holesBlocks[bi];
 
@@ -469,7 +573,7 @@ namespace CGoGN
 	bufferui.reserve(10);
 
 	bufferui.push_back(id);
-	bufferui.push_back(_BLOCKSIZE_);
+	bufferui.push_back(getBlockSize());
 	bufferui.push_back(uint32(m_holesBlocks.size()));
 	bufferui.push_back(uint32(m_tableBlocksWithFree.size()));
 	bufferui.push_back(uint32(bufferamv.size()));
@@ -541,9 +645,10 @@ namespace CGoGN
 	m_nbUnknown = bufferui[7];
 
 
-	if (bs != _BLOCKSIZE_)
+	// the container takes the block size of the saved one
+	if ((bs != getBlockSize()) && !setBlockSize(bs))
 	{
-		CGoGNerr << "Loading unavailable, different block sizes: "<<_BLOCKSIZE_<<" / " << bs << CGoGNendl;
+		CGoGNerr << "Loading unavailable, block size: " << bs << CGoGNendl;
 		return false;
 	}
 
@@ -558,7 +663,7 @@ namespace CGoGN
 		if (itAtt == m_attributes_registry_map->end())
 		{
 			CGoGNout << "Skipping non registred attribute of type name"<< typeAtt <<CGoGNendl;
-			AttributeMultiVectorGen::skipLoadBin(fs);
+			AttributeMultiVectorGen::skipLoadBin(fs, bs);
 		}
 		else
 		{
@@ -581,7 +686,7 @@ namespace CGoGN
 	// blocks
 	for (unsigned int i = 0; i < szHB; ++i)
 	{
-		m_holesBlocks[i] = new HoleBlockRef;
+		m_holesBlocks[i] = new HoleBlockRef(bs);
 		m_holesBlocks[i]->loadBin(fs);
 	}
 
@@ -602,6 +707,8 @@ namespace CGoGN
 	m_nbUnknown = cont.m_nbUnknown;
 	m_nbAttributes = cont.m_nbAttributes;
 	m_lineCost = cont.m_lineCost;
+	m_blockShift = cont.m_blockShift;
+	m_blockMask = cont.m_blockMask;
 
 	// blocks
 	unsigned int sz = uint32(cont.m_holesBlocks.size());
@@ -635,6 +742,8 @@ namespace CGoGN
 		if (cont.m_tableAttribs[i] != NULL)
 		{
 			AttributeMultiVectorGen* ptr = cont.m_tableAttribs[i]->new_obj();
+			ptr->setBlockAllocator(m_blockAllocator);
+			ptr->setBlockShift(m_blockShift);
 			ptr->setName(cont.m_tableAttribs[i]->getName());
 			ptr->setOrbit(cont.m_tableAttribs[i]->getOrbit());
 			ptr->setIndex(uint32(m_tableAttribs.size()));
@@ -647,6 +756,8 @@ namespace CGoGN
 	for (unsigned int i = 0; i < sz; ++i)
 	{
 		AttributeMultiVector<MarkerBool>* ptr = new AttributeMultiVector<MarkerBool>;
+		ptr->setBlockAllocator(m_blockAllocator);
+		ptr->setBlockShift(m_blockShift);
 		ptr->setTypeName(cont.m_tableMarkerAttribs[i]->getTypeName());
 		ptr->setName(cont.m_tableMarkerAttribs[i]->getName());
 		ptr->setOrbit(cont.m_tableMarkerAttribs[i]->getOrbit());
@@ -797,6 +908,8 @@ namespace CGoGN
 
 	// create the new attribute
 	AttributeMultiVector<MarkerBool>* amv = new AttributeMultiVector<MarkerBool>(attribName, "MarkerBool") ;
+	amv->setBlockAllocator(m_blockAllocator) ;
+	amv->setBlockShift(m_blockShift) ;
 
 	index = uint32(m_tableMarkerAttribs.size()) ;
 	m_tableMarkerAttribs.push_back(amv) ;
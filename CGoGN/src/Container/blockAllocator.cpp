@@ -0,0 +1,190 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#define CGoGN_CONTAINER_DLL_EXPORT 1
+#include "Container/blockAllocator.h"
+
+#include <cstdlib>
+#include <cassert>
+
+#ifdef WIN32
+#include <malloc.h>
+#else
+#include <sys/mman.h>
+#endif
+
+namespace CGoGN
+{
+
+namespace
+{
+
+std::shared_ptr<BlockAllocator>& defaultAllocator()
+{
+	static std::shared_ptr<BlockAllocator> alloc(new HeapBlockAllocator);
+	return alloc;
+}
+
+std::mutex& defaultAllocatorMutex()
+{
+	static std::mutex m;
+	return m;
+}
+
+void* alignedAlloc(std::size_t alignment, std::size_t nbBytes)
+{
+#ifdef WIN32
+	return _aligned_malloc(nbBytes, alignment);
+#else
+	void* ptr = NULL;
+	if (posix_memalign(&ptr, alignment, nbBytes) != 0)
+		return NULL;
+	return ptr;
+#endif
+}
+
+void alignedFree(void* ptr)
+{
+#ifdef WIN32
+	_aligned_free(ptr);
+#else
+	free(ptr);
+#endif
+}
+
+} // namespace
+
+/**************************************
+ *           BLOCK ALLOCATOR          *
+ **************************************/
+
+void BlockAllocator::release(const std::vector<void*>& ptrs, std::size_t nbBytes)
+{
+	for (std::vector<void*>::const_iterator it = ptrs.begin(); it != ptrs.end(); ++it)
+		release(*it, nbBytes);
+}
+
+std::shared_ptr<BlockAllocator> BlockAllocator::getDefault()
+{
+	std::lock_guard<std::mutex> lock(defaultAllocatorMutex());
+	return defaultAllocator();
+}
+
+void BlockAllocator::setDefault(std::shared_ptr<BlockAllocator> alloc)
+{
+	std::lock_guard<std::mutex> lock(defaultAllocatorMutex());
+	defaultAllocator() = alloc;
+}
+
+/**************************************
+ *        HEAP BLOCK ALLOCATOR        *
+ **************************************/
+
+void* HeapBlockAllocator::allocate(std::size_t nbBytes)
+{
+	return new char[nbBytes];
+}
+
+void HeapBlockAllocator::release(void* ptr, std::size_t /*nbBytes*/)
+{
+	delete[] static_cast<char*>(ptr);
+}
+
+/**************************************
+ *       ARENA BLOCK ALLOCATOR        *
+ **************************************/
+
+ArenaBlockAllocator::ArenaBlockAllocator(bool hugePages, std::size_t slabSize):
+	m_slabSize(slabSize),
+	m_hugePages(hugePages),
+	m_current(NULL),
+	m_remaining(0),
+	m_nbBytesReserved(0)
+{}
+
+ArenaBlockAllocator::~ArenaBlockAllocator()
+{
+	for (std::vector<void*>::iterator it = m_slabs.begin(); it != m_slabs.end(); ++it)
+		alignedFree(*it);
+}
+
+void* ArenaBlockAllocator::newSlab(std::size_t nbBytes)
+{
+	void* ptr = alignedAlloc(m_slabSize, nbBytes);
+	if (ptr == NULL)
+		throw std::bad_alloc();
+#ifdef MADV_HUGEPAGE
+	if (m_hugePages)
+		madvise(ptr, nbBytes, MADV_HUGEPAGE);
+#endif
+	m_slabs.push_back(ptr);
+	m_nbBytesReserved += nbBytes;
+	return ptr;
+}
+
+void* ArenaBlockAllocator::allocate(std::size_t nbBytes)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+
+	std::size_t size = roundSize(nbBytes);
+
+	// recycle a released block
+	std::map< std::size_t, std::vector<void*> >::iterator it = m_freeBlocks.find(size);
+	if (it != m_freeBlocks.end() && !it->second.empty())
+	{
+		void* ptr = it->second.back();
+		it->second.pop_back();
+		return ptr;
+	}
+
+	// big block: its own slab
+	if (size > maxCarvedSize())
+		return newSlab(size);
+
+	// carve in the current slab
+	if (size > m_remaining)
+	{
+		m_current = static_cast<char*>(newSlab(m_slabSize));
+		m_remaining = m_slabSize;
+	}
+	void* ptr = m_current;
+	m_current += size;
+	m_remaining -= size;
+	return ptr;
+}
+
+void ArenaBlockAllocator::release(void* ptr, std::size_t nbBytes)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_freeBlocks[roundSize(nbBytes)].push_back(ptr);
+}
+
+void ArenaBlockAllocator::release(const std::vector<void*>& ptrs, std::size_t nbBytes)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	std::vector<void*>& freeBlocks = m_freeBlocks[roundSize(nbBytes)];
+	freeBlocks.insert(freeBlocks.end(), ptrs.begin(), ptrs.end());
+}
+
+} // namespace CGoGN
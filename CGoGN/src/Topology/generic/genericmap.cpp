@@ -30,6 +30,7 @@
 #include "Geometry/vector_gen.h"
 #include "Geometry/matrix.h"
 #include "Container/registered.h"
+#include "Utils/threadPool.h"
 
 #include <algorithm>
 
@@ -40,6 +41,13 @@ namespace Parallel
 {
 //int NumberOfThreads=1;
 CGoGN_TOPO_API int NumberOfThreads = getSystemNumberOfCores();
+
+Utils::ThreadPool& getThreadPool(unsigned int nbWorkers)
+{
+	static Utils::ThreadPool pool(nbWorkers);
+	pool.reserve(nbWorkers);
+	return pool;
+}
 }
 
 std::map<std::string, RegisteredBaseAttribute*>* GenericMap::m_attributes_registry_map = NULL;
@@ -66,6 +74,11 @@ GenericMap::GenericMap():
 	{
 		m_attribs[i].setOrbit(i) ;
 		m_attribs[i].setRegistry(m_attributes_registry_map) ;
+		for(unsigned int j = 0; j < NB_ORBITS; ++j)
+		{
+			m_quickLocalIncidentTraversal[i][j] = NULL ;
+			m_quickLocalAdjacentTraversal[i][j] = NULL ;
+		}
 	}
 
 	for(unsigned int i = 0; i < NB_THREADS; ++i)
@@ -142,6 +155,12 @@ GenericMap::~GenericMap()
 	{
 		if(isOrbitEmbedded(i))
 			m_attribs[i].clear(true) ;
+
+		for(unsigned int j = 0; j < NB_ORBITS; ++j)
+		{
+			delete m_quickLocalIncidentTraversal[i][j] ;
+			delete m_quickLocalAdjacentTraversal[i][j] ;
+		}
 	}
 
 	for(std::multimap<AttributeMultiVectorGen*, AttributeHandlerGen*>::iterator it = attributeHandlers.begin(); it != attributeHandlers.end(); ++it)
@@ -209,9 +228,12 @@ void GenericMap::init(bool addBoundaryMarkers)
 		m_attribs[i].clear(true) ;
 		m_embeddings[i] = NULL ;
 		m_quickTraversal[i] = NULL;
+		m_quickTraversalUpToDate[i] = true;
 
 		for(unsigned int j = 0; j < NB_ORBITS; ++j)
 		{
+			delete m_quickLocalIncidentTraversal[i][j] ;
+			delete m_quickLocalAdjacentTraversal[i][j] ;
 			m_quickLocalIncidentTraversal[i][j] = NULL ;
 			m_quickLocalAdjacentTraversal[i][j] = NULL ;
 		}
@@ -279,6 +301,31 @@ void GenericMap::swapEmbeddingContainers(unsigned int orbit1, unsigned int orbit
 //	}
 }
 
+void GenericMap::setBlockAllocator(std::shared_ptr<BlockAllocator> alloc)
+{
+	for (unsigned int i = 0; i < NB_ORBITS; ++i)
+		m_attribs[i].setBlockAllocator(alloc) ;
+}
+
+bool GenericMap::setBlockSize(unsigned int nbLines)
+{
+	for (unsigned int i = 0; i < NB_ORBITS; ++i)
+	{
+		if (m_attribs[i].nbBlocks() != 0)
+		{
+			CGoGNerr << "setBlockSize: map is not empty" << CGoGNendl ;
+			return false ;
+		}
+	}
+
+	for (unsigned int i = 0; i < NB_ORBITS; ++i)
+	{
+		if (!m_attribs[i].setBlockSize(nbLines))
+			return false ;
+	}
+	return true ;
+}
+
 void GenericMap::viewAttributesTables()
 {
 	std::cout << "======================="<< std::endl ;
@@ -407,14 +454,22 @@ void GenericMap::restore_shortcuts()
 	{
 		AttributeContainer& cont = m_attribs[orbit];
 		m_quickTraversal[orbit] = cont.getDataVector<Dart>("quick_traversal") ;
+		m_quickTraversalUpToDate[orbit] = true;
+		// the packed darts of the local traversal tables are not saved: remove the beginnings
 		for(unsigned int j = 0; j < NB_ORBITS; ++j)
 		{
+			delete m_quickLocalIncidentTraversal[orbit][j] ;
+			delete m_quickLocalAdjacentTraversal[orbit][j] ;
+			m_quickLocalIncidentTraversal[orbit][j] = NULL ;
+			m_quickLocalAdjacentTraversal[orbit][j] = NULL ;
 			std::stringstream ss;
-			ss << "quickLocalIncidentTraversal_" << j;
-			m_quickLocalIncidentTraversal[orbit][j] = cont.getDataVector< NoTypeNameAttribute<std::vector<Dart> > >(ss.str()) ;
+			ss << "quickIncidentTraversal_" << j;
+			if (cont.getAttributeIndex(ss.str()) != AttributeContainer::UNKNOWN)
+				cont.removeAttribute<unsigned int>(ss.str()) ;
 			std::stringstream ss2;
-			ss2 << "quickLocalAdjacentTraversal_" << j;
-			m_quickLocalAdjacentTraversal[orbit][j] = cont.getDataVector< NoTypeNameAttribute<std::vector<Dart> > >(ss2.str()) ;
+			ss2 << "quickAdjacentTraversal_" << j;
+			if (cont.getAttributeIndex(ss2.str()) != AttributeContainer::UNKNOWN)
+				cont.removeAttribute<unsigned int>(ss2.str()) ;
 		}
 	}
 
@@ -468,6 +523,8 @@ void GenericMap::dumpAttributesAndMarkers()
 void GenericMap::compact(bool topoOnly)
 {
 	compactTopo();
+	for (unsigned int orbit = 0; orbit < NB_ORBITS; ++orbit)
+		m_quickTraversalUpToDate[orbit] = false;
 
 	if (topoOnly)
 		return;
@@ -507,11 +564,29 @@ void GenericMap::compactOrbitContainer(unsigned int orbit, float frag)
 	}
 }
 
+void GenericMap::permuteOrbitContainer(unsigned int orbit, const std::vector<unsigned int>& mapOldNew)
+{
+	if (!isOrbitEmbedded(orbit))
+		return;
+
+	m_attribs[orbit].permute(mapOldNew);
+	for (unsigned int i = m_attribs[DART].begin(); i != m_attribs[DART].end(); m_attribs[DART].next(i))
+	{
+		unsigned int& idx = m_embeddings[orbit]->operator[](i);
+		if (idx != EMBNULL)
+			idx = mapOldNew[idx];
+	}
+}
+
 
 void GenericMap::compactIfNeeded(float frag, bool topoOnly)
 {
 	if (fragmentation(DART)< frag)
+	{
 		compactTopo();
+		for (unsigned int orbit = 0; orbit < NB_ORBITS; ++orbit)
+			m_quickTraversalUpToDate[orbit] = false;
+	}
 
 	if (topoOnly)
 		return;
@@ -555,6 +630,7 @@ void GenericMap::moveData(GenericMap &mapf)
 		this->m_attribs[i].swap(mapf.m_attribs[i]);
 		this->m_embeddings[i] = mapf.m_embeddings[i];
 		this->m_quickTraversal[i] = mapf.m_quickTraversal[i];
+		this->m_quickTraversalUpToDate[i] = mapf.m_quickTraversalUpToDate[i];
 		mapf.m_embeddings[i] = NULL ;
 		mapf.m_quickTraversal[i] = NULL;
 
@@ -33,9 +33,12 @@ namespace CGoGN
  *             SAVE & LOAD              *
  ****************************************/
 
-bool MapMono::saveMapBin(const std::string& filename) const
+bool MapMono::saveMapBin(const std::string& filename, Utils::BinaryFormat format) const
 {
-	CGoGNostream fs(filename.c_str(), std::ios::out|std::ios::binary);
+	// frames of compressed formats are compressed in parallel
+	unsigned int nbth = Parallel::NumberOfThreads;
+	Utils::ThreadPool* pool = (nbth > 1) ? &Parallel::getThreadPool(nbth - 1) : NULL;
+	CGoGNostream fs(filename.c_str(), std::ios::out|std::ios::binary, format, pool, nbth - 1);
 	if (!fs)
 	{
 		CGoGNerr << "Unable to open file for writing: " << filename << CGoGNendl;
@@ -54,8 +57,10 @@ bool MapMono::saveMapBin(const std::string& filename) const
 	memcpy(buff+32, mtc, mt.size()+1);
 	unsigned int *buffi = reinterpret_cast<unsigned int*>(buff + 64);
 	*buffi = NB_ORBITS;
+	buffi[1] = _MAPBIN_VERSION_;
+	buffi[2] = format;
 	fs.write(reinterpret_cast<const char*>(buff), 256);
-	delete buff;
+	delete[] buff;
 
 	// save all attribs
 	for (unsigned int i = 0; i < NB_ORBITS; ++i)
@@ -66,7 +71,9 @@ bool MapMono::saveMapBin(const std::string& filename) const
 
 bool MapMono::loadMapBin(const std::string& filename)
 {
-	CGoGNistream fs(filename.c_str(), std::ios::in|std::ios::binary);
+	unsigned int nbth = Parallel::NumberOfThreads;
+	Utils::ThreadPool* pool = (nbth > 1) ? &Parallel::getThreadPool(nbth - 1) : NULL;
+	CGoGNistream fs(filename.c_str(), std::ios::in|std::ios::binary, pool, nbth - 1);
 	if (!fs)
 	{
 		CGoGNerr << "Unable to open file for loading" << CGoGNendl;
@@ -114,6 +121,14 @@ bool MapMono::loadMapBin(const std::string& filename)
 		return  false;
 	}
 
+	// Check version (no version in files of version 1)
+	unsigned int version = *reinterpret_cast<unsigned int*>(buff + 68);
+	if (version != 0xFFFFFFFF && version > _MAPBIN_VERSION_)
+	{
+		CGoGNerr << "Binary file of a newer version (" << version << ")" << CGoGNendl;
+		return false;
+	}
+
 	// load attrib container
 	for (unsigned int i = 0; i < NB_ORBITS; ++i)
 	{
@@ -131,20 +146,19 @@ bool MapMono::loadMapBin(const std::string& filename)
 bool MapMono::copyFrom(const GenericMap& map)
 {
 
-	if (mapTypeName() != map.mapTypeName())
+	const MapMono* mapM = dynamic_cast<const MapMono*>(&map);
+	if (mapM == NULL || mapTypeName() != map.mapTypeName())
 	{
 		CGoGNerr << "try to copy from incompatible type map" << CGoGNendl;
 		return false;
 	}
 
-	const MapMono& mapM = reinterpret_cast<const MapMono&>(map);
-
 	// clear the map but do not insert boundary markers dart attribute
 	GenericMap::init(false);
 
 	// copy attrib containers
 	for (unsigned int i = 0; i < NB_ORBITS; ++i)
-		m_attribs[i].copyFrom(mapM.m_attribs[i]);
+		m_attribs[i].copyFrom(mapM->m_attribs[i]);
 
 	GenericMap::garbageMarkVectors();
 
@@ -51,6 +51,22 @@ void MapMulti::printMR()
 	}
 }
 
+void MapMulti::setBlockAllocator(std::shared_ptr<BlockAllocator> alloc)
+{
+	GenericMap::setBlockAllocator(alloc) ;
+	m_mrattribs.setBlockAllocator(alloc) ;
+}
+
+bool MapMulti::setBlockSize(unsigned int nbLines)
+{
+	if (m_mrattribs.nbBlocks() != 0)
+	{
+		CGoGNerr << "setBlockSize: map is not empty" << CGoGNendl ;
+		return false ;
+	}
+	return GenericMap::setBlockSize(nbLines) && m_mrattribs.setBlockSize(nbLines) ;
+}
+
 void MapMulti::initMR()
 {
 	m_mrattribs.clear(true) ;
@@ -204,9 +220,12 @@ void MapMulti::duplicateDarts(unsigned int newlevel)
  *             SAVE & LOAD              *
  ****************************************/
 
-bool MapMulti::saveMapBin(const std::string& filename) const
+bool MapMulti::saveMapBin(const std::string& filename, Utils::BinaryFormat format) const
 {
-	CGoGNostream fs(filename.c_str(), std::ios::out|std::ios::binary);
+	// frames of compressed formats are compressed in parallel
+	unsigned int nbth = Parallel::NumberOfThreads;
+	Utils::ThreadPool* pool = (nbth > 1) ? &Parallel::getThreadPool(nbth - 1) : NULL;
+	CGoGNostream fs(filename.c_str(), std::ios::out|std::ios::binary, format, pool, nbth - 1);
 	if (!fs)
 	{
 		CGoGNerr << "Unable to open file for writing: " << filename << CGoGNendl;
@@ -225,8 +244,10 @@ bool MapMulti::saveMapBin(const std::string& filename) const
 	memcpy(buff+32, mtc, mt.size()+1);
 	unsigned int *buffi = reinterpret_cast<unsigned int*>(buff + 64);
 	*buffi = NB_ORBITS;
+	buffi[1] = _MAPBIN_VERSION_;
+	buffi[2] = format;
 	fs.write(reinterpret_cast<const char*>(buff), 256);
-	delete buff;
+	delete[] buff;
 
 	// save all attribs
 	for (unsigned int i = 0; i < NB_ORBITS; ++i)
@@ -253,7 +274,9 @@ bool MapMulti::saveMapBin(const std::string& filename) const
 
 bool MapMulti::loadMapBin(const std::string& filename)
 {
-	CGoGNistream fs(filename.c_str(), std::ios::in|std::ios::binary);
+	unsigned int nbth = Parallel::NumberOfThreads;
+	Utils::ThreadPool* pool = (nbth > 1) ? &Parallel::getThreadPool(nbth - 1) : NULL;
+	CGoGNistream fs(filename.c_str(), std::ios::in|std::ios::binary, pool, nbth - 1);
 	if (!fs)
 	{
 		CGoGNerr << "Unable to open file for loading" << CGoGNendl;
@@ -312,6 +335,14 @@ bool MapMulti::loadMapBin(const std::string& filename)
 		return  false;
 	}
 
+	// Check version (no version in files of version 1)
+	unsigned int version = *reinterpret_cast<unsigned int*>(buff + 68);
+	if (version != 0xFFFFFFFF && version > _MAPBIN_VERSION_)
+	{
+		CGoGNerr << "Binary file of a newer version (" << version << ")" << CGoGNendl;
+		return false;
+	}
+
 	// load attrib container
 	for (unsigned int i = 0; i < NB_ORBITS; ++i)
 	{
@@ -0,0 +1,609 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+
+#define CGoGN_UTILS_DLL_EXPORT 1
+#include "Utils/binaryStream.h"
+#include "Utils/threadPool.h"
+#include "Utils/cgognStream.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+
+#ifdef WIN32
+#include <io.h>
+#else
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+#ifdef CGOGN_WITH_LZ4
+#include <lz4.h>
+#endif
+
+namespace CGoGN
+{
+
+namespace Utils
+{
+
+namespace
+{
+
+/// size of the frames (and of the buffer of raw files)
+const unsigned int FRAME = 1024*1024;
+
+const char LZ4_MAGIC[8] = {'C', 'G', 'o', 'G', 'N', 'L', 'Z', '4'};
+
+/// write at a position of the file
+bool writeAt(int fd, const char* data, std::size_t nb, long long offset)
+{
+	while (nb > 0)
+	{
+		unsigned int chunk = (unsigned int)(std::min(nb, std::size_t(1) << 30));
+#ifdef WIN32
+		if (_lseeki64(fd, offset, SEEK_SET) < 0)
+			return false;
+		int w = _write(fd, data, chunk);
+#else
+		ssize_t w = pwrite(fd, data, chunk, off_t(offset));
+#endif
+		if (w <= 0)
+			return false;
+		data += w;
+		nb -= w;
+		offset += w;
+	}
+	return true;
+}
+
+/// read at the current position, first in a then in b (one call, may be partial)
+long long readTwo(int fd, char* a, std::size_t na, char* b, std::size_t nb)
+{
+#ifdef WIN32
+	int r = _read(fd, a, (unsigned int)(na));
+	if (r < int(na) || nb == 0)
+		return r;
+	int r2 = _read(fd, b, (unsigned int)(nb));
+	return (r2 > 0) ? r + r2 : r;
+#else
+	struct iovec iov[2];
+	iov[0].iov_base = a;
+	iov[0].iov_len = na;
+	iov[1].iov_base = b;
+	iov[1].iov_len = nb;
+	return (long long)(readv(fd, iov, (nb > 0) ? 2 : 1));
+#endif
+}
+
+/// read nb bytes (less at the end of file)
+std::size_t readFully(int fd, char* data, std::size_t nb)
+{
+	std::size_t got = 0;
+	while (got < nb)
+	{
+		long long r = readTwo(fd, data + got, nb - got, NULL, 0);
+		if (r <= 0)
+			break;
+		got += std::size_t(r);
+	}
+	return got;
+}
+
+int openFile(const char* name, bool writing)
+{
+#ifdef WIN32
+	if (writing)
+		return _open(name, _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE);
+	return _open(name, _O_RDONLY | _O_BINARY);
+#else
+	if (writing)
+		return ::open(name, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	return ::open(name, O_RDONLY);
+#endif
+}
+
+void closeFile(int fd)
+{
+#ifdef WIN32
+	_close(fd);
+#else
+	::close(fd);
+#endif
+}
+
+} // namespace
+
+
+BinaryStreamBuf::BinaryStreamBuf():
+	m_format(BIN_GZIP), m_mode(0), m_opened(false), m_fd(-1), m_gzFile(NULL), m_offset(0),
+	m_pool(NULL), m_nbWorkers(0), m_nbFrames(0), m_currentFrame(0)
+{
+	setp(NULL, NULL);
+	setg(NULL, NULL, NULL);
+}
+
+BinaryStreamBuf::~BinaryStreamBuf()
+{
+	close();
+}
+
+unsigned int BinaryStreamBuf::waveSize() const
+{
+	if (m_pool == NULL)
+		return 1;
+	unsigned int nb = (m_nbWorkers == 0) ? m_pool->nbWorkers() : std::min(m_nbWorkers, m_pool->nbWorkers());
+	return 2 * std::max(nb, 1u);
+}
+
+void BinaryStreamBuf::parallelFrames(unsigned int nb, void (BinaryStreamBuf::*task)(unsigned int))
+{
+	if (m_pool != NULL && nb > 1)
+		m_pool->exec(nb, [this, task] (unsigned int i, unsigned int) { (this->*task)(i); }, m_nbWorkers);
+	else
+	{
+		for (unsigned int i = 0; i < nb; ++i)
+			(this->*task)(i);
+	}
+}
+
+BinaryStreamBuf* BinaryStreamBuf::open(const char* name, int mode, BinaryFormat format, ThreadPool* pool, unsigned int nbWorkers)
+{
+	if (m_opened)
+		return NULL;
+	// no append nor read/write mode
+	if ((mode & std::ios::ate) || (mode & std::ios::app) || ((mode & std::ios::in) && (mode & std::ios::out)))
+		return NULL;
+	if (!(mode & (std::ios::in | std::ios::out)))
+		return NULL;
+
+	m_mode = mode;
+	m_pool = pool;
+	m_nbWorkers = nbWorkers;
+	m_nbFrames = 0;
+	m_currentFrame = 0;
+
+	if (mode & std::ios::in)
+	{
+		m_fd = openFile(name, false);
+		if (m_fd < 0)
+			return NULL;
+
+		char magic[8];
+		std::size_t nb = readFully(m_fd, magic, 8);
+		if (nb >= 2 && (unsigned char)(magic[0]) == 0x1f && (unsigned char)(magic[1]) == 0x8b)
+		{
+			closeFile(m_fd);
+			m_fd = -1;
+			m_gzFile = gzopen(name, "rb");
+			if (m_gzFile == NULL)
+				return NULL;
+			m_format = BIN_GZIP;
+		}
+		else if (nb == 8 && memcmp(magic, LZ4_MAGIC, 8) == 0)
+		{
+#ifndef CGOGN_WITH_LZ4
+			CGoGNerr << "File " << name << " is compressed with LZ4, CGoGN is built without LZ4" << CGoGNendl;
+			closeFile(m_fd);
+			m_fd = -1;
+			return NULL;
+#endif
+			m_format = BIN_LZ4;
+		}
+		else
+		{
+			closeFile(m_fd);
+			m_fd = openFile(name, false);
+			if (m_fd < 0)
+				return NULL;
+			m_format = BIN_RAW;
+		}
+
+		m_buffer.resize(FRAME);
+		setg(&m_buffer[0], &m_buffer[0], &m_buffer[0]);
+	}
+	else
+	{
+#ifndef CGOGN_WITH_LZ4
+		if (format == BIN_LZ4)
+		{
+			CGoGNerr << "CGoGN is built without LZ4, can not write " << name << CGoGNendl;
+			return NULL;
+		}
+#endif
+		m_fd = openFile(name, true);
+		if (m_fd < 0)
+			return NULL;
+		m_format = format;
+		m_offset = 0;
+		if (m_format == BIN_LZ4 && !writeData(LZ4_MAGIC, 8))
+		{
+			closeFile(m_fd);
+			m_fd = -1;
+			return NULL;
+		}
+
+		m_buffer.resize(FRAME);
+		setp(&m_buffer[0], &m_buffer[0] + FRAME);
+	}
+
+	if (m_format != BIN_RAW)
+	{
+		unsigned int nb = waveSize();
+		m_frames.resize(nb);
+		m_packed.resize(nb);
+		m_sizes.resize(nb);
+		m_packedSizes.resize(nb);
+	}
+
+	m_opened = true;
+	return this;
+}
+
+BinaryStreamBuf* BinaryStreamBuf::close()
+{
+	if (!m_opened)
+		return NULL;
+
+	bool ok = true;
+	if (m_mode & std::ios::out)
+		ok = (sync() == 0);
+
+	if (m_gzFile != NULL)
+	{
+		ok = (gzclose(m_gzFile) == Z_OK) && ok;
+		m_gzFile = NULL;
+	}
+	if (m_fd >= 0)
+	{
+		closeFile(m_fd);
+		m_fd = -1;
+	}
+
+	m_opened = false;
+	setp(NULL, NULL);
+	setg(NULL, NULL, NULL);
+	std::vector<char>().swap(m_buffer);
+	m_frames.clear();
+	m_packed.clear();
+
+	return ok ? this : NULL;
+}
+
+bool BinaryStreamBuf::writeData(const char* data, std::size_t nb)
+{
+	if (!writeAt(m_fd, data, nb, m_offset))
+		return false;
+	m_offset += nb;
+	return true;
+}
+
+bool BinaryStreamBuf::flushBuffer()
+{
+	unsigned int nb = (unsigned int)(pptr() - pbase());
+	if (nb == 0)
+		return true;
+
+	if (m_format == BIN_RAW)
+	{
+		setp(&m_buffer[0], &m_buffer[0] + FRAME);
+		return writeData(&m_buffer[0], nb);
+	}
+
+	// the full buffer becomes a frame, the storage of the frame slot becomes the buffer
+	m_sizes[m_nbFrames] = nb;
+	m_frames[m_nbFrames].swap(m_buffer);
+	++m_nbFrames;
+	m_buffer.resize(FRAME);
+	setp(&m_buffer[0], &m_buffer[0] + FRAME);
+
+	if (m_nbFrames == m_frames.size())
+		return writeFrames();
+	return true;
+}
+
+void BinaryStreamBuf::compressFrame(unsigned int i)
+{
+	const char* src = &m_frames[i][0];
+	unsigned int size = m_sizes[i];
+	std::vector<char>& dst = m_packed[i];
+	m_packedSizes[i] = 0;	// error
+
+	if (m_format == BIN_GZIP)
+	{
+		z_stream strm;
+		memset(&strm, 0, sizeof(z_stream));
+		// windowBits 15 + 16: gzip wrapper
+		if (deflateInit2(&strm, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+			return;
+		unsigned int bound = (unsigned int)(deflateBound(&strm, size));
+		if (dst.size() < bound)
+			dst.resize(bound);
+		strm.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(src));
+		strm.avail_in = size;
+		strm.next_out = reinterpret_cast<Bytef*>(&dst[0]);
+		strm.avail_out = bound;
+		if (deflate(&strm, Z_FINISH) == Z_STREAM_END)
+			m_packedSizes[i] = (unsigned int)(strm.total_out);
+		deflateEnd(&strm);
+	}
+#ifdef CGOGN_WITH_LZ4
+	else
+	{
+		unsigned int bound = 2 * sizeof(unsigned int) + (unsigned int)(LZ4_compressBound(int(size)));
+		if (dst.size() < bound)
+			dst.resize(bound);
+		int nb = LZ4_compress_default(src, &dst[2 * sizeof(unsigned int)], int(size), int(bound - 2 * sizeof(unsigned int)));
+		if (nb <= 0)
+			return;
+		unsigned int header[2] = { size, (unsigned int)(nb) };
+		memcpy(&dst[0], header, 2 * sizeof(unsigned int));
+		m_packedSizes[i] = 2 * sizeof(unsigned int) + nb;
+	}
+#endif
+}
+
+bool BinaryStreamBuf::writeFrames()
+{
+	unsigned int nb = m_nbFrames;
+	m_nbFrames = 0;
+
+	parallelFrames(nb, &BinaryStreamBuf::compressFrame);
+
+	for (unsigned int i = 0; i < nb; ++i)
+	{
+		if (m_packedSizes[i] == 0 || !writeData(&m_packed[i][0], m_packedSizes[i]))
+			return false;
+	}
+	return true;
+}
+
+void BinaryStreamBuf::decompressFrame(unsigned int i)
+{
+#ifdef CGOGN_WITH_LZ4
+	if (m_frames[i].size() < FRAME)
+		m_frames[i].resize(FRAME);
+	int nb = LZ4_decompress_safe(&m_packed[i][0], &m_frames[i][0], int(m_packedSizes[i]), int(FRAME));
+	if (nb != int(m_sizes[i]))
+		m_packedSizes[i] = 0;	// error
+#else
+	m_packedSizes[i] = 0;
+#endif
+}
+
+bool BinaryStreamBuf::readFrames()
+{
+	unsigned int nb = 0;
+	while (nb < m_frames.size())
+	{
+		unsigned int header[2];
+		std::size_t got = readFully(m_fd, reinterpret_cast<char*>(header), 2 * sizeof(unsigned int));
+		if (got == 0)
+			break;	// end of file
+		if (got < 2 * sizeof(unsigned int) || header[0] > FRAME || header[1] == 0)
+			return false;
+
+		m_sizes[nb] = header[0];
+		m_packedSizes[nb] = header[1];
+		if (m_packed[nb].size() < header[1])
+			m_packed[nb].resize(header[1]);
+		if (readFully(m_fd, &m_packed[nb][0], header[1]) != header[1])
+			return false;
+		++nb;
+	}
+	if (nb == 0)
+		return false;
+
+	parallelFrames(nb, &BinaryStreamBuf::decompressFrame);
+
+	for (unsigned int i = 0; i < nb; ++i)
+	{
+		if (m_packedSizes[i] == 0)
+		{
+			CGoGNerr << "BinaryStreamBuf: corrupted LZ4 frame" << CGoGNendl;
+			return false;
+		}
+	}
+
+	m_nbFrames = nb;
+	m_currentFrame = 0;
+	return true;
+}
+
+int BinaryStreamBuf::overflow(int c)
+{
+	if (!(m_mode & std::ios::out) || !m_opened)
+		return EOF;
+	if (!flushBuffer())
+		return EOF;
+	if (c != EOF)
+	{
+		*pptr() = char(c);
+		pbump(1);
+		return c;
+	}
+	return 0;
+}
+
+int BinaryStreamBuf::sync()
+{
+	if (!(m_mode & std::ios::out) || !m_opened)
+		return 0;
+	if (!flushBuffer())
+		return -1;
+	if (m_format != BIN_RAW && m_nbFrames > 0 && !writeFrames())
+		return -1;
+	return 0;
+}
+
+std::streamsize BinaryStreamBuf::xsputn(const char* s, std::streamsize n)
+{
+	if (!(m_mode & std::ios::out) || !m_opened)
+		return 0;
+
+	// large raw blocks: no copy in the buffer
+	if (m_format == BIN_RAW && n >= std::streamsize(FRAME))
+	{
+		if (!flushBuffer() || !writeData(s, std::size_t(n)))
+			return 0;
+		return n;
+	}
+
+	std::streamsize done = 0;
+	while (done < n)
+	{
+		std::streamsize avail = epptr() - pptr();
+		if (avail == 0)
+		{
+			if (!flushBuffer())
+				break;
+			continue;
+		}
+		std::streamsize nb = std::min(avail, n - done);
+		memcpy(pptr(), s + done, std::size_t(nb));
+		pbump(int(nb));
+		done += nb;
+	}
+	return done;
+}
+
+int BinaryStreamBuf::underflow()
+{
+	if (gptr() < egptr())
+		return *reinterpret_cast<unsigned char*>(gptr());
+
+	if (!(m_mode & std::ios::in) || !m_opened)
+		return EOF;
+
+	switch (m_format)
+	{
+		case BIN_GZIP:
+		{
+			int nb = gzread(m_gzFile, &m_buffer[0], FRAME);
+			if (nb <= 0)
+				return EOF;
+			setg(&m_buffer[0], &m_buffer[0], &m_buffer[0] + nb);
+			break;
+		}
+		case BIN_RAW:
+		{
+			long long nb = readTwo(m_fd, &m_buffer[0], FRAME, NULL, 0);
+			if (nb <= 0)
+				return EOF;
+			setg(&m_buffer[0], &m_buffer[0], &m_buffer[0] + nb);
+			break;
+		}
+		case BIN_LZ4:
+		{
+			if (m_currentFrame + 1 < m_nbFrames)
+				++m_currentFrame;
+			else if (!readFrames())
+				return EOF;
+			char* frame = &m_frames[m_currentFrame][0];
+			setg(frame, frame, frame + m_sizes[m_currentFrame]);
+			if (m_sizes[m_currentFrame] == 0)
+				return underflow();
+			break;
+		}
+	}
+
+	return *reinterpret_cast<unsigned char*>(gptr());
+}
+
+std::streamsize BinaryStreamBuf::xsgetn(char* s, std::streamsize n)
+{
+	std::streamsize got = std::min(std::streamsize(egptr() - gptr()), n);
+	if (got > 0)
+	{
+		memcpy(s, gptr(), std::size_t(got));
+		gbump(int(got));
+	}
+	if (got == n || !(m_mode & std::ios::in) || !m_opened)
+		return got;
+
+	if (m_format == BIN_RAW)
+	{
+		// the rest of the block goes directly to s, the buffer is refilled by the same call
+		while (got < n)
+		{
+			long long nb = readTwo(m_fd, s + got, std::size_t(n - got), &m_buffer[0], FRAME);
+			if (nb <= 0)
+			{
+				setg(&m_buffer[0], &m_buffer[0], &m_buffer[0]);
+				break;
+			}
+			if (nb <= n - got)
+			{
+				got += std::streamsize(nb);
+				setg(&m_buffer[0], &m_buffer[0], &m_buffer[0]);
+			}
+			else
+			{
+				setg(&m_buffer[0], &m_buffer[0], &m_buffer[0] + (nb - (n - got)));
+				got = n;
+			}
+		}
+		return got;
+	}
+
+	if (m_format == BIN_GZIP)
+	{
+		// large blocks are inflated directly in s
+		while (n - got >= std::streamsize(FRAME))
+		{
+			int nb = gzread(m_gzFile, s + got, (unsigned int)(std::min(n - got, std::streamsize(1) << 30)));
+			if (nb <= 0)
+				return got;
+			got += nb;
+		}
+	}
+
+	return got + std::streambuf::xsgetn(s + got, n - got);
+}
+
+
+BinaryStreamBase::~BinaryStreamBase()
+{
+	buf.close();
+}
+
+void BinaryStreamBase::open(const char* name, int mode, BinaryFormat format, ThreadPool* pool, unsigned int nbWorkers)
+{
+	if (!buf.open(name, mode, format, pool, nbWorkers))
+		clear(rdstate() | std::ios::badbit);
+}
+
+void BinaryStreamBase::close()
+{
+	if (buf.is_open())
+	{
+		if (!buf.close())
+			clear(rdstate() | std::ios::badbit);
+	}
+}
+
+}
+
+}
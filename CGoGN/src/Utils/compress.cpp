@@ -24,6 +24,7 @@
 
 #include <cassert>
 #include "Utils/compress.h"
+#include "Utils/threadPool.h"
 #include "zlib.h"
 
 #include <iostream>
@@ -37,72 +38,119 @@ namespace CGoGN
 namespace Utils
 {
 
-void zlibVTUWriteCompressed( unsigned char* input, unsigned int nbBytes, std::ofstream& fout)
+namespace
 {
 
-	std::cout << "Compressor Block " << std::endl;
+const unsigned int CHUNK = 1024*256;
 
-	const int CHUNK=1024*256;
-	int level = 6; // compression level 
+struct StreamOutput
+{
+	std::ofstream& out;
+	StreamOutput(std::ofstream& o) : out(o) {}
+	void write(const void* data, std::size_t nb) { out.write(reinterpret_cast<const char*>(data), nb); }
+	long long tell() { return (long long)(out.tellp()); }
+	void seek(long long pos) { out.seekp(pos); }
+};
+
+struct FileOutput
+{
+	FILE* out;
+	FileOutput(FILE* o) : out(o) {}
+	void write(const void* data, std::size_t nb) { fwrite(data, 1, nb, out); }
+	long long tell() { return (long long)(ftell(out)); }
+	void seek(long long pos) { fseek(out, long(pos), SEEK_SET); }
+};
+
+/**
+ * compress the blocks of CHUNK bytes by waves of a few blocks per worker:
+ * each block is gathered (if input is NULL) and deflated in its own buffers,
+ * then the wave is written. The header is written at the end, in front of the blocks.
+ */
+template <typename OUTPUT>
+unsigned int writeCompressedBlocks(const unsigned char* input, unsigned int nbBytes, const GatherFunction* gather, OUTPUT& out, int level, ThreadPool* pool, unsigned int nbWorkers)
+{
+	unsigned int nbBlocks = (nbBytes + CHUNK - 1) / CHUNK;
 
-	z_stream strm;
-	strm.zalloc = Z_NULL;
-	strm.zfree = Z_NULL;
-	strm.opaque = Z_NULL;
-	int ret = deflateInit(&strm, level);
-	assert(ret == Z_OK); 
-	if (ret != Z_OK)
-		return;
+	std::vector<unsigned int> header(3 + nbBlocks);
+	header[0] = nbBlocks;
+	header[1] = CHUNK;
+	header[2] = nbBytes % CHUNK;	// 0: last block is full
 
-	unsigned char* bufferOut = new unsigned char[nbBytes];
-	unsigned char* ptrBufferOut = bufferOut;
+	long long headerPos = out.tell();
+	out.write(&header[0], header.size()*sizeof(unsigned int));
+	unsigned int written = (unsigned int)(header.size()*sizeof(unsigned int));
 
-	std::vector<unsigned int> header;
-	header.reserve(1024);
-	header.resize(3);
+	unsigned int nbThreads = 1;
+	if (pool != NULL)
+		nbThreads = (nbWorkers == 0) ? pool->nbWorkers() : std::min(nbWorkers, pool->nbWorkers());
+	unsigned int waveSize = 4 * nbThreads;
 
-	unsigned char* ptrData = input;
-	int remain = nbBytes;
+	std::vector< std::vector<unsigned char> > bufferIn(input == NULL ? waveSize : 0);
+	std::vector< std::vector<unsigned char> > bufferOut(waveSize);
 
-	while (remain >0)
+	for (unsigned int first = 0; first < nbBlocks; first += waveSize)
 	{
-		strm.avail_in = std::min(remain,CHUNK);	// taille buffer
-		strm.next_in = ptrData;					// ptr buffer
-		do
+		unsigned int nb = std::min(waveSize, nbBlocks - first);
+
+		ThreadPool::TaskFunction compressBlock = [&] (unsigned int t, unsigned int)
+		{
+			unsigned int offset = (first + t) * CHUNK;
+			unsigned int size = std::min(CHUNK, nbBytes - offset);
+
+			const unsigned char* data = input + offset;
+			if (input == NULL)
+			{
+				bufferIn[t].resize(size);
+				(*gather)(offset, size, &bufferIn[t][0]);
+				data = &bufferIn[t][0];
+			}
+
+			uLongf length = compressBound(size);
+			bufferOut[t].resize(length);
+			int ret = compress2(&bufferOut[t][0], &length, data, size, level);
+			assert(ret == Z_OK);
+			(void)ret;
+			bufferOut[t].resize(length);
+		};
+
+		if (pool != NULL && nb > 1)
+			pool->exec(nb, compressBlock, nbWorkers);
+		else
+		{
+			for (unsigned int t = 0; t < nb; ++t)
+				compressBlock(t, 0);
+		}
+
+		for (unsigned int t = 0; t < nb; ++t)
 		{
-			strm.avail_out = CHUNK;
-			strm.next_out = ptrBufferOut;
-			if (remain>= CHUNK)
-				ret = deflate(&strm, 0);
-			else
-				ret = deflate(&strm, 1);
-			assert(ret != Z_STREAM_ERROR); 
-			unsigned int have = CHUNK - strm.avail_out;
-			ptrBufferOut+=have;
-			header.push_back(have);
-		} while (strm.avail_out == 0);
-
-		remain -= CHUNK;
-		ptrData += CHUNK;	
+			header[3 + first + t] = (unsigned int)(bufferOut[t].size());
+			out.write(&bufferOut[t][0], bufferOut[t].size());
+			written += header[3 + first + t];
+		}
 	}
-	deflateEnd(&strm);
 
-	header[0] = (unsigned int)(header.size()-3);
-	header[1] = CHUNK;
-	if (remain != 0)
-		header[2] = remain +CHUNK;
-	else header[2] = 0;
+	// header with the compressed sizes
+	long long endPos = out.tell();
+	out.seek(headerPos);
+	out.write(&header[0], header.size()*sizeof(unsigned int));
+	out.seek(endPos);
 
-	std::cout << "HEADER "<< std::endl;
-	for (unsigned int i=0; i<header.size(); ++i)
-		std::cout << header[i]<< std::endl;
+	return written;
+}
 
-	fout.write((char*)&header[0], header.size()*sizeof(unsigned int));
-	fout.write((char*)bufferOut, ptrBufferOut - bufferOut);
+} // namespace
 
-	std::cout << "DATA "<<  ptrBufferOut - bufferOut << "bytes writen"<< std::endl;
 
-	delete[] bufferOut;
+unsigned int zlibVTUWriteCompressed(const unsigned char* input, unsigned int nbBytes, std::ofstream& fout, int level, ThreadPool* pool, unsigned int nbWorkers)
+{
+	StreamOutput out(fout);
+	return writeCompressedBlocks(input, nbBytes, NULL, out, level, pool, nbWorkers);
+}
+
+unsigned int zlibVTUWriteCompressed(unsigned int nbBytes, const GatherFunction& gather, FILE* fout, int level, ThreadPool* pool, unsigned int nbWorkers)
+{
+	FileOutput out(fout);
+	return writeCompressedBlocks(NULL, nbBytes, &gather, out, level, pool, nbWorkers);
 }
 
 
@@ -0,0 +1,152 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#define CGoGN_UTILS_DLL_EXPORT 1
+#include "Utils/mappedFile.h"
+
+#include <fstream>
+
+#ifndef WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace CGoGN
+{
+
+namespace Utils
+{
+
+MappedFile::MappedFile():
+	m_data(NULL),
+	m_size(0),
+	m_mapped(false)
+{}
+
+MappedFile::~MappedFile()
+{
+	close();
+}
+
+bool MappedFile::open(const std::string& filename)
+{
+	close();
+
+#ifndef WIN32
+	int fd = ::open(filename.c_str(), O_RDONLY);
+	if (fd < 0)
+		return false;
+
+	struct stat st;
+	if ((fstat(fd, &st) != 0) || (st.st_size <= 0))
+	{
+		::close(fd);
+		return false;
+	}
+
+	void* ptr = mmap(NULL, std::size_t(st.st_size), PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+	::close(fd);	// the mapping keeps its own reference to the file
+	if (ptr == MAP_FAILED)
+		return false;
+
+	m_data = static_cast<char*>(ptr);
+	m_size = std::size_t(st.st_size);
+	m_mapped = true;
+	return true;
+#else
+	std::ifstream fp(filename.c_str(), std::ios::in | std::ios::binary);
+	if (!fp.good())
+		return false;
+	fp.seekg(0, std::ios::end);
+	std::streamoff sz = fp.tellg();
+	if (sz <= 0)
+		return false;
+	fp.seekg(0, std::ios::beg);
+	m_buffer.resize(std::size_t(sz));
+	fp.read(&m_buffer[0], sz);
+	m_data = &m_buffer[0];
+	m_size = std::size_t(sz);
+	m_mapped = false;
+	return true;
+#endif
+}
+
+void MappedFile::close()
+{
+#ifndef WIN32
+	if (m_mapped)
+		munmap(m_data, m_size);
+#endif
+	std::vector<char>().swap(m_buffer);
+	m_data = NULL;
+	m_size = 0;
+	m_mapped = false;
+}
+
+#ifndef WIN32
+namespace
+{
+
+// page aligned range of [offset, offset+length[ clamped to the size of the file
+bool pageRange(char* data, std::size_t size, std::size_t offset, std::size_t length, char*& begin, std::size_t& nbBytes)
+{
+	if (offset >= size)
+		return false;
+	if (length > size - offset)
+		length = size - offset;
+	std::size_t page = std::size_t(sysconf(_SC_PAGESIZE));
+	std::size_t b = offset - offset % page;
+	begin = data + b;
+	nbBytes = offset + length - b;
+	return nbBytes > 0;
+}
+
+}
+#endif
+
+void MappedFile::willNeed(std::size_t offset, std::size_t length) const
+{
+#ifndef WIN32
+	char* begin;
+	std::size_t nbBytes;
+	if (m_mapped && pageRange(m_data, m_size, offset, length, begin, nbBytes))
+		madvise(begin, nbBytes, MADV_WILLNEED);
+#endif
+}
+
+void MappedFile::dontNeed(std::size_t offset, std::size_t length) const
+{
+#if !defined(WIN32) && defined(MADV_COLD)
+	// MADV_COLD only deactivates the pages: unlike MADV_DONTNEED it never drops private copies
+	char* begin;
+	std::size_t nbBytes;
+	if (m_mapped && pageRange(m_data, m_size, offset, length, begin, nbBytes))
+		madvise(begin, nbBytes, MADV_COLD);
+#endif
+}
+
+}
+}
@@ -0,0 +1,211 @@
+/*******************************************************************************
+* CGoGN: Combinatorial and Geometric modeling with Generic N-dimensional Maps  *
+* version 0.1                                                                  *
+* Copyright (C) 2009-2012, IGG Team, LSIIT, University of Strasbourg           *
+*                                                                              *
+* This library is free software; you can redistribute it and/or modify it      *
+* under the terms of the GNU Lesser General Public License as published by the *
+* Free Software Foundation; either version 2.1 of the License, or (at your     *
+* option) any later version.                                                   *
+*                                                                              *
+* This library is distributed in the hope that it will be useful, but WITHOUT  *
+* ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or        *
+* FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License  *
+* for more details.                                                            *
+*                                                                              *
+* You should have received a copy of the GNU Lesser General Public License     *
+* along with this library; if not, write to the Free Software Foundation,      *
+* Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA.           *
+*                                                                              *
+* Web site: http://cgogn.unistra.fr/                                           *
+* Contact information: cgogn@unistra.fr                                        *
+*                                                                              *
+*******************************************************************************/
+
+#define CGoGN_UTILS_DLL_EXPORT 1
+#include "Utils/threadPool.h"
+
+#include <cassert>
+
+namespace CGoGN
+{
+
+namespace Utils
+{
+
+/// pool and index in [1,nbWorkers] of the calling thread if it is a worker (set once at its launch)
+static thread_local const ThreadPool* t_pool = NULL;
+static thread_local unsigned int t_worker = 0;
+
+ThreadPool::ThreadPool(unsigned int nbWorkers):
+	m_nbActive(0),
+	m_func(NULL),
+	m_pending(0),
+	m_busy(0),
+	m_generation(0),
+	m_stop(false)
+{
+	reserve(nbWorkers);
+}
+
+ThreadPool::~ThreadPool()
+{
+	std::lock_guard<std::mutex> lockExec(m_execMutex);
+	{
+		std::lock_guard<std::mutex> lock(m_protect);
+		m_stop = true;
+	}
+	m_condWork.notify_all();
+
+	for (unsigned int i = 0; i < m_workers.size(); ++i)
+		m_workers[i]->thread.join();
+	for (unsigned int i = 0; i < m_workers.size(); ++i)
+		delete m_workers[i];
+}
+
+void ThreadPool::reserve(unsigned int nb)
+{
+	// called from a task: m_execMutex is held by the running exec
+	// and the nested execs are executed inline, no worker is needed
+	if (currentWorker() != 0)
+		return;
+
+	std::lock_guard<std::mutex> lockExec(m_execMutex);
+	std::lock_guard<std::mutex> lock(m_protect);
+
+	// no exec is running: new workers start with the current generation
+	while (m_workers.size() < nb)
+	{
+		unsigned int w = (unsigned int)(m_workers.size());
+		Worker* worker = new Worker;
+		m_workers.push_back(worker);
+		worker->thread = std::thread(&ThreadPool::workerLoop, this, w, m_generation);
+	}
+}
+
+unsigned int ThreadPool::currentWorker() const
+{
+	return (t_pool == this) ? t_worker : 0;
+}
+
+void ThreadPool::workerLoop(unsigned int w, unsigned int seenGeneration)
+{
+	t_pool = this;
+	t_worker = w + 1;
+
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_protect);
+			while (!m_stop && m_generation == seenGeneration)
+				m_condWork.wait(lock);
+			if (m_stop)
+				return;
+			seenGeneration = m_generation;
+		}
+		runTasks(w);
+		{
+			std::lock_guard<std::mutex> lock(m_protect);
+			if (--m_busy == 0)
+				m_condDone.notify_all();
+		}
+	}
+}
+
+bool ThreadPool::popTask(unsigned int w, unsigned int& task)
+{
+	Worker* worker = m_workers[w];
+	std::lock_guard<std::mutex> lock(worker->mutex);
+	if (w >= m_nbActive || worker->tasks.empty())
+		return false;
+	task = worker->tasks.front();
+	worker->tasks.pop_front();
+	return true;
+}
+
+bool ThreadPool::stealTask(unsigned int w, unsigned int& task)
+{
+	unsigned int nb = m_nbActive;
+	for (unsigned int i = 1; i < nb; ++i)
+	{
+		Worker* victim = m_workers[(w + i) % nb];
+		std::lock_guard<std::mutex> lock(victim->mutex);
+		// checked under the lock of the victim: tasks are pushed after m_nbActive is set
+		if (w >= m_nbActive)
+			return false;
+		if (!victim->tasks.empty())
+		{
+			task = victim->tasks.back();
+			victim->tasks.pop_back();
+			return true;
+		}
+	}
+	return false;
+}
+
+void ThreadPool::runTasks(unsigned int w)
+{
+	unsigned int task;
+	while (popTask(w, task) || stealTask(w, task))
+	{
+		(*m_func)(task, w + 1);
+		--m_pending;
+	}
+}
+
+void ThreadPool::exec(unsigned int nbTasks, const TaskFunction& func, unsigned int nbActive)
+{
+	if (nbTasks == 0)
+		return;
+
+	// nested call from a task: no worker is available, execute inline
+	unsigned int cw = currentWorker();
+	if (cw != 0)
+	{
+		for (unsigned int t = 0; t < nbTasks; ++t)
+			func(t, cw);
+		return;
+	}
+
+	std::lock_guard<std::mutex> lockExec(m_execMutex);
+
+	unsigned int nbw = (unsigned int)(m_workers.size());
+	assert(nbw > 0 || !"ThreadPool::exec: pool without worker");
+	if ((nbActive == 0) || (nbActive > nbw))
+		nbActive = nbw;
+
+	m_func = &func;
+	m_pending = nbTasks;
+	m_nbActive = nbActive;
+
+	// deal contiguous packs of tasks: neighbour tasks are likely to share memory
+	for (unsigned int w = 0; w < nbActive; ++w)
+	{
+		unsigned int b = (unsigned int)((unsigned long long)(nbTasks) * w / nbActive);
+		unsigned int e = (unsigned int)((unsigned long long)(nbTasks) * (w + 1) / nbActive);
+		std::lock_guard<std::mutex> lock(m_workers[w]->mutex);
+		for (unsigned int t = b; t < e; ++t)
+			m_workers[w]->tasks.push_back(t);
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_protect);
+		m_busy = nbw;
+		++m_generation;
+	}
+	m_condWork.notify_all();
+
+	// all the woken workers must have left runTasks (and stopped reading the deques)
+	// before m_workers may be modified by reserve or the tasks of the next exec dealt
+	{
+		std::unique_lock<std::mutex> lock(m_protect);
+		while (m_busy != 0)
+			m_condDone.wait(lock);
+	}
+	assert(m_pending == 0);
+
+	m_func = NULL;
+}
+
+}
+}
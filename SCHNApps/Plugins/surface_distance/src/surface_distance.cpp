@@ -122,12 +122,14 @@ void Surface_Distance_Plugin::computeDistance(
 	PFP2::MAP* map1 = mh1->getMap();
 	PFP2::MAP* map2 = mh2->getMap();
 
-	// compute distance between map1 and map2 here
-	//   distance from map1 to map2 can be stored in map1 vertex attribute distance1
-	//   distance from map2 to map1 can be stored in map2 vertex attribute distance2
-
-	// Algo::Geometry::computeDistance<PFP2>(map1, position1, distance1, map2, position2);
-	// Algo::Geometry::computeDistance<PFP2>(map2, position2, distance2, map1, position1);
+	// distance from map1 to map2 stored in map1 vertex attribute distance1
+	// distance from map2 to map1 stored in map2 vertex attribute distance2
+	Algo::Geometry::DistanceStats<PFP2::REAL> s1 = Algo::Geometry::computeDistance<PFP2>(*map1, position1, distance1, *map2, position2);
+	Algo::Geometry::DistanceStats<PFP2::REAL> s2 = Algo::Geometry::computeDistance<PFP2>(*map2, position2, distance2, *map1, position1);
+
+	CGoGNout << mapName1.toStdString() << " -> " << mapName2.toStdString() << " : min " << s1.min << " / mean " << s1.mean << " / rms " << s1.rms << " / max " << s1.max << CGoGNendl;
+	CGoGNout << mapName2.toStdString() << " -> " << mapName1.toStdString() << " : min " << s2.min << " / mean " << s2.mean << " / rms " << s2.rms << " / max " << s2.max << CGoGNendl;
+	CGoGNout << "Hausdorff distance : " << std::max(s1.max, s2.max) << CGoGNendl;
 
 	this->pythonRecording("computeDistance", "", mapName1, positionAttributeName1, distanceAttributeName1, 
 							mapName2, positionAttributeName2, distanceAttributeName2);
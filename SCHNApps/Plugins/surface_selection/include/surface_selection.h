@@ -8,6 +8,8 @@
 #include "Utils/pointSprite.h"
 #include "Utils/drawer.h"
 
+#include "Algo/Geometry/faceBVH.h"
+
 namespace CGoGN
 {
 
@@ -139,8 +141,15 @@ public slots:
 	void clearSelection(const QString& map, unsigned int orbit, const QString& selectorName);
 
 protected:
+	/// BVH of the faces of the map used for picking (built on first use)
+	Algo::Geometry::FaceBVH<PFP2>* getFaceBVH(MapHandlerGen* map);
+
+	/// delete the BVH of the map (rebuilt on next picking)
+	void resetFaceBVH(MapHandlerGen* map);
+
 	Surface_Selection_DockTab* m_dockTab;
 	QHash<MapHandlerGen*, MapParameters> h_parameterSet;
+	QHash<MapHandlerGen*, Algo::Geometry::FaceBVH<PFP2>*> h_faceBVH;
 
 	bool m_selecting;
 
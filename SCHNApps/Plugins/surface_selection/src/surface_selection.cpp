@@ -89,6 +89,10 @@ void Surface_Selection_Plugin::disable()
 
 	delete m_selectionSphereVBO;
 
+	foreach(Algo::Geometry::FaceBVH<PFP2>* bvh, h_faceBVH)
+		delete bvh;
+	h_faceBVH.clear();
+
 	//disconnect(m_schnapps, SIGNAL(selectedViewChanged(View*, View*)), this, SLOT(selectedViewChanged(View*, View*)));
 	//disconnect(m_schnapps, SIGNAL(mapRemoved(MapHandlerGen*)), this, SLOT(mapRemoved(MapHandlerGen*)));
 	disconnect(m_schnapps, SIGNAL(selectedMapChanged(MapHandlerGen*, MapHandlerGen*)), this, SLOT(selectedMapChanged(MapHandlerGen*, MapHandlerGen*)));
@@ -459,19 +463,20 @@ void Surface_Selection_Plugin::mouseMove(View* view, QMouseEvent* event)
 				PFP2::VEC3 AB(glmAB.x, glmAB.y, glmAB.z);
 
 				PFP2::MAP* map = static_cast<MapHandler<PFP2>*>(mh)->getMap();
+				const Algo::Geometry::FaceBVH<PFP2>& bvh = *getFaceBVH(mh);
 
 				switch(orbit)
 				{
 					case VERTEX : {
-						Algo::Selection::vertexRaySelection<PFP2>(*map, p.positionAttribute, rayA, AB, m_selectingVertex);
+						Algo::Selection::vertexRaySelection<PFP2>(*map, p.positionAttribute, bvh, rayA, AB, m_selectingVertex);
 						break;
 					}
 					case EDGE : {
-						Algo::Selection::edgeRaySelection<PFP2>(*map, p.positionAttribute, rayA, AB, m_selectingEdge);
+						Algo::Selection::edgeRaySelection<PFP2>(*map, p.positionAttribute, bvh, rayA, AB, m_selectingEdge);
 						break;
 					}
 					case FACE : {
-						Algo::Selection::faceRaySelection<PFP2>(*map, p.positionAttribute, rayA, AB, m_selectingFace);
+						Algo::Selection::faceRaySelection<PFP2>(*map, p.positionAttribute, bvh, rayA, AB, m_selectingFace);
 						break;
 					}
 				}
@@ -638,6 +643,22 @@ void Surface_Selection_Plugin::updateRemovedSelector(unsigned int orbit, const Q
 
 
 
+Algo::Geometry::FaceBVH<PFP2>* Surface_Selection_Plugin::getFaceBVH(MapHandlerGen* map)
+{
+	if (!h_faceBVH.contains(map))
+	{
+		MapHandler<PFP2>* mh = static_cast<MapHandler<PFP2>*>(map);
+		h_faceBVH[map] = new Algo::Geometry::FaceBVH<PFP2>(*mh->getMap(), h_parameterSet[map].positionAttribute);
+	}
+	return h_faceBVH[map];
+}
+
+void Surface_Selection_Plugin::resetFaceBVH(MapHandlerGen* map)
+{
+	if (h_faceBVH.contains(map))
+		delete h_faceBVH.take(map);
+}
+
 void Surface_Selection_Plugin::selectedMapAttributeAdded(unsigned int orbit, const QString& name)
 {
 	if(orbit == VERTEX)
@@ -651,13 +672,18 @@ void Surface_Selection_Plugin::selectedMapAttributeModified(unsigned int orbit,
 		MapHandlerGen* map = static_cast<MapHandlerGen*>(QObject::sender());
 		const MapParameters& p = h_parameterSet[map];
 		if(p.positionAttribute.isValid() && QString::fromStdString(p.positionAttribute.name()) == name)
+		{
+			if (h_faceBVH.contains(map))
+				h_faceBVH[map]->refit();
 			updateSelectedCellsRendering();
+		}
 	}
 }
 
 void Surface_Selection_Plugin::selectedMapConnectivityModified()
 {
 	MapHandlerGen* map = static_cast<MapHandlerGen*>(QObject::sender());
+	resetFaceBVH(map);
 	const MapParameters& p = h_parameterSet[map];
 	if(p.positionAttribute.isValid())
 		updateSelectedCellsRendering();
@@ -682,6 +708,7 @@ void Surface_Selection_Plugin::changePositionAttribute(const QString& map, const
 	{
 		MapHandler<PFP2>* mh = static_cast<MapHandler<PFP2>*>(m);
 		h_parameterSet[m].positionAttribute = mh->getAttribute<PFP2::VEC3, VERTEX>(name);
+		resetFaceBVH(m);
 		if(m->isSelectedMap())
 			m_dockTab->updateMapParameters();
 	}
@@ -43,6 +43,7 @@ void Surface_Selection_DockTab::positionAttributeChanged(int index)
 		{
 			MapHandler<PFP2>* mh = static_cast<MapHandler<PFP2>*>(map);
 			m_plugin->h_parameterSet[map].positionAttribute = mh->getAttribute<PFP2::VEC3, VERTEX>(combo_positionAttribute->currentText());
+			m_plugin->resetFaceBVH(map);
 			m_plugin->updateSelectedCellsRendering();
 			m_plugin->pythonRecording("changePositionAttribute", "", map->getName(), combo_positionAttribute->currentText());
 		}